@@ -36,6 +36,8 @@
 #include "itkMapContainer.h"
 #include "itkCommonEnums.h"
 #include "ITKMeshExport.h"
+#include <functional>
+#include <memory>
 #include <vector>
 #include <set>
 #include "itkVectorContainer.h"
@@ -211,6 +213,17 @@ public:
   using CellDataContainerIterator = typename CellDataContainer::ConstIterator;
   using PointCellLinksContainerIterator = typename PointCellLinksContainer::const_iterator;
 
+  /** Contiguous, VTK-style storage of the cells: the type of each cell,
+   *  the offset of the first point identifier of each cell followed by
+   *  the total number of point identifiers, and the point identifiers of
+   *  all the cells. */
+  using CellTypesContainer = VectorContainer<CellIdentifier, CellGeometryEnum>;
+  using CellTypesContainerPointer = typename CellTypesContainer::Pointer;
+  using CellOffsetsContainer = VectorContainer<CellIdentifier, SizeValueType>;
+  using CellOffsetsContainerPointer = typename CellOffsetsContainer::Pointer;
+  using CellConnectivityContainer = VectorContainer<SizeValueType, PointIdentifier>;
+  using CellConnectivityContainerPointer = typename CellConnectivityContainer::Pointer;
+
   /** A useful rename. */
   using CellFeatureCount = CellFeatureIdentifier;
 
@@ -278,6 +291,63 @@ public:
     }
   }; // End Class: Mesh::BoundaryAssignmentIdentifier
 
+#if !defined(ITK_WRAPPING_PARSER)
+  /** \class CellView
+   *  A lightweight view of a cell of the contiguous cell storage of the
+   *  mesh, see SetCellsConnectivity(). The view refers to the point
+   *  identifiers of the cell without copying them, it is valid as long as
+   *  the cells of the mesh are not modified.
+   * \ingroup ITKMesh
+   */
+  class CellView
+  {
+  public:
+    CellView() = default;
+    CellView(CellGeometryEnum type, const PointIdentifier * first, const PointIdentifier * last)
+      : m_Type(type)
+      , m_PointIdsBegin(first)
+      , m_PointIdsEnd(last)
+    {}
+
+    /** The geometric type of the cell. */
+    CellGeometryEnum
+    GetType() const
+    {
+      return m_Type;
+    }
+
+    unsigned int
+    GetNumberOfPoints() const
+    {
+      return static_cast<unsigned int>(m_PointIdsEnd - m_PointIdsBegin);
+    }
+
+    PointIdentifier
+    GetPointId(unsigned int localId) const
+    {
+      return m_PointIdsBegin[localId];
+    }
+
+    /** Iterate over the point identifiers of the cell. */
+    const PointIdentifier *
+    PointIdsBegin() const
+    {
+      return m_PointIdsBegin;
+    }
+
+    const PointIdentifier *
+    PointIdsEnd() const
+    {
+      return m_PointIdsEnd;
+    }
+
+  private:
+    CellGeometryEnum        m_Type{ CellGeometryEnum::VERTEX_CELL };
+    const PointIdentifier * m_PointIdsBegin{ nullptr };
+    const PointIdentifier * m_PointIdsEnd{ nullptr };
+  }; // End Class: Mesh::CellView
+#endif
+
   /** Used for manipulating boundaries and boundary attributes.  A
    * BoundaryAssignmentsContainerVector is indexed by dimension.  For
    * each dimension, it points to a MapContainer indexed by a
@@ -387,6 +457,47 @@ public:
   virtual CellsVectorContainer *
   GetCellsArray();
 
+#if !defined(ITK_WRAPPING_PARSER)
+  /** Set the cells from contiguous, VTK-style arrays: the type of each
+   *  cell, the offset of the first point identifier of each cell in the
+   *  connectivity array followed by the size of that array, and the point
+   *  identifiers of all the cells. The cell identifiers range from 0 to the
+   *  number of types - 1.
+   *
+   *  The mesh keeps a reference to the arrays, and GetCellView() is the
+   *  only access to the cells that does not copy their point identifiers.
+   *  The cell objects of the cells container are still created for the
+   *  rest of the toolkit, and each of them holds its own copy of its point
+   *  identifiers; the PolyLine and Polygon cells also allocate them. These
+   *  cell objects are allocated in one array per cell type rather than one
+   *  by one, they are owned by the cells container and released with it,
+   *  whether it is shared through Graft() or SetCells(). Setting a cell
+   *  with SetCell() discards the arrays, but not the cells allocated from
+   *  them.
+   *
+   *  Throws an exception if the arrays are inconsistent.
+   */
+  virtual void
+  SetCellsConnectivity(CellTypesContainer *, CellOffsetsContainer *, CellConnectivityContainer *);
+
+  /** Get the contiguous cell arrays given to SetCellsConnectivity(), or
+   *  nullptr if the cells were set otherwise. */
+  const CellTypesContainer *
+  GetCellTypes() const;
+
+  const CellOffsetsContainer *
+  GetCellOffsets() const;
+
+  const CellConnectivityContainer *
+  GetCellConnectivity() const;
+
+  /** Get a view of a cell of the contiguous cell arrays. Throws an exception
+   *  if the cells were not set by SetCellsConnectivity(), or if the cell
+   *  identifier is out of range. */
+  CellView
+  GetCellView(CellIdentifier) const;
+#endif
+
   /** Get the cells container. */
   CellsContainer *
   GetCells();
@@ -589,11 +700,92 @@ protected:
   BoundingBoxPointer m_BoundingBox{};
 
 private:
+  /** An array of cells of the same type created by SetCellsConnectivity(). */
+  struct CellsBlock
+  {
+    std::shared_ptr<void> m_Cells;
+    const void *          m_Begin;
+    const void *          m_End;
+  };
+
+  /** \class CellsBlocksContainer
+   *  The cells container created by SetCellsConnectivity(). It owns the
+   *  arrays of cells it refers to, so that they live as long as the
+   *  container, whichever mesh or user holds its last reference.
+   * \ingroup ITKMesh
+   */
+  class CellsBlocksContainer : public CellsContainer
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(CellsBlocksContainer);
+
+    using Self = CellsBlocksContainer;
+    using Superclass = CellsContainer;
+    using Pointer = SmartPointer<Self>;
+
+    itkNewMacro(Self);
+    itkOverrideGetNameOfClassMacro(CellsBlocksContainer);
+
+    /** Take the ownership of an array of cells. */
+    void
+    AddCellsBlock(std::shared_ptr<void> cells, const void * begin, const void * end)
+    {
+      m_CellsBlocks.push_back({ std::move(cells), begin, end });
+    }
+
+    /** Whether a cell belongs to one of the arrays of cells. */
+    bool
+    IsInCellsBlock(const CellType * cell) const
+    {
+      const std::less<const void *> less;
+      for (const CellsBlock & block : m_CellsBlocks)
+      {
+        if (!less(cell, block.m_Begin) && less(cell, block.m_End))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /** Release the arrays of cells, once the container no longer refers
+     *  to them. */
+    void
+    ReleaseCellsBlocks()
+    {
+      m_CellsBlocks.clear();
+    }
+
+    SizeValueType
+    GetNumberOfCellsBlocks() const
+    {
+      return static_cast<SizeValueType>(m_CellsBlocks.size());
+    }
+
+  protected:
+    CellsBlocksContainer() = default;
+    ~CellsBlocksContainer() override = default;
+
+  private:
+    std::vector<CellsBlock> m_CellsBlocks{};
+  }; // End Class: Mesh::CellsBlocksContainer
+
+  /** Allocate the cells of a type of the contiguous cell arrays as one
+   *  array, and insert them in the cells container. */
+  template <typename TCell>
+  void
+  CreateCellsBlock(CellsBlocksContainer * cells, CellGeometryEnum type, SizeValueType numberOfCells);
+
   MeshClassCellsAllocationMethodEnum m_CellsAllocationMethod{};
 
   /** Create a new cell of a given type. */
   void
   CreateCell(int cellType, CellAutoPointer &);
+
+  /** The contiguous cell arrays given to SetCellsConnectivity(). */
+  CellTypesContainerPointer        m_CellTypes{};
+  CellOffsetsContainerPointer      m_CellOffsets{};
+  CellConnectivityContainerPointer m_CellConnectivity{};
 }; // End Class: Mesh
 
 /** Define how to print enumeration */
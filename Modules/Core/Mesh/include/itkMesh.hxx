@@ -51,6 +51,11 @@ Mesh<TPixelType, VDimension, TMeshTraits>::PrintSelf(std::ostream & os, Indent i
   os << indent << "Number of explicit cell boundary assignments: "
      << static_cast<CellIdentifier>(m_BoundaryAssignmentsContainers.size()) << std::endl;
   os << indent << "CellsAllocationMethod: " << m_CellsAllocationMethod << std::endl;
+  itkPrintSelfObjectMacro(CellTypes);
+  itkPrintSelfObjectMacro(CellOffsets);
+  itkPrintSelfObjectMacro(CellConnectivity);
+  const auto * cellsBlocks = dynamic_cast<const CellsBlocksContainer *>(m_CellsContainer.GetPointer());
+  os << indent << "Number Of Cells Blocks: " << (cellsBlocks ? cellsBlocks->GetNumberOfCellsBlocks() : 0) << std::endl;
 }
 
 template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
@@ -234,6 +239,185 @@ Mesh<TPixelType, VDimension, TMeshTraits>::SetCellsArray(CellsVectorContainer *
   this->Modified();
 }
 
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+void
+Mesh<TPixelType, VDimension, TMeshTraits>::SetCellsConnectivity(CellTypesContainer *        types,
+                                                                CellOffsetsContainer *      offsets,
+                                                                CellConnectivityContainer * connectivity)
+{
+  itkDebugMacro("setting Cells connectivity to " << types << ", " << offsets << ", " << connectivity);
+
+  if (types == nullptr || offsets == nullptr || connectivity == nullptr)
+  {
+    itkExceptionMacro("The cell types, offsets and connectivity must all be given");
+  }
+
+  const CellIdentifier numberOfCells = types->Size();
+  if (offsets->Size() != numberOfCells + 1 || offsets->ElementAt(numberOfCells) != connectivity->Size())
+  {
+    itkExceptionMacro("Expected " << numberOfCells + 1 << " cell offsets, the last one being the connectivity size "
+                                  << connectivity->Size() << ", got " << offsets->Size() << " cell offsets");
+  }
+
+  // Check the cells and count them by type before touching the mesh
+  const typename CellTypesContainer::STLContainerType &   typesVector = types->CastToSTLConstContainer();
+  const typename CellOffsetsContainer::STLContainerType & offsetsVector = offsets->CastToSTLConstContainer();
+  SizeValueType numberOfCellsOfType[static_cast<int>(CellGeometryEnum::POLYLINE_CELL) + 1]{};
+  for (CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    if (offsetsVector[cellId + 1] < offsetsVector[cellId])
+    {
+      itkExceptionMacro("Decreasing offsets of cell " << cellId);
+    }
+    const SizeValueType numberOfPoints = offsetsVector[cellId + 1] - offsetsVector[cellId];
+
+    unsigned int expectedNumberOfPoints = 0;
+    switch (typesVector[cellId])
+    {
+      case CellGeometryEnum::VERTEX_CELL:
+        expectedNumberOfPoints = OutputVertexCellType::NumberOfPoints;
+        break;
+      case CellGeometryEnum::LINE_CELL:
+        expectedNumberOfPoints = OutputLineCellType::NumberOfPoints;
+        break;
+      case CellGeometryEnum::TRIANGLE_CELL:
+        expectedNumberOfPoints = OutputTriangleCellType::NumberOfPoints;
+        break;
+      case CellGeometryEnum::QUADRILATERAL_CELL:
+        expectedNumberOfPoints = OutputQuadrilateralCellType::NumberOfPoints;
+        break;
+      case CellGeometryEnum::TETRAHEDRON_CELL:
+        expectedNumberOfPoints = OutputTetrahedronCellType::NumberOfPoints;
+        break;
+      case CellGeometryEnum::HEXAHEDRON_CELL:
+        expectedNumberOfPoints = OutputHexahedronCellType::NumberOfPoints;
+        break;
+      case CellGeometryEnum::QUADRATIC_EDGE_CELL:
+        expectedNumberOfPoints = OutputQuadraticEdgeCellType::NumberOfPoints;
+        break;
+      case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+        expectedNumberOfPoints = OutputQuadraticTriangleCellType::NumberOfPoints;
+        break;
+      case CellGeometryEnum::POLYLINE_CELL:
+      case CellGeometryEnum::POLYGON_CELL:
+        break;
+      default:
+        itkExceptionMacro("Unknown mesh cell type " << typesVector[cellId] << " of cell " << cellId);
+    }
+    if (expectedNumberOfPoints != 0 && numberOfPoints != expectedNumberOfPoints)
+    {
+      itkExceptionMacro("Invalid " << typesVector[cellId] << " cell " << cellId
+                                   << " with number of points = " << numberOfPoints);
+    }
+    ++numberOfCellsOfType[static_cast<int>(typesVector[cellId])];
+  }
+
+  this->ReleaseCellsMemory();
+  const auto cells = CellsBlocksContainer::New();
+  cells->Reserve(numberOfCells);
+  m_CellsContainer = cells;
+  m_CellsAllocationMethod = MeshEnums::MeshClassCellsAllocationMethod::CellsAllocatedDynamicallyCellByCell;
+  m_CellTypes = types;
+  m_CellOffsets = offsets;
+  m_CellConnectivity = connectivity;
+
+  const auto count = [&numberOfCellsOfType](CellGeometryEnum type) {
+    return numberOfCellsOfType[static_cast<int>(type)];
+  };
+  using GeometryEnum = CellGeometryEnum;
+  this->CreateCellsBlock<OutputVertexCellType>(cells, GeometryEnum::VERTEX_CELL, count(GeometryEnum::VERTEX_CELL));
+  this->CreateCellsBlock<OutputLineCellType>(cells, GeometryEnum::LINE_CELL, count(GeometryEnum::LINE_CELL));
+  this->CreateCellsBlock<OutputPolyLineCellType>(cells, GeometryEnum::POLYLINE_CELL,
+                                                 count(GeometryEnum::POLYLINE_CELL));
+  this->CreateCellsBlock<OutputTriangleCellType>(cells, GeometryEnum::TRIANGLE_CELL,
+                                                 count(GeometryEnum::TRIANGLE_CELL));
+  this->CreateCellsBlock<OutputQuadrilateralCellType>(cells, GeometryEnum::QUADRILATERAL_CELL,
+                                                      count(GeometryEnum::QUADRILATERAL_CELL));
+  this->CreateCellsBlock<OutputPolygonCellType>(cells, GeometryEnum::POLYGON_CELL, count(GeometryEnum::POLYGON_CELL));
+  this->CreateCellsBlock<OutputTetrahedronCellType>(cells, GeometryEnum::TETRAHEDRON_CELL,
+                                                    count(GeometryEnum::TETRAHEDRON_CELL));
+  this->CreateCellsBlock<OutputHexahedronCellType>(cells, GeometryEnum::HEXAHEDRON_CELL,
+                                                   count(GeometryEnum::HEXAHEDRON_CELL));
+  this->CreateCellsBlock<OutputQuadraticEdgeCellType>(cells, GeometryEnum::QUADRATIC_EDGE_CELL,
+                                                      count(GeometryEnum::QUADRATIC_EDGE_CELL));
+  this->CreateCellsBlock<OutputQuadraticTriangleCellType>(cells, GeometryEnum::QUADRATIC_TRIANGLE_CELL,
+                                                          count(GeometryEnum::QUADRATIC_TRIANGLE_CELL));
+
+  this->Modified();
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+template <typename TCell>
+void
+Mesh<TPixelType, VDimension, TMeshTraits>::CreateCellsBlock(CellsBlocksContainer * cellsContainer,
+                                                            CellGeometryEnum       type,
+                                                            SizeValueType          numberOfCells)
+{
+  if (numberOfCells == 0)
+  {
+    return;
+  }
+
+  const std::shared_ptr<TCell[]> cells(new TCell[numberOfCells]);
+
+  const typename CellTypesContainer::STLContainerType &   types = m_CellTypes->CastToSTLConstContainer();
+  const typename CellOffsetsContainer::STLContainerType & offsets = m_CellOffsets->CastToSTLConstContainer();
+  const PointIdentifier * connectivity = m_CellConnectivity->CastToSTLConstContainer().data();
+
+  SizeValueType n = 0;
+  for (CellIdentifier cellId = 0; cellId < types.size(); ++cellId)
+  {
+    if (types[cellId] == type)
+    {
+      TCell & cell = cells[n++];
+      cell.SetPointIds(connectivity + offsets[cellId], connectivity + offsets[cellId + 1]);
+      cellsContainer->SetElement(cellId, &cell);
+    }
+  }
+
+  cellsContainer->AddCellsBlock(cells, cells.get(), cells.get() + numberOfCells);
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+auto
+Mesh<TPixelType, VDimension, TMeshTraits>::GetCellTypes() const -> const CellTypesContainer *
+{
+  return m_CellTypes;
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+auto
+Mesh<TPixelType, VDimension, TMeshTraits>::GetCellOffsets() const -> const CellOffsetsContainer *
+{
+  return m_CellOffsets;
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+auto
+Mesh<TPixelType, VDimension, TMeshTraits>::GetCellConnectivity() const -> const CellConnectivityContainer *
+{
+  return m_CellConnectivity;
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+auto
+Mesh<TPixelType, VDimension, TMeshTraits>::GetCellView(CellIdentifier cellId) const -> CellView
+{
+  if (m_CellTypes.IsNull())
+  {
+    itkExceptionMacro("The cells of the mesh were not set by SetCellsConnectivity()");
+  }
+  if (cellId >= m_CellTypes->Size())
+  {
+    itkExceptionMacro("Cell " << cellId << " out of the " << m_CellTypes->Size() << " cells of the mesh");
+  }
+
+  const PointIdentifier * connectivity = m_CellConnectivity->CastToSTLConstContainer().data();
+  return CellView(m_CellTypes->ElementAt(cellId),
+                  connectivity + m_CellOffsets->ElementAt(cellId),
+                  connectivity + m_CellOffsets->ElementAt(cellId + 1));
+}
+
 template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 auto
 Mesh<TPixelType, VDimension, TMeshTraits>::GetCells() -> CellsContainer *
@@ -338,6 +522,13 @@ Mesh<TPixelType, VDimension, TMeshTraits>::SetCell(CellIdentifier cellId, CellAu
     this->SetCells(CellsContainer::New());
   }
 
+  /**
+   * The contiguous cell arrays no longer describe the cells.
+   */
+  m_CellTypes = nullptr;
+  m_CellOffsets = nullptr;
+  m_CellConnectivity = nullptr;
+
   /**
    * Insert the cell into the container with the given identifier.
    */
@@ -1042,24 +1233,38 @@ Mesh<TPixelType, VDimension, TMeshTraits>::ReleaseCellsMemory()
       case MeshEnums::MeshClassCellsAllocationMethod::CellsAllocatedDynamicallyCellByCell:
       {
         itkDebugMacro("CellsAllocatedDynamicallyCellByCell start");
-        // It is assumed that every cell was allocated independently.
+        // It is assumed that every cell was allocated independently,
+        // except the cells created by SetCellsConnectivity(), which are
+        // released with their arrays by the cells container.
         // A Cell iterator is created for going through the cells
         // deleting one by one.
+        auto *                 cellsBlocks = dynamic_cast<CellsBlocksContainer *>(m_CellsContainer.GetPointer());
         CellsContainerIterator cell = m_CellsContainer->Begin();
         CellsContainerIterator end = m_CellsContainer->End();
         while (cell != end)
         {
           const CellType * cellToBeDeleted = cell->Value();
-          itkDebugMacro("Mesh destructor deleting cell = " << cellToBeDeleted);
-          delete cellToBeDeleted;
+          if (cellsBlocks == nullptr || !cellsBlocks->IsInCellsBlock(cellToBeDeleted))
+          {
+            itkDebugMacro("Mesh destructor deleting cell = " << cellToBeDeleted);
+            delete cellToBeDeleted;
+          }
           ++cell;
         }
         m_CellsContainer->Initialize();
+        if (cellsBlocks != nullptr)
+        {
+          cellsBlocks->ReleaseCellsBlocks();
+        }
         itkDebugMacro("CellsAllocatedDynamicallyCellByCell end");
         break;
       }
     }
   }
+
+  m_CellTypes = nullptr;
+  m_CellOffsets = nullptr;
+  m_CellConnectivity = nullptr;
 }
 
 template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
@@ -1104,6 +1309,9 @@ Mesh<TPixelType, VDimension, TMeshTraits>::Graft(const DataObject * data)
   // The cell allocation method must be maintained. The reference count
   // test on the container will prevent premature deletion of cells.
   this->m_CellsAllocationMethod = mesh->m_CellsAllocationMethod;
+  this->m_CellTypes = mesh->m_CellTypes;
+  this->m_CellOffsets = mesh->m_CellOffsets;
+  this->m_CellConnectivity = mesh->m_CellConnectivity;
 }
 
 template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
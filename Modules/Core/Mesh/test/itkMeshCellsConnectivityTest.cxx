@@ -0,0 +1,192 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDefaultDynamicMeshTraits.h"
+#include "itkMesh.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Check that the cells of the container match the views of the
+// contiguous cell arrays.
+template <typename TMesh>
+bool
+CheckCells(const TMesh * mesh)
+{
+  bool equal = mesh->GetNumberOfCells() == mesh->GetCellTypes()->Size();
+  for (typename TMesh::CellIdentifier cellId = 0; equal && cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    typename TMesh::CellAutoPointer cell;
+    mesh->GetCell(cellId, cell);
+    const typename TMesh::CellView view = mesh->GetCellView(cellId);
+    equal = cell->GetType() == view.GetType() && cell->GetNumberOfPoints() == view.GetNumberOfPoints() &&
+            std::equal(view.PointIdsBegin(), view.PointIdsEnd(), cell->PointIdsBegin());
+    if (!equal)
+    {
+      std::cerr << "Cell " << cellId << " of type " << cell->GetType() << " does not match its view of type "
+                << view.GetType() << std::endl;
+    }
+  }
+  return equal;
+}
+
+template <typename TMesh>
+int
+MeshCellsConnectivityTest()
+{
+  using MeshType = TMesh;
+
+  // A triangle, a quadrilateral, a polyline, a vertex, a polygon and a
+  // second triangle.
+  const std::vector<itk::CellGeometryEnum> types = {
+    itk::CellGeometryEnum::TRIANGLE_CELL, itk::CellGeometryEnum::QUADRILATERAL_CELL,
+    itk::CellGeometryEnum::POLYLINE_CELL, itk::CellGeometryEnum::VERTEX_CELL,
+    itk::CellGeometryEnum::POLYGON_CELL,  itk::CellGeometryEnum::TRIANGLE_CELL
+  };
+  const std::vector<itk::SizeValueType>                 offsets = { 0, 3, 7, 10, 11, 16, 19 };
+  const std::vector<typename MeshType::PointIdentifier> connectivity = { 0, 1, 2, 0, 1, 3, 2, 4, 5, 6, 6,
+                                                                         0, 2, 4, 6, 5, 1, 3, 5 };
+
+  auto cellTypes = MeshType::CellTypesContainer::New();
+  cellTypes->CastToSTLContainer() = types;
+  auto cellOffsets = MeshType::CellOffsetsContainer::New();
+  cellOffsets->CastToSTLContainer() = offsets;
+  auto cellConnectivity = MeshType::CellConnectivityContainer::New();
+  cellConnectivity->CastToSTLContainer() = connectivity;
+
+  auto mesh = MeshType::New();
+  for (typename MeshType::PointIdentifier id = 0; id < 7; ++id)
+  {
+    typename MeshType::PointType point;
+    point[0] = static_cast<float>(id % 3);
+    point[1] = static_cast<float>(id / 3);
+    point[2] = 0.0f;
+    mesh->SetPoint(id, point);
+  }
+  ITK_TEST_EXPECT_TRUE(mesh->GetCellTypes() == nullptr);
+  ITK_TRY_EXPECT_EXCEPTION(mesh->GetCellView(0));
+
+  mesh->SetCellsConnectivity(cellTypes, cellOffsets, cellConnectivity);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), 6);
+  ITK_TEST_EXPECT_TRUE(mesh->GetCellTypes() == cellTypes.GetPointer());
+  ITK_TEST_EXPECT_TRUE(mesh->GetCellOffsets() == cellOffsets.GetPointer());
+  ITK_TEST_EXPECT_TRUE(mesh->GetCellConnectivity() == cellConnectivity.GetPointer());
+  if (!CheckCells<MeshType>(mesh))
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellView(4).GetNumberOfPoints(), 5);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellView(4).GetPointId(3), 6);
+  ITK_TRY_EXPECT_EXCEPTION(mesh->GetCellView(6));
+
+  // The cells are used as any other cells
+  mesh->BuildCellLinks();
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellLinks()->ElementAt(6).size(), 3);
+  std::cout << mesh << std::endl;
+
+  // The cells remain valid in a mesh they are grafted to
+  auto grafted = MeshType::New();
+  grafted->Graft(mesh);
+  mesh = nullptr;
+  if (!CheckCells<MeshType>(grafted))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Setting a cell discards the arrays, the other cells remain
+  {
+    typename MeshType::CellAutoPointer cell;
+    cell.TakeOwnership(new typename MeshType::OutputLineCellType);
+    cell->SetPointId(0, 3);
+    cell->SetPointId(1, 4);
+    grafted->SetCell(6, cell);
+  }
+  ITK_TEST_EXPECT_TRUE(grafted->GetCellTypes() == nullptr);
+  ITK_TRY_EXPECT_EXCEPTION(grafted->GetCellView(0));
+  ITK_TEST_EXPECT_EQUAL(grafted->GetNumberOfCells(), 7);
+  {
+    typename MeshType::CellAutoPointer cell;
+    grafted->GetCell(5, cell);
+    ITK_TEST_EXPECT_EQUAL(cell->GetPointIds()[2], 5);
+  }
+
+  // Inconsistent arrays are rejected, and leave the mesh unchanged
+  auto badConnectivity = MeshType::CellConnectivityContainer::New();
+  badConnectivity->CastToSTLContainer().assign(connectivity.cbegin(), connectivity.cend() - 1);
+  ITK_TRY_EXPECT_EXCEPTION(grafted->SetCellsConnectivity(cellTypes, cellOffsets, badConnectivity));
+
+  auto badOffsets = MeshType::CellOffsetsContainer::New();
+  badOffsets->CastToSTLContainer() = { 0, 2, 7, 10, 11, 16, 19 };
+  ITK_TRY_EXPECT_EXCEPTION(grafted->SetCellsConnectivity(cellTypes, badOffsets, cellConnectivity));
+
+  auto badTypes = MeshType::CellTypesContainer::New();
+  badTypes->CastToSTLContainer() = types;
+  badTypes->CastToSTLContainer()[3] = itk::CellGeometryEnum::LAST_ITK_CELL;
+  ITK_TRY_EXPECT_EXCEPTION(grafted->SetCellsConnectivity(badTypes, cellOffsets, cellConnectivity));
+  ITK_TEST_EXPECT_EQUAL(grafted->GetNumberOfCells(), 7);
+
+  // The arrays replace the cells set one by one
+  grafted->SetCellsConnectivity(cellTypes, cellOffsets, cellConnectivity);
+  ITK_TEST_EXPECT_EQUAL(grafted->GetNumberOfCells(), 6);
+  if (!CheckCells<MeshType>(grafted))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The cells remain valid in a mesh sharing their container, after the
+  // mesh which created them is destroyed, and the cells added later are
+  // deleted one by one with the container
+  auto sharing = MeshType::New();
+  sharing->SetCells(grafted->GetCells());
+  grafted = nullptr;
+  {
+    typename MeshType::CellAutoPointer cell;
+    cell.TakeOwnership(new typename MeshType::OutputLineCellType);
+    cell->SetPointId(0, 3);
+    cell->SetPointId(1, 4);
+    sharing->SetCell(6, cell);
+  }
+  ITK_TEST_EXPECT_EQUAL(sharing->GetNumberOfCells(), 7);
+  for (typename MeshType::CellIdentifier cellId = 0; cellId < 6; ++cellId)
+  {
+    typename MeshType::CellAutoPointer cell;
+    sharing->GetCell(cellId, cell);
+    ITK_TEST_EXPECT_EQUAL(cell->GetType(), types[cellId]);
+    ITK_TEST_EXPECT_TRUE(std::equal(cell->PointIdsBegin(),
+                                    cell->PointIdsEnd(),
+                                    connectivity.cbegin() + offsets[cellId],
+                                    connectivity.cbegin() + offsets[cellId + 1]));
+  }
+  sharing = nullptr;
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkMeshCellsConnectivityTest(int, char *[])
+{
+  using StaticMeshType = itk::Mesh<float, 3>;
+  using DynamicMeshType = itk::Mesh<float, 3, itk::DefaultDynamicMeshTraits<float, 3, 3>>;
+
+  int result = MeshCellsConnectivityTest<StaticMeshType>();
+  result += MeshCellsConnectivityTest<DynamicMeshType>();
+
+  std::cout << "Test finished." << std::endl;
+  return result == EXIT_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -105,6 +105,10 @@ public:
   using typename Superclass::CellsContainerConstIterator;
   using typename Superclass::CellsContainerIterator;
 
+  using typename Superclass::CellTypesContainer;
+  using typename Superclass::CellOffsetsContainer;
+  using typename Superclass::CellConnectivityContainer;
+
   using typename Superclass::CellLinksContainer;
   using typename Superclass::CellLinksContainerPointer;
   using typename Superclass::CellLinksContainerIterator;
@@ -320,6 +324,15 @@ public:
   void
   SetCell(CellIdentifier cId, CellAutoPointer & cell);
 
+#if !defined(ITK_WRAPPING_PARSER)
+  /** The cells are added one by one with SetCell(), since they are made
+   * of the edges of the mesh. The contiguous cell arrays are not kept. */
+  void
+  SetCellsConnectivity(CellTypesContainer *        types,
+                       CellOffsetsContainer *      offsets,
+                       CellConnectivityContainer * connectivity) override;
+#endif
+
   /** Methods to simplify point/edge insertion/search. */
   virtual PointIdentifier
   FindFirstUnusedPointIndex();
@@ -467,6 +480,10 @@ protected:
   CellsContainerPointer m_EdgeCellsContainer{};
 
 private:
+  /** Delete all the edges and faces, but not the points. */
+  void
+  ClearCells();
+
   CellIdentifier m_NumberOfFaces{};
   CellIdentifier m_NumberOfEdges{};
 
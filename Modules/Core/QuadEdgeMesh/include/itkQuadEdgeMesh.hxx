@@ -50,6 +50,24 @@ QuadEdgeMesh<TPixel, VDimension, TTraits>::Initialize()
 template <typename TPixel, unsigned int VDimension, typename TTraits>
 void
 QuadEdgeMesh<TPixel, VDimension, TTraits>::Clear()
+{
+  this->ClearCells();
+
+  // Clear the points potentially left behind by LightWeightDeleteEdge():
+  if (this->GetPoints())
+  {
+    this->GetPoints()->clear();
+  }
+  this->ClearFreePointAndCellIndexesLists(); // to start at index 0
+}
+
+/**
+ * Delete all the edges of this mesh, which as a side effect deletes the
+ * adjacent faces, and keep the points
+ */
+template <typename TPixel, unsigned int VDimension, typename TTraits>
+void
+QuadEdgeMesh<TPixel, VDimension, TTraits>::ClearCells()
 {
   if (this->GetEdgeCells())
   {
@@ -62,12 +80,10 @@ QuadEdgeMesh<TPixel, VDimension, TTraits>::Clear()
     }
   }
 
-  // Clear the points potentially left behind by LightWeightDeleteEdge():
-  if (this->GetPoints())
+  while (!this->m_FreeCellIndexes.empty())
   {
-    this->GetPoints()->clear();
+    this->m_FreeCellIndexes.pop();
   }
-  this->ClearFreePointAndCellIndexesLists(); // to start at index 0
 }
 
 template <typename TPixel, unsigned int VDimension, typename TTraits>
@@ -333,6 +349,53 @@ QuadEdgeMesh<TPixel, VDimension, TTraits>::Splice(QEPrimal * a, QEPrimal * b) ->
   return resultingOriginId;
 }
 
+/**
+ */
+template <typename TPixel, unsigned int VDimension, typename TTraits>
+void
+QuadEdgeMesh<TPixel, VDimension, TTraits>::SetCellsConnectivity(CellTypesContainer *        types,
+                                                                CellOffsetsContainer *      offsets,
+                                                                CellConnectivityContainer * connectivity)
+{
+  if (types == nullptr || offsets == nullptr || connectivity == nullptr)
+  {
+    itkExceptionMacro("The cell types, offsets and connectivity must all be given");
+  }
+  if (offsets->Size() != types->Size() + 1 || offsets->ElementAt(types->Size()) != connectivity->Size())
+  {
+    itkExceptionMacro("Expected " << types->Size() + 1 << " cell offsets, the last one being the connectivity size "
+                                  << connectivity->Size() << ", got " << offsets->Size() << " cell offsets");
+  }
+
+  // Release the existing edges and faces, but keep the points
+  this->ClearCells();
+
+  // Add the edges and faces as SetCell() does, without creating the cells
+  const PointIdentifier * pointIds = connectivity->CastToSTLConstContainer().data();
+  for (CellIdentifier cellId = 0; cellId < types->Size(); ++cellId)
+  {
+    const PointIdentifier * first = pointIds + offsets->ElementAt(cellId);
+    const PointIdentifier * last = pointIds + offsets->ElementAt(cellId + 1);
+    if (last - first == 2)
+    {
+      this->AddEdge(first[1], first[0]);
+      continue;
+    }
+    switch (types->ElementAt(cellId))
+    {
+      case CellGeometryEnum::TRIANGLE_CELL:
+      case CellGeometryEnum::QUADRILATERAL_CELL:
+      case CellGeometryEnum::POLYGON_CELL:
+      case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+        this->AddFace(PointIdList(first, last));
+        break;
+      default:
+        break;
+    }
+  }
+  this->Modified();
+}
+
 /**
  */
 template <typename TPixel, unsigned int VDimension, typename TTraits>
@@ -0,0 +1,67 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkQuadEdgeMesh.h"
+#include "itkTestingMacros.h"
+
+int
+itkQuadEdgeMeshSetCellsConnectivityTest(int, char *[])
+{
+  using MeshType = itk::QuadEdgeMesh<double, 3>;
+
+  auto mesh = MeshType::New();
+  for (MeshType::PointIdentifier id = 0; id < 5; ++id)
+  {
+    MeshType::PointType point;
+    point[0] = static_cast<double>(id % 2);
+    point[1] = static_cast<double>(id / 2);
+    point[2] = 0.0;
+    mesh->SetPoint(id, point);
+  }
+
+  // Two triangles, a line, and a vertex that is not part of the mesh edges
+  auto cellTypes = MeshType::CellTypesContainer::New();
+  cellTypes->CastToSTLContainer() = { itk::CellGeometryEnum::TRIANGLE_CELL,
+                                      itk::CellGeometryEnum::TRIANGLE_CELL,
+                                      itk::CellGeometryEnum::LINE_CELL,
+                                      itk::CellGeometryEnum::VERTEX_CELL };
+  auto cellOffsets = MeshType::CellOffsetsContainer::New();
+  cellOffsets->CastToSTLContainer() = { 0, 3, 6, 8, 9 };
+  auto cellConnectivity = MeshType::CellConnectivityContainer::New();
+  cellConnectivity->CastToSTLContainer() = { 0, 1, 3, 0, 3, 2, 2, 4, 4 };
+
+  // Setting the cells again releases the previous edges and faces
+  for (int i = 0; i < 2; ++i)
+  {
+    mesh->SetCellsConnectivity(cellTypes, cellOffsets, cellConnectivity);
+    ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfFaces(), 2);
+    ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfEdges(), 6);
+    ITK_TEST_EXPECT_EQUAL(mesh->ComputeNumberOfFaces(), 2);
+    ITK_TEST_EXPECT_EQUAL(mesh->ComputeNumberOfEdges(), 6);
+    ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfPoints(), 5);
+    ITK_TEST_EXPECT_TRUE(mesh->GetCellTypes() == nullptr);
+  }
+
+  auto badOffsets = MeshType::CellOffsetsContainer::New();
+  badOffsets->CastToSTLContainer() = { 0, 3, 6, 8 };
+  ITK_TRY_EXPECT_EXCEPTION(mesh->SetCellsConnectivity(cellTypes, badOffsets, cellConnectivity));
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfFaces(), 2);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -37,6 +37,12 @@ namespace itk
  * convolution theorem to accelerate the convolution computation when
  * the kernel is large.
  *
+ * When Tiling is on, the output is computed tile by tile with the
+ * overlap-save method, which bounds the memory used by the Fourier
+ * transforms and keeps their working set small for large images convolved
+ * with small kernels. The deconvolution filters derived from this class
+ * compute their output in a single piece and ignore this setting.
+ *
  * \warning This filter ignores the spacing, origin, and orientation
  * of the kernel image and treats them as identical to those in the
  * input image.
@@ -111,6 +117,29 @@ public:
   itkSetMacro(SizeGreatestPrimeFactor, SizeValueType);
   itkGetMacro(SizeGreatestPrimeFactor, SizeValueType);
 
+  /** Set/Get whether the output is computed tile by tile with the
+   * overlap-save method. Each output tile is computed from the
+   * corresponding input tile padded by the kernel radius, so that the
+   * memory used by the Fourier transforms depends on the tile size rather
+   * than on the size of the requested region, and the kernel is
+   * transformed only once for all the tiles. This is most useful for large
+   * images and small kernels. Off by default. */
+  itkSetMacro(Tiling, bool);
+  itkGetConstMacro(Tiling, bool);
+  itkBooleanMacro(Tiling);
+
+  /** Set/Get the size of the output tiles when Tiling is on. Along the
+   * dimensions where it is zero, the tile size is selected from the kernel
+   * size and TileMemoryLimit. Zero by default. */
+  itkSetMacro(TileSize, OutputSizeType);
+  itkGetConstReferenceMacro(TileSize, OutputSizeType);
+
+  /** Set/Get the approximate number of bytes used by the Fourier
+   * transforms of a tile, when the tile size is selected automatically.
+   * 256 MiB by default. */
+  itkSetMacro(TileMemoryLimit, SizeValueType);
+  itkGetConstMacro(TileMemoryLimit, SizeValueType);
+
 protected:
   FFTConvolutionImageFilter();
   ~FFTConvolutionImageFilter() override = default;
@@ -133,6 +162,23 @@ protected:
   void
   GenerateData() override;
 
+  /** Compute the output requested region tile by tile, with the
+   * overlap-save method. */
+  void
+  GenerateTiledData();
+
+  /** Select the size of the output tiles for an output requested region
+   * of the given size. The padded tile sizes are chosen to minimize the
+   * number of operations of the Fourier transforms per output pixel,
+   * within TileMemoryLimit. */
+  OutputSizeType
+  ComputeTileSize(const OutputSizeType & requestedSize) const;
+
+  /** Get the smallest size greater or equal to size whose greatest prime
+   * factor is at most SizeGreatestPrimeFactor. */
+  SizeValueType
+  GetFFTSize(SizeValueType size) const;
+
   /** Prepare the input images for operations in the Fourier
    * domain. This includes resizing the input and kernel images,
    * normalizing the kernel if requested, shifting the kernel, and
@@ -209,6 +255,10 @@ private:
   SizeValueType      m_SizeGreatestPrimeFactor{};
   InternalSizeType   m_FFTPadSize{ { 0 } };
   InternalRegionType m_PaddedInputRegion{};
+
+  bool           m_Tiling{ false };
+  OutputSizeType m_TileSize{ { 0 } };
+  SizeValueType  m_TileMemoryLimit{ 256 * 1024 * 1024 };
 };
 } // namespace itk
 
@@ -25,7 +25,9 @@
 #include "itkCyclicShiftImageFilter.h"
 #include "itkExtractImageFilter.h"
 #include "itkFFTPadImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageBase.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
 #include "itkMath.h"
@@ -82,6 +84,12 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage, ty
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
 {
+  if (m_Tiling)
+  {
+    this->GenerateTiledData();
+    return;
+  }
+
   // Create a process accumulator for tracking the progress of this minipipeline
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
@@ -112,6 +120,206 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   this->ProduceOutput(multiplyFilter->GetOutput(), progress, 0.2);
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateTiledData()
+{
+  auto progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  this->AllocateOutputs();
+
+  const InputImageType *        input = this->GetInput();
+  OutputImageType *             output = this->GetOutput();
+  const BoundaryConditionType * boundaryCondition = this->GetBoundaryCondition();
+  const InputRegionType         inputBufferedRegion = input->GetBufferedRegion();
+  const OutputRegionType        outputRequestedRegion = output->GetRequestedRegion();
+  const KernelSizeType          kernelRadius = this->GetKernelRadius();
+  const OutputSizeType          tileSize = this->ComputeTileSize(outputRequestedRegion.GetSize());
+
+  // All the tiles are padded by the kernel radius, and then for the FFT,
+  // to the same size, so that the kernel is transformed only once.
+  InternalSizeType fftSize;
+  OutputSizeType   numberOfTiles;
+  SizeValueType    totalNumberOfTiles = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    const SizeValueType paddedTileSize = tileSize[dim] + 2 * kernelRadius[dim];
+    fftSize[dim] = this->GetFFTSize(paddedTileSize);
+    m_FFTPadSize[dim] = fftSize[dim] - paddedTileSize;
+    numberOfTiles[dim] = (outputRequestedRegion.GetSize()[dim] + tileSize[dim] - 1) / tileSize[dim];
+    totalNumberOfTiles *= numberOfTiles[dim];
+  }
+  m_PaddedInputRegion = InternalRegionType(fftSize);
+
+  const float                     kernelProgressWeight = 0.1f;
+  InternalComplexImagePointerType kernel = nullptr;
+  this->PrepareKernel(this->GetKernelImage(), kernel, progress, kernelProgressWeight);
+  const InternalComplexType * kernelBuffer = kernel->GetBufferPointer();
+
+  auto paddedTile = InternalImageType::New();
+  paddedTile->SetRegions(m_PaddedInputRegion);
+  paddedTile->Allocate();
+
+  for (SizeValueType tile = 0; tile < totalNumberOfTiles; ++tile)
+  {
+    // Locate the tile in the output requested region, and the part of the
+    // input it depends on.
+    OutputRegionType tileRegion;
+    InputRegionType  tileInputRegion;
+    SizeValueType    tileNumber = tile;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const SizeValueType tilePosition = tileNumber % numberOfTiles[dim];
+      tileNumber /= numberOfTiles[dim];
+      const SizeValueType offset = tilePosition * tileSize[dim];
+      tileRegion.SetIndex(dim, outputRequestedRegion.GetIndex(dim) + static_cast<IndexValueType>(offset));
+      tileRegion.SetSize(dim, std::min(tileSize[dim], outputRequestedRegion.GetSize(dim) - offset));
+      tileInputRegion.SetIndex(dim, tileRegion.GetIndex(dim) - static_cast<IndexValueType>(kernelRadius[dim]));
+      tileInputRegion.SetSize(dim, tileRegion.GetSize(dim) + 2 * kernelRadius[dim]);
+    }
+
+    // Copy the input tile to the beginning of the padded tile. The rest of
+    // the padded tile only contributes to discarded output pixels, but it
+    // is set to zero to keep the transforms finite.
+    const InternalRegionType paddedTileInputRegion(tileInputRegion.GetSize());
+    if (paddedTileInputRegion != m_PaddedInputRegion)
+    {
+      paddedTile->FillBuffer(TInternalPrecision{});
+    }
+    if (inputBufferedRegion.IsInside(tileInputRegion))
+    {
+      ImageAlgorithm::Copy(input, paddedTile.GetPointer(), tileInputRegion, paddedTileInputRegion);
+    }
+    else
+    {
+      for (ImageRegionIteratorWithIndex<InternalImageType> it(paddedTile, paddedTileInputRegion); !it.IsAtEnd(); ++it)
+      {
+        InputIndexType index;
+        for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+        {
+          index[dim] = tileInputRegion.GetIndex(dim) + it.GetIndex()[dim];
+        }
+        it.Set(static_cast<TInternalPrecision>(boundaryCondition->GetPixel(index, input)));
+      }
+    }
+    paddedTile->Modified();
+
+    auto tileFFTFilter = FFTFilterType::New();
+    tileFFTFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    tileFFTFilter->SetInput(paddedTile);
+    tileFFTFilter->Update();
+    InternalComplexImagePointerType tileSpectrum = tileFFTFilter->GetOutput();
+    tileSpectrum->DisconnectPipeline();
+    tileFFTFilter = nullptr;
+
+    // Convolve in place.
+    InternalComplexType * tileSpectrumBuffer = tileSpectrum->GetBufferPointer();
+    const SizeValueType   numberOfSpectrumPixels = tileSpectrum->GetBufferedRegion().GetNumberOfPixels();
+    for (SizeValueType i = 0; i < numberOfSpectrumPixels; ++i)
+    {
+      tileSpectrumBuffer[i] *= kernelBuffer[i];
+    }
+
+    auto tileIFFTFilter = IFFTFilterType::New();
+    tileIFFTFilter->SetActualXDimensionIsOdd(this->GetXDimensionIsOdd());
+    tileIFFTFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    tileIFFTFilter->SetInput(tileSpectrum);
+    tileIFFTFilter->Update();
+
+    // Save the pixels of the output tile, which start at the kernel radius.
+    InternalIndexType validIndex;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      validIndex[dim] = static_cast<IndexValueType>(kernelRadius[dim]);
+    }
+    ImageAlgorithm::Copy(tileIFFTFilter->GetOutput(),
+                         output,
+                         InternalRegionType(validIndex, tileRegion.GetSize()),
+                         tileRegion);
+
+    this->UpdateProgress(kernelProgressWeight + (1.0f - kernelProgressWeight) * static_cast<float>(tile + 1) /
+                                                  static_cast<float>(totalNumberOfTiles));
+  }
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+auto
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::ComputeTileSize(
+  const OutputSizeType & requestedSize) const -> OutputSizeType
+{
+  const KernelSizeType kernelRadius = this->GetKernelRadius();
+
+  // A padded tile needs a real buffer, its half Hermitian spectrum, the
+  // kernel spectrum and the inverse transform output.
+  const double bytesPerPaddedPixel = 4.0 * sizeof(TInternalPrecision);
+
+  // Grow the tiles as multiples of the kernel size until the cost of the
+  // transforms per output pixel stops decreasing, or the tiles do not fit
+  // in the memory limit anymore. The tiles of the first scale are always
+  // accepted.
+  OutputSizeType bestTileSize = requestedSize;
+  double         bestCost = NumericTraits<double>::max();
+  for (SizeValueType scale = 1;; scale *= 2)
+  {
+    OutputSizeType tileSize;
+    double         numberOfPaddedPixels = 1.0;
+    double         numberOfTilePixels = 1.0;
+    bool           coversRequestedSize = true;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const SizeValueType kernelDiameter = 2 * kernelRadius[dim];
+      SizeValueType       size = m_TileSize[dim] > 0 ? m_TileSize[dim] : scale * (kernelDiameter + 1);
+      size = std::min(size, requestedSize[dim]);
+      if (m_TileSize[dim] == 0)
+      {
+        // Use the FFT padding for more output pixels.
+        size = std::min(this->GetFFTSize(size + kernelDiameter) - kernelDiameter, requestedSize[dim]);
+      }
+      tileSize[dim] = size;
+      coversRequestedSize = coversRequestedSize && size == requestedSize[dim];
+      numberOfPaddedPixels *= static_cast<double>(this->GetFFTSize(size + kernelDiameter));
+      numberOfTilePixels *= static_cast<double>(size);
+    }
+
+    if (scale > 1 && numberOfPaddedPixels * bytesPerPaddedPixel > static_cast<double>(m_TileMemoryLimit))
+    {
+      break;
+    }
+    const double cost = numberOfPaddedPixels * std::log2(numberOfPaddedPixels + 1.0) / numberOfTilePixels;
+    if (cost < bestCost)
+    {
+      bestCost = cost;
+      bestTileSize = tileSize;
+    }
+    if (coversRequestedSize)
+    {
+      break;
+    }
+  }
+  return bestTileSize;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+auto
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GetFFTSize(
+  SizeValueType size) const -> SizeValueType
+{
+  // Same rule as FFTPadImageFilter.
+  if (m_SizeGreatestPrimeFactor > 1)
+  {
+    while (Math::GreatestPrimeFactor(size) > m_SizeGreatestPrimeFactor)
+    {
+      ++size;
+    }
+  }
+  else if (m_SizeGreatestPrimeFactor == 1)
+  {
+    size += size % 2;
+  }
+  return size;
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrepareInputs(
@@ -525,6 +733,10 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "SizeGreatestPrimeFactor: " << m_SizeGreatestPrimeFactor << std::endl;
+  itkPrintSelfBooleanMacro(Tiling);
+  os << indent << "TileSize: " << static_cast<typename NumericTraits<OutputSizeType>::PrintType>(m_TileSize)
+     << std::endl;
+  os << indent << "TileMemoryLimit: " << m_TileMemoryLimit << std::endl;
 }
 
 } // namespace itk
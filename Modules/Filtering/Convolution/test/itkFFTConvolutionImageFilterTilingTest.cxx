@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkRandomImageSource.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using ConvolutionFilterType = itk::FFTConvolutionImageFilter<ImageType>;
+
+ImageType::Pointer
+MakeImage(itk::SizeValueType sizeX, itk::SizeValueType sizeY)
+{
+  using SourceType = itk::RandomImageSource<ImageType>;
+  auto                source = SourceType::New();
+  ImageType::SizeType size = { { sizeX, sizeY } };
+  source->SetSize(size);
+  source->SetMin(-1.0);
+  source->SetMax(1.0);
+  source->Update();
+  return source->GetOutput();
+}
+
+bool
+SameImages(const ImageType * image1, const ImageType * image2)
+{
+  if (image1->GetBufferedRegion() != image2->GetBufferedRegion())
+  {
+    std::cerr << "Different regions: " << image1->GetBufferedRegion() << image2->GetBufferedRegion() << std::endl;
+    return false;
+  }
+  itk::ImageRegionConstIterator<ImageType> it1(image1, image1->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> it2(image2, image2->GetBufferedRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (std::abs(it1.Get() - it2.Get()) > 1e-4)
+    {
+      std::cerr << "Different pixels at " << it1.GetIndex() << ": " << it1.Get() << " != " << it2.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Convolve image with kernel in one piece, and tile by tile.
+bool
+CompareTiledConvolution(const ImageType *                              image,
+                        const ImageType *                              kernel,
+                        ConvolutionFilterType::BoundaryConditionType * boundaryCondition,
+                        const ConvolutionFilterType::OutputSizeType &  tileSize,
+                        itk::SizeValueType                             tileMemoryLimit,
+                        bool                                           normalize,
+                        bool                                           valid,
+                        unsigned int                                   numberOfStreamDivisions)
+{
+  auto reference = ConvolutionFilterType::New();
+  reference->SetInput(image);
+  reference->SetKernelImage(kernel);
+  reference->SetNormalize(normalize);
+  auto tiled = ConvolutionFilterType::New();
+  tiled->SetInput(image);
+  tiled->SetKernelImage(kernel);
+  tiled->SetNormalize(normalize);
+  tiled->TilingOn();
+  tiled->SetTileSize(tileSize);
+  tiled->SetTileMemoryLimit(tileMemoryLimit);
+  if (boundaryCondition)
+  {
+    reference->SetBoundaryCondition(boundaryCondition);
+    tiled->SetBoundaryCondition(boundaryCondition);
+  }
+  if (valid)
+  {
+    reference->SetOutputRegionModeToValid();
+    tiled->SetOutputRegionModeToValid();
+  }
+  reference->Update();
+
+  using StreamingFilterType = itk::StreamingImageFilter<ImageType, ImageType>;
+  auto streamer = StreamingFilterType::New();
+  streamer->SetInput(tiled->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  streamer->Update();
+
+  return SameImages(reference->GetOutput(), streamer->GetOutput());
+}
+} // namespace
+
+int
+itkFFTConvolutionImageFilterTilingTest(int, char *[])
+{
+  auto filter = ConvolutionFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, FFTConvolutionImageFilter, ConvolutionImageFilterBase);
+
+  ITK_TEST_SET_GET_BOOLEAN(filter, Tiling, true);
+  ConvolutionFilterType::OutputSizeType tileSize = { { 16, 10 } };
+  filter->SetTileSize(tileSize);
+  ITK_TEST_SET_GET_VALUE(tileSize, filter->GetTileSize());
+  constexpr itk::SizeValueType tileMemoryLimit = 1024 * 1024;
+  filter->SetTileMemoryLimit(tileMemoryLimit);
+  ITK_TEST_SET_GET_VALUE(tileMemoryLimit, filter->GetTileMemoryLimit());
+
+  const ImageType::Pointer image = MakeImage(97, 83);
+  const ImageType::Pointer oddKernel = MakeImage(7, 5);
+  const ImageType::Pointer evenKernel = MakeImage(6, 4);
+
+  const ConvolutionFilterType::OutputSizeType automaticTileSize{ { 0, 0 } };
+  const ConvolutionFilterType::OutputSizeType mixedTileSize{ { 0, 13 } };
+
+  itk::ConstantBoundaryCondition<ImageType> constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(0.5f);
+  itk::PeriodicBoundaryCondition<ImageType> periodicBoundaryCondition;
+
+  // Explicit, automatic and partly automatic tile sizes. A small memory
+  // limit forces several automatic tiles.
+  ITK_TEST_EXPECT_TRUE(CompareTiledConvolution(image, oddKernel, nullptr, tileSize, 0, false, false, 1));
+  ITK_TEST_EXPECT_TRUE(CompareTiledConvolution(image, evenKernel, nullptr, tileSize, 0, false, false, 1));
+  ITK_TEST_EXPECT_TRUE(CompareTiledConvolution(image, oddKernel, nullptr, automaticTileSize, 4096, false, false, 1));
+  ITK_TEST_EXPECT_TRUE(
+    CompareTiledConvolution(image, oddKernel, nullptr, automaticTileSize, tileMemoryLimit, false, false, 1));
+  ITK_TEST_EXPECT_TRUE(CompareTiledConvolution(image, evenKernel, nullptr, mixedTileSize, 4096, true, false, 1));
+
+  // Boundary conditions.
+  ITK_TEST_EXPECT_TRUE(
+    CompareTiledConvolution(image, oddKernel, &constantBoundaryCondition, tileSize, 0, false, false, 1));
+  ITK_TEST_EXPECT_TRUE(
+    CompareTiledConvolution(image, evenKernel, &periodicBoundaryCondition, tileSize, 0, false, false, 1));
+
+  // Valid output region, and streamed requested regions.
+  ITK_TEST_EXPECT_TRUE(CompareTiledConvolution(image, oddKernel, nullptr, tileSize, 0, false, true, 1));
+  ITK_TEST_EXPECT_TRUE(CompareTiledConvolution(image, oddKernel, nullptr, tileSize, 0, false, false, 5));
+  ITK_TEST_EXPECT_TRUE(CompareTiledConvolution(image, evenKernel, nullptr, automaticTileSize, 4096, true, true, 3));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
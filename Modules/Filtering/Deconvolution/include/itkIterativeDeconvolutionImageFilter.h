@@ -130,6 +130,14 @@ protected:
   void
   GenerateData() override;
 
+  /** Split [0, size) in numberOfChunks contiguous ranges, and call
+   * function(chunk, first, end) for each range in parallel. Subclasses use
+   * it to compute the pixel-wise steps of an iteration in a single pass
+   * over their buffers. */
+  template <typename TFunction>
+  void
+  ParallelizeBuffer(SizeValueType size, SizeValueType numberOfChunks, const TFunction & function);
+
   /** Discrete Fourier transform of the padded kernel. */
   InternalComplexImagePointerType m_TransferFunction{};
 
@@ -138,6 +138,24 @@ IterativeDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInte
   this->Finish(progress, 0.1f);
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+template <typename TFunction>
+void
+IterativeDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::ParallelizeBuffer(
+  SizeValueType     size,
+  SizeValueType     numberOfChunks,
+  const TFunction & function)
+{
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [size, numberOfChunks, &function](SizeValueType chunk) {
+      function(chunk, size * chunk / numberOfChunks, size * (chunk + 1) / numberOfChunks);
+    },
+    nullptr);
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 IterativeDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrintSelf(
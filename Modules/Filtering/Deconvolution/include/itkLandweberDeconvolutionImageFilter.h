@@ -21,7 +21,6 @@
 #include "itkIterativeDeconvolutionImageFilter.h"
 
 #include "itkComplexConjugateImageAdaptor.h"
-#include "itkTernaryGeneratorImageFilter.h"
 
 namespace itk
 {
@@ -78,6 +77,9 @@ public:
  * algorithm that enforces a positivity constraint on each
  * intermediate solution, see ProjectedLandweberDeconvolutionImageFilter.
  *
+ * Each iteration reuses the same Fourier transform filters, and updates
+ * the transform of the estimate in a single pass over the buffers.
+ *
  * This code was adapted from the Insight Journal contribution:
  *
  * "Deconvolution: infrastructure and reference algorithms"
@@ -156,13 +158,11 @@ private:
 
   using LandweberFunctor =
     Functor::LandweberMethod<InternalComplexType, InternalComplexType, InternalComplexType, InternalComplexType>;
-  using LandweberFilterType = TernaryGeneratorImageFilter<InternalComplexImageType,
-                                                          InternalComplexImageType,
-                                                          InternalComplexImageType,
-                                                          InternalComplexImageType>;
 
-  typename LandweberFilterType::Pointer m_LandweberFilter{};
-  typename IFFTFilterType::Pointer      m_IFFTFilter{};
+  /** The Fourier transforms of the iterations. The inverse transform takes
+   * the output of the forward transform as input. */
+  typename FFTFilterType::Pointer  m_FFTFilter{};
+  typename IFFTFilterType::Pointer m_IFFTFilter{};
 };
 
 } // end namespace itk
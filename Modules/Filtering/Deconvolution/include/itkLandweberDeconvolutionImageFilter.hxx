@@ -18,6 +18,7 @@
 #ifndef itkLandweberDeconvolutionImageFilter_hxx
 #define itkLandweberDeconvolutionImageFilter_hxx
 
+#include <algorithm>
 
 namespace itk
 {
@@ -48,46 +49,58 @@ LandweberDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInte
 
   this->PrepareInput(this->GetInput(), m_TransformedInput, progress, 0.5f * progressWeight);
 
-  // Set up minipipeline to compute estimate at each iteration
-  m_LandweberFilter = LandweberFilterType::New();
-
-  LandweberFunctor functor;
-  functor.m_Alpha = m_Alpha;
-  m_LandweberFilter->SetFunctor(functor);
-  m_LandweberFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  // Transform of current estimate will be set as input 1 in Iteration()
-  m_LandweberFilter->SetInput2(this->m_TransferFunction);
-  m_LandweberFilter->SetInput3(m_TransformedInput);
-  m_LandweberFilter->ReleaseDataFlagOn();
-  progress->RegisterInternalFilter(m_LandweberFilter, 0.3f * iterationProgressWeight);
+  // The transforms are run once per iteration, and keep their output
+  // buffers from one iteration to the next.
+  m_FFTFilter = FFTFilterType::New();
+  m_FFTFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  progress->RegisterInternalFilter(m_FFTFilter, 0.4f * iterationProgressWeight);
 
   m_IFFTFilter = IFFTFilterType::New();
   m_IFFTFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
   m_IFFTFilter->SetActualXDimensionIsOdd(this->GetXDimensionIsOdd());
-  m_IFFTFilter->SetInput(m_LandweberFilter->GetOutput());
-  m_IFFTFilter->ReleaseDataFlagOn();
-  progress->RegisterInternalFilter(m_IFFTFilter, 0.7f * iterationProgressWeight);
+  m_IFFTFilter->SetInput(m_FFTFilter->GetOutput());
+  progress->RegisterInternalFilter(m_IFFTFilter, 0.5f * iterationProgressWeight);
 }
 
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 LandweberDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::Iteration(
-  ProgressAccumulator * progress,
-  float                 iterationProgressWeight)
+  ProgressAccumulator * itkNotUsed(progress),
+  float                 itkNotUsed(iterationProgressWeight))
 {
-  // Set up minipipeline to compute the new estimate
-  InternalComplexImagePointerType transformedEstimate;
-  this->TransformPaddedInput(this->m_CurrentEstimate, transformedEstimate, progress, 0.1f * iterationProgressWeight);
+  InternalImageType * currentEstimate = this->m_CurrentEstimate;
+  currentEstimate->Modified();
+  m_FFTFilter->SetInput(currentEstimate);
+  m_FFTFilter->Update();
 
-  // Set the inputs
-  m_LandweberFilter->SetInput1(transformedEstimate);
-
-  // Trigger the update
-  m_IFFTFilter->UpdateLargestPossibleRegion();
+  // Update the transform of the estimate in place.
+  LandweberFunctor functor;
+  functor.m_Alpha = m_Alpha;
+  InternalComplexType *       transformedEstimate = m_FFTFilter->GetOutput()->GetBufferPointer();
+  const InternalComplexType * transferFunction = this->m_TransferFunction->GetBufferPointer();
+  const InternalComplexType * transformedInput = m_TransformedInput->GetBufferPointer();
+
+  const SizeValueType numberOfChunks = std::max(1u, this->GetNumberOfWorkUnits());
+  this->ParallelizeBuffer(m_FFTFilter->GetOutput()->GetBufferedRegion().GetNumberOfPixels(),
+                          numberOfChunks,
+                          [=](SizeValueType, SizeValueType first, SizeValueType end) {
+                            for (SizeValueType i = first; i < end; ++i)
+                            {
+                              transformedEstimate[i] =
+                                functor(transformedEstimate[i], transferFunction[i], transformedInput[i]);
+                            }
+                          });
+  m_IFFTFilter->Update();
 
   // Store the current estimate
-  this->m_CurrentEstimate = m_IFFTFilter->GetOutput();
-  this->m_CurrentEstimate->DisconnectPipeline();
+  const TInternalPrecision * newEstimate = m_IFFTFilter->GetOutput()->GetBufferPointer();
+  TInternalPrecision *       estimate = currentEstimate->GetBufferPointer();
+  this->ParallelizeBuffer(currentEstimate->GetBufferedRegion().GetNumberOfPixels(),
+                          numberOfChunks,
+                          [=](SizeValueType, SizeValueType first, SizeValueType end) {
+                            std::copy(newEstimate + first, newEstimate + end, estimate + first);
+                          });
+  currentEstimate->Modified();
 }
 
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
@@ -98,7 +111,8 @@ LandweberDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInte
 {
   this->Superclass::Finish(progress, progressWeight);
 
-  m_LandweberFilter = nullptr;
+  m_TransformedInput = nullptr;
+  m_FFTFilter = nullptr;
   m_IFFTFilter = nullptr;
 }
 
@@ -20,8 +20,6 @@
 
 #include "itkIterativeDeconvolutionImageFilter.h"
 
-#include "itkThresholdImageFilter.h"
-
 namespace itk
 {
 /**
@@ -76,16 +74,8 @@ protected:
   ProjectedIterativeDeconvolutionImageFilter();
   ~ProjectedIterativeDeconvolutionImageFilter() override;
 
-  void
-  Initialize(ProgressAccumulator * progress, float progressWeight, float iterationProgressWeight) override;
-
   void
   Iteration(ProgressAccumulator * progress, float iterationProgressWeight) override;
-
-private:
-  using ProjectionFilterType = ThresholdImageFilter<InternalImageType>;
-
-  typename ProjectionFilterType::Pointer m_ProjectionFilter{};
 };
 } // namespace itk
 
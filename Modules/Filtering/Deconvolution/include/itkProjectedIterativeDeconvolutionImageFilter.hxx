@@ -18,34 +18,16 @@
 #ifndef itkProjectedIterativeDeconvolutionImageFilter_hxx
 #define itkProjectedIterativeDeconvolutionImageFilter_hxx
 
+#include <algorithm>
 
 namespace itk
 {
 
 template <typename TSuperclass>
-ProjectedIterativeDeconvolutionImageFilter<TSuperclass>::ProjectedIterativeDeconvolutionImageFilter()
-{
-  m_ProjectionFilter = nullptr;
-}
-
-template <typename TSuperclass>
-ProjectedIterativeDeconvolutionImageFilter<TSuperclass>::~ProjectedIterativeDeconvolutionImageFilter()
-{
-  m_ProjectionFilter = nullptr;
-}
+ProjectedIterativeDeconvolutionImageFilter<TSuperclass>::ProjectedIterativeDeconvolutionImageFilter() = default;
 
 template <typename TSuperclass>
-void
-ProjectedIterativeDeconvolutionImageFilter<TSuperclass>::Initialize(ProgressAccumulator * progress,
-                                                                    float                 progressWeight,
-                                                                    float                 iterationProgressWeight)
-{
-  this->Superclass::Initialize(progress, progressWeight, iterationProgressWeight);
-
-  m_ProjectionFilter = ProjectionFilterType::New();
-  typename InternalImageType::PixelType zero{};
-  m_ProjectionFilter->ThresholdBelow(zero);
-}
+ProjectedIterativeDeconvolutionImageFilter<TSuperclass>::~ProjectedIterativeDeconvolutionImageFilter() = default;
 
 template <typename TSuperclass>
 void
@@ -54,10 +36,25 @@ ProjectedIterativeDeconvolutionImageFilter<TSuperclass>::Iteration(ProgressAccum
 {
   this->Superclass::Iteration(progress, iterationProgressWeight);
 
-  m_ProjectionFilter->SetInput(this->m_CurrentEstimate);
-  m_ProjectionFilter->UpdateLargestPossibleRegion();
-  this->m_CurrentEstimate = m_ProjectionFilter->GetOutput();
-  this->m_CurrentEstimate->DisconnectPipeline();
+  // Project the pixels out of [0, max], NaNs included, to zero in place,
+  // as ThresholdImageFilter::ThresholdBelow(0) does.
+  using RealType = typename InternalImageType::PixelType;
+  InternalImageType * currentEstimate = this->m_CurrentEstimate;
+  RealType *          estimate = currentEstimate->GetBufferPointer();
+  const RealType      upper = NumericTraits<RealType>::max();
+
+  const SizeValueType numberOfPixels = currentEstimate->GetBufferedRegion().GetNumberOfPixels();
+  const SizeValueType numberOfChunks = std::max(1u, this->GetNumberOfWorkUnits());
+  this->ParallelizeBuffer(numberOfPixels, numberOfChunks, [=](SizeValueType, SizeValueType first, SizeValueType end) {
+    for (SizeValueType i = first; i < end; ++i)
+    {
+      if (!(estimate[i] >= RealType{} && estimate[i] <= upper))
+      {
+        estimate[i] = RealType{};
+      }
+    }
+  });
+  currentEstimate->Modified();
 }
 
 } // end namespace itk
@@ -20,10 +20,6 @@
 
 #include "itkIterativeDeconvolutionImageFilter.h"
 
-#include "itkComplexConjugateImageAdaptor.h"
-#include "itkDivideOrZeroOutImageFilter.h"
-#include "itkMultiplyImageFilter.h"
-
 namespace itk
 {
 /**
@@ -41,6 +37,18 @@ namespace itk
  * follows a Poisson distribution and that the distribution for each
  * pixel is independent of the other pixels.
  *
+ * Each iteration reuses the same Fourier transform filters and work
+ * buffers, and computes its pixel-wise steps in single passes over the
+ * buffers, so that no image is allocated after the first iteration.
+ *
+ * The convergence can be accelerated with the vector extrapolation of
+ * Biggs D S C and Andrews M, "Acceleration of iterative image restoration
+ * algorithms", Applied Optics 36(8), 1997. Each iteration is then applied
+ * to a prediction of the estimate extrapolated along the direction of the
+ * previous iterations, which typically reduces the number of iterations
+ * needed for a given result several times, at the cost of two more image
+ * buffers.
+ *
  * This code was adapted from the Insight Journal contribution:
  *
  * "Deconvolution: infrastructure and reference algorithms"
@@ -90,6 +98,16 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(RichardsonLucyDeconvolutionImageFilter);
 
+  /** Set/Get whether the iterations are accelerated by Biggs-Andrews
+   * vector extrapolation. Off by default. */
+  itkSetMacro(Acceleration, bool);
+  itkGetConstMacro(Acceleration, bool);
+  itkBooleanMacro(Acceleration);
+
+  /** Get the extrapolation factor used to predict the estimate of the next
+   * iteration, between 0 and 1. Always 0 when Acceleration is off. */
+  itkGetConstMacro(AccelerationFactor, double);
+
 protected:
   RichardsonLucyDeconvolutionImageFilter();
   ~RichardsonLucyDeconvolutionImageFilter() override;
@@ -106,28 +124,32 @@ protected:
   using typename Superclass::FFTFilterType;
   using typename Superclass::IFFTFilterType;
 
+  /** Multiply a spectrum in place by the transfer function, or by its
+   * complex conjugate. */
+  void
+  MultiplyByTransferFunction(InternalComplexImageType * spectrum, bool conjugate);
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
-  /** Filters to compute each iterative update step. */
-  using MultiplyFilterType = MultiplyImageFilter<InternalImageType>;
-  using ComplexMultiplyType = MultiplyImageFilter<InternalComplexImageType>;
-  using DivideFilterType = DivideOrZeroOutImageFilter<InternalImageType>;
-  using ConjugateAdaptorType = ComplexConjugateImageAdaptor<InternalComplexImageType>;
-  using ComplexConjugateMultiplyType =
-    MultiplyImageFilter<InternalComplexImageType, ConjugateAdaptorType, InternalComplexImageType>;
+  bool   m_Acceleration{ false };
+  double m_AccelerationFactor{ 0.0 };
 
   InternalImagePointerType m_PaddedInput{};
 
-  typename ComplexMultiplyType::Pointer          m_ComplexMultiplyFilter1{};
-  typename IFFTFilterType::Pointer               m_IFFTFilter1{};
-  typename DivideFilterType::Pointer             m_DivideFilter{};
-  typename FFTFilterType::Pointer                m_FFTFilter{};
-  typename ConjugateAdaptorType::Pointer         m_ConjugateAdaptor{};
-  typename ComplexConjugateMultiplyType::Pointer m_ComplexMultiplyFilter2{};
-  typename IFFTFilterType::Pointer               m_IFFTFilter2{};
-  typename MultiplyFilterType::Pointer           m_MultiplyFilter{};
+  /** Ratio of the input to the blurred estimate. */
+  InternalImagePointerType m_Ratio{};
+
+  /** Estimate before the last iteration, and its change by the last
+   * iteration, used by the acceleration. */
+  InternalImagePointerType m_PreviousEstimate{};
+  InternalImagePointerType m_PreviousUpdate{};
+
+  /** The Fourier transforms of the iterations. The inverse transform takes
+   * the output of the forward transform as input. */
+  typename FFTFilterType::Pointer  m_FFTFilter{};
+  typename IFFTFilterType::Pointer m_IFFTFilter{};
 };
 } // end namespace itk
 
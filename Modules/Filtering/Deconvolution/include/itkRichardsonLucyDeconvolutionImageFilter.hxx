@@ -18,6 +18,8 @@
 #ifndef itkRichardsonLucyDeconvolutionImageFilter_hxx
 #define itkRichardsonLucyDeconvolutionImageFilter_hxx
 
+#include <algorithm>
+#include <vector>
 
 namespace itk
 {
@@ -46,86 +48,166 @@ RichardsonLucyDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage,
   this->Superclass::Initialize(progress, 0.5f * progressWeight, iterationProgressWeight);
 
   this->PadInput(this->GetInput(), m_PaddedInput, progress, 0.5f * progressWeight);
-
-  // Set up minipipeline to compute estimate at each iteration
-  m_ComplexMultiplyFilter1 = ComplexMultiplyType::New();
-  m_ComplexMultiplyFilter1->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  // Transformed estimate will be set as input 1 in Iteration()
-  m_ComplexMultiplyFilter1->SetInput2(this->m_TransferFunction);
-  m_ComplexMultiplyFilter1->InPlaceOn();
-  m_ComplexMultiplyFilter1->ReleaseDataFlagOn();
-  progress->RegisterInternalFilter(m_ComplexMultiplyFilter1, 0.07f * iterationProgressWeight);
-
-  m_IFFTFilter1 = IFFTFilterType::New();
-  m_IFFTFilter1->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  m_IFFTFilter1->SetActualXDimensionIsOdd(this->GetXDimensionIsOdd());
-  m_IFFTFilter1->SetInput(m_ComplexMultiplyFilter1->GetOutput());
-  m_IFFTFilter1->ReleaseDataFlagOn();
-  progress->RegisterInternalFilter(m_IFFTFilter1, 0.2f * iterationProgressWeight);
-
-  m_DivideFilter = DivideFilterType::New();
-  m_DivideFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  m_DivideFilter->SetInput1(m_PaddedInput);
-  m_DivideFilter->SetInput2(m_IFFTFilter1->GetOutput());
-  m_DivideFilter->InPlaceOn();
-  m_DivideFilter->SetCoordinateTolerance(NumericTraits<double>::max());
-  m_DivideFilter->SetDirectionTolerance(NumericTraits<double>::max());
-  progress->RegisterInternalFilter(m_DivideFilter, 0.1f * iterationProgressWeight);
-
+  m_PaddedInput->DisconnectPipeline();
+
+  const typename InternalImageType::RegionType paddedRegion = m_PaddedInput->GetLargestPossibleRegion();
+  m_Ratio = InternalImageType::New();
+  m_Ratio->CopyInformation(m_PaddedInput);
+  m_Ratio->SetRegions(paddedRegion);
+  m_Ratio->Allocate();
+
+  m_AccelerationFactor = 0.0;
+  if (m_Acceleration)
+  {
+    m_PreviousEstimate = InternalImageType::New();
+    m_PreviousEstimate->CopyInformation(m_PaddedInput);
+    m_PreviousEstimate->SetRegions(paddedRegion);
+    m_PreviousEstimate->Allocate();
+    // The first prediction, with a zero factor, is the estimate itself.
+    std::copy_n(this->m_CurrentEstimate->GetBufferPointer(),
+                paddedRegion.GetNumberOfPixels(),
+                m_PreviousEstimate->GetBufferPointer());
+
+    m_PreviousUpdate = InternalImageType::New();
+    m_PreviousUpdate->CopyInformation(m_PaddedInput);
+    m_PreviousUpdate->SetRegions(paddedRegion);
+    m_PreviousUpdate->AllocateInitialized();
+  }
+
+  // The transforms are run twice per iteration, and keep their output
+  // buffers from one run to the next.
   m_FFTFilter = FFTFilterType::New();
   m_FFTFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  m_FFTFilter->SetInput(m_DivideFilter->GetOutput());
-  m_FFTFilter->ReleaseDataFlagOn();
-  progress->RegisterInternalFilter(m_FFTFilter, 0.2f * iterationProgressWeight);
-
-  m_ConjugateAdaptor = ConjugateAdaptorType::New();
-  m_ConjugateAdaptor->SetImage(this->m_TransferFunction);
-
-  m_ComplexMultiplyFilter2 = ComplexConjugateMultiplyType::New();
-  m_ComplexMultiplyFilter2->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  m_ComplexMultiplyFilter2->SetInput1(m_FFTFilter->GetOutput());
-  m_ComplexMultiplyFilter2->SetInput2(m_ConjugateAdaptor);
-  m_ComplexMultiplyFilter2->ReleaseDataFlagOn();
-  progress->RegisterInternalFilter(m_ComplexMultiplyFilter2, 0.07f * iterationProgressWeight);
-
-  m_IFFTFilter2 = IFFTFilterType::New();
-  m_IFFTFilter2->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  m_IFFTFilter2->SetActualXDimensionIsOdd(this->GetXDimensionIsOdd());
-  m_IFFTFilter2->SetInput(m_ComplexMultiplyFilter2->GetOutput());
-  m_IFFTFilter2->ReleaseDataFlagOn();
-  progress->RegisterInternalFilter(m_IFFTFilter2, 0.2f * iterationProgressWeight);
-
-  m_MultiplyFilter = MultiplyFilterType::New();
-  m_MultiplyFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  // Current estimate will be set as input 1 in Iteration()
-  m_MultiplyFilter->SetInput2(m_IFFTFilter2->GetOutput());
-  m_MultiplyFilter->InPlaceOn();
-  m_MultiplyFilter->ReleaseDataFlagOn();
-  m_MultiplyFilter->SetCoordinateTolerance(NumericTraits<double>::max());
-  m_MultiplyFilter->SetDirectionTolerance(NumericTraits<double>::max());
-  progress->RegisterInternalFilter(m_MultiplyFilter, 0.06f * iterationProgressWeight);
+  progress->RegisterInternalFilter(m_FFTFilter, 0.22f * iterationProgressWeight);
+
+  m_IFFTFilter = IFFTFilterType::New();
+  m_IFFTFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  m_IFFTFilter->SetActualXDimensionIsOdd(this->GetXDimensionIsOdd());
+  m_IFFTFilter->SetInput(m_FFTFilter->GetOutput());
+  progress->RegisterInternalFilter(m_IFFTFilter, 0.22f * iterationProgressWeight);
 }
 
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 RichardsonLucyDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::Iteration(
-  ProgressAccumulator * progress,
-  float                 iterationProgressWeight)
+  ProgressAccumulator * itkNotUsed(progress),
+  float                 itkNotUsed(iterationProgressWeight))
 {
-  // Set up minipipeline to compute the new estimate
-  InternalComplexImagePointerType transformedEstimate;
-  this->TransformPaddedInput(this->m_CurrentEstimate, transformedEstimate, progress, 0.1f * iterationProgressWeight);
-
-  // Set the inputs
-  m_ComplexMultiplyFilter1->SetInput1(transformedEstimate);
-  m_MultiplyFilter->SetInput1(this->m_CurrentEstimate);
-
-  // Trigger the update
-  m_MultiplyFilter->UpdateLargestPossibleRegion();
+  using RealType = TInternalPrecision;
+
+  InternalImageType * currentEstimate = this->m_CurrentEstimate;
+  RealType *          estimate = currentEstimate->GetBufferPointer();
+  const RealType *    input = m_PaddedInput->GetBufferPointer();
+  RealType *          ratio = m_Ratio->GetBufferPointer();
+
+  const SizeValueType numberOfPixels = currentEstimate->GetBufferedRegion().GetNumberOfPixels();
+  const SizeValueType numberOfChunks = std::max(1u, this->GetNumberOfWorkUnits());
+
+  // With the acceleration, the iteration is applied to a prediction of the
+  // estimate, extrapolated from the previous estimate and clipped to keep
+  // it non-negative.
+  if (m_Acceleration)
+  {
+    RealType *     previousEstimate = m_PreviousEstimate->GetBufferPointer();
+    const RealType alpha = static_cast<RealType>(m_AccelerationFactor);
+    this->ParallelizeBuffer(numberOfPixels, numberOfChunks, [=](SizeValueType, SizeValueType first, SizeValueType end) {
+      for (SizeValueType i = first; i < end; ++i)
+      {
+        const RealType x = estimate[i];
+        estimate[i] = std::max(x + alpha * (x - previousEstimate[i]), RealType{});
+        previousEstimate[i] = x;
+      }
+    });
+  }
+
+  // Blur the estimate.
+  currentEstimate->Modified();
+  m_FFTFilter->SetInput(currentEstimate);
+  m_FFTFilter->Update();
+  this->MultiplyByTransferFunction(m_FFTFilter->GetOutput(), false);
+  m_IFFTFilter->Update();
+
+  // Divide the input by the blurred estimate, as DivideOrZeroOutImageFilter.
+  const RealType * blurred = m_IFFTFilter->GetOutput()->GetBufferPointer();
+  const RealType   threshold = static_cast<RealType>(1e-5);
+  this->ParallelizeBuffer(numberOfPixels, numberOfChunks, [=](SizeValueType, SizeValueType first, SizeValueType end) {
+    for (SizeValueType i = first; i < end; ++i)
+    {
+      ratio[i] = blurred[i] < threshold ? RealType{} : input[i] / blurred[i];
+    }
+  });
+
+  // Correlate the ratio with the kernel.
+  m_Ratio->Modified();
+  m_FFTFilter->SetInput(m_Ratio);
+  m_FFTFilter->Update();
+  this->MultiplyByTransferFunction(m_FFTFilter->GetOutput(), true);
+  m_IFFTFilter->Update();
+
+  // Multiply the estimate by the correction.
+  const RealType * correction = m_IFFTFilter->GetOutput()->GetBufferPointer();
+  if (!m_Acceleration)
+  {
+    this->ParallelizeBuffer(numberOfPixels, numberOfChunks, [=](SizeValueType, SizeValueType first, SizeValueType end) {
+      for (SizeValueType i = first; i < end; ++i)
+      {
+        estimate[i] *= correction[i];
+      }
+    });
+  }
+  else
+  {
+    // Also compute the change of the prediction by this iteration, and its
+    // correlation with the change by the previous iteration, from which the
+    // next extrapolation factor is derived.
+    RealType *          previousUpdate = m_PreviousUpdate->GetBufferPointer();
+    std::vector<double> products(2 * numberOfChunks, 0.0);
+    this->ParallelizeBuffer(
+      numberOfPixels, numberOfChunks, [=, &products](SizeValueType chunk, SizeValueType first, SizeValueType end) {
+        double updateProduct = 0.0;
+        double previousUpdateNorm = 0.0;
+        for (SizeValueType i = first; i < end; ++i)
+        {
+          const RealType prediction = estimate[i];
+          estimate[i] = prediction * correction[i];
+          const RealType update = estimate[i] - prediction;
+          updateProduct += static_cast<double>(update) * static_cast<double>(previousUpdate[i]);
+          previousUpdateNorm += static_cast<double>(previousUpdate[i]) * static_cast<double>(previousUpdate[i]);
+          previousUpdate[i] = update;
+        }
+        products[2 * chunk] = updateProduct;
+        products[2 * chunk + 1] = previousUpdateNorm;
+      });
+
+    double updateProduct = 0.0;
+    double previousUpdateNorm = 0.0;
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      updateProduct += products[2 * chunk];
+      previousUpdateNorm += products[2 * chunk + 1];
+    }
+    m_AccelerationFactor =
+      previousUpdateNorm > 0.0 ? std::clamp(updateProduct / previousUpdateNorm, 0.0, 1.0) : 0.0;
+  }
+  currentEstimate->Modified();
+}
 
-  // Store the current estimate
-  this->m_CurrentEstimate = m_MultiplyFilter->GetOutput();
-  this->m_CurrentEstimate->DisconnectPipeline();
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+RichardsonLucyDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::
+  MultiplyByTransferFunction(InternalComplexImageType * spectrum, bool conjugate)
+{
+  InternalComplexType *       spectrumBuffer = spectrum->GetBufferPointer();
+  const InternalComplexType * transferFunction = this->m_TransferFunction->GetBufferPointer();
+  const SizeValueType         numberOfPixels = spectrum->GetBufferedRegion().GetNumberOfPixels();
+  this->ParallelizeBuffer(numberOfPixels,
+                          std::max(1u, this->GetNumberOfWorkUnits()),
+                          [=](SizeValueType, SizeValueType first, SizeValueType end) {
+                            for (SizeValueType i = first; i < end; ++i)
+                            {
+                              spectrumBuffer[i] *= conjugate ? std::conj(transferFunction[i]) : transferFunction[i];
+                            }
+                          });
 }
 
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
@@ -136,14 +218,12 @@ RichardsonLucyDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage,
 {
   this->Superclass::Finish(progress, progressWeight);
 
-  m_ComplexMultiplyFilter1 = nullptr;
-  m_IFFTFilter1 = nullptr;
-  m_DivideFilter = nullptr;
+  m_PaddedInput = nullptr;
+  m_Ratio = nullptr;
+  m_PreviousEstimate = nullptr;
+  m_PreviousUpdate = nullptr;
   m_FFTFilter = nullptr;
-  m_ConjugateAdaptor = nullptr;
-  m_ComplexMultiplyFilter2 = nullptr;
-  m_IFFTFilter2 = nullptr;
-  m_MultiplyFilter = nullptr;
+  m_IFFTFilter = nullptr;
 }
 
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
@@ -153,6 +233,9 @@ RichardsonLucyDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage,
   Indent         indent) const
 {
   this->Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(Acceleration);
+  os << indent << "AccelerationFactor: " << m_AccelerationFactor << std::endl;
 }
 
 } // end namespace itk
@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDeconvolutionIterationCommand.h"
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkGaussianImageSource.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkRichardsonLucyDeconvolutionImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using DeconvolutionFilterType = itk::RichardsonLucyDeconvolutionImageFilter<ImageType>;
+
+double
+MeanSquaredDifference(const ImageType * image1, const ImageType * image2)
+{
+  itk::ImageRegionConstIterator<ImageType> it1(image1, image1->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> it2(image2, image2->GetLargestPossibleRegion());
+  double                                   sum = 0.0;
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    const double difference = it1.Get() - it2.Get();
+    sum += difference * difference;
+  }
+  return sum / static_cast<double>(image1->GetLargestPossibleRegion().GetNumberOfPixels());
+}
+} // namespace
+
+int
+itkRichardsonLucyDeconvolutionImageFilterAccelerationTest(int, char *[])
+{
+  // A positive image blurred by a Gaussian kernel.
+  using RandomSourceType = itk::RandomImageSource<ImageType>;
+  auto                randomSource = RandomSourceType::New();
+  ImageType::SizeType size = { { 64, 48 } };
+  randomSource->SetSize(size);
+  randomSource->SetMin(10.0);
+  randomSource->SetMax(100.0);
+  randomSource->Update();
+  const ImageType * image = randomSource->GetOutput();
+
+  using GaussianSourceType = itk::GaussianImageSource<ImageType>;
+  auto                          gaussianSource = GaussianSourceType::New();
+  ImageType::SizeType           kernelSize = { { 9, 9 } };
+  GaussianSourceType::ArrayType mean;
+  GaussianSourceType::ArrayType sigma;
+  mean.Fill(4.0);
+  sigma.Fill(1.5);
+  gaussianSource->SetSize(kernelSize);
+  gaussianSource->SetMean(mean);
+  gaussianSource->SetSigma(sigma);
+  gaussianSource->Update();
+  const ImageType * kernel = gaussianSource->GetOutput();
+
+  using ConvolutionFilterType = itk::FFTConvolutionImageFilter<ImageType>;
+  auto convolutionFilter = ConvolutionFilterType::New();
+  convolutionFilter->SetInput(image);
+  convolutionFilter->SetKernelImage(kernel);
+  convolutionFilter->NormalizeOn();
+  convolutionFilter->Update();
+
+  auto deconvolutionFilter = DeconvolutionFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    deconvolutionFilter, RichardsonLucyDeconvolutionImageFilter, IterativeDeconvolutionImageFilter);
+
+  ITK_TEST_SET_GET_BOOLEAN(deconvolutionFilter, Acceleration, true);
+
+  deconvolutionFilter->SetInput(convolutionFilter->GetOutput());
+  deconvolutionFilter->SetKernelImage(kernel);
+  deconvolutionFilter->NormalizeOn();
+  deconvolutionFilter->SetNumberOfIterations(20);
+
+  using IterationCommandType = itk::DeconvolutionIterationCommand<DeconvolutionFilterType>;
+  auto observer = IterationCommandType::New();
+  deconvolutionFilter->AddObserver(itk::IterationEvent(), observer);
+
+  // Without acceleration.
+  deconvolutionFilter->AccelerationOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(deconvolutionFilter->Update());
+  ITK_TEST_EXPECT_TRUE(observer->GetInvoked());
+  ITK_TEST_EXPECT_EQUAL(deconvolutionFilter->GetAccelerationFactor(), 0.0);
+  const ImageType::Pointer plainEstimate = deconvolutionFilter->GetOutput();
+  plainEstimate->DisconnectPipeline();
+  const double plainError = MeanSquaredDifference(image, plainEstimate);
+
+  // The estimate after as many accelerated iterations is closer to the
+  // original image.
+  deconvolutionFilter->AccelerationOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(deconvolutionFilter->Update());
+  const double acceleratedError = MeanSquaredDifference(image, deconvolutionFilter->GetOutput());
+  const double accelerationFactor = deconvolutionFilter->GetAccelerationFactor();
+  std::cout << "Mean squared error without acceleration: " << plainError << std::endl;
+  std::cout << "Mean squared error with acceleration: " << acceleratedError << std::endl;
+  std::cout << "Last acceleration factor: " << accelerationFactor << std::endl;
+  ITK_TEST_EXPECT_TRUE(accelerationFactor > 0.0 && accelerationFactor <= 1.0);
+  ITK_TEST_EXPECT_TRUE(acceleratedError < plainError);
+
+  // The first accelerated iteration, with a zero factor, is a plain one:
+  // the previous estimate starts as the estimate.
+  deconvolutionFilter->SetNumberOfIterations(1);
+  deconvolutionFilter->AccelerationOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(deconvolutionFilter->Update());
+  const ImageType::Pointer plainFirstEstimate = deconvolutionFilter->GetOutput();
+  plainFirstEstimate->DisconnectPipeline();
+  deconvolutionFilter->AccelerationOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(deconvolutionFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(MeanSquaredDifference(plainFirstEstimate, deconvolutionFilter->GetOutput()), 0.0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -33,7 +33,10 @@
 
 #endif
 
+#include <memory>
 #include <mutex>
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -70,6 +73,9 @@ public:
   using ComplexType = fftwf_complex;
   using PlanType = fftwf_plan;
   using Self = Proxy<float>;
+  /** Shared ownership of a plan returned by the CachedPlan_*() functions. */
+  using PlanHandleType = std::shared_ptr<std::remove_pointer_t<PlanType>>;
+  using PlanCacheKeyType = std::vector<int>;
 
   // FFTW works with any data size, but is optimized for size decomposition with prime factors up to 13.
 #  ifdef ITK_USE_CUFFTW
@@ -373,6 +379,70 @@ public:
   }
 
 
+  /** Return a plan for the transform described by the arguments, shared
+   * with the process-wide plan cache of FFTWGlobalConfiguration: a plan
+   * created earlier for the same sizes, planner flags, number of threads,
+   * data alignment and in-place layout is reused instead of being planned
+   * again. The plan must be run with the new-array Execute_dft_*()
+   * functions, since it may have been created for other arrays. */
+  static PlanHandleType
+  CachedPlan_dft_c2r(int           rank,
+                     const int *   n,
+                     ComplexType * in,
+                     PixelType *   out,
+                     unsigned int  flags,
+                     int           threads = 1,
+                     bool          canDestroyInput = false)
+  {
+    return CachedPlan(PlanCacheKey(1, 0, rank, n, in, out, flags, threads),
+                      [&]() { return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput); });
+  }
+
+  static PlanHandleType
+  CachedPlan_dft_r2c(int           rank,
+                     const int *   n,
+                     PixelType *   in,
+                     ComplexType * out,
+                     unsigned int  flags,
+                     int           threads = 1,
+                     bool          canDestroyInput = false)
+  {
+    return CachedPlan(PlanCacheKey(2, 0, rank, n, in, out, flags, threads),
+                      [&]() { return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput); });
+  }
+
+  static PlanHandleType
+  CachedPlan_dft(int           rank,
+                 const int *   n,
+                 ComplexType * in,
+                 ComplexType * out,
+                 int           sign,
+                 unsigned int  flags,
+                 int           threads = 1,
+                 bool          canDestroyInput = false)
+  {
+    return CachedPlan(PlanCacheKey(3, sign, rank, n, in, out, flags, threads),
+                      [&]() { return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput); });
+  }
+
+  static void
+  Execute_dft_c2r(const PlanHandleType & p, ComplexType * in, PixelType * out)
+  {
+    fftwf_execute_dft_c2r(p.get(), in, out);
+  }
+
+  static void
+  Execute_dft_r2c(const PlanHandleType & p, PixelType * in, ComplexType * out)
+  {
+    fftwf_execute_dft_r2c(p.get(), in, out);
+  }
+
+  static void
+  Execute_dft(const PlanHandleType & p, ComplexType * in, ComplexType * out)
+  {
+    fftwf_execute_dft(p.get(), in, out);
+  }
+
   static void
   Execute(PlanType p)
   {
@@ -386,6 +456,53 @@ public:
 #  endif
     fftwf_destroy_plan(p);
   }
+
+private:
+  static PlanCacheKeyType
+  PlanCacheKey(int kind, int sign, int rank, const int * n, void * in, void * out, unsigned int flags, int threads)
+  {
+    PlanCacheKeyType key{ static_cast<int>(sizeof(PixelType)),
+                          kind,
+                          sign,
+                          static_cast<int>(flags),
+                          threads,
+                          in == out,
+#  ifndef ITK_USE_CUFFTW
+                          fftwf_alignment_of(static_cast<PixelType *>(in)),
+                          fftwf_alignment_of(static_cast<PixelType *>(out)),
+#  endif
+                          rank };
+    key.insert(key.end(), n, n + rank);
+    return key;
+  }
+
+  template <typename TPlanFunction>
+  static PlanHandleType
+  CachedPlan([[maybe_unused]] const PlanCacheKeyType & key, TPlanFunction planFunction)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const FFTWGlobalConfiguration::PlanHandleType cachedPlan = FFTWGlobalConfiguration::GetCachedPlan(key);
+    if (cachedPlan)
+    {
+      return std::static_pointer_cast<std::remove_pointer_t<PlanType>>(cachedPlan);
+    }
+    // The plan keeps a pointer to the mutex rather than going through the
+    // singleton, so that it can still be destroyed when the cache is cleared
+    // while the global configuration is destroyed.
+    FFTWGlobalConfiguration::MutexType * lock = &FFTWGlobalConfiguration::GetLockMutex();
+
+    const auto destroyPlan = [lock](PlanType p)
+    {
+      const std::lock_guard<FFTWGlobalConfiguration::MutexType> lockGuard(*lock);
+      fftwf_destroy_plan(p);
+    };
+    const PlanHandleType plan(planFunction(), destroyPlan);
+    FFTWGlobalConfiguration::AddCachedPlan(key, plan);
+    return plan;
+#  else
+    return PlanHandleType(planFunction(), [](PlanType p) { fftwf_destroy_plan(p); });
+#  endif
+  }
 };
 
 #endif // ITK_USE_FFTWF
@@ -400,6 +517,9 @@ public:
   using ComplexType = fftw_complex;
   using PlanType = fftw_plan;
   using Self = Proxy<double>;
+  /** Shared ownership of a plan returned by the CachedPlan_*() functions. */
+  using PlanHandleType = std::shared_ptr<std::remove_pointer_t<PlanType>>;
+  using PlanCacheKeyType = std::vector<int>;
 
   // FFTW works with any data size, but is optimized for size decomposition with prime factors up to 13.
 #  ifdef ITK_USE_CUFFTW
@@ -702,6 +822,70 @@ public:
   }
 
 
+  /** Return a plan for the transform described by the arguments, shared
+   * with the process-wide plan cache of FFTWGlobalConfiguration: a plan
+   * created earlier for the same sizes, planner flags, number of threads,
+   * data alignment and in-place layout is reused instead of being planned
+   * again. The plan must be run with the new-array Execute_dft_*()
+   * functions, since it may have been created for other arrays. */
+  static PlanHandleType
+  CachedPlan_dft_c2r(int           rank,
+                     const int *   n,
+                     ComplexType * in,
+                     PixelType *   out,
+                     unsigned int  flags,
+                     int           threads = 1,
+                     bool          canDestroyInput = false)
+  {
+    return CachedPlan(PlanCacheKey(1, 0, rank, n, in, out, flags, threads),
+                      [&]() { return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput); });
+  }
+
+  static PlanHandleType
+  CachedPlan_dft_r2c(int           rank,
+                     const int *   n,
+                     PixelType *   in,
+                     ComplexType * out,
+                     unsigned int  flags,
+                     int           threads = 1,
+                     bool          canDestroyInput = false)
+  {
+    return CachedPlan(PlanCacheKey(2, 0, rank, n, in, out, flags, threads),
+                      [&]() { return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput); });
+  }
+
+  static PlanHandleType
+  CachedPlan_dft(int           rank,
+                 const int *   n,
+                 ComplexType * in,
+                 ComplexType * out,
+                 int           sign,
+                 unsigned int  flags,
+                 int           threads = 1,
+                 bool          canDestroyInput = false)
+  {
+    return CachedPlan(PlanCacheKey(3, sign, rank, n, in, out, flags, threads),
+                      [&]() { return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput); });
+  }
+
+  static void
+  Execute_dft_c2r(const PlanHandleType & p, ComplexType * in, PixelType * out)
+  {
+    fftw_execute_dft_c2r(p.get(), in, out);
+  }
+
+  static void
+  Execute_dft_r2c(const PlanHandleType & p, PixelType * in, ComplexType * out)
+  {
+    fftw_execute_dft_r2c(p.get(), in, out);
+  }
+
+  static void
+  Execute_dft(const PlanHandleType & p, ComplexType * in, ComplexType * out)
+  {
+    fftw_execute_dft(p.get(), in, out);
+  }
+
   static void
   Execute(PlanType p)
   {
@@ -715,6 +899,53 @@ public:
 #  endif
     fftw_destroy_plan(p);
   }
+
+private:
+  static PlanCacheKeyType
+  PlanCacheKey(int kind, int sign, int rank, const int * n, void * in, void * out, unsigned int flags, int threads)
+  {
+    PlanCacheKeyType key{ static_cast<int>(sizeof(PixelType)),
+                          kind,
+                          sign,
+                          static_cast<int>(flags),
+                          threads,
+                          in == out,
+#  ifndef ITK_USE_CUFFTW
+                          fftw_alignment_of(static_cast<PixelType *>(in)),
+                          fftw_alignment_of(static_cast<PixelType *>(out)),
+#  endif
+                          rank };
+    key.insert(key.end(), n, n + rank);
+    return key;
+  }
+
+  template <typename TPlanFunction>
+  static PlanHandleType
+  CachedPlan([[maybe_unused]] const PlanCacheKeyType & key, TPlanFunction planFunction)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const FFTWGlobalConfiguration::PlanHandleType cachedPlan = FFTWGlobalConfiguration::GetCachedPlan(key);
+    if (cachedPlan)
+    {
+      return std::static_pointer_cast<std::remove_pointer_t<PlanType>>(cachedPlan);
+    }
+    // The plan keeps a pointer to the mutex rather than going through the
+    // singleton, so that it can still be destroyed when the cache is cleared
+    // while the global configuration is destroyed.
+    FFTWGlobalConfiguration::MutexType * lock = &FFTWGlobalConfiguration::GetLockMutex();
+
+    const auto destroyPlan = [lock](PlanType p)
+    {
+      const std::lock_guard<FFTWGlobalConfiguration::MutexType> lockGuard(*lock);
+      fftw_destroy_plan(p);
+    };
+    const PlanHandleType plan(planFunction(), destroyPlan);
+    FFTWGlobalConfiguration::AddCachedPlan(key, plan);
+    return plan;
+#  else
+    return PlanHandleType(planFunction(), [](PlanType p) { fftw_destroy_plan(p); });
+#  endif
+  }
 };
 
 #endif
@@ -75,10 +75,9 @@ FFTWComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGen
     transformDirection = -1;
   }
 
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = (typename FFTWProxyType::ComplexType *)input->GetBufferPointer();
-  auto *                           out = (typename FFTWProxyType::ComplexType *)output->GetBufferPointer();
-  int                              flags = m_PlanRigor;
+  auto * in = (typename FFTWProxyType::ComplexType *)input->GetBufferPointer();
+  auto * out = (typename FFTWProxyType::ComplexType *)output->GetBufferPointer();
+  int    flags = m_PlanRigor;
   if (!m_CanUseDestructiveAlgorithm)
   {
     // if the input is about to be destroyed, there is no need to force fftw
@@ -93,11 +92,9 @@ FFTWComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGen
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan =
-    FFTWProxyType::Plan_dft(ImageDimension, sizes, in, out, transformDirection, flags, this->GetNumberOfWorkUnits());
-
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  const typename FFTWProxyType::PlanHandleType plan = FFTWProxyType::CachedPlan_dft(
+    ImageDimension, sizes, in, out, transformDirection, flags, this->GetNumberOfWorkUnits());
+  FFTWProxyType::Execute_dft(plan, in, out);
 }
 
 
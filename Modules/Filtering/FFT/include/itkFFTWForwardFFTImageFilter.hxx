@@ -91,9 +91,9 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   fftwOutput->SetRegions(fftwOutputRegion);
   fftwOutput->Allocate();
 
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
-  int                              flags = m_PlanRigor;
+  auto * in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
+  auto * out = (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer();
+  int    flags = m_PlanRigor;
   if (!m_CanUseDestructiveAlgorithm)
   {
     // if the input is about to be destroyed, there is no need to force fftw
@@ -107,14 +107,9 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(ImageDimension,
-                                     sizes,
-                                     in,
-                                     (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer(),
-                                     flags,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  const typename FFTWProxyType::PlanHandleType plan = FFTWProxyType::CachedPlan_dft_r2c(
+    ImageDimension, sizes, in, out, flags, MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  FFTWProxyType::Execute_dft_r2c(plan, in, out);
 
   // Expand the half image to the full image size
   using HalfToFullFilterType = HalfToFullHermitianImageFilter<OutputImageType>;
@@ -35,6 +35,10 @@
 #  endif
 #  include <algorithm>
 #  include <cctype>
+#  include <list>
+#  include <map>
+#  include <memory>
+#  include <vector>
 
 struct FFTWGlobalConfigurationGlobals;
 
@@ -56,6 +60,9 @@ struct FFTWGlobalConfigurationGlobals;
 //                             file to be generated.  If this is
 //                             set, then ITK_FFTW_WISDOM_CACHE_BASE
 //                             is ignored.
+// ITK_FFTW_PLAN_CACHE_SIZE   - Defines the maximum number of plans
+//                             kept in the plan cache (16 by default,
+//                             0 disables the cache).
 //
 // The above behaviors can also be controlled by the application.
 //
@@ -212,6 +219,16 @@ public:
   using ConstPointer = SmartPointer<const Self>;
   using MutexType = std::mutex;
 
+  /** Key identifying a plan in the plan cache. It holds every parameter
+   * a plan depends on: precision, transform kind and direction, planner
+   * flags, number of threads, in-place layout, data alignment and sizes. */
+  using PlanCacheKeyType = std::vector<int>;
+
+  /** Shared ownership of a cached plan. A plan is destroyed when its last
+   * handle is released, so that a plan evicted from the cache is never
+   * destroyed while a filter is still executing it. */
+  using PlanHandleType = std::shared_ptr<void>;
+
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(FFTWGlobalConfiguration);
 
@@ -348,6 +365,48 @@ public:
   static bool
   ExportDefaultWisdomFile();
 
+  /**
+   * \brief Set/Get the maximum number of plans kept in the plan cache
+   *
+   * The FFTW filters keep the plans they create in a cache shared by all
+   * the filter instances of the process, and reuse them, with the
+   * new-array execute functions of FFTW, for transforms with the same
+   * parameters. When the cache is full, the least recently used plan is
+   * evicted. A value of 0 disables the cache. If the environmental variable
+   * "ITK_FFTW_PLAN_CACHE_SIZE" is set, it overrides the default of 16.
+   */
+  static void
+  SetPlanCacheSize(const SizeValueType v);
+  static SizeValueType
+  GetPlanCacheSize();
+
+  /** Get the number of plans currently in the plan cache. */
+  static SizeValueType
+  GetNumberOfCachedPlans();
+
+  /** Get the number of plan look-ups that were, or were not, satisfied by
+   * the plan cache since the last call to ResetPlanCacheStatistics(). */
+  static SizeValueType
+  GetPlanCacheHits();
+  static SizeValueType
+  GetPlanCacheMisses();
+  static void
+  ResetPlanCacheStatistics();
+
+  /** Remove all the plans from the plan cache. */
+  static void
+  ClearPlanCache();
+
+  /** Look up a plan in the plan cache. A null handle is returned when no
+   * plan matches the key. This is used by fftw::Proxy. */
+  static PlanHandleType
+  GetCachedPlan(const PlanCacheKeyType & key);
+
+  /** Add a plan to the plan cache, evicting the least recently used plans
+   * if needed. This is used by fftw::Proxy. */
+  static void
+  AddCachedPlan(const PlanCacheKeyType & key, const PlanHandleType & plan);
+
 private:
   FFTWGlobalConfiguration();           // This will process env variables
   ~FFTWGlobalConfiguration() override; // This will write cache file if requested.
@@ -376,6 +435,23 @@ private:
   // m_WriteWisdomCache Controls the behavior of default
   // wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
+
+  using PlanCacheListType = std::list<std::pair<PlanCacheKeyType, PlanHandleType>>;
+
+  /** Move the least recently used plans to evicted until the cache holds at
+   * most m_PlanCacheSize plans. m_PlanCacheMutex must be held; the evicted
+   * plans should be released after it is unlocked. */
+  void
+  TrimPlanCache(PlanCacheListType & evicted);
+
+  // The plan cache is protected by its own mutex, so that a cache hit does
+  // not wait for the planning done by another thread under m_Mutex.
+  std::mutex                                              m_PlanCacheMutex;
+  SizeValueType                                           m_PlanCacheSize{ 16 };
+  SizeValueType                                           m_PlanCacheHits{ 0 };
+  SizeValueType                                           m_PlanCacheMisses{ 0 };
+  PlanCacheListType                                       m_PlanCache;
+  std::map<PlanCacheKeyType, PlanCacheListType::iterator> m_PlanCacheIndex;
 };
 } // namespace itk
 #endif
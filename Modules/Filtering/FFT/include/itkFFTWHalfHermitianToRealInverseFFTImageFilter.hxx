@@ -90,21 +90,21 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
     }
   }
   ();
-  OutputPixelType *                out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
+  OutputPixelType * out = outputPtr->GetBufferPointer();
 
   int sizes[ImageDimension];
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
-  plan = FFTWProxyType::Plan_dft_c2r(ImageDimension,
-                                     sizes,
-                                     in,
-                                     out,
-                                     m_PlanRigor,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
-                                     !m_CanUseDestructiveAlgorithm);
+  const typename FFTWProxyType::PlanHandleType plan =
+    FFTWProxyType::CachedPlan_dft_c2r(ImageDimension,
+                                      sizes,
+                                      in,
+                                      out,
+                                      m_PlanRigor,
+                                      MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
+                                      !m_CanUseDestructiveAlgorithm);
   if (!m_CanUseDestructiveAlgorithm)
   {
     // complex<double> and double[2] types are compatible memory layouts.
@@ -113,10 +113,9 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
     std::copy_n(
       inputPtr->GetBufferPointer(), totalInputSize, reinterpret_cast<typename InputImageType::PixelType *>(in));
   }
-  FFTWProxyType::Execute(plan);
+  FFTWProxyType::Execute_dft_c2r(plan, in, out);
 
   // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
   if (!m_CanUseDestructiveAlgorithm)
   {
     delete[] in;
@@ -82,8 +82,7 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData
 
   auto * in = (typename FFTWProxyType::ComplexType *)fullToHalfFilter->GetOutput()->GetBufferPointer();
 
-  OutputPixelType *                out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
+  OutputPixelType * out = outputPtr->GetBufferPointer();
 
   int sizes[ImageDimension];
   for (unsigned int i = 0; i < ImageDimension; ++i)
@@ -91,12 +90,9 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_c2r(
+  const typename FFTWProxyType::PlanHandleType plan = FFTWProxyType::CachedPlan_dft_c2r(
     ImageDimension, sizes, in, out, m_PlanRigor, MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), false);
-  FFTWProxyType::Execute(plan);
-
-  // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
+  FFTWProxyType::Execute_dft_c2r(plan, in, out);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -73,10 +73,9 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generat
     totalOutputSize *= outputSize[i];
   }
 
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
-  auto *                           out = (typename FFTWProxyType::ComplexType *)outputPtr->GetBufferPointer();
-  int                              flags = m_PlanRigor;
+  auto * in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
+  auto * out = (typename FFTWProxyType::ComplexType *)outputPtr->GetBufferPointer();
+  int    flags = m_PlanRigor;
   if (!m_CanUseDestructiveAlgorithm)
   {
     // if the input is about to be destroyed, there is no need to force fftw
@@ -90,10 +89,9 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generat
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(
+  const typename FFTWProxyType::PlanHandleType plan = FFTWProxyType::CachedPlan_dft_r2c(
     ImageDimension, sizes, in, out, flags, MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  FFTWProxyType::Execute_dft_r2c(plan, in, out);
 }
 
 template <typename TInputImage, typename TOutputImage>
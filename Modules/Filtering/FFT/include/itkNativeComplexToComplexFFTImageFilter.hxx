@@ -0,0 +1,73 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeComplexToComplexFFTImageFilter_hxx
+#define itkNativeComplexToComplexFFTImageFilter_hxx
+
+#include "itkNativeFFTCommon.h"
+#include "itkImageAlgorithm.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+void
+NativeComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  const ImageType * input = this->GetInput();
+  ImageType *       output = this->GetOutput();
+
+  if (!input || !output)
+  {
+    return;
+  }
+
+  // We don't have a nice progress to report, but at least this simple line
+  // reports the beginning and the end of the process.
+  ProgressReporter progress(this, 0, 1);
+
+  this->AllocateOutputs();
+
+  const typename ImageType::RegionType bufferedRegion = input->GetBufferedRegion();
+  const typename ImageType::SizeType & imageSize = bufferedRegion.GetSize();
+
+  // Copy the input to the output, and we will work in place on the output.
+  ImageAlgorithm::Copy<ImageType, ImageType>(input, output, bufferedRegion, bufferedRegion);
+
+  using RealType = typename PixelType::value_type;
+  auto * outputBuffer = reinterpret_cast<std::complex<RealType> *>(output->GetBufferPointer());
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  if (this->GetTransformDirection() == Superclass::TransformDirectionEnum::INVERSE)
+  {
+    NativeFFTCommon::TransformComplexImage(outputBuffer,
+                                           imageSize,
+                                           true,
+                                           this->GetMultiThreader(),
+                                           0,
+                                           RealType{ 1 } / static_cast<RealType>(bufferedRegion.GetNumberOfPixels()));
+  }
+  else
+  {
+    NativeFFTCommon::TransformComplexImage(outputBuffer, imageSize, false, this->GetMultiThreader());
+  }
+}
+
+} // end namespace itk
+
+#endif // itkNativeComplexToComplexFFTImageFilter_hxx
@@ -0,0 +1,216 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeFFTCommon_h
+#define itkNativeFFTCommon_h
+
+#include "itkIntTypes.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSize.h"
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+namespace itk
+{
+
+/**
+ * \class NativeFFTCommon
+ * \brief Fast Fourier Transform engine of the Native FFT image filters.
+ *
+ * One-dimensional complex transforms are computed with a mixed-radix
+ * decimation in time algorithm, with specialized butterflies for the
+ * radices 2, 3, 4 and 5, and a generic butterfly for the other radices up
+ * to 13. Lengths with a larger prime factor are computed with Bluestein's
+ * algorithm, as a circular convolution of power of two length, so that
+ * any length is supported. Real signals of even length are transformed as
+ * complex signals of half that length.
+ *
+ * Multi-dimensional transforms apply the one-dimensional transforms along
+ * each dimension in turn, in parallel over the lines of the image.
+ *
+ * \ingroup ITKFFT
+ */
+struct NativeFFTCommon
+{
+  /** Any size is supported, but sizes whose prime factorization consists
+   * of 2s, 3s and 5s are transformed with the fastest butterflies. */
+  static constexpr SizeValueType GREATEST_PRIME_FACTOR = 5;
+
+  /** Largest radix handled by the mixed-radix algorithm. Lengths with a
+   * larger prime factor use Bluestein's algorithm. */
+  static constexpr SizeValueType MaximumRadix = 13;
+
+  /** Number of lines gathered together when transforming along a
+   * dimension other than the first one. */
+  static constexpr SizeValueType PanelWidth = 8;
+
+  /** \class ComplexPlan
+   * \brief One-dimensional complex transform of a given length.
+   *
+   * A plan holds the factorization and the twiddle factors of the
+   * transform. It is not modified by the transforms, so it can be used by
+   * several threads at once, each one with its own scratch buffer.
+   *
+   * \ingroup ITKFFT
+   */
+  template <typename TReal>
+  class ComplexPlan
+  {
+  public:
+    using ComplexType = std::complex<TReal>;
+
+    explicit ComplexPlan(SizeValueType size);
+
+    SizeValueType
+    GetSize() const
+    {
+      return m_Size;
+    }
+
+    /** Number of elements of the scratch buffer given to Forward() and
+     * Backward(). */
+    SizeValueType
+    GetScratchSize() const;
+
+    /** Transform data in place. The forward transform uses the kernel
+     * exp(-2 i pi j k / n), the backward transform exp(2 i pi j k / n). The
+     * backward transform is not normalized. */
+    void
+    Forward(ComplexType * data, ComplexType * scratch) const;
+    void
+    Backward(ComplexType * data, ComplexType * scratch) const;
+
+  private:
+    void
+    Work(ComplexType * out, const ComplexType * in, SizeValueType fstride, const SizeValueType * factors) const;
+
+    void
+    Butterfly2(ComplexType * out, SizeValueType fstride, SizeValueType m) const;
+    void
+    Butterfly3(ComplexType * out, SizeValueType fstride, SizeValueType m) const;
+    void
+    Butterfly4(ComplexType * out, SizeValueType fstride, SizeValueType m) const;
+    void
+    Butterfly5(ComplexType * out, SizeValueType fstride, SizeValueType m) const;
+    void
+    ButterflyGeneric(ComplexType * out, SizeValueType fstride, SizeValueType m, SizeValueType p) const;
+
+    void
+    Bluestein(ComplexType * data, ComplexType * scratch) const;
+
+    SizeValueType m_Size;
+
+    // Pairs of radix and remaining length, in the order of the recursion.
+    std::vector<SizeValueType> m_Factors;
+    std::vector<ComplexType>   m_Twiddles;
+
+    // Bluestein's algorithm, used when the length has a prime factor
+    // larger than MaximumRadix.
+    std::unique_ptr<ComplexPlan> m_BluesteinPlan;
+    std::vector<ComplexType>     m_Chirp;
+    std::vector<ComplexType>     m_BluesteinKernel;
+  };
+
+  /** \class RealPlan
+   * \brief One-dimensional real to half Hermitian transform of a given
+   * length, and its inverse.
+   *
+   * \ingroup ITKFFT
+   */
+  template <typename TReal>
+  class RealPlan
+  {
+  public:
+    using ComplexType = std::complex<TReal>;
+
+    explicit RealPlan(SizeValueType size);
+
+    SizeValueType
+    GetSize() const
+    {
+      return m_Size;
+    }
+
+    /** Number of elements of the scratch buffer given to Forward() and
+     * Backward(). */
+    SizeValueType
+    GetScratchSize() const;
+
+    /** Transform size real values to the first size / 2 + 1 values of their
+     * spectrum. */
+    void
+    Forward(const TReal * in, ComplexType * out, ComplexType * scratch) const;
+
+    /** Transform the size / 2 + 1 first values of a Hermitian spectrum to
+     * size real values, multiplied by scale. The transform is otherwise
+     * not normalized. */
+    void
+    Backward(const ComplexType * in, TReal * out, ComplexType * scratch, TReal scale = 1) const;
+
+  private:
+    SizeValueType            m_Size;
+    ComplexPlan<TReal>       m_ComplexPlan;
+    std::vector<ComplexType> m_Twiddles;
+  };
+
+  /** Transform a complex image buffer in place along the dimensions
+   * firstDimension to VDimension - 1, and multiply the result by scale.
+   * The backward transform is otherwise not normalized. */
+  template <typename TReal, unsigned int VDimension>
+  static void
+  TransformComplexImage(std::complex<TReal> *    buffer,
+                        const Size<VDimension> & size,
+                        bool                     backward,
+                        MultiThreaderBase *      multiThreader,
+                        unsigned int             firstDimension = 0,
+                        TReal                    scale = 1);
+
+  /** Compute the half Hermitian spectrum of a real image buffer of size
+   * realSize. The output buffer holds realSize[0] / 2 + 1 values along the
+   * first dimension. */
+  template <typename TReal, unsigned int VDimension>
+  static void
+  TransformRealToHalfHermitian(const TReal *            in,
+                               std::complex<TReal> *    out,
+                               const Size<VDimension> & realSize,
+                               MultiThreaderBase *      multiThreader);
+
+  /** Compute the real image of size realSize from its half Hermitian
+   * spectrum, multiplied by scale. The input buffer is overwritten. */
+  template <typename TReal, unsigned int VDimension>
+  static void
+  TransformHalfHermitianToReal(std::complex<TReal> *    in,
+                               TReal *                  out,
+                               const Size<VDimension> & realSize,
+                               MultiThreaderBase *      multiThreader,
+                               TReal                    scale = 1);
+
+  /** Split [0, numberOfLines) in one range per work unit of the threader,
+   * and call function(firstLine, endLine) for each range in parallel. */
+  template <typename TFunction>
+  static void
+  ParallelizeLines(SizeValueType numberOfLines, MultiThreaderBase * multiThreader, const TFunction & function);
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkNativeFFTCommon.hxx"
+#endif
+
+#endif // itkNativeFFTCommon_h
@@ -0,0 +1,696 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeFFTCommon_hxx
+#define itkNativeFFTCommon_hxx
+
+#include "itkMath.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace itk
+{
+namespace NativeFFTDetail
+{
+// std::complex multiplication checks for infinities and NaNs, which
+// prevents the compiler from vectorizing the butterflies.
+template <typename TReal>
+inline std::complex<TReal>
+Multiply(const std::complex<TReal> & a, const std::complex<TReal> & b)
+{
+  return std::complex<TReal>(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+// exp(-2 i pi numerator / denominator), computed in double precision.
+template <typename TReal>
+inline std::complex<TReal>
+UnitRoot(SizeValueType numerator, SizeValueType denominator)
+{
+  const double angle = -2.0 * Math::pi * static_cast<double>(numerator) / static_cast<double>(denominator);
+  return std::complex<TReal>(static_cast<TReal>(std::cos(angle)), static_cast<TReal>(std::sin(angle)));
+}
+
+// A transform is not defined for an empty image.
+template <unsigned int VDimension>
+void
+CheckSize(const Size<VDimension> & size)
+{
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    if (size[d] == 0)
+    {
+      itkGenericExceptionMacro("Cannot compute the FFT of an image of size " << size);
+    }
+  }
+}
+} // namespace NativeFFTDetail
+
+template <typename TReal>
+NativeFFTCommon::ComplexPlan<TReal>::ComplexPlan(SizeValueType size)
+  : m_Size(size)
+{
+  if (size == 0)
+  {
+    itkGenericExceptionMacro("Cannot compute the FFT of a line of length 0");
+  }
+
+  // Factorize the size, radix 4 first, then 2, then odd radices.
+  SizeValueType       n = size;
+  SizeValueType       p = 4;
+  const SizeValueType floorSqrt = static_cast<SizeValueType>(std::floor(std::sqrt(static_cast<double>(n))));
+  bool                useBluestein = false;
+  while (n > 1)
+  {
+    while (n % p != 0)
+    {
+      switch (p)
+      {
+        case 4:
+          p = 2;
+          break;
+        case 2:
+          p = 3;
+          break;
+        default:
+          p += 2;
+          break;
+      }
+      if (p > floorSqrt)
+      {
+        p = n;
+      }
+    }
+    n /= p;
+    m_Factors.push_back(p);
+    m_Factors.push_back(n);
+    useBluestein = useBluestein || p > MaximumRadix;
+  }
+
+  if (!useBluestein)
+  {
+    m_Twiddles.resize(size);
+    for (SizeValueType i = 0; i < size; ++i)
+    {
+      m_Twiddles[i] = NativeFFTDetail::UnitRoot<TReal>(i, size);
+    }
+    return;
+  }
+
+  // Bluestein's algorithm: the transform is the product of a chirp with the
+  // circular convolution of the chirped signal with the conjugate chirp.
+  m_Factors.clear();
+  SizeValueType convolutionSize = 1;
+  while (convolutionSize < 2 * size - 1)
+  {
+    convolutionSize *= 2;
+  }
+  m_BluesteinPlan = std::make_unique<ComplexPlan>(convolutionSize);
+
+  m_Chirp.resize(size);
+  for (SizeValueType k = 0; k < size; ++k)
+  {
+    // exp(-i pi k^2 / n), with k^2 reduced modulo 2 n to keep the precision.
+    m_Chirp[k] = NativeFFTDetail::UnitRoot<TReal>((k * k) % (2 * size), 2 * size);
+  }
+
+  m_BluesteinKernel.assign(convolutionSize, ComplexType());
+  m_BluesteinKernel[0] = std::conj(m_Chirp[0]);
+  for (SizeValueType k = 1; k < size; ++k)
+  {
+    m_BluesteinKernel[k] = std::conj(m_Chirp[k]);
+    m_BluesteinKernel[convolutionSize - k] = std::conj(m_Chirp[k]);
+  }
+  std::vector<ComplexType> scratch(m_BluesteinPlan->GetScratchSize());
+  m_BluesteinPlan->Forward(m_BluesteinKernel.data(), scratch.data());
+  // Fold the normalization of the backward convolution transform in the
+  // kernel.
+  const TReal normalization = TReal{ 1 } / static_cast<TReal>(convolutionSize);
+  for (auto & value : m_BluesteinKernel)
+  {
+    value *= normalization;
+  }
+}
+
+template <typename TReal>
+SizeValueType
+NativeFFTCommon::ComplexPlan<TReal>::GetScratchSize() const
+{
+  if (m_BluesteinPlan)
+  {
+    return m_BluesteinPlan->GetSize() + m_BluesteinPlan->GetScratchSize();
+  }
+  return m_Size;
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::ComplexPlan<TReal>::Forward(ComplexType * data, ComplexType * scratch) const
+{
+  if (m_BluesteinPlan)
+  {
+    this->Bluestein(data, scratch);
+  }
+  else if (m_Size > 1)
+  {
+    std::copy_n(data, m_Size, scratch);
+    this->Work(data, scratch, 1, m_Factors.data());
+  }
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::ComplexPlan<TReal>::Backward(ComplexType * data, ComplexType * scratch) const
+{
+  // The backward transform is the conjugate of the forward transform of
+  // the conjugate.
+  for (SizeValueType i = 0; i < m_Size; ++i)
+  {
+    data[i] = std::conj(data[i]);
+  }
+  this->Forward(data, scratch);
+  for (SizeValueType i = 0; i < m_Size; ++i)
+  {
+    data[i] = std::conj(data[i]);
+  }
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::ComplexPlan<TReal>::Work(ComplexType *          out,
+                                          const ComplexType *    in,
+                                          SizeValueType          fstride,
+                                          const SizeValueType * factors) const
+{
+  const SizeValueType p = factors[0];
+  const SizeValueType m = factors[1];
+  ComplexType * const outBegin = out;
+  ComplexType * const outEnd = out + p * m;
+
+  if (m == 1)
+  {
+    for (; out != outEnd; ++out, in += fstride)
+    {
+      *out = *in;
+    }
+  }
+  else
+  {
+    // Transform the p interleaved sub-sequences of length m.
+    for (; out != outEnd; out += m, in += fstride)
+    {
+      this->Work(out, in, fstride * p, factors + 2);
+    }
+  }
+
+  switch (p)
+  {
+    case 2:
+      this->Butterfly2(outBegin, fstride, m);
+      break;
+    case 3:
+      this->Butterfly3(outBegin, fstride, m);
+      break;
+    case 4:
+      this->Butterfly4(outBegin, fstride, m);
+      break;
+    case 5:
+      this->Butterfly5(outBegin, fstride, m);
+      break;
+    default:
+      this->ButterflyGeneric(outBegin, fstride, m, p);
+      break;
+  }
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::ComplexPlan<TReal>::Butterfly2(ComplexType * out, SizeValueType fstride, SizeValueType m) const
+{
+  ComplexType * const out2 = out + m;
+  for (SizeValueType k = 0; k < m; ++k)
+  {
+    const ComplexType t = NativeFFTDetail::Multiply(out2[k], m_Twiddles[k * fstride]);
+    out2[k] = out[k] - t;
+    out[k] += t;
+  }
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::ComplexPlan<TReal>::Butterfly3(ComplexType * out, SizeValueType fstride, SizeValueType m) const
+{
+  const TReal epi3 = m_Twiddles[fstride * m].imag();
+  for (SizeValueType k = 0; k < m; ++k)
+  {
+    const ComplexType s1 = NativeFFTDetail::Multiply(out[k + m], m_Twiddles[k * fstride]);
+    const ComplexType s2 = NativeFFTDetail::Multiply(out[k + 2 * m], m_Twiddles[2 * k * fstride]);
+    const ComplexType s3 = s1 + s2;
+    const ComplexType s0 = (s1 - s2) * epi3;
+    const ComplexType a = out[k] - s3 * TReal{ 0.5 };
+
+    out[k] += s3;
+    out[k + m] = ComplexType(a.real() - s0.imag(), a.imag() + s0.real());
+    out[k + 2 * m] = ComplexType(a.real() + s0.imag(), a.imag() - s0.real());
+  }
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::ComplexPlan<TReal>::Butterfly4(ComplexType * out, SizeValueType fstride, SizeValueType m) const
+{
+  for (SizeValueType k = 0; k < m; ++k)
+  {
+    const ComplexType s0 = NativeFFTDetail::Multiply(out[k + m], m_Twiddles[k * fstride]);
+    const ComplexType s1 = NativeFFTDetail::Multiply(out[k + 2 * m], m_Twiddles[2 * k * fstride]);
+    const ComplexType s2 = NativeFFTDetail::Multiply(out[k + 3 * m], m_Twiddles[3 * k * fstride]);
+    const ComplexType s3 = s0 + s2;
+    const ComplexType s4 = s0 - s2;
+    const ComplexType s5 = out[k] - s1;
+    const ComplexType s6 = out[k] + s1;
+
+    out[k] = s6 + s3;
+    out[k + 2 * m] = s6 - s3;
+    out[k + m] = ComplexType(s5.real() + s4.imag(), s5.imag() - s4.real());
+    out[k + 3 * m] = ComplexType(s5.real() - s4.imag(), s5.imag() + s4.real());
+  }
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::ComplexPlan<TReal>::Butterfly5(ComplexType * out, SizeValueType fstride, SizeValueType m) const
+{
+  const ComplexType ya = m_Twiddles[fstride * m];
+  const ComplexType yb = m_Twiddles[2 * fstride * m];
+  for (SizeValueType k = 0; k < m; ++k)
+  {
+    const ComplexType s0 = out[k];
+    const ComplexType s1 = NativeFFTDetail::Multiply(out[k + m], m_Twiddles[k * fstride]);
+    const ComplexType s2 = NativeFFTDetail::Multiply(out[k + 2 * m], m_Twiddles[2 * k * fstride]);
+    const ComplexType s3 = NativeFFTDetail::Multiply(out[k + 3 * m], m_Twiddles[3 * k * fstride]);
+    const ComplexType s4 = NativeFFTDetail::Multiply(out[k + 4 * m], m_Twiddles[4 * k * fstride]);
+
+    const ComplexType s7 = s1 + s4;
+    const ComplexType s10 = s1 - s4;
+    const ComplexType s8 = s2 + s3;
+    const ComplexType s9 = s2 - s3;
+
+    out[k] = s0 + s7 + s8;
+
+    const ComplexType s5(s0.real() + s7.real() * ya.real() + s8.real() * yb.real(),
+                         s0.imag() + s7.imag() * ya.real() + s8.imag() * yb.real());
+    const ComplexType s6(s10.imag() * ya.imag() + s9.imag() * yb.imag(),
+                         -s10.real() * ya.imag() - s9.real() * yb.imag());
+    out[k + m] = s5 - s6;
+    out[k + 4 * m] = s5 + s6;
+
+    const ComplexType s11(s0.real() + s7.real() * yb.real() + s8.real() * ya.real(),
+                          s0.imag() + s7.imag() * yb.real() + s8.imag() * ya.real());
+    const ComplexType s12(-s10.imag() * yb.imag() + s9.imag() * ya.imag(),
+                          s10.real() * yb.imag() - s9.real() * ya.imag());
+    out[k + 2 * m] = s11 + s12;
+    out[k + 3 * m] = s11 - s12;
+  }
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::ComplexPlan<TReal>::ButterflyGeneric(ComplexType * out,
+                                                      SizeValueType fstride,
+                                                      SizeValueType m,
+                                                      SizeValueType p) const
+{
+  std::array<ComplexType, MaximumRadix> values;
+  for (SizeValueType u = 0; u < m; ++u)
+  {
+    for (SizeValueType q = 0; q < p; ++q)
+    {
+      values[q] = out[u + q * m];
+    }
+    for (SizeValueType q1 = 0; q1 < p; ++q1)
+    {
+      const SizeValueType k = u + q1 * m;
+      SizeValueType       twiddleIndex = 0;
+      ComplexType         sum = values[0];
+      for (SizeValueType q = 1; q < p; ++q)
+      {
+        twiddleIndex += fstride * k;
+        if (twiddleIndex >= m_Size)
+        {
+          twiddleIndex -= m_Size;
+        }
+        sum += NativeFFTDetail::Multiply(values[q], m_Twiddles[twiddleIndex]);
+      }
+      out[k] = sum;
+    }
+  }
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::ComplexPlan<TReal>::Bluestein(ComplexType * data, ComplexType * scratch) const
+{
+  const SizeValueType convolutionSize = m_BluesteinPlan->GetSize();
+  ComplexType * const convolution = scratch;
+  ComplexType * const convolutionScratch = scratch + convolutionSize;
+
+  for (SizeValueType k = 0; k < m_Size; ++k)
+  {
+    convolution[k] = NativeFFTDetail::Multiply(data[k], m_Chirp[k]);
+  }
+  std::fill(convolution + m_Size, convolution + convolutionSize, ComplexType());
+
+  m_BluesteinPlan->Forward(convolution, convolutionScratch);
+  for (SizeValueType k = 0; k < convolutionSize; ++k)
+  {
+    convolution[k] = NativeFFTDetail::Multiply(convolution[k], m_BluesteinKernel[k]);
+  }
+  m_BluesteinPlan->Backward(convolution, convolutionScratch);
+
+  for (SizeValueType k = 0; k < m_Size; ++k)
+  {
+    data[k] = NativeFFTDetail::Multiply(convolution[k], m_Chirp[k]);
+  }
+}
+
+template <typename TReal>
+NativeFFTCommon::RealPlan<TReal>::RealPlan(SizeValueType size)
+  : m_Size(size)
+  , m_ComplexPlan(size % 2 == 0 ? size / 2 : size)
+{
+  if (size % 2 == 0)
+  {
+    m_Twiddles.resize(size / 2 + 1);
+    for (SizeValueType k = 0; k <= size / 2; ++k)
+    {
+      m_Twiddles[k] = NativeFFTDetail::UnitRoot<TReal>(k, size);
+    }
+  }
+}
+
+template <typename TReal>
+SizeValueType
+NativeFFTCommon::RealPlan<TReal>::GetScratchSize() const
+{
+  return m_ComplexPlan.GetSize() + m_ComplexPlan.GetScratchSize();
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::RealPlan<TReal>::Forward(const TReal * in, ComplexType * out, ComplexType * scratch) const
+{
+  const SizeValueType n = m_ComplexPlan.GetSize();
+  ComplexType * const z = scratch;
+
+  if (m_Size % 2 != 0)
+  {
+    for (SizeValueType k = 0; k < n; ++k)
+    {
+      z[k] = ComplexType(in[k], 0);
+    }
+    m_ComplexPlan.Forward(z, scratch + n);
+    std::copy_n(z, m_Size / 2 + 1, out);
+    return;
+  }
+
+  // Transform the even and odd samples at once, as the real and imaginary
+  // parts of a complex signal of half the length, and separate their
+  // spectra.
+  for (SizeValueType k = 0; k < n; ++k)
+  {
+    z[k] = ComplexType(in[2 * k], in[2 * k + 1]);
+  }
+  m_ComplexPlan.Forward(z, scratch + n);
+
+  out[0] = ComplexType(z[0].real() + z[0].imag(), 0);
+  out[n] = ComplexType(z[0].real() - z[0].imag(), 0);
+  for (SizeValueType k = 1; k < n; ++k)
+  {
+    const ComplexType a = z[k];
+    const ComplexType b = std::conj(z[n - k]);
+    const ComplexType even = (a + b) * TReal{ 0.5 };
+    const ComplexType oddTimesI = (a - b) * TReal{ 0.5 };
+    const ComplexType odd(oddTimesI.imag(), -oddTimesI.real());
+    out[k] = even + NativeFFTDetail::Multiply(m_Twiddles[k], odd);
+  }
+}
+
+template <typename TReal>
+void
+NativeFFTCommon::RealPlan<TReal>::Backward(const ComplexType * in,
+                                           TReal *             out,
+                                           ComplexType *       scratch,
+                                           TReal               scale) const
+{
+  const SizeValueType n = m_ComplexPlan.GetSize();
+  ComplexType * const z = scratch;
+
+  if (m_Size % 2 != 0)
+  {
+    // Rebuild the full spectrum from its Hermitian symmetry.
+    z[0] = in[0];
+    for (SizeValueType k = 1; k <= n / 2; ++k)
+    {
+      z[k] = in[k];
+      z[n - k] = std::conj(in[k]);
+    }
+    m_ComplexPlan.Backward(z, scratch + n);
+    for (SizeValueType k = 0; k < n; ++k)
+    {
+      out[k] = z[k].real() * scale;
+    }
+    return;
+  }
+
+  // Combine the spectra of the even and odd samples in the spectrum of a
+  // complex signal of half the length.
+  for (SizeValueType k = 0; k < n; ++k)
+  {
+    const ComplexType a = in[k];
+    const ComplexType b = std::conj(in[n - k]);
+    const ComplexType even = a + b;
+    const ComplexType odd = NativeFFTDetail::Multiply(a - b, std::conj(m_Twiddles[k]));
+    z[k] = ComplexType(even.real() - odd.imag(), even.imag() + odd.real());
+  }
+  m_ComplexPlan.Backward(z, scratch + n);
+  for (SizeValueType k = 0; k < n; ++k)
+  {
+    out[2 * k] = z[k].real() * scale;
+    out[2 * k + 1] = z[k].imag() * scale;
+  }
+}
+
+template <typename TFunction>
+void
+NativeFFTCommon::ParallelizeLines(SizeValueType       numberOfLines,
+                                  MultiThreaderBase * multiThreader,
+                                  const TFunction &   function)
+{
+  const SizeValueType numberOfRanges =
+    std::min(numberOfLines, static_cast<SizeValueType>(multiThreader->GetNumberOfWorkUnits()));
+  if (numberOfRanges == 0)
+  {
+    return;
+  }
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfRanges,
+    [numberOfLines, numberOfRanges, &function](SizeValueType range) {
+      function(range * numberOfLines / numberOfRanges, (range + 1) * numberOfLines / numberOfRanges);
+    },
+    nullptr);
+}
+
+template <typename TReal, unsigned int VDimension>
+void
+NativeFFTCommon::TransformComplexImage(std::complex<TReal> *    buffer,
+                                       const Size<VDimension> & size,
+                                       bool                     backward,
+                                       MultiThreaderBase *      multiThreader,
+                                       unsigned int             firstDimension,
+                                       TReal                    scale)
+{
+  using ComplexType = std::complex<TReal>;
+
+  NativeFFTDetail::CheckSize(size);
+  const SizeValueType numberOfPixels = size.CalculateProductOfElements();
+
+  // The result is scaled while it is written by the last transform.
+  unsigned int lastDimension = VDimension;
+  for (unsigned int d = firstDimension; d < VDimension; ++d)
+  {
+    if (size[d] > 1)
+    {
+      lastDimension = d;
+    }
+  }
+  if (lastDimension == VDimension)
+  {
+    if (scale != TReal{ 1 })
+    {
+      for (SizeValueType i = 0; i < numberOfPixels; ++i)
+      {
+        buffer[i] *= scale;
+      }
+    }
+    return;
+  }
+
+  SizeValueType stride = 1;
+  for (unsigned int d = 0; d < firstDimension; ++d)
+  {
+    stride *= size[d];
+  }
+
+  for (unsigned int d = firstDimension; d <= lastDimension; ++d)
+  {
+    const SizeValueType n = size[d];
+    if (n > 1)
+    {
+      const ComplexPlan<TReal> plan(n);
+      const TReal              lineScale = (d == lastDimension) ? scale : TReal{ 1 };
+
+      const auto transformLine = [&plan, backward, lineScale](ComplexType * line, ComplexType * scratch) {
+        if (backward)
+        {
+          plan.Backward(line, scratch);
+        }
+        else
+        {
+          plan.Forward(line, scratch);
+        }
+        if (lineScale != TReal{ 1 })
+        {
+          for (SizeValueType i = 0; i < plan.GetSize(); ++i)
+          {
+            line[i] *= lineScale;
+          }
+        }
+      };
+
+      ParallelizeLines(
+        numberOfPixels / n, multiThreader, [&, n, stride](SizeValueType firstLine, SizeValueType endLine) {
+          std::vector<ComplexType> scratch(plan.GetScratchSize());
+          if (stride == 1)
+          {
+            // The lines are contiguous.
+            for (SizeValueType line = firstLine; line < endLine; ++line)
+            {
+              transformLine(buffer + line * n, scratch.data());
+            }
+            return;
+          }
+
+          // Gather up to PanelWidth lines with consecutive offsets together,
+          // so that each row of the panel is read from contiguous memory.
+          std::vector<ComplexType> panel(PanelWidth * n);
+          for (SizeValueType line = firstLine; line < endLine;)
+          {
+            const SizeValueType inner = line % stride;
+            const SizeValueType outer = line / stride;
+            const SizeValueType width = std::min({ PanelWidth, stride - inner, endLine - line });
+            ComplexType * const start = buffer + outer * stride * n + inner;
+
+            for (SizeValueType i = 0; i < n; ++i)
+            {
+              for (SizeValueType b = 0; b < width; ++b)
+              {
+                panel[b * n + i] = start[i * stride + b];
+              }
+            }
+            for (SizeValueType b = 0; b < width; ++b)
+            {
+              transformLine(panel.data() + b * n, scratch.data());
+            }
+            for (SizeValueType i = 0; i < n; ++i)
+            {
+              for (SizeValueType b = 0; b < width; ++b)
+              {
+                start[i * stride + b] = panel[b * n + i];
+              }
+            }
+            line += width;
+          }
+        });
+    }
+    stride *= n;
+  }
+}
+
+template <typename TReal, unsigned int VDimension>
+void
+NativeFFTCommon::TransformRealToHalfHermitian(const TReal *            in,
+                                              std::complex<TReal> *    out,
+                                              const Size<VDimension> & realSize,
+                                              MultiThreaderBase *      multiThreader)
+{
+  using ComplexType = std::complex<TReal>;
+
+  NativeFFTDetail::CheckSize(realSize);
+  const SizeValueType realLength = realSize[0];
+  const SizeValueType halfLength = realLength / 2 + 1;
+  const RealPlan<TReal> plan(realLength);
+
+  ParallelizeLines(realSize.CalculateProductOfElements() / realLength,
+                   multiThreader,
+                   [&](SizeValueType firstLine, SizeValueType endLine) {
+                     std::vector<ComplexType> scratch(plan.GetScratchSize());
+                     for (SizeValueType line = firstLine; line < endLine; ++line)
+                     {
+                       plan.Forward(in + line * realLength, out + line * halfLength, scratch.data());
+                     }
+                   });
+
+  Size<VDimension> halfSize = realSize;
+  halfSize[0] = halfLength;
+  TransformComplexImage(out, halfSize, false, multiThreader, 1);
+}
+
+template <typename TReal, unsigned int VDimension>
+void
+NativeFFTCommon::TransformHalfHermitianToReal(std::complex<TReal> *    in,
+                                              TReal *                  out,
+                                              const Size<VDimension> & realSize,
+                                              MultiThreaderBase *      multiThreader,
+                                              TReal                    scale)
+{
+  using ComplexType = std::complex<TReal>;
+
+  NativeFFTDetail::CheckSize(realSize);
+  const SizeValueType realLength = realSize[0];
+  const SizeValueType halfLength = realLength / 2 + 1;
+
+  Size<VDimension> halfSize = realSize;
+  halfSize[0] = halfLength;
+  TransformComplexImage(in, halfSize, true, multiThreader, 1);
+
+  const RealPlan<TReal> plan(realLength);
+  ParallelizeLines(realSize.CalculateProductOfElements() / realLength,
+                   multiThreader,
+                   [&](SizeValueType firstLine, SizeValueType endLine) {
+                     std::vector<ComplexType> scratch(plan.GetScratchSize());
+                     for (SizeValueType line = firstLine; line < endLine; ++line)
+                     {
+                       plan.Backward(in + line * halfLength, out + line * realLength, scratch.data(), scale);
+                     }
+                   });
+}
+
+} // namespace itk
+
+#endif // itkNativeFFTCommon_hxx
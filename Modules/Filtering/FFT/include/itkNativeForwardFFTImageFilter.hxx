@@ -0,0 +1,88 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeForwardFFTImageFilter_hxx
+#define itkNativeForwardFFTImageFilter_hxx
+
+#include "itkHalfToFullHermitianImageFilter.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+void
+NativeForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  // Get pointers to the input and output.
+  typename InputImageType::ConstPointer inputPtr = this->GetInput();
+  typename OutputImageType::Pointer     outputPtr = this->GetOutput();
+
+  if (!inputPtr || !outputPtr)
+  {
+    return;
+  }
+
+  // We don't have a nice progress to report, but at least this simple line
+  // reports the beginning and the end of the process.
+  ProgressReporter progress(this, 0, 1);
+
+  // allocate output buffer memory
+  outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
+  outputPtr->Allocate();
+
+  const InputSizeType inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+
+  // Set up image to hold the half spectrum.
+  typename OutputImageType::SizeType halfSize(outputPtr->GetLargestPossibleRegion().GetSize());
+  halfSize[0] = (halfSize[0] / 2) + 1;
+  typename OutputImageType::RegionType halfRegion(outputPtr->GetLargestPossibleRegion());
+  halfRegion.SetSize(halfSize);
+
+  auto halfOutput = OutputImageType::New();
+  // The information is copied to the half image so that it will then
+  // be copied to the final output of this filter.
+  halfOutput->CopyInformation(inputPtr);
+  halfOutput->SetRegions(halfRegion);
+  halfOutput->Allocate();
+
+  auto * out = reinterpret_cast<std::complex<InputPixelType> *>(halfOutput->GetBufferPointer());
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  NativeFFTCommon::TransformRealToHalfHermitian(inputPtr->GetBufferPointer(), out, inputSize, this->GetMultiThreader());
+
+  // Expand the half image to the full image size
+  using HalfToFullFilterType = HalfToFullHermitianImageFilter<OutputImageType>;
+  auto halfToFullFilter = HalfToFullFilterType::New();
+  halfToFullFilter->SetActualXDimensionIsOdd(inputSize[0] % 2 != 0);
+  halfToFullFilter->SetInput(halfOutput);
+  halfToFullFilter->GraftOutput(this->GetOutput());
+  halfToFullFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  halfToFullFilter->UpdateLargestPossibleRegion();
+  this->GraftOutput(halfToFullFilter->GetOutput());
+}
+
+template <typename TInputImage, typename TOutputImage>
+SizeValueType
+NativeForwardFFTImageFilter<TInputImage, TOutputImage>::GetSizeGreatestPrimeFactor() const
+{
+  return NativeFFTCommon::GREATEST_PRIME_FACTOR;
+}
+
+} // namespace itk
+
+#endif
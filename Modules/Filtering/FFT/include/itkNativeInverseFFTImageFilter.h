@@ -0,0 +1,114 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeInverseFFTImageFilter_h
+#define itkNativeInverseFFTImageFilter_h
+
+#include "itkInverseFFTImageFilter.h"
+
+#include "itkNativeFFTCommon.h"
+#include "itkFFTImageFilterFactory.h"
+
+namespace itk
+{
+/**
+ * \class NativeInverseFFTImageFilter
+ *
+ * \brief Multithreaded inverse Fast Fourier Transform which does not depend
+ * on an external FFT library.
+ *
+ * The input is assumed to be Hermitian: only half of the spectrum is used
+ * by the complex to real transform of NativeFFTCommon. Images of any size
+ * are supported, but the transform is fastest when the prime factorization
+ * of the size in each dimension consists of 2s, 3s, and 5s.
+ *
+ * \ingroup FourierTransform
+ *
+ * \sa InverseFFTImageFilter
+ * \sa NativeFFTCommon
+ * \ingroup ITKFFT
+ *
+ */
+template <typename TInputImage,
+          typename TOutputImage = Image<typename TInputImage::PixelType::value_type, TInputImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT NativeInverseFFTImageFilter : public InverseFFTImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(NativeInverseFFTImageFilter);
+
+  /** Standard class type aliases. */
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using InputSizeType = typename InputImageType::SizeType;
+  using InputSizeValueType = typename InputImageType::SizeValueType;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputSizeType = typename OutputImageType::SizeType;
+
+  using Self = NativeInverseFFTImageFilter;
+  using Superclass = InverseFFTImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(NativeInverseFFTImageFilter);
+
+  /** Extract the dimensionality of the images. They are assumed to be
+   * the same. */
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+  static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
+  static constexpr unsigned int OutputImageDimension = TOutputImage::ImageDimension;
+
+  SizeValueType
+  GetSizeGreatestPrimeFactor() const override;
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  // Begin concept checking
+  itkConceptMacro(ImageDimensionsMatchCheck, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
+  // End concept checking
+#endif
+
+protected:
+  NativeInverseFFTImageFilter() = default;
+  ~NativeInverseFFTImageFilter() override = default;
+
+  void
+  GenerateData() override;
+};
+
+// Describe whether input/output are real- or complex-valued
+// for factory registration
+template <>
+struct FFTImageFilterTraits<NativeInverseFFTImageFilter>
+{
+  template <typename TUnderlying>
+  using InputPixelType = std::complex<TUnderlying>;
+  template <typename TUnderlying>
+  using OutputPixelType = TUnderlying;
+  using FilterDimensions = std::integer_sequence<unsigned int, 4, 3, 2, 1>;
+};
+
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkNativeInverseFFTImageFilter.hxx"
+#endif
+
+#endif
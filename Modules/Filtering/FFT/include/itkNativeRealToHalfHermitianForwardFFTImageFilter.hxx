@@ -0,0 +1,63 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeRealToHalfHermitianForwardFFTImageFilter_hxx
+#define itkNativeRealToHalfHermitianForwardFFTImageFilter_hxx
+
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+void
+NativeRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  // Get pointers to the input and output.
+  typename InputImageType::ConstPointer inputPtr = this->GetInput();
+  typename OutputImageType::Pointer     outputPtr = this->GetOutput();
+
+  if (!inputPtr || !outputPtr)
+  {
+    return;
+  }
+
+  // We don't have a nice progress to report, but at least this simple line
+  // reports the beginning and the end of the process.
+  ProgressReporter progress(this, 0, 1);
+
+  const InputSizeType inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+
+  outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
+  outputPtr->Allocate();
+
+  auto * out = reinterpret_cast<std::complex<InputPixelType> *>(outputPtr->GetBufferPointer());
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  NativeFFTCommon::TransformRealToHalfHermitian(inputPtr->GetBufferPointer(), out, inputSize, this->GetMultiThreader());
+}
+
+template <typename TInputImage, typename TOutputImage>
+SizeValueType
+NativeRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::GetSizeGreatestPrimeFactor() const
+{
+  return NativeFFTCommon::GREATEST_PRIME_FACTOR;
+}
+
+} // namespace itk
+
+#endif
@@ -1,12 +1,15 @@
 set(DOCUMENTATION
     "This module provides interfaces to FFT
 implementations. In particular it provides the direct and inverse
-computations of Fast Fourier Transforms based on
-<a href=\"http://vxl.sourceforge.net/\">VXL</a> and
+computations of Fast Fourier Transforms based on a native multithreaded
+implementation, on <a href=\"http://vxl.sourceforge.net/\">VXL</a> and on
 <a href=\"https://www.fftw.org\">FFTW</a>. Note that when using the FFTW
 implementation you must comply with the GPL license.")
 
-set(_fft_backends "FFTImageFilterInit::Vnl")
+# Vnl remains the default backend: the native backend is registered after
+# it, and is opted in by instantiating the Native filters, or by disabling
+# the Vnl factories
+set(_fft_backends "FFTImageFilterInit::Vnl;FFTImageFilterInit::Native")
 if(ITK_USE_FFTWF OR ITK_USE_FFTWD)
   # Prepend so that FFTW constructor is preferred
   list(PREPEND _fft_backends "FFTImageFilterInit::FFTW")
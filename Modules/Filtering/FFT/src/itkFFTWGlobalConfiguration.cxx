@@ -20,6 +20,7 @@
 #if defined(ITK_USE_FFTWF) || defined(ITK_USE_FFTWD)
 
 #  include "itkSingleton.h"
+#  include <iterator>
 
 
 #  include "itksys/SystemTools.hxx"
@@ -469,6 +470,21 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
     }
   }
 
+  {
+    std::string planCacheSizeEnv;
+    if (itksys::SystemTools::GetEnv("ITK_FFTW_PLAN_CACHE_SIZE", planCacheSizeEnv))
+    {
+      try
+      {
+        this->m_PlanCacheSize = std::stoul(planCacheSizeEnv);
+      }
+      catch (...)
+      {
+        itkWarningMacro("Warning: Invalid FFTW PLAN CACHE SIZE: " << planCacheSizeEnv);
+      }
+    }
+  }
+
   if (this->m_ReadWisdomCache)
   {
     std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -485,6 +501,10 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
 
 FFTWGlobalConfiguration::~FFTWGlobalConfiguration()
 {
+  // The cached plans must be destroyed before FFTW is cleaned up.
+  this->m_PlanCacheIndex.clear();
+  this->m_PlanCache.clear();
+
   if (this->m_WriteWisdomCache && this->m_NewWisdomAvailable)
   {
     std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -824,6 +844,129 @@ FFTWGlobalConfiguration::GetWisdomCacheBase()
   return GetInstance()->m_WisdomCacheBase;
 }
 
+void
+FFTWGlobalConfiguration::SetPlanCacheSize(const SizeValueType v)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer           instance = GetInstance();
+  PlanCacheListType evicted;
+  {
+    const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+    instance->m_PlanCacheSize = v;
+    instance->TrimPlanCache(evicted);
+  }
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                           instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  return instance->m_PlanCacheSize;
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetNumberOfCachedPlans()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                           instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  return instance->m_PlanCache.size();
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheHits()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                           instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  return instance->m_PlanCacheHits;
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheMisses()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                           instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  return instance->m_PlanCacheMisses;
+}
+
+void
+FFTWGlobalConfiguration::ResetPlanCacheStatistics()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                           instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  instance->m_PlanCacheHits = 0;
+  instance->m_PlanCacheMisses = 0;
+}
+
+void
+FFTWGlobalConfiguration::ClearPlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer           instance = GetInstance();
+  PlanCacheListType plans;
+  {
+    const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+    instance->m_PlanCacheIndex.clear();
+    plans.swap(instance->m_PlanCache);
+  }
+  // The plans are released on return, without holding the cache mutex,
+  // because destroying a plan takes the FFTW lock.
+}
+
+FFTWGlobalConfiguration::PlanHandleType
+FFTWGlobalConfiguration::GetCachedPlan(const PlanCacheKeyType & key)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                           instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  const auto                        it = instance->m_PlanCacheIndex.find(key);
+  if (it == instance->m_PlanCacheIndex.end())
+  {
+    ++instance->m_PlanCacheMisses;
+    return nullptr;
+  }
+  ++instance->m_PlanCacheHits;
+  // Move the plan to the front of the list, which holds the most recently
+  // used plans.
+  instance->m_PlanCache.splice(instance->m_PlanCache.begin(), instance->m_PlanCache, it->second);
+  return it->second->second;
+}
+
+void
+FFTWGlobalConfiguration::AddCachedPlan(const PlanCacheKeyType & key, const PlanHandleType & plan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer           instance = GetInstance();
+  PlanCacheListType evicted;
+  {
+    const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+    if (instance->m_PlanCacheSize == 0 || instance->m_PlanCacheIndex.count(key) != 0)
+    {
+      // The cache is disabled, or another thread cached an equivalent plan
+      // in the meantime.
+      return;
+    }
+    instance->m_PlanCache.emplace_front(key, plan);
+    instance->m_PlanCacheIndex[key] = instance->m_PlanCache.begin();
+    instance->TrimPlanCache(evicted);
+  }
+}
+
+void
+FFTWGlobalConfiguration::TrimPlanCache(PlanCacheListType & evicted)
+{
+  while (m_PlanCache.size() > m_PlanCacheSize)
+  {
+    m_PlanCacheIndex.erase(m_PlanCache.back().first);
+    evicted.splice(evicted.end(), m_PlanCache, std::prev(m_PlanCache.end()));
+  }
+}
+
 } // end namespace itk
 
 #endif
@@ -0,0 +1,159 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTWCommon.h"
+#include "itkFFTWRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+#if defined(ITK_USE_FFTWD)
+using PixelType = double;
+#else
+using PixelType = float;
+#endif
+using RealImageType = itk::Image<PixelType, 2>;
+using ComplexImageType = itk::Image<std::complex<PixelType>, 2>;
+using FFTFilterType = itk::FFTWRealToHalfHermitianForwardFFTImageFilter<RealImageType, ComplexImageType>;
+
+RealImageType::Pointer
+MakeImage(itk::SizeValueType sizeX, itk::SizeValueType sizeY)
+{
+  using SourceType = itk::RandomImageSource<RealImageType>;
+  auto                    source = SourceType::New();
+  RealImageType::SizeType size = { { sizeX, sizeY } };
+  source->SetSize(size);
+  source->SetMin(0.0);
+  source->SetMax(1.0);
+  source->Update();
+  return source->GetOutput();
+}
+
+// Plans created for buffers of different alignments may use different
+// algorithms, so the results are compared with a tolerance.
+bool
+SameImages(const ComplexImageType * image1, const ComplexImageType * image2)
+{
+  itk::ImageRegionConstIterator<ComplexImageType> it1(image1, image1->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ComplexImageType> it2(image2, image2->GetLargestPossibleRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (std::abs(it1.Get() - it2.Get()) > 1e-4 * (1.0 + std::abs(it1.Get())))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkFFTWPlanCacheTest(int, char *[])
+{
+  itk::FFTWGlobalConfiguration::SetPlanCacheSize(2);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 2);
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  itk::FFTWGlobalConfiguration::ResetPlanCacheStatistics();
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans(), 0);
+
+  // A second identical request, on the same buffers, is served from the
+  // cache with the plan of the first one.
+  using ProxyType = itk::fftw::Proxy<PixelType>;
+  std::vector<PixelType>               realBuffer(16 * 12);
+  std::vector<std::complex<PixelType>> complexBuffer(9 * 12);
+  auto * const                         realData = realBuffer.data();
+  auto * const                         complexData = reinterpret_cast<ProxyType::ComplexType *>(complexBuffer.data());
+  const int                            sizes[2] = { 12, 16 };
+  const ProxyType::PlanHandleType plan = ProxyType::CachedPlan_dft_r2c(2, sizes, realData, complexData, FFTW_ESTIMATE);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheMisses(), 1);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheHits(), 0);
+  const ProxyType::PlanHandleType samePlan =
+    ProxyType::CachedPlan_dft_r2c(2, sizes, realData, complexData, FFTW_ESTIMATE);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheMisses(), 1);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheHits(), 1);
+  ITK_TEST_EXPECT_TRUE(plan == samePlan);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans(), 1);
+
+  // Another request misses the cache.
+  const ProxyType::PlanHandleType backwardPlan =
+    ProxyType::CachedPlan_dft_c2r(2, sizes, complexData, realData, FFTW_ESTIMATE);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheMisses(), 2);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheHits(), 1);
+  ITK_TEST_EXPECT_TRUE(plan != backwardPlan);
+
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  itk::FFTWGlobalConfiguration::ResetPlanCacheStatistics();
+
+  const RealImageType::Pointer image = MakeImage(16, 12);
+
+  // The first transform creates a plan and adds it to the cache, later
+  // transforms look their plan up in the cache.
+  auto filter = FFTFilterType::New();
+  filter->SetInput(image);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheMisses(), 1);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheHits(), 0);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans(), 1);
+
+  const ComplexImageType::Pointer firstOutput = filter->GetOutput();
+  firstOutput->DisconnectPipeline();
+  image->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheMisses() +
+                          itk::FFTWGlobalConfiguration::GetPlanCacheHits(),
+                        2);
+  ITK_TEST_EXPECT_TRUE(SameImages(firstOutput, filter->GetOutput()));
+
+  // Another filter instance shares the cache. It may only miss if its
+  // buffers are not aligned as the ones of the first filter.
+  auto otherFilter = FFTFilterType::New();
+  otherFilter->SetInput(image);
+  ITK_TRY_EXPECT_NO_EXCEPTION(otherFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheMisses() +
+                          itk::FFTWGlobalConfiguration::GetPlanCacheHits(),
+                        3);
+  ITK_TEST_EXPECT_TRUE(SameImages(firstOutput, otherFilter->GetOutput()));
+
+  // Transforms of other sizes evict the least recently used plans.
+  for (const itk::SizeValueType sizeX : { 10, 20, 30 })
+  {
+    auto sizeFilter = FFTFilterType::New();
+    sizeFilter->SetInput(MakeImage(sizeX, 8));
+    ITK_TRY_EXPECT_NO_EXCEPTION(sizeFilter->Update());
+    ITK_TEST_EXPECT_TRUE(itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans() <= 2);
+  }
+
+  // Without the cache, every transform creates and destroys its own plan,
+  // and the results do not change.
+  itk::FFTWGlobalConfiguration::SetPlanCacheSize(0);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans(), 0);
+  auto uncachedFilter = FFTFilterType::New();
+  uncachedFilter->SetInput(image);
+  ITK_TRY_EXPECT_NO_EXCEPTION(uncachedFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans(), 0);
+  ITK_TEST_EXPECT_TRUE(SameImages(firstOutput, uncachedFilter->GetOutput()));
+
+  itk::FFTWGlobalConfiguration::ResetPlanCacheStatistics();
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheHits(), 0);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheMisses(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTTest.h"
+#include "itkNativeComplexToComplexFFTImageFilter.h"
+#include "itkNativeForwardFFTImageFilter.h"
+#include "itkNativeInverseFFTImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Compare the native transforms of an image with a direct evaluation of the
+// discrete Fourier transform.
+template <typename TPixel, unsigned int VDimension>
+int
+CompareWithDFT(const unsigned int * sizeOfDimensions)
+{
+  using RealImageType = itk::Image<TPixel, VDimension>;
+  using ComplexImageType = itk::Image<std::complex<TPixel>, VDimension>;
+
+  typename RealImageType::SizeType size;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    size[d] = sizeOfDimensions[d];
+  }
+  auto image = RealImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  vnl_sample_reseed(123456);
+  for (itk::ImageRegionIterator<RealImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(vnl_sample_uniform(-1.0, 1.0));
+  }
+
+  auto forward = itk::NativeForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  forward->SetInput(image);
+  forward->Update();
+
+  using ComplexFilterType = itk::NativeComplexToComplexFFTImageFilter<ComplexImageType>;
+  auto inverseComplex = ComplexFilterType::New();
+  inverseComplex->SetInput(forward->GetOutput());
+  inverseComplex->SetTransformDirection(ComplexFilterType::TransformDirectionEnum::INVERSE);
+  inverseComplex->Update();
+
+  const itk::SizeValueType numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  const TPixel *           in = image->GetBufferPointer();
+  const auto *             spectrum = forward->GetOutput()->GetBufferPointer();
+  const auto *             roundTrip = inverseComplex->GetOutput()->GetBufferPointer();
+
+  double maximumError = 0.0;
+  for (itk::SizeValueType k = 0; k < numberOfPixels; ++k)
+  {
+    const typename RealImageType::IndexType frequency = image->ComputeIndex(k);
+    std::complex<double>                    expected = 0.0;
+    for (itk::SizeValueType j = 0; j < numberOfPixels; ++j)
+    {
+      const typename RealImageType::IndexType position = image->ComputeIndex(j);
+      double                                  phase = 0.0;
+      for (unsigned int d = 0; d < VDimension; ++d)
+      {
+        phase += static_cast<double>(frequency[d] * position[d]) / static_cast<double>(size[d]);
+      }
+      expected += static_cast<double>(in[j]) * std::polar(1.0, -2.0 * itk::Math::pi * phase);
+    }
+    maximumError = std::max(maximumError, std::abs(std::complex<double>(spectrum[k]) - expected));
+    maximumError = std::max(maximumError, std::abs(std::complex<double>(roundTrip[k]) - static_cast<double>(in[k])));
+  }
+
+  const double tolerance = 100.0 * std::numeric_limits<TPixel>::epsilon() * static_cast<double>(numberOfPixels);
+  std::cerr << "Maximum error " << maximumError << ", tolerance " << tolerance << std::endl;
+  return maximumError <= tolerance ? 0 : 1;
+}
+} // namespace
+
+// Test the native FFT filters. The sizes do not need to have only 2, 3
+// and 5 as prime factors: (7,6,4) uses the generic butterfly, (17,9,4) and
+// (3,22,2) use Bluestein's algorithm.
+int
+itkNativeFFTTest(int, char *[])
+{
+  using ImageF1 = itk::Image<float, 1>;
+  using ImageCF1 = itk::Image<std::complex<float>, 1>;
+  using ImageF2 = itk::Image<float, 2>;
+  using ImageCF2 = itk::Image<std::complex<float>, 2>;
+  using ImageF3 = itk::Image<float, 3>;
+  using ImageCF3 = itk::Image<std::complex<float>, 3>;
+  using ImageF4 = itk::Image<float, 4>;
+  using ImageCF4 = itk::Image<std::complex<float>, 4>;
+
+  using ImageD1 = itk::Image<double, 1>;
+  using ImageCD1 = itk::Image<std::complex<double>, 1>;
+  using ImageD2 = itk::Image<double, 2>;
+  using ImageCD2 = itk::Image<std::complex<double>, 2>;
+  using ImageD3 = itk::Image<double, 3>;
+  using ImageCD3 = itk::Image<std::complex<double>, 3>;
+
+  auto forwardFilter = itk::NativeForwardFFTImageFilter<ImageF2>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(forwardFilter, NativeForwardFFTImageFilter, ForwardFFTImageFilter);
+
+  auto inverseFilter = itk::NativeInverseFFTImageFilter<ImageCF2>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(inverseFilter, NativeInverseFFTImageFilter, InverseFFTImageFilter);
+
+  auto complexFilter = itk::NativeComplexToComplexFFTImageFilter<ImageCF2>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    complexFilter, NativeComplexToComplexFFTImageFilter, ComplexToComplexFFTImageFilter);
+
+  unsigned int SizeOfDimensions1[] = { 4, 4, 4, 4 };
+  unsigned int SizeOfDimensions2[] = { 3, 5, 4 };
+  unsigned int SizeOfDimensions3[] = { 7, 6, 4 };
+  unsigned int SizeOfDimensions4[] = { 17, 9, 4 };
+  unsigned int SizeOfDimensions5[] = { 3, 22, 2 };
+  int          rval = 0;
+
+  for (unsigned int * sizeOfDimensions :
+       { SizeOfDimensions1, SizeOfDimensions2, SizeOfDimensions3, SizeOfDimensions4, SizeOfDimensions5 })
+  {
+    std::cerr << "Native (" << sizeOfDimensions[0] << ',' << sizeOfDimensions[1] << ',' << sizeOfDimensions[2] << ')'
+              << std::endl;
+    rval += test_fft<float, 1, itk::NativeForwardFFTImageFilter<ImageF1>, itk::NativeInverseFFTImageFilter<ImageCF1>>(
+              sizeOfDimensions) != 0;
+    rval += test_fft<float, 2, itk::NativeForwardFFTImageFilter<ImageF2>, itk::NativeInverseFFTImageFilter<ImageCF2>>(
+              sizeOfDimensions) != 0;
+    rval += test_fft<float, 3, itk::NativeForwardFFTImageFilter<ImageF3>, itk::NativeInverseFFTImageFilter<ImageCF3>>(
+              sizeOfDimensions) != 0;
+    rval += test_fft<double, 1, itk::NativeForwardFFTImageFilter<ImageD1>, itk::NativeInverseFFTImageFilter<ImageCD1>>(
+              sizeOfDimensions) != 0;
+    rval += test_fft<double, 2, itk::NativeForwardFFTImageFilter<ImageD2>, itk::NativeInverseFFTImageFilter<ImageCD2>>(
+              sizeOfDimensions) != 0;
+    rval += test_fft<double, 3, itk::NativeForwardFFTImageFilter<ImageD3>, itk::NativeInverseFFTImageFilter<ImageCD3>>(
+              sizeOfDimensions) != 0;
+
+    rval += CompareWithDFT<float, 3>(sizeOfDimensions);
+    rval += CompareWithDFT<double, 3>(sizeOfDimensions);
+  }
+  rval += test_fft<float, 4, itk::NativeForwardFFTImageFilter<ImageF4>, itk::NativeInverseFFTImageFilter<ImageCF4>>(
+            SizeOfDimensions1) != 0;
+
+  // The native and VNL transforms agree on the sizes supported by VNL.
+  for (unsigned int * sizeOfDimensions : { SizeOfDimensions1, SizeOfDimensions2 })
+  {
+    std::cerr << "Native and Vnl (" << sizeOfDimensions[0] << ',' << sizeOfDimensions[1] << ','
+              << sizeOfDimensions[2] << ')' << std::endl;
+    rval += test_fft_rtc<double, 1, itk::NativeForwardFFTImageFilter<ImageD1>, itk::VnlForwardFFTImageFilter<ImageD1>>(
+              sizeOfDimensions) != 0;
+    rval += test_fft_rtc<double, 2, itk::NativeForwardFFTImageFilter<ImageD2>, itk::VnlForwardFFTImageFilter<ImageD2>>(
+              sizeOfDimensions) != 0;
+    rval += test_fft_rtc<double, 3, itk::NativeForwardFFTImageFilter<ImageD3>, itk::VnlForwardFFTImageFilter<ImageD3>>(
+              sizeOfDimensions) != 0;
+  }
+
+  // The transform of an empty image is not defined.
+  const itk::Size<2> emptySize{ { 0, 3 } };
+  ITK_TRY_EXPECT_EXCEPTION(
+    (itk::NativeFFTCommon::TransformComplexImage<double, 2>(nullptr, emptySize, false, nullptr)));
+  ITK_TRY_EXPECT_EXCEPTION(
+    (itk::NativeFFTCommon::TransformRealToHalfHermitian<double, 2>(nullptr, nullptr, emptySize, nullptr)));
+
+  if (rval != 0)
+  {
+    std::cerr << "Test failed " << rval << " times." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRealFFTTest.h"
+#include "itkNativeHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkNativeRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Test the native real to half Hermitian transforms, on sizes with only 2, 3
+// and 5 as prime factors, and on sizes which use the generic butterfly
+// (7,6,4) and Bluestein's algorithm (17,9,4) and (3,22,2).
+int
+itkNativeRealFFTTest(int, char *[])
+{
+  using ImageF1 = itk::Image<float, 1>;
+  using ImageCF1 = itk::Image<std::complex<float>, 1>;
+  using ImageF2 = itk::Image<float, 2>;
+  using ImageCF2 = itk::Image<std::complex<float>, 2>;
+  using ImageF3 = itk::Image<float, 3>;
+  using ImageCF3 = itk::Image<std::complex<float>, 3>;
+  using ImageF4 = itk::Image<float, 4>;
+  using ImageCF4 = itk::Image<std::complex<float>, 4>;
+
+  using ImageD1 = itk::Image<double, 1>;
+  using ImageCD1 = itk::Image<std::complex<double>, 1>;
+  using ImageD2 = itk::Image<double, 2>;
+  using ImageCD2 = itk::Image<std::complex<double>, 2>;
+  using ImageD3 = itk::Image<double, 3>;
+  using ImageCD3 = itk::Image<std::complex<double>, 3>;
+
+  auto forwardFilter = itk::NativeRealToHalfHermitianForwardFFTImageFilter<ImageF2>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    forwardFilter, NativeRealToHalfHermitianForwardFFTImageFilter, RealToHalfHermitianForwardFFTImageFilter);
+
+  auto inverseFilter = itk::NativeHalfHermitianToRealInverseFFTImageFilter<ImageCF2>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    inverseFilter, NativeHalfHermitianToRealInverseFFTImageFilter, HalfHermitianToRealInverseFFTImageFilter);
+
+  unsigned int SizeOfDimensions1[] = { 4, 4, 4, 4 };
+  unsigned int SizeOfDimensions2[] = { 3, 5, 4 };
+  unsigned int SizeOfDimensions3[] = { 7, 6, 4 };
+  unsigned int SizeOfDimensions4[] = { 17, 9, 4 };
+  unsigned int SizeOfDimensions5[] = { 3, 22, 2 };
+  int          rval = 0;
+
+  for (unsigned int * sizeOfDimensions :
+       { SizeOfDimensions1, SizeOfDimensions2, SizeOfDimensions3, SizeOfDimensions4, SizeOfDimensions5 })
+  {
+    std::cerr << "Native (" << sizeOfDimensions[0] << ',' << sizeOfDimensions[1] << ',' << sizeOfDimensions[2] << ')'
+              << std::endl;
+    rval += test_fft<float,
+                     1,
+                     itk::NativeRealToHalfHermitianForwardFFTImageFilter<ImageF1>,
+                     itk::NativeHalfHermitianToRealInverseFFTImageFilter<ImageCF1>>(sizeOfDimensions) != 0;
+    rval += test_fft<float,
+                     2,
+                     itk::NativeRealToHalfHermitianForwardFFTImageFilter<ImageF2>,
+                     itk::NativeHalfHermitianToRealInverseFFTImageFilter<ImageCF2>>(sizeOfDimensions) != 0;
+    rval += test_fft<float,
+                     3,
+                     itk::NativeRealToHalfHermitianForwardFFTImageFilter<ImageF3>,
+                     itk::NativeHalfHermitianToRealInverseFFTImageFilter<ImageCF3>>(sizeOfDimensions) != 0;
+    rval += test_fft<double,
+                     1,
+                     itk::NativeRealToHalfHermitianForwardFFTImageFilter<ImageD1>,
+                     itk::NativeHalfHermitianToRealInverseFFTImageFilter<ImageCD1>>(sizeOfDimensions) != 0;
+    rval += test_fft<double,
+                     2,
+                     itk::NativeRealToHalfHermitianForwardFFTImageFilter<ImageD2>,
+                     itk::NativeHalfHermitianToRealInverseFFTImageFilter<ImageCD2>>(sizeOfDimensions) != 0;
+    rval += test_fft<double,
+                     3,
+                     itk::NativeRealToHalfHermitianForwardFFTImageFilter<ImageD3>,
+                     itk::NativeHalfHermitianToRealInverseFFTImageFilter<ImageCD3>>(sizeOfDimensions) != 0;
+  }
+  rval += test_fft<float,
+                   4,
+                   itk::NativeRealToHalfHermitianForwardFFTImageFilter<ImageF4>,
+                   itk::NativeHalfHermitianToRealInverseFFTImageFilter<ImageCF4>>(SizeOfDimensions1) != 0;
+
+  // The native and VNL transforms agree on the sizes supported by VNL.
+  for (unsigned int * sizeOfDimensions : { SizeOfDimensions1, SizeOfDimensions2 })
+  {
+    rval += test_fft_rtc<double,
+                         2,
+                         itk::NativeRealToHalfHermitianForwardFFTImageFilter<ImageD2>,
+                         itk::VnlRealToHalfHermitianForwardFFTImageFilter<ImageD2>>(sizeOfDimensions) != 0;
+    rval += test_fft_rtc<double,
+                         3,
+                         itk::NativeRealToHalfHermitianForwardFFTImageFilter<ImageD3>,
+                         itk::VnlRealToHalfHermitianForwardFFTImageFilter<ImageD3>>(sizeOfDimensions) != 0;
+  }
+
+  if (rval != 0)
+  {
+    std::cerr << "Test failed " << rval << " times." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFastIterativeImageFilterBase_h
+#define itkFastIterativeImageFilterBase_h
+
+#include "itkFastMarchingImageFilterBase.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class FastIterativeImageFilterBase
+ * \brief Solve the Eikonal equation on an image with a parallel, block based
+ * fast iterative method.
+ *
+ * This filter computes the same arrival times as FastMarchingImageFilterBase
+ * and is configured the same way (speed image or speed constant, alive,
+ * trial and forbidden points, output information, stopping criterion), but
+ * it does not process the nodes one at a time from a priority queue.
+ * Instead, the output is split into blocks of BlockSize pixels, and active
+ * blocks are relaxed with Gauss-Seidel sweeps of the upwind update used by
+ * fast marching until their values no longer decrease. Blocks are processed
+ * in parallel in two phases following a checkerboard pattern, so that blocks
+ * updated concurrently never share a face. A block whose boundary values
+ * changed activates its neighbors for the next phase, and the computation
+ * ends when no block is active.
+ *
+ * The relaxation converges to the fixed point of the upwind discretization,
+ * which is the solution computed by fast marching. The ConvergenceTolerance
+ * bounds the error of each node with respect to this fixed point: a node
+ * whose value decreases by less than the tolerance does not trigger further
+ * updates. With the default tolerance of zero, nodes are updated until
+ * their value is exact, and the output matches the one of
+ * FastMarchingImageFilterBase up to floating point rounding. The computed
+ * values are never smaller than the exact ones.
+ *
+ * Once the arrival times are known, the stopping criterion is evaluated on
+ * the nodes sorted by arrival time, as fast marching would visit them.
+ * Nodes after the one satisfying the criterion are reset, except for the
+ * trial band around the accepted nodes, so that the output, the label image,
+ * the processed points and the target reached value match fast marching.
+ * Note that the arrival times are computed on the whole output before the
+ * criterion is evaluated.
+ *
+ * Topology checks are not supported by this filter.
+ *
+ * This implementation is based on
+ * W.-K. Jeong & R.T. Whitaker, "A Fast Iterative Method for Eikonal
+ * Equations", SIAM J. Sci. Comput. 30(5), 2512-2534 (2008).
+ * https://doi.org/10.1137/060670298
+ *
+ * \sa FastMarchingImageFilterBase
+ * \sa FastMarchingStoppingCriterionBase
+ *
+ * \ingroup ITKFastMarching
+ */
+template <typename TInput, typename TOutput>
+class ITK_TEMPLATE_EXPORT FastIterativeImageFilterBase : public FastMarchingImageFilterBase<TInput, TOutput>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FastIterativeImageFilterBase);
+
+  using Self = FastIterativeImageFilterBase;
+  using Superclass = FastMarchingImageFilterBase<TInput, TOutput>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using typename Superclass::Traits;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(FastIterativeImageFilterBase);
+
+  using typename Superclass::OutputImageType;
+  using typename Superclass::OutputPixelType;
+  using typename Superclass::OutputRegionType;
+  using typename Superclass::OutputSizeType;
+  using typename Superclass::NodeType;
+  using typename Superclass::NodePairType;
+  using typename Superclass::LabelImageType;
+  using typename Superclass::InternalNodeStructure;
+  using typename Superclass::InternalNodeStructureArray;
+
+  static constexpr unsigned int ImageDimension = Superclass::ImageDimension;
+
+  /** Set/Get the size of the blocks processed by a work unit. Default is 8
+   * pixels along each dimension. */
+  itkSetMacro(BlockSize, OutputSizeType);
+  itkGetConstReferenceMacro(BlockSize, OutputSizeType);
+
+  /** Set/Get the largest decrease of a node value that does not trigger the
+   * update of its neighbors. Default is 0, which yields the fast marching
+   * solution. */
+  itkSetMacro(ConvergenceTolerance, double);
+  itkGetConstMacro(ConvergenceTolerance, double);
+
+protected:
+  FastIterativeImageFilterBase();
+  ~FastIterativeImageFilterBase() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  GenerateData() override;
+
+  /** Relax the active blocks of the output until convergence. */
+  void
+  SolveByBlocks(OutputImageType * oImage);
+
+  /** Relax a block until its values no longer decrease. Returns a bit mask
+   * of the block faces where values changed: bit 2 * d is the lower face
+   * along dimension d, and bit 2 * d + 1 the upper one. */
+  unsigned int
+  RelaxBlock(OutputImageType * oImage, const OutputRegionType & block) const;
+
+  /** Accept the nodes in increasing arrival time until the stopping
+   * criterion is satisfied, and reset the nodes not reached by the front. */
+  void
+  ApplyStoppingCriterion(OutputImageType * oImage);
+
+private:
+  OutputSizeType m_BlockSize{};
+  double         m_ConvergenceTolerance{ 0.0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkFastIterativeImageFilterBase.hxx"
+#endif
+
+#endif // itkFastIterativeImageFilterBase_h
@@ -0,0 +1,402 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFastIterativeImageFilterBase_hxx
+#define itkFastIterativeImageFilterBase_hxx
+
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TInput, typename TOutput>
+FastIterativeImageFilterBase<TInput, TOutput>::FastIterativeImageFilterBase()
+{
+  m_BlockSize.Fill(8);
+}
+
+template <typename TInput, typename TOutput>
+void
+FastIterativeImageFilterBase<TInput, TOutput>::GenerateData()
+{
+  OutputImageType * output = this->GetOutput();
+
+  if (this->m_TopologyCheck != Superclass::TopologyCheckEnum::Nothing)
+  {
+    itkExceptionMacro("Topology checks are not supported by " << this->GetNameOfClass());
+  }
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    if (m_BlockSize[d] == 0)
+    {
+      itkExceptionMacro("BlockSize must be positive along each dimension, got " << m_BlockSize);
+    }
+  }
+
+  this->Initialize(output);
+
+  // The trial points are already labeled in the label image: the heap filled
+  // by InitializeOutput() is not used.
+  while (!this->m_Heap.empty())
+  {
+    this->m_Heap.pop();
+  }
+
+  this->m_StoppingCriterion->Reinitialize();
+
+  this->SolveByBlocks(output);
+
+  this->ApplyStoppingCriterion(output);
+}
+
+template <typename TInput, typename TOutput>
+void
+FastIterativeImageFilterBase<TInput, TOutput>::SolveByBlocks(OutputImageType * oImage)
+{
+  const OutputRegionType & region = this->m_BufferedRegion;
+
+  OutputSizeType gridSize;
+  SizeValueType  numberOfBlocks = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    gridSize[d] = (region.GetSize(d) + m_BlockSize[d] - 1) / m_BlockSize[d];
+    numberOfBlocks *= gridSize[d];
+  }
+
+  const auto blockCoordinates = [&gridSize](SizeValueType id) {
+    OutputSizeType coordinates;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      coordinates[d] = id % gridSize[d];
+      id /= gridSize[d];
+    }
+    return coordinates;
+  };
+  const auto blockId = [&gridSize](const OutputSizeType & coordinates) {
+    SizeValueType id = 0;
+    for (unsigned int d = ImageDimension; d > 0; --d)
+    {
+      id = id * gridSize[d - 1] + coordinates[d - 1];
+    }
+    return id;
+  };
+  const auto blockRegion = [&](SizeValueType id) {
+    const OutputSizeType coordinates = blockCoordinates(id);
+    OutputRegionType     block;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const SizeValueType start = coordinates[d] * m_BlockSize[d];
+      block.SetIndex(d, region.GetIndex(d) + static_cast<IndexValueType>(start));
+      block.SetSize(d, std::min(m_BlockSize[d], region.GetSize(d) - start));
+    }
+    return block;
+  };
+
+  std::vector<unsigned char> active(numberOfBlocks, 0);
+  std::vector<unsigned int>  changedFaces(numberOfBlocks, 0);
+
+  // Activate the blocks across the given faces of a block.
+  const auto activateNeighbors = [&](SizeValueType id, unsigned int faces) {
+    const OutputSizeType coordinates = blockCoordinates(id);
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      OutputSizeType neighbor = coordinates;
+      if ((faces & (1u << (2 * d))) && coordinates[d] > 0)
+      {
+        --neighbor[d];
+        active[blockId(neighbor)] = 1;
+        neighbor[d] = coordinates[d];
+      }
+      if ((faces & (1u << (2 * d + 1))) && coordinates[d] + 1 < gridSize[d])
+      {
+        ++neighbor[d];
+        active[blockId(neighbor)] = 1;
+      }
+    }
+  };
+
+  // The front starts from the blocks holding the alive and trial points.
+  constexpr unsigned int allFaces = (1u << (2 * ImageDimension)) - 1;
+  for (ImageRegionConstIteratorWithIndex<LabelImageType> it(this->m_LabelImage, region); !it.IsAtEnd(); ++it)
+  {
+    const unsigned char label = it.Get();
+    if (label == Traits::Alive || label == Traits::InitialTrial)
+    {
+      OutputSizeType coordinates;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        coordinates[d] = static_cast<SizeValueType>(it.GetIndex()[d] - region.GetIndex(d)) / m_BlockSize[d];
+      }
+      const SizeValueType id = blockId(coordinates);
+      if (!active[id])
+      {
+        active[id] = 1;
+        activateNeighbors(id, allFaces);
+      }
+    }
+  }
+
+  MultiThreaderBase * const  multiThreader = this->GetMultiThreader();
+  std::vector<SizeValueType> phaseBlocks;
+
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  bool anyActive = std::find(active.cbegin(), active.cend(), 1) != active.cend();
+  while (anyActive)
+  {
+    // Blocks of the same parity never share a face, so that the pixels read
+    // by a block are not modified while it is being relaxed.
+    for (unsigned int parity = 0; parity < 2; ++parity)
+    {
+      phaseBlocks.clear();
+      for (SizeValueType id = 0; id < numberOfBlocks; ++id)
+      {
+        if (active[id])
+        {
+          const OutputSizeType coordinates = blockCoordinates(id);
+          SizeValueType        sum = 0;
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            sum += coordinates[d];
+          }
+          if (sum % 2 == parity)
+          {
+            phaseBlocks.push_back(id);
+          }
+        }
+      }
+
+      multiThreader->ParallelizeArray(
+        0,
+        phaseBlocks.size(),
+        [&](SizeValueType i) {
+          const SizeValueType id = phaseBlocks[i];
+          changedFaces[id] = this->RelaxBlock(oImage, blockRegion(id));
+        },
+        nullptr);
+
+      for (const SizeValueType id : phaseBlocks)
+      {
+        active[id] = 0;
+      }
+      for (const SizeValueType id : phaseBlocks)
+      {
+        activateNeighbors(id, changedFaces[id]);
+      }
+    }
+
+    anyActive = std::find(active.cbegin(), active.cend(), 1) != active.cend();
+  }
+}
+
+template <typename TInput, typename TOutput>
+unsigned int
+FastIterativeImageFilterBase<TInput, TOutput>::RelaxBlock(OutputImageType * oImage, const OutputRegionType & block) const
+{
+  using IteratorType = ImageRegionConstIteratorWithIndex<OutputImageType>;
+
+  OutputPixelType * const       values = oImage->GetBufferPointer();
+  const unsigned char * const   labels = this->m_LabelImage->GetBufferPointer();
+  const OffsetValueType * const offsetTable = oImage->GetOffsetTable();
+
+  const NodeType blockStart = block.GetIndex();
+  const NodeType blockLast = block.GetUpperIndex();
+
+  unsigned int changedFaces = 0;
+
+  const auto relaxNode = [&](const NodeType & node) {
+    const OffsetValueType offset = oImage->ComputeOffset(node);
+    const unsigned char   label = labels[offset];
+    if (label == Traits::Alive || label == Traits::InitialTrial || label == Traits::Forbidden)
+    {
+      return false;
+    }
+
+    // Smallest neighbor value along each dimension, as fast marching would
+    // use once all the upwind neighbors are alive.
+    InternalNodeStructureArray neighbors;
+    bool                       reached = false;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      InternalNodeStructure & neighbor = neighbors[d];
+      neighbor.m_Node = node;
+      neighbor.m_Value = this->m_LargeValue;
+      neighbor.m_Axis = d;
+
+      if (node[d] > this->m_StartIndex[d])
+      {
+        const OffsetValueType neighborOffset = offset - offsetTable[d];
+        if (labels[neighborOffset] != Traits::Forbidden && values[neighborOffset] < neighbor.m_Value)
+        {
+          neighbor.m_Value = values[neighborOffset];
+          --neighbor.m_Node[d];
+        }
+      }
+      if (node[d] < this->m_LastIndex[d])
+      {
+        const OffsetValueType neighborOffset = offset + offsetTable[d];
+        if (labels[neighborOffset] != Traits::Forbidden && values[neighborOffset] < neighbor.m_Value)
+        {
+          neighbor.m_Value = values[neighborOffset];
+          neighbor.m_Node[d] = node[d] + 1;
+        }
+      }
+      reached = reached || neighbor.m_Value < this->m_LargeValue;
+    }
+    if (!reached)
+    {
+      return false;
+    }
+
+    const auto            solution = static_cast<OutputPixelType>(this->Solve(oImage, node, neighbors));
+    const OutputPixelType previous = values[offset];
+    if (!(solution < previous))
+    {
+      return false;
+    }
+    values[offset] = solution;
+
+    if (static_cast<double>(previous) - static_cast<double>(solution) <= m_ConvergenceTolerance)
+    {
+      return false;
+    }
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if (node[d] == blockStart[d])
+      {
+        changedFaces |= 1u << (2 * d);
+      }
+      if (node[d] == blockLast[d])
+      {
+        changedFaces |= 1u << (2 * d + 1);
+      }
+    }
+    return true;
+  };
+
+  // Alternate forward and backward sweeps until no value changes.
+  IteratorType it(oImage, block);
+  bool         changed = true;
+  bool         forward = true;
+  while (changed)
+  {
+    changed = false;
+    if (forward)
+    {
+      for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+      {
+        changed = relaxNode(it.GetIndex()) || changed;
+      }
+    }
+    else
+    {
+      for (it.GoToReverseBegin(); !it.IsAtReverseEnd(); --it)
+      {
+        changed = relaxNode(it.GetIndex()) || changed;
+      }
+    }
+    forward = !forward;
+  }
+
+  return changedFaces;
+}
+
+template <typename TInput, typename TOutput>
+void
+FastIterativeImageFilterBase<TInput, TOutput>::ApplyStoppingCriterion(OutputImageType * oImage)
+{
+  // Nodes reached by the front, in the order fast marching accepts them.
+  std::vector<NodePairType> reached;
+  for (ImageRegionConstIteratorWithIndex<LabelImageType> it(this->m_LabelImage, this->m_BufferedRegion); !it.IsAtEnd();
+       ++it)
+  {
+    const unsigned char label = it.Get();
+    if (label == Traits::Alive || label == Traits::Forbidden)
+    {
+      continue;
+    }
+    const OutputPixelType value = this->GetOutputValue(oImage, it.GetIndex());
+    if (label == Traits::InitialTrial || value < this->m_LargeValue)
+    {
+      reached.emplace_back(it.GetIndex(), value);
+    }
+  }
+  std::sort(reached.begin(), reached.end());
+
+  ProgressReporter progress(this, 0, reached.size());
+
+  OutputPixelType currentValue{};
+
+  auto stop = reached.cbegin();
+  for (; stop != reached.cend(); ++stop)
+  {
+    currentValue = stop->GetValue();
+
+    this->m_StoppingCriterion->SetCurrentNodePair(*stop);
+    if (this->m_StoppingCriterion->IsSatisfied())
+    {
+      break;
+    }
+
+    if (this->m_CollectPoints)
+    {
+      this->m_ProcessedPoints->push_back(*stop);
+    }
+    this->SetLabelValueForGivenNode(stop->GetNode(), Traits::Alive);
+    progress.CompletedPixel();
+  }
+
+  this->m_TargetReachedValue = currentValue;
+
+  // The remaining nodes have not been accepted: only those next to an
+  // accepted node keep a trial value computed from their alive neighbors.
+  for (auto it = stop; it != reached.cend(); ++it)
+  {
+    if (this->GetLabelValueForGivenNode(it->GetNode()) != Traits::InitialTrial)
+    {
+      this->SetOutputValue(oImage, it->GetNode(), this->m_LargeValue);
+    }
+  }
+  for (auto it = stop; it != reached.cend(); ++it)
+  {
+    if (this->GetLabelValueForGivenNode(it->GetNode()) != Traits::InitialTrial)
+    {
+      this->UpdateValue(oImage, it->GetNode());
+    }
+  }
+
+  while (!this->m_Heap.empty())
+  {
+    this->m_Heap.pop();
+  }
+}
+
+template <typename TInput, typename TOutput>
+void
+FastIterativeImageFilterBase<TInput, TOutput>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BlockSize: " << m_BlockSize << std::endl;
+  os << indent << "ConvergenceTolerance: " << m_ConvergenceTolerance << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkFastIterativeImageFilterBase_hxx
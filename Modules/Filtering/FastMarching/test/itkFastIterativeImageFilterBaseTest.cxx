@@ -0,0 +1,244 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFastIterativeImageFilterBase.h"
+#include "itkFastMarchingImageFilterBase.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+template <unsigned int VDimension>
+class FastIterativeTestHelper
+{
+public:
+  using ImageType = itk::Image<float, VDimension>;
+  using CriterionType = itk::FastMarchingThresholdStoppingCriterion<ImageType, ImageType>;
+  using FastMarchingType = itk::FastMarchingImageFilterBase<ImageType, ImageType>;
+  using FastIterativeType = itk::FastIterativeImageFilterBase<ImageType, ImageType>;
+  using NodePairType = typename FastMarchingType::NodePairType;
+  using NodePairContainerType = typename FastMarchingType::NodePairContainerType;
+  using IndexType = typename ImageType::IndexType;
+  using SizeType = typename ImageType::SizeType;
+
+  explicit FastIterativeTestHelper(unsigned int size)
+    : m_Speed(ImageType::New())
+    , m_Alive(NodePairContainerType::New())
+    , m_Trial(NodePairContainerType::New())
+    , m_Forbidden(NodePairContainerType::New())
+  {
+    m_Speed->SetRegions(SizeType::Filled(size));
+    m_Speed->Allocate();
+
+    // A smoothly varying speed, slow in a slab in the middle of the image.
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(m_Speed, m_Speed->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      const IndexType & index = it.GetIndex();
+      double            speed = 1.0 + 0.5 * std::sin(0.3 * index[0]) * std::cos(0.2 * index[1]);
+      if (index[0] == static_cast<itk::IndexValueType>(size / 2) && index[1] > 2)
+      {
+        speed = 0.1;
+      }
+      it.Set(static_cast<float>(speed));
+    }
+
+    auto source = IndexType::Filled(size / 4);
+    m_Alive->push_back(NodePairType(source, 0.0));
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      for (const int s : { -1, 1 })
+      {
+        IndexType trial = source;
+        trial[d] += s;
+        m_Trial->push_back(NodePairType(trial, 1.0));
+      }
+    }
+
+    // A second front starting from a corner of the image.
+    m_Trial->push_back(NodePairType(IndexType::Filled(size - 2), 0.5));
+
+    // A wall the front has to go around.
+    for (unsigned int i = 0; i < size / 2; ++i)
+    {
+      auto forbidden = IndexType::Filled(size / 2 + 2);
+      forbidden[0] = i;
+      m_Forbidden->push_back(NodePairType(forbidden, 0.0));
+    }
+  }
+
+  template <typename TFilter>
+  typename TFilter::Pointer
+  Run(float threshold) const
+  {
+    auto criterion = CriterionType::New();
+    criterion->SetThreshold(threshold);
+
+    auto filter = TFilter::New();
+    filter->SetInput(m_Speed);
+    filter->SetAlivePoints(m_Alive);
+    filter->SetTrialPoints(m_Trial);
+    filter->SetForbiddenPoints(m_Forbidden);
+    filter->SetStoppingCriterion(criterion);
+    filter->CollectPointsOn();
+    return filter;
+  }
+
+  // Compare the output of the fast iterative method with fast marching.
+  bool
+  Compare(float threshold, const typename FastIterativeType::OutputSizeType & blockSize) const
+  {
+    auto marcher = Run<FastMarchingType>(threshold);
+    marcher->Update();
+
+    auto iterative = Run<FastIterativeType>(threshold);
+    iterative->SetBlockSize(blockSize);
+    iterative->Update();
+
+    bool passed = true;
+
+    const ImageType * const expected = marcher->GetOutput();
+    const ImageType * const output = iterative->GetOutput();
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      const float value = output->GetPixel(it.GetIndex());
+      const float tolerance = 1e-4f * std::max(1.0f, std::abs(it.Get()));
+      if (!(std::abs(value - it.Get()) <= tolerance) && !itk::Math::ExactlyEquals(value, it.Get()))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error at index " << it.GetIndex() << " with threshold " << threshold << " and block size "
+                  << blockSize << std::endl;
+        std::cerr << "Expected value " << it.Get() << ", but got " << value << std::endl;
+        passed = false;
+        break;
+      }
+      if (marcher->GetLabelImage()->GetPixel(it.GetIndex()) != iterative->GetLabelImage()->GetPixel(it.GetIndex()))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Label mismatch at index " << it.GetIndex() << " with threshold " << threshold << std::endl;
+        passed = false;
+        break;
+      }
+    }
+
+    if (marcher->GetProcessedPoints()->size() != iterative->GetProcessedPoints()->size())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Expected " << marcher->GetProcessedPoints()->size() << " processed points, but got "
+                << iterative->GetProcessedPoints()->size() << std::endl;
+      passed = false;
+    }
+    if (std::abs(marcher->GetTargetReachedValue() - iterative->GetTargetReachedValue()) > 1e-4f * threshold)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Expected target reached value " << marcher->GetTargetReachedValue() << ", but got "
+                << iterative->GetTargetReachedValue() << std::endl;
+      passed = false;
+    }
+    return passed;
+  }
+
+  // With a positive tolerance, values stay upper bounds of the exact ones.
+  bool
+  CompareWithTolerance(double tolerance) const
+  {
+    constexpr float threshold = 1e6f;
+
+    auto marcher = Run<FastMarchingType>(threshold);
+    marcher->Update();
+
+    auto iterative = Run<FastIterativeType>(threshold);
+    iterative->SetConvergenceTolerance(tolerance);
+    iterative->Update();
+
+    const ImageType * const expected = marcher->GetOutput();
+    const ImageType * const output = iterative->GetOutput();
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      const float value = output->GetPixel(it.GetIndex());
+      if (value < it.Get() - 1e-4f * std::max(1.0f, it.Get()))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Value " << value << " at index " << it.GetIndex() << " is below the exact value " << it.Get()
+                  << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  typename ImageType::Pointer             m_Speed;
+  typename NodePairContainerType::Pointer m_Alive;
+  typename NodePairContainerType::Pointer m_Trial;
+  typename NodePairContainerType::Pointer m_Forbidden;
+};
+} // namespace
+
+int
+itkFastIterativeImageFilterBaseTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::FastIterativeImageFilterBase<ImageType, ImageType>;
+
+  auto filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, FastIterativeImageFilterBase, FastMarchingImageFilterBase);
+
+  auto blockSize = FilterType::OutputSizeType::Filled(16);
+  filter->SetBlockSize(blockSize);
+  ITK_TEST_SET_GET_VALUE(blockSize, filter->GetBlockSize());
+
+  double convergenceTolerance = 0.5;
+  filter->SetConvergenceTolerance(convergenceTolerance);
+  ITK_TEST_SET_GET_VALUE(convergenceTolerance, filter->GetConvergenceTolerance());
+
+  bool passed = true;
+
+  const FastIterativeTestHelper<2> helper2D(64);
+  for (const float threshold : { 1e6f, 20.0f, 45.0f })
+  {
+    for (const unsigned int size : { 1u, 5u, 8u, 64u })
+    {
+      passed = helper2D.Compare(threshold, FilterType::OutputSizeType::Filled(size)) && passed;
+    }
+  }
+  passed = helper2D.CompareWithTolerance(0.5) && passed;
+
+  const FastIterativeTestHelper<3> helper3D(20);
+  for (const float threshold : { 1e6f, 12.0f })
+  {
+    passed = helper3D.Compare(threshold, itk::Size<3>{ { 8, 4, 6 } }) && passed;
+  }
+  passed = helper3D.CompareWithTolerance(0.5) && passed;
+
+  // Topology checks are not supported.
+  auto topology = FastIterativeTestHelper<2>(16).Run<FastIterativeTestHelper<2>::FastIterativeType>(1e6f);
+  topology->SetTopologyCheck(itk::FastMarchingTraitsEnums::TopologyCheck::Strict);
+  ITK_TRY_EXPECT_EXCEPTION(topology->Update());
+
+  if (!passed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -165,6 +165,132 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataArray(RealTy
   }
 }
 
+/**
+ * Apply Recursive Filter to a panel of interleaved lines
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataPanel(RealType * const       outs,
+                                                                          const RealType * const data,
+                                                                          RealType * const       scratch,
+                                                                          const SizeValueType    ln) const
+{
+  constexpr unsigned int W = PanelWidth;
+
+  RealType * const scratch1 = outs;
+  RealType * const scratch2 = scratch;
+
+  /**
+   * Causal direction pass
+   */
+  for (unsigned int b = 0; b < W; ++b)
+  {
+    // this value is assumed to exist from the border to infinity.
+    const RealType & outV1 = data[b];
+
+    MathEMAMAMAM(scratch1[b], outV1, m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(scratch1[W + b], data[W + b], m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(scratch1[2 * W + b], data[2 * W + b], m_N0, data[W + b], m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(
+      scratch1[3 * W + b], data[3 * W + b], m_N0, data[2 * W + b], m_N1, data[W + b], m_N2, outV1, m_N3);
+
+    MathSMAMAMAM(scratch1[b], outV1, m_BN1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(scratch1[W + b], scratch1[b], m_D1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(scratch1[2 * W + b], scratch1[W + b], m_D1, scratch1[b], m_D2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(
+      scratch1[3 * W + b], scratch1[2 * W + b], m_D1, scratch1[W + b], m_D2, scratch1[b], m_D3, outV1, m_BN4);
+  }
+
+  for (SizeValueType i = 4; i < ln; ++i)
+  {
+    RealType * const       s0 = scratch1 + i * W;
+    const RealType * const s1 = s0 - W;
+    const RealType * const s2 = s1 - W;
+    const RealType * const s3 = s2 - W;
+    const RealType * const s4 = s3 - W;
+    const RealType * const d0 = data + i * W;
+    const RealType * const d1 = d0 - W;
+    const RealType * const d2 = d1 - W;
+    const RealType * const d3 = d2 - W;
+    for (unsigned int b = 0; b < W; ++b)
+    {
+      MathEMAMAMAM(s0[b], d0[b], m_N0, d1[b], m_N1, d2[b], m_N2, d3[b], m_N3);
+      MathSMAMAMAM(s0[b], s1[b], m_D1, s2[b], m_D2, s3[b], m_D3, s4[b], m_D4);
+    }
+  }
+
+  /**
+   * AntiCausal direction pass
+   */
+  const SizeValueType last = (ln - 1) * W;
+  for (unsigned int b = 0; b < W; ++b)
+  {
+    // this value is assumed to exist from the border to infinity.
+    const RealType & outV2 = data[last + b];
+
+    MathEMAMAMAM(scratch2[last + b], outV2, m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(scratch2[last - W + b], data[last + b], m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(
+      scratch2[last - 2 * W + b], data[last - W + b], m_M1, data[last + b], m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(scratch2[last - 3 * W + b],
+                 data[last - 2 * W + b],
+                 m_M1,
+                 data[last - W + b],
+                 m_M2,
+                 data[last + b],
+                 m_M3,
+                 outV2,
+                 m_M4);
+
+    MathSMAMAMAM(scratch2[last + b], outV2, m_BM1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(scratch2[last - W + b], scratch2[last + b], m_D1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(scratch2[last - 2 * W + b],
+                 scratch2[last - W + b],
+                 m_D1,
+                 scratch2[last + b],
+                 m_D2,
+                 outV2,
+                 m_BM3,
+                 outV2,
+                 m_BM4);
+    MathSMAMAMAM(scratch2[last - 3 * W + b],
+                 scratch2[last - 2 * W + b],
+                 m_D1,
+                 scratch2[last - W + b],
+                 m_D2,
+                 scratch2[last + b],
+                 m_D3,
+                 outV2,
+                 m_BM4);
+  }
+
+  for (SizeValueType i = ln - 4; i > 0; --i)
+  {
+    RealType * const       s0 = scratch2 + (i - 1) * W;
+    const RealType * const s1 = s0 + W;
+    const RealType * const s2 = s1 + W;
+    const RealType * const s3 = s2 + W;
+    const RealType * const s4 = s3 + W;
+    const RealType * const d1 = data + i * W;
+    const RealType * const d2 = d1 + W;
+    const RealType * const d3 = d2 + W;
+    const RealType * const d4 = d3 + W;
+    for (unsigned int b = 0; b < W; ++b)
+    {
+      MathEMAMAMAM(s0[b], d1[b], m_M1, d2[b], m_M2, d3[b], m_M3, d4[b], m_M4);
+      MathSMAMAMAM(s0[b], s1[b], m_D1, s2[b], m_D2, s3[b], m_D3, s4[b], m_D4);
+    }
+  }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  for (SizeValueType i = 0; i < ln * W; ++i)
+  {
+    outs[i] += scratch2[i];
+  }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -261,6 +387,15 @@ void
 RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  if constexpr (PanelFilteringSupported)
+  {
+    if (this->m_Direction != 0 && outputRegionForThread.GetSize(0) >= PanelWidth)
+    {
+      this->GenerateDataByPanels(outputRegionForThread);
+      return;
+    }
+  }
+
   using OutputPixelType = typename TOutputImage::PixelType;
 
   using InputConstIteratorType = ImageLinearConstIteratorWithIndex<TInputImage>;
@@ -311,6 +446,91 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
   }
 }
 
+/**
+ * Compute Recursive filter
+ * by panels of lines adjacent along dimension 0
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::GenerateDataByPanels(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  if constexpr (PanelFilteringSupported)
+  {
+    using OutputPixelType = typename TOutputImage::PixelType;
+    using RowIteratorType = ImageLinearConstIteratorWithIndex<TOutputImage>;
+
+    const TInputImage * const inputImage = this->GetInputImage();
+    TOutputImage * const      outputImage = this->GetOutput();
+
+    const SizeValueType   ln = outputRegionForThread.GetSize(this->m_Direction);
+    const SizeValueType   width = outputRegionForThread.GetSize(0);
+    const OffsetValueType inputStride = inputImage->GetOffsetTable()[this->m_Direction];
+    const OffsetValueType outputStride = outputImage->GetOffsetTable()[this->m_Direction];
+
+    const auto inps = make_unique_for_overwrite<RealType[]>(ln * PanelWidth);
+    const auto outs = make_unique_for_overwrite<RealType[]>(ln * PanelWidth);
+    const auto scratch = make_unique_for_overwrite<RealType[]>(ln * PanelWidth);
+
+    // Visit the first pixel of every line along dimension 0 in the first
+    // slice of the region orthogonal to the filtering direction.
+    OutputImageRegionType rowRegion = outputRegionForThread;
+    rowRegion.SetSize(this->m_Direction, 1);
+
+    RowIteratorType rowIterator(outputImage, rowRegion);
+    rowIterator.SetDirection(0);
+
+    for (rowIterator.GoToBegin(); !rowIterator.IsAtEnd(); rowIterator.NextLine())
+    {
+      const auto &                 rowIndex = rowIterator.GetIndex();
+      const InputPixelType * const inputRow = inputImage->GetBufferPointer() + inputImage->ComputeOffset(rowIndex);
+      OutputPixelType * const      outputRow = outputImage->GetBufferPointer() + outputImage->ComputeOffset(rowIndex);
+
+      SizeValueType x = 0;
+      for (; x + PanelWidth <= width; x += PanelWidth)
+      {
+        for (SizeValueType i = 0; i < ln; ++i)
+        {
+          const InputPixelType * const in = inputRow + static_cast<OffsetValueType>(i) * inputStride + x;
+          RealType * const             panel = inps.get() + i * PanelWidth;
+          for (unsigned int b = 0; b < PanelWidth; ++b)
+          {
+            panel[b] = static_cast<RealType>(in[b]);
+          }
+        }
+
+        this->FilterDataPanel(outs.get(), inps.get(), scratch.get(), ln);
+
+        for (SizeValueType i = 0; i < ln; ++i)
+        {
+          OutputPixelType * const out = outputRow + static_cast<OffsetValueType>(i) * outputStride + x;
+          const RealType * const  panel = outs.get() + i * PanelWidth;
+          for (unsigned int b = 0; b < PanelWidth; ++b)
+          {
+            out[b] = static_cast<OutputPixelType>(panel[b]);
+          }
+        }
+      }
+
+      // Remaining lines of the row are filtered one at a time.
+      for (; x < width; ++x)
+      {
+        for (SizeValueType i = 0; i < ln; ++i)
+        {
+          inps[i] = static_cast<RealType>(inputRow[static_cast<OffsetValueType>(i) * inputStride + x]);
+        }
+
+        this->FilterDataArray(outs.get(), inps.get(), scratch.get(), ln);
+
+        for (SizeValueType i = 0; i < ln; ++i)
+        {
+          outputRow[static_cast<OffsetValueType>(i) * outputStride + x] = static_cast<OutputPixelType>(outs[i]);
+        }
+      }
+    }
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 RecursiveSeparableImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
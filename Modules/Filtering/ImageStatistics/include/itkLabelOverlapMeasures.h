@@ -0,0 +1,154 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelOverlapMeasures_h
+#define itkLabelOverlapMeasures_h
+
+#include "itkNumericTraits.h"
+#include <unordered_map>
+
+namespace itk
+{
+
+/** \class LabelOverlapMeasures
+ * \brief Computes the overlap measures of the labels of a source and a
+ * target label image from the numbers of pixels of each label.
+ *
+ * The pixels are counted by LabelOverlapMeasuresImageFilter from the
+ * pixels of label images, and by LabelOverlapMeasuresLabelMapFilter from
+ * the lines of the label objects of LabelMaps; both compute their
+ * measures through this class. The measures over all labels exclude the
+ * background label.
+ *
+ * The measures refer to the counts of pixels they are constructed from,
+ * which must outlive them.
+ *
+ * \sa LabelOverlapMeasuresImageFilter, LabelOverlapMeasuresLabelMapFilter
+ *
+ * \ingroup ITKImageStatistics
+ */
+template <typename TLabel>
+class ITK_TEMPLATE_EXPORT LabelOverlapMeasures
+{
+public:
+  using LabelType = TLabel;
+
+  /** Type to use for computations. */
+  using RealType = typename NumericTraits<LabelType>::RealType;
+
+  /** \class LabelSetMeasures
+   * \brief Metrics stored per label
+   * \ingroup ITKImageStatistics
+   */
+  class LabelSetMeasures
+  {
+  public:
+    // default constructor/copy/move etc...
+
+    SizeValueType m_Source{ 0 };
+    SizeValueType m_Target{ 0 };
+    SizeValueType m_Union{ 0 };
+    SizeValueType m_Intersection{ 0 };
+    SizeValueType m_SourceComplement{ 0 };
+    SizeValueType m_TargetComplement{ 0 };
+  };
+
+  /** Type of the map used to store data per label */
+  using MapType = std::unordered_map<LabelType, LabelSetMeasures>;
+
+  /** The measures of the labels of images of the given number of pixels. */
+  LabelOverlapMeasures(const MapType & labelSetMeasures, LabelType backgroundValue, SizeValueType numberOfPixels);
+
+  // Overlap agreement metrics
+
+  /** Get the total overlap over all labels. */
+  RealType
+  GetTotalOverlap() const;
+
+  /** Get the target overlap for the specified individual label. */
+  RealType GetTargetOverlap(LabelType) const;
+
+  /** Get the union overlap (Jaccard coefficient) over all labels. */
+  RealType
+  GetUnionOverlap() const;
+
+  /** Get the union overlap (Jaccard coefficient) for the specified individual
+   * label. */
+  RealType GetUnionOverlap(LabelType) const;
+
+  /** Get the mean overlap (Dice coefficient) over all labels. */
+  RealType
+  GetMeanOverlap() const;
+
+  /** Get the mean overlap (Dice coefficient) for the specified individual
+   * label. */
+  RealType GetMeanOverlap(LabelType) const;
+
+  /** Get the volume similarity over all labels. */
+  RealType
+  GetVolumeSimilarity() const;
+
+  /** Get the volume similarity for the specified individual label. */
+  RealType GetVolumeSimilarity(LabelType) const;
+
+  // Overlap error metrics
+
+  /** Get the false negative error over all labels. */
+  RealType
+  GetFalseNegativeError() const;
+
+  /** Get the false negative error for the specified individual label. */
+  RealType GetFalseNegativeError(LabelType) const;
+
+  /** Get the false positive error over all labels. */
+  RealType
+  GetFalsePositiveError() const;
+
+  /** Get the false positive error for the specified individual label. */
+  RealType GetFalsePositiveError(LabelType) const;
+
+  /** Get the false discovery rate over all labels. */
+  RealType
+  GetFalseDiscoveryRate() const;
+
+  /** Get the false discovery rate for the specified individual label. */
+  RealType GetFalseDiscoveryRate(LabelType) const;
+
+private:
+  /** Type to use for printing label values (e.g. in warnings). */
+  using PrintType = typename NumericTraits<LabelType>::PrintType;
+
+  /** Find the measures of a label, warning if the label is not found. */
+  const LabelSetMeasures *
+  FindLabelSetMeasures(LabelType label) const;
+
+  /** The ratio of two counts of pixels, or the largest real when there are no pixels. */
+  static RealType
+  GetRatio(RealType numerator, RealType denominator);
+
+  const MapType &     m_LabelSetMeasures;
+  const LabelType     m_BackgroundValue;
+  const SizeValueType m_NumberOfPixels;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkLabelOverlapMeasures.hxx"
+#endif
+
+#endif
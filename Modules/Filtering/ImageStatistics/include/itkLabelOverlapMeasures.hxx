@@ -0,0 +1,282 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelOverlapMeasures_hxx
+#define itkLabelOverlapMeasures_hxx
+
+#include "itkMath.h"
+#include "itkObject.h"
+#include "itkOutputWindow.h"
+#include <sstream>
+
+namespace itk
+{
+
+template <typename TLabel>
+LabelOverlapMeasures<TLabel>::LabelOverlapMeasures(const MapType & labelSetMeasures,
+                                                   LabelType       backgroundValue,
+                                                   SizeValueType   numberOfPixels)
+  : m_LabelSetMeasures(labelSetMeasures)
+  , m_BackgroundValue(backgroundValue)
+  , m_NumberOfPixels(numberOfPixels)
+{}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetRatio(RealType numerator, RealType denominator) -> RealType
+{
+  if (Math::ExactlyEquals(denominator, 0.0))
+  {
+    return NumericTraits<RealType>::max();
+  }
+  return numerator / denominator;
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::FindLabelSetMeasures(LabelType label) const -> const LabelSetMeasures *
+{
+  auto mapIt = this->m_LabelSetMeasures.find(label);
+  if (mapIt == this->m_LabelSetMeasures.end())
+  {
+    if (Object::GetGlobalWarningDisplay())
+    {
+      std::ostringstream message;
+      message << "WARNING: In " __FILE__ ", line " << __LINE__ << '\n'
+              << "Label " << static_cast<PrintType>(label) << " not found.\n\n";
+      OutputWindowDisplayWarningText(message.str().c_str());
+    }
+    return nullptr;
+  }
+  return &mapIt->second;
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetTotalOverlap() const -> RealType
+{
+  RealType numerator = 0.0;
+  RealType denominator = 0.0;
+  for (const auto & labelSetMeasures : this->m_LabelSetMeasures)
+  {
+    // Do not include the background in the final value.
+    if (labelSetMeasures.first == this->m_BackgroundValue)
+    {
+      continue;
+    }
+    numerator += static_cast<RealType>(labelSetMeasures.second.m_Intersection);
+    denominator += static_cast<RealType>(labelSetMeasures.second.m_Target);
+  }
+  return GetRatio(numerator, denominator);
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetTargetOverlap(LabelType label) const -> RealType
+{
+  const LabelSetMeasures * measures = this->FindLabelSetMeasures(label);
+  if (measures == nullptr)
+  {
+    return 0.0;
+  }
+  return GetRatio(static_cast<RealType>(measures->m_Intersection), static_cast<RealType>(measures->m_Target));
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetUnionOverlap() const -> RealType
+{
+  RealType numerator = 0.0;
+  RealType denominator = 0.0;
+  for (const auto & labelSetMeasures : this->m_LabelSetMeasures)
+  {
+    // Do not include the background in the final value.
+    if (labelSetMeasures.first == this->m_BackgroundValue)
+    {
+      continue;
+    }
+    numerator += static_cast<RealType>(labelSetMeasures.second.m_Intersection);
+    denominator += static_cast<RealType>(labelSetMeasures.second.m_Union);
+  }
+  return GetRatio(numerator, denominator);
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetUnionOverlap(LabelType label) const -> RealType
+{
+  const LabelSetMeasures * measures = this->FindLabelSetMeasures(label);
+  if (measures == nullptr)
+  {
+    return 0.0;
+  }
+  return GetRatio(static_cast<RealType>(measures->m_Intersection), static_cast<RealType>(measures->m_Union));
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetMeanOverlap() const -> RealType
+{
+  const RealType uo = this->GetUnionOverlap();
+  return (2.0 * uo / (1.0 + uo));
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetMeanOverlap(LabelType label) const -> RealType
+{
+  const RealType uo = this->GetUnionOverlap(label);
+  return (2.0 * uo / (1.0 + uo));
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetVolumeSimilarity() const -> RealType
+{
+  RealType numerator = 0.0;
+  RealType denominator = 0.0;
+  for (const auto & labelSetMeasures : this->m_LabelSetMeasures)
+  {
+    // Do not include the background in the final value.
+    if (labelSetMeasures.first == this->m_BackgroundValue)
+    {
+      continue;
+    }
+    numerator += static_cast<RealType>(labelSetMeasures.second.m_Source) -
+                 static_cast<RealType>(labelSetMeasures.second.m_Target);
+    denominator += static_cast<RealType>(labelSetMeasures.second.m_Source) +
+                   static_cast<RealType>(labelSetMeasures.second.m_Target);
+  }
+  return GetRatio(2.0 * numerator, denominator);
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetVolumeSimilarity(LabelType label) const -> RealType
+{
+  const LabelSetMeasures * measures = this->FindLabelSetMeasures(label);
+  if (measures == nullptr)
+  {
+    return 0.0;
+  }
+  return 2.0 * (static_cast<RealType>(measures->m_Source) - static_cast<RealType>(measures->m_Target)) /
+         (static_cast<RealType>(measures->m_Source) + static_cast<RealType>(measures->m_Target));
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetFalseNegativeError() const -> RealType
+{
+  RealType numerator = 0.0;
+  RealType denominator = 0.0;
+  for (const auto & labelSetMeasures : this->m_LabelSetMeasures)
+  {
+    // Do not include the background in the final value.
+    if (labelSetMeasures.first == this->m_BackgroundValue)
+    {
+      continue;
+    }
+    numerator += static_cast<RealType>(labelSetMeasures.second.m_TargetComplement);
+    denominator += static_cast<RealType>(labelSetMeasures.second.m_Target);
+  }
+  return GetRatio(numerator, denominator);
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetFalseNegativeError(LabelType label) const -> RealType
+{
+  const LabelSetMeasures * measures = this->FindLabelSetMeasures(label);
+  if (measures == nullptr)
+  {
+    return 0.0;
+  }
+  return GetRatio(static_cast<RealType>(measures->m_TargetComplement), static_cast<RealType>(measures->m_Target));
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetFalsePositiveError() const -> RealType
+{
+  RealType numerator = 0.0;
+  RealType denominator = 0.0;
+  for (const auto & labelSetMeasures : this->m_LabelSetMeasures)
+  {
+    // Do not include the background in the final value.
+    if (labelSetMeasures.first == this->m_BackgroundValue)
+    {
+      continue;
+    }
+    const SizeValueType nComplementIntersection = this->m_NumberOfPixels - labelSetMeasures.second.m_Union;     // TN
+    numerator += static_cast<RealType>(labelSetMeasures.second.m_SourceComplement);                             // FP
+    denominator += static_cast<RealType>(labelSetMeasures.second.m_SourceComplement + nComplementIntersection); // FP+TN
+  }
+  return GetRatio(numerator, denominator);
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetFalsePositiveError(LabelType label) const -> RealType
+{
+  const LabelSetMeasures * measures = this->FindLabelSetMeasures(label);
+  if (measures == nullptr)
+  {
+    return 0.0;
+  }
+  if (measures->m_Source == 0)
+  {
+    return NumericTraits<RealType>::max();
+  }
+  const SizeValueType nComplementIntersection = this->m_NumberOfPixels - measures->m_Union; // TN
+  return static_cast<RealType>(measures->m_SourceComplement) /
+         static_cast<RealType>(measures->m_SourceComplement + nComplementIntersection);
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetFalseDiscoveryRate() const -> RealType
+{
+  RealType numerator = 0.0;
+  RealType denominator = 0.0;
+  for (const auto & labelSetMeasures : this->m_LabelSetMeasures)
+  {
+    // Do not include the background in the final value.
+    if (labelSetMeasures.first == this->m_BackgroundValue)
+    {
+      continue;
+    }
+    numerator += static_cast<RealType>(labelSetMeasures.second.m_SourceComplement); // FP
+    denominator += static_cast<RealType>(labelSetMeasures.second.m_Source);         // FP+TP
+  }
+  return GetRatio(numerator, denominator);
+}
+
+template <typename TLabel>
+auto
+LabelOverlapMeasures<TLabel>::GetFalseDiscoveryRate(LabelType label) const -> RealType
+{
+  const LabelSetMeasures * measures = this->FindLabelSetMeasures(label);
+  if (measures == nullptr)
+  {
+    return 0.0;
+  }
+  return GetRatio(static_cast<RealType>(measures->m_SourceComplement), static_cast<RealType>(measures->m_Source));
+}
+
+} // end namespace itk
+
+#endif
@@ -19,9 +19,8 @@
 #define itkLabelOverlapMeasuresImageFilter_h
 
 #include "itkImageSink.h"
-#include "itkNumericTraits.h"
+#include "itkLabelOverlapMeasures.h"
 #include <mutex>
-#include <unordered_map>
 
 namespace itk
 {
@@ -36,7 +35,7 @@ namespace itk
  * https://doi.org/10.54294/1vixgg
  *
  * \author Nicholas J. Tustison
- * \sa LabelOverlapMeasuresImageFilter
+ * \sa LabelOverlapMeasuresLabelMapFilter
  *
  * \ingroup ITKImageStatistics
  * \ingroup MultiThreaded
@@ -70,28 +69,17 @@ public:
 
   using LabelType = typename TLabelImage::PixelType;
 
-  /** Type to use for computations. */
-  using RealType = typename NumericTraits<LabelType>::RealType;
+  /** The measures are computed by LabelOverlapMeasures. */
+  using LabelOverlapMeasuresType = LabelOverlapMeasures<LabelType>;
 
-  /** \class LabelSetMeasures
-   * \brief Metrics stored per label
-   * \ingroup ITKImageStatistics
-   */
-  class LabelSetMeasures
-  {
-  public:
-    // default constructor/copy/move etc...
+  /** Type to use for computations. */
+  using RealType = typename LabelOverlapMeasuresType::RealType;
 
-    SizeValueType m_Source{ 0 };
-    SizeValueType m_Target{ 0 };
-    SizeValueType m_Union{ 0 };
-    SizeValueType m_Intersection{ 0 };
-    SizeValueType m_SourceComplement{ 0 };
-    SizeValueType m_TargetComplement{ 0 };
-  };
+  /** Metrics stored per label */
+  using LabelSetMeasures = typename LabelOverlapMeasuresType::LabelSetMeasures;
 
   /** Type of the map used to store data per label */
-  using MapType = std::unordered_map<LabelType, LabelSetMeasures>;
+  using MapType = typename LabelOverlapMeasuresType::MapType;
   using MapIterator = typename MapType::iterator;
   using MapConstIterator = typename MapType::const_iterator;
 
@@ -116,14 +104,24 @@ public:
 
   /** Get the total overlap over all labels. */
   RealType
-  GetTotalOverlap() const;
+  GetTotalOverlap() const
+  {
+    return this->GetLabelOverlapMeasures().GetTotalOverlap();
+  }
 
   /** Get the target overlap for the specified individual label. */
-  RealType GetTargetOverlap(LabelType) const;
+  RealType
+  GetTargetOverlap(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetTargetOverlap(label);
+  }
 
   /** Get the union overlap (Jaccard coefficient) over all labels. */
   RealType
-  GetUnionOverlap() const;
+  GetUnionOverlap() const
+  {
+    return this->GetLabelOverlapMeasures().GetUnionOverlap();
+  }
   RealType
   GetJaccardCoefficient() const
   {
@@ -132,7 +130,11 @@ public:
 
   /** Get the union overlap (Jaccard coefficient) for the specified individual
    * label. */
-  RealType GetUnionOverlap(LabelType) const;
+  RealType
+  GetUnionOverlap(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetUnionOverlap(label);
+  }
   RealType
   GetJaccardCoefficient(LabelType label) const
   {
@@ -141,7 +143,10 @@ public:
 
   /** Get the mean overlap (Dice coefficient) over all labels. */
   RealType
-  GetMeanOverlap() const;
+  GetMeanOverlap() const
+  {
+    return this->GetLabelOverlapMeasures().GetMeanOverlap();
+  }
   RealType
   GetDiceCoefficient() const
   {
@@ -150,7 +155,11 @@ public:
 
   /** Get the mean overlap (Dice coefficient) for the specified individual
    * label. */
-  RealType GetMeanOverlap(LabelType) const;
+  RealType
+  GetMeanOverlap(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetMeanOverlap(label);
+  }
   RealType
   GetDiceCoefficient(LabelType label) const
   {
@@ -159,33 +168,61 @@ public:
 
   /** Get the volume similarity over all labels. */
   RealType
-  GetVolumeSimilarity() const;
+  GetVolumeSimilarity() const
+  {
+    return this->GetLabelOverlapMeasures().GetVolumeSimilarity();
+  }
 
   /** Get the volume similarity for the specified individual label. */
-  RealType GetVolumeSimilarity(LabelType) const;
+  RealType
+  GetVolumeSimilarity(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetVolumeSimilarity(label);
+  }
 
   // Overlap error metrics
 
   /** Get the false negative error over all labels. */
   RealType
-  GetFalseNegativeError() const;
+  GetFalseNegativeError() const
+  {
+    return this->GetLabelOverlapMeasures().GetFalseNegativeError();
+  }
 
   /** Get the false negative error for the specified individual label. */
-  RealType GetFalseNegativeError(LabelType) const;
+  RealType
+  GetFalseNegativeError(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetFalseNegativeError(label);
+  }
 
   /** Get the false positive error over all labels. */
   RealType
-  GetFalsePositiveError() const;
+  GetFalsePositiveError() const
+  {
+    return this->GetLabelOverlapMeasures().GetFalsePositiveError();
+  }
 
   /** Get the false positive error for the specified individual label. */
-  RealType GetFalsePositiveError(LabelType) const;
+  RealType
+  GetFalsePositiveError(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetFalsePositiveError(label);
+  }
 
   /** Get the false discovery rate over all labels. */
   RealType
-  GetFalseDiscoveryRate() const;
+  GetFalseDiscoveryRate() const
+  {
+    return this->GetLabelOverlapMeasures().GetFalseDiscoveryRate();
+  }
 
   /** Get the false discovery rate for the specified individual label. */
-  RealType GetFalseDiscoveryRate(LabelType) const;
+  RealType
+  GetFalseDiscoveryRate(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetFalseDiscoveryRate(label);
+  }
 
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
@@ -213,6 +250,10 @@ protected:
   MergeMap(MapType & m1, MapType & m2) const;
 
 private:
+  /** The measures of the labels counted by the last update. */
+  LabelOverlapMeasuresType
+  GetLabelOverlapMeasures() const;
+
   MapType m_LabelSetMeasures{};
 
   std::mutex m_Mutex{};
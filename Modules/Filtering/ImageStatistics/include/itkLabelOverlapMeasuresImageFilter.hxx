@@ -142,324 +142,13 @@ LabelOverlapMeasuresImageFilter<TLabelImage>::ThreadedStreamedGenerateData(const
 
 template <typename TLabelImage>
 auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetTotalOverlap() const -> RealType
+LabelOverlapMeasuresImageFilter<TLabelImage>::GetLabelOverlapMeasures() const -> LabelOverlapMeasuresType
 {
-  RealType numerator = 0.0;
-  RealType denominator = 0.0;
-  for (auto mapIt = this->m_LabelSetMeasures.begin(); mapIt != this->m_LabelSetMeasures.end(); ++mapIt)
-  {
-    // Do not include the background in the final value.
-    if (mapIt->first == LabelType{})
-    {
-      continue;
-    }
-    numerator += static_cast<RealType>(mapIt->second.m_Intersection);
-    denominator += static_cast<RealType>(mapIt->second.m_Target);
-  }
-
-  if (Math::ExactlyEquals(denominator, 0.0))
-  {
-    return NumericTraits<RealType>::max();
-  }
-  else
-  {
-    return (numerator / denominator);
-  }
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetTargetOverlap(LabelType label) const -> RealType
-{
-  auto mapIt = this->m_LabelSetMeasures.find(label);
-  if (mapIt == this->m_LabelSetMeasures.end())
-  {
-    itkWarningMacro("Label " << static_cast<PrintType>(label) << " not found.");
-    return 0.0;
-  }
-
-  RealType value;
-
-  if (mapIt->second.m_Target == 0)
-  {
-    value = NumericTraits<RealType>::max();
-  }
-  else
-  {
-    value = static_cast<RealType>(mapIt->second.m_Intersection) / static_cast<RealType>(mapIt->second.m_Target);
-  }
-  return value;
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetUnionOverlap() const -> RealType
-{
-  RealType numerator = 0.0;
-  RealType denominator = 0.0;
-  for (auto mapIt = this->m_LabelSetMeasures.begin(); mapIt != this->m_LabelSetMeasures.end(); ++mapIt)
-  {
-    // Do not include the background in the final value.
-    if (mapIt->first == LabelType{})
-    {
-      continue;
-    }
-    numerator += static_cast<RealType>(mapIt->second.m_Intersection);
-    denominator += static_cast<RealType>(mapIt->second.m_Union);
-  }
-
-  if (Math::ExactlyEquals(denominator, 0.0))
-  {
-    return NumericTraits<RealType>::max();
-  }
-  else
-  {
-    return (numerator / denominator);
-  }
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetUnionOverlap(LabelType label) const -> RealType
-{
-  auto mapIt = this->m_LabelSetMeasures.find(label);
-  if (mapIt == this->m_LabelSetMeasures.end())
-  {
-    itkWarningMacro("Label " << static_cast<PrintType>(label) << " not found.");
-    return 0.0;
-  }
-
-  RealType value;
-  if (Math::ExactlyEquals(mapIt->second.m_Union, 0.0))
-  {
-    value = NumericTraits<RealType>::max();
-  }
-  else
-  {
-    value = static_cast<RealType>(mapIt->second.m_Intersection) / static_cast<RealType>(mapIt->second.m_Union);
-  }
-
-  return value;
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetMeanOverlap() const -> RealType
-{
-  RealType uo = this->GetUnionOverlap();
-  return (2.0 * uo / (1.0 + uo));
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetMeanOverlap(LabelType label) const -> RealType
-{
-  RealType uo = this->GetUnionOverlap(label);
-  return (2.0 * uo / (1.0 + uo));
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetVolumeSimilarity() const -> RealType
-{
-  RealType numerator = 0.0;
-  RealType denominator = 0.0;
-  for (auto mapIt = this->m_LabelSetMeasures.begin(); mapIt != this->m_LabelSetMeasures.end(); ++mapIt)
-  {
-    // Do not include the background in the final value.
-    if (mapIt->first == LabelType{})
-    {
-      continue;
-    }
-    numerator += ((static_cast<RealType>(mapIt->second.m_Source) - static_cast<RealType>(mapIt->second.m_Target)));
-    denominator += ((static_cast<RealType>(mapIt->second.m_Source) + static_cast<RealType>(mapIt->second.m_Target)));
-  }
-
-  if (Math::ExactlyEquals(denominator, 0.0))
-  {
-    return NumericTraits<RealType>::max();
-  }
-  else
-  {
-    return (2.0 * numerator / denominator);
-  }
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetVolumeSimilarity(LabelType label) const -> RealType
-{
-  auto mapIt = this->m_LabelSetMeasures.find(label);
-  if (mapIt == this->m_LabelSetMeasures.end())
-  {
-    itkWarningMacro("Label " << static_cast<PrintType>(label) << " not found.");
-    return 0.0;
-  }
-  RealType value = 2.0 *
-                   (static_cast<RealType>(mapIt->second.m_Source) - static_cast<RealType>(mapIt->second.m_Target)) /
-                   (static_cast<RealType>(mapIt->second.m_Source) + static_cast<RealType>(mapIt->second.m_Target));
-  return value;
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetFalseNegativeError() const -> RealType
-{
-  RealType numerator = 0.0;
-  RealType denominator = 0.0;
-  for (auto mapIt = this->m_LabelSetMeasures.begin(); mapIt != this->m_LabelSetMeasures.end(); ++mapIt)
-  {
-    // Do not include the background in the final value.
-    if (mapIt->first == LabelType{})
-    {
-      continue;
-    }
-    numerator += static_cast<RealType>(mapIt->second.m_TargetComplement);
-    denominator += static_cast<RealType>(mapIt->second.m_Target);
-  }
-
-  if (Math::ExactlyEquals(denominator, 0.0))
-  {
-    return NumericTraits<RealType>::max();
-  }
-  else
-  {
-    return (numerator / denominator);
-  }
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetFalseNegativeError(LabelType label) const -> RealType
-{
-  auto mapIt = this->m_LabelSetMeasures.find(label);
-  if (mapIt == this->m_LabelSetMeasures.end())
-  {
-    itkWarningMacro("Label " << static_cast<PrintType>(label) << " not found.");
-    return 0.0;
-  }
-
-  RealType value;
-  if (Math::ExactlyEquals(mapIt->second.m_Target, 0.0))
-  {
-    value = NumericTraits<RealType>::max();
-  }
-  else
-  {
-    value = static_cast<RealType>(mapIt->second.m_TargetComplement) / static_cast<RealType>(mapIt->second.m_Target);
-  }
-
-  return value;
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetFalsePositiveError() const -> RealType
-{
-  RealType numerator = 0.0;
-  RealType denominator = 0.0;
-
-  auto nVox = this->GetInput(0)->GetLargestPossibleRegion().GetNumberOfPixels(); // TP+FP+FN+TN
-
-  for (auto mapIt = this->m_LabelSetMeasures.begin(); mapIt != this->m_LabelSetMeasures.end(); ++mapIt)
-  {
-    // Do not include the background in the final value.
-    if (mapIt->first == LabelType{})
-    {
-      continue;
-    }
-    auto nComplementIntersection = nVox - mapIt->second.m_Union;                                      // TN
-    numerator += static_cast<RealType>(mapIt->second.m_SourceComplement);                             // FP
-    denominator += static_cast<RealType>(mapIt->second.m_SourceComplement + nComplementIntersection); // FP+TN
-  }
-
-  if (Math::ExactlyEquals(denominator, 0.0))
-  {
-    return NumericTraits<RealType>::max();
-  }
-  else
-  {
-    return (numerator / denominator);
-  }
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetFalsePositiveError(LabelType label) const -> RealType
-{
-  auto nVox = this->GetInput(0)->GetLargestPossibleRegion().GetNumberOfPixels(); // TP+FP+FN+TN
-  auto mapIt = this->m_LabelSetMeasures.find(label);
-  if (mapIt == this->m_LabelSetMeasures.end())
-  {
-    itkWarningMacro("Label " << static_cast<PrintType>(label) << " not found.");
-    return 0.0;
-  }
-
-  RealType value;
-  if (Math::ExactlyEquals(mapIt->second.m_Source, 0.0))
-  {
-    value = NumericTraits<RealType>::max();
-  }
-  else
-  {
-    auto nComplementIntersection = nVox - mapIt->second.m_Union; // TN
-
-    value = static_cast<RealType>(mapIt->second.m_SourceComplement) /
-            static_cast<RealType>(mapIt->second.m_SourceComplement + nComplementIntersection);
-  }
-
-  return value;
-}
-
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetFalseDiscoveryRate() const -> RealType
-{
-  RealType numerator = 0.0;
-  RealType denominator = 0.0;
-  for (auto mapIt = this->m_LabelSetMeasures.begin(); mapIt != this->m_LabelSetMeasures.end(); ++mapIt)
-  {
-    // Do not include the background in the final value.
-    if (mapIt->first == LabelType{})
-    {
-      continue;
-    }
-    numerator += static_cast<RealType>(mapIt->second.m_SourceComplement); // FP
-    denominator += static_cast<RealType>(mapIt->second.m_Source);         // FP+TP
-  }
-
-  if (Math::ExactlyEquals(denominator, 0.0))
-  {
-    return NumericTraits<RealType>::max();
-  }
-  else
-  {
-    return (numerator / denominator);
-  }
-}
-
-template <typename TLabelImage>
-auto
-LabelOverlapMeasuresImageFilter<TLabelImage>::GetFalseDiscoveryRate(LabelType label) const -> RealType
-{
-  auto mapIt = this->m_LabelSetMeasures.find(label);
-  if (mapIt == this->m_LabelSetMeasures.end())
-  {
-    itkWarningMacro("Label " << static_cast<PrintType>(label) << " not found.");
-    return 0.0;
-  }
-
-  RealType value;
-  if (Math::ExactlyEquals(mapIt->second.m_Source, 0.0))
-  {
-    value = NumericTraits<RealType>::max();
-  }
-  else
-  {
-    value = static_cast<RealType>(mapIt->second.m_SourceComplement) / static_cast<RealType>(mapIt->second.m_Source);
-  }
-  return value;
+  // Label 0 is the background
+  const LabelImageType * sourceImage = this->GetSourceImage();
+  const SizeValueType    numberOfPixels =
+    sourceImage ? sourceImage->GetLargestPossibleRegion().GetNumberOfPixels() : 0; // TP+FP+FN+TN
+  return LabelOverlapMeasuresType(this->m_LabelSetMeasures, LabelType{}, numberOfPixels);
 }
 
 template <typename TLabelImage>
@@ -24,6 +24,7 @@
 #include "itkHistogram.h"
 #include "itkPrintHelper.h"
 #include <mutex>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -52,6 +53,15 @@ namespace itk
  * 1. Statistics are independently computed for each streamed and
  * threaded region then merged.
  *
+ * For integral label types, when the labels present in a threaded
+ * region span no more than MaximumDenseLabelRange consecutive values,
+ * a table indexed by label value gives each label of that region a
+ * compact index, and the statistics are accumulated in flat arrays
+ * holding the labels present only, instead of a hash map. This avoids a
+ * hash lookup per pixel and greatly speeds up label images with many
+ * compact labels, such as cell segmentations. Setting
+ * MaximumDenseLabelRange to zero disables this path.
+ *
  * \ingroup MathematicalStatisticsImageFilters
  * \ingroup ITKImageStatistics
  *
@@ -281,6 +291,14 @@ public:
   itkGetConstMacro(UseHistograms, bool);
   itkBooleanMacro(UseHistograms);
 
+  /** Set/Get the largest span of label values (maximum label minus
+   * minimum label plus one) of a threaded region for which the
+   * statistics are accumulated in dense per-label arrays. Regions with
+   * a larger span, and non-integral label types, use a hash map. A
+   * value of zero disables the dense path. Defaults to 65536. */
+  itkSetMacro(MaximumDenseLabelRange, SizeValueType);
+  itkGetConstMacro(MaximumDenseLabelRange, SizeValueType);
+
 
   virtual const ValidLabelValuesContainerType &
   GetValidLabelValues() const
@@ -409,6 +427,23 @@ private:
   void
   MergeMap(MapType &, MapType &) const;
 
+  /** Accumulate the statistics of a region into a hash map, one lookup per pixel. */
+  void
+  AccumulateSparse(const RegionType &, MapType &) const;
+
+  /** Accumulate the statistics of a region whose labels lie in
+   * [minimumLabel, minimumLabel + labelRange) into flat arrays of the
+   * labels present, through a table of their compact indices, then
+   * copy them into the map. */
+  void
+  AccumulateDense(const RegionType &, LabelPixelType minimumLabel, SizeValueType labelRange, MapType &) const;
+
+  /** Compute the span of the label values in a region. Returns false
+   * when the span exceeds MaximumDenseLabelRange or the label type is
+   * not integral. */
+  bool
+  ComputeDenseLabelRange(const RegionType &, LabelPixelType & minimumLabel, SizeValueType & labelRange) const;
+
   MapType                       m_LabelStatistics{};
   ValidLabelValuesContainerType m_ValidLabelValues{};
 
@@ -419,6 +454,8 @@ private:
   RealType m_LowerBound{};
   RealType m_UpperBound{};
 
+  SizeValueType m_MaximumDenseLabelRange{ 65536 };
+
   std::mutex m_Mutex{};
 
 }; // end of class
@@ -22,6 +22,7 @@
 #include "itkImageScanlineConstIterator.h"
 #include "itkTotalProgressReporter.h"
 #include <algorithm> // For min and max.
+#include <cstdint>
 
 namespace itk
 {
@@ -156,25 +157,177 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::AfterStreamedGenerateData(
 }
 
 template <typename TInputImage, typename TLabelImage>
-void
-LabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedStreamedGenerateData(
-  const RegionType & outputRegionForThread)
+bool
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::ComputeDenseLabelRange(const RegionType & region,
+                                                                             LabelPixelType &   minimumLabel,
+                                                                             SizeValueType &    labelRange) const
 {
+  if constexpr (std::is_integral_v<LabelPixelType> && !std::is_same_v<LabelPixelType, bool>)
+  {
+    if (m_MaximumDenseLabelRange == 0)
+    {
+      return false;
+    }
 
-  MapType localStatistics;
+    ImageScanlineConstIterator labelIt(this->GetLabelInput(), region);
+
+    LabelPixelType minimum = labelIt.Get();
+    LabelPixelType maximum = minimum;
+    while (!labelIt.IsAtEnd())
+    {
+      while (!labelIt.IsAtEndOfLine())
+      {
+        const LabelPixelType label = labelIt.Get();
+        minimum = std::min(minimum, label);
+        maximum = std::max(maximum, label);
+        ++labelIt;
+      }
+      labelIt.NextLine();
+    }
+
+    // The difference is computed in the unsigned type so that it cannot overflow for signed labels.
+    using UnsignedLabelType = std::make_unsigned_t<LabelPixelType>;
+    const auto span =
+      static_cast<UnsignedLabelType>(static_cast<UnsignedLabelType>(maximum) - static_cast<UnsignedLabelType>(minimum));
+    // The compact indices of the labels are 32 bits wide.
+    if (static_cast<std::uintmax_t>(span) >= static_cast<std::uintmax_t>(m_MaximumDenseLabelRange) ||
+        static_cast<std::uintmax_t>(span) >= static_cast<std::uintmax_t>(NumericTraits<std::uint32_t>::max()))
+    {
+      return false;
+    }
+
+    minimumLabel = minimum;
+    labelRange = static_cast<SizeValueType>(span) + 1;
+    return true;
+  }
+  else
+  {
+    (void)region;
+    (void)minimumLabel;
+    (void)labelRange;
+    return false;
+  }
+}
+
+template <typename TInputImage, typename TLabelImage>
+void
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::AccumulateDense(const RegionType & region,
+                                                                      LabelPixelType     minimumLabel,
+                                                                      SizeValueType      labelRange,
+                                                                      MapType &          statistics) const
+{
+  // Compact index of each label value of the range, in the order the
+  // labels are met; only the labels present get accumulators.
+  using CompactIndexType = std::uint32_t;
+  constexpr auto                NoCompactIndex = NumericTraits<CompactIndexType>::max();
+  std::vector<CompactIndexType> compactIndex(labelRange, NoCompactIndex);
+
+  // Structure of arrays, indexed by the compact index of the label
+  std::vector<LabelPixelType>   labels;
+  std::vector<IdentifierType>   count;
+  std::vector<RealType>         sum;
+  std::vector<RealType>         sumOfSquares;
+  std::vector<RealType>         minimum;
+  std::vector<RealType>         maximum;
+  std::vector<IndexValueType>   boundingBox;
+  std::vector<HistogramPointer> histograms;
 
   typename HistogramType::IndexType             histogramIndex(1);
   typename HistogramType::MeasurementVectorType histogramMeasurement(1);
 
-  const SizeValueType size0 = outputRegionForThread.GetSize(0);
-  if (size0 == 0)
+  ImageLinearConstIteratorWithIndex<TInputImage> it(this->GetInput(), region);
+
+  ImageScanlineConstIterator labelIt(this->GetLabelInput(), region);
+
+  while (!it.IsAtEnd())
   {
-    return;
+    IndexType index = it.GetIndex();
+    while (!it.IsAtEndOfLine())
+    {
+      const auto       value = static_cast<RealType>(it.Get());
+      const auto       label = labelIt.Get();
+      CompactIndexType i = compactIndex[static_cast<SizeValueType>(label - minimumLabel)];
+      if (i == NoCompactIndex)
+      {
+        // first pixel of this label in the region
+        i = static_cast<CompactIndexType>(labels.size());
+        compactIndex[static_cast<SizeValueType>(label - minimumLabel)] = i;
+        labels.push_back(label);
+        count.push_back(IdentifierType{});
+        sum.push_back(RealType{});
+        sumOfSquares.push_back(RealType{});
+        minimum.push_back(NumericTraits<RealType>::max());
+        maximum.push_back(NumericTraits<RealType>::NonpositiveMin());
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          boundingBox.push_back(NumericTraits<IndexValueType>::max());
+          boundingBox.push_back(NumericTraits<IndexValueType>::NonpositiveMin());
+        }
+        if (m_UseHistograms)
+        {
+          histograms.push_back(LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound).m_Histogram);
+        }
+      }
+
+      minimum[i] = std::min(minimum[i], value);
+      maximum[i] = std::max(maximum[i], value);
+      sum[i] += value;
+      sumOfSquares[i] += value * value;
+      ++count[i];
+
+      // bounding box is min,max pairs
+      IndexValueType * const labelBoundingBox = &boundingBox[i * ImageDimension * 2];
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        labelBoundingBox[2 * d] = std::min(labelBoundingBox[2 * d], index[d]);
+        labelBoundingBox[2 * d + 1] = std::max(labelBoundingBox[2 * d + 1], index[d]);
+      }
+
+      if (m_UseHistograms)
+      {
+        histogramMeasurement[0] = value;
+        histograms[i]->GetIndex(histogramMeasurement, histogramIndex);
+        histograms[i]->IncreaseFrequencyOfIndex(histogramIndex, 1);
+      }
+
+      ++index[0];
+      ++labelIt;
+      ++it;
+    }
+    labelIt.NextLine();
+    it.NextLine();
   }
 
-  ImageLinearConstIteratorWithIndex<TInputImage> it(this->GetInput(), outputRegionForThread);
+  statistics.reserve(statistics.size() + labels.size());
+  for (SizeValueType i = 0; i < labels.size(); ++i)
+  {
+    LabelStatistics labelStats;
+    labelStats.m_Count = count[i];
+    labelStats.m_Sum = sum[i];
+    labelStats.m_SumOfSquares = sumOfSquares[i];
+    labelStats.m_Minimum = minimum[i];
+    labelStats.m_Maximum = maximum[i];
+    std::copy_n(&boundingBox[i * ImageDimension * 2], ImageDimension * 2, labelStats.m_BoundingBox.begin());
+    if (m_UseHistograms)
+    {
+      labelStats.m_Histogram = std::move(histograms[i]);
+    }
+
+    statistics.emplace(labels[i], std::move(labelStats));
+  }
+}
+
+template <typename TInputImage, typename TLabelImage>
+void
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::AccumulateSparse(const RegionType & region,
+                                                                       MapType &          localStatistics) const
+{
+  typename HistogramType::IndexType             histogramIndex(1);
+  typename HistogramType::MeasurementVectorType histogramMeasurement(1);
 
-  ImageScanlineConstIterator labelIt(this->GetLabelInput(), outputRegionForThread);
+  ImageLinearConstIteratorWithIndex<TInputImage> it(this->GetInput(), region);
+
+  ImageScanlineConstIterator labelIt(this->GetLabelInput(), region);
 
   auto mapIt = localStatistics.end();
 
@@ -241,6 +394,32 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedStreamedGenerateDa
     labelIt.NextLine();
     it.NextLine();
   }
+}
+
+template <typename TInputImage, typename TLabelImage>
+void
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedStreamedGenerateData(
+  const RegionType & outputRegionForThread)
+{
+
+  MapType localStatistics;
+
+  const SizeValueType size0 = outputRegionForThread.GetSize(0);
+  if (size0 == 0)
+  {
+    return;
+  }
+
+  LabelPixelType minimumLabel{};
+  SizeValueType  labelRange{};
+  if (this->ComputeDenseLabelRange(outputRegionForThread, minimumLabel, labelRange))
+  {
+    this->AccumulateDense(outputRegionForThread, minimumLabel, labelRange, localStatistics);
+  }
+  else
+  {
+    this->AccumulateSparse(outputRegionForThread, localStatistics);
+  }
 
 
   // Merge localStatistics and m_LabelStatistics concurrently safe in a
@@ -498,6 +677,7 @@ LabelStatisticsImageFilter<TImage, TLabelImage>::PrintSelf(std::ostream & os, In
   os << indent << "NumBins: " << m_NumBins << std::endl;
   os << indent << "LowerBound: " << static_cast<typename NumericTraits<RealType>::PrintType>(m_LowerBound) << std::endl;
   os << indent << "UpperBound: " << static_cast<typename NumericTraits<RealType>::PrintType>(m_UpperBound) << std::endl;
+  os << indent << "MaximumDenseLabelRange: " << m_MaximumDenseLabelRange << std::endl;
 }
 } // end namespace itk
 #endif
@@ -19,6 +19,7 @@
 #include "itkGTest.h"
 #include "itkImageFileReader.h"
 #include "itkPipelineMonitorImageFilter.h"
+#include "itkLabelOverlapMeasures.h"
 #include "itkLabelOverlapMeasuresImageFilter.h"
 
 namespace
@@ -204,3 +205,31 @@ TEST_F(LabelOverlapMeasuresImageFilterFixture, test3)
   EXPECT_NEAR(filter->GetFalsePositiveError(2), 4.76837612950e-07, 1e-17);
   EXPECT_NEAR(filter->GetFalseDiscoveryRate(2), 1.0 / 3.0, 0.0);
 }
+
+
+// The measures over all labels exclude the background value, which needs not be 0.
+TEST(LabelOverlapMeasures, ExcludesTheBackgroundValue)
+{
+  using MeasuresType = itk::LabelOverlapMeasures<unsigned char>;
+
+  MeasuresType::MapType labelSetMeasures;
+  labelSetMeasures[5] = { 9, 8, 10, 7, 2, 1 };
+  labelSetMeasures[1] = { 2, 4, 4, 2, 0, 2 };
+  labelSetMeasures[2] = { 3, 2, 3, 2, 1, 0 };
+
+  const MeasuresType measures(labelSetMeasures, 5, 16);
+  EXPECT_DOUBLE_EQ(measures.GetTotalOverlap(), 4.0 / 6.0);
+  EXPECT_DOUBLE_EQ(measures.GetUnionOverlap(), 4.0 / 7.0);
+  EXPECT_DOUBLE_EQ(measures.GetMeanOverlap(), 8.0 / 11.0);
+  EXPECT_DOUBLE_EQ(measures.GetVolumeSimilarity(), -2.0 / 11.0);
+  EXPECT_DOUBLE_EQ(measures.GetFalseNegativeError(), 2.0 / 6.0);
+  EXPECT_DOUBLE_EQ(measures.GetFalsePositiveError(), 1.0 / 26.0);
+  EXPECT_DOUBLE_EQ(measures.GetFalseDiscoveryRate(), 1.0 / 5.0);
+
+  EXPECT_DOUBLE_EQ(measures.GetTargetOverlap(5), 7.0 / 8.0);
+  EXPECT_DOUBLE_EQ(measures.GetFalsePositiveError(2), 1.0 / 14.0);
+  EXPECT_DOUBLE_EQ(measures.GetTargetOverlap(3), 0.0);
+
+  const MeasuresType withBackground0(labelSetMeasures, 0, 16);
+  EXPECT_DOUBLE_EQ(withBackground0.GetTotalOverlap(), 11.0 / 14.0);
+}
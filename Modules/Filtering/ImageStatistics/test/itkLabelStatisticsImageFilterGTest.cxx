@@ -0,0 +1,154 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkLabelStatisticsImageFilter.h"
+
+namespace
+{
+
+template <typename TLabelPixel>
+class LabelStatisticsImageFilterFixture : public ::testing::Test
+{
+protected:
+  static constexpr unsigned int Dimension = 3;
+  using IntensityImageType = itk::Image<float, Dimension>;
+  using LabelImageType = itk::Image<TLabelPixel, Dimension>;
+  using FilterType = itk::LabelStatisticsImageFilter<IntensityImageType, LabelImageType>;
+
+  void
+  SetUp() override
+  {
+    const auto                                  size = IntensityImageType::SizeType::Filled(32);
+    const typename IntensityImageType::RegionType region(size);
+
+    m_Intensity = IntensityImageType::New();
+    m_Intensity->SetRegions(region);
+    m_Intensity->Allocate();
+
+    m_Labels = LabelImageType::New();
+    m_Labels->SetRegions(region);
+    m_Labels->Allocate();
+
+    // Labels are small blocks with values offset from the most negative representable label
+    itk::ImageRegionIteratorWithIndex<IntensityImageType> it(m_Intensity, region);
+    itk::ImageRegionIteratorWithIndex<LabelImageType>     labelIt(m_Labels, region);
+    for (; !it.IsAtEnd(); ++it, ++labelIt)
+    {
+      const auto & index = it.GetIndex();
+      const auto   block = (index[0] / 4) + 8 * (index[1] / 4) + 64 * (index[2] / 8);
+      labelIt.Set(static_cast<TLabelPixel>(itk::NumericTraits<TLabelPixel>::NonpositiveMin() + block));
+      it.Set(static_cast<float>((index[0] * 7 + index[1] * 3 + index[2]) % 17));
+    }
+  }
+
+  typename FilterType::Pointer
+  RunFilter(itk::SizeValueType maximumDenseLabelRange, bool useHistograms, unsigned int streamDivisions = 1)
+  {
+    auto filter = FilterType::New();
+    filter->SetInput(m_Intensity);
+    filter->SetLabelInput(m_Labels);
+    filter->SetMaximumDenseLabelRange(maximumDenseLabelRange);
+    if (useHistograms)
+    {
+      filter->SetHistogramParameters(17, -0.5, 16.5);
+    }
+    filter->SetNumberOfStreamDivisions(streamDivisions);
+    filter->Update();
+    return filter;
+  }
+
+  static void
+  ExpectSameStatistics(const FilterType * expected, const FilterType * actual)
+  {
+    ASSERT_EQ(expected->GetNumberOfLabels(), actual->GetNumberOfLabels());
+    for (const auto label : expected->GetValidLabelValues())
+    {
+      ASSERT_TRUE(actual->HasLabel(label));
+      EXPECT_EQ(expected->GetCount(label), actual->GetCount(label));
+      EXPECT_EQ(expected->GetMinimum(label), actual->GetMinimum(label));
+      EXPECT_EQ(expected->GetMaximum(label), actual->GetMaximum(label));
+      EXPECT_DOUBLE_EQ(expected->GetSum(label), actual->GetSum(label));
+      EXPECT_DOUBLE_EQ(expected->GetMean(label), actual->GetMean(label));
+      EXPECT_NEAR(expected->GetVariance(label), actual->GetVariance(label), 1e-9);
+      EXPECT_EQ(expected->GetBoundingBox(label), actual->GetBoundingBox(label));
+      EXPECT_EQ(expected->GetMedian(label), actual->GetMedian(label));
+    }
+  }
+
+  typename IntensityImageType::Pointer m_Intensity;
+  typename LabelImageType::Pointer     m_Labels;
+};
+
+using LabelPixelTypes = ::testing::Types<unsigned char, short, unsigned int, long long>;
+TYPED_TEST_SUITE(LabelStatisticsImageFilterFixture, LabelPixelTypes);
+
+} // namespace
+
+
+TYPED_TEST(LabelStatisticsImageFilterFixture, DenseMatchesSparse)
+{
+  const auto sparse = this->RunFilter(0, false);
+  const auto dense = this->RunFilter(65536, false);
+
+  EXPECT_EQ(sparse->GetNumberOfLabels(), 256u);
+  this->ExpectSameStatistics(sparse, dense);
+}
+
+
+TYPED_TEST(LabelStatisticsImageFilterFixture, DenseMatchesSparseWithHistograms)
+{
+  const auto sparse = this->RunFilter(0, true);
+  const auto dense = this->RunFilter(65536, true);
+
+  this->ExpectSameStatistics(sparse, dense);
+}
+
+
+TYPED_TEST(LabelStatisticsImageFilterFixture, DenseStreamed)
+{
+  const auto sparse = this->RunFilter(0, true);
+
+  // A range smaller than the number of labels falls back to the map for the regions exceeding it
+  const auto mixed = this->RunFilter(32, true, 4);
+  const auto streamed = this->RunFilter(65536, true, 4);
+
+  this->ExpectSameStatistics(sparse, mixed);
+  this->ExpectSameStatistics(sparse, streamed);
+}
+
+
+// Labels spread over a range much larger than their number only get accumulators for the labels present
+using LabelStatisticsImageFilterSpreadLabels = LabelStatisticsImageFilterFixture<unsigned int>;
+TEST_F(LabelStatisticsImageFilterSpreadLabels, DenseMatchesSparse)
+{
+  itk::ImageRegionIteratorWithIndex<LabelImageType> labelIt(m_Labels, m_Labels->GetBufferedRegion());
+  for (; !labelIt.IsAtEnd(); ++labelIt)
+  {
+    const auto & index = labelIt.GetIndex();
+    labelIt.Set(static_cast<unsigned int>(1000 + 211 * ((index[0] / 4) + 8 * (index[1] / 4) + 64 * (index[2] / 8))));
+  }
+
+  const auto sparse = RunFilter(0, true);
+  EXPECT_EQ(sparse->GetNumberOfLabels(), 256u);
+  EXPECT_TRUE(sparse->HasLabel(1000 + 211 * 255));
+  ExpectSameStatistics(sparse, RunFilter(65536, true));
+  ExpectSameStatistics(sparse, RunFilter(65536, true, 4));
+}
@@ -24,6 +24,7 @@
 #include "itkConnectedComponentAlgorithm.h"
 #include "itkProgressReporter.h"
 #include "itkProgressTransformer.h"
+#include <deque>
 
 namespace itk
 {
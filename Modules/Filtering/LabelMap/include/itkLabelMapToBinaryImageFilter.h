@@ -27,9 +27,15 @@ namespace itk
  * \brief Convert a LabelMap to a binary image.
  *
  * LabelMapToBinaryImageFilter to a binary image. All the objects in the image
- * are used as foreground.  The background values of the original binary image
- * can be restored by passing this image to the filter with the
- * SetBackgroundImage() method.
+ * with a label between the LowerThreshold and the UpperThreshold, inclusive,
+ * are used as foreground. By default all of them are.  The background values
+ * of the original binary image can be restored by passing this image to the
+ * filter with the SetBackgroundImage() method.
+ *
+ * Thresholding the labels this way gives the output of a
+ * BinaryThresholdImageFilter applied to the label image of the LabelMap,
+ * as long as the background value of the LabelMap is outside of the
+ * thresholds, but only the lines of the selected objects are written.
  *
  * This implementation was taken from the Insight Journal paper:
  * https://doi.org/10.54294/q6auw4
@@ -37,7 +43,7 @@ namespace itk
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction,
  * INRA de Jouy-en-Josas, France.
  *
- * \sa LabelMapToLabelImageFilter, LabelMapMaskImageFilter
+ * \sa LabelMapToLabelImageFilter, LabelMapMaskImageFilter, BinaryThresholdImageFilter
  * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
  * \ingroup ITKLabelMap
  */
@@ -92,6 +98,20 @@ public:
   itkSetMacro(ForegroundValue, OutputImagePixelType);
   itkGetConstMacro(ForegroundValue, OutputImagePixelType);
 
+  /**
+   * Set/Get the lowest label of the objects used as foreground.
+   * Defaults to NumericTraits<InputImagePixelType>::NonpositiveMin().
+   */
+  itkSetMacro(LowerThreshold, InputImagePixelType);
+  itkGetConstMacro(LowerThreshold, InputImagePixelType);
+
+  /**
+   * Set/Get the highest label of the objects used as foreground.
+   * Defaults to NumericTraits<InputImagePixelType>::max().
+   */
+  itkSetMacro(UpperThreshold, InputImagePixelType);
+  itkGetConstMacro(UpperThreshold, InputImagePixelType);
+
   /** Set/Get the background image top be used to restore the background values
    */
   void
@@ -157,6 +177,8 @@ protected:
 private:
   OutputImagePixelType m_BackgroundValue{};
   OutputImagePixelType m_ForegroundValue{};
+  InputImagePixelType  m_LowerThreshold{};
+  InputImagePixelType  m_UpperThreshold{};
 }; // end of class
 } // end namespace itk
 
@@ -30,6 +30,8 @@ LabelMapToBinaryImageFilter<TInputImage, TOutputImage>::LabelMapToBinaryImageFil
 {
   this->m_BackgroundValue = NumericTraits<OutputImagePixelType>::NonpositiveMin();
   this->m_ForegroundValue = NumericTraits<OutputImagePixelType>::max();
+  this->m_LowerThreshold = NumericTraits<InputImagePixelType>::NonpositiveMin();
+  this->m_UpperThreshold = NumericTraits<InputImagePixelType>::max();
   this->DynamicMultiThreadingOn();
 }
 
@@ -137,6 +139,12 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapToBinaryImageFilter<TInputImage, TOutputImage>::ThreadedProcessLabelObject(LabelObjectType * labelObject)
 {
+  const InputImagePixelType label = labelObject->GetLabel();
+  if (label < this->m_LowerThreshold || this->m_UpperThreshold < label)
+  {
+    return;
+  }
+
   OutputImageType *                            output = this->GetOutput();
   typename LabelObjectType::ConstIndexIterator it(labelObject);
   while (!it.IsAtEnd())
@@ -156,6 +164,10 @@ LabelMapToBinaryImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream &
      << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(this->m_ForegroundValue) << std::endl;
   os << indent << "BackgroundValue: "
      << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(this->m_BackgroundValue) << std::endl;
+  os << indent << "LowerThreshold: "
+     << static_cast<typename NumericTraits<InputImagePixelType>::PrintType>(this->m_LowerThreshold) << std::endl;
+  os << indent << "UpperThreshold: "
+     << static_cast<typename NumericTraits<InputImagePixelType>::PrintType>(this->m_UpperThreshold) << std::endl;
 }
 } // end namespace itk
 
@@ -28,12 +28,26 @@ namespace itk
  *
  * LabelMapToBinaryImageFilter to a label image.
  *
+ * Only the requested region of the output is generated, the lines of
+ * the label objects being clipped to it. The run-length encoded label
+ * map can thus be written with a streaming ImageFileWriter, or
+ * processed by a StreamingImageFilter, without ever allocating the
+ * whole label image.
+ *
+ * Most processing of the label image can stay on the LabelMap instead:
+ * ChangeLabelLabelMapFilter changes its labels as ChangeLabelImageFilter
+ * does, LabelMapToBinaryImageFilter thresholds them as
+ * BinaryThresholdImageFilter does, and LabelOverlapMeasuresLabelMapFilter
+ * computes the measures of LabelOverlapMeasuresImageFilter, all of them
+ * working on the lines of the label objects.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
  * https://doi.org/10.54294/q6auw4
  *
- * \sa LabelMapToBinaryImageFilter, LabelMapMaskImageFilter
+ * \sa LabelMapToBinaryImageFilter, LabelMapMaskImageFilter, ChangeLabelLabelMapFilter,
+ * LabelOverlapMeasuresLabelMapFilter
  * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
  * \ingroup LabeledImageFilters
  * \ingroup ITKLabelMap
@@ -79,6 +93,12 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(LabelMapToLabelImageFilter);
 
+  /** LabelMapToLabelImageFilter can produce any region of the output,
+   * so the requested region is not enlarged. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * itkNotUsed(output)) override
+  {}
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
 #endif
@@ -21,6 +21,7 @@
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -42,14 +43,34 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapToLabelImageFilter<TInputImage, TOutputImage>::ThreadedProcessLabelObject(LabelObjectType * labelObject)
 {
-  OutputImageType *                            output = this->GetOutput();
-  const typename LabelObjectType::LabelType &  label = labelObject->GetLabel();
-  typename LabelObjectType::ConstIndexIterator it(labelObject);
+  OutputImageType *             output = this->GetOutput();
+  const OutputImageRegionType & region = output->GetBufferedRegion();
+  const IndexType &             regionIndex = region.GetIndex();
+  const auto &                  regionSize = region.GetSize();
+  const auto                    label = static_cast<OutputImagePixelType>(labelObject->GetLabel());
 
-  while (!it.IsAtEnd())
+  typename LabelObjectType::ConstLineIterator lit(labelObject);
+  for (; !lit.IsAtEnd(); ++lit)
   {
-    output->SetPixel(it.GetIndex(), label);
-    ++it;
+    IndexType idx = lit.GetLine().GetIndex();
+
+    // skip the lines outside of the output region
+    bool isInside = true;
+    for (unsigned int i = 1; i < OutputImageDimension && isInside; ++i)
+    {
+      isInside = idx[i] >= regionIndex[i] && idx[i] < regionIndex[i] + static_cast<IndexValueType>(regionSize[i]);
+    }
+    const IndexValueType lineBegin = std::max(idx[0], regionIndex[0]);
+    const IndexValueType lineEnd = std::min(idx[0] + static_cast<IndexValueType>(lit.GetLine().GetLength()),
+                                            regionIndex[0] + static_cast<IndexValueType>(regionSize[0]));
+    if (!isInside || lineBegin >= lineEnd)
+    {
+      continue;
+    }
+
+    // the pixels of a line are contiguous in the buffer
+    idx[0] = lineBegin;
+    std::fill_n(output->GetBufferPointer() + output->ComputeOffset(idx), lineEnd - lineBegin, label);
   }
 }
 
@@ -18,7 +18,7 @@
 #ifndef itkLabelObject_h
 #define itkLabelObject_h
 
-#include <deque>
+#include <vector>
 #include "itkLightObject.h"
 #include "itkLabelObjectLine.h"
 #include "itkWeakPointer.h"
@@ -278,7 +278,7 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
+    using LineContainerType = typename std::vector<LineType>;
     using InternalIteratorType = typename LineContainerType::const_iterator;
     InternalIteratorType m_Iterator;
     InternalIteratorType m_Begin;
@@ -376,7 +376,7 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
+    using LineContainerType = typename std::vector<LineType>;
     using InternalIteratorType = typename LineContainerType::const_iterator;
     void
     NextValidLine()
@@ -404,7 +404,7 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
-  using LineContainerType = typename std::deque<LineType>;
+  using LineContainerType = typename std::vector<LineType>;
 
   LineContainerType m_LineContainer{};
   LabelType         m_Label{};
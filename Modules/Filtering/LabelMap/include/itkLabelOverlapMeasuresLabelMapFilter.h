@@ -0,0 +1,291 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelOverlapMeasuresLabelMapFilter_h
+#define itkLabelOverlapMeasuresLabelMapFilter_h
+
+#include "itkLabelOverlapMeasures.h"
+#include "itkProcessObject.h"
+#include <vector>
+
+namespace itk
+{
+
+/** \class LabelOverlapMeasuresLabelMapFilter
+ * \brief Computes overlap measures between the same set of labels of
+ * two LabelMaps.
+ *
+ * The measures are those of LabelOverlapMeasuresImageFilter, computed on
+ * the lines of the label objects rather than on the pixels of label
+ * images: the lines of both LabelMaps are sorted, and each image line is
+ * swept once, counting the pixels of each pair of source and target labels
+ * by the length of the segments they share. The lines without any label
+ * object only hold background, and are counted all at once. The cost thus
+ * depends on the number of lines of the objects, not on the number of
+ * pixels of the image.
+ *
+ * The pixels outside of the label objects have the background value of
+ * their LabelMap, and the background value of the source LabelMap is
+ * excluded from the measures over all labels, as label 0 is by
+ * LabelOverlapMeasuresImageFilter. The two LabelMaps must have the same
+ * largest possible region, and the label objects of a LabelMap must not
+ * overlap.
+ *
+ * With a background value of 0, the measures are exactly those of
+ * LabelOverlapMeasuresImageFilter on the label images of the LabelMaps.
+ *
+ * \sa LabelOverlapMeasuresImageFilter, LabelImageToLabelMapFilter
+ *
+ * \ingroup ITKLabelMap
+ */
+template <typename TLabelMap>
+class ITK_TEMPLATE_EXPORT LabelOverlapMeasuresLabelMapFilter : public ProcessObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(LabelOverlapMeasuresLabelMapFilter);
+
+  /** Standard Self type alias */
+  using Self = LabelOverlapMeasuresLabelMapFilter;
+  using Superclass = ProcessObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(LabelOverlapMeasuresLabelMapFilter);
+
+  /** LabelMap related type alias. */
+  using LabelMapType = TLabelMap;
+  using LabelMapPointer = typename TLabelMap::Pointer;
+  using LabelMapConstPointer = typename TLabelMap::ConstPointer;
+  using LabelObjectType = typename TLabelMap::LabelObjectType;
+
+  using RegionType = typename TLabelMap::RegionType;
+  using SizeType = typename TLabelMap::SizeType;
+  using IndexType = typename TLabelMap::IndexType;
+
+  using LabelType = typename TLabelMap::LabelType;
+
+  /** Image related type alias. */
+  static constexpr unsigned int ImageDimension = TLabelMap::ImageDimension;
+
+  /** The measures are computed by LabelOverlapMeasures, as those of LabelOverlapMeasuresImageFilter. */
+  using LabelOverlapMeasuresType = LabelOverlapMeasures<LabelType>;
+  using RealType = typename LabelOverlapMeasuresType::RealType;
+  using LabelSetMeasures = typename LabelOverlapMeasuresType::LabelSetMeasures;
+  using MapType = typename LabelOverlapMeasuresType::MapType;
+  using MapIterator = typename MapType::iterator;
+  using MapConstIterator = typename MapType::const_iterator;
+
+  /** Set the label maps */
+  itkSetInputMacro(TargetLabelMap, LabelMapType);
+  itkGetInputMacro(TargetLabelMap, LabelMapType);
+  itkSetInputMacro(SourceLabelMap, LabelMapType);
+  itkGetInputMacro(SourceLabelMap, LabelMapType);
+
+  /** Compute the measures, the filter having no output. */
+  void
+  Update() override;
+
+  void
+  UpdateLargestPossibleRegion() override
+  {
+    this->Update();
+  }
+
+  /** Get the label set measures. */
+  MapType
+  GetLabelSetMeasures() const
+  {
+    return this->m_LabelSetMeasures;
+  }
+
+  // Overlap agreement metrics
+
+  /** Get the total overlap over all labels. */
+  RealType
+  GetTotalOverlap() const
+  {
+    return this->GetLabelOverlapMeasures().GetTotalOverlap();
+  }
+
+  /** Get the target overlap for the specified individual label. */
+  RealType
+  GetTargetOverlap(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetTargetOverlap(label);
+  }
+
+  /** Get the union overlap (Jaccard coefficient) over all labels. */
+  RealType
+  GetUnionOverlap() const
+  {
+    return this->GetLabelOverlapMeasures().GetUnionOverlap();
+  }
+  RealType
+  GetJaccardCoefficient() const
+  {
+    return this->GetUnionOverlap();
+  }
+
+  /** Get the union overlap (Jaccard coefficient) for the specified individual
+   * label. */
+  RealType
+  GetUnionOverlap(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetUnionOverlap(label);
+  }
+  RealType
+  GetJaccardCoefficient(LabelType label) const
+  {
+    return this->GetUnionOverlap(label);
+  }
+
+  /** Get the mean overlap (Dice coefficient) over all labels. */
+  RealType
+  GetMeanOverlap() const
+  {
+    return this->GetLabelOverlapMeasures().GetMeanOverlap();
+  }
+  RealType
+  GetDiceCoefficient() const
+  {
+    return this->GetMeanOverlap();
+  }
+
+  /** Get the mean overlap (Dice coefficient) for the specified individual
+   * label. */
+  RealType
+  GetMeanOverlap(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetMeanOverlap(label);
+  }
+  RealType
+  GetDiceCoefficient(LabelType label) const
+  {
+    return this->GetMeanOverlap(label);
+  }
+
+  /** Get the volume similarity over all labels. */
+  RealType
+  GetVolumeSimilarity() const
+  {
+    return this->GetLabelOverlapMeasures().GetVolumeSimilarity();
+  }
+
+  /** Get the volume similarity for the specified individual label. */
+  RealType
+  GetVolumeSimilarity(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetVolumeSimilarity(label);
+  }
+
+  // Overlap error metrics
+
+  /** Get the false negative error over all labels. */
+  RealType
+  GetFalseNegativeError() const
+  {
+    return this->GetLabelOverlapMeasures().GetFalseNegativeError();
+  }
+
+  /** Get the false negative error for the specified individual label. */
+  RealType
+  GetFalseNegativeError(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetFalseNegativeError(label);
+  }
+
+  /** Get the false positive error over all labels. */
+  RealType
+  GetFalsePositiveError() const
+  {
+    return this->GetLabelOverlapMeasures().GetFalsePositiveError();
+  }
+
+  /** Get the false positive error for the specified individual label. */
+  RealType
+  GetFalsePositiveError(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetFalsePositiveError(label);
+  }
+
+  /** Get the false discovery rate over all labels. */
+  RealType
+  GetFalseDiscoveryRate() const
+  {
+    return this->GetLabelOverlapMeasures().GetFalseDiscoveryRate();
+  }
+
+  /** Get the false discovery rate for the specified individual label. */
+  RealType
+  GetFalseDiscoveryRate(LabelType label) const
+  {
+    return this->GetLabelOverlapMeasures().GetFalseDiscoveryRate(label);
+  }
+
+protected:
+  LabelOverlapMeasuresLabelMapFilter();
+  ~LabelOverlapMeasuresLabelMapFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  VerifyInputInformation() const override;
+
+  void
+  GenerateData() override;
+
+private:
+  /** A line of a label object. */
+  struct Run
+  {
+    IndexType       m_Index;
+    OffsetValueType m_End;
+    LabelType       m_Label;
+  };
+  using RunVectorType = std::vector<Run>;
+
+  /** The lines of the label objects of a LabelMap, sorted line by line. */
+  static RunVectorType
+  GetSortedRuns(const LabelMapType * labelMap);
+
+  /** Whether the line of the first index is before the one of the second. */
+  static bool
+  IsLineBefore(const IndexType & index1, const IndexType & index2);
+
+  /** Count the pixels of a source label and a target label. */
+  void
+  AddPixels(LabelType sourceLabel, LabelType targetLabel, SizeValueType numberOfPixels);
+
+  /** The measures of the labels counted by the last update. */
+  LabelOverlapMeasuresType
+  GetLabelOverlapMeasures() const;
+
+  MapType m_LabelSetMeasures{};
+}; // end of class
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkLabelOverlapMeasuresLabelMapFilter.hxx"
+#endif
+
+#endif
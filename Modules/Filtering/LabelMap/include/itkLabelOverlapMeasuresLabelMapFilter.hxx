@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelOverlapMeasuresLabelMapFilter_hxx
+#define itkLabelOverlapMeasuresLabelMapFilter_hxx
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TLabelMap>
+LabelOverlapMeasuresLabelMapFilter<TLabelMap>::LabelOverlapMeasuresLabelMapFilter()
+{
+  Self::SetPrimaryInputName("SourceLabelMap");
+  Self::AddRequiredInputName("TargetLabelMap", 1);
+
+  // This filter requires two input label maps
+  this->SetNumberOfRequiredInputs(2);
+}
+
+template <typename TLabelMap>
+void
+LabelOverlapMeasuresLabelMapFilter<TLabelMap>::Update()
+{
+  this->UpdateOutputInformation();
+  this->UpdateOutputData(nullptr);
+}
+
+template <typename TLabelMap>
+void
+LabelOverlapMeasuresLabelMapFilter<TLabelMap>::VerifyInputInformation() const
+{
+  Superclass::VerifyInputInformation();
+
+  const RegionType & sourceRegion = this->GetSourceLabelMap()->GetLargestPossibleRegion();
+  const RegionType & targetRegion = this->GetTargetLabelMap()->GetLargestPossibleRegion();
+  if (sourceRegion != targetRegion)
+  {
+    itkExceptionMacro("The largest possible region of the source label map " << sourceRegion
+                                                                             << " and of the target label map "
+                                                                             << targetRegion << " differ.");
+  }
+}
+
+template <typename TLabelMap>
+bool
+LabelOverlapMeasuresLabelMapFilter<TLabelMap>::IsLineBefore(const IndexType & index1, const IndexType & index2)
+{
+  for (unsigned int i = ImageDimension - 1; i > 0; --i)
+  {
+    if (index1[i] != index2[i])
+    {
+      return index1[i] < index2[i];
+    }
+  }
+  return false;
+}
+
+template <typename TLabelMap>
+auto
+LabelOverlapMeasuresLabelMapFilter<TLabelMap>::GetSortedRuns(const LabelMapType * labelMap) -> RunVectorType
+{
+  RunVectorType runs;
+  for (typename LabelMapType::ConstIterator it(labelMap); !it.IsAtEnd(); ++it)
+  {
+    const LabelObjectType * labelObject = it.GetLabelObject();
+    for (SizeValueType i = 0; i < labelObject->GetNumberOfLines(); ++i)
+    {
+      const auto & line = labelObject->GetLine(i);
+      runs.push_back(
+        { line.GetIndex(), line.GetIndex()[0] + static_cast<OffsetValueType>(line.GetLength()), it.GetLabel() });
+    }
+  }
+
+  std::sort(runs.begin(), runs.end(), [](const Run & run1, const Run & run2) {
+    return IsLineBefore(run1.m_Index, run2.m_Index) ||
+           (!IsLineBefore(run2.m_Index, run1.m_Index) && run1.m_Index[0] < run2.m_Index[0]);
+  });
+  return runs;
+}
+
+template <typename TLabelMap>
+void
+LabelOverlapMeasuresLabelMapFilter<TLabelMap>::AddPixels(LabelType     sourceLabel,
+                                                         LabelType     targetLabel,
+                                                         SizeValueType numberOfPixels)
+{
+  // Initialized to empty if key does not already exist
+  auto & sValue = m_LabelSetMeasures[sourceLabel];
+  auto & tValue = m_LabelSetMeasures[targetLabel];
+
+  sValue.m_Source += numberOfPixels;
+  tValue.m_Target += numberOfPixels;
+
+  if (sourceLabel == targetLabel)
+  {
+    sValue.m_Intersection += numberOfPixels;
+    sValue.m_Union += numberOfPixels;
+  }
+  else
+  {
+    sValue.m_Union += numberOfPixels;
+    tValue.m_Union += numberOfPixels;
+
+    sValue.m_SourceComplement += numberOfPixels;
+    tValue.m_TargetComplement += numberOfPixels;
+  }
+}
+
+template <typename TLabelMap>
+void
+LabelOverlapMeasuresLabelMapFilter<TLabelMap>::GenerateData()
+{
+  const LabelMapType * source = this->GetSourceLabelMap();
+  const LabelMapType * target = this->GetTargetLabelMap();
+  const LabelType      sourceBackground = source->GetBackgroundValue();
+  const LabelType      targetBackground = target->GetBackgroundValue();
+
+  m_LabelSetMeasures.clear();
+
+  const RegionType &    region = source->GetLargestPossibleRegion();
+  const OffsetValueType lineBegin = region.GetIndex(0);
+  const OffsetValueType lineEnd = lineBegin + static_cast<OffsetValueType>(region.GetSize(0));
+
+  const RunVectorType sourceRuns = GetSortedRuns(source);
+  const RunVectorType targetRuns = GetSortedRuns(target);
+
+  // Sweep the lines holding runs of either label map, in order
+  SizeValueType numberOfLines = 0;
+  auto          sIt = sourceRuns.cbegin();
+  auto          tIt = targetRuns.cbegin();
+  while (sIt != sourceRuns.cend() || tIt != targetRuns.cend())
+  {
+    IndexType line =
+      (tIt == targetRuns.cend() || (sIt != sourceRuns.cend() && !IsLineBefore(tIt->m_Index, sIt->m_Index)))
+        ? sIt->m_Index
+        : tIt->m_Index;
+    line[0] = lineBegin;
+    const auto isOnLine = [&line](const Run & run) {
+      return !IsLineBefore(run.m_Index, line) && !IsLineBefore(line, run.m_Index);
+    };
+    const auto sLineEnd = std::find_if_not(sIt, sourceRuns.cend(), isOnLine);
+    const auto tLineEnd = std::find_if_not(tIt, targetRuns.cend(), isOnLine);
+
+    if (region.IsInside(line))
+    {
+      ++numberOfLines;
+
+      // Split the line in segments of the same source and target labels
+      OffsetValueType x = lineBegin;
+      while (x < lineEnd)
+      {
+        while (sIt != sLineEnd && sIt->m_End <= x)
+        {
+          ++sIt;
+        }
+        while (tIt != tLineEnd && tIt->m_End <= x)
+        {
+          ++tIt;
+        }
+
+        OffsetValueType next = lineEnd;
+        LabelType       sourceLabel = sourceBackground;
+        if (sIt != sLineEnd)
+        {
+          if (sIt->m_Index[0] <= x)
+          {
+            sourceLabel = sIt->m_Label;
+            next = std::min(next, sIt->m_End);
+          }
+          else
+          {
+            next = std::min(next, sIt->m_Index[0]);
+          }
+        }
+        LabelType targetLabel = targetBackground;
+        if (tIt != tLineEnd)
+        {
+          if (tIt->m_Index[0] <= x)
+          {
+            targetLabel = tIt->m_Label;
+            next = std::min(next, tIt->m_End);
+          }
+          else
+          {
+            next = std::min(next, tIt->m_Index[0]);
+          }
+        }
+
+        this->AddPixels(sourceLabel, targetLabel, static_cast<SizeValueType>(next - x));
+        x = next;
+      }
+    }
+    sIt = sLineEnd;
+    tIt = tLineEnd;
+  }
+
+  // The other lines only hold background
+  const SizeValueType numberOfBackgroundPixels = region.GetNumberOfPixels() - numberOfLines * region.GetSize(0);
+  if (numberOfBackgroundPixels > 0)
+  {
+    this->AddPixels(sourceBackground, targetBackground, numberOfBackgroundPixels);
+  }
+}
+
+template <typename TLabelMap>
+auto
+LabelOverlapMeasuresLabelMapFilter<TLabelMap>::GetLabelOverlapMeasures() const -> LabelOverlapMeasuresType
+{
+  const LabelMapType * sourceLabelMap = this->GetSourceLabelMap();
+  if (sourceLabelMap == nullptr)
+  {
+    return LabelOverlapMeasuresType(this->m_LabelSetMeasures, LabelType{}, 0);
+  }
+  return LabelOverlapMeasuresType(this->m_LabelSetMeasures,
+                                  sourceLabelMap->GetBackgroundValue(),
+                                  sourceLabelMap->GetLargestPossibleRegion().GetNumberOfPixels());
+}
+
+template <typename TLabelMap>
+void
+LabelOverlapMeasuresLabelMapFilter<TLabelMap>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of labels: " << this->m_LabelSetMeasures.size() << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -30,15 +30,21 @@ namespace itk
  * ShapeLabelMapFilter can be used to set the attributes values of the
  * ShapeLabelObject in a LabelMap.
  *
- * ShapeLabelMapFilter takes an optional parameter, used only to
- * optimize the computation time and the memory usage when the
- * perimeter or the feret diameter is used: the exact copy of the
- * input LabelMap is stored in an Image.
- * It can be set with SetLabelImage(). It is cleared at the end of the
- * computation, so must be reset before running Update() again. It is
- * not part of the pipeline management design, to let the subclasses
- * of ShapeLabelMapFilter use the pipeline design to specify truly
- * required inputs.
+ * ShapeLabelMapFilter takes an optional parameter, the exact copy of
+ * the input LabelMap stored in an Image, which can be set with
+ * SetLabelImage(). It is cleared at the end of the computation. It is
+ * kept for backward compatibility only: none of the attributes need it
+ * anymore, as the Feret diameter is now computed directly from the
+ * lines of the label objects.
+ *
+ * The Feret diameter is reached between two vertices of the convex
+ * hull of the object. The candidate pixels, which are at an end of the
+ * object along every axis, are reduced to the vertices of the convex
+ * hulls of their 2D slices. In 2D, the diameter is then found by
+ * rotating calipers around the hull, in linear time. In 3D and above,
+ * all the pairs of the remaining candidates are compared, which is
+ * quadratic in their number, but that number is far lower than the
+ * number of border pixels.
  *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
@@ -101,7 +107,7 @@ public:
 
   /**
    * Set/Get whether the maximum Feret diameter should be computed or not.
-   * Default value is false because of the high computation time required.
+   * Default value is false.
    */
   itkSetMacro(ComputeFeretDiameter, bool);
   itkGetConstReferenceMacro(ComputeFeretDiameter, bool);
@@ -138,9 +144,6 @@ protected:
   void
   ThreadedProcessLabelObject(LabelObjectType * labelObject) override;
 
-  void
-  BeforeThreadedGenerateData() override;
-
   void
   AfterThreadedGenerateData() override;
 
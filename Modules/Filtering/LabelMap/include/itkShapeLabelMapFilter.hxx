@@ -29,8 +29,10 @@
 #include "vnl/algo/vnl_symmetric_eigensystem.h"
 #include "itkMath.h"
 #include "itkLexicographicCompare.h"
+#include <algorithm>
 #include <deque>
 #include <map>
+#include <vector>
 
 namespace itk
 {
@@ -42,29 +44,6 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ShapeLabelMapFilter()
   m_ComputeOrientedBoundingBox = false;
 }
 
-template <typename TImage, typename TLabelImage>
-void
-ShapeLabelMapFilter<TImage, TLabelImage>::BeforeThreadedGenerateData()
-{
-  Superclass::BeforeThreadedGenerateData();
-
-  // Generate the label image, if needed
-  if (m_ComputeFeretDiameter)
-  {
-    if (!m_LabelImage)
-    {
-      // generate an image of the labelized image
-      using LCI2IType = LabelMapToLabelImageFilter<TImage, LabelImageType>;
-      auto lci2i = LCI2IType::New();
-      lci2i->SetInput(this->GetOutput());
-      // Respect the number of threads of the filter
-      lci2i->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-      lci2i->Update();
-      m_LabelImage = lci2i->GetOutput();
-    }
-  }
-}
-
 template <typename TImage, typename TLabelImage>
 void
 ShapeLabelMapFilter<TImage, TLabelImage>::ThreadedProcessLabelObject(LabelObjectType * labelObject)
@@ -424,62 +403,233 @@ template <typename TImage, typename TLabelImage>
 void
 ShapeLabelMapFilter<TImage, TLabelImage>::ComputeFeretDiameter(LabelObjectType * labelObject)
 {
-  const LabelPixelType & label = labelObject->GetLabel();
+  // The largest distance between two pixels of the object is reached between two vertices of its convex
+  // hull. A pixel lying strictly between two pixels of the object along one of the axes can't be a vertex,
+  // so only the pixels which are at an end of the object along every axis are kept as candidates.
+  const RegionType & boundingBox = labelObject->GetBoundingBox();
+  const IndexType &  boundingBoxIndex = boundingBox.GetIndex();
+  const SizeType &   boundingBoxSize = boundingBox.GetSize();
+
+  // For each axis, the first and last index of the object along that axis, for each position of the
+  // bounding box projected along that axis. The axis 0 is always the fastest varying one in the projection
+  // of the other axes.
+  using ProjectionType = std::vector<IndexValueType>;
+  using StrideType = FixedArray<OffsetValueType, ImageDimension>;
+  FixedArray<ProjectionType, ImageDimension> minimums;
+  FixedArray<ProjectionType, ImageDimension> maximums;
+  FixedArray<StrideType, ImageDimension>     strides;
+  for (unsigned int axis = 0; axis < ImageDimension; ++axis)
+  {
+    OffsetValueType projectionSize = 1;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      strides[axis][i] = 0;
+      if (i != axis)
+      {
+        strides[axis][i] = projectionSize;
+        projectionSize *= boundingBoxSize[i];
+      }
+    }
+    minimums[axis].assign(projectionSize, NumericTraits<IndexValueType>::max());
+    maximums[axis].assign(projectionSize, NumericTraits<IndexValueType>::NonpositiveMin());
+  }
 
-  using IndexListType = typename std::deque<IndexType>;
-  IndexListType idxList;
+  const auto projectionOffset = [&boundingBoxIndex, &strides](const IndexType & idx, unsigned int axis) {
+    OffsetValueType offset = 0;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      offset += (idx[i] - boundingBoxIndex[i]) * strides[axis][i];
+    }
+    return offset;
+  };
 
-  using NeighborIteratorType = typename itk::ConstNeighborhoodIterator<LabelImageType>;
-  auto                                      neighborHoodRadius = SizeType::Filled(1);
-  NeighborIteratorType                      it(neighborHoodRadius, m_LabelImage, m_LabelImage->GetBufferedRegion());
-  ConstantBoundaryCondition<LabelImageType> lcbc;
-  // Use label + 1 to have a label different of the current label on the border
-  lcbc.SetConstant(label + 1);
-  it.OverrideBoundaryCondition(&lcbc);
-  it.GoToBegin();
+  using LengthType = typename LabelObjectType::LengthType;
+
+  typename LabelObjectType::ConstLineIterator lit(labelObject);
+  for (; !lit.IsAtEnd(); ++lit)
+  {
+    const IndexType & idx = lit.GetLine().GetIndex();
+    const LengthType  length = lit.GetLine().GetLength();
+    if (length == 0)
+    {
+      continue;
+    }
+
+    const OffsetValueType rowOffset = projectionOffset(idx, 0);
+    minimums[0][rowOffset] = std::min(minimums[0][rowOffset], idx[0]);
+    maximums[0][rowOffset] = std::max(maximums[0][rowOffset], idx[0] + static_cast<IndexValueType>(length) - 1);
 
-  using NeighborIndexType = typename NeighborIteratorType::NeighborIndexType;
+    for (unsigned int axis = 1; axis < ImageDimension; ++axis)
+    {
+      const OffsetValueType lineOffset = projectionOffset(idx, axis);
+      for (OffsetValueType i = lineOffset; i < lineOffset + static_cast<OffsetValueType>(length); ++i)
+      {
+        minimums[axis][i] = std::min(minimums[axis][i], idx[axis]);
+        maximums[axis][i] = std::max(maximums[axis][i], idx[axis]);
+      }
+    }
+  }
 
-  // Iterate over all the indexes
-  typename LabelObjectType::ConstIndexIterator iit(labelObject);
-  while (!iit.IsAtEnd())
+  // Only the ends of the lines can be at an end of the object along the axis 0
+  std::vector<IndexType> candidates;
+  for (lit.GoToBegin(); !lit.IsAtEnd(); ++lit)
   {
-    // Move the iterator to the new location
-    it += iit.GetIndex() - it.GetIndex();
+    const LengthType length = lit.GetLine().GetLength();
+    if (length == 0)
+    {
+      continue;
+    }
 
-    // Push the pixel in the list if it is on the border of the object
-    for (NeighborIndexType i = 0; i < it.Size(); ++i)
+    IndexType            idx = lit.GetLine().GetIndex();
+    const IndexValueType lineEnd = idx[0] + static_cast<IndexValueType>(length) - 1;
+    for (;;)
     {
-      if (it.GetPixel(i) != label)
+      bool isCandidate = true;
+      for (unsigned int axis = 0; axis < ImageDimension && isCandidate; ++axis)
+      {
+        const OffsetValueType offset = projectionOffset(idx, axis);
+        isCandidate = idx[axis] == minimums[axis][offset] || idx[axis] == maximums[axis][offset];
+      }
+      if (isCandidate)
+      {
+        candidates.push_back(idx);
+      }
+      if (idx[0] == lineEnd)
       {
-        idxList.push_back(iit.GetIndex());
         break;
       }
+      idx[0] = lineEnd;
     }
-    ++iit;
   }
 
-  ImageType * output = this->GetOutput();
+  // Twice the signed area of the triangle (o, a, b) projected on the plane of two axes, positive when the
+  // triangle is counterclockwise. It is computed on the indices, so exactly.
+  const auto cross = [](const IndexType & o, const IndexType & a, const IndexType & b, unsigned int axis1,
+                        unsigned int axis2) {
+    return (a[axis1] - o[axis1]) * (b[axis2] - o[axis2]) - (a[axis2] - o[axis2]) * (b[axis1] - o[axis1]);
+  };
+
+  // A vertex of the convex hull of the object is also a vertex of the convex hull of the pixels of its 2D
+  // slice, for any two axes. For each pair of axes, the candidates are sorted by slice, and reduced to the
+  // vertices of the convex hull of each slice with Andrew's monotone chain, in counterclockwise order.
+  std::vector<IndexType> vertices;
+  for (unsigned int axis1 = 0; axis1 + 1 < ImageDimension; ++axis1)
+  {
+    for (unsigned int axis2 = axis1 + 1; axis2 < ImageDimension; ++axis2)
+    {
+      const auto inSameSlice = [axis1, axis2](const IndexType & a, const IndexType & b) {
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+          if (i != axis1 && i != axis2 && a[i] != b[i])
+          {
+            return false;
+          }
+        }
+        return true;
+      };
+      std::sort(candidates.begin(), candidates.end(), [axis1, axis2](const IndexType & a, const IndexType & b) {
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+          if (i != axis1 && i != axis2 && a[i] != b[i])
+          {
+            return a[i] < b[i];
+          }
+        }
+        return a[axis1] < b[axis1] || (a[axis1] == b[axis1] && a[axis2] < b[axis2]);
+      });
 
-  const typename ImageType::SpacingType & spacing = output->GetSpacing();
+      vertices.clear();
+      for (auto first = candidates.cbegin(); first != candidates.cend();)
+      {
+        auto last = first + 1;
+        while (last != candidates.cend() && inSameSlice(*first, *last))
+        {
+          ++last;
+        }
+        if (last - first <= 2)
+        {
+          vertices.insert(vertices.end(), first, last);
+          first = last;
+          continue;
+        }
 
-  // We can now search the feret diameter
+        // The lower hull, then the upper hull, which ends with the first pixel again
+        const size_t lowerHullBegin = vertices.size() + 2;
+        for (auto it = first; it != last; ++it)
+        {
+          while (vertices.size() >= lowerHullBegin &&
+                 cross(vertices[vertices.size() - 2], vertices.back(), *it, axis1, axis2) <= 0)
+          {
+            vertices.pop_back();
+          }
+          vertices.push_back(*it);
+        }
+        const size_t upperHullBegin = vertices.size() + 1;
+        for (auto it = last - 1; it != first;)
+        {
+          --it;
+          while (vertices.size() >= upperHullBegin &&
+                 cross(vertices[vertices.size() - 2], vertices.back(), *it, axis1, axis2) <= 0)
+          {
+            vertices.pop_back();
+          }
+          vertices.push_back(*it);
+        }
+        vertices.pop_back();
+        first = last;
+      }
+      candidates.swap(vertices);
+    }
+  }
+
+  const typename ImageType::SpacingType & spacing = this->GetOutput()->GetSpacing();
+  const auto squaredDistance = [&spacing](const IndexType & a, const IndexType & b) {
+    double squaredLength = 0.0;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      squaredLength += Math::sqr((a[i] - b[i]) * spacing[i]);
+    }
+    return squaredLength;
+  };
+
+  // We can now search the feret diameter. It is reached between two antipodal vertices, and antipodal
+  // vertices in the index space are also antipodal in the physical space, as the spacing only scales the
+  // axes.
   double feretDiameter = 0;
-  for (typename IndexListType::const_iterator iIt1 = idxList.begin(); iIt1 != idxList.end(); ++iIt1)
+  bool   compareAllPairs = true;
+  if constexpr (ImageDimension == 2)
   {
-    auto iIt2 = iIt1;
-    for (iIt2++; iIt2 != idxList.end(); ++iIt2)
+    // Rotating calipers: the vertex farthest from an edge of the convex hull moves forward with the edge,
+    // so that all the antipodal pairs are visited in linear time.
+    const size_t numberOfVertices = candidates.size();
+    if (numberOfVertices > 3)
     {
-      // Compute the length between the 2 indexes
-      double length = 0;
-      for (unsigned int i = 0; i < ImageDimension; ++i)
+      compareAllPairs = false;
+      size_t farthest = 1;
+      for (size_t i = 0; i < numberOfVertices; ++i)
       {
-        const OffsetValueType indexDifference = (iIt1->operator[](i) - iIt2->operator[](i));
-        length += std::pow(indexDifference * spacing[i], 2);
+        const IndexType & edgeBegin = candidates[i];
+        const IndexType & edgeEnd = candidates[(i + 1) % numberOfVertices];
+        while (cross(edgeBegin, edgeEnd, candidates[(farthest + 1) % numberOfVertices], 0, 1) >
+               cross(edgeBegin, edgeEnd, candidates[farthest], 0, 1))
+        {
+          farthest = (farthest + 1) % numberOfVertices;
+        }
+        feretDiameter = std::max({ feretDiameter,
+                                   squaredDistance(edgeBegin, candidates[farthest]),
+                                   squaredDistance(edgeEnd, candidates[farthest]) });
       }
-      if (feretDiameter < length)
+    }
+  }
+  if (compareAllPairs)
+  {
+    // In 3D and above, or with less than four vertices, all the pairs of the remaining candidates are
+    // compared.
+    for (auto it1 = candidates.cbegin(); it1 != candidates.cend(); ++it1)
+    {
+      for (auto it2 = it1 + 1; it2 != candidates.cend(); ++it2)
       {
-        feretDiameter = length;
+        feretDiameter = std::max(feretDiameter, squaredDistance(*it1, *it2));
       }
     }
   }
@@ -11,6 +11,7 @@ itk_module(
   ENABLE_SHARED
   DEPENDS
   ITKImageLabel
+  ITKImageStatistics
   PRIVATE_DEPENDS
   ITKStatistics
   COMPILE_DEPENDS
@@ -0,0 +1,72 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkLabelMapToBinaryImageFilter.h"
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using LabelImageType = itk::Image<unsigned short, Dimension>;
+using BinaryImageType = itk::Image<unsigned char, Dimension>;
+using LabelMapType = itk::LabelMap<itk::LabelObject<unsigned short, Dimension>>;
+using ToLabelMapType = itk::LabelImageToLabelMapFilter<LabelImageType, LabelMapType>;
+using ToBinaryImageType = itk::LabelMapToBinaryImageFilter<LabelMapType, BinaryImageType>;
+} // namespace
+
+
+// Thresholding the labels of the objects gives the binary threshold of the label image.
+TEST(LabelMapToBinaryImageFilter, Thresholds)
+{
+  auto labelImage = LabelImageType::New();
+  labelImage->SetRegions(LabelImageType::RegionType(itk::MakeIndex(2, -4), itk::MakeSize(37, 29)));
+  labelImage->Allocate();
+  itk::ImageRegionIteratorWithIndex<LabelImageType> it(labelImage, labelImage->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const auto value = (it.GetIndex()[0] * 3 + it.GetIndex()[1] * 5) % 19;
+    it.Set(value < 12 ? static_cast<unsigned short>(1 + value / 2) : 0);
+  }
+
+  auto toLabelMap = ToLabelMapType::New();
+  toLabelMap->SetInput(labelImage);
+  toLabelMap->SetBackgroundValue(0);
+
+  auto filter = ToBinaryImageType::New();
+  filter->SetInput(toLabelMap->GetOutput());
+  filter->SetForegroundValue(255);
+  filter->SetBackgroundValue(0);
+  EXPECT_EQ(filter->GetLowerThreshold(), 0);
+  EXPECT_EQ(filter->GetUpperThreshold(), itk::NumericTraits<unsigned short>::max());
+
+  filter->SetLowerThreshold(2);
+  filter->SetUpperThreshold(4);
+  filter->Update();
+
+  itk::ImageRegionConstIteratorWithIndex<LabelImageType> lIt(labelImage, labelImage->GetBufferedRegion());
+  for (; !lIt.IsAtEnd(); ++lIt)
+  {
+    const bool inside = lIt.Get() >= 2 && lIt.Get() <= 4;
+    ASSERT_EQ(filter->GetOutput()->GetPixel(lIt.GetIndex()), inside ? 255 : 0) << "at index " << lIt.GetIndex();
+  }
+}
@@ -0,0 +1,121 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkLabelMapToLabelImageFilter.h"
+#include "itkStreamingImageFilter.h"
+
+namespace
+{
+
+class LabelMapToLabelImageFixture : public ::testing::Test
+{
+protected:
+  static constexpr unsigned int Dimension = 3;
+  using LabelImageType = itk::Image<unsigned short, Dimension>;
+  using LabelMapType = itk::LabelMap<itk::LabelObject<unsigned short, Dimension>>;
+  using ToLabelMapType = itk::LabelImageToLabelMapFilter<LabelImageType, LabelMapType>;
+  using ToLabelImageType = itk::LabelMapToLabelImageFilter<LabelMapType, LabelImageType>;
+
+  void
+  SetUp() override
+  {
+    m_LabelImage = LabelImageType::New();
+    m_LabelImage->SetRegions(LabelImageType::RegionType(itk::MakeIndex(-3, 2, 5), itk::MakeSize(31, 17, 13)));
+    m_LabelImage->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<LabelImageType> it(m_LabelImage, m_LabelImage->GetBufferedRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const auto & idx = it.GetIndex();
+      // mostly background, with runs of a few labels
+      const auto value = (idx[0] * 3 + idx[1] * 5 + idx[2] * 7) % 23;
+      it.Set(value < 8 ? static_cast<unsigned short>(1 + value / 3) : 0);
+    }
+
+    auto toLabelMap = ToLabelMapType::New();
+    toLabelMap->SetInput(m_LabelImage);
+    toLabelMap->SetBackgroundValue(0);
+    toLabelMap->Update();
+    m_LabelMap = toLabelMap->GetOutput();
+  }
+
+  void
+  ExpectSameAsLabelImage(const LabelImageType * image, const LabelImageType::RegionType & region) const
+  {
+    ASSERT_TRUE(image->GetBufferedRegion().IsInside(region));
+    itk::ImageRegionConstIteratorWithIndex<LabelImageType> it(m_LabelImage, region);
+    for (; !it.IsAtEnd(); ++it)
+    {
+      ASSERT_EQ(it.Get(), image->GetPixel(it.GetIndex())) << "at index " << it.GetIndex();
+    }
+  }
+
+  LabelImageType::Pointer m_LabelImage;
+  LabelMapType::Pointer   m_LabelMap;
+};
+
+} // namespace
+
+
+TEST_F(LabelMapToLabelImageFixture, LargestPossibleRegion)
+{
+  auto filter = ToLabelImageType::New();
+  filter->SetInput(m_LabelMap);
+  filter->Update();
+
+  EXPECT_EQ(m_LabelImage->GetLargestPossibleRegion(), filter->GetOutput()->GetBufferedRegion());
+  this->ExpectSameAsLabelImage(filter->GetOutput(), m_LabelImage->GetLargestPossibleRegion());
+}
+
+
+TEST_F(LabelMapToLabelImageFixture, RequestedRegionOnly)
+{
+  auto filter = ToLabelImageType::New();
+  filter->SetInput(m_LabelMap);
+
+  const LabelImageType::RegionType region(itk::MakeIndex(4, 6, 9), itk::MakeSize(11, 5, 3));
+  filter->UpdateOutputInformation();
+  filter->GetOutput()->SetRequestedRegion(region);
+  filter->Update();
+
+  EXPECT_EQ(region, filter->GetOutput()->GetBufferedRegion());
+  this->ExpectSameAsLabelImage(filter->GetOutput(), region);
+}
+
+
+TEST_F(LabelMapToLabelImageFixture, Streamed)
+{
+  auto filter = ToLabelImageType::New();
+  filter->SetInput(m_LabelMap);
+
+  using StreamingFilterType = itk::StreamingImageFilter<LabelImageType, LabelImageType>;
+  auto streamer = StreamingFilterType::New();
+  streamer->SetInput(filter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(5);
+  streamer->Update();
+
+  // each streamed chunk is generated on its own
+  EXPECT_NE(m_LabelImage->GetLargestPossibleRegion(), filter->GetOutput()->GetBufferedRegion());
+  this->ExpectSameAsLabelImage(streamer->GetOutput(), m_LabelImage->GetLargestPossibleRegion());
+}
@@ -0,0 +1,168 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkLabelOverlapMeasuresImageFilter.h"
+#include "itkLabelOverlapMeasuresLabelMapFilter.h"
+
+namespace
+{
+
+class LabelOverlapMeasuresLabelMapFixture : public ::testing::Test
+{
+protected:
+  static constexpr unsigned int Dimension = 3;
+  using LabelImageType = itk::Image<unsigned short, Dimension>;
+  using LabelMapType = itk::LabelMap<itk::LabelObject<unsigned short, Dimension>>;
+  using ToLabelMapType = itk::LabelImageToLabelMapFilter<LabelImageType, LabelMapType>;
+  using ImageFilterType = itk::LabelOverlapMeasuresImageFilter<LabelImageType>;
+  using LabelMapFilterType = itk::LabelOverlapMeasuresLabelMapFilter<LabelMapType>;
+
+  void
+  SetUp() override
+  {
+    // the labels differ by a shift, and the target has a label of its own
+    m_SourceImage = CreateLabelImage(0, 0);
+    m_TargetImage = CreateLabelImage(2, 9);
+  }
+
+  static LabelImageType::Pointer
+  CreateLabelImage(int shift, unsigned short extraLabel)
+  {
+    auto image = LabelImageType::New();
+    image->SetRegions(LabelImageType::RegionType(itk::MakeIndex(-3, 2, 5), itk::MakeSize(31, 17, 13)));
+    image->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<LabelImageType> it(image, image->GetBufferedRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const auto & idx = it.GetIndex();
+      // background slices, and runs of a few labels
+      const auto value = ((idx[0] + shift) * 3 + idx[1] * 5 + idx[2] * 7) % 23;
+      unsigned short label = (value < 8 && idx[2] % 4 != 0) ? static_cast<unsigned short>(1 + value / 3) : 0;
+      if (extraLabel && idx[0] > 20 && idx[1] == 4)
+      {
+        label = extraLabel;
+      }
+      it.Set(label);
+    }
+    return image;
+  }
+
+  static LabelMapType::Pointer
+  ToLabelMap(const LabelImageType * image)
+  {
+    auto toLabelMap = ToLabelMapType::New();
+    toLabelMap->SetInput(image);
+    toLabelMap->SetBackgroundValue(0);
+    toLabelMap->Update();
+    return toLabelMap->GetOutput();
+  }
+
+  LabelImageType::Pointer m_SourceImage;
+  LabelImageType::Pointer m_TargetImage;
+};
+
+} // namespace
+
+
+TEST_F(LabelOverlapMeasuresLabelMapFixture, SameAsImageFilter)
+{
+  auto imageFilter = ImageFilterType::New();
+  imageFilter->SetSourceImage(m_SourceImage);
+  imageFilter->SetTargetImage(m_TargetImage);
+  imageFilter->Update();
+
+  auto labelMapFilter = LabelMapFilterType::New();
+  labelMapFilter->SetSourceLabelMap(ToLabelMap(m_SourceImage));
+  labelMapFilter->SetTargetLabelMap(ToLabelMap(m_TargetImage));
+  labelMapFilter->Update();
+
+  const ImageFilterType::MapType    expected = imageFilter->GetLabelSetMeasures();
+  const LabelMapFilterType::MapType measures = labelMapFilter->GetLabelSetMeasures();
+  ASSERT_EQ(expected.size(), measures.size());
+  for (const auto & labelSetMeasures : expected)
+  {
+    const auto it = measures.find(labelSetMeasures.first);
+    ASSERT_NE(it, measures.end()) << "label " << labelSetMeasures.first;
+    EXPECT_EQ(labelSetMeasures.second.m_Source, it->second.m_Source);
+    EXPECT_EQ(labelSetMeasures.second.m_Target, it->second.m_Target);
+    EXPECT_EQ(labelSetMeasures.second.m_Union, it->second.m_Union);
+    EXPECT_EQ(labelSetMeasures.second.m_Intersection, it->second.m_Intersection);
+    EXPECT_EQ(labelSetMeasures.second.m_SourceComplement, it->second.m_SourceComplement);
+    EXPECT_EQ(labelSetMeasures.second.m_TargetComplement, it->second.m_TargetComplement);
+
+    const unsigned short label = labelSetMeasures.first;
+    if (labelSetMeasures.second.m_Source > 0)
+    {
+      EXPECT_DOUBLE_EQ(imageFilter->GetFalsePositiveError(label), labelMapFilter->GetFalsePositiveError(label));
+      EXPECT_DOUBLE_EQ(imageFilter->GetVolumeSimilarity(label), labelMapFilter->GetVolumeSimilarity(label));
+    }
+    EXPECT_DOUBLE_EQ(imageFilter->GetTargetOverlap(label), labelMapFilter->GetTargetOverlap(label));
+    EXPECT_DOUBLE_EQ(imageFilter->GetUnionOverlap(label), labelMapFilter->GetUnionOverlap(label));
+    EXPECT_DOUBLE_EQ(imageFilter->GetDiceCoefficient(label), labelMapFilter->GetDiceCoefficient(label));
+    EXPECT_DOUBLE_EQ(imageFilter->GetFalseNegativeError(label), labelMapFilter->GetFalseNegativeError(label));
+    EXPECT_DOUBLE_EQ(imageFilter->GetFalseDiscoveryRate(label), labelMapFilter->GetFalseDiscoveryRate(label));
+  }
+
+  EXPECT_DOUBLE_EQ(imageFilter->GetTotalOverlap(), labelMapFilter->GetTotalOverlap());
+  EXPECT_DOUBLE_EQ(imageFilter->GetUnionOverlap(), labelMapFilter->GetUnionOverlap());
+  EXPECT_DOUBLE_EQ(imageFilter->GetMeanOverlap(), labelMapFilter->GetMeanOverlap());
+  EXPECT_DOUBLE_EQ(imageFilter->GetVolumeSimilarity(), labelMapFilter->GetVolumeSimilarity());
+  EXPECT_DOUBLE_EQ(imageFilter->GetFalseNegativeError(), labelMapFilter->GetFalseNegativeError());
+  EXPECT_DOUBLE_EQ(imageFilter->GetFalsePositiveError(), labelMapFilter->GetFalsePositiveError());
+  EXPECT_DOUBLE_EQ(imageFilter->GetFalseDiscoveryRate(), labelMapFilter->GetFalseDiscoveryRate());
+}
+
+
+TEST_F(LabelOverlapMeasuresLabelMapFixture, SameLabelMap)
+{
+  const LabelMapType::Pointer labelMap = ToLabelMap(m_SourceImage);
+
+  auto labelMapFilter = LabelMapFilterType::New();
+  labelMapFilter->SetSourceLabelMap(labelMap);
+  labelMapFilter->SetTargetLabelMap(labelMap);
+  labelMapFilter->Update();
+
+  EXPECT_EQ(labelMapFilter->GetLabelSetMeasures().size(), labelMap->GetNumberOfLabelObjects() + 1);
+  EXPECT_DOUBLE_EQ(labelMapFilter->GetDiceCoefficient(), 1.0);
+  EXPECT_DOUBLE_EQ(labelMapFilter->GetJaccardCoefficient(), 1.0);
+  EXPECT_DOUBLE_EQ(labelMapFilter->GetVolumeSimilarity(), 0.0);
+  EXPECT_DOUBLE_EQ(labelMapFilter->GetFalseNegativeError(), 0.0);
+  EXPECT_DOUBLE_EQ(labelMapFilter->GetFalsePositiveError(), 0.0);
+
+  // a label missing from both label maps
+  EXPECT_DOUBLE_EQ(labelMapFilter->GetTargetOverlap(100), 0.0);
+}
+
+
+TEST_F(LabelOverlapMeasuresLabelMapFixture, DifferentRegions)
+{
+  auto targetImage = LabelImageType::New();
+  targetImage->SetRegions(itk::MakeSize(4, 4, 4));
+  targetImage->AllocateInitialized();
+
+  auto labelMapFilter = LabelMapFilterType::New();
+  labelMapFilter->SetSourceLabelMap(ToLabelMap(m_SourceImage));
+  labelMapFilter->SetTargetLabelMap(ToLabelMap(targetImage));
+  EXPECT_THROW(labelMapFilter->Update(), itk::ExceptionObject);
+}
@@ -19,8 +19,10 @@
 #include "itkGTest.h"
 
 #include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkLabelImageToShapeLabelMapFilter.h"
 #include "itkTestingMacros.h"
+#include <chrono>
 
 
 namespace Math = itk::Math;
@@ -541,3 +543,192 @@ TEST_F(ShapeLabelMapFixture, 2D_T2x4)
     labelObject->Print(std::cout);
   }
 }
+
+TEST_F(ShapeLabelMapFixture, 3D_FeretDiameterMatchesBruteForce)
+{
+  using Utils = FixtureUtilities<3>;
+
+  Utils::ImageType::Pointer image(Utils::CreateImage());
+  image->SetSpacing(itk::MakeVector(1.0, 0.5, 2.0));
+
+  // A non-convex object: a ball with a tilted arm and a hole
+  std::vector<Utils::ImageType::IndexType> indices;
+  for (itk::IndexValueType k = 0; k < 25; ++k)
+  {
+    for (itk::IndexValueType j = 0; j < 25; ++j)
+    {
+      for (itk::IndexValueType i = 0; i < 25; ++i)
+      {
+        const auto ball = (i - 10) * (i - 10) + (j - 12) * (j - 12) + (k - 9) * (k - 9);
+        const bool inBall = ball <= 36 && ball > 4;
+        const bool inArm = i > 10 && i < 24 && std::abs(j - i / 2 - 6) <= 1 && std::abs(k - 2 * i / 3) <= 1;
+        if (inBall || inArm)
+        {
+          const auto idx = itk::MakeIndex(i, j, k);
+          image->SetPixel(idx, 1);
+          indices.push_back(idx);
+        }
+      }
+    }
+  }
+
+  double expected = 0.0;
+  for (auto it1 = indices.cbegin(); it1 != indices.cend(); ++it1)
+  {
+    for (auto it2 = it1 + 1; it2 != indices.cend(); ++it2)
+    {
+      double length = 0.0;
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        length += itk::Math::sqr(((*it1)[d] - (*it2)[d]) * image->GetSpacing()[d]);
+      }
+      expected = std::max(expected, length);
+    }
+  }
+  expected = std::sqrt(expected);
+
+  Utils::LabelObjectType::ConstPointer labelObject = Utils::ComputeLabelObject(image);
+
+  EXPECT_NEAR(expected, labelObject->GetFeretDiameter(), 1e-10);
+}
+
+namespace
+{
+// The Feret diameter computed by comparing all the pairs of border pixels of the object, those with a face
+// neighbor outside of it, as ShapeLabelMapFilter used to.
+template <typename TImage>
+double
+ComputeBorderFeretDiameter(const TImage * image)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+  using IndexType = typename TImage::IndexType;
+
+  const typename TImage::RegionType region = image->GetLargestPossibleRegion();
+  std::vector<IndexType>            border;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() == 0)
+    {
+      continue;
+    }
+    bool isBorder = false;
+    for (unsigned int d = 0; d < Dimension && !isBorder; ++d)
+    {
+      for (const int step : { -1, 1 })
+      {
+        IndexType neighbor = it.GetIndex();
+        neighbor[d] += step;
+        isBorder = isBorder || !region.IsInside(neighbor) || image->GetPixel(neighbor) == 0;
+      }
+    }
+    if (isBorder)
+    {
+      border.push_back(it.GetIndex());
+    }
+  }
+
+  double feretDiameter = 0.0;
+  for (auto it1 = border.cbegin(); it1 != border.cend(); ++it1)
+  {
+    for (auto it2 = it1 + 1; it2 != border.cend(); ++it2)
+    {
+      double length = 0.0;
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        length += itk::Math::sqr(((*it1)[d] - (*it2)[d]) * image->GetSpacing()[d]);
+      }
+      feretDiameter = std::max(feretDiameter, length);
+    }
+  }
+  return std::sqrt(feretDiameter);
+}
+
+// Fill the pixels for which the predicate is true, in an image of the given size.
+template <typename TImage, typename TPredicate>
+typename TImage::Pointer
+CreateObjectImage(const typename TImage::SizeType & size, const TPredicate & predicate)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->AllocateInitialized();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (predicate(it.GetIndex()))
+    {
+      it.Set(1);
+    }
+  }
+  return image;
+}
+
+template <typename TImage>
+void
+ExpectFeretDiameterMatchesBorderPairs(const TImage * image)
+{
+  const auto   start = std::chrono::steady_clock::now();
+  const double expected = ComputeBorderFeretDiameter(image);
+  const auto   middle = std::chrono::steady_clock::now();
+
+  auto l2s = itk::LabelImageToShapeLabelMapFilter<TImage>::New();
+  l2s->SetInput(image);
+  l2s->ComputeFeretDiameterOn();
+  l2s->Update();
+  const auto end = std::chrono::steady_clock::now();
+
+  const double feretDiameter = l2s->GetOutput()->GetLabelObject(1)->GetFeretDiameter();
+  std::cout << "Feret diameter " << feretDiameter
+            << ", all border pairs: " << std::chrono::duration<double>(middle - start).count()
+            << " s, ShapeLabelMapFilter: " << std::chrono::duration<double>(end - middle).count() << " s" << std::endl;
+  EXPECT_NEAR(expected, feretDiameter, 1e-10);
+}
+} // namespace
+
+TEST_F(ShapeLabelMapFixture, 2D_FeretDiameterOfLargeEllipse)
+{
+  using ImageType = itk::Image<unsigned short, 2>;
+
+  // Tilted, so that the diameter is not along an axis
+  const auto image = CreateObjectImage<ImageType>(itk::MakeSize(1001, 901), [](const ImageType::IndexType & idx) {
+    const double x = 0.8 * (idx[0] - 500.0) + 0.6 * (idx[1] - 450.0);
+    const double y = -0.6 * (idx[0] - 500.0) + 0.8 * (idx[1] - 450.0);
+    return Math::sqr(x / 480.0) + Math::sqr(y / 300.0) <= 1.0;
+  });
+  image->SetSpacing(itk::MakeVector(1.0, 0.7));
+  ExpectFeretDiameterMatchesBorderPairs(image.GetPointer());
+}
+
+TEST_F(ShapeLabelMapFixture, 3D_FeretDiameterOfLargeBall)
+{
+  using ImageType = itk::Image<unsigned short, 3>;
+
+  const auto image = CreateObjectImage<ImageType>(itk::MakeSize(61, 61, 61), [](const ImageType::IndexType & idx) {
+    return Math::sqr(idx[0] - 30) + Math::sqr(idx[1] - 30) + Math::sqr(idx[2] - 30) <= 29 * 29;
+  });
+  image->SetSpacing(itk::MakeVector(1.0, 0.5, 2.0));
+  ExpectFeretDiameterMatchesBorderPairs(image.GetPointer());
+}
+
+TEST_F(ShapeLabelMapFixture, FeretDiameterOfScatteredPixels)
+{
+  // Many collinear, and many slices with one or two pixels only
+  using ImageType2D = itk::Image<unsigned short, 2>;
+  for (const unsigned int seed : { 1u, 2u, 3u })
+  {
+    const auto image =
+      CreateObjectImage<ImageType2D>(itk::MakeSize(60, 40), [seed](const ImageType2D::IndexType & idx) {
+        return (idx[0] * 7919 + idx[1] * 104729 + seed * 15485863) % 97 < 3;
+      });
+    ExpectFeretDiameterMatchesBorderPairs(image.GetPointer());
+  }
+
+  using ImageType3D = itk::Image<unsigned short, 3>;
+  for (const unsigned int seed : { 1u, 2u, 3u })
+  {
+    const auto image =
+      CreateObjectImage<ImageType3D>(itk::MakeSize(30, 20, 25), [seed](const ImageType3D::IndexType & idx) {
+        return (idx[0] * 7919 + idx[1] * 104729 + idx[2] * 1299709 + seed * 15485863) % 89 < 3;
+      });
+    image->SetSpacing(itk::MakeVector(0.5, 1.0, 1.5));
+    ExpectFeretDiameterMatchesBorderPairs(image.GetPointer());
+  }
+}
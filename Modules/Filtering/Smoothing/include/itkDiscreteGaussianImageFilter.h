@@ -22,6 +22,8 @@
 #include "itkImageToImageFilter.h"
 #include "itkImage.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -45,6 +47,17 @@ namespace itk
  * When the Gaussian kernel is small, this filter tends to run faster than
  * itk::RecursiveGaussianImageFilter.
  *
+ * By default, each separable pass is run by a NeighborhoodOperatorImageFilter
+ * over the whole requested region, so the intermediate images are as large as
+ * the padded output. When UseTiledExecution is on, the output requested region
+ * is split into tiles of TileSize pixels, processed in parallel, and all the
+ * separable passes are applied to a tile, with the halo required by the
+ * following passes, before moving to the next tile. The intermediate data then
+ * stay small enough to remain in the processor caches, and the memory used is
+ * the output plus a few tiles. Both modes produce the same output. The tiled
+ * mode is only available for Image types with scalar pixels; other image types
+ * always use the internal pipeline.
+ *
  * \sa GaussianOperator
  * \sa Image
  * \sa Neighborhood
@@ -112,6 +125,10 @@ public:
   using RealBoundaryConditionPointerType = ImageBoundaryCondition<RealOutputImageType> *;
   using RealDefaultBoundaryConditionType = ZeroFluxNeumannBoundaryCondition<RealOutputImageType>;
 
+  /** Region and size types used for the tiles */
+  using OutputImageRegionType = typename TOutputImage::RegionType;
+  using SizeType = typename TOutputImage::SizeType;
+
   /** Typedef of double containers */
   using ArrayType = FixedArray<double, Self::ImageDimension>;
   using SigmaArrayType = ArrayType;
@@ -286,6 +303,19 @@ public:
   itkGetConstMacro(UseImageSpacing, bool);
   itkBooleanMacro(UseImageSpacing);
 
+  /** Set/Get whether the output is computed tile by tile, all the
+   * separable passes being applied to each tile in turn. Default is
+   * Off. */
+  itkSetMacro(UseTiledExecution, bool);
+  itkGetConstMacro(UseTiledExecution, bool);
+  itkBooleanMacro(UseTiledExecution);
+
+  /** Set/Get the size of the tiles used when UseTiledExecution is On. A
+   * size of zero along a dimension uses the whole requested region
+   * along that dimension. Default is 64 pixels in each dimension. */
+  itkSetMacro(TileSize, SizeType);
+  itkGetConstReferenceMacro(TileSize, SizeType);
+
 #if !defined(ITK_FUTURE_LEGACY_REMOVE)
   /** Use the image spacing information in calculations. Use this option if you
    *  want to specify Gaussian variance in real world units.  Default is
@@ -337,6 +367,7 @@ protected:
     m_FilterDimensionality = ImageDimension;
     m_InputBoundaryCondition = &m_InputDefaultBoundaryCondition;
     m_RealBoundaryCondition = &m_RealDefaultBoundaryCondition;
+    m_TileSize.Fill(64);
   }
 
   ~DiscreteGaussianImageFilter() override = default;
@@ -368,6 +399,31 @@ protected:
   ArrayType
   GetKernelVarianceArray() const;
 
+  /** Whether the tiled execution is available for these image types. */
+  static constexpr bool TiledExecutionSupported =
+    std::is_arithmetic_v<InputPixelType> && std::is_arithmetic_v<OutputPixelType> &&
+    std::is_same_v<TInputImage, Image<InputPixelType, ImageDimension>> &&
+    std::is_same_v<TOutputImage, Image<OutputPixelType, ImageDimension>>;
+
+  /** Compute the requested region of the output tile by tile. The
+   * kernels are given in the order in which they are applied. */
+  void
+  GenerateTiledData(const std::vector<KernelType> & kernels);
+
+  /** Apply all the separable passes to one tile of the output. */
+  void
+  GenerateTile(const OutputImageRegionType & tile, const std::vector<KernelType> & kernels) const;
+
+  /** Convolve the region of the destination along the direction of
+   * the kernel, reading the source image or its boundary condition. */
+  template <typename TSourceImage, typename TDestinationImage>
+  static void
+  ConvolveRegion(const TSourceImage *                         source,
+                 const ImageBoundaryCondition<TSourceImage> * boundaryCondition,
+                 const KernelType &                           kernel,
+                 TDestinationImage *                          destination,
+                 const OutputImageRegionType &                region);
+
 private:
   /** The variance of the gaussian blurring kernel in each dimensional
     direction. */
@@ -400,6 +456,12 @@ private:
 
   /** Default boundary condition use for the intermediate filters */
   RealDefaultBoundaryConditionType m_RealDefaultBoundaryCondition{};
+
+  /** Flag to indicate whether the output is computed tile by tile */
+  bool m_UseTiledExecution{ false };
+
+  /** Size of the tiles when UseTiledExecution is on */
+  SizeType m_TileSize{};
 };
 } // end namespace itk
 
@@ -23,6 +23,7 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressAccumulator.h"
 #include "itkImageAlgorithm.h"
+#include "itkImageLinearIteratorWithIndex.h"
 
 namespace itk
 {
@@ -220,6 +221,15 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
     this->GenerateKernel(i, oper[reverse_i]);
   }
 
+  if constexpr (TiledExecutionSupported)
+  {
+    if (m_UseTiledExecution)
+    {
+      this->GenerateTiledData(oper);
+      return;
+    }
+  }
+
   // Create a chain of filters
   //
   //
@@ -316,6 +326,187 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateTiledData(const std::vector<KernelType> & kernels)
+{
+  const OutputImageRegionType requestedRegion = this->GetOutput()->GetRequestedRegion();
+
+  // Split the requested region in tiles of at most m_TileSize pixels
+  SizeType      numberOfTiles;
+  SizeType      tileSize;
+  SizeValueType totalNumberOfTiles = 1;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    tileSize[i] = m_TileSize[i] == 0 ? requestedRegion.GetSize(i) : std::min(m_TileSize[i], requestedRegion.GetSize(i));
+    numberOfTiles[i] = tileSize[i] == 0 ? 0 : (requestedRegion.GetSize(i) + tileSize[i] - 1) / tileSize[i];
+    totalNumberOfTiles *= numberOfTiles[i];
+  }
+
+  const auto tileAt = [&](SizeValueType tileNumber) {
+    OutputImageRegionType tile;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      const SizeValueType position = tileNumber % numberOfTiles[i];
+      tileNumber /= numberOfTiles[i];
+      const IndexValueType start = requestedRegion.GetIndex(i) + static_cast<IndexValueType>(position * tileSize[i]);
+      tile.SetIndex(i, start);
+      tile.SetSize(i, std::min(tileSize[i], requestedRegion.GetSize(i) - position * tileSize[i]));
+    }
+    return tile;
+  };
+
+  // The progress is reported tile by tile, rather than by the multi-threader
+  // once per work unit
+  const float progressPerTile = totalNumberOfTiles == 0 ? 0.0f : 1.0f / static_cast<float>(totalNumberOfTiles);
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    totalNumberOfTiles,
+    [&](SizeValueType tileNumber) {
+      this->GenerateTile(tileAt(tileNumber), kernels);
+      this->IncrementProgress(progressPerTile);
+    },
+    nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateTile(const OutputImageRegionType &   tile,
+                                                                     const std::vector<KernelType> & kernels) const
+{
+  if constexpr (TiledExecutionSupported)
+  {
+    TOutputImage *                output = const_cast<TOutputImage *>(this->GetOutput());
+    const OutputImageRegionType & largestRegion = output->GetLargestPossibleRegion();
+
+    // The region of each intermediate image is the tile padded by the
+    // radius of the kernels applied after it, as the internal pipeline
+    // would request, so both modes read the same boundary conditions.
+    typename RealOutputImageType::Pointer previous;
+    for (unsigned int pass = 0; pass < kernels.size(); ++pass)
+    {
+      RadiusType radius{};
+      for (unsigned int next = pass + 1; next < kernels.size(); ++next)
+      {
+        const unsigned long direction = kernels[next].GetDirection();
+        radius[direction] = kernels[next].GetRadius(direction);
+      }
+      OutputImageRegionType region = tile;
+      region.PadByRadius(radius);
+      region.Crop(largestRegion);
+
+      typename RealOutputImageType::Pointer current;
+      if (pass + 1 < kernels.size())
+      {
+        current = RealOutputImageType::New();
+        current->SetRegions(region);
+        current->Allocate();
+      }
+
+      if (pass == 0 && current)
+      {
+        ConvolveRegion(this->GetInput(), m_InputBoundaryCondition, kernels[pass], current.GetPointer(), region);
+      }
+      else if (pass == 0)
+      {
+        ConvolveRegion(this->GetInput(), m_InputBoundaryCondition, kernels[pass], output, region);
+      }
+      else if (current)
+      {
+        ConvolveRegion(previous.GetPointer(), m_RealBoundaryCondition, kernels[pass], current.GetPointer(), region);
+      }
+      else
+      {
+        ConvolveRegion(previous.GetPointer(), m_RealBoundaryCondition, kernels[pass], output, region);
+      }
+      previous = current;
+    }
+  }
+  else
+  {
+    (void)tile;
+    (void)kernels;
+    itkExceptionMacro("Tiled execution is not supported for this image type");
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TSourceImage, typename TDestinationImage>
+void
+DiscreteGaussianImageFilter<TInputImage, TOutputImage>::ConvolveRegion(
+  const TSourceImage *                         source,
+  const ImageBoundaryCondition<TSourceImage> * boundaryCondition,
+  const KernelType &                           kernel,
+  TDestinationImage *                          destination,
+  const OutputImageRegionType &                region)
+{
+  // Same arithmetic as NeighborhoodOperatorImageFilter and NeighborhoodInnerProduct
+  using DestinationPixelType = typename TDestinationImage::PixelType;
+  using ComputingPixelType = typename NumericTraits<DestinationPixelType>::RealType;
+  using KernelValueType = typename NumericTraits<ComputingPixelType>::ValueType;
+  using SourceRealType = typename NumericTraits<typename TSourceImage::PixelType>::RealType;
+  using AccumulateType = typename NumericTraits<SourceRealType>::AccumulateType;
+
+  const unsigned int   direction = kernel.GetDirection();
+  const IndexValueType kernelRadius = kernel.GetRadius(direction);
+  const SizeValueType  kernelSize = kernel.Size();
+  const SizeValueType  lineLength = region.GetSize(direction);
+
+  std::vector<KernelValueType> weights(kernelSize);
+  for (SizeValueType j = 0; j < kernelSize; ++j)
+  {
+    weights[j] = static_cast<KernelValueType>(kernel[j]);
+  }
+
+  const typename TSourceImage::RegionType & bufferedRegion = source->GetBufferedRegion();
+  const OffsetValueType                     sourceStride = source->GetOffsetTable()[direction];
+
+  // Each line is first gathered with its halo into a contiguous buffer
+  std::vector<SourceRealType> line(lineLength + 2 * kernelRadius);
+
+  ImageLinearIteratorWithIndex<TDestinationImage> it(destination, region);
+  it.SetDirection(direction);
+  for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+  {
+    auto first = it.GetIndex();
+    first[direction] -= kernelRadius;
+    auto last = first;
+    last[direction] += static_cast<IndexValueType>(line.size()) - 1;
+
+    if (bufferedRegion.IsInside(first) && bufferedRegion.IsInside(last))
+    {
+      const typename TSourceImage::PixelType * pixel = source->GetBufferPointer() + source->ComputeOffset(first);
+      for (auto & value : line)
+      {
+        value = static_cast<SourceRealType>(*pixel);
+        pixel += sourceStride;
+      }
+    }
+    else
+    {
+      auto index = first;
+      for (auto & value : line)
+      {
+        value = static_cast<SourceRealType>(
+          bufferedRegion.IsInside(index) ? source->GetPixel(index) : boundaryCondition->GetPixel(index, source));
+        ++index[direction];
+      }
+    }
+
+    for (SizeValueType i = 0; i < lineLength; ++i, ++it)
+    {
+      AccumulateType sum{};
+      for (SizeValueType j = 0; j < kernelSize; ++j)
+      {
+        sum += static_cast<AccumulateType>(weights[j] * line[i + j]);
+      }
+      it.Set(static_cast<DestinationPixelType>(static_cast<ComputingPixelType>(sum)));
+    }
+  }
+}
+
 #if !defined(ITK_LEGACY_REMOVE)
 template <typename TInputImage, typename TOutputImage>
 unsigned int
@@ -346,6 +537,8 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream &
   os << indent << "FilterDimensionality: " << m_FilterDimensionality << std::endl;
   itkPrintSelfBooleanMacro(UseImageSpacing);
   os << indent << "RealBoundaryCondition: " << m_RealBoundaryCondition << std::endl;
+  itkPrintSelfBooleanMacro(UseTiledExecution);
+  os << indent << "TileSize: " << m_TileSize << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkDiscreteGaussianImageFilter.h"
+
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkStreamingImageFilter.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+// Creates a test image with a varying pattern, so that every pass contributes.
+template <typename TImage>
+typename TImage::Pointer
+CreatePatternImage(const typename TImage::RegionType & imageRegion)
+{
+  using PixelType = typename TImage::PixelType;
+  const auto image = TImage::New();
+  image->SetRegions(imageRegion);
+  image->Allocate();
+  unsigned int value = 0;
+  for (auto & pixel : itk::ImageBufferRange{ *image })
+  {
+    value = (value * 7 + 13) % 101;
+    pixel = static_cast<PixelType>(value);
+  }
+  return image;
+}
+
+
+// Expects that the tiled mode produces the same output as the internal pipeline.
+template <typename TInputImage, typename TOutputImage>
+void
+Expect_tiled_output_equals_pipeline_output(const typename TInputImage::RegionType & imageRegion,
+                                           const typename TOutputImage::SizeType &  tileSize,
+                                           unsigned int                             filterDimensionality,
+                                           unsigned int                             numberOfStreamDivisions = 1)
+{
+  using FilterType = itk::DiscreteGaussianImageFilter<TInputImage, TOutputImage>;
+
+  const auto   input = CreatePatternImage<TInputImage>(imageRegion);
+  const double variance[] = { 2.0, 4.5, 1.0 };
+
+  const auto computeOutput = [&](bool tiled) {
+    const auto filter = FilterType::New();
+    filter->SetInput(input);
+    filter->SetVariance(variance);
+    filter->SetFilterDimensionality(filterDimensionality);
+    filter->SetUseTiledExecution(tiled);
+    filter->SetTileSize(tileSize);
+
+    const auto streamer = itk::StreamingImageFilter<TOutputImage, TOutputImage>::New();
+    streamer->SetInput(filter->GetOutput());
+    streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+    streamer->Update();
+    return typename TOutputImage::Pointer(streamer->GetOutput());
+  };
+
+  const auto expected = computeOutput(false);
+  const auto actual = computeOutput(true);
+
+  itk::ImageRegionConstIterator<TOutputImage> expectedIt(expected, imageRegion);
+  itk::ImageRegionConstIterator<TOutputImage> actualIt(actual, imageRegion);
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+  {
+    ASSERT_EQ(expectedIt.Get(), actualIt.Get());
+  }
+}
+
+} // namespace
+
+
+TEST(DiscreteGaussianImageFilter, TiledExecutionIsOffByDefault)
+{
+  const auto filter = itk::DiscreteGaussianImageFilter<itk::Image<float, 3>>::New();
+  EXPECT_FALSE(filter->GetUseTiledExecution());
+  EXPECT_EQ(filter->GetTileSize(), itk::Size<3>::Filled(64));
+}
+
+
+TEST(DiscreteGaussianImageFilter, TiledOutputEqualsPipelineOutput)
+{
+  using ImageType = itk::Image<float, 3>;
+  const ImageType::RegionType region(itk::MakeIndex(-2, 3, 1), itk::MakeSize(37, 29, 17));
+
+  Expect_tiled_output_equals_pipeline_output<ImageType, ImageType>(region, itk::MakeSize(8, 16, 5), 3);
+  Expect_tiled_output_equals_pipeline_output<ImageType, ImageType>(region, itk::MakeSize(0, 7, 0), 3);
+  Expect_tiled_output_equals_pipeline_output<ImageType, ImageType>(region, itk::MakeSize(64, 64, 64), 3);
+  Expect_tiled_output_equals_pipeline_output<ImageType, ImageType>(region, itk::MakeSize(10, 10, 10), 2);
+  Expect_tiled_output_equals_pipeline_output<ImageType, ImageType>(region, itk::MakeSize(10, 10, 10), 1);
+}
+
+
+TEST(DiscreteGaussianImageFilter, TiledOutputEqualsPipelineOutputWhenStreamed)
+{
+  using ImageType = itk::Image<float, 3>;
+  const ImageType::RegionType region(itk::MakeSize(31, 23, 19));
+
+  Expect_tiled_output_equals_pipeline_output<ImageType, ImageType>(region, itk::MakeSize(9, 9, 9), 3, 4);
+}
+
+
+TEST(DiscreteGaussianImageFilter, TiledOutputEqualsPipelineOutputForIntegerPixels)
+{
+  using InputImageType = itk::Image<unsigned char, 2>;
+  using OutputImageType = itk::Image<short, 2>;
+  const InputImageType::RegionType region(itk::MakeSize(45, 33));
+
+  Expect_tiled_output_equals_pipeline_output<InputImageType, OutputImageType>(region, itk::MakeSize(16, 8), 2);
+}
+
+
+// The progress of the tiled mode is reported tile by tile.
+TEST(DiscreteGaussianImageFilter, TiledExecutionReportsProgress)
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::DiscreteGaussianImageFilter<ImageType>;
+
+  const auto filter = FilterType::New();
+  filter->SetInput(CreatePatternImage<ImageType>(ImageType::RegionType(itk::MakeSize(40, 30))));
+  filter->SetVariance(2.0);
+  filter->SetUseTiledExecution(true);
+  filter->SetTileSize(itk::MakeSize(10, 10));
+  filter->SetNumberOfWorkUnits(1);
+
+  std::vector<float> progresses;
+  filter->AddObserver(itk::ProgressEvent(), [&filter, &progresses](const itk::EventObject &) {
+    progresses.push_back(filter->GetProgress());
+  });
+  filter->Update();
+
+  // One event per tile, and the ones of the pipeline
+  ASSERT_GE(progresses.size(), 12u);
+  EXPECT_TRUE(std::is_sorted(progresses.cbegin(), progresses.cend()));
+  EXPECT_FLOAT_EQ(progresses.back(), 1.0f);
+}
@@ -226,6 +226,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the UID prefix, the compression type and the options reading the DICOM files. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalReadImageInformation();
 
@@ -51,6 +51,13 @@ namespace itk
  *    DICOM objects, you may want to try calling SetUseSeriesDetails(true)
  *    prior to calling SetDirectory().
  *
+ * The headers of the files are parsed concurrently, by the work units
+ * of the process object, each one only up to the last tag needed to
+ * group and order the files. Files without image rows are skipped. When
+ * an index file is set, the series information of the parsed files is
+ * saved in it, keyed by the file path, size and modification time, and
+ * the next scans only parse the new or changed files.
+ *
  * \ingroup IOFilters
  *
  * \ingroup ITKIOGDCM
@@ -185,6 +192,18 @@ public:
   itkGetConstMacro(LoadPrivateTags, bool);
   itkBooleanMacro(LoadPrivateTags);
 
+  /** Set/Get the file keeping the series information of the scanned
+   * files between scans, possibly shared by several directories. It is
+   * read and updated by SetInputDirectory(). Empty, the default, parses
+   * every file at each scan. Must be set before the call to
+   * SetInputDirectory(). */
+  itkSetStringMacro(IndexFileName);
+  itkGetStringMacro(IndexFileName);
+
+  /** Number of files whose header was parsed by the last scan, the
+   * others having been found unchanged in the index file. */
+  itkGetConstMacro(NumberOfParsedFiles, SizeValueType);
+
 protected:
   GDCMSeriesFileNames();
   ~GDCMSeriesFileNames() override;
@@ -192,6 +211,14 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  /** Series information of the scanned files, defined in the implementation */
+  struct SeriesIndex;
+
+  /** Group and order the files of the input directory, parsing those
+   * which are not found unchanged in the index file. */
+  void
+  ScanInputDirectory();
+
   /** Contains the input directory where the DICOM series is found */
   std::string m_InputDirectory = "";
 
@@ -205,9 +232,15 @@ private:
   /** Internal structure to order series from one directory */
   std::unique_ptr<gdcm::SerieHelper> m_SerieHelper;
 
+  /** Internal structure to keep the files of each series found */
+  std::unique_ptr<SeriesIndex> m_SeriesIndex;
+
   /** Internal structure to keep the list of series UIDs */
   SeriesUIDContainerType m_SeriesUIDs{};
 
+  std::string   m_IndexFileName{};
+  SizeValueType m_NumberOfParsedFiles{ 0 };
+
   bool m_UseSeriesDetails = true;
   bool m_Recursive = false;
   bool m_LoadSequences = false;
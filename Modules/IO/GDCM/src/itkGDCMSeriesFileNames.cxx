@@ -18,16 +18,276 @@
 
 #include "itkGDCMSeriesFileNames.h"
 #include "itksys/SystemTools.hxx"
+#include "itkMultiThreaderBase.h"
 #include "itkProgressReporter.h"
 #include "itkPrintHelper.h"
+#include "gdcmAttribute.h"
+#include "gdcmDirectory.h"
+#include "gdcmImageHelper.h"
+#include "gdcmReader.h"
 #include "gdcmSerieHelper.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
 namespace itk
 {
 
+struct GDCMSeriesFileNames::SeriesIndex
+{
+  /** Series information of a file, as kept in the index file. */
+  struct FileInformation
+  {
+    std::string   fileName;
+    unsigned long size{ 0 };
+    long int      modifiedTime{ 0 };
+    bool          isImage{ false };
+    std::string   seriesIdentifier;
+    int           instanceNumber{ -1 };
+    double        origin[3]{ 0.0, 0.0, 0.0 };
+    double        directionCosines[6]{ 1.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+  };
+
+  using FileListType = std::vector<const FileInformation *>;
+
+  /** The settings of the series identifiers of the last scan. The
+   * index file is only used with the settings it was written with. */
+  std::string identifierSettings{};
+
+  /** The tags refining the series identifiers, in the order they were
+   * added to the gdcm::SerieHelper, and as a set. */
+  std::string         refineHistory{};
+  std::set<gdcm::Tag> refineTags{};
+
+  /** The files of the last scan, and their ordered lists by series. */
+  std::vector<FileInformation>        files{};
+  std::map<std::string, FileListType> series{};
+
+  void
+  ParseFile(FileInformation & information, gdcm::SerieHelper & helper) const;
+
+  static void
+  OrderFiles(FileListType & fileList);
+
+  void
+  ReadIndexFile(const std::string & indexFileName, std::map<std::string, FileInformation> & entries) const;
+
+  void
+  WriteIndexFile(const std::string &                             indexFileName,
+                 const std::map<std::string, FileInformation> & entries) const;
+};
+
+void
+GDCMSeriesFileNames::SeriesIndex::ParseFile(FileInformation & information, gdcm::SerieHelper & helper) const
+{
+  // The tags identifying and ordering the files, the dataset is only
+  // parsed up to the last of them
+  std::set<gdcm::Tag> tags = refineTags;
+  tags.insert({ gdcm::Tag(0x0008, 0x0016),
+                gdcm::Tag(0x0008, 0x0060),
+                gdcm::Tag(0x0020, 0x000e),
+                gdcm::Tag(0x0020, 0x0013),
+                gdcm::Tag(0x0020, 0x0032),
+                gdcm::Tag(0x0020, 0x0037),
+                gdcm::Tag(0x0028, 0x0008),
+                gdcm::Tag(0x0028, 0x0010),
+                gdcm::Tag(0x0028, 0x0011) });
+
+  auto reader = std::make_unique<gdcm::Reader>();
+  reader->SetFileName(information.fileName.c_str());
+  information.isImage = reader->ReadSelectedTags(tags) &&
+                        reader->GetFile().GetDataSet().FindDataElement(gdcm::Tag(0x0028, 0x0010));
+  if (!information.isImage)
+  {
+    return;
+  }
+
+  // The multi-frame and nuclear medicine images keep their position and
+  // orientation in sequences, only parsed when needed
+  if (!reader->GetFile().GetDataSet().FindDataElement(gdcm::Tag(0x0020, 0x0032)))
+  {
+    tags.insert({ gdcm::Tag(0x0054, 0x0022), gdcm::Tag(0x5200, 0x9229), gdcm::Tag(0x5200, 0x9230) });
+    reader = std::make_unique<gdcm::Reader>();
+    reader->SetFileName(information.fileName.c_str());
+    if (!reader->ReadSelectedTags(tags))
+    {
+      information.isImage = false;
+      return;
+    }
+  }
+
+  gdcm::File & file = reader->GetFile();
+  information.seriesIdentifier = helper.CreateUniqueSeriesIdentifier(&file);
+
+  gdcm::Attribute<0x0020, 0x0013> instanceNumber;
+  instanceNumber.SetValue(-1);
+  instanceNumber.SetFromDataSet(file.GetDataSet());
+  information.instanceNumber = instanceNumber.GetValue();
+
+  const std::vector<double> origin = gdcm::ImageHelper::GetOriginValue(file);
+  const std::vector<double> directionCosines = gdcm::ImageHelper::GetDirectionCosinesValue(file);
+  std::copy_n(origin.cbegin(), std::min<size_t>(origin.size(), 3), information.origin);
+  std::copy_n(directionCosines.cbegin(), std::min<size_t>(directionCosines.size(), 6), information.directionCosines);
+}
+
+void
+GDCMSeriesFileNames::SeriesIndex::OrderFiles(FileListType & fileList)
+{
+  // As gdcm::SerieHelper, order the files along the normal of the first
+  // one when their positions are distinct, otherwise by their distinct
+  // instance numbers, otherwise by their names.
+  const double * cosines = fileList.front()->directionCosines;
+  const double   normal[3] = { cosines[1] * cosines[5] - cosines[2] * cosines[4],
+                               cosines[2] * cosines[3] - cosines[0] * cosines[5],
+                               cosines[0] * cosines[4] - cosines[1] * cosines[3] };
+
+  std::vector<std::pair<double, const FileInformation *>> distances;
+  for (const FileInformation * information : fileList)
+  {
+    double distance = 0.0;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      distance += normal[i] * information->origin[i];
+    }
+    distances.emplace_back(distance, information);
+  }
+  std::stable_sort(
+    distances.begin(), distances.end(), [](const auto & a, const auto & b) { return a.first < b.first; });
+
+  bool arePositionsDistinct = distances.front().first != distances.back().first;
+  for (size_t n = 1; n < distances.size() && arePositionsDistinct; ++n)
+  {
+    arePositionsDistinct = distances[n - 1].first != distances[n].first;
+  }
+  if (arePositionsDistinct)
+  {
+    for (size_t n = 0; n < distances.size(); ++n)
+    {
+      fileList[n] = distances[n].second;
+    }
+    return;
+  }
+
+  std::set<int> instanceNumbers;
+  for (const FileInformation * information : fileList)
+  {
+    instanceNumbers.insert(information->instanceNumber);
+  }
+  if (instanceNumbers.size() == fileList.size())
+  {
+    std::sort(fileList.begin(), fileList.end(), [](const FileInformation * a, const FileInformation * b) {
+      return a->instanceNumber < b->instanceNumber;
+    });
+    return;
+  }
+
+  std::sort(fileList.begin(), fileList.end(), [](const FileInformation * a, const FileInformation * b) {
+    return a->fileName < b->fileName;
+  });
+}
+
+// The index file is a text file: a version line and a settings line,
+// then one line per file with its size, modification time, image flag,
+// instance number, origin, direction cosines, series identifier and,
+// last as it may contain any character but a new line, its path.
+namespace
+{
+constexpr char SeriesIndexVersion[] = "ITK GDCMSeriesFileNames index 1";
+} // namespace
+
+void
+GDCMSeriesFileNames::SeriesIndex::ReadIndexFile(const std::string &                       indexFileName,
+                                                std::map<std::string, FileInformation> & entries) const
+{
+  std::ifstream file(indexFileName.c_str());
+  std::string   line;
+  if (!std::getline(file, line) || line != SeriesIndexVersion || !std::getline(file, line) ||
+      line != identifierSettings)
+  {
+    return;
+  }
+
+  while (std::getline(file, line))
+  {
+    std::istringstream stream(line);
+    FileInformation    information;
+    stream >> information.size >> information.modifiedTime >> information.isImage >> information.instanceNumber;
+    for (double & value : information.origin)
+    {
+      stream >> value;
+    }
+    for (double & value : information.directionCosines)
+    {
+      stream >> value;
+    }
+    if (stream.get() != '\t' || !std::getline(stream, information.seriesIdentifier, '\t') ||
+        !std::getline(stream, information.fileName) || information.fileName.empty())
+    {
+      continue;
+    }
+    entries[information.fileName] = information;
+  }
+}
+
+void
+GDCMSeriesFileNames::SeriesIndex::WriteIndexFile(const std::string &                             indexFileName,
+                                                 const std::map<std::string, FileInformation> & entries) const
+{
+  std::ostringstream stream;
+  stream.precision(17);
+  stream << SeriesIndexVersion << '\n' << identifierSettings << '\n';
+  for (const auto & entry : entries)
+  {
+    const FileInformation & information = entry.second;
+    if (information.fileName.find('\n') != std::string::npos)
+    {
+      continue;
+    }
+    stream << information.size << ' ' << information.modifiedTime << ' ' << information.isImage << ' '
+           << information.instanceNumber;
+    for (const double value : information.origin)
+    {
+      stream << ' ' << value;
+    }
+    for (const double value : information.directionCosines)
+    {
+      stream << ' ' << value;
+    }
+    stream << '\t' << information.seriesIdentifier << '\t' << information.fileName << '\n';
+  }
+
+  // Replace the index file at once, so that concurrent scans sharing it
+  // read either version
+  const std::string temporaryFileName = indexFileName + '.' + std::to_string(std::random_device()());
+  {
+    std::ofstream file(temporaryFileName.c_str(), std::ios::binary);
+    file << stream.str();
+    if (!file)
+    {
+      itksys::SystemTools::RemoveFile(temporaryFileName);
+      throw std::runtime_error("Cannot write the index file " + indexFileName);
+    }
+  }
+  // std::rename does not replace an existing file on Windows
+  if (std::rename(temporaryFileName.c_str(), indexFileName.c_str()) != 0 &&
+      (!itksys::SystemTools::RemoveFile(indexFileName) ||
+       std::rename(temporaryFileName.c_str(), indexFileName.c_str()) != 0))
+  {
+    itksys::SystemTools::RemoveFile(temporaryFileName);
+    throw std::runtime_error("Cannot replace the index file " + indexFileName);
+  }
+}
+
 
 GDCMSeriesFileNames::GDCMSeriesFileNames()
   : m_SerieHelper{ new gdcm::SerieHelper() }
+  , m_SeriesIndex{ std::make_unique<SeriesIndex>() }
 {}
 
 GDCMSeriesFileNames::~GDCMSeriesFileNames() = default;
@@ -48,6 +308,11 @@ void
 GDCMSeriesFileNames::AddSeriesRestriction(const std::string & tag)
 {
   m_SerieHelper->AddRestriction(tag);
+
+  gdcm::Tag t;
+  t.ReadFromPipeSeparatedString(tag.c_str());
+  m_SeriesIndex->refineTags.insert(t);
+  m_SeriesIndex->refineHistory += t.PrintAsPipeSeparatedString() + ";";
 }
 
 void
@@ -72,29 +337,115 @@ GDCMSeriesFileNames::SetInputDirectory(std::string const & name)
   m_SerieHelper->Clear();
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->SetLoadMode((m_LoadSequences ? 0 : gdcm::LD_NOSEQ) | (m_LoadPrivateTags ? 0 : gdcm::LD_NOSHADOW));
-  m_SerieHelper->SetDirectory(name, m_Recursive);
+  this->ScanInputDirectory();
   // as a side effect it also execute
   this->Modified();
 }
 
-const GDCMSeriesFileNames::SeriesUIDContainerType &
-GDCMSeriesFileNames::GetSeriesUIDs()
+void
+GDCMSeriesFileNames::ScanInputDirectory()
 {
-  m_SeriesUIDs.clear();
-  // Accessing the first serie found (assume there is at least one)
-  gdcm::FileList * flist = m_SerieHelper->GetFirstSingleSerieUIDFileSet();
-  while (flist)
+  using FileInformation = SeriesIndex::FileInformation;
+
+  gdcm::Directory directory;
+  directory.Load(m_InputDirectory, m_Recursive);
+  const gdcm::Directory::FilenamesType & fileNames = directory.GetFilenames();
+
+  m_SeriesIndex->identifierSettings =
+    "UseSeriesDetails=" + std::to_string(m_UseSeriesDetails) + ";Refine=" + m_SeriesIndex->refineHistory;
+  std::map<std::string, FileInformation> entries;
+  if (!m_IndexFileName.empty())
   {
-    if (!flist->empty()) // make sure we have at leat one serie
-    {
-      gdcm::File * file = (*flist)[0]; // for example take the first one
+    m_SeriesIndex->ReadIndexFile(m_IndexFileName, entries);
+  }
 
-      // Create its unique series ID
-      std::string id = m_SerieHelper->CreateUniqueSeriesIdentifier(file).c_str();
+  // Only the files which are not in the index, or have changed since,
+  // are parsed
+  std::vector<FileInformation> & files = m_SeriesIndex->files;
+  std::vector<size_t>            filesToParse;
+  files.clear();
+  files.reserve(fileNames.size());
+  for (const std::string & fileName : fileNames)
+  {
+    FileInformation information;
+    information.fileName = fileName;
+    information.size = itksys::SystemTools::FileLength(fileName);
+    information.modifiedTime = itksys::SystemTools::ModifiedTime(fileName);
+
+    const auto entry = entries.find(fileName);
+    if (entry != entries.cend() && entry->second.size == information.size &&
+        entry->second.modifiedTime == information.modifiedTime)
+    {
+      files.push_back(entry->second);
+    }
+    else
+    {
+      filesToParse.push_back(files.size());
+      files.push_back(information);
+    }
+  }
 
-      m_SeriesUIDs.push_back(id.c_str());
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  const auto parseFile = [this, &files, &filesToParse](SizeValueType n) {
+    m_SeriesIndex->ParseFile(files[filesToParse[n]], *m_SerieHelper);
+  };
+  multiThreader->ParallelizeArray(0, filesToParse.size(), parseFile, nullptr);
+  m_NumberOfParsedFiles = filesToParse.size();
+
+  // Group the images by series, in the order of the directory, then
+  // order each series
+  m_SeriesIndex->series.clear();
+  for (const FileInformation & information : files)
+  {
+    if (information.isImage)
+    {
+      m_SeriesIndex->series[information.seriesIdentifier].push_back(&information);
     }
-    flist = m_SerieHelper->GetNextSingleSerieUIDFileSet();
+  }
+  for (auto & series : m_SeriesIndex->series)
+  {
+    SeriesIndex::OrderFiles(series.second);
+  }
+
+  if (m_IndexFileName.empty() || filesToParse.empty())
+  {
+    return;
+  }
+
+  // The entries of the files which were in the scanned directory but
+  // were not found are removed from the index
+  std::string prefix = m_InputDirectory;
+  itksys::SystemTools::ConvertToUnixSlashes(prefix);
+  prefix += '/';
+  for (auto entry = entries.begin(); entry != entries.end();)
+  {
+    const std::string & fileName = entry->first;
+    const bool          isInDirectory = fileName.compare(0, prefix.size(), prefix) == 0 &&
+                               (m_Recursive || fileName.find('/', prefix.size()) == std::string::npos);
+    entry = isInDirectory ? entries.erase(entry) : std::next(entry);
+  }
+  for (const FileInformation & information : files)
+  {
+    entries[information.fileName] = information;
+  }
+  try
+  {
+    m_SeriesIndex->WriteIndexFile(m_IndexFileName, entries);
+  }
+  catch (const std::exception & e)
+  {
+    itkWarningMacro(<< e.what());
+  }
+}
+
+const GDCMSeriesFileNames::SeriesUIDContainerType &
+GDCMSeriesFileNames::GetSeriesUIDs()
+{
+  m_SeriesUIDs.clear();
+  for (const auto & series : m_SeriesIndex->series)
+  {
+    m_SeriesUIDs.push_back(series.first);
   }
   if (m_SeriesUIDs.empty())
   {
@@ -108,52 +459,28 @@ GDCMSeriesFileNames::GetFileNames(const std::string serie)
 {
   m_InputFileNames.clear();
   // Accessing the first serie found (assume there is at least one)
-  gdcm::FileList * flist = m_SerieHelper->GetFirstSingleSerieUIDFileSet();
-  if (!flist)
+  auto series = m_SeriesIndex->series.cbegin();
+  if (series == m_SeriesIndex->series.cend())
   {
     itkWarningMacro("No Series can be found, make sure your restrictions are not too strong");
     return m_InputFileNames;
   }
   if (!serie.empty()) // user did not specify any sub selection based on UID
   {
-    bool found = false;
-    while (flist && !found)
-    {
-      if (!flist->empty()) // make sure we have at leat one serie
-      {
-        gdcm::File * file = (*flist)[0]; // for example take the first one
-        std::string  id = m_SerieHelper->CreateUniqueSeriesIdentifier(file).c_str();
-
-        if (id == serie)
-        {
-          found = true; // we found a match
-          break;
-        }
-      }
-      flist = m_SerieHelper->GetNextSingleSerieUIDFileSet();
-    }
-    if (!found)
+    series = m_SeriesIndex->series.find(serie);
+    if (series == m_SeriesIndex->series.cend())
     {
       itkWarningMacro("No Series were found");
       return m_InputFileNames;
     }
   }
-  m_SerieHelper->OrderFileList(flist);
 
-  gdcm::FileList::iterator it;
-  if (!flist->empty())
-  {
-    ProgressReporter progress(this, 0, static_cast<itk::SizeValueType>(flist->size()), 10);
-    for (it = flist->begin(); it != flist->end(); ++it)
-    {
-      gdcm::FileWithName * header = *it;
-      m_InputFileNames.push_back(header->filename);
-      progress.CompletedPixel();
-    }
-  }
-  else
+  const SeriesIndex::FileListType & fileList = series->second;
+  ProgressReporter                  progress(this, 0, static_cast<itk::SizeValueType>(fileList.size()), 10);
+  for (const SeriesIndex::FileInformation * information : fileList)
   {
-    itkDebugMacro("No files were found");
+    m_InputFileNames.push_back(information->fileName);
+    progress.CompletedPixel();
   }
 
   return m_InputFileNames;
@@ -274,6 +601,9 @@ GDCMSeriesFileNames::PrintSelf(std::ostream & os, Indent indent) const
   itkPrintSelfBooleanMacro(Recursive);
   itkPrintSelfBooleanMacro(LoadSequences);
   itkPrintSelfBooleanMacro(LoadPrivateTags);
+
+  os << indent << "IndexFileName: " << m_IndexFileName << std::endl;
+  os << indent << "NumberOfParsedFiles: " << m_NumberOfParsedFiles << std::endl;
 }
 
 void
@@ -282,5 +612,12 @@ GDCMSeriesFileNames::SetUseSeriesDetails(bool useSeriesDetails)
   m_UseSeriesDetails = useSeriesDetails;
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->CreateDefaultUniqueSeriesIdentifier();
+
+  m_SeriesIndex->refineTags.insert({ gdcm::Tag(0x0020, 0x0011),
+                                     gdcm::Tag(0x0018, 0x0024),
+                                     gdcm::Tag(0x0018, 0x0050),
+                                     gdcm::Tag(0x0028, 0x0010),
+                                     gdcm::Tag(0x0028, 0x0011) });
+  m_SeriesIndex->refineHistory += "default;";
 }
 } // namespace itk
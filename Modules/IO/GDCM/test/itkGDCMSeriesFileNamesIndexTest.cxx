@@ -0,0 +1,197 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkGDCMImageIO.h"
+#include "itkGDCMSeriesFileNames.h"
+#include "itkImageFileWriter.h"
+#include "itkMetaDataObject.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+using ImageType = itk::Image<short, 2>;
+using FileNamesContainerType = itk::GDCMSeriesFileNames::FileNamesContainerType;
+
+const std::string SeriesA = "1.2.826.0.1.3680043.2.1125.1.1";
+const std::string SeriesB = "1.2.826.0.1.3680043.2.1125.1.2";
+
+// Write a small slice of a series at the given position along z
+void
+WriteSlice(const std::string & fileName,
+           const std::string & seriesUID,
+           double              z,
+           int                 instanceNumber,
+           unsigned int        size = 8)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(size));
+  image->Allocate();
+  image->FillBuffer(static_cast<short>(instanceNumber));
+
+  itk::MetaDataDictionary & dictionary = image->GetMetaDataDictionary();
+  std::ostringstream        position;
+  position << "0\\0\\" << z;
+  itk::EncapsulateMetaData<std::string>(dictionary, "0008|0060", "CT");
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|000e", seriesUID);
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|0032", position.str());
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|0037", "1\\0\\0\\0\\1\\0");
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|0013", std::to_string(instanceNumber));
+
+  auto io = itk::GDCMImageIO::New();
+  io->KeepOriginalUIDOn();
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetImageIO(io);
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->Update();
+}
+
+bool
+CheckFileNames(itk::GDCMSeriesFileNames *       seriesFileNames,
+               const std::string &              seriesUID,
+               const std::string &              directory,
+               const std::vector<std::string> & expected)
+{
+  const FileNamesContainerType & fileNames = seriesFileNames->GetFileNames(seriesUID);
+  bool                           equal = fileNames.size() == expected.size();
+  for (size_t i = 0; equal && i < fileNames.size(); ++i)
+  {
+    equal = itksys::SystemTools::CollapseFullPath(fileNames[i]) ==
+            itksys::SystemTools::CollapseFullPath(directory + '/' + expected[i]);
+  }
+  if (!equal)
+  {
+    std::cerr << "Unexpected files of series " << seriesUID << ":";
+    for (const std::string & fileName : fileNames)
+    {
+      std::cerr << ' ' << fileName;
+    }
+    std::cerr << std::endl;
+  }
+  return equal;
+}
+
+itk::GDCMSeriesFileNames::Pointer
+Scan(const std::string & directory, const std::string & indexFileName, itk::ThreadIdType numberOfWorkUnits)
+{
+  auto seriesFileNames = itk::GDCMSeriesFileNames::New();
+  seriesFileNames->SetUseSeriesDetails(false);
+  seriesFileNames->SetIndexFileName(indexFileName);
+  seriesFileNames->SetNumberOfWorkUnits(numberOfWorkUnits);
+  seriesFileNames->SetInputDirectory(directory);
+  return seriesFileNames;
+}
+} // namespace
+
+int
+itkGDCMSeriesFileNamesIndexTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " OutputTestDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string directory = std::string(argv[1]) + "/itkGDCMSeriesFileNamesIndexTest";
+  const std::string indexFileName = std::string(argv[1]) + "/itkGDCMSeriesFileNamesIndexTest.index";
+  itksys::SystemTools::RemoveADirectory(directory);
+  itksys::SystemTools::MakeDirectory(directory);
+  itksys::SystemTools::RemoveFile(indexFileName);
+
+  // The names of the files of series A do not follow their positions,
+  // the slices of series B share a position and are ordered by
+  // instance number.
+  WriteSlice(directory + "/a1.dcm", SeriesA, 7.5, 1);
+  WriteSlice(directory + "/a2.dcm", SeriesA, 0.0, 2);
+  WriteSlice(directory + "/a3.dcm", SeriesA, 5.0, 3);
+  WriteSlice(directory + "/a4.dcm", SeriesA, 2.5, 4);
+  WriteSlice(directory + "/b1.dcm", SeriesB, 1.0, 3);
+  WriteSlice(directory + "/b2.dcm", SeriesB, 1.0, 1);
+  WriteSlice(directory + "/b3.dcm", SeriesB, 1.0, 2);
+  {
+    std::ofstream notDicom(directory + "/notes.txt");
+    notDicom << "Not a DICOM file" << std::endl;
+  }
+  const std::vector<std::string> expectedA = { "a2.dcm", "a4.dcm", "a3.dcm", "a1.dcm" };
+  const std::vector<std::string> expectedB = { "b2.dcm", "b3.dcm", "b1.dcm" };
+
+  int result = EXIT_SUCCESS;
+
+  // Without an index file, every file is parsed
+  {
+    auto seriesFileNames = Scan(directory, "", 2);
+    ITK_EXERCISE_BASIC_OBJECT_METHODS(seriesFileNames, GDCMSeriesFileNames, ProcessObject);
+    ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetNumberOfParsedFiles(), 8);
+
+    const itk::GDCMSeriesFileNames::SeriesUIDContainerType & seriesUIDs = seriesFileNames->GetSeriesUIDs();
+    ITK_TEST_EXPECT_EQUAL(seriesUIDs.size(), 2);
+    ITK_TEST_EXPECT_EQUAL(seriesUIDs[0], SeriesA);
+    ITK_TEST_EXPECT_EQUAL(seriesUIDs[1], SeriesB);
+    if (!CheckFileNames(seriesFileNames, SeriesA, directory, expectedA) ||
+        !CheckFileNames(seriesFileNames, SeriesB, directory, expectedB))
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // The first scan fills the index file, the next one only reads it
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3 })
+  {
+    auto seriesFileNames = Scan(directory, indexFileName, numberOfWorkUnits);
+    ITK_TEST_SET_GET_VALUE(indexFileName, seriesFileNames->GetIndexFileName());
+    ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetNumberOfParsedFiles(), numberOfWorkUnits == 1 ? 8 : 0);
+    ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetSeriesUIDs().size(), 2);
+    if (!CheckFileNames(seriesFileNames, SeriesA, directory, expectedA) ||
+        !CheckFileNames(seriesFileNames, SeriesB, directory, expectedB))
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // A modified file is parsed again, a removed one leaves its series
+  WriteSlice(directory + "/a2.dcm", SeriesA, 6.0, 2, 10);
+  itksys::SystemTools::RemoveFile(directory + "/b3.dcm");
+  {
+    auto seriesFileNames = Scan(directory, indexFileName, 2);
+    ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetNumberOfParsedFiles(), 1);
+    if (!CheckFileNames(seriesFileNames, SeriesA, directory, { "a4.dcm", "a3.dcm", "a2.dcm", "a1.dcm" }) ||
+        !CheckFileNames(seriesFileNames, SeriesB, directory, { "b2.dcm", "b1.dcm" }))
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+  {
+    auto seriesFileNames = Scan(directory, indexFileName, 2);
+    ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetNumberOfParsedFiles(), 0);
+  }
+
+  // The index depends on the settings identifying the series
+  {
+    auto seriesFileNames = itk::GDCMSeriesFileNames::New();
+    seriesFileNames->SetIndexFileName(indexFileName);
+    seriesFileNames->SetInputDirectory(directory);
+    ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetNumberOfParsedFiles(), 7);
+    ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetSeriesUIDs().size(), 2);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
@@ -28,6 +28,7 @@
 #include "itkMetaDataObjectBase.h"
 #include "itkMetaDataDictionary.h"
 #include <memory> // For unique_ptr.
+#include <vector>
 
 // itk namespace first suppresses
 // kwstyle error for the H5 namespace below
@@ -78,6 +79,12 @@ namespace itk
  * \li \/ITKImage\/\<name\>\/MetaData\/\<item-name\>
  *                             Dataset containing data for item-name
  *                             in the MetaDataDictionary
+ * \li \/ITKImage\/\<name\>\/ResolutionLevels\/\<k\>
+ *                             Group of the resolution level k > 0 of a
+ *                             multi-resolution file, with its own
+ *                             Origin, Spacing, Dimension and VoxelData.
+ *                             Each level halves the extents of the
+ *                             previous one, averaging blocks of pixels.
  * re-arrangement.
  *
  *
@@ -138,6 +145,41 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Shape of a chunk, in image (fastest moving first) order. */
+  using ChunkSizeType = std::vector<SizeValueType>;
+
+  /** Set/Get the shape, in pixels, of the chunks in which the voxel
+   * data are stored, in image order. The components of a pixel always
+   * share a chunk, and the extents are clamped to the image size. An
+   * empty shape, the default, selects near-cubic chunks of about 1 MiB
+   * by halving the largest extent of the image until a chunk fits. */
+  itkSetMacro(ChunkSize, ChunkSizeType);
+  itkGetConstReferenceMacro(ChunkSize, ChunkSizeType);
+
+  /** Set/Get the largest size, in bytes, of the chunk cache of the voxel
+   * data set. The cache is sized to hold the chunks overlapping the
+   * region read, or a layer of chunks when writing, so that the chunks
+   * shared by successive regions are decompressed or compressed only
+   * once. Zero keeps the default cache of the HDF5 library. Defaults to
+   * 64 MiB. */
+  itkSetMacro(MaximumChunkCacheSize, SizeValueType);
+  itkGetConstMacro(MaximumChunkCacheSize, SizeValueType);
+
+  /** Set/Get the number of work units compressing and decompressing the
+   * chunks of a region concurrently. Zero, the default, uses the global
+   * default number of threads. */
+  itkSetMacro(NumberOfWorkUnits, unsigned int);
+  itkGetConstMacro(NumberOfWorkUnits, unsigned int);
+
+  /** The coarser resolution levels are written in one pass with the full
+   * resolution image, which must then be written at once, and any of
+   * them is read without reading the full resolution. */
+  bool
+  SupportsResolutionLevels() const override
+  {
+    return true;
+  }
+
 protected:
   HDF5ImageIO();
   ~HDF5ImageIO() override;
@@ -148,6 +190,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the chunk size, the chunk cache size and the number of work units. */
+  LightObject::Pointer
+  InternalClone() const override;
+
 private:
   void
   WriteString(const std::string & path, const std::string & value);
@@ -204,6 +250,24 @@ private:
   void
   SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpace);
 
+  /** The chunk shape of a voxel data set to write, in image order. */
+  ChunkSizeType
+  ComputeChunkSize(const std::vector<SizeValueType> & dimensions) const;
+
+  /** Write the coarser resolution levels, downsampled from the full
+   * resolution image. */
+  void
+  WriteResolutionLevels(const void * buffer);
+
+  /** Read or write the chunks of the IO region directly, decompressing
+   * or compressing them concurrently. Return false, having done
+   * nothing, when the data set is not stored in chunks which are
+   * uncompressed or compressed by deflate only. */
+  bool
+  ReadChunks(void * buffer);
+  bool
+  WriteChunks(const void * buffer);
+
   /* A convenience function to ensure that the
    * state of the HDF5ImageIO object is returned
    * to a state similar to constructing a new
@@ -216,7 +280,11 @@ private:
 
   std::unique_ptr<H5::H5File>  m_H5File;
   std::unique_ptr<H5::DataSet> m_VoxelDataSet;
+  std::string                  m_VoxelDataName{};
   bool                         m_ImageInformationWritten{ false };
+  ChunkSizeType                m_ChunkSize{};
+  SizeValueType                m_MaximumChunkCacheSize{ SizeValueType{ 64 } << 20 };
+  unsigned int                 m_NumberOfWorkUnits{ 0 };
 };
 } // end namespace itk
 
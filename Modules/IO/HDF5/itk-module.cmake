@@ -10,9 +10,11 @@ itk_module(
   ITKIOImageBase
   PRIVATE_DEPENDS
   ITKHDF5
+  ITKZLIB
   TEST_DEPENDS
   ITKTestKernel
   ITKImageSources
+  ITKHDF5
   FACTORY_NAMES
   ImageIO::HDF5
   DESCRIPTION
@@ -21,9 +21,14 @@
 #include "itkArray.h"
 #include "itksys/SystemTools.hxx"
 #include "itk_H5Cpp.h"
+#include "itk_zlib.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
 
 namespace itk
 {
@@ -49,12 +54,36 @@ HDF5ImageIO::~HDF5ImageIO()
   this->ResetToInitialState();
 }
 
+LightObject::Pointer
+HDF5ImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_ChunkSize = m_ChunkSize;
+  rval->m_MaximumChunkCacheSize = m_MaximumChunkCacheSize;
+  rval->m_NumberOfWorkUnits = m_NumberOfWorkUnits;
+  return loPtr;
+}
+
 void
 HDF5ImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   // just prints out the pointer value.
   os << indent << "H5File: " << m_H5File.get() << std::endl;
+  os << indent << "ChunkSize: ";
+  for (const SizeValueType extent : m_ChunkSize)
+  {
+    os << extent << ' ';
+  }
+  os << std::endl;
+  os << indent << "MaximumChunkCacheSize: " << m_MaximumChunkCacheSize << std::endl;
+  os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
 }
 
 //
@@ -71,6 +100,7 @@ const std::string Dimensions("/Dimension");
 const std::string VoxelType("/VoxelType");
 const std::string VoxelData("/VoxelData");
 const std::string MetaDataName("/MetaData");
+const std::string ResolutionLevelsName("/ResolutionLevels");
 
 template <typename TScalar>
 H5::PredType
@@ -259,6 +289,383 @@ doesAttrExist(const H5::H5Object & object, const char * const name)
   return (H5Aexists(object.getId(), name) > 0 ? true : false);
 }
 
+// Size, in bytes, of the chunks selected when no chunk shape is set.
+constexpr size_t AutomaticChunkBytes = size_t{ 1 } << 20;
+
+// Chunks are compressed and decompressed by batches of at most this
+// many bytes per work unit, bounding the temporary memory.
+constexpr size_t MaximumChunkBytesPerWorkUnit = size_t{ 16 } << 20;
+
+// A hyperslab of the voxel data, in HDF5 (slowest moving first) order.
+struct Hyperslab
+{
+  std::vector<hsize_t> offset;
+  std::vector<hsize_t> count;
+};
+
+// The hyperslab of an image region. The components of the pixels are
+// the fastest moving HDF5 dimension.
+Hyperslab
+RegionToHyperslab(const ImageIORegion & region, unsigned int numberOfDimensions, unsigned int numberOfComponents)
+{
+  const unsigned int HDFDim = numberOfDimensions + (numberOfComponents > 1 ? 1 : 0);
+  Hyperslab          slab{ std::vector<hsize_t>(HDFDim, 0), std::vector<hsize_t>(HDFDim, 1) };
+
+  unsigned int i = 0;
+  if (numberOfComponents > 1)
+  {
+    slab.count[HDFDim - 1] = numberOfComponents;
+    ++i;
+  }
+  for (unsigned int j = 0; j < region.GetImageDimension() && i < HDFDim; ++i, ++j)
+  {
+    slab.offset[HDFDim - i - 1] = region.GetIndex(j);
+    slab.count[HDFDim - i - 1] = region.GetSize(j);
+  }
+  return slab;
+}
+
+// The number of chunks overlapping a hyperslab.
+size_t
+NumberOfOverlappingChunks(const std::vector<hsize_t> & chunkDims, const Hyperslab & slab)
+{
+  size_t numberOfChunks = 1;
+  for (size_t d = 0; d < chunkDims.size(); ++d)
+  {
+    numberOfChunks *= (slab.offset[d] + slab.count[d] - 1) / chunkDims[d] - slab.offset[d] / chunkDims[d] + 1;
+  }
+  return numberOfChunks;
+}
+
+// The offsets of the chunks overlapping a hyperslab, in storage order.
+std::vector<std::vector<hsize_t>>
+OverlappingChunks(const std::vector<hsize_t> & chunkDims, const Hyperslab & slab)
+{
+  const size_t         rank = chunkDims.size();
+  std::vector<hsize_t> first(rank);
+  std::vector<hsize_t> last(rank);
+  for (size_t d = 0; d < rank; ++d)
+  {
+    first[d] = slab.offset[d] / chunkDims[d] * chunkDims[d];
+    last[d] = (slab.offset[d] + slab.count[d] - 1) / chunkDims[d] * chunkDims[d];
+  }
+
+  std::vector<std::vector<hsize_t>> chunks;
+  std::vector<hsize_t>              offset = first;
+  for (;;)
+  {
+    chunks.push_back(offset);
+    size_t d = rank;
+    for (; d > 0; --d)
+    {
+      if (offset[d - 1] < last[d - 1])
+      {
+        offset[d - 1] += chunkDims[d - 1];
+        break;
+      }
+      offset[d - 1] = first[d - 1];
+    }
+    if (d == 0)
+    {
+      return chunks;
+    }
+  }
+}
+
+// Copy the part of a chunk overlapping a hyperslab from the chunk
+// buffer to the hyperslab buffer, or the other way round.
+void
+CopyChunkOverlap(const std::vector<hsize_t> & chunkOffset,
+                 const std::vector<hsize_t> & chunkDims,
+                 const Hyperslab &            slab,
+                 size_t                       elementSize,
+                 char *                       chunk,
+                 char *                       slabBuffer,
+                 bool                         toChunk)
+{
+  const size_t         rank = chunkDims.size();
+  std::vector<hsize_t> begin(rank);
+  std::vector<hsize_t> end(rank);
+  for (size_t d = 0; d < rank; ++d)
+  {
+    begin[d] = std::max(chunkOffset[d], slab.offset[d]);
+    end[d] = std::min(chunkOffset[d] + chunkDims[d], slab.offset[d] + slab.count[d]);
+  }
+  const size_t runBytes = (end[rank - 1] - begin[rank - 1]) * elementSize;
+
+  // Copy the overlap run by run along the fastest moving dimension
+  std::vector<hsize_t> position = begin;
+  for (;;)
+  {
+    size_t chunkPosition = 0;
+    size_t slabPosition = 0;
+    for (size_t d = 0; d < rank; ++d)
+    {
+      chunkPosition = chunkPosition * chunkDims[d] + (position[d] - chunkOffset[d]);
+      slabPosition = slabPosition * slab.count[d] + (position[d] - slab.offset[d]);
+    }
+    if (toChunk)
+    {
+      std::memcpy(chunk + chunkPosition * elementSize, slabBuffer + slabPosition * elementSize, runBytes);
+    }
+    else
+    {
+      std::memcpy(slabBuffer + slabPosition * elementSize, chunk + chunkPosition * elementSize, runBytes);
+    }
+
+    size_t d = rank - 1;
+    for (; d > 0; --d)
+    {
+      if (++position[d - 1] < end[d - 1])
+      {
+        break;
+      }
+      position[d - 1] = begin[d - 1];
+    }
+    if (d == 0)
+    {
+      return;
+    }
+  }
+}
+
+size_t
+NextPrime(size_t n)
+{
+  for (;; ++n)
+  {
+    bool isPrime = n > 1;
+    for (size_t divisor = 2; isPrime && divisor * divisor <= n; ++divisor)
+    {
+      isPrime = n % divisor != 0;
+    }
+    if (isPrime)
+    {
+      return n;
+    }
+  }
+}
+
+// Access properties of the voxel data set, with a chunk cache holding
+// the given number of chunks up to a maximum size.
+H5::DSetAccPropList
+ChunkCacheAccessList(size_t numberOfChunks, size_t chunkBytes, SizeValueType maximumCacheSize)
+{
+  H5::DSetAccPropList accessList;
+  if (maximumCacheSize > 0)
+  {
+    const size_t cacheSize = std::min<size_t>(numberOfChunks * chunkBytes, maximumCacheSize);
+    // HDF5 recommends a prime number of hash slots, about a hundred
+    // times the number of chunks in the cache. Fully read or written
+    // chunks are evicted first.
+    const size_t numberOfCachedChunks = std::max<size_t>(1, cacheSize / chunkBytes);
+    accessList.setChunkCache(NextPrime(std::min<size_t>(100 * numberOfCachedChunks, 65536)), cacheSize, 1.0);
+  }
+  return accessList;
+}
+
+// Whether a data set is stored in chunks which are either uncompressed
+// or compressed by deflate only, so that they can be read and written
+// directly. Returns the number of filters and the compression level.
+bool
+HasDirectChunkLayout(const H5::DSetCreatPropList & createList, int & numberOfFilters, unsigned int & level)
+{
+  if (createList.getLayout() != H5D_CHUNKED)
+  {
+    return false;
+  }
+  numberOfFilters = createList.getNfilters();
+  level = 0;
+  if (numberOfFilters == 0)
+  {
+    return true;
+  }
+  size_t             numberOfValues = 1;
+  unsigned int       values[1] = { 0 };
+  const H5Z_filter_t filter =
+    H5Pget_filter2(createList.getId(), 0, nullptr, &numberOfValues, values, 0, nullptr, nullptr);
+  level = values[0];
+  return numberOfFilters == 1 && filter == H5Z_FILTER_DEFLATE;
+}
+
+// The extents of the voxel data set of an image, in HDF5 order. The
+// components of the pixels are the fastest moving dimension.
+std::vector<hsize_t>
+VoxelDataDims(const std::vector<SizeValueType> & dimensions, unsigned int numberOfComponents)
+{
+  std::vector<hsize_t> dims(dimensions.rbegin(), dimensions.rend());
+  if (numberOfComponents > 1)
+  {
+    dims.push_back(numberOfComponents);
+  }
+  return dims;
+}
+
+// The grid of a resolution level of a multi-resolution file.
+struct LevelGeometry
+{
+  std::vector<SizeValueType> dimensions;
+  std::vector<double>        spacing;
+  std::vector<double>        origin;
+};
+
+// The resolution levels of an image, the first one being the full
+// resolution. Each level halves the extents of the previous one which
+// are larger than one, its pixels being centered on the blocks of pixels
+// they average. There are fewer levels than requested when a level has
+// no extent left to halve.
+std::vector<LevelGeometry>
+ComputeResolutionLevels(const LevelGeometry &                    fullResolution,
+                        const std::vector<std::vector<double>> & direction,
+                        unsigned int                             numberOfLevels)
+{
+  std::vector<LevelGeometry> levels{ fullResolution };
+  while (levels.size() < numberOfLevels)
+  {
+    const LevelGeometry & previous = levels.back();
+    LevelGeometry         level = previous;
+    bool                  isHalved = false;
+    for (size_t i = 0; i < previous.dimensions.size(); ++i)
+    {
+      if (previous.dimensions[i] > 1)
+      {
+        isHalved = true;
+        level.dimensions[i] = (previous.dimensions[i] + 1) / 2;
+        level.spacing[i] = 2.0 * previous.spacing[i];
+        for (size_t j = 0; j < level.origin.size(); ++j)
+        {
+          level.origin[j] += 0.5 * previous.spacing[i] * direction[i][j];
+        }
+      }
+    }
+    if (!isHalved)
+    {
+      break;
+    }
+    levels.push_back(std::move(level));
+  }
+  return levels;
+}
+
+// Average the blocks of up to 2^N pixels of the input level into the
+// pixels of the next level.
+template <typename TComponent>
+void
+DownsampleLevel(const TComponent *                 input,
+                const std::vector<SizeValueType> & inputDims,
+                TComponent *                       output,
+                const std::vector<SizeValueType> & outputDims,
+                unsigned int                       numberOfComponents,
+                MultiThreaderBase *                multiThreader)
+{
+  const size_t               numberOfDimensions = inputDims.size();
+  std::vector<SizeValueType> inputStrides(numberOfDimensions, numberOfComponents);
+  for (size_t d = 1; d < numberOfDimensions; ++d)
+  {
+    inputStrides[d] = inputStrides[d - 1] * inputDims[d - 1];
+  }
+  SizeValueType numberOfLines = 1;
+  for (size_t d = 1; d < numberOfDimensions; ++d)
+  {
+    numberOfLines *= outputDims[d];
+  }
+  const SizeValueType lineLength = numberOfDimensions > 0 ? outputDims[0] : 1;
+
+  const auto downsampleLine = [&](SizeValueType line) {
+    // The first input pixel of the blocks of the line
+    std::vector<SizeValueType> index(numberOfDimensions, 0);
+    SizeValueType              lineOffset = 0;
+    for (size_t d = 1, rest = line; d < numberOfDimensions; ++d)
+    {
+      index[d] = 2 * (rest % outputDims[d]);
+      rest /= outputDims[d];
+      lineOffset += index[d] * inputStrides[d];
+    }
+    TComponent * outputPixel = output + line * lineLength * numberOfComponents;
+    for (SizeValueType x = 0; x < lineLength; ++x, outputPixel += numberOfComponents)
+    {
+      index[0] = 2 * x;
+      for (unsigned int c = 0; c < numberOfComponents; ++c)
+      {
+        double        sum = 0.0;
+        unsigned int  count = 0;
+        const size_t  numberOfNeighbors = size_t{ 1 } << numberOfDimensions;
+        SizeValueType baseOffset = lineOffset + c;
+        if (numberOfDimensions > 0)
+        {
+          baseOffset += index[0] * inputStrides[0];
+        }
+        for (size_t neighbor = 0; neighbor < numberOfNeighbors; ++neighbor)
+        {
+          SizeValueType offset = baseOffset;
+          bool          isInside = true;
+          for (size_t d = 0; isInside && d < numberOfDimensions; ++d)
+          {
+            if ((neighbor >> d) & 1)
+            {
+              isInside = inputDims[d] > outputDims[d] && index[d] + 1 < inputDims[d];
+              offset += inputStrides[d];
+            }
+          }
+          if (isInside)
+          {
+            sum += static_cast<double>(input[offset]);
+            ++count;
+          }
+        }
+        const double mean = sum / count;
+        if constexpr (std::is_integral_v<TComponent>)
+        {
+          outputPixel[c] = static_cast<TComponent>(std::round(mean));
+        }
+        else
+        {
+          outputPixel[c] = static_cast<TComponent>(mean);
+        }
+      }
+    }
+  };
+  multiThreader->ParallelizeArray(0, numberOfLines, downsampleLine, nullptr);
+}
+
+bool
+DownsampleLevel(IOComponentEnum                    componentType,
+                const void *                       input,
+                const std::vector<SizeValueType> & inputDims,
+                void *                             output,
+                const std::vector<SizeValueType> & outputDims,
+                unsigned int                       numberOfComponents,
+                MultiThreaderBase *                multiThreader)
+{
+#define ITK_HDF5_DOWNSAMPLE_CASE(componentEnum, TComponent)                                   \
+  case IOComponentEnum::componentEnum:                                                        \
+    DownsampleLevel(static_cast<const TComponent *>(input),                                   \
+                    inputDims,                                                                \
+                    static_cast<TComponent *>(output),                                        \
+                    outputDims,                                                               \
+                    numberOfComponents,                                                       \
+                    multiThreader);                                                           \
+    return true
+  switch (componentType)
+  {
+    ITK_HDF5_DOWNSAMPLE_CASE(UCHAR, unsigned char);
+    ITK_HDF5_DOWNSAMPLE_CASE(CHAR, char);
+    ITK_HDF5_DOWNSAMPLE_CASE(USHORT, unsigned short);
+    ITK_HDF5_DOWNSAMPLE_CASE(SHORT, short);
+    ITK_HDF5_DOWNSAMPLE_CASE(UINT, unsigned int);
+    ITK_HDF5_DOWNSAMPLE_CASE(INT, int);
+    ITK_HDF5_DOWNSAMPLE_CASE(ULONG, unsigned long);
+    ITK_HDF5_DOWNSAMPLE_CASE(LONG, long);
+    ITK_HDF5_DOWNSAMPLE_CASE(ULONGLONG, unsigned long long);
+    ITK_HDF5_DOWNSAMPLE_CASE(LONGLONG, long long);
+    ITK_HDF5_DOWNSAMPLE_CASE(FLOAT, float);
+    ITK_HDF5_DOWNSAMPLE_CASE(DOUBLE, double);
+    default:
+      return false;
+  }
+#undef ITK_HDF5_DOWNSAMPLE_CASE
+}
+
 } // namespace
 
 void
@@ -684,8 +1091,24 @@ HDF5ImageIO::ReadImageInformation()
     auto numDims = static_cast<int>(directions.size());
     this->SetNumberOfDimensions(numDims);
 
+    // The coarser levels of a multi-resolution file have their own
+    // grid and voxel data, and share the rest with the full resolution.
+    std::string  levelsGroupName(groupName);
+    unsigned int numberOfLevels = 1;
+    levelsGroupName += ResolutionLevelsName;
+    if (H5Lexists(m_H5File->getId(), levelsGroupName.c_str(), H5P_DEFAULT) > 0)
+    {
+      numberOfLevels += static_cast<unsigned int>(m_H5File->openGroup(levelsGroupName).getNumObjs());
+    }
+    this->SetNumberOfResolutionLevels(numberOfLevels);
+    std::string levelGroupName(groupName);
+    if (m_ResolutionLevel > 0 && m_ResolutionLevel < numberOfLevels)
+    {
+      levelGroupName = levelsGroupName + "/" + std::to_string(m_ResolutionLevel);
+    }
+
     // H5::Group instanceGroup(m_H5File->openGroup(groupName));
-    std::string OriginName(groupName);
+    std::string OriginName(levelGroupName);
     OriginName += Origin;
     this->m_Origin = this->ReadVector<double>(OriginName);
 
@@ -694,7 +1117,7 @@ HDF5ImageIO::ReadImageInformation()
       this->SetDirection(i, directions[i]);
     }
 
-    std::string SpacingName(groupName);
+    std::string SpacingName(levelGroupName);
     SpacingName += Spacing;
     std::vector<double> spacing = this->ReadVector<double>(SpacingName);
     for (int i = 0; i < numDims; ++i)
@@ -702,7 +1125,7 @@ HDF5ImageIO::ReadImageInformation()
       this->SetSpacing(i, spacing[i]);
     }
 
-    std::string DimensionsName(groupName);
+    std::string DimensionsName(levelGroupName);
     DimensionsName += Dimensions;
 
     {
@@ -713,9 +1136,8 @@ HDF5ImageIO::ReadImageInformation()
       }
     }
 
-    std::string VoxelDataName(groupName);
-    VoxelDataName += VoxelData;
-    *(m_VoxelDataSet) = m_H5File->openDataSet(VoxelDataName);
+    m_VoxelDataName = levelGroupName + VoxelData;
+    *(m_VoxelDataSet) = m_H5File->openDataSet(m_VoxelDataName);
     H5::DataSet   imageSet = *(m_VoxelDataSet);
     H5::DataSpace imageSpace = imageSet.getSpace();
     //
@@ -911,56 +1333,232 @@ HDF5ImageIO::ReadImageInformation()
     itkExceptionMacro("Unspecified error occured during ReadImageInformation " << this->GetFileName() << " with "
                                                                                << this->GetNameOfClass());
   }
+  if (m_ResolutionLevel >= m_NumberOfResolutionLevels)
+  {
+    itkExceptionMacro("Cannot read the resolution level " << m_ResolutionLevel << " of " << m_FileName
+                                                          << ", which has " << m_NumberOfResolutionLevels
+                                                          << " resolution levels");
+  }
 }
 
 void
 HDF5ImageIO::SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpace)
 {
-  ImageIORegion            regionToRead = this->GetIORegion();
-  ImageIORegion::SizeType  size = regionToRead.GetSize();
-  ImageIORegion::IndexType start = regionToRead.GetIndex();
-  //
-  int numComponents = this->GetNumberOfComponents();
+  const Hyperslab slab =
+    RegionToHyperslab(this->GetIORegion(), this->GetNumberOfDimensions(), this->GetNumberOfComponents());
 
-  const int HDFDim(this->GetNumberOfDimensions() + (numComponents > 1 ? 1 : 0));
+  slabSpace->setExtentSimple(static_cast<int>(slab.count.size()), slab.count.data());
+  imageSpace->selectHyperslab(H5S_SELECT_SET, slab.count.data(), slab.offset.data());
+}
 
-  const auto offset = make_unique_for_overwrite<hsize_t[]>(HDFDim);
-  const auto HDFSize = make_unique_for_overwrite<hsize_t[]>(HDFDim);
-  const int  limit = regionToRead.GetImageDimension();
-  //
-  // fastest moving dimension is intra-voxel
-  // index
-  int i = 0;
-  if (numComponents > 1)
+HDF5ImageIO::ChunkSizeType
+HDF5ImageIO::ComputeChunkSize(const std::vector<SizeValueType> & dimensions) const
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  ChunkSizeType      chunkSize(numberOfDimensions);
+
+  if (!m_ChunkSize.empty())
   {
-    offset[HDFDim - 1] = 0;
-    HDFSize[HDFDim - 1] = numComponents;
-    ++i;
+    if (m_ChunkSize.size() != numberOfDimensions)
+    {
+      itkExceptionMacro("The chunk size has " << m_ChunkSize.size() << " extents but the image has "
+                                              << numberOfDimensions << " dimensions");
+    }
+    for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+      chunkSize[i] = std::clamp<SizeValueType>(m_ChunkSize[i], 1, std::max<SizeValueType>(1, dimensions[i]));
+    }
+    return chunkSize;
   }
 
-  for (int j = 0; j < limit && i < HDFDim; ++i, ++j)
+  // Halve the largest extent until the chunk fits, which keeps the
+  // chunks close to cubes whatever the region read later.
+  size_t chunkBytes = this->GetComponentSize() * this->GetNumberOfComponents();
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
   {
-    offset[HDFDim - i - 1] = start[j];
-    HDFSize[HDFDim - i - 1] = size[j];
+    chunkSize[i] = std::max<SizeValueType>(1, dimensions[i]);
+    chunkBytes *= chunkSize[i];
   }
+  while (chunkBytes > AutomaticChunkBytes && numberOfDimensions > 0)
+  {
+    const auto largest = std::max_element(chunkSize.begin(), chunkSize.end());
+    if (*largest == 1)
+    {
+      break;
+    }
+    chunkBytes = chunkBytes / *largest * ((*largest + 1) / 2);
+    *largest = (*largest + 1) / 2;
+  }
+  return chunkSize;
+}
 
-  while (i < HDFDim)
+bool
+HDF5ImageIO::ReadChunks(void * buffer)
+{
+#if !H5_VERSION_GE(1, 10, 5)
+  // Direct chunk reads and chunk queries by coordinates require HDF5 1.10.5
+  (void)buffer;
+  return false;
+#else
+  const H5::DSetCreatPropList createList = m_VoxelDataSet->getCreatePlist();
+  int                         numberOfFilters = 0;
+  unsigned int                level = 0;
+  if (!HasDirectChunkLayout(createList, numberOfFilters, level))
   {
-    offset[HDFDim - i - 1] = 0;
-    HDFSize[HDFDim - i - 1] = 1;
-    ++i;
+    return false;
+  }
+
+  const Hyperslab slab =
+    RegionToHyperslab(this->GetIORegion(), this->GetNumberOfDimensions(), this->GetNumberOfComponents());
+  const size_t rank = slab.count.size();
+  if (m_VoxelDataSet->getSpace().getSimpleExtentNdims() != static_cast<int>(rank))
+  {
+    return false;
+  }
+  for (const hsize_t count : slab.count)
+  {
+    if (count == 0)
+    {
+      return true;
+    }
+  }
+
+  const H5::DataType   voxelType = m_VoxelDataSet->getDataType();
+  const size_t         elementSize = voxelType.getSize();
+  std::vector<hsize_t> chunkDims(rank);
+  createList.getChunk(static_cast<int>(rank), chunkDims.data());
+  size_t chunkBytes = elementSize;
+  for (const hsize_t extent : chunkDims)
+  {
+    chunkBytes *= extent;
+  }
+
+  // The chunks which were never written hold the fill value
+  std::vector<char> fillValue(elementSize, 0);
+  H5Pget_fill_value(createList.getId(), voxelType.getId(), fillValue.data());
+
+  const hid_t                             dataSetId = m_VoxelDataSet->getId();
+  const std::vector<std::vector<hsize_t>> chunks = OverlappingChunks(chunkDims, slab);
+
+  auto multiThreader = MultiThreaderBase::New();
+  if (m_NumberOfWorkUnits > 0)
+  {
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
   }
+  const size_t chunksPerBatch =
+    std::max<size_t>(1, MaximumChunkBytesPerWorkUnit * multiThreader->GetNumberOfWorkUnits() / chunkBytes);
+
+  // The HDF5 library is not thread safe: the stored chunks of a batch
+  // are read serially, then decompressed and copied concurrently.
+  for (size_t batchBegin = 0; batchBegin < chunks.size(); batchBegin += chunksPerBatch)
+  {
+    const size_t                   batchSize = std::min(chunksPerBatch, chunks.size() - batchBegin);
+    std::vector<std::vector<char>> storedChunks(batchSize);
+    std::vector<uint32_t>          filterMasks(batchSize, 0);
+    for (size_t k = 0; k < batchSize; ++k)
+    {
+      const hsize_t * chunkOffset = chunks[batchBegin + k].data();
+      unsigned int    filterMask = 0;
+      haddr_t         address = HADDR_UNDEF;
+      hsize_t         storedSize = 0;
+      if (H5Dget_chunk_info_by_coord(dataSetId, chunkOffset, &filterMask, &address, &storedSize) < 0)
+      {
+        itkExceptionMacro("Cannot query a chunk of " << m_FileName);
+      }
+      if (address == HADDR_UNDEF)
+      {
+        continue;
+      }
+      storedChunks[k].resize(storedSize);
+      if (H5Dread_chunk(dataSetId, H5P_DEFAULT, chunkOffset, &filterMasks[k], storedChunks[k].data()) < 0)
+      {
+        itkExceptionMacro("Cannot read a chunk of " << m_FileName);
+      }
+    }
+
+    std::vector<char> failed(batchSize, 0);
+    const auto        decodeChunk = [&](SizeValueType k) {
+      std::vector<char> decoded;
+      char *            chunk = storedChunks[k].data();
+      if (storedChunks[k].empty())
+      {
+        decoded.resize(chunkBytes);
+        for (size_t n = 0; n < chunkBytes; n += elementSize)
+        {
+          std::memcpy(decoded.data() + n, fillValue.data(), elementSize);
+        }
+        chunk = decoded.data();
+      }
+      else if (numberOfFilters > 0 && (filterMasks[k] & 1) == 0)
+      {
+        decoded.resize(chunkBytes);
+        auto decodedSize = static_cast<uLongf>(chunkBytes);
+        if (uncompress(reinterpret_cast<Bytef *>(decoded.data()),
+                       &decodedSize,
+                       reinterpret_cast<const Bytef *>(storedChunks[k].data()),
+                       static_cast<uLong>(storedChunks[k].size())) != Z_OK ||
+            decodedSize != chunkBytes)
+        {
+          failed[k] = 1;
+          return;
+        }
+        chunk = decoded.data();
+      }
+      else if (storedChunks[k].size() != chunkBytes)
+      {
+        failed[k] = 1;
+        return;
+      }
+      CopyChunkOverlap(chunks[batchBegin + k], chunkDims, slab, elementSize, chunk, static_cast<char *>(buffer), false);
+    };
+    multiThreader->ParallelizeArray(0, batchSize, decodeChunk, nullptr);
 
-  slabSpace->setExtentSimple(HDFDim, HDFSize.get());
-  imageSpace->selectHyperslab(H5S_SELECT_SET, HDFSize.get(), offset.get());
+    if (std::find(failed.cbegin(), failed.cend(), 1) != failed.cend())
+    {
+      itkExceptionMacro("Cannot decompress a chunk of " << m_FileName);
+    }
+  }
+  return true;
+#endif
 }
 
 void
 HDF5ImageIO::Read(void * buffer)
 {
-  ImageIORegion            regionToRead = this->GetIORegion();
-  ImageIORegion::SizeType  size = regionToRead.GetSize();
-  ImageIORegion::IndexType start = regionToRead.GetIndex();
+  if (this->ReadChunks(buffer))
+  {
+    return;
+  }
+
+  // Otherwise the chunks overlapping the region are read through the
+  // HDF5 library. The chunk cache is grown to hold them, so that the
+  // chunks shared with the next region are decompressed only once.
+  H5::DSetCreatPropList createList = m_VoxelDataSet->getCreatePlist();
+  if (createList.getLayout() == H5D_CHUNKED && m_MaximumChunkCacheSize > 0)
+  {
+    const Hyperslab slab =
+      RegionToHyperslab(this->GetIORegion(), this->GetNumberOfDimensions(), this->GetNumberOfComponents());
+    std::vector<hsize_t> chunkDims(slab.count.size());
+    createList.getChunk(static_cast<int>(chunkDims.size()), chunkDims.data());
+    size_t chunkBytes = m_VoxelDataSet->getDataType().getSize();
+    for (const hsize_t extent : chunkDims)
+    {
+      chunkBytes *= extent;
+    }
+    const size_t cacheSize = std::min<size_t>(NumberOfOverlappingChunks(chunkDims, slab) * chunkBytes,
+                                              m_MaximumChunkCacheSize);
+
+    size_t numberOfSlots = 0;
+    size_t currentCacheSize = 0;
+    double preemption = 0.0;
+    m_VoxelDataSet->getAccessPlist().getChunkCache(numberOfSlots, currentCacheSize, preemption);
+    if (cacheSize > currentCacheSize)
+    {
+      m_VoxelDataSet->close();
+      *(m_VoxelDataSet) = m_H5File->openDataSet(
+        m_VoxelDataName, ChunkCacheAccessList(NumberOfOverlappingChunks(chunkDims, slab), chunkBytes, cacheSize));
+    }
+  }
 
   H5::DataType  voxelType = m_VoxelDataSet->getDataType();
   H5::DataSpace imageSpace = m_VoxelDataSet->getSpace();
@@ -1018,6 +1616,8 @@ HDF5ImageIO::WriteImageInformation()
     return;
   }
 
+  const ChunkSizeType chunkSize = this->ComputeChunkSize(this->m_Dimensions);
+
   try
   {
     this->ResetToInitialState();
@@ -1080,21 +1680,63 @@ HDF5ImageIO::WriteImageInformation()
     H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
 
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
-    // region
     H5::DSetCreatPropList plist;
 
     // we have implicit compression enabled here?
     plist.setDeflate(this->GetCompressionLevel());
 
-    dims[0] = 1;
+    // The chunks of a layer along the slowest moving dimension are
+    // cached, so that the chunks split by successive streamed regions
+    // are compressed once.
+    const int numImageDims = this->GetNumberOfDimensions();
+    size_t    chunkBytes = dataType.getSize();
+    size_t    chunksPerLayer = 1;
+    for (int i(0), j(numImageDims - 1); i < numImageDims; i++, j--)
+    {
+      dims[j] = chunkSize[i];
+      chunkBytes *= chunkSize[i];
+      if (j > 0)
+      {
+        chunksPerLayer *= (this->m_Dimensions[i] + chunkSize[i] - 1) / chunkSize[i];
+      }
+    }
+    if (numComponents > 1)
+    {
+      chunkBytes *= numComponents;
+    }
     plist.setChunk(numDims, dims.get());
     dims.reset();
 
-    std::string VoxelDataName(ImageGroup);
-    VoxelDataName += "/0";
-    VoxelDataName += VoxelData;
-    *(m_VoxelDataSet) = m_H5File->createDataSet(VoxelDataName, dataType, imageSpace, plist);
+    m_VoxelDataName = groupName + VoxelData;
+    const H5::DSetAccPropList accessList = ChunkCacheAccessList(chunksPerLayer, chunkBytes, m_MaximumChunkCacheSize);
+    *(m_VoxelDataSet) = m_H5File->createDataSet(m_VoxelDataName, dataType, imageSpace, plist, accessList);
+
+    // The coarser resolution levels, filled by Write()
+    const std::vector<LevelGeometry> levels = ComputeResolutionLevels(
+      { this->m_Dimensions, this->m_Spacing, this->m_Origin }, this->m_Direction, m_NumberOfResolutionLevelsToWrite);
+    if (levels.size() > 1)
+    {
+      std::string levelsGroupName(groupName);
+      levelsGroupName += ResolutionLevelsName;
+      m_H5File->createGroup(levelsGroupName);
+    }
+    for (size_t k = 1; k < levels.size(); ++k)
+    {
+      const std::string levelGroupName = groupName + ResolutionLevelsName + "/" + std::to_string(k);
+      m_H5File->createGroup(levelGroupName);
+      this->WriteVector(levelGroupName + Origin, levels[k].origin);
+      this->WriteVector(levelGroupName + Spacing, levels[k].spacing);
+      this->WriteVector(levelGroupName + Dimensions, levels[k].dimensions);
+
+      const std::vector<hsize_t> levelDims = VoxelDataDims(levels[k].dimensions, numComponents);
+      const std::vector<hsize_t> levelChunkDims =
+        VoxelDataDims(this->ComputeChunkSize(levels[k].dimensions), numComponents);
+      H5::DSetCreatPropList levelList;
+      levelList.setDeflate(this->GetCompressionLevel());
+      levelList.setChunk(static_cast<int>(levelChunkDims.size()), levelChunkDims.data());
+      const H5::DataSpace levelSpace(static_cast<int>(levelDims.size()), levelDims.data());
+      m_H5File->createDataSet(levelGroupName + VoxelData, dataType, levelSpace, levelList);
+    }
     std::string MetaDataGroupName(groupName);
     MetaDataGroupName += MetaDataName;
     m_H5File->createGroup(MetaDataGroupName);
@@ -1270,6 +1912,19 @@ HDF5ImageIO::WriteImageInformation()
 void
 HDF5ImageIO::Write(const void * buffer)
 {
+  if (m_NumberOfResolutionLevelsToWrite > 1)
+  {
+    for (unsigned int i = 0; i < this->GetNumberOfDimensions(); ++i)
+    {
+      if (this->GetIORegion().GetSize(i) != this->GetDimensions(i))
+      {
+        itkExceptionMacro("The resolution levels of " << m_FileName
+                                                      << " are downsampled from the whole image, which cannot be "
+                                                         "written in streamed regions");
+      }
+    }
+  }
+
   this->WriteImageInformation();
   try
   {
@@ -1288,11 +1943,14 @@ HDF5ImageIO::Write(const void * buffer)
       dims[numDims] = numComponents;
       ++numDims;
     }
-    H5::DataSpace imageSpace(numDims, dims.get());
-    H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
-    H5::DataSpace dspace;
-    this->SetupStreaming(&imageSpace, &dspace);
-    m_VoxelDataSet->write(buffer, dataType, dspace, imageSpace);
+    if (!this->WriteChunks(buffer))
+    {
+      H5::DataSpace imageSpace(numDims, dims.get());
+      H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
+      H5::DataSpace dspace;
+      this->SetupStreaming(&imageSpace, &dspace);
+      m_VoxelDataSet->write(buffer, dataType, dspace, imageSpace);
+    }
   }
   // catch failure caused by the H5File operations
   catch (const H5::FileIException & error)
@@ -1319,11 +1977,211 @@ HDF5ImageIO::Write(const void * buffer)
     itkExceptionMacro("Unspecified error occured during Write: " << this->GetFileName() << " with "
                                                                  << this->GetNameOfClass());
   }
+  this->WriteResolutionLevels(buffer);
   // TODO: including this line allows the IO object to be re-used multiple times for writing, but
   // but causes the streaming tests for HDF5ImageIO to fail.
   // this->ResetToInitialState();
 }
 
+void
+HDF5ImageIO::WriteResolutionLevels(const void * buffer)
+{
+  const std::vector<LevelGeometry> levels = ComputeResolutionLevels(
+    { this->m_Dimensions, this->m_Spacing, this->m_Origin }, this->m_Direction, m_NumberOfResolutionLevelsToWrite);
+  if (levels.size() < 2)
+  {
+    return;
+  }
+
+  auto multiThreader = MultiThreaderBase::New();
+  if (m_NumberOfWorkUnits > 0)
+  {
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+  }
+  const unsigned int numberOfComponents = this->GetNumberOfComponents();
+  const size_t       pixelSize = this->GetComponentSize() * numberOfComponents;
+
+  // Each level is downsampled from the previous one
+  std::vector<char> previousLevel;
+  const void *      input = buffer;
+  for (size_t k = 1; k < levels.size(); ++k)
+  {
+    size_t levelBytes = pixelSize;
+    for (const SizeValueType extent : levels[k].dimensions)
+    {
+      levelBytes *= extent;
+    }
+    std::vector<char> level(levelBytes);
+    if (!DownsampleLevel(this->GetComponentType(),
+                         input,
+                         levels[k - 1].dimensions,
+                         level.data(),
+                         levels[k].dimensions,
+                         numberOfComponents,
+                         multiThreader))
+    {
+      itkExceptionMacro("Cannot downsample the pixels of " << m_FileName << " to write its resolution levels");
+    }
+    try
+    {
+      H5::DataSet dataSet =
+        m_H5File->openDataSet(ImageGroup + "/0" + ResolutionLevelsName + "/" + std::to_string(k) + VoxelData);
+      dataSet.write(level.data(), ComponentToPredType(this->GetComponentType()));
+    }
+    catch (const H5::Exception & error)
+    {
+      itkExceptionMacro(<< error.getCDetailMsg());
+    }
+    previousLevel = std::move(level);
+    input = previousLevel.data();
+  }
+}
+
+bool
+HDF5ImageIO::WriteChunks(const void * buffer)
+{
+#if !H5_VERSION_GE(1, 10, 5)
+  // Direct chunk writes require HDF5 1.10.5
+  (void)buffer;
+  return false;
+#else
+  const H5::DSetCreatPropList createList = m_VoxelDataSet->getCreatePlist();
+  int                         numberOfFilters = 0;
+  unsigned int                level = 0;
+  if (!HasDirectChunkLayout(createList, numberOfFilters, level) ||
+      !(m_VoxelDataSet->getDataType() == ComponentToPredType(this->GetComponentType())))
+  {
+    return false;
+  }
+
+  const Hyperslab slab =
+    RegionToHyperslab(this->GetIORegion(), this->GetNumberOfDimensions(), this->GetNumberOfComponents());
+  const size_t  rank = slab.count.size();
+  H5::DataSpace imageSpace = m_VoxelDataSet->getSpace();
+  if (imageSpace.getSimpleExtentNdims() != static_cast<int>(rank))
+  {
+    return false;
+  }
+  for (const hsize_t count : slab.count)
+  {
+    if (count == 0)
+    {
+      return true;
+    }
+  }
+
+  std::vector<hsize_t> imageDims(rank);
+  imageSpace.getSimpleExtentDims(imageDims.data());
+  const size_t         elementSize = m_VoxelDataSet->getDataType().getSize();
+  std::vector<hsize_t> chunkDims(rank);
+  createList.getChunk(static_cast<int>(rank), chunkDims.data());
+  size_t chunkBytes = elementSize;
+  for (const hsize_t extent : chunkDims)
+  {
+    chunkBytes *= extent;
+  }
+
+  // The chunks whose stored part is inside the region are compressed
+  // and written directly. The chunks the region only partly covers are
+  // merged with their stored data by the HDF5 library.
+  std::vector<std::vector<hsize_t>> wholeChunks;
+  std::vector<std::vector<hsize_t>> partialChunks;
+  for (std::vector<hsize_t> & chunkOffset : OverlappingChunks(chunkDims, slab))
+  {
+    bool isWhole = true;
+    for (size_t d = 0; d < rank; ++d)
+    {
+      isWhole = isWhole && chunkOffset[d] >= slab.offset[d] &&
+                std::min(chunkOffset[d] + chunkDims[d], imageDims[d]) <= slab.offset[d] + slab.count[d];
+    }
+    (isWhole ? wholeChunks : partialChunks).push_back(std::move(chunkOffset));
+  }
+
+  auto multiThreader = MultiThreaderBase::New();
+  if (m_NumberOfWorkUnits > 0)
+  {
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+  }
+  const size_t chunksPerBatch =
+    std::max<size_t>(1, MaximumChunkBytesPerWorkUnit * multiThreader->GetNumberOfWorkUnits() / chunkBytes);
+
+  // The HDF5 library is not thread safe: the chunks of a batch are
+  // compressed concurrently, then written serially.
+  const hid_t dataSetId = m_VoxelDataSet->getId();
+  for (size_t batchBegin = 0; batchBegin < wholeChunks.size(); batchBegin += chunksPerBatch)
+  {
+    const size_t                   batchSize = std::min(chunksPerBatch, wholeChunks.size() - batchBegin);
+    std::vector<std::vector<char>> storedChunks(batchSize);
+    std::vector<char>              failed(batchSize, 0);
+    const auto                     encodeChunk = [&](SizeValueType k) {
+      // The part of the edge chunks outside of the image is zero
+      std::vector<char> chunk(chunkBytes, 0);
+      CopyChunkOverlap(wholeChunks[batchBegin + k],
+                       chunkDims,
+                       slab,
+                       elementSize,
+                       chunk.data(),
+                       static_cast<char *>(const_cast<void *>(buffer)),
+                       true);
+      if (numberOfFilters == 0)
+      {
+        storedChunks[k] = std::move(chunk);
+        return;
+      }
+      auto storedSize = compressBound(static_cast<uLong>(chunkBytes));
+      storedChunks[k].resize(storedSize);
+      if (compress2(reinterpret_cast<Bytef *>(storedChunks[k].data()),
+                    &storedSize,
+                    reinterpret_cast<const Bytef *>(chunk.data()),
+                    static_cast<uLong>(chunkBytes),
+                    static_cast<int>(level)) != Z_OK)
+      {
+        failed[k] = 1;
+        return;
+      }
+      storedChunks[k].resize(storedSize);
+    };
+    multiThreader->ParallelizeArray(0, batchSize, encodeChunk, nullptr);
+
+    if (std::find(failed.cbegin(), failed.cend(), 1) != failed.cend())
+    {
+      itkExceptionMacro("Cannot compress a chunk of " << m_FileName);
+    }
+    for (size_t k = 0; k < batchSize; ++k)
+    {
+      if (H5Dwrite_chunk(dataSetId,
+                         H5P_DEFAULT,
+                         0,
+                         wholeChunks[batchBegin + k].data(),
+                         storedChunks[k].size(),
+                         storedChunks[k].data()) < 0)
+      {
+        itkExceptionMacro("Cannot write a chunk of " << m_FileName);
+      }
+    }
+  }
+
+  const H5::PredType dataType = ComponentToPredType(this->GetComponentType());
+  H5::DataSpace      slabSpace(static_cast<int>(rank), slab.count.data());
+  for (const std::vector<hsize_t> & chunkOffset : partialChunks)
+  {
+    std::vector<hsize_t> fileOffset(rank);
+    std::vector<hsize_t> slabOffset(rank);
+    std::vector<hsize_t> count(rank);
+    for (size_t d = 0; d < rank; ++d)
+    {
+      fileOffset[d] = std::max(chunkOffset[d], slab.offset[d]);
+      slabOffset[d] = fileOffset[d] - slab.offset[d];
+      count[d] = std::min(chunkOffset[d] + chunkDims[d], slab.offset[d] + slab.count[d]) - fileOffset[d];
+    }
+    imageSpace.selectHyperslab(H5S_SELECT_SET, count.data(), fileOffset.data());
+    slabSpace.selectHyperslab(H5S_SELECT_SET, count.data(), slabOffset.data());
+    m_VoxelDataSet->write(buffer, dataType, slabSpace, imageSpace);
+  }
+  return true;
+#endif
+}
+
 //
 // GetHeaderSize -- return 0
 ImageIOBase::SizeType
@@ -0,0 +1,288 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHDF5ImageIO.h"
+#include "itkGaussianImageSource.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkIOTestHelper.h"
+#include "itkTestingMacros.h"
+#include "itk_hdf5.h"
+
+namespace
+{
+using ChunkSizeType = itk::HDF5ImageIO::ChunkSizeType;
+
+template <typename TPixel>
+TPixel
+MakePixel(itk::OffsetValueType n)
+{
+  return static_cast<TPixel>(n % 251 - 100);
+}
+
+template <>
+itk::Vector<float, 2>
+MakePixel<itk::Vector<float, 2>>(itk::OffsetValueType n)
+{
+  itk::Vector<float, 2> pixel;
+  pixel[0] = static_cast<float>(n);
+  pixel[1] = static_cast<float>(n % 7) * 0.5f;
+  return pixel;
+}
+
+// The shape of the chunks stored in the file, in HDF5 order.
+std::vector<hsize_t>
+StoredChunkSize(const std::string & fileName)
+{
+  std::vector<hsize_t> chunkSize(8, 0);
+  const hid_t          file = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  const hid_t          dataSet = H5Dopen2(file, "/ITKImage/0/VoxelData", H5P_DEFAULT);
+  const hid_t          createList = H5Dget_create_plist(dataSet);
+  chunkSize.resize(H5Pget_chunk(createList, static_cast<int>(chunkSize.size()), chunkSize.data()));
+  H5Pclose(createList);
+  H5Dclose(dataSet);
+  H5Fclose(file);
+  return chunkSize;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+MakeImage()
+{
+  typename TImage::SizeType size;
+  size[0] = 53;
+  size[1] = 41;
+  size[2] = 23;
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  itk::OffsetValueType n = 0;
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it, ++n)
+  {
+    it.Set(MakePixel<typename TImage::PixelType>(n));
+  }
+  return image;
+}
+
+// A source generating the regions requested by a streaming writer
+template <typename TImage>
+typename itk::GaussianImageSource<TImage>::Pointer
+MakeStreamableSource()
+{
+  auto source = itk::GaussianImageSource<TImage>::New();
+  source->SetSize({ { 53, 41, 23 } });
+  source->SetMean(itk::FixedArray<double, 3>{ { 20.0, 15.0, 10.0 } });
+  source->SetSigma(itk::FixedArray<double, 3>{ { 15.0, 10.0, 5.0 } });
+  source->SetScale(100.0);
+  source->SetNormalized(false);
+  return source;
+}
+
+// Write an image with the given chunk shape, possibly streaming it,
+// check the stored chunk shape, then read back regions of it.
+template <typename TImage>
+int
+HDF5ChunkingTest(const std::string &          fileName,
+                 TImage *                     image,
+                 itk::ImageSource<TImage> *   input,
+                 const ChunkSizeType &        chunkSize,
+                 const std::vector<hsize_t> & expectedChunkSize,
+                 unsigned int                 numberOfStreamDivisions,
+                 unsigned int                 numberOfWorkUnits)
+{
+  using ImageType = TImage;
+
+  {
+    auto io = itk::HDF5ImageIO::New();
+    io->SetChunkSize(chunkSize);
+    io->SetNumberOfWorkUnits(numberOfWorkUnits);
+    ITK_TEST_EXPECT_TRUE(io->GetChunkSize() == chunkSize);
+
+    using WriterType = itk::ImageFileWriter<ImageType>;
+    auto writer = WriterType::New();
+    writer->SetImageIO(io);
+    writer->SetFileName(fileName);
+    if (input)
+    {
+      writer->SetInput(input->GetOutput());
+    }
+    else
+    {
+      writer->SetInput(image);
+    }
+    writer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  }
+
+  const std::vector<hsize_t> storedChunkSize = StoredChunkSize(fileName);
+  if (storedChunkSize != expectedChunkSize)
+  {
+    std::cerr << "Unexpected chunk shape in " << fileName << ":";
+    for (const hsize_t extent : storedChunkSize)
+    {
+      std::cerr << ' ' << extent;
+    }
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Read the whole image, a region across chunks and a single row
+  typename ImageType::IndexType roiIndex;
+  roiIndex[0] = 5;
+  roiIndex[1] = 9;
+  roiIndex[2] = 7;
+  typename ImageType::SizeType roiSize;
+  roiSize[0] = 30;
+  roiSize[1] = 17;
+  roiSize[2] = 11;
+  typename ImageType::IndexType rowIndex;
+  rowIndex[0] = 0;
+  rowIndex[1] = 40;
+  rowIndex[2] = 22;
+  typename ImageType::SizeType rowSize;
+  rowSize[0] = 53;
+  rowSize[1] = 1;
+  rowSize[2] = 1;
+  const typename ImageType::RegionType regions[] = { image->GetLargestPossibleRegion(),
+                                                     { roiIndex, roiSize },
+                                                     { rowIndex, rowSize } };
+  for (const typename ImageType::RegionType & region : regions)
+  {
+    auto io = itk::HDF5ImageIO::New();
+    io->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+    using ReaderType = itk::ImageFileReader<ImageType>;
+    auto reader = ReaderType::New();
+    reader->SetImageIO(io);
+    reader->SetFileName(fileName);
+    reader->SetUseStreaming(true);
+    reader->UpdateOutputInformation();
+    reader->GetOutput()->SetRequestedRegion(region);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+    typename ImageType::Pointer output = reader->GetOutput();
+    ITK_TEST_EXPECT_EQUAL(output->GetBufferedRegion(), region);
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != image->GetPixel(it.GetIndex()))
+      {
+        std::cerr << "Wrong pixel value at " << it.GetIndex() << " of " << fileName << " when reading " << region
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  itk::IOTestHelper::Remove(fileName.c_str());
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkHDF5ImageIOChunkingTest(int argc, char * argv[])
+{
+  if (argc > 1)
+  {
+    itksys::SystemTools::ChangeDirectory(argv[1]);
+  }
+
+  auto io = itk::HDF5ImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(io, HDF5ImageIO, StreamingImageIOBase);
+  ITK_TEST_SET_GET_VALUE(0, io->GetNumberOfWorkUnits());
+  ITK_TEST_SET_GET_VALUE(itk::SizeValueType{ 64 } << 20, io->GetMaximumChunkCacheSize());
+  ITK_TEST_EXPECT_TRUE(io->GetChunkSize().empty());
+
+  int result = EXIT_SUCCESS;
+
+  using ShortImageType = itk::Image<short, 3>;
+  using VectorImageType = itk::Image<itk::Vector<float, 2>, 3>;
+
+  // The automatic chunk of a small image is the whole image
+  result += HDF5ChunkingTest<ShortImageType>(
+    "ChunkingAutomatic.hdf5", MakeImage<ShortImageType>(), nullptr, {}, { 23, 41, 53 }, 1, 1);
+
+  // Chunks clamped to the image size, the components share a chunk
+  result += HDF5ChunkingTest<VectorImageType>(
+    "ChunkingVector.hdf5", MakeImage<VectorImageType>(), nullptr, { 16, 64, 8 }, { 8, 41, 16, 2 }, 1, 4);
+
+  // Streamed writes split chunks, which are completed by the next region
+  {
+    auto reference = MakeStreamableSource<ShortImageType>();
+    reference->Update();
+    for (const unsigned int numberOfWorkUnits : { 1, 4 })
+    {
+      result += HDF5ChunkingTest<ShortImageType>("ChunkingStreamed.hdf5",
+                                                 reference->GetOutput(),
+                                                 MakeStreamableSource<ShortImageType>(),
+                                                 { 8, 8, 8 },
+                                                 { 8, 8, 8 },
+                                                 5,
+                                                 numberOfWorkUnits);
+    }
+    result += HDF5ChunkingTest<ShortImageType>("ChunkingStreamedSlices.hdf5",
+                                               reference->GetOutput(),
+                                               MakeStreamableSource<ShortImageType>(),
+                                               { 53, 41, 1 },
+                                               { 1, 41, 53 },
+                                               3,
+                                               4);
+  }
+
+  // The automatic chunk of a larger image halves its largest extents
+  {
+    using ImageType = itk::Image<unsigned char, 3>;
+    ImageType::SizeType size;
+    size[0] = 256;
+    size[1] = 256;
+    size[2] = 64;
+    auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate(true);
+
+    const std::string fileName = "ChunkingLarge.hdf5";
+    auto              writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(itk::HDF5ImageIO::New());
+    writer->SetFileName(fileName);
+    writer->SetInput(image);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+    const std::vector<hsize_t> expectedChunkSize = { 64, 128, 128 };
+    ITK_TEST_EXPECT_TRUE(StoredChunkSize(fileName) == expectedChunkSize);
+    itk::IOTestHelper::Remove(fileName.c_str());
+  }
+
+  // A chunk size not matching the image dimension is an error
+  {
+    using ImageType = itk::Image<short, 2>;
+    ImageType::SizeType size;
+    size.Fill(4);
+    auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate(true);
+
+    auto badIO = itk::HDF5ImageIO::New();
+    badIO->SetChunkSize({ 2, 2, 2 });
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(badIO);
+    writer->SetFileName("ChunkingBad.hdf5");
+    writer->SetInput(image);
+    ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result == EXIT_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
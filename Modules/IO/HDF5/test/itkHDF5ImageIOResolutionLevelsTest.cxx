@@ -0,0 +1,341 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHDF5ImageIO.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkGaussianImageSource.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkIOTestHelper.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <type_traits>
+
+namespace
+{
+template <typename TPixel>
+TPixel
+MakePixel(itk::OffsetValueType n)
+{
+  return static_cast<TPixel>(n % 1009 - 300);
+}
+
+template <>
+itk::Vector<unsigned char, 2>
+MakePixel<itk::Vector<unsigned char, 2>>(itk::OffsetValueType n)
+{
+  itk::Vector<unsigned char, 2> pixel;
+  pixel[0] = static_cast<unsigned char>(n % 251);
+  pixel[1] = static_cast<unsigned char>(n % 7 * 30);
+  return pixel;
+}
+
+// The next resolution level, averaging the blocks of up to 2^N pixels
+// of the image, rounding integer components.
+template <typename TImage>
+typename TImage::Pointer
+Downsample(const TImage * image)
+{
+  using PixelType = typename TImage::PixelType;
+  using Traits = itk::DefaultConvertPixelTraits<PixelType>;
+  using ValueType = typename Traits::ComponentType;
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+
+  const typename TImage::SizeType inputSize = image->GetLargestPossibleRegion().GetSize();
+  typename TImage::SizeType       size;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    size[d] = (inputSize[d] + 1) / 2;
+  }
+  auto output = TImage::New();
+  output->SetRegions(size);
+  output->Allocate();
+
+  const unsigned int numberOfComponents = Traits::GetNumberOfComponents();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    std::vector<double> sum(numberOfComponents, 0.0);
+    unsigned int        count = 0;
+    for (unsigned int neighbor = 0; neighbor < (1u << Dimension); ++neighbor)
+    {
+      typename TImage::IndexType index;
+      bool                       isInside = true;
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        index[d] = 2 * it.GetIndex()[d] + ((neighbor >> d) & 1);
+        isInside = isInside && index[d] < static_cast<itk::IndexValueType>(inputSize[d]);
+      }
+      if (isInside)
+      {
+        const PixelType pixel = image->GetPixel(index);
+        for (unsigned int c = 0; c < numberOfComponents; ++c)
+        {
+          sum[c] += static_cast<double>(Traits::GetNthComponent(c, pixel));
+        }
+        ++count;
+      }
+    }
+    PixelType pixel;
+    for (unsigned int c = 0; c < numberOfComponents; ++c)
+    {
+      const double mean = sum[c] / count;
+      Traits::SetNthComponent(
+        c, pixel, static_cast<ValueType>(std::is_integral_v<ValueType> ? std::round(mean) : mean));
+    }
+    it.Set(pixel);
+  }
+  return output;
+}
+
+// Write an image with its resolution levels, then read each level, in
+// whole and streamed.
+template <typename TImage>
+int
+HDF5ResolutionLevelsTest(const std::string & fileName, unsigned int numberOfLevels)
+{
+  using ImageType = TImage;
+  constexpr unsigned int Dimension = ImageType::ImageDimension;
+
+  typename ImageType::SizeType size;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    size[d] = 37 - 12 * d;
+  }
+  typename ImageType::SpacingType spacing;
+  typename ImageType::PointType   origin;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    spacing[d] = 0.5 + d;
+    origin[d] = 10.0 - 3.0 * d;
+  }
+  // The first two axes are swapped, to check the origin of the levels
+  typename ImageType::DirectionType direction;
+  direction.SetIdentity();
+  direction(0, 0) = 0.0;
+  direction(1, 1) = 0.0;
+  direction(0, 1) = -1.0;
+  direction(1, 0) = 1.0;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->SetDirection(direction);
+  image->Allocate();
+  itk::OffsetValueType n = 0;
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it, ++n)
+  {
+    it.Set(MakePixel<typename ImageType::PixelType>(n * 7));
+  }
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetImageIO(itk::HDF5ImageIO::New());
+  writer->SetFileName(fileName);
+  writer->SetInput(image);
+  writer->SetNumberOfResolutionLevels(numberOfLevels);
+  ITK_TEST_SET_GET_VALUE(numberOfLevels, writer->GetNumberOfResolutionLevels());
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  typename ImageType::Pointer expected = image;
+  for (unsigned int level = 0; level < numberOfLevels; ++level)
+  {
+    auto io = itk::HDF5ImageIO::New();
+    using ReaderType = itk::ImageFileReader<ImageType>;
+    auto reader = ReaderType::New();
+    reader->SetImageIO(io);
+    reader->SetFileName(fileName);
+    reader->SetResolutionLevel(level);
+    ITK_TEST_SET_GET_VALUE(level, reader->GetResolutionLevel());
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(io->GetNumberOfResolutionLevels(), numberOfLevels);
+
+    // The first pixel of the level is at the center of the block of full
+    // resolution pixels it averages
+    const typename ImageType::Pointer output = reader->GetOutput();
+    itk::ContinuousIndex<double, Dimension> blockCenter;
+    blockCenter.Fill(0.5 * ((1 << level) - 1));
+    const typename ImageType::PointType expectedOrigin =
+      image->template TransformContinuousIndexToPhysicalPoint<double>(blockCenter);
+    if (output->GetOrigin().EuclideanDistanceTo(expectedOrigin) > 1e-9 ||
+        output->GetDirection() != direction ||
+        output->GetSpacing()[0] != spacing[0] * (1 << level))
+    {
+      std::cerr << "Wrong grid of level " << level << " of " << fileName << ": origin " << output->GetOrigin()
+                << " instead of " << expectedOrigin << ", spacing " << output->GetSpacing() << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (output->GetLargestPossibleRegion() != expected->GetLargestPossibleRegion())
+    {
+      std::cerr << "Wrong region " << output->GetLargestPossibleRegion() << " of level " << level << " of "
+                << fileName << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      if (it.Get() != expected->GetPixel(it.GetIndex()))
+      {
+        std::cerr << "Wrong pixel value at " << it.GetIndex() << " of level " << level << " of " << fileName
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // A region of the level is read by itself
+    typename ImageType::RegionType region = output->GetLargestPossibleRegion();
+    region.ShrinkByRadius(1);
+    auto streamingReader = ReaderType::New();
+    streamingReader->SetImageIO(itk::HDF5ImageIO::New());
+    streamingReader->SetFileName(fileName);
+    streamingReader->SetResolutionLevel(level);
+    streamingReader->SetUseStreaming(true);
+    streamingReader->UpdateOutputInformation();
+    streamingReader->GetOutput()->SetRequestedRegion(region);
+    ITK_TRY_EXPECT_NO_EXCEPTION(streamingReader->Update());
+    ITK_TEST_EXPECT_EQUAL(streamingReader->GetOutput()->GetBufferedRegion(), region);
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(streamingReader->GetOutput(), region); !it.IsAtEnd();
+         ++it)
+    {
+      if (it.Get() != expected->GetPixel(it.GetIndex()))
+      {
+        std::cerr << "Wrong pixel value at " << it.GetIndex() << " of a region of level " << level << " of "
+                  << fileName << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    expected = Downsample<ImageType>(expected);
+  }
+
+  // There is no level past the last one
+  {
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetImageIO(itk::HDF5ImageIO::New());
+    reader->SetFileName(fileName);
+    reader->SetResolutionLevel(numberOfLevels);
+    ITK_TRY_EXPECT_EXCEPTION(reader->Update());
+  }
+
+  itk::IOTestHelper::Remove(fileName.c_str());
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkHDF5ImageIOResolutionLevelsTest(int argc, char * argv[])
+{
+  if (argc > 1)
+  {
+    itksys::SystemTools::ChangeDirectory(argv[1]);
+  }
+
+  auto io = itk::HDF5ImageIO::New();
+  ITK_TEST_EXPECT_TRUE(io->SupportsResolutionLevels());
+  ITK_TEST_SET_GET_VALUE(0, io->GetResolutionLevel());
+  ITK_TEST_EXPECT_EQUAL(io->GetNumberOfResolutionLevels(), 1);
+  io->SetNumberOfResolutionLevelsToWrite(0);
+  ITK_TEST_SET_GET_VALUE(1, io->GetNumberOfResolutionLevelsToWrite());
+
+  int result = EXIT_SUCCESS;
+
+  result += HDF5ResolutionLevelsTest<itk::Image<short, 3>>("ResolutionLevelsShort.hdf5", 4);
+  result += HDF5ResolutionLevelsTest<itk::Image<float, 2>>("ResolutionLevelsFloat.hdf5", 3);
+  result += HDF5ResolutionLevelsTest<itk::Image<itk::Vector<unsigned char, 2>, 3>>("ResolutionLevelsVector.hdf5", 2);
+
+  using ImageType = itk::Image<short, 2>;
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 3, 2 } });
+  image->Allocate(true);
+
+  // The levels stop when no extent is left to halve
+  {
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(itk::HDF5ImageIO::New());
+    writer->SetFileName("ResolutionLevelsSmall.hdf5");
+    writer->SetInput(image);
+    writer->SetNumberOfResolutionLevels(10);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetImageIO(itk::HDF5ImageIO::New());
+    reader->SetFileName("ResolutionLevelsSmall.hdf5");
+    reader->SetResolutionLevel(2);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetImageIO()->GetNumberOfResolutionLevels(), 3);
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetLargestPossibleRegion().GetNumberOfPixels(), 1);
+
+    // The level 0 of the reader is forwarded to an ImageIO set to another level
+    auto levelIO = itk::HDF5ImageIO::New();
+    levelIO->SetResolutionLevel(2);
+    reader->SetImageIO(levelIO);
+    reader->SetResolutionLevel(0);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(levelIO->GetResolutionLevel(), 0);
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetLargestPossibleRegion(), image->GetLargestPossibleRegion());
+
+    // The ImageIO writes the number of levels requested, not the one of the file it read
+    ITK_TEST_EXPECT_EQUAL(levelIO->GetNumberOfResolutionLevels(), 3);
+    ITK_TEST_EXPECT_EQUAL(levelIO->GetNumberOfResolutionLevelsToWrite(), 1);
+    auto rewriter = itk::ImageFileWriter<ImageType>::New();
+    rewriter->SetImageIO(levelIO);
+    rewriter->SetFileName("ResolutionLevelsRewritten.hdf5");
+    rewriter->SetInput(image);
+    ITK_TRY_EXPECT_NO_EXCEPTION(rewriter->Update());
+    reader->SetImageIO(itk::HDF5ImageIO::New());
+    reader->SetFileName("ResolutionLevelsRewritten.hdf5");
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetImageIO()->GetNumberOfResolutionLevels(), 1);
+
+    itk::IOTestHelper::Remove("ResolutionLevelsSmall.hdf5");
+    itk::IOTestHelper::Remove("ResolutionLevelsRewritten.hdf5");
+  }
+
+  // Streamed writes cannot downsample the whole image
+  {
+    auto source = itk::GaussianImageSource<ImageType>::New();
+    source->SetSize({ { 16, 16 } });
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(itk::HDF5ImageIO::New());
+    writer->SetFileName("ResolutionLevelsStreamed.hdf5");
+    writer->SetInput(source->GetOutput());
+    writer->SetNumberOfResolutionLevels(2);
+    writer->SetNumberOfStreamDivisions(2);
+    ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+  }
+
+  // An ImageIO without resolution levels neither reads nor writes them
+  {
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetFileName("ResolutionLevels.mha");
+    writer->SetInput(image);
+    writer->SetNumberOfResolutionLevels(2);
+    ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+    writer->SetNumberOfResolutionLevels(1);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetFileName("ResolutionLevels.mha");
+    reader->SetResolutionLevel(1);
+    ITK_TRY_EXPECT_EXCEPTION(reader->Update());
+    itk::IOTestHelper::Remove("ResolutionLevels.mha");
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result == EXIT_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -118,6 +118,14 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
 
+  /** Set/Get the resolution level to read from a multi-resolution file,
+   * 0 being the full resolution, the default. It is always forwarded to
+   * the ImageIO, which must support resolution levels for the other
+   * levels.
+   * \sa ImageIOBase::SetResolutionLevel */
+  itkSetMacro(ResolutionLevel, unsigned int);
+  itkGetConstMacro(ResolutionLevel, unsigned int);
+
 protected:
   ImageFileReader();
   ~ImageFileReader() override = default;
@@ -160,6 +168,8 @@ protected:
 
   bool m_UseStreaming{};
 
+  unsigned int m_ResolutionLevel{ 0 };
+
 private:
   std::string m_ExceptionMessage{};
 
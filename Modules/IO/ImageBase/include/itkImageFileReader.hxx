@@ -50,6 +50,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   itkPrintSelfBooleanMacro(UserSpecifiedImageIO);
   itkPrintSelfBooleanMacro(UseStreaming);
+  os << indent << "ResolutionLevel: " << m_ResolutionLevel << std::endl;
 
   os << indent << "ExceptionMessage: " << m_ExceptionMessage << std::endl;
   os << indent << "ActualIORegion: " << m_ActualIORegion << std::endl;
@@ -139,6 +140,15 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformation()
   // Got to allocate space for the image. Determine the characteristics of
   // the image.
   //
+  if (m_ResolutionLevel > 0 && !m_ImageIO->SupportsResolutionLevels())
+  {
+    std::ostringstream msg;
+    msg << "Cannot read the resolution level " << m_ResolutionLevel << " of " << this->GetFileName() << ": "
+        << m_ImageIO->GetNameOfClass() << " does not support resolution levels";
+    ImageFileReaderException e(__FILE__, __LINE__, msg.str().c_str(), ITK_LOCATION);
+    throw e;
+  }
+  m_ImageIO->SetResolutionLevel(m_ResolutionLevel);
   m_ImageIO->SetFileName(this->GetFileName().c_str());
   m_ImageIO->ReadImageInformation();
 
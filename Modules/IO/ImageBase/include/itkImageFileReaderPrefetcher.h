@@ -0,0 +1,209 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageFileReaderPrefetcher_h
+#define itkImageFileReaderPrefetcher_h
+
+#include "itkImageFileReader.h"
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace itk
+{
+/** \class ImageFileReaderPrefetcher
+ * \brief Read a list of image files ahead of their processing, on background threads.
+ *
+ * The files are read in order, each one by an ImageFileReader, so that
+ * any format known to the ImageIOFactory is supported. While the images
+ * already read are processed, the next files are read and decoded by
+ * background threads, overlapping the file system and the processing.
+ *
+ * Start() starts reading the files. GetNextImage() returns the future of
+ * the next image of the list, in order, which holds the image once read,
+ * or the exception thrown when reading it. An ImageReadCallback is also
+ * called on the reading thread for each image read.
+ *
+ * At most NumberOfPrefetchedImages images are read ahead of the image
+ * last returned by GetNextImage(), by NumberOfReadThreads threads. When
+ * MaximumPrefetchedMemorySize is not zero, the reads also wait for the
+ * memory of the images read ahead to fit in it. An image is always read
+ * when no other image is read ahead, whatever its size.
+ *
+ * The buffer of an image given back with RecycleImage() is reused by the
+ * next read of an image which fits in it, instead of allocating a new
+ * one. The image given back must not be used anymore.
+ *
+ * \sa ImageFileReader
+ * \sa ImageSeriesReader
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+template <typename TOutputImage>
+class ITK_TEMPLATE_EXPORT ImageFileReaderPrefetcher : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageFileReaderPrefetcher);
+
+  /** Standard class type aliases. */
+  using Self = ImageFileReaderPrefetcher;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageFileReaderPrefetcher);
+
+  using OutputImageType = TOutputImage;
+  using OutputImagePointer = typename TOutputImage::Pointer;
+  using FileNamesContainer = std::vector<std::string>;
+  using ImageFutureType = std::future<OutputImagePointer>;
+
+  /** The function called on the reading thread for each image read,
+   * with the index of its file in the list. */
+  using ImageReadCallbackType = std::function<void(SizeValueType, TOutputImage *)>;
+
+  /** Set/Get the list of files to read. Setting it stops reading the
+   * previous list. */
+  void
+  SetFileNames(const FileNamesContainer & fileNames);
+  const FileNamesContainer &
+  GetFileNames() const
+  {
+    return m_FileNames;
+  }
+
+  /** Set/Get the ImageIO reading the files. Each read uses its own copy
+   * of the ImageIO, created with Clone(), with the same settings: an
+   * ImageIO with options of its own must override InternalClone() to
+   * copy them. The ImageIO must not be modified while the files are
+   * read. By default, the ImageIOFactory creates an ImageIO for each
+   * file. */
+  itkSetObjectMacro(ImageIO, ImageIOBase);
+  itkGetModifiableObjectMacro(ImageIO, ImageIOBase);
+
+  /** Set/Get the maximum number of images read ahead of the image last
+   * returned by GetNextImage(). The default is 2. */
+  itkSetClampMacro(NumberOfPrefetchedImages, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfPrefetchedImages, unsigned int);
+
+  /** Set/Get the number of background threads reading the files. The
+   * default is 1, which reads the files one after the other. */
+  itkSetClampMacro(NumberOfReadThreads, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfReadThreads, unsigned int);
+
+  /** Set/Get the maximum size, in bytes, of the buffers of the images
+   * read ahead and not yet returned by GetNextImage(). Zero, the
+   * default, does not limit the memory. */
+  itkSetMacro(MaximumPrefetchedMemorySize, SizeValueType);
+  itkGetConstMacro(MaximumPrefetchedMemorySize, SizeValueType);
+
+  /** Set the function called on the reading thread for each image read,
+   * before its future is ready. */
+  void
+  SetImageReadCallback(ImageReadCallbackType callback)
+  {
+    m_ImageReadCallback = std::move(callback);
+  }
+
+  /** Start reading the files in the background, from the first one,
+   * stopping the reads in progress if any. The number of read threads is
+   * taken into account when starting. */
+  void
+  Start();
+
+  /** Stop reading the files, waiting for the reads in progress. The
+   * futures of the images not read are left without value. It must not
+   * be called by the ImageReadCallback. */
+  void
+  Stop();
+
+  /** Whether GetNextImage() has images left to return. */
+  bool
+  HasNextImage() const;
+
+  /** Return the future of the next image of the list, which holds the
+   * image once read. Reading starts if Start() has not been called.
+   * Throws if all the images have been returned. */
+  ImageFutureType
+  GetNextImage();
+
+  /** Give back an image, whose buffer is reused by a next read. */
+  void
+  RecycleImage(TOutputImage * image);
+
+protected:
+  ImageFileReaderPrefetcher() = default;
+  ~ImageFileReaderPrefetcher() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  using ReaderType = ImageFileReader<TOutputImage>;
+  using PixelContainerPointer = typename TOutputImage::PixelContainerPointer;
+
+  /** The state of the read of a file. */
+  struct ImageSlot
+  {
+    std::promise<OutputImagePointer> promise{};
+    ImageFutureType                  future{};
+    SizeValueType                    prefetchedMemorySize{ 0 };
+    bool                             isReturned{ false };
+  };
+
+  /** Read the files claimed by a background thread. */
+  void
+  ReadFiles();
+
+  FileNamesContainer   m_FileNames{};
+  ImageIOBase::Pointer m_ImageIO{};
+
+  unsigned int  m_NumberOfPrefetchedImages{ 2 };
+  unsigned int  m_NumberOfReadThreads{ 1 };
+  SizeValueType m_MaximumPrefetchedMemorySize{ 0 };
+
+  ImageReadCallbackType m_ImageReadCallback{};
+
+  std::vector<std::thread> m_Threads{};
+
+  // The state shared by the threads, guarded by m_Mutex
+  mutable std::mutex                 m_Mutex{};
+  std::condition_variable            m_Condition{};
+  std::vector<ImageSlot>             m_Slots{};
+  std::vector<PixelContainerPointer> m_RecycledPixelContainers{};
+  SizeValueType                      m_NextFileToRead{ 0 };
+  SizeValueType                      m_NextFileToReserve{ 0 };
+  SizeValueType                      m_NumberOfReturnedImages{ 0 };
+  SizeValueType                      m_PrefetchedMemorySize{ 0 };
+  bool                               m_IsStarted{ false };
+  bool                               m_IsStopping{ false };
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkImageFileReaderPrefetcher.hxx"
+#endif
+
+#endif // itkImageFileReaderPrefetcher_h
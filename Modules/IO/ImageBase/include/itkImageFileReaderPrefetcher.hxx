@@ -0,0 +1,278 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageFileReaderPrefetcher_hxx
+#define itkImageFileReaderPrefetcher_hxx
+
+#include <algorithm>
+
+namespace itk
+{
+template <typename TOutputImage>
+ImageFileReaderPrefetcher<TOutputImage>::~ImageFileReaderPrefetcher()
+{
+  this->Stop();
+}
+
+template <typename TOutputImage>
+void
+ImageFileReaderPrefetcher<TOutputImage>::SetFileNames(const FileNamesContainer & fileNames)
+{
+  this->Stop();
+  m_FileNames = fileNames;
+  this->Modified();
+}
+
+template <typename TOutputImage>
+void
+ImageFileReaderPrefetcher<TOutputImage>::Start()
+{
+  this->Stop();
+
+  m_Slots = std::vector<ImageSlot>(m_FileNames.size());
+  for (ImageSlot & slot : m_Slots)
+  {
+    slot.future = slot.promise.get_future();
+  }
+  m_IsStarted = true;
+
+  const auto numberOfThreads =
+    std::min(static_cast<SizeValueType>(m_NumberOfReadThreads), static_cast<SizeValueType>(m_FileNames.size()));
+  for (SizeValueType i = 0; i < numberOfThreads; ++i)
+  {
+    m_Threads.emplace_back(&Self::ReadFiles, this);
+  }
+}
+
+template <typename TOutputImage>
+void
+ImageFileReaderPrefetcher<TOutputImage>::Stop()
+{
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_IsStopping = true;
+  }
+  m_Condition.notify_all();
+  for (std::thread & thread : m_Threads)
+  {
+    thread.join();
+  }
+  m_Threads.clear();
+
+  // The threads are done, the state is reset without locking
+  m_Slots.clear();
+  m_NextFileToRead = 0;
+  m_NextFileToReserve = 0;
+  m_NumberOfReturnedImages = 0;
+  m_PrefetchedMemorySize = 0;
+  m_IsStarted = false;
+  m_IsStopping = false;
+}
+
+template <typename TOutputImage>
+bool
+ImageFileReaderPrefetcher<TOutputImage>::HasNextImage() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfReturnedImages < m_FileNames.size();
+}
+
+template <typename TOutputImage>
+auto
+ImageFileReaderPrefetcher<TOutputImage>::GetNextImage() -> ImageFutureType
+{
+  if (!m_IsStarted)
+  {
+    this->Start();
+  }
+
+  ImageFutureType future;
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_NumberOfReturnedImages >= m_Slots.size())
+    {
+      itkExceptionMacro("All the " << m_Slots.size() << " images have been returned");
+    }
+
+    // The memory of the image is no longer accounted for as read ahead
+    ImageSlot & slot = m_Slots[m_NumberOfReturnedImages++];
+    slot.isReturned = true;
+    m_PrefetchedMemorySize -= slot.prefetchedMemorySize;
+    slot.prefetchedMemorySize = 0;
+    future = std::move(slot.future);
+  }
+  m_Condition.notify_all();
+  return future;
+}
+
+template <typename TOutputImage>
+void
+ImageFileReaderPrefetcher<TOutputImage>::RecycleImage(TOutputImage * image)
+{
+  if (image == nullptr || image->GetPixelContainer() == nullptr)
+  {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_RecycledPixelContainers.push_back(image->GetPixelContainer());
+  if (m_RecycledPixelContainers.size() > m_NumberOfPrefetchedImages)
+  {
+    m_RecycledPixelContainers.erase(m_RecycledPixelContainers.begin());
+  }
+}
+
+template <typename TOutputImage>
+void
+ImageFileReaderPrefetcher<TOutputImage>::ReadFiles()
+{
+  const auto numberOfFiles = static_cast<SizeValueType>(m_FileNames.size());
+
+  for (;;)
+  {
+    // Claim the next file, once it is not too far ahead of the images
+    // returned
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Condition.wait(lock, [this, numberOfFiles] {
+      return m_IsStopping || m_NextFileToRead >= numberOfFiles ||
+             m_NextFileToRead < m_NumberOfReturnedImages + m_NumberOfPrefetchedImages;
+    });
+    if (m_IsStopping || m_NextFileToRead >= numberOfFiles)
+    {
+      return;
+    }
+    const SizeValueType fileIndex = m_NextFileToRead++;
+    lock.unlock();
+
+    auto reader = ReaderType::New();
+    reader->SetFileName(m_FileNames[fileIndex]);
+    reader->ReleaseDataBeforeUpdateFlagOff();
+    if (m_ImageIO)
+    {
+      reader->SetImageIO(m_ImageIO->Clone());
+    }
+
+    std::exception_ptr exception;
+    SizeValueType      numberOfElements = 0;
+    try
+    {
+      reader->UpdateOutputInformation();
+      const TOutputImage * output = reader->GetOutput();
+      numberOfElements = output->GetLargestPossibleRegion().GetNumberOfPixels() *
+                         TOutputImage::AccessorFunctorType::GetVectorLength(output);
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+    const SizeValueType memorySize = numberOfElements * sizeof(typename TOutputImage::InternalPixelType);
+
+    // The memory is reserved in the order of the files, so that a file
+    // never waits for the memory reserved by the files after it.
+    lock.lock();
+    ImageSlot & slot = m_Slots[fileIndex];
+    m_Condition.wait(lock, [this, fileIndex, memorySize, &exception, &slot] {
+      return m_IsStopping || (m_NextFileToReserve == fileIndex &&
+                              (exception || slot.isReturned || m_MaximumPrefetchedMemorySize == 0 ||
+                               m_PrefetchedMemorySize == 0 ||
+                               m_PrefetchedMemorySize + memorySize <= m_MaximumPrefetchedMemorySize));
+    });
+    if (m_IsStopping)
+    {
+      return;
+    }
+    if (!exception && !slot.isReturned)
+    {
+      slot.prefetchedMemorySize = memorySize;
+      m_PrefetchedMemorySize += memorySize;
+    }
+    ++m_NextFileToReserve;
+
+    PixelContainerPointer pixelContainer;
+    if (!exception)
+    {
+      // The smallest recycled buffer large enough for the image
+      auto recycled = m_RecycledPixelContainers.end();
+      for (auto it = m_RecycledPixelContainers.begin(); it != m_RecycledPixelContainers.end(); ++it)
+      {
+        if ((*it)->Capacity() >= numberOfElements &&
+            (recycled == m_RecycledPixelContainers.end() || (*it)->Capacity() < (*recycled)->Capacity()))
+        {
+          recycled = it;
+        }
+      }
+      if (recycled != m_RecycledPixelContainers.end())
+      {
+        pixelContainer = *recycled;
+        m_RecycledPixelContainers.erase(recycled);
+      }
+    }
+    lock.unlock();
+    m_Condition.notify_all();
+
+    OutputImagePointer image;
+    if (!exception)
+    {
+      try
+      {
+        // The allocation of the output keeps the recycled buffer, large
+        // enough for it
+        if (pixelContainer)
+        {
+          reader->GetOutput()->SetPixelContainer(pixelContainer);
+        }
+        reader->Update();
+        image = reader->GetOutput();
+        image->DisconnectPipeline();
+        if (m_ImageReadCallback)
+        {
+          m_ImageReadCallback(fileIndex, image);
+        }
+      }
+      catch (...)
+      {
+        exception = std::current_exception();
+      }
+    }
+
+    if (exception)
+    {
+      slot.promise.set_exception(exception);
+    }
+    else
+    {
+      slot.promise.set_value(image);
+    }
+  }
+}
+
+template <typename TOutputImage>
+void
+ImageFileReaderPrefetcher<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileNames: " << m_FileNames.size() << " files" << std::endl;
+  itkPrintSelfObjectMacro(ImageIO);
+  os << indent << "NumberOfPrefetchedImages: " << m_NumberOfPrefetchedImages << std::endl;
+  os << indent << "NumberOfReadThreads: " << m_NumberOfReadThreads << std::endl;
+  os << indent << "MaximumPrefetchedMemorySize: " << m_MaximumPrefetchedMemorySize << std::endl;
+  os << indent << "ImageReadCallback: " << (m_ImageReadCallback ? "(set)" : "(none)") << std::endl;
+  os << indent << "IsStarted: " << (m_IsStarted ? "On" : "Off") << std::endl;
+}
+} // namespace itk
+
+#endif
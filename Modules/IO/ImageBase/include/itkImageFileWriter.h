@@ -203,6 +203,14 @@ public:
   itkSetMacro(CompressionLevel, int);
   itkGetConstReferenceMacro(CompressionLevel, int);
 
+  /** Set the number of resolution levels of a multi-resolution file, all
+   * written in one pass from the full resolution image. Set to 0, the
+   * default, to use the number of levels to write of the ImageIO. More than
+   * one level requires an ImageIO supporting resolution levels.
+   * \sa ImageIOBase::SetNumberOfResolutionLevelsToWrite */
+  itkSetMacro(NumberOfResolutionLevels, unsigned int);
+  itkGetConstMacro(NumberOfResolutionLevels, unsigned int);
+
   /** By default the MetaDataDictionary is taken from the input image and
    *  passed to the ImageIO. In some cases, however, a user may prefer to
    *  introduce her/his own MetaDataDictionary. This is often the case of
@@ -237,6 +245,8 @@ private:
   bool m_UseCompression{ false };
   int  m_CompressionLevel{ -1 };
   bool m_UseInputMetaDataDictionary{ true };
+
+  unsigned int m_NumberOfResolutionLevels{ 0 };
 };
 
 
@@ -198,6 +198,17 @@ ImageFileWriter<TInputImage>::Write()
     m_ImageIO->SetCompressionLevel(m_CompressionLevel);
   }
 
+  // configure the resolution levels
+  if (m_NumberOfResolutionLevels > 0)
+  {
+    m_ImageIO->SetNumberOfResolutionLevelsToWrite(m_NumberOfResolutionLevels);
+  }
+  if (m_ImageIO->GetNumberOfResolutionLevelsToWrite() > 1 && !m_ImageIO->SupportsResolutionLevels())
+  {
+    itkExceptionMacro("Cannot write " << m_ImageIO->GetNumberOfResolutionLevelsToWrite() << " resolution levels: "
+                                      << m_ImageIO->GetNameOfClass() << " does not support resolution levels");
+  }
+
   // configure meta dictionary
   if (m_UseInputMetaDataDictionary)
   {
@@ -393,6 +404,7 @@ ImageFileWriter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
   os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
   itkPrintSelfBooleanMacro(UseCompression);
+  os << indent << "NumberOfResolutionLevels: " << m_NumberOfResolutionLevels << std::endl;
   itkPrintSelfBooleanMacro(UseInputMetaDataDictionary);
   itkPrintSelfBooleanMacro(FactorySpecifiedImageIO);
 }
@@ -88,6 +88,9 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(ImageIOBase);
 
+  /** Create a copy of the ImageIO, with the same settings. */
+  itkCloneMacro(Self);
+
   /** Set/Get the name of the file to be read. */
   itkSetStringMacro(FileName);
   itkGetStringMacro(FileName);
@@ -307,6 +310,33 @@ public:
   itkGetConstMacro(WritePalette, bool);
   itkBooleanMacro(WritePalette);
 
+  /** Set/Get the resolution level to read from a multi-resolution file.
+   * Level 0, the default, is the full resolution image, and each next
+   * level halves the extents of the previous one. Only the ImageIOs for
+   * which SupportsResolutionLevels() is true use it. */
+  itkSetMacro(ResolutionLevel, unsigned int);
+  itkGetConstMacro(ResolutionLevel, unsigned int);
+
+  /** Get the number of resolution levels of the file read, set by
+   * ReadImageInformation(). The default is 1, the full resolution only. */
+  itkGetConstMacro(NumberOfResolutionLevels, unsigned int);
+
+  /** Set/Get the number of resolution levels to write, used by the ImageIOs
+   * for which SupportsResolutionLevels() is true. It is independent of the
+   * number of levels of the file read last. The default is 1, the full
+   * resolution only. */
+  itkSetClampMacro(NumberOfResolutionLevelsToWrite, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfResolutionLevelsToWrite, unsigned int);
+
+  /** Determine whether the ImageIO reads and writes multi-resolution
+   * files, whose coarser levels are read without reading the full
+   * resolution. Default is false. */
+  virtual bool
+  SupportsResolutionLevels() const
+  {
+    return false;
+  }
+
   /** Determine whether a palletized image file has been read as a scalar image
    *  plus a color palette.
    *  ExpandRGBPalette must be set to true, and the file must be a
@@ -683,6 +713,16 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Create a new ImageIO of the same class, with the same settings and
+   * image information, so that it reads and writes files the same way.
+   * ImageIOs with settings of their own override this method to copy
+   * them as well. */
+  LightObject::Pointer
+  InternalClone() const override;
+
+  /** Set the number of resolution levels of the file read. */
+  itkSetClampMacro(NumberOfResolutionLevels, unsigned int, 1, NumericTraits<unsigned int>::max());
+
   virtual const ImageRegionSplitterBase *
   GetImageRegionSplitter() const;
 
@@ -755,6 +795,12 @@ protected:
   /** Should we try to include a RGB palette while writing the image  */
   bool m_WritePalette{};
 
+  /** The resolution level to read, the number of levels of the
+   * multi-resolution file read, and the number of levels to write. */
+  unsigned int m_ResolutionLevel{ 0 };
+  unsigned int m_NumberOfResolutionLevels{ 1 };
+  unsigned int m_NumberOfResolutionLevelsToWrite{ 1 };
+
   /** The region to read or write. The region contains information about the
    * data within the region to read or write. */
   ImageIORegion m_IORegion{};
@@ -20,6 +20,7 @@
 #include "ITKIOImageBaseExport.h"
 
 #include "itkSize.h"
+#include <exception>
 #include <vector>
 #include <string>
 #include "itkMetaDataDictionary.h"
@@ -173,6 +174,31 @@ public:
   itkSetMacro(SpacingWarningRelThreshold, double);
   itkGetConstMacro(SpacingWarningRelThreshold, double);
 
+  /** \brief Set/Get the maximum number of files read concurrently.
+   *
+   * When greater than one, the files of the series are read and
+   * decoded concurrently, each directly into its slice of the output
+   * buffer, with at most this number of files in flight. This hides
+   * the latency of the file system for series of many small files.
+   * The files are read on dedicated threads, not on the pool of the
+   * MultiThreaderBase, so that the reads blocking on the file system
+   * leave the pool to the ImageIOs decoding concurrently, and the
+   * NumberOfWorkUnits of the reader is left unchanged.
+   * The MetaDataDictionaryArray, the non uniform sampling checks and
+   * the reported errors are the same as for a sequential read.
+   *
+   * Each file is read with its own ImageIO. If an ImageIO has been
+   * set, every concurrent read uses a copy of it created with Clone(),
+   * which keeps its settings: the options of the ImageIOs of ITK, like
+   * the private tags or YBR conversion of GDCMImageIO, and the
+   * compression, streaming and resolution settings of ImageIOBase. An
+   * ImageIO with options of its own must override InternalClone() to
+   * copy them. The default is 1, a sequential read with the ImageIO
+   * shared by all files.
+   */
+  itkSetClampMacro(NumberOfParallelReads, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfParallelReads, unsigned int);
+
 protected:
   ImageSeriesReader()
     : m_ImageIO(nullptr)
@@ -218,14 +244,35 @@ protected:
 private:
   using ReaderType = ImageFileReader<TOutputImage>;
 
+  /** What is recorded from the file of a slice, in the order of the series. */
+  struct SliceReadResult
+  {
+    bool                             isRead{ false };
+    typename TOutputImage::PointType origin{};
+    ImageIOBase::Pointer             imageIO{};
+    std::exception_ptr               exception{};
+  };
+
   int
   ComputeMovingDimensionIndex(ReaderType * reader);
 
+  /** Read the file of a slice, into the output buffer when the slice is
+   * inside the requested region, or only its information otherwise. */
+  void
+  ReadSlice(int                     sliceIndex,
+            bool                    insideRequestedRegion,
+            const ImageRegionType & sliceRegionToRequest,
+            const SizeType &        validSize,
+            ImageIOBase *           imageIO,
+            SliceReadResult &       result);
+
   /** Modified time of the MetaDataDictionaryArray */
   TimeStamp m_MetaDataDictionaryArrayMTime{};
 
   /** Indicated if the MMDA should be updated */
   bool m_MetaDataDictionaryArrayUpdate{ true };
+
+  unsigned int m_NumberOfParallelReads{ 1 };
 };
 } // namespace itk
 
@@ -25,8 +25,11 @@
 #include "itkMath.h"
 #include "itkProgressReporter.h"
 #include "itkMetaDataObject.h"
+#include <atomic>
 #include <cstddef> // For ptrdiff_t.
 #include <iomanip>
+#include <system_error>
+#include <thread>
 
 namespace itk
 {
@@ -60,6 +63,7 @@ ImageSeriesReader<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) con
 
   os << indent << "MetaDataDictionaryArrayMTime: " << m_MetaDataDictionaryArrayMTime << std::endl;
   os << indent << "MetaDataDictionaryArrayUpdate: " << m_MetaDataDictionaryArrayUpdate << std::endl;
+  os << indent << "NumberOfParallelReads: " << m_NumberOfParallelReads << std::endl;
 }
 
 template <typename TOutputImage>
@@ -251,6 +255,134 @@ ImageSeriesReader<TOutputImage>::EnlargeOutputRequestedRegion(DataObject * outpu
   }
 }
 
+template <typename TOutputImage>
+void
+ImageSeriesReader<TOutputImage>::ReadSlice(int                     sliceIndex,
+                                           bool                    insideRequestedRegion,
+                                           const ImageRegionType & sliceRegionToRequest,
+                                           const SizeType &        validSize,
+                                           ImageIOBase *           imageIO,
+                                           SliceReadResult &       result)
+{
+  TOutputImage * output = this->GetOutput();
+
+  const ImageRegionType requestedRegion = output->GetRequestedRegion();
+  const auto            numberOfFiles = static_cast<int>(m_FileNames.size());
+  const int             iFileName = (m_ReverseOrder ? numberOfFiles - sliceIndex - 1 : sliceIndex);
+
+  IndexType sliceStartIndex = requestedRegion.GetIndex();
+  if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+  {
+    sliceStartIndex[this->m_NumberOfDimensionsInImage] = sliceIndex;
+  }
+
+  // configure reader
+  auto reader = ReaderType::New();
+  reader->SetFileName(m_FileNames[iFileName].c_str());
+
+  TOutputImage * readerOutput = reader->GetOutput();
+
+  if (imageIO)
+  {
+    reader->SetImageIO(imageIO);
+  }
+  reader->SetUseStreaming(m_UseStreaming);
+  readerOutput->SetRequestedRegion(sliceRegionToRequest);
+
+  // update the data or info
+  if (!insideRequestedRegion)
+  {
+    reader->UpdateOutputInformation();
+  }
+  else
+  {
+    // read the meta data information
+    readerOutput->UpdateOutputInformation();
+
+    // propagate the requested region to determine what the region
+    // will actually be read
+    readerOutput->PropagateRequestedRegion();
+
+    // check that the size of each slice is the same
+    if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+    {
+      itkExceptionMacro("Size mismatch! The size of  "
+                        << m_FileNames[iFileName].c_str() << " is "
+                        << readerOutput->GetLargestPossibleRegion().GetSize()
+                        << " and does not match the required size " << validSize << " from file "
+                        << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+    }
+
+    // get the size of the region to be read
+    SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+
+    if (readSize == sliceRegionToRequest.GetSize())
+    {
+      // if the buffer of the ImageReader is going to match that of
+      // ourselves, then set the ImageReader's buffer to a section
+      // of ours
+
+      const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+
+      using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+      const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+
+
+      const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+                                      ? (sliceIndex - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                      : 0;
+
+      const ptrdiff_t numberOfPixelComponentsUpToSlice =
+        numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+      const bool bufferDelete = false;
+
+      typename TOutputImage::InternalPixelType * outputSliceBuffer =
+        output->GetBufferPointer() + numberOfPixelComponentsUpToSlice;
+
+      if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+      {
+        // if the input image type is a vector image then the number
+        // of components needs to be set for the size
+        readerOutput->GetPixelContainer()->SetImportPointer(
+          outputSliceBuffer,
+          static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
+          bufferDelete);
+      }
+      else
+      {
+        // otherwise the actual number of pixels needs to be passed
+        readerOutput->GetPixelContainer()->SetImportPointer(
+          outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+      }
+      readerOutput->UpdateOutputData();
+    }
+    else
+    {
+      // the read region isn't going to match exactly what we need
+      // to update to buffer created by the reader, then copy
+
+      reader->Update();
+
+      // output of buffer copy
+      ImageRegionType outRegion = requestedRegion;
+      outRegion.SetIndex(sliceStartIndex);
+
+      // set the moving dimension to a size of 1
+      if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+      {
+        outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+      }
+
+      ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+    }
+
+    result.origin = readerOutput->GetOrigin();
+    result.isRead = true;
+  } // end !insideRequestedRegion
+
+  result.imageIO = reader->GetImageIO();
+}
+
 template <typename TOutputImage>
 void
 ImageSeriesReader<TOutputImage>::GenerateData()
@@ -281,7 +413,8 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   output->Allocate();
 
   // progress reported on a per slice basis
-  ProgressReporter progress(this, 0, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
+  const SizeValueType numberOfSlicesToRead = requestedRegion.GetSize(TOutputImage::ImageDimension - 1);
+  ProgressReporter    progress(this, 0, numberOfSlicesToRead, 100);
 
   // We utilize the modified time of the output information to
   // know when the meta array needs to be updated, when the output
@@ -291,138 +424,127 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   bool needToUpdateMetaDataDictionaryArray =
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
-  typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
-  const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
+  const auto numberOfFiles = static_cast<int>(m_FileNames.size());
 
   typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
   typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
   double                             maxSpacingDeviation = 0.0;
   bool                               prevSliceIsValid = false;
 
-  for (int i = 0; i != numberOfFiles; ++i)
-  {
+  const auto isInsideRequestedRegion = [this, &requestedRegion](int sliceIndex) {
+    IndexType sliceStartIndex = requestedRegion.GetIndex();
     if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
     {
-      sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
+      sliceStartIndex[this->m_NumberOfDimensionsInImage] = sliceIndex;
     }
+    return requestedRegion.IsInside(sliceStartIndex);
+  };
 
-    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
+  const bool parallelRead = m_NumberOfParallelReads > 1 && numberOfFiles > 1;
 
-    // check if we need this slice
-    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
-    {
-      continue;
-    }
-
-    // configure reader
-    auto reader = ReaderType::New();
-    reader->SetFileName(m_FileNames[iFileName].c_str());
-
-    TOutputImage * readerOutput = reader->GetOutput();
-
-    if (m_ImageIO)
-    {
-      reader->SetImageIO(m_ImageIO);
-    }
-    reader->SetUseStreaming(m_UseStreaming);
-    readerOutput->SetRequestedRegion(sliceRegionToRequest);
-
-    // update the data or info
-    if (!insideRequestedRegion)
-    {
-      reader->UpdateOutputInformation();
-    }
-    else
-    {
-      // read the meta data information
-      readerOutput->UpdateOutputInformation();
-
-      // propagate the requested region to determine what the region
-      // will actually be read
-      readerOutput->PropagateRequestedRegion();
-
-      // check that the size of each slice is the same
-      if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
-      {
-        itkExceptionMacro("Size mismatch! The size of  "
-                          << m_FileNames[iFileName].c_str() << " is "
-                          << readerOutput->GetLargestPossibleRegion().GetSize()
-                          << " and does not match the required size " << validSize << " from file "
-                          << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
-      }
-
-      // get the size of the region to be read
-      SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+  // The files are read concurrently by a bounded number of readers,
+  // each one taking the next file of the series. Everything which
+  // depends on the order of the series is done afterwards, in order.
+  std::vector<SliceReadResult> sliceReadResults(parallelRead ? numberOfFiles : 1);
+  if (parallelRead)
+  {
+    const bool      readInformationOfAllSlices = needToUpdateMetaDataDictionaryArray;
+    const float     progressIncrement = 1.0f / std::max<SizeValueType>(numberOfSlicesToRead, 1);
+    std::atomic_int nextSliceIndex{ 0 };
 
-      if (readSize == sliceRegionToRequest.GetSize())
+    const auto readSlices = [&]() {
+      for (int i = nextSliceIndex++; i < numberOfFiles && !this->GetAbortGenerateData(); i = nextSliceIndex++)
       {
-        // if the buffer of the ImageReader is going to match that of
-        // ourselves, then set the ImageReader's buffer to a section
-        // of ours
-
-        const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
-
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
-
-
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
-
-        const ptrdiff_t numberOfPixelComponentsUpToSlice =
-          numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-        const bool bufferDelete = false;
+        const bool insideRequestedRegion = isInsideRequestedRegion(i);
+        if (!insideRequestedRegion && !readInformationOfAllSlices)
+        {
+          continue;
+        }
 
-        typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
+        // each concurrent read uses its own copy of the ImageIO set
+        ImageIOBase::Pointer imageIO;
+        if (m_ImageIO)
+        {
+          imageIO = m_ImageIO->Clone();
+        }
 
-        if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+        try
         {
-          // if the input image type is a vector image then the number
-          // of components needs to be set for the size
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer,
-            static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
-            bufferDelete);
+          this->ReadSlice(i, insideRequestedRegion, sliceRegionToRequest, validSize, imageIO, sliceReadResults[i]);
         }
-        else
+        catch (...)
+        {
+          sliceReadResults[i].exception = std::current_exception();
+        }
+
+        if (insideRequestedRegion)
         {
-          // otherwise the actual number of pixels needs to be passed
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+          this->IncrementProgress(progressIncrement);
         }
-        readerOutput->UpdateOutputData();
       }
-      else
+    };
+
+    // The reads block on the file system, and the ImageIOs may use the
+    // pool of the MultiThreaderBase themselves: the files are read on
+    // dedicated threads, the calling thread being one of them, rather
+    // than on the pool.
+    const auto               numberOfReadThreads = std::min<unsigned int>(m_NumberOfParallelReads, numberOfFiles);
+    std::vector<std::thread> readThreads;
+    readThreads.reserve(numberOfReadThreads - 1);
+    for (unsigned int t = 1; t < numberOfReadThreads; ++t)
+    {
+      try
+      {
+        readThreads.emplace_back(readSlices);
+      }
+      catch (const std::system_error &)
       {
-        // the read region isn't going to match exactly what we need
-        // to update to buffer created by the reader, then copy
+        // read with the threads already started
+        break;
+      }
+    }
+    readSlices();
+    for (std::thread & readThread : readThreads)
+    {
+      readThread.join();
+    }
 
-        reader->Update();
+    progress.CheckAbortGenerateData();
+  }
 
-        // output of buffer copy
-        ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex(sliceStartIndex);
+  for (int i = 0; i != numberOfFiles; ++i)
+  {
+    const bool insideRequestedRegion = isInsideRequestedRegion(i);
+    bool       nonUniformSampling = false;
+    double     spacingDeviation = 0.0;
 
-        // set the moving dimension to a size of 1
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-        {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
-        }
+    // check if we need this slice
+    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+    {
+      continue;
+    }
 
-        ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
-      }
+    SliceReadResult & result = sliceReadResults[parallelRead ? i : 0];
+    if (!parallelRead || (!result.isRead && !result.imageIO && !result.exception))
+    {
+      // read sequentially, or only the information of a slice which was
+      // not needed when the files were read concurrently
+      result = SliceReadResult{};
+      this->ReadSlice(i, insideRequestedRegion, sliceRegionToRequest, validSize, m_ImageIO, result);
+    }
+    if (result.exception)
+    {
+      std::rethrow_exception(result.exception);
+    }
 
+    if (insideRequestedRegion)
+    {
       // verify that slice spacing is the expected one
       // since we can be skipping some slices because they are outside of requested region
       // I am using additional variable
       if (prevSliceIsValid)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
+        const typename TOutputImage::PointType & sliceOrigin = result.origin;
         using SpacingScalarType = typename TOutputImage::SpacingValueType;
         Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
         for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
@@ -449,19 +571,22 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       }
       else
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
+        prevSliceOrigin = result.origin;
         prevSliceIsValid = true;
       }
 
       // report progress for read slices
-      progress.CompletedPixel();
+      if (!parallelRead)
+      {
+        progress.CompletedPixel();
+      }
     } // end !insideRequestedRegion
 
     // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+    if (result.imageIO && needToUpdateMetaDataDictionaryArray)
     {
       auto newDictionary = new DictionaryType;
-      *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
+      *newDictionary = result.imageIO->GetMetaDataDictionary();
       if (nonUniformSampling)
       {
         // slice-specific information
@@ -469,6 +594,9 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       }
       m_MetaDataDictionaryArray.push_back(newDictionary);
     }
+
+    // release the ImageIO of the slice
+    result = SliceReadResult{};
   } // end per slice loop
 
 
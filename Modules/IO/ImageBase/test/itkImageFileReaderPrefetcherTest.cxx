@@ -0,0 +1,290 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReaderPrefetcher.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+using ImageType = itk::Image<short, 2>;
+using PrefetcherType = itk::ImageFileReaderPrefetcher<ImageType>;
+
+// The file of this index is missing from the list
+constexpr unsigned int MissingFile = 3;
+
+short
+PixelValue(unsigned int file, const ImageType::IndexType & index)
+{
+  return static_cast<short>(1000 * file + 30 * index[1] + index[0]);
+}
+
+// Write files of different sizes, and a missing file name.
+PrefetcherType::FileNamesContainer
+WriteFiles(const std::string & prefix, unsigned int numberOfFiles)
+{
+  PrefetcherType::FileNamesContainer fileNames;
+  for (unsigned int file = 0; file < numberOfFiles; ++file)
+  {
+    const std::string fileName = prefix + std::to_string(file) + ".mha";
+    fileNames.push_back(fileName);
+    if (file == MissingFile)
+    {
+      itksys::SystemTools::RemoveFile(fileName);
+      continue;
+    }
+
+    auto                  image = ImageType::New();
+    ImageType::RegionType region({ { 0, 0 } }, { { 17 + file, 9 + 2 * file } });
+    image->SetRegions(region);
+    image->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(PixelValue(file, it.GetIndex()));
+    }
+    itk::WriteImage(image, fileName);
+  }
+  return fileNames;
+}
+
+bool
+CheckImage(unsigned int file, const ImageType * image)
+{
+  const ImageType::SizeType expectedSize = { { 17 + file, 9 + 2 * file } };
+  if (image->GetBufferedRegion().GetSize() != expectedSize)
+  {
+    std::cerr << "Wrong size " << image->GetBufferedRegion().GetSize() << " of image " << file << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != PixelValue(file, it.GetIndex()))
+    {
+      std::cerr << "Wrong pixel value at " << it.GetIndex() << " of image " << file << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// A MetaImageIO adding an offset to the pixels it reads, to check that
+// each read keeps the settings of the ImageIO set.
+class OffsetMetaImageIO : public itk::MetaImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OffsetMetaImageIO);
+
+  using Self = OffsetMetaImageIO;
+  using Superclass = itk::MetaImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(OffsetMetaImageIO);
+
+  itkSetMacro(Offset, short);
+  itkGetConstMacro(Offset, short);
+
+  void
+  Read(void * buffer) override
+  {
+    Superclass::Read(buffer);
+    const auto   pixels = static_cast<short *>(buffer);
+    const size_t numberOfPixels = this->GetIORegion().GetNumberOfPixels();
+    std::transform(
+      pixels, pixels + numberOfPixels, pixels, [this](short pixel) { return static_cast<short>(pixel + m_Offset); });
+  }
+
+protected:
+  OffsetMetaImageIO() = default;
+  ~OffsetMetaImageIO() override = default;
+
+  itk::LightObject::Pointer
+  InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    dynamic_cast<Self &>(*loPtr).m_Offset = m_Offset;
+    return loPtr;
+  }
+
+private:
+  short m_Offset{ 0 };
+};
+
+// Read all the images in order, checking them, and give them back.
+int
+ReadAll(PrefetcherType * prefetcher, std::atomic<unsigned int> & numberOfRequestedImages)
+{
+  prefetcher->Start();
+  ITK_TEST_EXPECT_TRUE(prefetcher->HasNextImage());
+
+  int          result = EXIT_SUCCESS;
+  unsigned int file = 0;
+  for (; prefetcher->HasNextImage(); ++file)
+  {
+    ++numberOfRequestedImages;
+    PrefetcherType::ImageFutureType future = prefetcher->GetNextImage();
+    if (file == MissingFile)
+    {
+      ITK_TRY_EXPECT_EXCEPTION(future.get());
+      continue;
+    }
+    const ImageType::Pointer image = future.get();
+    if (!CheckImage(file, image))
+    {
+      result = EXIT_FAILURE;
+    }
+    prefetcher->RecycleImage(image);
+  }
+  ITK_TEST_EXPECT_EQUAL(file, prefetcher->GetFileNames().size());
+  ITK_TRY_EXPECT_EXCEPTION(prefetcher->GetNextImage());
+  return result;
+}
+} // namespace
+
+int
+itkImageFileReaderPrefetcherTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " OutputTestDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const PrefetcherType::FileNamesContainer fileNames =
+    WriteFiles(std::string(argv[1]) + "/itkImageFileReaderPrefetcherTest", 7);
+
+  auto prefetcher = PrefetcherType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(prefetcher, ImageFileReaderPrefetcher, Object);
+  ITK_TEST_SET_GET_VALUE(2, prefetcher->GetNumberOfPrefetchedImages());
+  ITK_TEST_SET_GET_VALUE(1, prefetcher->GetNumberOfReadThreads());
+  ITK_TEST_SET_GET_VALUE(0, prefetcher->GetMaximumPrefetchedMemorySize());
+  ITK_TEST_EXPECT_TRUE(!prefetcher->HasNextImage());
+  ITK_TRY_EXPECT_EXCEPTION(prefetcher->GetNextImage());
+
+  prefetcher->SetFileNames(fileNames);
+  ITK_TEST_EXPECT_TRUE(prefetcher->GetFileNames() == fileNames);
+
+  int result = EXIT_SUCCESS;
+
+  std::atomic<unsigned int> numberOfRequestedImages{ 0 };
+  std::atomic<unsigned int> numberOfReadImages{ 0 };
+  std::atomic<bool>         isReadAhead{ false };
+  std::atomic<bool>         isWrongImageRead{ false };
+  prefetcher->SetImageReadCallback([&](itk::SizeValueType file, ImageType * image) {
+    ++numberOfReadImages;
+    // The missing file takes no memory
+    isReadAhead = isReadAhead || file > numberOfRequestedImages + (file > MissingFile ? 1 : 0);
+    isWrongImageRead = isWrongImageRead || !CheckImage(file, image);
+  });
+
+  // Any number of threads reads the images in order
+  for (const unsigned int numberOfReadThreads : { 1, 3 })
+  {
+    prefetcher->SetNumberOfReadThreads(numberOfReadThreads);
+    prefetcher->SetNumberOfPrefetchedImages(2 * numberOfReadThreads);
+    numberOfRequestedImages = 0;
+    numberOfReadImages = 0;
+    if (ReadAll(prefetcher, numberOfRequestedImages) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+    ITK_TEST_EXPECT_EQUAL(numberOfReadImages, fileNames.size() - 1);
+  }
+
+  // A given ImageIO is replicated for each read
+  prefetcher->SetImageIO(itk::MetaImageIO::New());
+  ITK_TEST_EXPECT_TRUE(prefetcher->GetImageIO() != nullptr);
+  numberOfRequestedImages = 0;
+  if (ReadAll(prefetcher, numberOfRequestedImages) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  // The copies of a configured ImageIO keep its settings
+  {
+    auto imageIO = OffsetMetaImageIO::New();
+    imageIO->SetOffset(7);
+    auto configured = PrefetcherType::New();
+    configured->SetFileNames(fileNames);
+    configured->SetNumberOfReadThreads(2);
+    configured->SetImageIO(imageIO);
+    configured->Start();
+    for (unsigned int file = 0; file < 2; ++file)
+    {
+      const ImageType::Pointer image = configured->GetNextImage().get();
+      ITK_TEST_EXPECT_EQUAL(image->GetPixel({ { 4, 2 } }), PixelValue(file, { { 4, 2 } }) + 7);
+    }
+  }
+
+  // The smallest recycled buffer large enough is reused
+  {
+    auto recycling = PrefetcherType::New();
+    recycling->SetFileNames(fileNames);
+    recycling->SetNumberOfPrefetchedImages(3);
+    const short * buffer = nullptr;
+    for (const unsigned int size : { 12, 64, 16 })
+    {
+      auto recycled = ImageType::New();
+      recycled->SetRegions(ImageType::SizeType{ { size, size } });
+      recycled->Allocate();
+      buffer = size == 16 ? recycled->GetBufferPointer() : buffer;
+      recycling->RecycleImage(recycled);
+    }
+
+    const ImageType::Pointer image = recycling->GetNextImage().get();
+    ITK_TEST_EXPECT_TRUE(image->GetBufferPointer() == buffer);
+    if (!CheckImage(0, image))
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // Stopping and starting reads the files from the first one again
+  prefetcher->Start();
+  {
+    const ImageType::Pointer image = prefetcher->GetNextImage().get();
+    if (!CheckImage(0, image))
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+  prefetcher->Stop();
+  ITK_TEST_EXPECT_TRUE(prefetcher->HasNextImage());
+
+  // A memory limit smaller than any image reads one image at a time, at
+  // most one ahead of the images requested
+  prefetcher->SetMaximumPrefetchedMemorySize(100);
+  ITK_TEST_SET_GET_VALUE(100, prefetcher->GetMaximumPrefetchedMemorySize());
+  numberOfRequestedImages = 0;
+  isReadAhead = false;
+  if (ReadAll(prefetcher, numberOfRequestedImages) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_TRUE(!isReadAhead);
+  ITK_TEST_EXPECT_TRUE(!isWrongImageRead);
+
+  std::cout << prefetcher << std::endl;
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
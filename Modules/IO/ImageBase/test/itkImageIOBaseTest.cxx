@@ -16,6 +16,7 @@
  *
  *=========================================================================*/
 
+#include "itkGDCMImageIO.h"
 #include "itkMetaImageIO.h"
 #include "itkTestingMacros.h"
 #include "itkImage.h"
@@ -338,5 +339,41 @@ itkImageIOBaseTest(int, char *[])
     ITK_TEST_EXPECT_EQUAL(imageIO->GetPixelType(), IOPixelEnum::VARIABLESIZEMATRIX);
     ITK_TEST_EXPECT_EQUAL(imageIO->GetComponentType(), IOComponentEnum::DOUBLE);
   }
+
+  { // Test that a clone keeps the settings of the ImageIO
+    itk::MetaImageIO::Pointer imageIO = itk::MetaImageIO::New();
+    imageIO->SetFileName("clone.mha");
+    imageIO->UseCompressionOn();
+    imageIO->SetCompressionLevel(7);
+    imageIO->UseStreamedReadingOn();
+    imageIO->ExpandRGBPaletteOff();
+    imageIO->SetSubSamplingFactor(3);
+    imageIO->SetPixelTypeInfo(static_cast<const itk::RGBPixel<unsigned char> *>(nullptr));
+
+    const itk::ImageIOBase::Pointer clone = imageIO->Clone();
+    ITK_TEST_EXPECT_TRUE(clone.GetPointer() != imageIO.GetPointer());
+    ITK_TEST_EXPECT_EQUAL(std::string(clone->GetNameOfClass()), "MetaImageIO");
+    ITK_TEST_EXPECT_EQUAL(clone->GetFileName(), std::string("clone.mha"));
+    ITK_TEST_EXPECT_TRUE(clone->GetUseCompression());
+    ITK_TEST_EXPECT_EQUAL(clone->GetCompressionLevel(), 7);
+    ITK_TEST_EXPECT_TRUE(clone->GetUseStreamedReading());
+    ITK_TEST_EXPECT_TRUE(!clone->GetExpandRGBPalette());
+    ITK_TEST_EXPECT_EQUAL(clone->GetNumberOfComponents(), 3);
+    ITK_TEST_EXPECT_EQUAL(clone->GetPixelType(), itk::CommonEnums::IOPixel::RGB);
+    ITK_TEST_EXPECT_EQUAL(dynamic_cast<itk::MetaImageIO *>(clone.GetPointer())->GetSubSamplingFactor(), 3);
+
+    itk::GDCMImageIO::Pointer gdcmImageIO = itk::GDCMImageIO::New();
+    gdcmImageIO->LoadPrivateTagsOn();
+    gdcmImageIO->ReadYBRtoRGBOff();
+    gdcmImageIO->KeepOriginalUIDOn();
+    gdcmImageIO->SetCompressor("JPEG");
+
+    const itk::GDCMImageIO::Pointer gdcmClone = gdcmImageIO->Clone();
+    ITK_TEST_EXPECT_TRUE(gdcmClone->GetLoadPrivateTags());
+    ITK_TEST_EXPECT_TRUE(!gdcmClone->GetReadYBRtoRGB());
+    ITK_TEST_EXPECT_TRUE(gdcmClone->GetKeepOriginalUID());
+    ITK_TEST_EXPECT_EQUAL(gdcmClone->GetCompressor(), std::string("JPEG"));
+    ITK_TEST_EXPECT_EQUAL(gdcmClone->GetCompressionType(), itk::GDCMImageIO::CompressionEnum::JPEG);
+  }
   return EXIT_SUCCESS;
 }
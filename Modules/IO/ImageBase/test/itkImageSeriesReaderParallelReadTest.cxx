@@ -0,0 +1,258 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageSeriesReader.h"
+#include "itkMetaImageIO.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+using ReaderType = itk::ImageSeriesReader<ImageType>;
+
+// Write a series of single slice 3D files, with a gap between the origins
+// of two slices to emulate a missing slice.
+ReaderType::FileNamesContainer
+WriteSeries(const std::string & prefix, unsigned int numberOfSlices)
+{
+  ReaderType::FileNamesContainer fileNames;
+  for (unsigned int slice = 0; slice < numberOfSlices; ++slice)
+  {
+    auto                  image = ImageType::New();
+    ImageType::RegionType region({ { 0, 0, 0 } }, { { 13, 7, 1 } });
+    image->SetRegions(region);
+    image->Allocate();
+
+    ImageType::PointType origin;
+    origin[0] = 1.0;
+    origin[1] = 2.0;
+    origin[2] = 2.0 * slice + (slice > numberOfSlices / 2 ? 2.0 : 0.0);
+    image->SetOrigin(origin);
+
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      const ImageType::IndexType index = it.GetIndex();
+      it.Set(static_cast<short>(100 * slice + 10 * index[1] + index[0]));
+    }
+
+    const std::string fileName = prefix + std::to_string(slice) + ".mha";
+    itk::WriteImage(image, fileName);
+    fileNames.push_back(fileName);
+  }
+  return fileNames;
+}
+
+// A MetaImageIO adding an offset to the pixels it reads, to check that
+// the concurrent reads keep the settings of the ImageIO set. The offset is
+// added on the thread pool, as the ImageIOs decoding concurrently do.
+class OffsetMetaImageIO : public itk::MetaImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OffsetMetaImageIO);
+
+  using Self = OffsetMetaImageIO;
+  using Superclass = itk::MetaImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(OffsetMetaImageIO);
+
+  itkSetMacro(Offset, short);
+  itkGetConstMacro(Offset, short);
+
+  void
+  Read(void * buffer) override
+  {
+    Superclass::Read(buffer);
+    const auto pixels = static_cast<short *>(buffer);
+    itk::MultiThreaderBase::New()->ParallelizeArray(
+      0,
+      this->GetIORegion().GetNumberOfPixels(),
+      [this, pixels](itk::SizeValueType i) { pixels[i] = static_cast<short>(pixels[i] + m_Offset); },
+      nullptr);
+  }
+
+protected:
+  OffsetMetaImageIO() = default;
+  ~OffsetMetaImageIO() override = default;
+
+  itk::LightObject::Pointer
+  InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    dynamic_cast<Self &>(*loPtr).m_Offset = m_Offset;
+    return loPtr;
+  }
+
+private:
+  short m_Offset{ 0 };
+};
+
+bool
+SameOutput(ReaderType * sequentialReader, ReaderType * parallelReader)
+{
+  const ImageType * sequential = sequentialReader->GetOutput();
+  const ImageType * parallel = parallelReader->GetOutput();
+  if (sequential->GetBufferedRegion() != parallel->GetBufferedRegion())
+  {
+    std::cerr << "Buffered regions differ: " << sequential->GetBufferedRegion() << parallel->GetBufferedRegion()
+              << std::endl;
+    return false;
+  }
+  if (!std::equal(sequential->GetBufferPointer(),
+                  sequential->GetBufferPointer() + sequential->GetBufferedRegion().GetNumberOfPixels(),
+                  parallel->GetBufferPointer()))
+  {
+    std::cerr << "Pixels differ" << std::endl;
+    return false;
+  }
+
+  double sequentialDeviation = 0.0;
+  double parallelDeviation = 0.0;
+  itk::ExposeMetaData<double>(
+    sequential->GetMetaDataDictionary(), "ITK_non_uniform_sampling_deviation", sequentialDeviation);
+  itk::ExposeMetaData<double>(
+    parallel->GetMetaDataDictionary(), "ITK_non_uniform_sampling_deviation", parallelDeviation);
+  if (sequentialDeviation != parallelDeviation)
+  {
+    std::cerr << "Non uniform sampling deviations differ: " << sequentialDeviation << " != " << parallelDeviation
+              << std::endl;
+    return false;
+  }
+
+  const ReaderType::DictionaryArrayType * sequentialArray = sequentialReader->GetMetaDataDictionaryArray();
+  const ReaderType::DictionaryArrayType * parallelArray = parallelReader->GetMetaDataDictionaryArray();
+  if (sequentialArray->size() != parallelArray->size())
+  {
+    std::cerr << "Dictionary array sizes differ: " << sequentialArray->size() << " != " << parallelArray->size()
+              << std::endl;
+    return false;
+  }
+  for (size_t i = 0; i < sequentialArray->size(); ++i)
+  {
+    sequentialDeviation = -1.0;
+    parallelDeviation = -1.0;
+    itk::ExposeMetaData<double>(*(*sequentialArray)[i], "ITK_non_uniform_sampling_deviation", sequentialDeviation);
+    itk::ExposeMetaData<double>(*(*parallelArray)[i], "ITK_non_uniform_sampling_deviation", parallelDeviation);
+    if (sequentialDeviation != parallelDeviation ||
+        (*sequentialArray)[i]->GetKeys().size() != (*parallelArray)[i]->GetKeys().size())
+    {
+      std::cerr << "Dictionaries of slice " << i << " differ" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageSeriesReaderParallelReadTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string                    prefix = std::string(argv[1]) + "/itkImageSeriesReaderParallelReadTest_";
+  const ReaderType::FileNamesContainer fileNames = WriteSeries(prefix, 9);
+
+  auto sequentialReader = ReaderType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(sequentialReader, ImageSeriesReader, ImageSource);
+  ITK_TEST_EXPECT_EQUAL(sequentialReader->GetNumberOfParallelReads(), 1);
+  sequentialReader->SetFileNames(fileNames);
+
+  auto parallelReader = ReaderType::New();
+  parallelReader->SetFileNames(fileNames);
+  parallelReader->SetNumberOfParallelReads(4);
+  ITK_TEST_SET_GET_VALUE(4, parallelReader->GetNumberOfParallelReads());
+
+  parallelReader->SetNumberOfParallelReads(0);
+  ITK_TEST_SET_GET_VALUE(1, parallelReader->GetNumberOfParallelReads());
+  parallelReader->SetNumberOfParallelReads(4);
+
+  std::cout << "Reading the whole series" << std::endl;
+  ITK_TRY_EXPECT_NO_EXCEPTION(sequentialReader->Update());
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelReader->Update());
+  ITK_TEST_EXPECT_TRUE(SameOutput(sequentialReader, parallelReader));
+  ITK_TEST_EXPECT_EQUAL(parallelReader->GetMetaDataDictionaryArray()->size(), fileNames.size());
+
+  std::cout << "Reading the series in reverse order with an ImageIO" << std::endl;
+  for (ReaderType * reader : { sequentialReader.GetPointer(), parallelReader.GetPointer() })
+  {
+    reader->SetReverseOrder(true);
+    reader->SetImageIO(itk::MetaImageIO::New());
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  }
+  ITK_TEST_EXPECT_TRUE(SameOutput(sequentialReader, parallelReader));
+
+  std::cout << "Reading the series with a configured ImageIO, with more reads than pool threads" << std::endl;
+  const itk::ThreadIdType numberOfWorkUnits = parallelReader->GetNumberOfWorkUnits();
+  parallelReader->SetNumberOfParallelReads(itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() + 8);
+  for (ReaderType * reader : { sequentialReader.GetPointer(), parallelReader.GetPointer() })
+  {
+    auto imageIO = OffsetMetaImageIO::New();
+    imageIO->SetOffset(1000);
+    reader->SetReverseOrder(false);
+    reader->SetImageIO(imageIO);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  }
+  ITK_TEST_EXPECT_TRUE(SameOutput(sequentialReader, parallelReader));
+  ITK_TEST_EXPECT_EQUAL(parallelReader->GetOutput()->GetPixel({ { 2, 1, 3 } }), 1312);
+  ITK_TEST_EXPECT_EQUAL(parallelReader->GetNumberOfWorkUnits(), numberOfWorkUnits);
+  parallelReader->SetNumberOfParallelReads(4);
+
+  std::cout << "Reading a part of the series" << std::endl;
+  for (ReaderType * reader : { sequentialReader.GetPointer(), parallelReader.GetPointer() })
+  {
+    reader->SetReverseOrder(false);
+    reader->SetMetaDataDictionaryArrayUpdate(false);
+    reader->UpdateOutputInformation();
+    ImageType::RegionType requestedRegion = reader->GetOutput()->GetLargestPossibleRegion();
+    requestedRegion.SetIndex(2, 3);
+    requestedRegion.SetSize(2, 4);
+    reader->GetOutput()->SetRequestedRegion(requestedRegion);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  }
+  ITK_TEST_EXPECT_TRUE(SameOutput(sequentialReader, parallelReader));
+
+  std::cout << "Reading a series with a slice of another size" << std::endl;
+  ReaderType::FileNamesContainer mismatchedFileNames = fileNames;
+  {
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::SizeType{ { 5, 5, 1 } });
+    image->AllocateInitialized();
+    mismatchedFileNames[6] = prefix + "mismatch.mha";
+    itk::WriteImage(image, mismatchedFileNames[6]);
+  }
+  for (ReaderType * reader : { sequentialReader.GetPointer(), parallelReader.GetPointer() })
+  {
+    reader->SetFileNames(mismatchedFileNames);
+    reader->SetImageIO(nullptr);
+    ITK_TRY_EXPECT_EXCEPTION(reader->Update());
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
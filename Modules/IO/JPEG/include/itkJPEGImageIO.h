@@ -116,6 +116,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the progressive writing and the CMYK to RGB conversion. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   WriteSlice(const std::string & fileName, const void * const buffer);
 
@@ -79,6 +79,10 @@ extern ITKIOJPEG2000_EXPORT std::ostream &
  * by Mosaliganti K., Ibanez L., Megason S
  * https://doi.org/10.54294/bo53br
  *
+ * The tiles of a region are decoded concurrently, by bands of tiles
+ * each decoded through its own codec, and an image can be read at a
+ * reduced resolution level, e.g. to make thumbnails or to start a
+ * multi-resolution analysis without decoding the full resolution.
  *
  *  \ingroup IOFilters
  * \ingroup ITKIOJPEG2000
@@ -153,6 +157,26 @@ public:
   bool
   CanStreamWrite() override;
 
+  /** The resolution levels of the file are read through
+   * SetResolutionLevel(): each level discarded divides the size of the
+   * image read by two, rounded up, and multiplies its spacing by two. The
+   * origin is not shifted, the first pixel of each level being centered on
+   * the first pixel of the full resolution. ReadImageInformation() sets the number of resolution levels of the
+   * file. When writing, a number of levels larger than one is the number
+   * of levels written, at most the number the size of the image allows;
+   * otherwise that number, at most 6, is written. */
+  bool
+  SupportsResolutionLevels() const override
+  {
+    return true;
+  }
+
+  /** Set/Get the number of work units decoding the tiles of a region
+   * concurrently, and separating the components of an image written.
+   * Zero, the default, uses the global default number of threads. */
+  itkSetMacro(NumberOfWorkUnits, unsigned int);
+  itkGetConstMacro(NumberOfWorkUnits, unsigned int);
+
 protected:
   JPEG2000ImageIO();
   ~JPEG2000ImageIO() override;
@@ -160,14 +184,20 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the number of work units and the tile size. */
+  LightObject::Pointer
+  InternalClone() const override;
+
 private:
   std::unique_ptr<JPEG2000ImageIOInternal> m_Internal;
 
+  unsigned int m_NumberOfWorkUnits{ 0 };
+
   using SizeValueType = ImageIORegion::SizeValueType;
   using IndexValueType = ImageIORegion::IndexValueType;
 
   void
-  ComputeRegionInTileBoundaries(unsigned int dimension, SizeValueType tileSize, ImageIORegion & streamableRegion) const;
+  ComputeRegionInTileBoundaries(unsigned int dimension, ImageIORegion & streamableRegion) const;
 };
 } // end namespace itk
 
@@ -17,8 +17,14 @@
  *=========================================================================*/
 
 #include "itkJPEG2000ImageIO.h"
+#include "itkMultiThreaderBase.h"
 #include "itksys/SystemTools.hxx"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
 // for memset
 // for malloc
 
@@ -34,6 +40,70 @@ extern "C"
 
 namespace itk
 {
+namespace
+{
+// The ceiling of value / 2^factor, mapping the index of a full
+// resolution sample to the one of a reduced resolution level.
+inline OPJ_INT32
+CeilDivPow2(OPJ_INT32 value, unsigned int factor)
+{
+  return (value + (1 << factor) - 1) >> factor;
+}
+
+// The number of resolution levels of the codestream of a file, from the
+// number of decomposition levels of its main header COD marker segment,
+// or 0 if it is not found. The codestream starts with the SOC and SIZ
+// markers, at the beginning of a .j2k file, in a box of a .jp2 file.
+unsigned int
+ReadNumberOfResolutionLevels(const std::string & fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+
+  const auto readUInt16 = [&file]() {
+    unsigned char bytes[2] = { 0, 0 };
+    file.read(reinterpret_cast<char *>(bytes), 2);
+    return static_cast<unsigned int>((bytes[0] << 8) | bytes[1]);
+  };
+
+  const unsigned char startOfCodestream[4] = { 0xFF, 0x4F, 0xFF, 0x51 };
+  unsigned int        matched = 0;
+  for (int c = file.get(); c != EOF; c = file.get())
+  {
+    matched = c == startOfCodestream[matched] ? matched + 1 : (c == startOfCodestream[0] ? 1 : 0);
+    if (matched == 4)
+    {
+      break;
+    }
+  }
+  if (matched < 4)
+  {
+    return 0;
+  }
+
+  // Skip the SIZ marker segment, then the other segments of the main
+  // header until the COD one, before the first tile (SOT).
+  for (unsigned int marker = 0xFF51; file && marker != 0xFF90; marker = readUInt16())
+  {
+    const unsigned int length = readUInt16();
+    if (marker == 0xFF52)
+    {
+      // Scod, progression order, number of layers and multiple component
+      // transform, then the number of decomposition levels
+      file.ignore(5);
+      const int numberOfDecompositionLevels = file.get();
+      return file && numberOfDecompositionLevels != EOF ? static_cast<unsigned int>(numberOfDecompositionLevels) + 1
+                                                        : 0;
+    }
+    if (length < 2)
+    {
+      break;
+    }
+    file.ignore(length - 2);
+  }
+  return 0;
+}
+} // namespace
+
 class JPEG2000ImageIOInternal
 {
 public:
@@ -66,8 +136,216 @@ public:
   OPJ_UINT32 m_NumberOfTilesInY;
 
   opj_dparameters_t m_DecompressionParameters; /* decompression parameters */
+
+  OPJ_UINT32
+  GetNumberOfTiles(unsigned int dimension) const
+  {
+    return dimension == 0 ? m_NumberOfTilesInX : m_NumberOfTilesInY;
+  }
+
+  // The first index of a tile along a dimension, on the grid of the
+  // image read at the given resolution factor.
+  ImageIORegion::IndexValueType
+  GetTileStart(unsigned int dimension, OPJ_UINT32 tile, unsigned int factor) const
+  {
+    const OPJ_UINT32 start = dimension == 0 ? m_TileStartX + tile * m_TileWidth : m_TileStartY + tile * m_TileHeight;
+    return CeilDivPow2(static_cast<OPJ_INT32>(start), factor);
+  }
+
+  // Decode the tiles [firstTile, endTile) of the file, at the given
+  // resolution factor, and put their part in the band [bandStart,
+  // bandEnd) of the region into the buffer of the region. Each call uses
+  // its own stream and codec, so that bands are decoded concurrently.
+  // Returns the reason of the failure, an empty string on success.
+  std::string
+  DecodeTiles(const std::string &   fileName,
+              opj_dparameters_t     parameters,
+              const OPJ_UINT32      firstTile[2],
+              const OPJ_UINT32      endTile[2],
+              const OPJ_INT32       bandStart[2],
+              const OPJ_INT32       bandEnd[2],
+              const ImageIORegion & region,
+              unsigned int          numberOfComponents,
+              void *                buffer) const;
 };
 
+std::string
+JPEG2000ImageIOInternal::DecodeTiles(const std::string &   fileName,
+                                     opj_dparameters_t     parameters,
+                                     const OPJ_UINT32      firstTile[2],
+                                     const OPJ_UINT32      endTile[2],
+                                     const OPJ_INT32       bandStart[2],
+                                     const OPJ_INT32       bandEnd[2],
+                                     const ImageIORegion & region,
+                                     unsigned int          numberOfComponents,
+                                     void *                buffer) const
+{
+  FILE * l_file = fopen(fileName.c_str(), "rb");
+  if (!l_file)
+  {
+    return itksys::SystemTools::GetLastSystemError();
+  }
+
+  opj_stream_t * l_stream = opj_stream_create_default_file_stream(l_file, true);
+  opj_codec_t *  l_codec = nullptr;
+  opj_image_t *  l_image = nullptr;
+
+  const unsigned int factor = parameters.cp_reduce;
+
+  const std::string error = [&]() -> std::string {
+    if (!l_stream)
+    {
+      return "opj_stream_create_default_file_stream returns nullptr";
+    }
+
+    switch (parameters.decod_format)
+    {
+      case static_cast<int>(DecodingFormatEnum::J2K_CFMT):
+        l_codec = opj_create_decompress(CODEC_J2K);
+        break;
+      case static_cast<int>(DecodingFormatEnum::JP2_CFMT):
+        l_codec = opj_create_decompress(CODEC_JP2);
+        break;
+      case static_cast<int>(DecodingFormatEnum::JPT_CFMT):
+        l_codec = opj_create_decompress(CODEC_JPT);
+        break;
+      default:
+        return "Unknown decode format: " + std::to_string(parameters.decod_format);
+    }
+    if (!l_codec)
+    {
+      return "opj_create_decompress returns nullptr";
+    }
+
+    if (!opj_setup_decoder(l_codec, &parameters))
+    {
+      return "opj_setup_decoder returns false";
+    }
+
+    OPJ_INT32  l_tile_x0, l_tile_y0;
+    OPJ_UINT32 l_tile_width, l_tile_height, l_nb_tiles_x, l_nb_tiles_y;
+    if (!opj_read_header(l_codec,
+                         &l_image,
+                         &l_tile_x0,
+                         &l_tile_y0,
+                         &l_tile_width,
+                         &l_tile_height,
+                         &l_nb_tiles_x,
+                         &l_nb_tiles_y,
+                         l_stream) ||
+        !l_image)
+    {
+      return "opj_read_header returns false";
+    }
+
+    // The decode area, on the full resolution grid, selects the tiles
+    if (!opj_set_decode_area(l_codec,
+                             static_cast<OPJ_INT32>(m_TileStartX + firstTile[0] * m_TileWidth),
+                             static_cast<OPJ_INT32>(m_TileStartY + firstTile[1] * m_TileHeight),
+                             static_cast<OPJ_INT32>(m_TileStartX + endTile[0] * m_TileWidth),
+                             static_cast<OPJ_INT32>(m_TileStartY + endTile[1] * m_TileHeight)))
+    {
+      return "opj_set_decode_area returns false";
+    }
+
+    const ImageIORegion::IndexValueType regionStartX = region.GetIndex(0);
+    const ImageIORegion::IndexValueType regionStartY = region.GetIndex(1);
+    const ImageIORegion::SizeValueType  regionSizeX = region.GetSize(0);
+
+    std::vector<OPJ_BYTE> l_data;
+    bool                  l_go_on = true;
+    while (l_go_on)
+    {
+      OPJ_UINT32 l_tile_index;
+      OPJ_UINT32 l_data_size;
+      OPJ_INT32  l_current_tile_x0, l_current_tile_y0, l_current_tile_x1, l_current_tile_y1;
+      OPJ_UINT32 l_nb_comps;
+      if (!opj_read_tile_header(l_codec,
+                                &l_tile_index,
+                                &l_data_size,
+                                &l_current_tile_x0,
+                                &l_current_tile_y0,
+                                &l_current_tile_x1,
+                                &l_current_tile_y1,
+                                &l_nb_comps,
+                                &l_go_on,
+                                l_stream))
+      {
+        return "opj_read_tile_header returns false";
+      }
+      if (!l_go_on)
+      {
+        break;
+      }
+
+      l_data.resize(l_data_size);
+      if (!opj_decode_tile_data(l_codec, l_tile_index, l_data.data(), l_data_size, l_stream))
+      {
+        return "opj_decode_tile_data returns false";
+      }
+
+      // The tile is decoded at the reduced resolution, one plane per
+      // component. Only its part in the band is put into the buffer.
+      const OPJ_INT32 tileX0 = CeilDivPow2(l_current_tile_x0, factor);
+      const OPJ_INT32 tileY0 = CeilDivPow2(l_current_tile_y0, factor);
+      const OPJ_INT32 tileX1 = CeilDivPow2(l_current_tile_x1, factor);
+      const OPJ_INT32 tileY1 = CeilDivPow2(l_current_tile_y1, factor);
+
+      const SizeValueType tileSizeX = tileX1 - tileX0;
+      const SizeValueType tileSizeY = tileY1 - tileY0;
+      if (tileSizeX == 0 || tileSizeY == 0 || l_nb_comps != numberOfComponents)
+      {
+        continue;
+      }
+      const SizeValueType componentSize = l_data_size / (tileSizeX * tileSizeY * numberOfComponents);
+
+      const OPJ_INT32 x0 = std::max(tileX0, bandStart[0]);
+      const OPJ_INT32 x1 = std::min(tileX1, bandEnd[0]);
+      const OPJ_INT32 y0 = std::max(tileY0, bandStart[1]);
+      const OPJ_INT32 y1 = std::min(tileY1, bandEnd[1]);
+
+      for (unsigned int k = 0; k < numberOfComponents; ++k)
+      {
+        for (OPJ_INT32 y = y0; y < y1; ++y)
+        {
+          const OPJ_BYTE * source =
+            l_data.data() + ((k * tileSizeY + (y - tileY0)) * tileSizeX + (x0 - tileX0)) * componentSize;
+          auto * destination =
+            static_cast<unsigned char *>(buffer) +
+            (((y - regionStartY) * regionSizeX + (x0 - regionStartX)) * numberOfComponents + k) * componentSize;
+          for (OPJ_INT32 x = x0; x < x1; ++x)
+          {
+            std::memcpy(destination, source, componentSize);
+            source += componentSize;
+            destination += numberOfComponents * componentSize;
+          }
+        }
+      }
+    }
+
+    if (!opj_end_decompress(l_codec, l_stream))
+    {
+      return "opj_end_decompress returns false";
+    }
+    return {};
+  }();
+
+  if (l_stream)
+  {
+    opj_stream_destroy(l_stream);
+  }
+  fclose(l_file);
+  if (l_codec)
+  {
+    opj_destroy_codec(l_codec);
+  }
+  if (l_image)
+  {
+    opj_image_destroy(l_image);
+  }
+  return error;
+}
+
 
 JPEG2000ImageIO::JPEG2000ImageIO()
   : m_Internal(new JPEG2000ImageIOInternal)
@@ -100,10 +378,28 @@ JPEG2000ImageIO::JPEG2000ImageIO()
 
 JPEG2000ImageIO::~JPEG2000ImageIO() = default;
 
+LightObject::Pointer
+JPEG2000ImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_NumberOfWorkUnits = m_NumberOfWorkUnits;
+  rval->m_Internal->m_TileWidth = m_Internal->m_TileWidth;
+  rval->m_Internal->m_TileHeight = m_Internal->m_TileHeight;
+  return loPtr;
+}
+
 void
 JPEG2000ImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
 }
 
 bool
@@ -139,6 +435,19 @@ JPEG2000ImageIO::ReadImageInformation()
 {
   itkDebugMacro("ReadImageInformation()");
 
+  // The resolution level read must be one of the levels of the file
+  const unsigned int numberOfResolutionLevels = ReadNumberOfResolutionLevels(this->m_FileName);
+  if (numberOfResolutionLevels > 0)
+  {
+    this->SetNumberOfResolutionLevels(numberOfResolutionLevels);
+    if (this->GetResolutionLevel() >= numberOfResolutionLevels)
+    {
+      itkExceptionMacro("JPEG2000ImageIO cannot read the resolution level "
+                        << this->GetResolutionLevel() << " of " << this->GetFileName() << ", which has "
+                        << numberOfResolutionLevels << " resolution levels");
+    }
+  }
+
   FILE * l_file = fopen(this->m_FileName.c_str(), "rb");
 
   /* decompression parameters */
@@ -152,6 +461,7 @@ JPEG2000ImageIO::ReadImageInformation()
 
   /* set decoding parameters to default values */
   opj_set_default_decoder_parameters(&(this->m_Internal->m_DecompressionParameters));
+  this->m_Internal->m_DecompressionParameters.cp_reduce = static_cast<int>(this->GetResolutionLevel());
 
   opj_stream_t * cio = opj_stream_create_default_file_stream(l_file, true);
 
@@ -341,11 +651,19 @@ JPEG2000ImageIO::ReadImageInformation()
   itkDebugMacro("image->x1 = " << l_image->x1);
   itkDebugMacro("image->y1 = " << l_image->y1);
 
-  this->SetDimensions(0, l_image->x1);
-  this->SetDimensions(1, l_image->y1);
+  // Each discarded resolution level halves the size of the image
+  this->SetDimensions(0, CeilDivPow2(l_image->x1, this->GetResolutionLevel()));
+  this->SetDimensions(1, CeilDivPow2(l_image->y1, this->GetResolutionLevel()));
 
-  this->SetSpacing(0, 1.0); // FIXME : Get the real pixel resolution.
-  this->SetSpacing(1, 1.0); // FIXME : Get the real pixel resolution.
+  // The codestream has no physical pixel size, so the full resolution has a
+  // unit spacing. The origin is kept at reduced resolutions: the low-pass
+  // coefficient n of a JPEG2000 wavelet level is centered on the sample 2n
+  // of the level above, so that the pixel 0 of every resolution level is
+  // centered on the pixel 0 of the full resolution, and no half pixel
+  // shift applies as with the averaging of pixel pairs.
+  const double spacing = static_cast<double>(1u << this->GetResolutionLevel());
+  this->SetSpacing(0, spacing);
+  this->SetSpacing(1, spacing);
 
   /* close the byte stream */
   opj_stream_destroy(cio);
@@ -368,327 +686,111 @@ JPEG2000ImageIO::Read(void * buffer)
 {
   itkDebugMacro("JPEG2000ImageIO::Read() Begin");
 
-  FILE * l_file = fopen(this->m_FileName.c_str(), "rb");
+  const ImageIORegion regionToRead = this->GetIORegion();
+  const unsigned int  numberOfComponents = this->GetNumberOfComponents();
 
-  if (!l_file)
-  {
-    itkExceptionMacro("JPEG2000ImageIO failed to open file for reading: " << this->GetFileName() << std::endl
-                                                                          << "Reason: "
-                                                                          << itksys::SystemTools::GetLastSystemError());
-  }
+  opj_dparameters_t parameters = this->m_Internal->m_DecompressionParameters;
+  parameters.cp_reduce = static_cast<int>(this->GetResolutionLevel());
 
-  opj_stream_t * l_stream = opj_stream_create_default_file_stream(l_file, true);
-  if (!l_stream)
+  // The tiles intersecting the region, and the part of the region in
+  // each band of tiles
+  OPJ_UINT32 firstTile[2];
+  OPJ_UINT32 endTile[2];
+  for (unsigned int dimension = 0; dimension < 2; ++dimension)
   {
-    itkExceptionMacro("JPEG2000ImageIO failed to read file: "
-                      << this->GetFileName() << std::endl
-                      << "Reason: opj_stream_create_default_file_stream returns nullptr");
-  }
-
-  this->m_Internal->m_Dinfo = nullptr; /* handle to a decompressor */
-
-  opj_image_t * l_image = nullptr;
-
-  /* decode the code-stream */
-  /* ---------------------- */
-  switch (this->m_Internal->m_DecompressionParameters.decod_format)
-  {
-    case static_cast<int>(JPEG2000ImageIOInternal::DecodingFormatEnum::J2K_CFMT):
-    {
-      /* JPEG-2000 codestream */
-      /* get a decoder handle */
-      this->m_Internal->m_Dinfo = opj_create_decompress(CODEC_J2K);
-      if (!this->m_Internal->m_Dinfo)
-      {
-        itkExceptionMacro("JPEG2000ImageIO failed to read file: "
-                          << this->GetFileName() << std::endl
-                          << "Reason: opj_create_decompress(CODEC_J2K) returns nullptr");
-      }
-      break;
-    }
-    case static_cast<int>(JPEG2000ImageIOInternal::DecodingFormatEnum::JP2_CFMT):
+    const IndexValueType regionStart = regionToRead.GetIndex(dimension);
+    const IndexValueType regionEnd = regionStart + static_cast<IndexValueType>(regionToRead.GetSize(dimension));
+    firstTile[dimension] = 0;
+    endTile[dimension] = this->m_Internal->GetNumberOfTiles(dimension);
+    for (OPJ_UINT32 tile = 1; tile < this->m_Internal->GetNumberOfTiles(dimension); ++tile)
     {
-      /* JPEG 2000 compressed image data */
-      /* get a decoder handle */
-      this->m_Internal->m_Dinfo = opj_create_decompress(CODEC_JP2);
-      if (!this->m_Internal->m_Dinfo)
+      const IndexValueType tileStart = this->m_Internal->GetTileStart(dimension, tile, this->GetResolutionLevel());
+      if (tileStart <= regionStart)
       {
-        itkExceptionMacro("JPEG2000ImageIO failed to read file: "
-                          << this->GetFileName() << std::endl
-                          << "Reason: opj_create_decompress(CODEC_JP2) returns nullptr");
+        firstTile[dimension] = tile;
       }
-      break;
-    }
-    case static_cast<int>(JPEG2000ImageIOInternal::DecodingFormatEnum::JPT_CFMT):
-    {
-      /* JPEG 2000, JPIP */
-      /* get a decoder handle */
-      this->m_Internal->m_Dinfo = opj_create_decompress(CODEC_JPT);
-      if (!this->m_Internal->m_Dinfo)
+      if (tileStart >= regionEnd)
       {
-        itkExceptionMacro("JPEG2000ImageIO failed to read file: "
-                          << this->GetFileName() << std::endl
-                          << "Reason: opj_create_decompress(CODEC_JPT) returns nullptr");
+        endTile[dimension] = tile;
+        break;
       }
-      break;
     }
-    default:
-      fclose(l_file);
-      itkExceptionMacro("JPEG2000ImageIO failed to read file: "
-                        << this->GetFileName() << std::endl
-                        << "Reason: "
-                        << "Unknown decode format: " << this->m_Internal->m_DecompressionParameters.decod_format);
   }
-  /* catch events using our callbacks and give a local context */
 
-  /* setup the decoder decoding parameters using user parameters */
-  if (!opj_setup_decoder(this->m_Internal->m_Dinfo, &(this->m_Internal->m_DecompressionParameters)))
+  auto multiThreader = MultiThreaderBase::New();
+  if (m_NumberOfWorkUnits > 0)
   {
-    itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                              << "Reason: opj_setup_decoder returns false");
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
   }
-
-  OPJ_INT32 l_tile_x0, l_tile_y0;
-
-  OPJ_UINT32 l_tile_width;
-  OPJ_UINT32 l_tile_height;
-  OPJ_UINT32 l_nb_tiles_x;
-  OPJ_UINT32 l_nb_tiles_y;
-
-  bool bResult = opj_read_header(this->m_Internal->m_Dinfo,
-                                 &l_image,
-                                 &l_tile_x0,
-                                 &l_tile_y0,
-                                 &l_tile_width,
-                                 &l_tile_height,
-                                 &l_nb_tiles_x,
-                                 &l_nb_tiles_y,
-                                 l_stream);
-
-  if (!bResult)
-  {
-    opj_destroy_codec(this->m_Internal->m_Dinfo);
-    this->m_Internal->m_Dinfo = nullptr;
-    opj_stream_destroy(l_stream);
-    fclose(l_file);
-    itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                              << "Reason: opj_read_header returns false");
-  }
-
-  ImageIORegion regionToRead = this->GetIORegion();
-
-  ImageIORegion::SizeType  size = regionToRead.GetSize();
-  ImageIORegion::IndexType start = regionToRead.GetIndex();
-
-  const unsigned int sizex = size[0];
-  const unsigned int sizey = size[1];
-  // const unsigned int sizez = size[2];
-
-  const unsigned int startx = start[0];
-  const unsigned int starty = start[1];
-  // const unsigned int startz = start[2];
-
-  auto p_start_x = static_cast<OPJ_INT32>(startx);
-  auto p_start_y = static_cast<OPJ_INT32>(starty);
-  auto p_end_x = static_cast<OPJ_INT32>(startx + sizex);
-  auto p_end_y = static_cast<OPJ_INT32>(starty + sizey);
-
-  itkDebugMacro("opj_set_decode_area() before");
-  itkDebugMacro("p_start_x = " << p_start_x);
-  itkDebugMacro("p_start_y = " << p_start_y);
-  itkDebugMacro("p_end_x = " << p_end_x);
-  itkDebugMacro("p_end_y = " << p_end_y);
-
-  bResult = opj_set_decode_area(this->m_Internal->m_Dinfo, p_start_x, p_start_y, p_end_x, p_end_y);
-
-  itkDebugMacro("opj_set_decode_area() after");
-
-  if (!bResult)
-  {
-    opj_destroy_codec(this->m_Internal->m_Dinfo);
-    this->m_Internal->m_Dinfo = nullptr;
-    opj_stream_destroy(l_stream);
-    fclose(l_file);
-    itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                              << "Reason: opj_set_decode_area returns false");
-  }
-
-  OPJ_INT32 l_current_tile_x0;
-  OPJ_INT32 l_current_tile_y0;
-  OPJ_INT32 l_current_tile_x1;
-  OPJ_INT32 l_current_tile_y1;
-
-  OPJ_UINT32 l_tile_index;
-  OPJ_UINT32 l_data_size;
-
-  OPJ_UINT32 l_nb_comps;
-
-  OPJ_UINT32 l_max_data_size = 1000;
-
-  bool l_go_on = true;
-
-  auto * l_data = (OPJ_BYTE *)malloc(1000);
-
-  while (l_go_on)
-  {
-    bool tileHeaderRead = opj_read_tile_header(this->m_Internal->m_Dinfo,
-                                               &l_tile_index,
-                                               &l_data_size,
-                                               &l_current_tile_x0,
-                                               &l_current_tile_y0,
-                                               &l_current_tile_x1,
-                                               &l_current_tile_y1,
-                                               &l_nb_comps,
-                                               &l_go_on,
-                                               l_stream);
-
-    if (!tileHeaderRead)
+  const OPJ_UINT32 numberOfWorkUnits = multiThreader->GetNumberOfWorkUnits();
+
+  // The rows of tiles are split into bands, which are split along the
+  // columns of tiles when there are fewer rows than work units.
+  OPJ_UINT32 numberOfBands[2];
+  numberOfBands[1] = std::max<OPJ_UINT32>(1, std::min(endTile[1] - firstTile[1], numberOfWorkUnits));
+  numberOfBands[0] =
+    std::max<OPJ_UINT32>(1, std::min(endTile[0] - firstTile[0], numberOfWorkUnits / numberOfBands[1]));
+
+  std::vector<std::string> errors(numberOfBands[0] * numberOfBands[1]);
+  const auto               decodeBand = [&](SizeValueType band) {
+    OPJ_UINT32       bandFirstTile[2];
+    OPJ_UINT32       bandEndTile[2];
+    OPJ_INT32        bandStart[2];
+    OPJ_INT32        bandEnd[2];
+    const OPJ_UINT32 bandIndex[2] = { static_cast<OPJ_UINT32>(band % numberOfBands[0]),
+                                      static_cast<OPJ_UINT32>(band / numberOfBands[0]) };
+    for (unsigned int dimension = 0; dimension < 2; ++dimension)
     {
-      free(l_data);
-      opj_stream_destroy(l_stream);
-      fclose(l_file);
-      opj_destroy_codec(this->m_Internal->m_Dinfo);
-      opj_image_destroy(l_image);
-      itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                                << "Reason: opj_read_tile_header returns false");
+      const OPJ_UINT32 numberOfTiles = endTile[dimension] - firstTile[dimension];
+      bandFirstTile[dimension] =
+        firstTile[dimension] + numberOfTiles * bandIndex[dimension] / numberOfBands[dimension];
+      bandEndTile[dimension] =
+        firstTile[dimension] + numberOfTiles * (bandIndex[dimension] + 1) / numberOfBands[dimension];
+
+      const IndexValueType regionStart = regionToRead.GetIndex(dimension);
+      const IndexValueType regionEnd = regionStart + static_cast<IndexValueType>(regionToRead.GetSize(dimension));
+      bandStart[dimension] = static_cast<OPJ_INT32>(std::max(
+        regionStart, this->m_Internal->GetTileStart(dimension, bandFirstTile[dimension], this->GetResolutionLevel())));
+      bandEnd[dimension] = static_cast<OPJ_INT32>(
+        bandEndTile[dimension] < this->m_Internal->GetNumberOfTiles(dimension)
+          ? std::min(regionEnd,
+                     this->m_Internal->GetTileStart(dimension, bandEndTile[dimension], this->GetResolutionLevel()))
+          : regionEnd);
     }
 
-    itkDebugMacro("l_tile_index " << l_tile_index);
-    itkDebugMacro("l_data_size " << l_data_size);
-    itkDebugMacro("l_current_tile_x0 " << l_current_tile_x0);
-    itkDebugMacro("l_current_tile_y0 " << l_current_tile_y0);
-    itkDebugMacro("l_current_tile_x1 " << l_current_tile_x1);
-    itkDebugMacro("l_current_tile_y1 " << l_current_tile_y1);
-    itkDebugMacro("l_nb_comps " << l_nb_comps);
-    itkDebugMacro("l_go_on " << l_go_on);
-
-    if (l_go_on)
+    try
     {
-      if (l_data_size > l_max_data_size)
-      {
-        l_data = (OPJ_BYTE *)realloc(l_data, l_data_size);
-
-        if (!l_data)
-        {
-          opj_stream_destroy(l_stream);
-          fclose(l_file);
-          opj_destroy_codec(this->m_Internal->m_Dinfo);
-          opj_image_destroy(l_image);
-          itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                                    << "Reason: Error reallocating memory");
-        }
-
-        itkDebugMacro("reallocated for " << l_data_size);
-
-        l_max_data_size = l_data_size;
-      }
-
-      bool decodeTileData =
-        opj_decode_tile_data(this->m_Internal->m_Dinfo, l_tile_index, l_data, l_data_size, l_stream);
-
-      if (!decodeTileData)
-      {
-        free(l_data);
-        opj_stream_destroy(l_stream);
-        fclose(l_file);
-        opj_destroy_codec(this->m_Internal->m_Dinfo);
-        opj_image_destroy(l_image);
-        itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                                  << "Reason: opj_decode_tile_data returns false");
-      }
-
-      OPJ_BYTE * l_data_ptr = l_data;
-
-      const SizeValueType tsizex = l_current_tile_x1 - l_current_tile_x0;
-      const SizeValueType tsizey = l_current_tile_y1 - l_current_tile_y0;
-      const SizeValueType numberOfPixels = tsizex * tsizey;
-      const SizeValueType numberOfComponents = this->GetNumberOfComponents();
-      const SizeValueType sizePerComponentInBytes = l_data_size / (numberOfPixels * numberOfComponents);
-      const SizeValueType sizePerChannelInBytes = l_data_size / (numberOfComponents);
-
-      itkDebugMacro("sizePerComponentInBytes: " << sizePerComponentInBytes);
-      itkDebugMacro("sizePerChannelInBytes:   " << sizePerChannelInBytes);
-
-      const SizeValueType sizePerStrideXInBytes = sizePerChannelInBytes / tsizey;
-      const SizeValueType initialStrideInBytes =
-        (l_current_tile_y0 - p_start_y) * sizex * sizePerComponentInBytes * numberOfComponents;
-      const SizeValueType priorStrideInBytes =
-        (l_current_tile_x0 - p_start_x) * sizePerComponentInBytes * numberOfComponents;
-      const SizeValueType postStrideInBytes =
-        (p_end_x - l_current_tile_x1) * sizePerComponentInBytes * numberOfComponents;
-
-      itkDebugMacro("sizePerStrideYInBytes:   " << sizePerChannelInBytes / tsizex);
-      itkDebugMacro("sizePerStrideXInBytes:   " << sizePerStrideXInBytes);
-      itkDebugMacro("initialStrideInBytes:    " << initialStrideInBytes);
-      itkDebugMacro("priorStrideInBytes:      " << priorStrideInBytes);
-      itkDebugMacro("postStrideInBytes:       " << postStrideInBytes);
-
-
-      // TODO: Read the void buffer within the tile ROI. How do we specify the
-      // tile ROI iteration
-      for (unsigned int k = 0; k < numberOfComponents; ++k)
-      {
-        auto * charBuffer = (unsigned char *)buffer;
-        charBuffer += k * sizePerComponentInBytes;
-
-        charBuffer += initialStrideInBytes;
-
-        for (SizeValueType m = 0; m < tsizey; ++m)
-        {
-          charBuffer += priorStrideInBytes;
-          for (SizeValueType j = 0; j < sizePerStrideXInBytes; ++j)
-          {
-            *charBuffer = static_cast<unsigned char>(*l_data_ptr++);
-            charBuffer += numberOfComponents;
-          }
-          charBuffer += postStrideInBytes;
-        }
-      }
+      errors[band] = this->m_Internal->DecodeTiles(m_FileName,
+                                                   parameters,
+                                                   bandFirstTile,
+                                                   bandEndTile,
+                                                   bandStart,
+                                                   bandEnd,
+                                                   regionToRead,
+                                                   numberOfComponents,
+                                                   buffer);
     }
-    //       l_go_on = 0;
-  }
-
-  //  l_image = opj_decode( this->m_Dinfo, l_stream );
-
-  if (!opj_end_decompress(this->m_Internal->m_Dinfo, l_stream))
-  {
-    free(l_data);
-    opj_stream_destroy(l_stream);
-    fclose(l_file);
-    opj_destroy_codec(this->m_Internal->m_Dinfo);
-    opj_image_destroy(l_image);
-    itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                              << "Reason: opj_end_decompress returns false");
-  }
-
-  if (!l_image)
-  {
-    opj_destroy_codec(this->m_Internal->m_Dinfo);
-    this->m_Internal->m_Dinfo = nullptr;
-    opj_stream_destroy(l_stream);
-    fclose(l_file);
-    itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                              << "Reason: error whle reading image");
-  }
-
-  /* close the byte stream */
-  opj_stream_destroy(l_stream);
-  fclose(l_file);
-
-  if (this->m_Internal->m_Dinfo)
+    catch (const std::exception & e)
+    {
+      errors[band] = e.what();
+    }
+  };
+  if (errors.size() > 1)
   {
-    opj_destroy_codec(this->m_Internal->m_Dinfo);
-    this->m_Internal->m_Dinfo = nullptr;
+    multiThreader->ParallelizeArray(0, errors.size(), decodeBand, nullptr);
   }
-
-  if (l_image)
+  else
   {
-    opj_image_destroy(l_image);
+    decodeBand(0);
   }
 
-  if (l_data)
+  for (const std::string & error : errors)
   {
-    free(l_data);
+    if (!error.empty())
+    {
+      itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
+                                                                << "Reason: " << error);
+    }
   }
 
   itkDebugMacro("JPEG2000ImageIO::Read() End");
@@ -834,8 +936,13 @@ JPEG2000ImageIO::Write(const void * buffer)
     th >>= 1;
   }
 
-  // Clamp the number of resolutions to 6.
-  if (numberOfResolutions > 6)
+  // Clamp the number of resolutions to 6, unless more than one
+  // resolution level is requested.
+  if (this->GetNumberOfResolutionLevelsToWrite() > 1)
+  {
+    numberOfResolutions = std::min(numberOfResolutions, this->GetNumberOfResolutionLevelsToWrite());
+  }
+  else if (numberOfResolutions > 6)
   {
     numberOfResolutions = 6;
   }
@@ -907,35 +1014,41 @@ JPEG2000ImageIO::Write(const void * buffer)
   l_image->x1 = !l_image->x0 ? (w - 1) * subsampling_dx + 1 : l_image->x0 + (w - 1) * subsampling_dx + 1;
   l_image->y1 = !l_image->y0 ? (h - 1) * subsampling_dy + 1 : l_image->y0 + (h - 1) * subsampling_dy + 1;
 
-  // HERE, copy the buffer
-  SizeValueType index = 0;
-  SizeValueType numberOfPixels = SizeValueType(w) * SizeValueType(h);
-  itkDebugMacro(" START COPY BUFFER");
-  if (this->GetComponentType() == IOComponentEnum::UCHAR)
-  {
-    const auto * charBuffer = (const unsigned char *)buffer;
-    for (SizeValueType j = 0; j < numberOfPixels; ++j)
+  // HERE, copy the buffer. The components are separated concurrently,
+  // by rows, since OpenJPEG encodes the tiles one after the other.
+  const unsigned int numberOfComponents = this->GetNumberOfComponents();
+  const auto         copyRow = [&](SizeValueType row) {
+    SizeValueType index = row * SizeValueType(w);
+    if (this->GetComponentType() == IOComponentEnum::UCHAR)
     {
-      for (unsigned int k = 0; k < this->GetNumberOfComponents(); ++k)
+      const auto * charBuffer = static_cast<const unsigned char *>(buffer) + index * numberOfComponents;
+      for (SizeValueType j = 0; j < SizeValueType(w); ++j, ++index)
       {
-        l_image->comps[k].data[index] = *charBuffer++;
+        for (unsigned int k = 0; k < numberOfComponents; ++k)
+        {
+          l_image->comps[k].data[index] = *charBuffer++;
+        }
       }
-      ++index;
     }
-  }
-
-  if (this->GetComponentType() == IOComponentEnum::USHORT)
-  {
-    const auto * shortBuffer = (const unsigned short *)buffer;
-    for (SizeValueType j = 0; j < numberOfPixels; ++j)
+    else if (this->GetComponentType() == IOComponentEnum::USHORT)
     {
-      for (unsigned int k = 0; k < this->GetNumberOfComponents(); ++k)
+      const auto * shortBuffer = static_cast<const unsigned short *>(buffer) + index * numberOfComponents;
+      for (SizeValueType j = 0; j < SizeValueType(w); ++j, ++index)
       {
-        l_image->comps[k].data[index] = *shortBuffer++;
+        for (unsigned int k = 0; k < numberOfComponents; ++k)
+        {
+          l_image->comps[k].data[index] = *shortBuffer++;
+        }
       }
-      ++index;
     }
+  };
+  itkDebugMacro(" START COPY BUFFER");
+  auto multiThreader = MultiThreaderBase::New();
+  if (m_NumberOfWorkUnits > 0)
+  {
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
   }
+  multiThreader->ParallelizeArray(0, h, copyRow, nullptr);
   itkDebugMacro(" END COPY BUFFER");
   //--------------------------------------------------------------------
 
@@ -1080,8 +1193,8 @@ JPEG2000ImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORe
     // Compute the required set of tiles that fully contain the requested region
     streamableRegion = requestedRegion;
 
-    this->ComputeRegionInTileBoundaries(0, this->m_Internal->m_TileWidth, streamableRegion);
-    this->ComputeRegionInTileBoundaries(1, this->m_Internal->m_TileHeight, streamableRegion);
+    this->ComputeRegionInTileBoundaries(0, streamableRegion);
+    this->ComputeRegionInTileBoundaries(1, streamableRegion);
   }
 
   itkDebugMacro("Streamable region = " << streamableRegion);
@@ -1090,34 +1203,31 @@ JPEG2000ImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORe
 }
 
 void
-JPEG2000ImageIO::ComputeRegionInTileBoundaries(unsigned int    dimension,
-                                               SizeValueType   tileSize,
-                                               ImageIORegion & streamableRegion) const
+JPEG2000ImageIO::ComputeRegionInTileBoundaries(unsigned int dimension, ImageIORegion & streamableRegion) const
 {
-  SizeValueType  requestedSize = streamableRegion.GetSize(dimension);
-  IndexValueType requestedIndex = streamableRegion.GetIndex(dimension);
-
-  IndexValueType startQuantizedInTileSize = requestedIndex - (requestedIndex % tileSize);
-  IndexValueType requestedEnd = requestedIndex + requestedSize;
-  SizeValueType  extendedSize = requestedEnd - startQuantizedInTileSize;
-  SizeValueType  tileRemanent = extendedSize % tileSize;
-
-  SizeValueType sizeQuantizedInTileSize = extendedSize;
-
-  if (tileRemanent)
+  const IndexValueType requestedStart = streamableRegion.GetIndex(dimension);
+  const IndexValueType requestedEnd = requestedStart + static_cast<IndexValueType>(streamableRegion.GetSize(dimension));
+
+  // The tiles are not all the same size at a reduced resolution, their
+  // boundaries are the ones of the full resolution tiles, rounded up.
+  IndexValueType startQuantizedInTiles = 0;
+  IndexValueType endQuantizedInTiles = this->GetDimensions(dimension);
+  for (OPJ_UINT32 tile = 1; tile < this->m_Internal->GetNumberOfTiles(dimension); ++tile)
   {
-    sizeQuantizedInTileSize += tileSize - tileRemanent;
-  }
-
-  IndexValueType endQuantizedInTileSize = startQuantizedInTileSize + sizeQuantizedInTileSize - 1;
-
-  if (endQuantizedInTileSize > static_cast<int>(this->GetDimensions(dimension)))
-  {
-    sizeQuantizedInTileSize = this->GetDimensions(dimension) - startQuantizedInTileSize;
+    const IndexValueType tileStart = this->m_Internal->GetTileStart(dimension, tile, this->GetResolutionLevel());
+    if (tileStart <= requestedStart)
+    {
+      startQuantizedInTiles = tileStart;
+    }
+    if (tileStart >= requestedEnd)
+    {
+      endQuantizedInTiles = std::min(endQuantizedInTiles, tileStart);
+      break;
+    }
   }
 
-  streamableRegion.SetSize(dimension, sizeQuantizedInTileSize);
-  streamableRegion.SetIndex(dimension, startQuantizedInTileSize);
+  streamableRegion.SetSize(dimension, endQuantizedInTiles - startQuantizedInTiles);
+  streamableRegion.SetIndex(dimension, startQuantizedInTiles);
 }
 
 bool
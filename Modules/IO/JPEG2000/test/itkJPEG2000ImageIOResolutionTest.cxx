@@ -0,0 +1,235 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkJPEG2000ImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkRGBPixel.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// A slowly varying pixel value, which reduced resolutions keep
+template <typename TPixel>
+TPixel
+MakePixel(const itk::Index<2> & index)
+{
+  return static_cast<TPixel>((index[0] + index[1]) / 2);
+}
+
+template <>
+itk::RGBPixel<unsigned char>
+MakePixel<itk::RGBPixel<unsigned char>>(const itk::Index<2> & index)
+{
+  itk::RGBPixel<unsigned char> pixel;
+  pixel[0] = static_cast<unsigned char>(index[0]);
+  pixel[1] = static_cast<unsigned char>(index[1]);
+  pixel[2] = static_cast<unsigned char>((index[0] + index[1]) / 2);
+  return pixel;
+}
+
+template <typename TPixel>
+double
+PixelDifference(const TPixel & a, const TPixel & b)
+{
+  return std::abs(static_cast<double>(a) - static_cast<double>(b));
+}
+
+template <>
+double
+PixelDifference<itk::RGBPixel<unsigned char>>(const itk::RGBPixel<unsigned char> & a,
+                                              const itk::RGBPixel<unsigned char> & b)
+{
+  double difference = 0.0;
+  for (unsigned int k = 0; k < 3; ++k)
+  {
+    difference = std::max(difference, PixelDifference<unsigned char>(a[k], b[k]));
+  }
+  return difference;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+Read(const std::string &                  fileName,
+     unsigned int                         resolutionLevel,
+     unsigned int                         numberOfWorkUnits,
+     const typename TImage::RegionType * region = nullptr)
+{
+  auto io = itk::JPEG2000ImageIO::New();
+  io->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetImageIO(io);
+  reader->SetFileName(fileName);
+  reader->SetResolutionLevel(resolutionLevel);
+  if (region)
+  {
+    reader->SetUseStreaming(true);
+    reader->UpdateOutputInformation();
+    reader->GetOutput()->SetRequestedRegion(*region);
+  }
+  reader->Update();
+  return reader->GetOutput();
+}
+
+// Write a tiled image, read it back at full and reduced resolutions, by
+// one or several work units, and compare the pixels read with the ones
+// written, sampled at the resolution read.
+template <typename TImage>
+int
+JPEG2000ResolutionTest(const std::string & fileName)
+{
+  using ImageType = TImage;
+
+  auto image = ImageType::New();
+  image->SetRegions(typename ImageType::SizeType{ { 203, 157 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(MakePixel<typename ImageType::PixelType>(it.GetIndex()));
+  }
+
+  {
+    auto io = itk::JPEG2000ImageIO::New();
+    io->SetTileSize(80, 64);
+    io->SetNumberOfWorkUnits(3);
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(io);
+    writer->SetInput(image);
+    writer->SetFileName(fileName);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  }
+
+  int result = EXIT_SUCCESS;
+
+  for (const unsigned int resolutionLevel : { 0, 1, 2 })
+  {
+    const unsigned int scale = 1u << resolutionLevel;
+
+    typename ImageType::Pointer reference;
+    ITK_TRY_EXPECT_NO_EXCEPTION(reference = Read<ImageType>(fileName, resolutionLevel, 1));
+    const typename ImageType::SizeType expectedSize = { { (203 + scale - 1) / scale, (157 + scale - 1) / scale } };
+    ITK_TEST_EXPECT_EQUAL(reference->GetLargestPossibleRegion().GetSize(), expectedSize);
+    ITK_TEST_EXPECT_EQUAL(reference->GetSpacing()[0], static_cast<double>(scale));
+    // The pixel of index i is centered on the full resolution pixel of index i * scale
+    ITK_TEST_EXPECT_EQUAL(reference->GetOrigin()[0], 0.0);
+    ITK_TEST_EXPECT_EQUAL(reference->GetOrigin()[1], 0.0);
+
+    // Lossless at full resolution, close to the sampled image otherwise
+    const double tolerance = resolutionLevel == 0 ? 0.0 : 2.0 * scale;
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(reference, reference->GetBufferedRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      const typename ImageType::IndexType fullIndex = { { it.GetIndex()[0] * scale, it.GetIndex()[1] * scale } };
+      if (PixelDifference(it.Get(), image->GetPixel(fullIndex)) > tolerance)
+      {
+        std::cerr << "Wrong pixel value " << it.Get() << " at " << it.GetIndex() << " of " << fileName
+                  << " read at resolution level " << resolutionLevel << ", expected " << image->GetPixel(fullIndex)
+                  << std::endl;
+        result = EXIT_FAILURE;
+        break;
+      }
+    }
+
+    // The tiles decoded concurrently, the whole image or a region
+    const typename ImageType::RegionType region = { { { 50 / scale, 30 / scale } },
+                                                    { { 100 / scale, 70 / scale } } };
+    for (const typename ImageType::RegionType * requested :
+         { static_cast<const typename ImageType::RegionType *>(nullptr), &region })
+    {
+      typename ImageType::Pointer output;
+      ITK_TRY_EXPECT_NO_EXCEPTION(output = Read<ImageType>(fileName, resolutionLevel, 4, requested));
+      if (requested && !output->GetBufferedRegion().IsInside(region))
+      {
+        std::cerr << "The region read " << output->GetBufferedRegion() << " does not contain the requested region "
+                  << region << std::endl;
+        result = EXIT_FAILURE;
+      }
+      for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd();
+           ++it)
+      {
+        if (it.Get() != reference->GetPixel(it.GetIndex()))
+        {
+          std::cerr << "Wrong pixel value at " << it.GetIndex() << " of " << fileName
+                    << " decoded concurrently at resolution level " << resolutionLevel << std::endl;
+          result = EXIT_FAILURE;
+          break;
+        }
+      }
+    }
+  }
+
+  // The resolution levels discarded must be fewer than the levels stored
+  ITK_TRY_EXPECT_EXCEPTION(Read<ImageType>(fileName, 6, 1));
+
+  // The number of levels written is set through the writer, and read back
+  // with the image information. A level is read through the reader too.
+  {
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(itk::JPEG2000ImageIO::New());
+    writer->SetInput(image);
+    writer->SetFileName(fileName);
+    writer->SetNumberOfResolutionLevels(3);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    auto io = itk::JPEG2000ImageIO::New();
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetImageIO(io);
+    reader->SetFileName(fileName);
+    reader->SetResolutionLevel(2);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(io->GetNumberOfResolutionLevels(), 3);
+    ITK_TEST_EXPECT_EQUAL(io->GetResolutionLevel(), 2);
+    const typename ImageType::SizeType expectedSize = { { (203 + 3) / 4, (157 + 3) / 4 } };
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetLargestPossibleRegion().GetSize(), expectedSize);
+
+    reader->SetResolutionLevel(3);
+    ITK_TRY_EXPECT_EXCEPTION(reader->Update());
+  }
+
+  return result;
+}
+} // namespace
+
+int
+itkJPEG2000ImageIOResolutionTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  auto io = itk::JPEG2000ImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(io, JPEG2000ImageIO, StreamingImageIOBase);
+  ITK_TEST_SET_GET_VALUE(0, io->GetResolutionLevel());
+  ITK_TEST_EXPECT_TRUE(io->SupportsResolutionLevels());
+  ITK_TEST_SET_GET_VALUE(0, io->GetNumberOfWorkUnits());
+
+  int result = EXIT_SUCCESS;
+  result += JPEG2000ResolutionTest<itk::Image<unsigned char, 2>>(directory + "/itkJPEG2000ResolutionTest.j2k");
+  result += JPEG2000ResolutionTest<itk::Image<unsigned short, 2>>(directory + "/itkJPEG2000ResolutionTest16.jp2");
+  result += JPEG2000ResolutionTest<itk::Image<itk::RGBPixel<unsigned char>, 2>>(
+    directory + "/itkJPEG2000ResolutionTestRGB.j2k");
+
+  std::cout << "Test finished." << std::endl;
+  return result == EXIT_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -55,6 +55,11 @@ namespace itk
  * between the file type and the external expected type.  The
  * ConvertTraits template argument is used to do the conversion.
  *
+ * The cells are read into the contiguous cell arrays of the output
+ * mesh, see Mesh::SetCellsConnectivity(). The cell objects of the mesh
+ * are then allocated one array per cell type instead of one by one, and
+ * still copy their point identifiers.
+ *
  * A Pluggable factory pattern is used this allows different kinds of readers
  * to be registered (even at run time) without having to modify the
  * code in this class. Normally just setting the FileName with the
@@ -105,6 +110,9 @@ public:
   using OutputCellIdentifier = typename OutputMeshType::CellIdentifier;
   using OutputCellAutoPointer = typename OutputMeshType::CellAutoPointer;
   using OutputCellType = typename OutputMeshType::CellType;
+  using OutputCellTypesContainer = typename OutputMeshType::CellTypesContainer;
+  using OutputCellOffsetsContainer = typename OutputMeshType::CellOffsetsContainer;
+  using OutputCellConnectivityContainer = typename OutputMeshType::CellConnectivityContainer;
   using SizeValueType = typename MeshIOBase::SizeValueType;
 
   using OutputVertexCellType = VertexCell<OutputCellType>;
@@ -124,220 +124,135 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Re
 {
   typename TOutputMesh::Pointer output = this->GetOutput();
 
-  SizeValueType        index{};
-  OutputCellIdentifier id{};
-  while (index < m_MeshIO->GetCellBufferSize())
+  // Check the cells and count the cells and point identifiers of the output,
+  // in which polylines stored as line cells are loaded as individual edges.
+  const SizeValueType bufferSize = m_MeshIO->GetCellBufferSize();
+  SizeValueType       numberOfCells{};
+  SizeValueType       connectivitySize{};
+  SizeValueType       index{};
+  while (index < bufferSize)
   {
-    auto type = static_cast<CellGeometryEnum>(static_cast<int>(buffer[index++]));
+    const auto type = static_cast<CellGeometryEnum>(static_cast<int>(buffer[index++]));
+    const auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
+
+    unsigned int expectedNumberOfPoints = 0;
+    const char * cellName = "";
     switch (type)
     {
       case CellGeometryEnum::VERTEX_CELL:
-      {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputVertexCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Vertex Cell with number of points = " << numberOfPoints);
-        }
-        OutputCellAutoPointer cell;
-        auto *                vertexCell = new OutputVertexCellType;
-        for (unsigned int jj = 0; jj < OutputVertexCellType::NumberOfPoints; ++jj)
-        {
-          vertexCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-        }
-
-        cell.TakeOwnership(vertexCell);
-        output->SetCell(id++, cell);
+        expectedNumberOfPoints = OutputVertexCellType::NumberOfPoints;
+        cellName = "Vertex";
         break;
-      }
       case CellGeometryEnum::LINE_CELL:
-      {
-        // for polylines will be loaded as individual edges.
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints < 2)
-        {
-          itkExceptionMacro("Invalid Line Cell with number of points = " << numberOfPoints);
-        }
-        auto pointIDBuffer = static_cast<OutputPointIdentifier>(buffer[index++]);
-        for (unsigned int jj = 1; jj < numberOfPoints; ++jj)
-        {
-          OutputCellAutoPointer cell;
-          auto *                lineCell = new OutputLineCellType;
-          lineCell->SetPointId(0, pointIDBuffer);
-          pointIDBuffer = static_cast<OutputPointIdentifier>(buffer[index++]);
-          lineCell->SetPointId(1, pointIDBuffer);
-          cell.TakeOwnership(lineCell);
-          output->SetCell(id++, cell);
-        }
-        break;
-      }
       case CellGeometryEnum::POLYLINE_CELL:
-      {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
         if (numberOfPoints < 2)
         {
           itkExceptionMacro("Invalid Line Cell with number of points = " << numberOfPoints);
         }
-        auto *                polyLineCell = new OutputPolyLineCellType;
-        OutputCellAutoPointer cell;
-
-        for (unsigned int jj = 0; jj < numberOfPoints; ++jj)
-        {
-          auto pointIDBuffer = static_cast<OutputPointIdentifier>(buffer[index++]);
-          polyLineCell->SetPointId(jj, pointIDBuffer);
-        }
-
-        cell.TakeOwnership(polyLineCell);
-        output->SetCell(id++, cell);
         break;
-      }
       case CellGeometryEnum::TRIANGLE_CELL:
-      {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputTriangleCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Triangle Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                triangleCell = new OutputTriangleCellType;
-        for (unsigned int jj = 0; jj < OutputTriangleCellType::NumberOfPoints; ++jj)
-        {
-          triangleCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-        }
-
-        cell.TakeOwnership(triangleCell);
-        output->SetCell(id++, cell);
+        expectedNumberOfPoints = OutputTriangleCellType::NumberOfPoints;
+        cellName = "Triangle";
         break;
-      }
       case CellGeometryEnum::QUADRILATERAL_CELL:
-      {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputQuadrilateralCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Quadrilateral Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                quadrilateralCell = new OutputQuadrilateralCellType;
-        for (unsigned int jj = 0; jj < OutputQuadrilateralCellType::NumberOfPoints; ++jj)
-        {
-          quadrilateralCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-        }
-
-        cell.TakeOwnership(quadrilateralCell);
-        output->SetCell(id++, cell);
+        expectedNumberOfPoints = OutputQuadrilateralCellType::NumberOfPoints;
+        cellName = "Quadrilateral";
         break;
-      }
       case CellGeometryEnum::POLYGON_CELL:
-      {
-        // For polyhedron, if the number of points is 3, then we treat it as
-        // triangle cell
-        OutputCellAutoPointer cell;
-        auto                  numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints == OutputTriangleCellType::NumberOfPoints)
-        {
-          auto * triangleCell = new OutputTriangleCellType;
-          for (unsigned int jj = 0; jj < OutputTriangleCellType::NumberOfPoints; ++jj)
-          {
-            triangleCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-          }
-          cell.TakeOwnership(triangleCell);
-        }
-        else
-        {
-          auto * polygonCell = new OutputPolygonCellType;
-          for (unsigned int jj = 0; jj < numberOfPoints; ++jj)
-          {
-            polygonCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-          }
-          cell.TakeOwnership(polygonCell);
-        }
-
-        output->SetCell(id++, cell);
         break;
-      }
       case CellGeometryEnum::TETRAHEDRON_CELL:
-      {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputTetrahedronCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Tetrahedron Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                tetrahedronCell = new OutputTetrahedronCellType;
-        for (unsigned int jj = 0; jj < OutputTetrahedronCellType::NumberOfPoints; ++jj)
-        {
-          tetrahedronCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-        }
-
-        cell.TakeOwnership(tetrahedronCell);
-        output->SetCell(id++, cell);
+        expectedNumberOfPoints = OutputTetrahedronCellType::NumberOfPoints;
+        cellName = "Tetrahedron";
         break;
-      }
       case CellGeometryEnum::HEXAHEDRON_CELL:
-      {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputHexahedronCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Hexahedron Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                hexahedronCell = new OutputHexahedronCellType;
-        for (unsigned int jj = 0; jj < OutputHexahedronCellType::NumberOfPoints; ++jj)
-        {
-          hexahedronCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-        }
-
-        cell.TakeOwnership(hexahedronCell);
-        output->SetCell(id++, cell);
+        expectedNumberOfPoints = OutputHexahedronCellType::NumberOfPoints;
+        cellName = "Hexahedron";
         break;
-      }
       case CellGeometryEnum::QUADRATIC_EDGE_CELL:
-      {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputQuadraticEdgeCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Quadratic edge Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                quadraticEdgeCell = new OutputQuadraticEdgeCellType;
-        for (unsigned int jj = 0; jj < OutputQuadraticEdgeCellType::NumberOfPoints; ++jj)
-        {
-          quadraticEdgeCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-        }
-
-        cell.TakeOwnership(quadraticEdgeCell);
-        output->SetCell(id++, cell);
+        expectedNumberOfPoints = OutputQuadraticEdgeCellType::NumberOfPoints;
+        cellName = "Quadratic edge";
         break;
-      }
       case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+        expectedNumberOfPoints = OutputQuadraticTriangleCellType::NumberOfPoints;
+        cellName = "Quadratic triangle";
+        break;
+      default:
       {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputQuadraticTriangleCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Quadratic triangle Cell with number of points = " << numberOfPoints);
-        }
+        itkExceptionMacro("Unknown cell type");
+      }
+    }
+    if (expectedNumberOfPoints != 0 && numberOfPoints != expectedNumberOfPoints)
+    {
+      itkExceptionMacro("Invalid " << cellName << " Cell with number of points = " << numberOfPoints);
+    }
 
-        OutputCellAutoPointer cell;
-        auto *                quadraticTriangleCell = new OutputQuadraticTriangleCellType;
-        for (unsigned int jj = 0; jj < OutputQuadraticTriangleCellType::NumberOfPoints; ++jj)
-        {
-          quadraticTriangleCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-        }
+    index += numberOfPoints;
+    if (index > bufferSize)
+    {
+      itkExceptionMacro("Cell buffer of size " << bufferSize << " too small for its cells");
+    }
 
-        cell.TakeOwnership(quadraticTriangleCell);
-        output->SetCell(id++, cell);
-        break;
+    if (type == CellGeometryEnum::LINE_CELL)
+    {
+      numberOfCells += numberOfPoints - 1;
+      connectivitySize += 2 * (numberOfPoints - 1);
+    }
+    else
+    {
+      ++numberOfCells;
+      connectivitySize += numberOfPoints;
+    }
+  }
+
+  // Fill the contiguous cell arrays of the output, which then allocates
+  // its cells by type rather than one by one.
+  auto cellTypes = OutputCellTypesContainer::New();
+  cellTypes->CastToSTLContainer().resize(numberOfCells);
+  auto cellOffsets = OutputCellOffsetsContainer::New();
+  cellOffsets->CastToSTLContainer().resize(numberOfCells + 1);
+  auto cellConnectivity = OutputCellConnectivityContainer::New();
+  cellConnectivity->CastToSTLContainer().resize(connectivitySize);
+
+  CellGeometryEnum *      types = cellTypes->CastToSTLContainer().data();
+  SizeValueType *         offsets = cellOffsets->CastToSTLContainer().data();
+  OutputPointIdentifier * connectivity = cellConnectivity->CastToSTLContainer().data();
+
+  OutputCellIdentifier id{};
+  SizeValueType        offset{};
+  index = 0;
+  while (index < bufferSize)
+  {
+    auto       type = static_cast<CellGeometryEnum>(static_cast<int>(buffer[index++]));
+    const auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
+    if (type == CellGeometryEnum::LINE_CELL)
+    {
+      for (unsigned int jj = 1; jj < numberOfPoints; ++jj)
+      {
+        types[id] = CellGeometryEnum::LINE_CELL;
+        offsets[id++] = offset;
+        connectivity[offset++] = static_cast<OutputPointIdentifier>(buffer[index + jj - 1]);
+        connectivity[offset++] = static_cast<OutputPointIdentifier>(buffer[index + jj]);
       }
-      default:
+    }
+    else
+    {
+      // Polygons of 3 points are loaded as triangles
+      if (type == CellGeometryEnum::POLYGON_CELL && numberOfPoints == OutputTriangleCellType::NumberOfPoints)
       {
-        itkExceptionMacro("Unknown cell type");
+        type = CellGeometryEnum::TRIANGLE_CELL;
+      }
+      types[id] = type;
+      offsets[id++] = offset;
+      for (unsigned int jj = 0; jj < numberOfPoints; ++jj)
+      {
+        connectivity[offset++] = static_cast<OutputPointIdentifier>(buffer[index + jj]);
       }
     }
+    index += numberOfPoints;
   }
+  offsets[id] = offset;
+
+  output->SetCellsConnectivity(cellTypes, cellOffsets, cellConnectivity);
 }
 
 template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
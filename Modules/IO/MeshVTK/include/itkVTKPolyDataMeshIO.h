@@ -26,7 +26,9 @@
 #include "itkNumberToString.h"
 #include "itkMakeUniqueForOverwrite.h"
 
+#include <algorithm>
 #include <fstream>
+#include <initializer_list>
 #include <vector>
 
 namespace itk
@@ -35,6 +37,12 @@ namespace itk
  * \class VTKPolyDataMeshIO
  * \brief This class defines how to read and write vtk legacy file format.
  *
+ * ReadMeshInformation() records the position of the data of each
+ * section of the file, and skips the binary data, so that the other
+ * read methods seek to their section directly. The numbers of ASCII
+ * sections are read by large blocks, whose tokens are converted
+ * concurrently by the requested number of work units.
+ *
  * \author Wanlin Zhu. University of New South Wales, Australia.
  * \ingroup IOFilters
  * \ingroup ITKIOMeshVTK
@@ -92,6 +100,12 @@ public:
   void
   ReadCellData(void * buffer) override;
 
+  /** Set/Get the number of work units converting the numbers of ASCII
+   * files. Zero, the default, uses the default number of work units of
+   * the multi-threader. */
+  itkSetMacro(NumberOfWorkUnits, unsigned int);
+  itkGetConstMacro(NumberOfWorkUnits, unsigned int);
+
   /*-------- This part of the interfaces deals with writing data. ----- */
   /** Determine if the file can be written with this MeshIO implementation.
    * \param fileName The name of the file to test for writing.
@@ -197,17 +211,10 @@ protected:
   void
   ReadPointsBufferAsASCII(std::ifstream & inputFile, T * buffer)
   {
-    std::string line;
-
-    while (!inputFile.eof())
+    if (this->SeekSection(inputFile, "POINTS"))
     {
-      std::getline(inputFile, line, '\n');
-
-      if (line.find("POINTS") != std::string::npos)
-      {
-        /**  Load the point coordinates into the itk::Mesh */
-        Self::ReadComponentsAsASCII(inputFile, buffer, this->m_NumberOfPoints * this->m_PointDimension);
-      }
+      /**  Load the point coordinates into the itk::Mesh */
+      this->ReadComponentsAsASCII(inputFile, buffer, this->m_NumberOfPoints * this->m_PointDimension);
     }
   }
 
@@ -215,21 +222,14 @@ protected:
   void
   ReadPointsBufferAsBINARY(std::ifstream & inputFile, T * buffer)
   {
-    std::string line;
-
-    while (!inputFile.eof())
+    if (this->SeekSection(inputFile, "POINTS"))
     {
-      std::getline(inputFile, line, '\n');
-
-      if (line.find("POINTS") != std::string::npos)
+      /**  Load the point coordinates into the itk::Mesh */
+      SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
+      inputFile.read(reinterpret_cast<char *>(buffer), numberOfComponents * sizeof(T));
+      if constexpr (itk::ByteSwapper<T>::SystemIsLittleEndian())
       {
-        /**  Load the point coordinates into the itk::Mesh */
-        SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        inputFile.read(reinterpret_cast<char *>(buffer), numberOfComponents * sizeof(T));
-        if constexpr (itk::ByteSwapper<T>::SystemIsLittleEndian())
-        {
-          itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
-        }
+        itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
       }
     }
   }
@@ -246,41 +246,37 @@ protected:
   {
     StringType line;
 
-    while (!inputFile.eof())
+    if (this->SeekSection(inputFile, "POINT_DATA"))
     {
-      std::getline(inputFile, line, '\n');
-      if (line.find("POINT_DATA") != std::string::npos)
+      if (!inputFile.eof())
+      {
+        std::getline(inputFile, line, '\n');
+      }
+      else
+      {
+        itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
+      }
+
+      /** For scalars we have to read the next line of LOOKUP_TABLE */
+      if (line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos)
       {
         if (!inputFile.eof())
         {
           std::getline(inputFile, line, '\n');
-        }
-        else
-        {
-          itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-        }
-
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if (line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos)
-        {
-          if (!inputFile.eof())
-          {
-            std::getline(inputFile, line, '\n');
-            if (line.find("LOOKUP_TABLE") == std::string::npos)
-            {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
-          else
+          if (line.find("LOOKUP_TABLE") == std::string::npos)
           {
             itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
           }
         }
-
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        Self::ReadComponentsAsASCII(
-          inputFile, buffer, this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents);
+        else
+        {
+          itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
+        }
       }
+
+      /** for VECTORS or NORMALS or TENSORS, we could read them directly */
+      this->ReadComponentsAsASCII(
+        inputFile, buffer, this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents);
     }
   }
 
@@ -290,45 +286,41 @@ protected:
   {
     StringType line;
 
-    while (!inputFile.eof())
+    if (this->SeekSection(inputFile, "POINT_DATA"))
     {
-      std::getline(inputFile, line, '\n');
-      if (line.find("POINT_DATA") != std::string::npos)
+      if (!inputFile.eof())
+      {
+        std::getline(inputFile, line, '\n');
+      }
+      else
+      {
+        itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
+      }
+
+      /** For scalars we have to read the next line of LOOKUP_TABLE */
+      if (line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos)
       {
         if (!inputFile.eof())
         {
           std::getline(inputFile, line, '\n');
-        }
-        else
-        {
-          itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-        }
-
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if (line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos)
-        {
-          if (!inputFile.eof())
-          {
-            std::getline(inputFile, line, '\n');
-            if (line.find("LOOKUP_TABLE") == std::string::npos)
-            {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
-          else
+          if (line.find("LOOKUP_TABLE") == std::string::npos)
           {
             itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
           }
         }
-
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        SizeValueType numberOfComponents = this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents;
-        inputFile.read(reinterpret_cast<char *>(buffer), numberOfComponents * sizeof(T));
-        if constexpr (itk::ByteSwapper<T>::SystemIsLittleEndian())
+        else
         {
-          itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
+          itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
         }
       }
+
+      /** for VECTORS or NORMALS or TENSORS, we could read them directly */
+      SizeValueType numberOfComponents = this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents;
+      inputFile.read(reinterpret_cast<char *>(buffer), numberOfComponents * sizeof(T));
+      if constexpr (itk::ByteSwapper<T>::SystemIsLittleEndian())
+      {
+        itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
+      }
     }
   }
 
@@ -338,41 +330,36 @@ protected:
   {
     StringType line;
 
-    while (!inputFile.eof())
+    if (this->SeekSection(inputFile, "CELL_DATA"))
     {
-      std::getline(inputFile, line, '\n');
-      if (line.find("CELL_DATA") != std::string::npos)
+      if (!inputFile.eof())
+      {
+        std::getline(inputFile, line, '\n');
+      }
+      else
+      {
+        itkExceptionMacro("UnExpected end of line while trying to read CELL_DATA");
+      }
+
+      /** For scalars we have to read the next line of LOOKUP_TABLE */
+      if (line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos)
       {
         if (!inputFile.eof())
         {
           std::getline(inputFile, line, '\n');
-        }
-        else
-        {
-          itkExceptionMacro("UnExpected end of line while trying to read CELL_DATA");
-        }
-
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if (line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos)
-        {
-          if (!inputFile.eof())
-          {
-            std::getline(inputFile, line, '\n');
-            if (line.find("LOOKUP_TABLE") == std::string::npos)
-            {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
-          else
+          if (line.find("LOOKUP_TABLE") == std::string::npos)
           {
             itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
           }
         }
-
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        Self::ReadComponentsAsASCII(
-          inputFile, buffer, this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents);
+        else
+        {
+          itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
+        }
       }
+
+      /** for VECTORS or NORMALS or TENSORS, we could read them directly */
+      this->ReadComponentsAsASCII(inputFile, buffer, this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents);
     }
   }
 
@@ -382,44 +369,40 @@ protected:
   {
     StringType line;
 
-    while (!inputFile.eof())
+    if (this->SeekSection(inputFile, "CELL_DATA"))
     {
-      std::getline(inputFile, line, '\n');
-      if (line.find("POINT_DATA") != std::string::npos)
+      if (!inputFile.eof())
+      {
+        std::getline(inputFile, line, '\n');
+      }
+      else
+      {
+        itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
+      }
+
+      /** For scalars we have to read the next line of LOOKUP_TABLE */
+      if (line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos)
       {
         if (!inputFile.eof())
         {
           std::getline(inputFile, line, '\n');
-        }
-        else
-        {
-          itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-        }
-
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if (line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos)
-        {
-          if (!inputFile.eof())
-          {
-            std::getline(inputFile, line, '\n');
-            if (line.find("LOOKUP_TABLE") == std::string::npos)
-            {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
-          else
+          if (line.find("LOOKUP_TABLE") == std::string::npos)
           {
             itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
           }
         }
-        /** For VECTORS or NORMALS or TENSORS, we could read them directly */
-        SizeValueType numberOfComponents = this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents;
-        inputFile.read(reinterpret_cast<char *>(buffer), numberOfComponents * sizeof(T));
-        if constexpr (itk::ByteSwapper<T>::SystemIsLittleEndian())
+        else
         {
-          itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
+          itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
         }
       }
+      /** For VECTORS or NORMALS or TENSORS, we could read them directly */
+      SizeValueType numberOfComponents = this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents;
+      inputFile.read(reinterpret_cast<char *>(buffer), numberOfComponents * sizeof(T));
+      if constexpr (itk::ByteSwapper<T>::SystemIsLittleEndian())
+      {
+        itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
+      }
     }
   }
 
@@ -525,8 +508,11 @@ protected:
           }
         }
 
-        polylines->InsertElement(numberOfPolylines++, pointIds);
-        numberOfLineIndices += pointIds.size();
+        if (!pointIds.empty())
+        {
+          polylines->InsertElement(numberOfPolylines++, pointIds);
+          numberOfLineIndices += pointIds.size();
+        }
         index += nn;
       }
 
@@ -597,7 +583,7 @@ protected:
       ExposeMetaData<unsigned int>(metaDic, "numberOfVertexIndices", numberOfVertexIndices);
       outputFile << "VERTICES " << numberOfVertices << ' ' << numberOfVertexIndices << '\n';
       const auto data = make_unique_for_overwrite<unsigned int[]>(numberOfVertexIndices);
-      ReadCellsBuffer(buffer, data.get());
+      this->CopyCellsOfTypes(buffer, data.get(), { CellGeometryEnum::VERTEX_CELL });
       itk::ByteSwapper<unsigned int>::SwapWriteRangeFromSystemToBigEndian(
         data.get(), numberOfVertexIndices, &outputFile);
       outputFile << '\n';
@@ -630,8 +616,11 @@ protected:
             pointIds.push_back(static_cast<SizeValueType>(buffer[index + jj]));
           }
         }
-        polylines->InsertElement(numberOfPolylines++, pointIds);
-        numberOfLineIndices += pointIds.size();
+        if (!pointIds.empty())
+        {
+          polylines->InsertElement(numberOfPolylines++, pointIds);
+          numberOfLineIndices += pointIds.size();
+        }
         index += nn;
       }
 
@@ -665,7 +654,10 @@ protected:
       ExposeMetaData<unsigned int>(metaDic, "numberOfPolygonIndices", numberOfPolygonIndices);
       outputFile << "POLYGONS " << numberOfPolygons << ' ' << numberOfPolygonIndices << '\n';
       const auto data = make_unique_for_overwrite<unsigned int[]>(numberOfPolygonIndices);
-      ReadCellsBuffer(buffer, data.get());
+      this->CopyCellsOfTypes(
+        buffer,
+        data.get(),
+        { CellGeometryEnum::POLYGON_CELL, CellGeometryEnum::TRIANGLE_CELL, CellGeometryEnum::QUADRILATERAL_CELL });
       itk::ByteSwapper<unsigned int>::SwapWriteRangeFromSystemToBigEndian(
         data.get(), numberOfPolygonIndices, &outputFile);
       outputFile << '\n';
@@ -1122,33 +1114,53 @@ protected:
     }
   }
 
-  /** Convenience method returns the IOComponentEnum corresponding to a string. */
-  IOComponentEnum
-  GetComponentTypeFromString(const std::string & pointType);
-
-private:
-  /** Reads the specified number of components from the specified input file into the specified buffer.
-   * \note This member function is overloaded for `float` and `double`, in order to support reading infinity and NaN
-   * values.
-   */
-  template <typename T>
-  static void
-  ReadComponentsAsASCII(std::ifstream & inputFile, T * const buffer, const SizeValueType numberOfComponents)
+  /** Copy the number of points and the point ids of the cells of the given types, as written in the sections of the
+   * file, from a cells buffer. */
+  template <typename TInput, typename TOutput>
+  void
+  CopyCellsOfTypes(TInput * input, TOutput * output, std::initializer_list<CellGeometryEnum> cellTypes)
   {
-    for (SizeValueType i = 0; i < numberOfComponents; ++i)
+    SizeValueType inputIndex = 0;
+    SizeValueType outputIndex = 0;
+    for (SizeValueType ii = 0; ii < this->m_NumberOfCells; ++ii)
     {
-      if (!(inputFile >> buffer[i]))
+      const auto cellType = static_cast<CellGeometryEnum>(static_cast<int>(input[inputIndex++]));
+      const auto nn = static_cast<unsigned int>(input[inputIndex++]);
+      if (std::find(cellTypes.begin(), cellTypes.end(), cellType) != cellTypes.end())
       {
-        itkGenericExceptionMacro("Failed to read a component from the specified ASCII input file!");
+        output[outputIndex++] = nn;
+        for (unsigned int jj = 0; jj < nn; ++jj)
+        {
+          output[outputIndex++] = static_cast<TOutput>(input[inputIndex + jj]);
+        }
       }
+      inputIndex += nn;
     }
   }
 
-  static void
-  ReadComponentsAsASCII(std::ifstream & inputFile, float * const buffer, const SizeValueType numberOfComponents);
+  /** Convenience method returns the IOComponentEnum corresponding to a string. */
+  IOComponentEnum
+  GetComponentTypeFromString(const std::string & pointType);
+
+  /** Seek the data following the first header line containing the keyword,
+   * as found by ReadMeshInformation(). Returns false when there is none. */
+  bool
+  SeekSection(std::ifstream & inputFile, const char * keyword) const;
+
+private:
+  /** A header line of the file and the position of the data following it. */
+  struct Section
+  {
+    StringType     header;
+    std::streampos dataPosition;
+  };
 
-  static void
-  ReadComponentsAsASCII(std::ifstream & inputFile, double * const buffer, const SizeValueType numberOfComponents);
+  /** Reads the specified number of components from the specified input file into the specified buffer, leaving the
+   * file after the last component. Infinity and NaN floating point values are supported.
+   */
+  template <typename T>
+  void
+  ReadComponentsAsASCII(std::ifstream & inputFile, T * const buffer, const SizeValueType numberOfComponents);
 
   template <typename TOffset>
   void
@@ -1159,6 +1171,11 @@ private:
   ReadCellsBufferAsBINARYConnectivityType(std::ifstream & inputFile, void * buffer);
 
   uint8_t m_ReadMeshVersionMajor{ 4 };
+
+  unsigned int m_NumberOfWorkUnits{ 0 };
+
+  /** The sections of the file found by ReadMeshInformation(), in file order */
+  std::vector<Section> m_Sections{};
 };
 } // end namespace itk
 
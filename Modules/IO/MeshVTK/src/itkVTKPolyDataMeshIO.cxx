@@ -20,67 +20,332 @@
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
 
 #include <double-conversion/string-to-double.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <limits>
+#include <string_view>
+#include <type_traits>
 
 namespace itk
 {
 
 namespace
 {
-template <typename TFloatingPoint>
+/** Maximum size of the blocks of an ASCII data section converted at once */
+constexpr size_t ASCIIBlockSize = size_t{ 1 } << 24;
+
+/** Minimum size of the chunks of a block converted by a work unit, below which a block is not worth splitting */
+constexpr size_t MinimumASCIIChunkSize = size_t{ 1 } << 16;
+
+bool
+IsASCIISeparator(const char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// Converts the characters [first, last) of a token into a component value
+template <typename T>
+bool
+ConvertASCIIComponent(const char * first, const char * last, T & value)
+{
+  if constexpr (std::is_same_v<T, long double>)
+  {
+    const std::string token(first, last);
+    char *            tokenEnd = nullptr;
+    value = std::strtold(token.c_str(), &tokenEnd);
+    return tokenEnd == token.c_str() + token.size();
+  }
+  else if constexpr (std::is_floating_point_v<T>)
+  {
+    using NumericLimits = std::numeric_limits<T>;
+
+    const std::string_view token(first, last - first);
+    if ((token == "NaN") || (token == "nan"))
+    {
+      value = NumericLimits::quiet_NaN();
+      return true;
+    }
+    if (token == "Infinity")
+    {
+      value = NumericLimits::infinity();
+      return true;
+    }
+    if (token == "-Infinity")
+    {
+      value = -NumericLimits::infinity();
+      return true;
+    }
+
+    const int numberOfChars = Math::CastWithRangeCheck<int>(token.size());
+
+    constexpr auto                                   double_NaN = std::numeric_limits<double>::quiet_NaN();
+    int                                              processedCharCount{ 0 };
+    const double_conversion::StringToDoubleConverter converter(0, double_NaN, double_NaN, "inf", "nan");
+    value = converter.StringTo<T>(first, numberOfChars, &processedCharCount);
+    return processedCharCount == numberOfChars && !std::isnan(value);
+  }
+  else
+  {
+    const bool negative = (*first == '-');
+    if (negative || *first == '+')
+    {
+      ++first;
+    }
+    if (first == last)
+    {
+      return false;
+    }
+
+    using MagnitudeType = unsigned long long;
+    MagnitudeType magnitude = 0;
+    for (; first != last; ++first)
+    {
+      if (*first < '0' || *first > '9')
+      {
+        return false;
+      }
+      const auto digit = static_cast<MagnitudeType>(*first - '0');
+      if (magnitude > (std::numeric_limits<MagnitudeType>::max() - digit) / 10)
+      {
+        return false;
+      }
+      magnitude = magnitude * 10 + digit;
+    }
+
+    if (!negative)
+    {
+      value = static_cast<T>(magnitude);
+      return magnitude <= static_cast<MagnitudeType>(std::numeric_limits<T>::max());
+    }
+    if (magnitude == 0)
+    {
+      value = T{};
+      return true;
+    }
+    if constexpr (std::is_signed_v<T>)
+    {
+      // -(magnitude - 1) - 1 does not overflow for the lowest value
+      value = static_cast<T>(-static_cast<long long>(magnitude - 1) - 1);
+      return magnitude - 1 <= static_cast<MagnitudeType>(std::numeric_limits<T>::max());
+    }
+    return false;
+  }
+}
+
+// Reads the components of an ASCII data section from the current position of the stream. The section is read by
+// blocks of blockSize characters, whose tokens are counted, then converted, concurrently by the work units, each one
+// in its own chunk of the block. The blocks are read serially when there is no multi-threader. The stream is left
+// after the last component.
+template <typename T>
 void
-ReadFloatingPointsAsASCII(std::ifstream &        inputFile,
-                          TFloatingPoint * const buffer,
-                          const SizeValueType    numberOfFloatingPoints)
+ReadASCIIComponents(std::istream &      inputFile,
+                    T * const           buffer,
+                    const SizeValueType numberOfComponents,
+                    const size_t        blockSize,
+                    MultiThreaderBase * multiThreader)
 {
-  std::string str;
+  const SizeValueType numberOfChunks =
+    multiThreader
+      ? std::clamp<SizeValueType>(blockSize / MinimumASCIIChunkSize, 1, multiThreader->GetNumberOfWorkUnits())
+      : 1;
+  const auto forEachChunk = [numberOfChunks, multiThreader](const auto & chunkFunction) {
+    if (numberOfChunks == 1)
+    {
+      chunkFunction(0);
+    }
+    else
+    {
+      multiThreader->ParallelizeArray(0, numberOfChunks, chunkFunction, nullptr);
+    }
+  };
+
+  std::vector<size_t>        chunkBegin(numberOfChunks + 1);
+  std::vector<SizeValueType> chunkNumberOfTokens(numberOfChunks);
+  std::vector<size_t>        chunkConvertedEnd(numberOfChunks);
+  std::vector<size_t>        chunkFailedToken(numberOfChunks);
+
+  std::vector<char> block;
+  size_t            carriedSize = 0; // characters of the token split by the end of the previous block
+  SizeValueType     numberOfReadComponents = 0;
 
-  for (SizeValueType i = 0; i < numberOfFloatingPoints; ++i)
+  while (numberOfReadComponents < numberOfComponents)
   {
-    buffer[i] = [&str, &inputFile] {
-      if (inputFile >> str)
+    const std::streampos blockPosition = inputFile.tellg();
+    block.resize(carriedSize + blockSize);
+    inputFile.read(block.data() + carriedSize, blockSize);
+    const auto readSize = static_cast<size_t>(inputFile.gcount());
+    const bool isLastBlock = readSize < blockSize;
+    block.resize(carriedSize + readSize);
+
+    // The token at the end of the block may continue in the next block
+    size_t blockEnd = block.size();
+    if (!isLastBlock)
+    {
+      while (blockEnd > 0 && !IsASCIISeparator(block[blockEnd - 1]))
+      {
+        --blockEnd;
+      }
+      if (blockEnd == 0)
+      {
+        itkGenericExceptionMacro("Failed to read a component from the specified ASCII input file!");
+      }
+    }
+
+    // Split the block into chunks starting at separators, so that no token spans two chunks
+    chunkBegin[0] = 0;
+    chunkBegin[numberOfChunks] = blockEnd;
+    for (SizeValueType chunk = 1; chunk < numberOfChunks; ++chunk)
+    {
+      size_t position = std::max(chunkBegin[chunk - 1], blockEnd * chunk / numberOfChunks);
+      while (position < blockEnd && !IsASCIISeparator(block[position]))
+      {
+        ++position;
+      }
+      chunkBegin[chunk] = position;
+    }
+
+    forEachChunk([&block, &chunkBegin, &chunkNumberOfTokens](SizeValueType chunk) {
+      SizeValueType numberOfTokens = 0;
+      bool          inSeparators = true;
+      for (size_t position = chunkBegin[chunk]; position < chunkBegin[chunk + 1]; ++position)
       {
-        using NumericLimits = std::numeric_limits<TFloatingPoint>;
+        const bool isSeparator = IsASCIISeparator(block[position]);
+        numberOfTokens += (inSeparators && !isSeparator);
+        inSeparators = isSeparator;
+      }
+      chunkNumberOfTokens[chunk] = numberOfTokens;
+    });
+
+    std::vector<SizeValueType> chunkFirstComponent(numberOfChunks);
+    SizeValueType              numberOfTokens = numberOfReadComponents;
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      chunkFirstComponent[chunk] = numberOfTokens;
+      numberOfTokens += chunkNumberOfTokens[chunk];
+    }
 
-        if ((str == "NaN") || (str == "nan"))
+    constexpr auto noFailure = std::numeric_limits<size_t>::max();
+    forEachChunk([&](SizeValueType chunk) {
+      SizeValueType component = chunkFirstComponent[chunk];
+      size_t        position = chunkBegin[chunk];
+      const size_t  end = chunkBegin[chunk + 1];
+      chunkConvertedEnd[chunk] = 0;
+      chunkFailedToken[chunk] = noFailure;
+      while (component < numberOfComponents)
+      {
+        while (position < end && IsASCIISeparator(block[position]))
         {
-          return NumericLimits::quiet_NaN();
+          ++position;
         }
-        if (str == "Infinity")
+        if (position == end)
         {
-          return NumericLimits::infinity();
+          break;
         }
-        if (str == "-Infinity")
+        const size_t tokenBegin = position;
+        while (position < end && !IsASCIISeparator(block[position]))
         {
-          return -NumericLimits::infinity();
+          ++position;
         }
-
-        const int numberOfChars = Math::CastWithRangeCheck<int>(str.size());
-
-        constexpr auto                                   double_NaN = std::numeric_limits<double>::quiet_NaN();
-        int                                              processedCharCount{ 0 };
-        const double_conversion::StringToDoubleConverter converter(0, double_NaN, double_NaN, "inf", "nan");
-        const auto                                       conversionResult =
-          converter.StringTo<TFloatingPoint>(str.c_str(), numberOfChars, &processedCharCount);
-
-        if (processedCharCount == numberOfChars && !std::isnan(conversionResult))
+        if (!ConvertASCIIComponent(block.data() + tokenBegin, block.data() + position, buffer[component]))
         {
-          return conversionResult;
+          chunkFailedToken[chunk] = tokenBegin;
+          break;
         }
+        chunkConvertedEnd[chunk] = position;
+        ++component;
+      }
+    });
+
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      if (chunkFailedToken[chunk] != noFailure)
+      {
+        const auto tokenBegin = block.cbegin() + chunkFailedToken[chunk];
+        const auto tokenEnd = std::find_if(tokenBegin, std::min(tokenBegin + 32, block.cend()), IsASCIISeparator);
+        itkGenericExceptionMacro("Failed to read a component from the specified ASCII input file! Read characters: \""
+                                 << std::string(tokenBegin, tokenEnd) << '"');
       }
-      itkGenericExceptionMacro("Failed to read a floating point component from the specified ASCII input file!"
-                               << (str.empty() ? "" : (" Read characters: \"" + str + "\"")));
-    }();
+    }
+
+    if (numberOfTokens >= numberOfComponents)
+    {
+      // Leave the stream after the last component, the characters of the
+      // block being counted from the read position in case of text mode.
+      const size_t convertedEnd = *std::max_element(chunkConvertedEnd.cbegin(), chunkConvertedEnd.cend());
+      inputFile.clear();
+      inputFile.seekg(blockPosition);
+      inputFile.ignore(static_cast<std::streamsize>(convertedEnd - carriedSize));
+      return;
+    }
+    if (isLastBlock)
+    {
+      itkGenericExceptionMacro("Failed to read a component from the specified ASCII input file!"
+                               << " Expected " << numberOfComponents << " components, found " << numberOfTokens);
+    }
+
+    numberOfReadComponents = numberOfTokens;
+    carriedSize = block.size() - blockEnd;
+    std::copy(block.cbegin() + blockEnd, block.cend(), block.begin());
   }
 }
-
 } // namespace
 
 
+template <typename T>
+void
+VTKPolyDataMeshIO::ReadComponentsAsASCII(std::ifstream &     inputFile,
+                                         T * const           buffer,
+                                         const SizeValueType numberOfComponents)
+{
+  // The section ends at the data of the next section, or at the end of the file
+  const std::streampos position = inputFile.tellg();
+  inputFile.seekg(0, std::ios::end);
+  std::streampos sectionEnd = inputFile.tellg();
+  inputFile.seekg(position);
+  for (const Section & section : m_Sections)
+  {
+    if (section.dataPosition > position && section.dataPosition < sectionEnd)
+    {
+      sectionEnd = section.dataPosition;
+    }
+  }
+
+  // One more character than the section, so that reading the last section of the file ends with a short read
+  const size_t blockSize = std::min(ASCIIBlockSize, static_cast<size_t>(sectionEnd - position) + 1);
+  if (blockSize < 2 * MinimumASCIIChunkSize || m_NumberOfWorkUnits == 1)
+  {
+    ReadASCIIComponents(inputFile, buffer, numberOfComponents, blockSize, nullptr);
+    return;
+  }
+
+  const auto multiThreader = MultiThreaderBase::New();
+  if (m_NumberOfWorkUnits > 0)
+  {
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+  }
+  ReadASCIIComponents(inputFile, buffer, numberOfComponents, blockSize, multiThreader);
+}
+
+bool
+VTKPolyDataMeshIO::SeekSection(std::ifstream & inputFile, const char * keyword) const
+{
+  for (const Section & section : m_Sections)
+  {
+    if (section.header.find(keyword) != std::string::npos)
+    {
+      inputFile.clear();
+      inputFile.seekg(section.dataPosition);
+      return true;
+    }
+  }
+  return false;
+}
+
 // Constructor
 VTKPolyDataMeshIO::VTKPolyDataMeshIO()
 {
@@ -349,6 +614,20 @@ VTKPolyDataMeshIO::ReadMeshInformation()
   this->m_CellBufferSize = SizeValueType{};
   MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
 
+  // The binary data of the sections are skipped, the sizes of the offsets
+  // and connectivity arrays of version 5 files being given by the
+  // preceding cell section.
+  m_Sections.clear();
+  const bool    skipData = (this->m_FileType == IOFileEnum::BINARY);
+  SizeValueType numberOfSectionOffsets = 0;
+  SizeValueType numberOfSectionConnectivity = 0;
+  const auto    skipComponents = [&inputFile, skipData, this](SizeValueType numberOfComponents, IOComponentEnum type) {
+    if (skipData && type != IOComponentEnum::UNKNOWNCOMPONENTTYPE)
+    {
+      inputFile.seekg(static_cast<std::streamoff>(numberOfComponents * this->GetComponentSize(type)), std::ios::cur);
+    }
+  };
+
   // Searching the vtk file
   while (!inputFile.eof())
   {
@@ -356,6 +635,14 @@ VTKPolyDataMeshIO::ReadMeshInformation()
     std::getline(inputFile, line, '\n');
     StringType item;
 
+    // Lines of ASCII numbers are not searched for keywords
+    const size_t firstChar = line.find_first_not_of(" \t\r");
+    if (firstChar == std::string::npos || std::isdigit(static_cast<unsigned char>(line[firstChar])) ||
+        line[firstChar] == '-' || line[firstChar] == '+' || line[firstChar] == '.')
+    {
+      continue;
+    }
+
     //  If there are points
     if (line.find("POINTS") != std::string::npos)
     {
@@ -379,6 +666,8 @@ VTKPolyDataMeshIO::ReadMeshInformation()
       }
 
       this->m_UpdatePoints = true;
+      m_Sections.push_back({ line, inputFile.tellg() });
+      skipComponents(this->m_NumberOfPoints * this->m_PointDimension, this->m_PointComponentType);
     }
     else if (line.find("VERTICES") != std::string::npos)
     {
@@ -416,7 +705,10 @@ VTKPolyDataMeshIO::ReadMeshInformation()
                           << "numberOfVertices= " << numberOfVertices);
       }
 
-      if (numberOfVertexIndices < numberOfVertices)
+      // The version 5 files count one offset more than the number of vertices
+      const unsigned int minimumNumberOfVertexIndices =
+        this->m_ReadMeshVersionMajor >= 5 ? numberOfVertices - 1 : numberOfVertices;
+      if (numberOfVertexIndices < minimumNumberOfVertexIndices)
       {
         itkExceptionMacro("ERROR: numberOfVertexIndices < numberOfVertices\n"
                           << "numberOfVertexIndices= " << numberOfVertexIndices << '\n'
@@ -426,6 +718,16 @@ VTKPolyDataMeshIO::ReadMeshInformation()
       // Set cell component type
       this->m_CellComponentType = IOComponentEnum::UINT;
       this->m_UpdateCells = true;
+      m_Sections.push_back({ line, inputFile.tellg() });
+      if (this->m_ReadMeshVersionMajor >= 5)
+      {
+        numberOfSectionOffsets = numberOfVertices;
+        numberOfSectionConnectivity = numberOfVertexIndices;
+      }
+      else
+      {
+        skipComponents(numberOfVertexIndices, IOComponentEnum::UINT);
+      }
     }
     else if (line.find("LINES") != std::string::npos)
     {
@@ -473,6 +775,16 @@ VTKPolyDataMeshIO::ReadMeshInformation()
       // Set cell component type
       this->m_CellComponentType = IOComponentEnum::UINT;
       this->m_UpdateCells = true;
+      m_Sections.push_back({ line, inputFile.tellg() });
+      if (this->m_ReadMeshVersionMajor >= 5)
+      {
+        numberOfSectionOffsets = numberOfLines;
+        numberOfSectionConnectivity = numberOfLineIndices;
+      }
+      else
+      {
+        skipComponents(numberOfLineIndices, IOComponentEnum::UINT);
+      }
     }
     else if (line.find("POLYGONS") != std::string::npos)
     {
@@ -520,6 +832,16 @@ VTKPolyDataMeshIO::ReadMeshInformation()
       // Set cell component type
       this->m_CellComponentType = IOComponentEnum::UINT;
       this->m_UpdateCells = true;
+      m_Sections.push_back({ line, inputFile.tellg() });
+      if (this->m_ReadMeshVersionMajor >= 5)
+      {
+        numberOfSectionOffsets = numberOfPolygons;
+        numberOfSectionConnectivity = numberOfPolygonIndices;
+      }
+      else
+      {
+        skipComponents(numberOfPolygonIndices, IOComponentEnum::UINT);
+      }
     }
     else if (line.find("POINT_DATA") != std::string::npos)
     {
@@ -532,6 +854,7 @@ VTKPolyDataMeshIO::ReadMeshInformation()
 
       // Get number of Point pixels
       pdss >> this->m_NumberOfPointPixels;
+      m_Sections.push_back({ line, inputFile.tellg() });
 
       // Continue to read line and get data type
       if (!inputFile.eof())
@@ -667,6 +990,7 @@ VTKPolyDataMeshIO::ReadMeshInformation()
 
       // Get number of Point pixels
       cdss >> this->m_NumberOfCellPixels;
+      m_Sections.push_back({ line, inputFile.tellg() });
 
       // Continue to read line and get data type
       if (!inputFile.eof())
@@ -801,6 +1125,7 @@ VTKPolyDataMeshIO::ReadMeshInformation()
       ss >> offsetsType;
 
       EncapsulateMetaData<std::string>(metaDic, "offsetsType", offsetsType);
+      skipComponents(numberOfSectionOffsets, this->GetComponentTypeFromString(offsetsType));
     }
     else if (line.find("CONNECTIVITY") != std::string::npos)
     {
@@ -814,6 +1139,7 @@ VTKPolyDataMeshIO::ReadMeshInformation()
       ss >> connectivityType;
 
       EncapsulateMetaData<std::string>(metaDic, "connectivityType", connectivityType);
+      skipComponents(numberOfSectionConnectivity, this->GetComponentTypeFromString(connectivityType));
     }
   }
 
@@ -997,9 +1323,11 @@ VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buff
 
   if (this->m_ReadMeshVersionMajor >= 5)
   {
-    while (!inputFile.eof())
+    for (const Section & section : m_Sections)
     {
-      std::getline(inputFile, line, '\n');
+      line = section.header;
+      inputFile.clear();
+      inputFile.seekg(section.dataPosition);
       if (line.find("VERTICES") != std::string::npos)
       {
         unsigned int numberOfVertexOffsets = 0;
@@ -1015,12 +1343,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buff
         {
           itkExceptionMacro("Expected OFFSETS keyword in the VTK file");
         }
-        GeometryIntegerType offset = 0;
-        for (unsigned int ii = 0; ii < numberOfVertexOffsets; ++ii)
-        {
-          inputFile >> offset;
-          offsets[ii] = offset;
-        }
+        this->ReadComponentsAsASCII(inputFile, offsets.data(), numberOfVertexOffsets);
 
         std::getline(inputFile, line, '\n');
         if (line.find("CONNECTIVITY") == std::string::npos)
@@ -1031,12 +1354,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buff
         {
           itkExceptionMacro("Expected CONNECTIVITY keyword in the VTK file");
         }
-        GeometryIntegerType connectivityValue = 0;
-        for (unsigned int ii = 0; ii < numberOfVertexConnectivity; ++ii)
-        {
-          inputFile >> connectivityValue;
-          connectivity[ii] = connectivityValue;
-        }
+        this->ReadComponentsAsASCII(inputFile, connectivity.data(), numberOfVertexConnectivity);
 
         numPoints = 1;
         for (unsigned int ii = 0; ii < numberOfVertexOffsets - 1; ++ii)
@@ -1061,12 +1379,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buff
         {
           itkExceptionMacro("Expected OFFSETS keyword in the VTK file");
         }
-        GeometryIntegerType offset = 0;
-        for (unsigned int ii = 0; ii < numberOfLinesOffsets; ++ii)
-        {
-          inputFile >> offset;
-          offsets[ii] = offset;
-        }
+        this->ReadComponentsAsASCII(inputFile, offsets.data(), numberOfLinesOffsets);
 
         std::getline(inputFile, line, '\n');
         if (line.find("CONNECTIVITY") == std::string::npos)
@@ -1077,14 +1390,9 @@ VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buff
         {
           itkExceptionMacro("Expected CONNECTIVITY keyword in the VTK file");
         }
-        GeometryIntegerType connectivityValue = 0;
-        for (unsigned int ii = 0; ii < numberOfLinesConnectivity; ++ii)
-        {
-          inputFile >> connectivityValue;
-          connectivity[ii] = connectivityValue;
-        }
+        this->ReadComponentsAsASCII(inputFile, connectivity.data(), numberOfLinesConnectivity);
 
-        for (unsigned int ii = 0; ii < numberOfLinesConnectivity - 1; ++ii)
+        for (unsigned int ii = 0; ii < numberOfLinesOffsets - 1; ++ii)
         {
           numPoints = offsets[ii + 1] - offsets[ii];
           if (numPoints == 2)
@@ -1118,12 +1426,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buff
         {
           itkExceptionMacro("Expected OFFSETS keyword in the VTK file");
         }
-        GeometryIntegerType offset = 0;
-        for (unsigned int ii = 0; ii < numberOfPolygonsOffsets; ++ii)
-        {
-          inputFile >> offset;
-          offsets[ii] = offset;
-        }
+        this->ReadComponentsAsASCII(inputFile, offsets.data(), numberOfPolygonsOffsets);
 
         std::getline(inputFile, line, '\n');
         if (line.find("CONNECTIVITY") == std::string::npos)
@@ -1134,12 +1437,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buff
         {
           itkExceptionMacro("Expected CONNECTIVITY keyword in the VTK file");
         }
-        GeometryIntegerType connectivityValue = 0;
-        for (unsigned int ii = 0; ii < numberOfPolygonsConnectivity; ++ii)
-        {
-          inputFile >> connectivityValue;
-          connectivity[ii] = connectivityValue;
-        }
+        this->ReadComponentsAsASCII(inputFile, connectivity.data(), numberOfPolygonsConnectivity);
 
         for (unsigned int ii = 0; ii < numberOfPolygonsOffsets - 1; ++ii)
         {
@@ -1156,66 +1454,42 @@ VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buff
   }
   else
   {
-    while (!inputFile.eof())
+    for (const Section & section : m_Sections)
     {
-      std::getline(inputFile, line, '\n');
-      if (line.find("VERTICES") != std::string::npos)
+      CellGeometryEnum cellType = CellGeometryEnum::VERTEX_CELL;
+      unsigned int     numberOfSectionCells = 0;
+      unsigned int     numberOfSectionIndices = 0;
+      if (section.header.find("VERTICES") != std::string::npos)
       {
-        unsigned int numberOfVertices = 0;
-        ExposeMetaData<unsigned int>(metaDic, "numberOfVertices", numberOfVertices);
-
-        for (unsigned int ii = 0; ii < numberOfVertices; ++ii)
-        {
-          inputFile >> numPoints;
-          data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::VERTEX_CELL);
-          data[index++] = numPoints;
-          for (unsigned int jj = 0; jj < numPoints; ++jj)
-          {
-            inputFile >> data[index++];
-          }
-        }
+        cellType = CellGeometryEnum::VERTEX_CELL;
+        ExposeMetaData<unsigned int>(metaDic, "numberOfVertices", numberOfSectionCells);
+        ExposeMetaData<unsigned int>(metaDic, "numberOfVertexIndices", numberOfSectionIndices);
       }
-      else if (line.find("LINES") != std::string::npos)
+      else if (section.header.find("LINES") != std::string::npos)
       {
-        unsigned int numberOfLines = 0;
-        ExposeMetaData<unsigned int>(metaDic, "numberOfLines", numberOfLines);
-
-        for (unsigned int ii = 0; ii < numberOfLines; ++ii)
-        {
-          inputFile >> numPoints;
-          if (numPoints == 2)
-          {
-            data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::LINE_CELL);
-          }
-          else
-          {
-            // Use POLYLINE_CELL when more than 2 points are present
-            data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::POLYLINE_CELL);
-          }
-          data[index++] = numPoints;
-          for (unsigned int jj = 0; jj < numPoints; ++jj)
-          {
-            inputFile >> data[index++];
-          }
-        }
+        // Lines of more than 2 points are set to POLYLINE_CELL
+        cellType = CellGeometryEnum::LINE_CELL;
+        ExposeMetaData<unsigned int>(metaDic, "numberOfLines", numberOfSectionCells);
+        ExposeMetaData<unsigned int>(metaDic, "numberOfLineIndices", numberOfSectionIndices);
       }
-      else if (line.find("POLYGONS") != std::string::npos)
+      else if (section.header.find("POLYGONS") != std::string::npos)
       {
-        unsigned int numberOfPolygons = 0;
-        ExposeMetaData<unsigned int>(metaDic, "numberOfPolygons", numberOfPolygons);
-
-        for (unsigned int ii = 0; ii < numberOfPolygons; ++ii)
-        {
-          inputFile >> numPoints;
-
-          data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::POLYGON_CELL);
-          data[index++] = numPoints;
-          for (unsigned int jj = 0; jj < numPoints; ++jj)
-          {
-            inputFile >> data[index++];
-          }
-        }
+        cellType = CellGeometryEnum::POLYGON_CELL;
+        ExposeMetaData<unsigned int>(metaDic, "numberOfPolygons", numberOfSectionCells);
+        ExposeMetaData<unsigned int>(metaDic, "numberOfPolygonIndices", numberOfSectionIndices);
       }
+      else
+      {
+        continue;
+      }
+
+      // The number of points of each cell followed by its point indices
+      std::vector<GeometryIntegerType> sectionData(numberOfSectionIndices);
+      inputFile.clear();
+      inputFile.seekg(section.dataPosition);
+      this->ReadComponentsAsASCII(inputFile, sectionData.data(), numberOfSectionIndices);
+      this->WriteCellsBuffer(sectionData.data(), data + index, cellType, numberOfSectionCells);
+      index += numberOfSectionIndices + numberOfSectionCells;
     }
   }
 }
@@ -1233,9 +1507,11 @@ VTKPolyDataMeshIO::ReadCellsBufferAsBINARYConnectivityType(std::ifstream & input
   unsigned int         numPoints; // number of point in each cell
 
   auto * outputBuffer = static_cast<unsigned int *>(buffer);
-  while (!inputFile.eof())
+  for (const Section & section : m_Sections)
   {
-    std::getline(inputFile, line, '\n');
+    line = section.header;
+    inputFile.clear();
+    inputFile.seekg(section.dataPosition);
     if (line.find("VERTICES") != std::string::npos)
     {
       GeometryIntegerType numberOfVertexOffsets = 0;
@@ -1265,7 +1541,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsBINARYConnectivityType(std::ifstream & input
         itkExceptionMacro("Expected CONNECTIVITY keyword in the VTK file");
       }
       const auto inputConnectivityBuffer = make_unique_for_overwrite<ConnectivityType[]>(numberOfVertexConnectivity);
-      void *     pvConnectivity = inputOffsetsBuffer.get();
+      void *     pvConnectivity = inputConnectivityBuffer.get();
       auto *     startBufferConnectivity = static_cast<char *>(pvConnectivity);
       inputFile.read(startBufferConnectivity, numberOfVertexConnectivity * sizeof(ConnectivityType));
       auto * dataConnectivity = static_cast<ConnectivityType *>(pvConnectivity);
@@ -1315,7 +1591,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsBINARYConnectivityType(std::ifstream & input
         itkExceptionMacro("Expected CONNECTIVITY keyword in the VTK file");
       }
       const auto inputConnectivityBuffer = make_unique_for_overwrite<ConnectivityType[]>(numberOfLinesConnectivity);
-      void *     pvConnectivity = inputOffsetsBuffer.get();
+      void *     pvConnectivity = inputConnectivityBuffer.get();
       auto *     startBufferConnectivity = static_cast<char *>(pvConnectivity);
       inputFile.read(startBufferConnectivity, numberOfLinesConnectivity * sizeof(ConnectivityType));
       auto * dataConnectivity = static_cast<ConnectivityType *>(pvConnectivity);
@@ -1325,7 +1601,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsBINARYConnectivityType(std::ifstream & input
       }
 
       numPoints = 2;
-      for (unsigned int ii = 0; ii < numberOfLinesConnectivity - 1; ++ii)
+      for (unsigned int ii = 0; ii < numberOfLinesOffsets - 1; ++ii)
       {
         numPoints = dataOffsets[ii + 1] - dataOffsets[ii];
         if (numPoints == 2)
@@ -1475,9 +1751,11 @@ VTKPolyDataMeshIO::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * buf
     void *      pv = inputBuffer.get();
     auto *      startBuffer = static_cast<char *>(pv);
     auto *      outputBuffer = static_cast<unsigned int *>(buffer);
-    while (!inputFile.eof())
+    for (const Section & section : m_Sections)
     {
-      std::getline(inputFile, line, '\n');
+      line = section.header;
+      inputFile.clear();
+      inputFile.seekg(section.dataPosition);
       if (line.find("VERTICES") != std::string::npos)
       {
         GeometryIntegerType numberOfVertices = 0;
@@ -1494,7 +1772,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * buf
         }
         this->WriteCellsBuffer(data, outputBuffer, CellGeometryEnum::VERTEX_CELL, numberOfVertices);
         startBuffer += numberOfVertexIndices * sizeof(GeometryIntegerType);
-        outputBuffer += (numberOfVertexIndices + numberOfVertices) * sizeof(GeometryIntegerType);
+        outputBuffer += numberOfVertexIndices + numberOfVertices;
       }
       else if (line.find("LINES") != std::string::npos)
       {
@@ -1512,7 +1790,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * buf
         }
         this->WriteCellsBuffer(data, outputBuffer, CellGeometryEnum::LINE_CELL, numberOfLines);
         startBuffer += numberOfLineIndices * sizeof(GeometryIntegerType);
-        outputBuffer += (numberOfLineIndices + numberOfLines) * sizeof(GeometryIntegerType);
+        outputBuffer += numberOfLineIndices + numberOfLines;
       }
       else if (line.find("POLYGONS") != std::string::npos)
       {
@@ -1531,7 +1809,7 @@ VTKPolyDataMeshIO::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * buf
 
         this->WriteCellsBuffer(data, outputBuffer, CellGeometryEnum::POLYGON_CELL, numberOfPolygons);
         startBuffer += numberOfPolygonIndices * sizeof(GeometryIntegerType);
-        outputBuffer += (numberOfPolygonIndices + numberOfPolygons) * sizeof(GeometryIntegerType);
+        outputBuffer += numberOfPolygonIndices + numberOfPolygons;
       }
     }
   }
@@ -2066,6 +2344,8 @@ VTKPolyDataMeshIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
 
+  os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
+
   const MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
   unsigned int               value = 0;
 
@@ -2116,20 +2396,4 @@ VTKPolyDataMeshIO::PrintSelf(std::ostream & os, Indent indent) const
   }
 }
 
-void
-VTKPolyDataMeshIO::ReadComponentsAsASCII(std::ifstream &     inputFile,
-                                         float * const       buffer,
-                                         const SizeValueType numberOfComponents)
-{
-  ReadFloatingPointsAsASCII(inputFile, buffer, numberOfComponents);
-}
-
-void
-VTKPolyDataMeshIO::ReadComponentsAsASCII(std::ifstream &     inputFile,
-                                         double * const      buffer,
-                                         const SizeValueType numberOfComponents)
-{
-  ReadFloatingPointsAsASCII(inputFile, buffer, numberOfComponents);
-}
-
 } // end of namespace itk
@@ -19,14 +19,22 @@
 // First include the header file to be tested:
 #include "itkMeshFileReader.h"
 
+#include "itkByteSwapper.h"
 #include "itkDeref.h"
+#include "itkLineCell.h"
 #include "itkMesh.h"
 #include "itkMeshFileWriter.h"
+#include "itkQuadEdgeMesh.h"
+#include "itkTriangleCell.h"
+#include "itkVertexCell.h"
 #include "itkVTKPolyDataMeshIO.h"
 
 #include <cmath> // For isnan
+#include <fstream>
+#include <initializer_list>
 #include <limits>
 #include <random>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -106,6 +114,79 @@ Expect_lossless_writing_and_reading_of_points(const std::string &
   }
 }
 
+
+using CellsType = std::vector<std::vector<itk::IdentifierType>>;
+
+// Makes a mesh of vertex, line and triangle cells, of one, two and three point ids.
+itk::Mesh<float, 3>::Pointer
+MakeMeshOfCells(const CellsType & cells)
+{
+  using MeshType = itk::Mesh<float, 3>;
+  using CellType = MeshType::CellType;
+
+  const auto mesh = MeshType::New();
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    mesh->SetPoint(i, itk::MakePoint(1.0f * (i % 2), 1.0f * (i / 2), 0.0f));
+  }
+  for (size_t i = 0; i < cells.size(); ++i)
+  {
+    MeshType::CellAutoPointer cell;
+    if (cells[i].size() == 1)
+    {
+      cell.TakeOwnership(new itk::VertexCell<CellType>);
+    }
+    else if (cells[i].size() == 2)
+    {
+      cell.TakeOwnership(new itk::LineCell<CellType>);
+    }
+    else
+    {
+      cell.TakeOwnership(new itk::TriangleCell<CellType>);
+    }
+    for (unsigned int j = 0; j < cells[i].size(); ++j)
+    {
+      cell->SetPointId(j, cells[i][j]);
+    }
+    mesh->SetCell(i, cell);
+  }
+  return mesh;
+}
+
+
+// Writes values in big endian, as the binary data of the VTK files.
+template <typename T>
+void
+WriteBigEndian(std::ofstream & file, std::initializer_list<T> values)
+{
+  for (T value : values)
+  {
+    itk::ByteSwapper<T>::SwapFromSystemToBigEndian(&value);
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+}
+
+
+// Reads a mesh file, and expects the point ids of its cells.
+void
+Expect_cells_of_file(const std::string & fileName, const CellsType & expectedCells)
+{
+  using MeshType = itk::Mesh<float, 3>;
+  const auto reader = itk::MeshFileReader<MeshType>::New();
+  reader->SetFileName(fileName);
+  reader->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  reader->Update();
+  const MeshType & mesh = itk::Deref(reader->GetOutput());
+
+  ASSERT_EQ(mesh.GetNumberOfCells(), expectedCells.size());
+  for (size_t i = 0; i < expectedCells.size(); ++i)
+  {
+    MeshType::CellAutoPointer cell;
+    ASSERT_TRUE(mesh.GetCell(i, cell));
+    EXPECT_EQ(CellsType::value_type(cell->PointIdsBegin(), cell->PointIdsEnd()), expectedCells[i]);
+  }
+}
+
 } // namespace
 
 
@@ -184,3 +265,339 @@ TEST(VTKPolyDataMeshIO, SupportsPointDimensionsGreaterThanOne)
       "VTKPolyDataMeshIOGTest_Supports4D.vtk", { MakePointOfIncreasingCoordValues<4>() }, writeAsBinary);
   }
 }
+
+
+// Tests that the points, the cells of several sections, and the point and cell data are read back, whatever the file
+// type and the number of work units converting the ASCII numbers.
+TEST(VTKPolyDataMeshIO, ReadsSectionsOfASCIIAndBinaryFiles)
+{
+  using MeshType = itk::Mesh<float, 3>;
+  using CellType = MeshType::CellType;
+  using CellAutoPointer = MeshType::CellAutoPointer;
+  using LineType = itk::LineCell<CellType>;
+  using TriangleType = itk::TriangleCell<CellType>;
+
+  // Enough points for the ASCII points section to be split between several work units
+  const auto inputMesh = MeshType::New();
+  for (unsigned int i = 0; i < 20000; ++i)
+  {
+    inputMesh->SetPoint(i, itk::MakePoint(0.5f * i, -0.25f * (i % 7), 1.0f / (i + 1)));
+    inputMesh->SetPointData(i, 0.125f * i - 3.0f);
+  }
+  // The cells are ordered as the sections of the file: the lines, then the polygons
+  for (unsigned int i = 0; i < 300; ++i)
+  {
+    CellAutoPointer cell;
+    if (i < 100)
+    {
+      cell.TakeOwnership(new LineType);
+      cell->SetPointId(0, 3 * i);
+      cell->SetPointId(1, 3 * i + 2);
+    }
+    else
+    {
+      cell.TakeOwnership(new TriangleType);
+      cell->SetPointId(0, i);
+      cell->SetPointId(1, i + 1);
+      cell->SetPointId(2, i + 2);
+    }
+    inputMesh->SetCell(i, cell);
+    inputMesh->SetCellData(i, static_cast<float>(i % 11));
+  }
+
+  for (const bool writeAsBinary : { false, true })
+  {
+    const std::string fileName = "VTKPolyDataMeshIOGTest_ReadsSections.vtk";
+    const auto        writer = itk::MeshFileWriter<MeshType>::New();
+    if (writeAsBinary)
+    {
+      writer->SetFileTypeAsBINARY();
+    }
+    writer->SetFileName(fileName);
+    writer->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+    writer->SetInput(inputMesh);
+    writer->Update();
+
+    for (const unsigned int numberOfWorkUnits : { 1, 3 })
+    {
+      const auto meshIO = itk::VTKPolyDataMeshIO::New();
+      meshIO->SetNumberOfWorkUnits(numberOfWorkUnits);
+      EXPECT_EQ(meshIO->GetNumberOfWorkUnits(), numberOfWorkUnits);
+
+      const auto reader = itk::MeshFileReader<MeshType>::New();
+      reader->SetFileName(fileName);
+      reader->SetMeshIO(meshIO);
+      reader->Update();
+      const MeshType & outputMesh = itk::Deref(reader->GetOutput());
+
+      ASSERT_EQ(outputMesh.GetNumberOfPoints(), inputMesh->GetNumberOfPoints());
+      ASSERT_EQ(outputMesh.GetNumberOfCells(), inputMesh->GetNumberOfCells());
+      for (unsigned int i = 0; i < inputMesh->GetNumberOfPoints(); ++i)
+      {
+        EXPECT_EQ(outputMesh.GetPoint(i), inputMesh->GetPoint(i));
+        float outputValue = 0;
+        float inputValue = 1;
+        outputMesh.GetPointData(i, &outputValue);
+        inputMesh->GetPointData(i, &inputValue);
+        EXPECT_EQ(outputValue, inputValue);
+      }
+
+      for (unsigned int i = 0; i < inputMesh->GetNumberOfCells(); ++i)
+      {
+        MeshType::CellAutoPointer inputCell;
+        MeshType::CellAutoPointer outputCell;
+        inputMesh->GetCell(i, inputCell);
+        ASSERT_TRUE(outputMesh.GetCell(i, outputCell));
+        EXPECT_EQ(std::vector<MeshType::PointIdentifier>(outputCell->PointIdsBegin(), outputCell->PointIdsEnd()),
+                  std::vector<MeshType::PointIdentifier>(inputCell->PointIdsBegin(), inputCell->PointIdsEnd()));
+        float outputValue = 0;
+        float inputValue = 1;
+        outputMesh.GetCellData(i, &outputValue);
+        inputMesh->GetCellData(i, &inputValue);
+        EXPECT_EQ(outputValue, inputValue);
+      }
+    }
+  }
+}
+
+
+// Tests reading the offsets and connectivity arrays of the cells of a version 5 ASCII file.
+TEST(VTKPolyDataMeshIO, ReadsVersion5ASCIICells)
+{
+  const std::string fileName = "VTKPolyDataMeshIOGTest_ReadsVersion5ASCIICells.vtk";
+  {
+    std::ofstream file(fileName);
+    file << "# vtk DataFile Version 5.1\n"
+            "lines and polygons\n"
+            "ASCII\n"
+            "DATASET POLYDATA\n"
+            "POINTS 6 float\n"
+            "0 0 0 1 0 0 2 0 0\n"
+            "0 1 0 1 1 0 2 1 0\n"
+            "LINES 3 5\n"
+            "OFFSETS vtktypeint64\n"
+            "0 2 5\n"
+            "CONNECTIVITY vtktypeint64\n"
+            "0 1 3 4\n"
+            "5\n"
+            "POLYGONS 3 7\n"
+            "OFFSETS vtktypeint64\n"
+            "0 3 7\n"
+            "CONNECTIVITY vtktypeint64\n"
+            "0 1 4 1 2 5 4\n";
+  }
+
+  using MeshType = itk::Mesh<float, 3>;
+  const auto reader = itk::MeshFileReader<MeshType>::New();
+  reader->SetFileName(fileName);
+  reader->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  reader->Update();
+  const MeshType & mesh = itk::Deref(reader->GetOutput());
+
+  EXPECT_EQ(mesh.GetNumberOfPoints(), 6u);
+  EXPECT_EQ(mesh.GetPoint(5), itk::MakePoint(2.0f, 1.0f, 0.0f));
+
+  const std::vector<std::vector<MeshType::PointIdentifier>> expectedCells = {
+    { 0, 1 }, { 3, 4, 5 }, { 0, 1, 4 }, { 1, 2, 5, 4 }
+  };
+  ASSERT_EQ(mesh.GetNumberOfCells(), expectedCells.size());
+  for (size_t i = 0; i < expectedCells.size(); ++i)
+  {
+    MeshType::CellAutoPointer cell;
+    ASSERT_TRUE(mesh.GetCell(i, cell));
+    EXPECT_EQ(std::vector<MeshType::PointIdentifier>(cell->PointIdsBegin(), cell->PointIdsEnd()), expectedCells[i]);
+  }
+}
+
+
+// Tests that the reader fills the contiguous cell arrays of a Mesh, and still builds the edges and faces of a
+// QuadEdgeMesh.
+TEST(VTKPolyDataMeshIO, ReadsCellsIntoContiguousStorage)
+{
+  const std::string fileName = "VTKPolyDataMeshIOGTest_ReadsCellsIntoContiguousStorage.vtk";
+  {
+    std::ofstream file(fileName);
+    file << "# vtk DataFile Version 4.2\n"
+            "lines and polygons\n"
+            "ASCII\n"
+            "DATASET POLYDATA\n"
+            "POINTS 6 float\n"
+            "0 0 0 1 0 0 2 0 0\n"
+            "0 1 0 1 1 0 2 1 0\n"
+            "LINES 2 7\n"
+            "2 0 1\n"
+            "3 3 4 5\n"
+            "POLYGONS 2 9\n"
+            "3 0 1 4\n"
+            "4 1 2 5 4\n";
+  }
+
+  using MeshType = itk::Mesh<float, 3>;
+  const auto reader = itk::MeshFileReader<MeshType>::New();
+  reader->SetFileName(fileName);
+  reader->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  reader->Update();
+  const MeshType & mesh = itk::Deref(reader->GetOutput());
+
+  const std::vector<itk::CellGeometryEnum> expectedTypes = { itk::CellGeometryEnum::LINE_CELL,
+                                                              itk::CellGeometryEnum::POLYLINE_CELL,
+                                                              itk::CellGeometryEnum::TRIANGLE_CELL,
+                                                              itk::CellGeometryEnum::POLYGON_CELL };
+  const std::vector<std::vector<MeshType::PointIdentifier>> expectedCells = {
+    { 0, 1 }, { 3, 4, 5 }, { 0, 1, 4 }, { 1, 2, 5, 4 }
+  };
+  ASSERT_EQ(mesh.GetNumberOfCells(), expectedCells.size());
+  ASSERT_NE(mesh.GetCellTypes(), nullptr);
+  EXPECT_EQ(mesh.GetCellTypes()->CastToSTLConstContainer(), expectedTypes);
+  EXPECT_EQ(mesh.GetCellConnectivity()->Size(), 12u);
+  for (size_t i = 0; i < expectedCells.size(); ++i)
+  {
+    const MeshType::CellView view = mesh.GetCellView(i);
+    EXPECT_EQ(view.GetType(), expectedTypes[i]);
+    EXPECT_EQ(std::vector<MeshType::PointIdentifier>(view.PointIdsBegin(), view.PointIdsEnd()), expectedCells[i]);
+
+    MeshType::CellAutoPointer cell;
+    ASSERT_TRUE(mesh.GetCell(i, cell));
+    EXPECT_EQ(cell->GetType(), expectedTypes[i]);
+    EXPECT_EQ(std::vector<MeshType::PointIdentifier>(cell->PointIdsBegin(), cell->PointIdsEnd()), expectedCells[i]);
+  }
+
+  using QuadEdgeMeshType = itk::QuadEdgeMesh<float, 3>;
+  const auto quadEdgeReader = itk::MeshFileReader<QuadEdgeMeshType>::New();
+  quadEdgeReader->SetFileName(fileName);
+  quadEdgeReader->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  quadEdgeReader->Update();
+  const QuadEdgeMeshType & quadEdgeMesh = itk::Deref(quadEdgeReader->GetOutput());
+
+  EXPECT_EQ(quadEdgeMesh.GetNumberOfFaces(), 2u);
+  EXPECT_EQ(quadEdgeMesh.GetNumberOfEdges(), 6u);
+  EXPECT_EQ(quadEdgeMesh.GetCellTypes(), nullptr);
+}
+
+
+// Tests that the lines section holds the line cells only, without an empty line for each other cell.
+TEST(VTKPolyDataMeshIO, WritesLineCellsOnlyInLinesSection)
+{
+  const std::string fileName = "VTKPolyDataMeshIOGTest_WritesLineCellsOnlyInLinesSection.vtk";
+  const auto        writer = itk::MeshFileWriter<itk::Mesh<float, 3>>::New();
+  writer->SetFileName(fileName);
+  writer->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  writer->SetInput(MakeMeshOfCells({ { 0, 1 }, { 1, 2, 3 }, { 2, 3 } }));
+  writer->Update();
+
+  std::ostringstream content;
+  content << std::ifstream(fileName).rdbuf();
+  EXPECT_NE(content.str().find("LINES 2 6\n"), std::string::npos);
+
+  // The cells are read back in the order of the sections of the file
+  Expect_cells_of_file(fileName, { { 0, 1 }, { 2, 3 }, { 1, 2, 3 } });
+}
+
+
+// Tests reading the vertices, lines and polygons sections of a legacy binary file, one after the other.
+TEST(VTKPolyDataMeshIO, ReadsCellSectionsOfLegacyBinaryFiles)
+{
+  const std::string fileName = "VTKPolyDataMeshIOGTest_ReadsCellSectionsOfLegacyBinaryFiles.vtk";
+  {
+    std::ofstream file(fileName, std::ios::binary);
+    file << "# vtk DataFile Version 3.0\n"
+            "vertices, lines and polygons\n"
+            "BINARY\n"
+            "DATASET POLYDATA\n"
+            "POINTS 4 float\n";
+    WriteBigEndian<float>(file, { 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0 });
+    file << "\nVERTICES 2 4\n";
+    WriteBigEndian<int32_t>(file, { 1, 3, 1, 0 });
+    file << "\nLINES 1 3\n";
+    WriteBigEndian<int32_t>(file, { 2, 0, 1 });
+    file << "\nPOLYGONS 2 8\n";
+    WriteBigEndian<int32_t>(file, { 3, 1, 2, 3, 3, 0, 1, 2 });
+    file << '\n';
+  }
+
+  Expect_cells_of_file(fileName, { { 3 }, { 0 }, { 0, 1 }, { 1, 2, 3 }, { 0, 1, 2 } });
+}
+
+
+// Tests that a binary file has only the vertices in its vertices section, and only the polygons in its polygons
+// section.
+TEST(VTKPolyDataMeshIO, WritesBinaryCellsInTheirSections)
+{
+  const std::string fileName = "VTKPolyDataMeshIOGTest_WritesBinaryCellsInTheirSections.vtk";
+  const auto        writer = itk::MeshFileWriter<itk::Mesh<float, 3>>::New();
+  writer->SetFileName(fileName);
+  writer->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  writer->SetFileTypeAsBINARY();
+  writer->SetInput(MakeMeshOfCells({ { 1, 2, 3 }, { 0 }, { 0, 1 }, { 2 } }));
+  writer->Update();
+
+  Expect_cells_of_file(fileName, { { 0 }, { 2 }, { 0, 1 }, { 1, 2, 3 } });
+}
+
+
+// Tests reading the vertices, lines and polygons of a version 5 binary file.
+TEST(VTKPolyDataMeshIO, ReadsVersion5BinaryCells)
+{
+  const std::string fileName = "VTKPolyDataMeshIOGTest_ReadsVersion5BinaryCells.vtk";
+  {
+    std::ofstream file(fileName, std::ios::binary);
+    file << "# vtk DataFile Version 5.1\n"
+            "vertices, lines and polygons\n"
+            "BINARY\n"
+            "DATASET POLYDATA\n"
+            "POINTS 4 float\n";
+    WriteBigEndian<float>(file, { 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0 });
+    file << "\nVERTICES 3 2\nOFFSETS vtktypeint64\n";
+    WriteBigEndian<int64_t>(file, { 0, 1, 2 });
+    file << "\nCONNECTIVITY vtktypeint64\n";
+    WriteBigEndian<int64_t>(file, { 3, 0 });
+    file << "\nLINES 3 5\nOFFSETS vtktypeint64\n";
+    WriteBigEndian<int64_t>(file, { 0, 2, 5 });
+    file << "\nCONNECTIVITY vtktypeint64\n";
+    WriteBigEndian<int64_t>(file, { 0, 1, 1, 2, 3 });
+    file << "\nPOLYGONS 2 3\nOFFSETS vtktypeint64\n";
+    WriteBigEndian<int64_t>(file, { 0, 3 });
+    file << "\nCONNECTIVITY vtktypeint64\n";
+    WriteBigEndian<int64_t>(file, { 1, 2, 3 });
+    file << '\n';
+  }
+
+  Expect_cells_of_file(fileName, { { 3 }, { 0 }, { 0, 1 }, { 1, 2, 3 }, { 1, 2, 3 } });
+}
+
+
+// Tests that the cell data of a binary file are read from its cell data section, and not from its point data section.
+TEST(VTKPolyDataMeshIO, ReadsBinaryCellData)
+{
+  using MeshType = itk::Mesh<float, 3>;
+
+  const auto inputMesh = MakeMeshOfCells({ { 0, 1 }, { 1, 2, 3 } });
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    inputMesh->SetPointData(i, 10.0f + i);
+  }
+  inputMesh->SetCellData(0, 100.0f);
+  inputMesh->SetCellData(1, 101.0f);
+
+  const std::string fileName = "VTKPolyDataMeshIOGTest_ReadsBinaryCellData.vtk";
+  const auto        writer = itk::MeshFileWriter<MeshType>::New();
+  writer->SetFileName(fileName);
+  writer->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  writer->SetFileTypeAsBINARY();
+  writer->SetInput(inputMesh);
+  writer->Update();
+
+  const auto reader = itk::MeshFileReader<MeshType>::New();
+  reader->SetFileName(fileName);
+  reader->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  reader->Update();
+  const MeshType & outputMesh = itk::Deref(reader->GetOutput());
+
+  float value = 0.0f;
+  ASSERT_TRUE(outputMesh.GetPointData(3, &value));
+  EXPECT_EQ(value, 13.0f);
+  ASSERT_TRUE(outputMesh.GetCellData(0, &value));
+  EXPECT_EQ(value, 100.0f);
+  ASSERT_TRUE(outputMesh.GetCellData(1, &value));
+  EXPECT_EQ(value, 101.0f);
+}
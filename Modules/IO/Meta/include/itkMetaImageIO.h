@@ -187,6 +187,11 @@ protected:
   ~MetaImageIO() override;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Also copies the subsampling factor and the double precision. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   template <unsigned int VNRows, unsigned int VNColumns = VNRows>
   bool
   WriteMatrixInMetaData(std::ostringstream & strs, const MetaDataDictionary & metaDict, const std::string & metaString);
@@ -62,6 +62,21 @@ MetaImageIO::MetaImageIO()
 
 MetaImageIO::~MetaImageIO() = default;
 
+LightObject::Pointer
+MetaImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_SubSamplingFactor = m_SubSamplingFactor;
+  rval->m_MetaImage.SetDoublePrecision(m_MetaImage.GetDoublePrecision());
+  return loPtr;
+}
+
 void
 MetaImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
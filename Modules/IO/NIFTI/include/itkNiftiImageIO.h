@@ -230,6 +230,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the rescaling, the legacy Analyze mode and the conversions of the vectors and sform. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   virtual bool
   GetUseLegacyModeForTwoFileWriting() const
   {
@@ -437,6 +437,25 @@ NiftiImageIO::~NiftiImageIO()
   nifti_image_free(this->m_NiftiImage);
 }
 
+LightObject::Pointer
+NiftiImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_RescaleSlope = m_RescaleSlope;
+  rval->m_RescaleIntercept = m_RescaleIntercept;
+  rval->m_LegacyAnalyze75Mode = m_LegacyAnalyze75Mode;
+  rval->m_ConvertRASVectors = m_ConvertRASVectors;
+  rval->m_ConvertRASDisplacementVectors = m_ConvertRASDisplacementVectors;
+  rval->m_SFORM_Permissive = m_SFORM_Permissive;
+  return loPtr;
+}
+
 void
 NiftiImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
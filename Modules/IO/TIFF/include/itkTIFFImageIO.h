@@ -21,6 +21,7 @@
 
 #include "itkImageIOBase.h"
 #include <fstream>
+#include <memory>
 
 namespace itk
 {
@@ -38,6 +39,12 @@ class TIFFReaderInternal;
  * supports the compression level for JPEG quality parameter in the
  * range 0-100.
  *
+ * The files which libtiff can decode natively are read by strips or
+ * tiles: only the strips or tiles, and the pages of a multi-page file,
+ * intersecting the region to read are decoded, so the reading can be
+ * streamed. The strips or tiles are decoded concurrently, and can be
+ * kept in a cache between the reads of overlapping regions.
+ *
  * \ingroup IOFilters
  * \ingroup ITKIOTIFF
  *
@@ -83,6 +90,36 @@ public:
   virtual void
   ReadVolume(void * buffer);
 
+  /** Determine if the ImageIO can stream reading from this file: the
+   * strips of a region are read when libtiff can decode the file
+   * natively, and the tiles of a region when the tiled file, read as
+   * RGBA, has its first row at the top. This is valid after
+   * ReadImageInformation has been called. */
+  bool
+  CanStreamRead() override
+  {
+    return m_CanStreamRead;
+  }
+
+  /** Returns the requested region when streaming is enabled and
+   * possible, the whole image otherwise. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
+  /** Set/Get the number of work units decoding the strips or tiles of
+   * a region concurrently, each one on its own thread and through its
+   * own handle on the file. Zero, the default, uses the global default
+   * number of threads. */
+  itkSetMacro(NumberOfWorkUnits, unsigned int);
+  itkGetConstMacro(NumberOfWorkUnits, unsigned int);
+
+  /** Set/Get the capacity, in bytes, of the cache of decoded strips and
+   * tiles. The cache is kept between the reads of a file, so that the
+   * strips or tiles shared by successive regions are decoded only once.
+   * Zero, the default, disables the cache. */
+  itkSetMacro(TileCacheSize, SizeValueType);
+  itkGetConstMacro(TileCacheSize, SizeValueType);
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -196,6 +233,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the number of work units, the tile cache size and the palette. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalSetCompressor(const std::string & _compressor) override;
 
@@ -249,12 +290,23 @@ protected:
   PaletteType m_ColorPalette{};
 
 private:
+  struct TileCache;
+
   void
   AllocateTiffPalette(uint16_t bps);
 
   void
   ReadCurrentPage(void * buffer, size_t pixelOffset);
 
+  // Read the region of the pages by strips or tiles, natively decoded, or
+  // decoded as RGBA for the tiled files
+  void
+  ReadRegion(void * buffer, const ImageIORegion & region);
+
+  template <typename TComponent>
+  void
+  PutRow(TComponent * to, const void * from, unsigned int width);
+
   template <typename TComponent>
   void
   ReadGenericImage(void * _out, unsigned int width, unsigned int height);
@@ -265,8 +317,8 @@ private:
 
   template <typename TType>
   void
-  PutGrayscale(TType *      to,
-               TType *      from,
+  PutGrayscale(TType *       to,
+               const TType * from,
                unsigned int xsize,
                unsigned int ysize,
                unsigned int toskew,
@@ -274,41 +326,52 @@ private:
 
   template <typename TType>
   void
-  PutRGB_(TType * to, TType * from, unsigned int xsize, unsigned int ysize, unsigned int toskew, unsigned int fromskew);
+  PutRGB_(TType *       to,
+          const TType * from,
+          unsigned int  xsize,
+          unsigned int  ysize,
+          unsigned int  toskew,
+          unsigned int  fromskew);
 
 
   template <typename TType, typename TFromType>
   void
-  PutPaletteGrayscale(TType *      to,
-                      TFromType *  from,
-                      unsigned int xsize,
-                      unsigned int ysize,
-                      unsigned int toskew,
-                      unsigned int fromskew);
+  PutPaletteGrayscale(TType *           to,
+                      const TFromType * from,
+                      unsigned int      xsize,
+                      unsigned int      ysize,
+                      unsigned int      toskew,
+                      unsigned int      fromskew);
 
   template <typename TType, typename TFromType>
   void
-  PutPaletteRGB(TType *      to,
-                TFromType *  from,
-                unsigned int xsize,
-                unsigned int ysize,
-                unsigned int toskew,
-                unsigned int fromskew);
+  PutPaletteRGB(TType *           to,
+                const TFromType * from,
+                unsigned int      xsize,
+                unsigned int      ysize,
+                unsigned int      toskew,
+                unsigned int      fromskew);
 
   template <typename TType, typename TFromType>
   void
-  PutPaletteScalar(TType *      to,
-                   TFromType *  from,
-                   unsigned int xsize,
-                   unsigned int ysize,
-                   unsigned int toskew,
-                   unsigned int fromskew);
+  PutPaletteScalar(TType *           to,
+                   const TFromType * from,
+                   unsigned int      xsize,
+                   unsigned int      ysize,
+                   unsigned int      toskew,
+                   unsigned int      fromskew);
 
   uint16_t *   m_ColorRed{};
   uint16_t *   m_ColorGreen{};
   uint16_t *   m_ColorBlue{};
   uint64_t     m_TotalColors{ 0 };
   unsigned int m_ImageFormat{ TIFFImageIO::NOFORMAT };
+
+  bool                       m_CanStreamRead{ false };
+  bool                       m_ReadRGBATiles{ false };
+  unsigned int               m_NumberOfWorkUnits{ 0 };
+  SizeValueType              m_TileCacheSize{ 0 };
+  std::unique_ptr<TileCache> m_TileCache;
 };
 } // end namespace itk
 
@@ -10,6 +10,7 @@ itk_module(
   ITKTIFF
   TEST_DEPENDS
   ITKTestKernel
+  ITKTIFF
   FACTORY_NAMES
   ImageIO::TIFF
   DESCRIPTION
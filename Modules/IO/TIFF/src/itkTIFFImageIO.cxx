@@ -21,12 +21,183 @@
 #include "itksys/SystemTools.hxx"
 #include "itkMetaDataObject.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itk_tiff.h"
 
+#include <functional>
+#include <list>
+#include <map>
+#include <system_error>
+#include <thread>
+
 namespace itk
 {
 
+namespace
+{
+// A strip or a tile of a page, intersecting the region to read
+struct TIFFBlock
+{
+  unsigned int slice;
+  unsigned int directory;
+  bool         tiled;
+  uint32_t     index;
+  uint32_t     column;
+  uint32_t     row;
+  uint32_t     width;
+  uint32_t     height;
+  size_t       size;
+};
+
+// Bound on the decoded strips or tiles held at once by a read, per work unit
+constexpr size_t MaximumDecodedBytesPerWorkUnit = size_t{ 4 } << 20;
+
+bool
+DecodeBlock(TIFF * tiff, const TIFFBlock & block, unsigned char * data)
+{
+  if (TIFFCurrentDirectory(tiff) != static_cast<tdir_t>(block.directory) &&
+      !TIFFSetDirectory(tiff, static_cast<tdir_t>(block.directory)))
+  {
+    return false;
+  }
+  const auto size = static_cast<tmsize_t>(block.size);
+  return (block.tiled ? TIFFReadEncodedTile(tiff, block.index, data, size)
+                      : TIFFReadEncodedStrip(tiff, block.index, data, size)) >= 0;
+}
+
+// Decode a strip or a tile of a top down page through the RGBA interface
+// of libtiff, into packed ABGR pixels. The raster of libtiff is bottom up,
+// the rows of the block being at its bottom: they are put back top down.
+bool
+DecodeRGBABlock(TIFF * tiff, const TIFFBlock & block, unsigned char * data)
+{
+  if (TIFFCurrentDirectory(tiff) != static_cast<tdir_t>(block.directory) &&
+      !TIFFSetDirectory(tiff, static_cast<tdir_t>(block.directory)))
+  {
+    return false;
+  }
+  auto * const raster = reinterpret_cast<uint32_t *>(data);
+  if (!(block.tiled ? TIFFReadRGBATile(tiff, block.column, block.row, raster)
+                    : TIFFReadRGBAStrip(tiff, block.row, raster)))
+  {
+    return false;
+  }
+  for (uint32_t top = 0, bottom = block.height - 1; top < bottom; ++top, --bottom)
+  {
+    std::swap_ranges(raster + size_t{ top } * block.width,
+                     raster + size_t{ top + 1 } * block.width,
+                     raster + size_t{ bottom } * block.width);
+  }
+  return true;
+}
+
+// Put a row of packed ABGR pixels into a buffer of RGBA components.
+void
+RGBARowToBuffer(unsigned char * to, const unsigned char * from, unsigned int width)
+{
+  const auto * pixels = reinterpret_cast<const uint32_t *>(from);
+  for (unsigned int x = 0; x < width; ++x, to += 4)
+  {
+    to[0] = static_cast<unsigned char>(TIFFGetR(pixels[x]));
+    to[1] = static_cast<unsigned char>(TIFFGetG(pixels[x]));
+    to[2] = static_cast<unsigned char>(TIFFGetB(pixels[x]));
+    to[3] = static_cast<unsigned char>(TIFFGetA(pixels[x]));
+  }
+}
+
+// Run the work units on dedicated threads, the calling thread being one of
+// them. The reads may be run by a task of the pool of the MultiThreaderBase,
+// which must not wait on other tasks of the pool.
+void
+RunWorkUnits(size_t numberOfWorkUnits, const std::function<void(size_t)> & workUnit)
+{
+  std::vector<std::thread> threads;
+  size_t                   spawned = 1;
+  for (; spawned < numberOfWorkUnits; ++spawned)
+  {
+    try
+    {
+      threads.emplace_back(workUnit, spawned);
+    }
+    catch (const std::system_error &)
+    {
+      break;
+    }
+  }
+  workUnit(0);
+  for (size_t unit = spawned; unit < numberOfWorkUnits; ++unit)
+  {
+    workUnit(unit);
+  }
+  for (std::thread & thread : threads)
+  {
+    thread.join();
+  }
+}
+} // namespace
+
+/** Least recently used decoded strips and tiles of a file. */
+struct TIFFImageIO::TileCache
+{
+  using KeyType = std::pair<unsigned int, uint32_t>; // directory, strip or tile
+  using BlockDataType = std::shared_ptr<const std::vector<unsigned char>>;
+  using ListType = std::list<std::pair<KeyType, BlockDataType>>;
+
+  BlockDataType
+  Find(const KeyType & key)
+  {
+    const auto it = m_Index.find(key);
+    if (it == m_Index.end())
+    {
+      return nullptr;
+    }
+    m_Blocks.splice(m_Blocks.begin(), m_Blocks, it->second);
+    return it->second->second;
+  }
+
+  void
+  Insert(const KeyType & key, const BlockDataType & data, SizeValueType capacity)
+  {
+    if (data->size() > capacity || m_Index.count(key) > 0)
+    {
+      return;
+    }
+    m_Blocks.emplace_front(key, data);
+    m_Index[key] = m_Blocks.begin();
+    m_Size += data->size();
+    this->Shrink(capacity);
+  }
+
+  void
+  Shrink(SizeValueType capacity)
+  {
+    while (m_Size > capacity)
+    {
+      m_Size -= m_Blocks.back().second->size();
+      m_Index.erase(m_Blocks.back().first);
+      m_Blocks.pop_back();
+    }
+  }
+
+  void
+  Reset(const std::string & fileName, long modifiedTime)
+  {
+    if (fileName != m_FileName || modifiedTime != m_ModifiedTime)
+    {
+      this->Shrink(0);
+      m_FileName = fileName;
+      m_ModifiedTime = modifiedTime;
+    }
+  }
+
+  std::string                           m_FileName{};
+  long                                  m_ModifiedTime{ 0 };
+  ListType                              m_Blocks{}; // most recently used first
+  std::map<KeyType, ListType::iterator> m_Index{};
+  SizeValueType                         m_Size{ 0 };
+};
+
 bool
 TIFFImageIO::CanReadFile(const char * file)
 {
@@ -149,6 +320,16 @@ TIFFImageIO::ReadVolume(void * buffer)
   const size_t width{ m_InternalImage->m_Width };
   const size_t height{ m_InternalImage->m_Height };
 
+  if (m_InternalImage->CanRead() || m_ReadRGBATiles)
+  {
+    ImageIORegion region(3);
+    region.SetSize(0, width);
+    region.SetSize(1, height);
+    region.SetSize(2, this->GetNumberOfDimensions() > 2 ? this->GetDimensions(2) : 1);
+    this->ReadRegion(buffer, region);
+    return;
+  }
+
   for (uint16_t page = 0; page < m_InternalImage->m_NumberOfPages; ++page)
   {
     if (m_InternalImage->m_IgnoredSubFiles > 0)
@@ -189,7 +370,11 @@ TIFFImageIO::Read(void * buffer)
 
   // The IO region should be of dimensions 3 otherwise we read only the first
   // page
-  if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
+  if (m_InternalImage->CanRead() || m_ReadRGBATiles)
+  {
+    this->ReadRegion(buffer, this->GetIORegion());
+  }
+  else if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
   {
     this->ReadVolume(buffer);
   }
@@ -239,6 +424,22 @@ TIFFImageIO::~TIFFImageIO()
   delete m_InternalImage;
 }
 
+LightObject::Pointer
+TIFFImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_NumberOfWorkUnits = m_NumberOfWorkUnits;
+  rval->m_TileCacheSize = m_TileCacheSize;
+  rval->m_ColorPalette = m_ColorPalette;
+  return loPtr;
+}
+
 void
 TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -246,6 +447,8 @@ TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "Compression: " << m_Compression << std::endl;
   os << indent << "JPEGQuality: " << this->GetJPEGQuality() << std::endl;
+  os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
+  os << indent << "TileCacheSize: " << m_TileCacheSize << std::endl;
   if (!m_ColorPalette.empty())
   {
     os << indent << "Image RGB palette:" << '\n';
@@ -529,6 +732,22 @@ TIFFImageIO::ReadImageInformation()
     // make sure the palette is empty
     m_ColorPalette.resize(0);
   }
+
+  // The tiled files keep the RGBA pixel type, but their tiles are still
+  // decoded one by one, so that they can be streamed
+  m_ReadRGBATiles = !m_InternalImage->CanRead() && this->GetPixelType() == IOPixelEnum::RGBA &&
+                    m_ComponentType == IOComponentEnum::UCHAR && m_InternalImage->CanReadRGBATiles();
+  m_CanStreamRead = m_InternalImage->CanRead() || m_ReadRGBATiles;
+}
+
+ImageIORegion
+TIFFImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  if (!m_UseStreamedReading || !m_CanStreamRead)
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  }
+  return requested;
 }
 
 bool
@@ -1245,64 +1464,338 @@ TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
   const uint32_t width = m_InternalImage->m_Width;
   const uint32_t height = m_InternalImage->m_Height;
 
+  // The pages which can be read natively are read by ReadRegion
+  uint32_t * tempImage = nullptr;
 
-  if (!m_InternalImage->CanRead())
+  if (this->GetNumberOfComponents() == 4 && m_ComponentType == IOComponentEnum::UCHAR)
+  {
+    tempImage = static_cast<uint32_t *>(buffer) + (pixelOffset / 4);
+  }
+  else
+  {
+    itkExceptionMacro("Logic Error: Unexpected buffer type!");
+  }
+
+  if (!TIFFReadRGBAImageOriented(m_InternalImage->m_Image, width, height, tempImage, ORIENTATION_TOPLEFT, 1))
+  {
+    itkExceptionMacro("Cannot read TIFF image as a TIFF RGBA image");
+  }
+
+  auto * out = static_cast<unsigned char *>(buffer) + pixelOffset;
+  RGBAImageToBuffer<unsigned char>(out, tempImage);
+}
+
+void
+TIFFImageIO::ReadRegion(void * buffer, const ImageIORegion & region)
+{
+  TIFF * const   tiff = m_InternalImage->m_Image;
+  const uint32_t width = m_InternalImage->m_Width;
+  const uint32_t height = m_InternalImage->m_Height;
+
+  const auto   regionColumn = static_cast<uint32_t>(region.GetIndex(0));
+  const auto   regionWidth = static_cast<uint32_t>(region.GetSize(0));
+  const auto   regionRow = static_cast<uint32_t>(region.GetIndex(1));
+  const auto   regionHeight = static_cast<uint32_t>(region.GetSize(1));
+  unsigned int firstSlice = 0;
+  unsigned int numberOfSlices = 1;
+  if (region.GetImageDimension() > 2 && this->GetNumberOfDimensions() > 2)
   {
-    uint32_t * tempImage = nullptr;
+    firstSlice = static_cast<unsigned int>(region.GetIndex(2));
+    numberOfSlices = static_cast<unsigned int>(region.GetSize(2));
+  }
 
-    if (this->GetNumberOfComponents() == 4 && m_ComponentType == IOComponentEnum::UCHAR)
+  if (!m_ReadRGBATiles && m_InternalImage->m_PlanarConfig != PLANARCONFIG_CONTIG &&
+      m_InternalImage->m_SamplesPerPixel != 1)
+  {
+    itkExceptionMacro("This reader can only do PLANARCONFIG_CONTIG or single-component PLANARCONFIG_SEPARATE");
+  }
+
+  // The rows of the region in the pages, stored bottom up with ORIENTATION_BOTLEFT
+  const bool     bottomUp = (m_InternalImage->m_Orientation == ORIENTATION_BOTLEFT);
+  const uint32_t firstRow = bottomUp ? height - regionRow - regionHeight : regionRow;
+  const uint32_t endRow = firstRow + regionHeight;
+  const uint32_t endColumn = regionColumn + regionWidth;
+
+  // The directories of the pages, without the reduced resolution images and masks
+  std::vector<unsigned int> directories;
+  for (unsigned int directory = 0;
+       directory < m_InternalImage->m_NumberOfPages && directories.size() < firstSlice + numberOfSlices;
+       ++directory)
+  {
+    if (m_InternalImage->m_IgnoredSubFiles > 0)
     {
-      tempImage = static_cast<uint32_t *>(buffer) + (pixelOffset / 4);
+      int32_t subfiletype = 6;
+      if (TIFFSetDirectory(tiff, static_cast<tdir_t>(directory)) &&
+          TIFFGetField(tiff, TIFFTAG_SUBFILETYPE, &subfiletype) &&
+          (subfiletype & FILETYPE_REDUCEDIMAGE || subfiletype & FILETYPE_MASK))
+      {
+        continue;
+      }
     }
-    else
+    directories.push_back(directory);
+  }
+  if (directories.size() < firstSlice + numberOfSlices)
+  {
+    itkExceptionMacro("Cannot find the page " << firstSlice + numberOfSlices - 1 << " in file " << m_FileName);
+  }
+
+  // The strips or tiles intersecting the region, page by page
+  const size_t bytesPerPixel = m_ReadRGBATiles ? sizeof(uint32_t)
+                                               : size_t{ m_InternalImage->m_BitsPerSample } / 8 *
+                                                   m_InternalImage->m_SamplesPerPixel;
+  std::vector<TIFFBlock> blocks;
+  for (unsigned int slice = 0; slice < numberOfSlices; ++slice)
+  {
+    const unsigned int directory = directories[firstSlice + slice];
+    if (TIFFCurrentDirectory(tiff) != static_cast<tdir_t>(directory) &&
+        !TIFFSetDirectory(tiff, static_cast<tdir_t>(directory)))
+    {
+      itkExceptionMacro("Cannot read the page " << directory << " of file " << m_FileName);
+    }
+
+    uint32_t pageWidth = 0;
+    uint32_t pageHeight = 0;
+    TIFFGetField(tiff, TIFFTAG_IMAGEWIDTH, &pageWidth);
+    TIFFGetField(tiff, TIFFTAG_IMAGELENGTH, &pageHeight);
+    if (pageWidth != width || pageHeight != height)
+    {
+      itkExceptionMacro("The size of the page " << directory << " of file " << m_FileName
+                                                << " differs from the size of the first page");
+    }
+    uint16_t orientation = ORIENTATION_TOPLEFT;
+    if (m_ReadRGBATiles && TIFFGetFieldDefaulted(tiff, TIFFTAG_ORIENTATION, &orientation) &&
+        orientation != ORIENTATION_TOPLEFT)
     {
-      itkExceptionMacro("Logic Error: Unexpected buffer type!");
+      itkExceptionMacro("The orientation of the page " << directory << " of file " << m_FileName
+                                                       << " differs from the orientation of the first page");
     }
 
-    if (!TIFFReadRGBAImageOriented(m_InternalImage->m_Image, width, height, tempImage, ORIENTATION_TOPLEFT, 1))
+    if (TIFFIsTiled(tiff))
+    {
+      uint32_t tileWidth = 0;
+      uint32_t tileHeight = 0;
+      if (!TIFFGetField(tiff, TIFFTAG_TILEWIDTH, &tileWidth) || !TIFFGetField(tiff, TIFFTAG_TILELENGTH, &tileHeight) ||
+          tileWidth == 0 || tileHeight == 0)
+      {
+        itkExceptionMacro("Cannot read tile width and tile length from file " << m_FileName);
+      }
+      for (uint32_t row = firstRow / tileHeight * tileHeight; row < endRow; row += tileHeight)
+      {
+        for (uint32_t column = regionColumn / tileWidth * tileWidth; column < endColumn; column += tileWidth)
+        {
+          blocks.push_back({ slice,
+                             directory,
+                             true,
+                             TIFFComputeTile(tiff, column, row, 0, 0),
+                             column,
+                             row,
+                             tileWidth,
+                             tileHeight,
+                             size_t{ tileWidth } * tileHeight * bytesPerPixel });
+        }
+      }
+    }
+    else
     {
-      itkExceptionMacro("Cannot read TIFF image as a TIFF RGBA image");
+      uint32_t rowsPerStrip = height;
+      TIFFGetFieldDefaulted(tiff, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+      rowsPerStrip = std::max<uint32_t>(std::min(rowsPerStrip, height), 1);
+      for (uint32_t row = firstRow / rowsPerStrip * rowsPerStrip; row < endRow; row += rowsPerStrip)
+      {
+        const uint32_t stripHeight = std::min(rowsPerStrip, height - row);
+        blocks.push_back({ slice,
+                           directory,
+                           false,
+                           TIFFComputeStrip(tiff, row, 0),
+                           0,
+                           row,
+                           width,
+                           stripHeight,
+                           size_t{ width } * stripHeight * bytesPerPixel });
+      }
     }
+  }
 
-    auto * out = static_cast<unsigned char *>(buffer) + pixelOffset;
-    RGBAImageToBuffer<unsigned char>(out, tempImage);
+  if (m_TileCacheSize > 0)
+  {
+    if (!m_TileCache)
+    {
+      m_TileCache = std::make_unique<TileCache>();
+    }
+    m_TileCache->Reset(m_FileName, itksys::SystemTools::ModifiedTime(m_FileName));
+    m_TileCache->Shrink(m_TileCacheSize);
   }
   else
   {
+    m_TileCache.reset();
+  }
+
+  const unsigned int numberOfWorkUnits =
+    m_NumberOfWorkUnits > 0 ? m_NumberOfWorkUnits : MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
 
-    this->InitializeColors();
+  // Each concurrent work unit decodes through its own handle on the file
+  std::vector<std::unique_ptr<TIFFReaderInternal>> decoders(numberOfWorkUnits);
 
+  const size_t       maximumBatchSize = MaximumDecodedBytesPerWorkUnit * numberOfWorkUnits;
+  const unsigned int numberOfComponents = this->GetNumberOfComponents();
+  const size_t       componentSize = this->GetComponentSize();
 
-    if (m_ComponentType == IOComponentEnum::USHORT)
+  // The strips or tiles are decoded and put into the buffer by batches
+  // bounding the memory used by the decoded data.
+  for (size_t batchBegin = 0; batchBegin < blocks.size();)
+  {
+    size_t batchEnd = batchBegin;
+    size_t batchSize = 0;
+    while (batchEnd < blocks.size() &&
+           (batchEnd == batchBegin || batchSize + blocks[batchEnd].size <= maximumBatchSize))
     {
-      auto * volume = static_cast<unsigned short *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
+      batchSize += blocks[batchEnd].size;
+      ++batchEnd;
     }
-    else if (m_ComponentType == IOComponentEnum::SHORT)
+
+    std::vector<TileCache::BlockDataType> data(batchEnd - batchBegin);
+    std::vector<size_t>                   blocksToDecode;
+    for (size_t k = 0; k < data.size(); ++k)
     {
-      auto * volume = static_cast<short *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
+      const TIFFBlock & block = blocks[batchBegin + k];
+      if (m_TileCache)
+      {
+        data[k] = m_TileCache->Find({ block.directory, block.index });
+      }
+      if (!data[k])
+      {
+        blocksToDecode.push_back(k);
+      }
     }
-    else if (m_ComponentType == IOComponentEnum::CHAR)
+
+    const size_t             numberOfChunks = std::min<size_t>(numberOfWorkUnits, blocksToDecode.size());
+    std::vector<std::string> errors(numberOfChunks);
+    const auto               decodeChunk = [&](SizeValueType chunk) {
+      try
+      {
+        TIFF * decoder = tiff;
+        if (numberOfChunks > 1)
+        {
+          if (!decoders[chunk])
+          {
+            auto internalImage = std::make_unique<TIFFReaderInternal>();
+            if (!internalImage->OpenForDecoding(m_FileName.c_str()))
+            {
+              errors[chunk] = "Cannot open file " + m_FileName;
+              return;
+            }
+            decoders[chunk] = std::move(internalImage);
+          }
+          decoder = decoders[chunk]->m_Image;
+        }
+
+        const size_t begin = (blocksToDecode.size() * chunk) / numberOfChunks;
+        const size_t end = (blocksToDecode.size() * (chunk + 1)) / numberOfChunks;
+        for (size_t n = begin; n < end; ++n)
+        {
+          const TIFFBlock & block = blocks[batchBegin + blocksToDecode[n]];
+          auto              blockData = std::make_shared<std::vector<unsigned char>>(block.size);
+          if (!(m_ReadRGBATiles ? DecodeRGBABlock(decoder, block, blockData->data())
+                                : DecodeBlock(decoder, block, blockData->data())))
+          {
+            errors[chunk] = "Cannot read the " + std::string(block.tiled ? "tile " : "strip ") +
+                            std::to_string(block.index) + " of the page " + std::to_string(block.directory);
+            return;
+          }
+          data[blocksToDecode[n]] = std::move(blockData);
+        }
+      }
+      catch (const std::exception & e)
+      {
+        errors[chunk] = e.what();
+      }
+    };
+    if (numberOfChunks > 0)
     {
-      auto * volume = static_cast<char *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
+      RunWorkUnits(numberOfChunks, decodeChunk);
     }
-    else if (m_ComponentType == IOComponentEnum::FLOAT)
+    for (const std::string & error : errors)
     {
-      auto * volume = static_cast<float *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
+      if (!error.empty())
+      {
+        itkExceptionMacro(<< error << " in file " << m_FileName);
+      }
     }
-    else
+
+    if (m_TileCache)
     {
-      auto * volume = static_cast<unsigned char *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
+      for (const size_t k : blocksToDecode)
+      {
+        const TIFFBlock & block = blocks[batchBegin + k];
+        m_TileCache->Insert({ block.directory, block.index }, data[k], m_TileCacheSize);
+      }
     }
+
+    // Put the rows of the region into the buffer, with the colors of the page
+    auto colorsDirectory = std::numeric_limits<unsigned int>::max();
+    for (size_t k = 0; k < data.size(); ++k)
+    {
+      const TIFFBlock & block = blocks[batchBegin + k];
+      if (!m_ReadRGBATiles && block.directory != colorsDirectory)
+      {
+        if (TIFFCurrentDirectory(tiff) != static_cast<tdir_t>(block.directory))
+        {
+          TIFFSetDirectory(tiff, static_cast<tdir_t>(block.directory));
+        }
+        this->InitializeColors();
+        colorsDirectory = block.directory;
+      }
+
+      const uint32_t        beginColumn = std::max(block.column, regionColumn);
+      const uint32_t        numberOfColumns = std::min(block.column + block.width, endColumn) - beginColumn;
+      const uint32_t        beginRow = std::max(block.row, firstRow);
+      const uint32_t        endBlockRow = std::min(block.row + block.height, endRow);
+      const size_t          rowSize = size_t{ block.width } * bytesPerPixel;
+      const unsigned char * blockData = data[k]->data();
+      for (uint32_t row = beginRow; row < endBlockRow; ++row)
+      {
+        const uint32_t imageRow = bottomUp ? height - 1 - row : row;
+        const size_t   pixelOffset =
+          (size_t{ block.slice } * regionHeight + (imageRow - regionRow)) * regionWidth + (beginColumn - regionColumn);
+        void * const to = static_cast<unsigned char *>(buffer) + pixelOffset * numberOfComponents * componentSize;
+        const unsigned char * from =
+          blockData + (row - block.row) * rowSize + (beginColumn - block.column) * bytesPerPixel;
+
+        if (m_ReadRGBATiles)
+        {
+          RGBARowToBuffer(static_cast<unsigned char *>(to), from, numberOfColumns);
+          continue;
+        }
+        switch (m_ComponentType)
+        {
+          case IOComponentEnum::UCHAR:
+            this->PutRow(static_cast<unsigned char *>(to), from, numberOfColumns);
+            break;
+          case IOComponentEnum::CHAR:
+            this->PutRow(static_cast<char *>(to), from, numberOfColumns);
+            break;
+          case IOComponentEnum::USHORT:
+            this->PutRow(static_cast<unsigned short *>(to), from, numberOfColumns);
+            break;
+          case IOComponentEnum::SHORT:
+            this->PutRow(static_cast<short *>(to), from, numberOfColumns);
+            break;
+          case IOComponentEnum::UINT:
+            this->PutRow(static_cast<unsigned int *>(to), from, numberOfColumns);
+            break;
+          case IOComponentEnum::INT:
+            this->PutRow(static_cast<int *>(to), from, numberOfColumns);
+            break;
+          case IOComponentEnum::FLOAT:
+            this->PutRow(static_cast<float *>(to), from, numberOfColumns);
+            break;
+          default:
+            itkExceptionMacro("Logic Error: Unexpected component type!");
+        }
+      }
+    }
+
+    batchBegin = batchEnd;
   }
 }
 
@@ -1378,82 +1871,88 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
       image = out + inc * width * (height - (row + 1));
     }
 
-    switch (this->GetFormat())
-    {
-      case TIFFImageIO::GRAYSCALE:
-        // check inverted
-        PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
-      case TIFFImageIO::RGB_:
-        PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
+    this->PutRow(image, buf, width);
+  }
+
+  _TIFFfree(buf);
+}
 
-      case TIFFImageIO::PALETTE_GRAYSCALE:
+template <typename TComponent>
+void
+TIFFImageIO::PutRow(TComponent * to, const void * from, unsigned int width)
+{
+  switch (this->GetFormat())
+  {
+    case TIFFImageIO::GRAYSCALE:
+      // check inverted
+      PutGrayscale<TComponent>(to, static_cast<const TComponent *>(from), width, 1, 0, 0);
+      break;
+    case TIFFImageIO::RGB_:
+      PutRGB_<TComponent>(to, static_cast<const TComponent *>(from), width, 1, 0, 0);
+      break;
+
+    case TIFFImageIO::PALETTE_GRAYSCALE:
+      switch (m_InternalImage->m_BitsPerSample)
+      {
+        case 8:
+          PutPaletteGrayscale<TComponent, unsigned char>(to, static_cast<const unsigned char *>(from), width, 1, 0, 0);
+          break;
+        case 16:
+          PutPaletteGrayscale<TComponent, unsigned short>(
+            to, static_cast<const unsigned short *>(from), width, 1, 0, 0);
+          break;
+        default:
+          itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                                                                << "-bit samples with palette.");
+      }
+      break;
+    case TIFFImageIO::PALETTE_RGB:
+      if (!this->GetIsReadAsScalarPlusPalette())
+      {
         switch (m_InternalImage->m_BitsPerSample)
         {
           case 8:
-            PutPaletteGrayscale<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<TComponent, unsigned char>(to, static_cast<const unsigned char *>(from), width, 1, 0, 0);
             break;
           case 16:
-            PutPaletteGrayscale<ComponentType, unsigned short>(
-              image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<TComponent, unsigned short>(to, static_cast<const unsigned short *>(from), width, 1, 0, 0);
             break;
           default:
             itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
                                                                   << "-bit samples with palette.");
         }
-        break;
-      case TIFFImageIO::PALETTE_RGB:
-        if (!this->GetIsReadAsScalarPlusPalette())
-        {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteRGB<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                                                    << "-bit samples with palette.");
-          }
-        }
-        else
+      }
+      else
+      {
+        switch (m_InternalImage->m_BitsPerSample)
         {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteScalar<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteScalar<ComponentType, unsigned short>(
-                image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                                                    << "-bit samples with palette.");
-          }
+          case 8:
+            PutPaletteScalar<TComponent, unsigned char>(to, static_cast<const unsigned char *>(from), width, 1, 0, 0);
+            break;
+          case 16:
+            PutPaletteScalar<TComponent, unsigned short>(to, static_cast<const unsigned short *>(from), width, 1, 0, 0);
+            break;
+          default:
+            itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                                                                  << "-bit samples with palette.");
         }
-        break;
+      }
+      break;
 
-      default:
-        itkExceptionMacro("Logic Error: Unexpected format!");
-    }
+    default:
+      itkExceptionMacro("Logic Error: Unexpected format!");
   }
-
-  _TIFFfree(buf);
 }
 
 // iso component scalar
 template <typename TType>
 void
-TIFFImageIO::PutGrayscale(TType *      to,
-                          TType *      from,
-                          unsigned int xsize,
-                          unsigned int ysize,
-                          unsigned int toskew,
-                          unsigned int fromskew)
+TIFFImageIO::PutGrayscale(TType *       to,
+                          const TType * from,
+                          unsigned int  xsize,
+                          unsigned int  ysize,
+                          unsigned int  toskew,
+                          unsigned int  fromskew)
 {
   for (unsigned int y = ysize; y-- > 0;)
   {
@@ -1469,12 +1968,12 @@ TIFFImageIO::PutGrayscale(TType *      to,
 // iso component scalar
 template <typename TType>
 void
-TIFFImageIO::PutRGB_(TType *      to,
-                     TType *      from,
-                     unsigned int xsize,
-                     unsigned int ysize,
-                     unsigned int toskew,
-                     unsigned int fromskew)
+TIFFImageIO::PutRGB_(TType *       to,
+                     const TType * from,
+                     unsigned int  xsize,
+                     unsigned int  ysize,
+                     unsigned int  toskew,
+                     unsigned int  fromskew)
 {
   const size_t samplesPerPixel = m_InternalImage->m_SamplesPerPixel;
   const size_t linesize = samplesPerPixel * xsize;
@@ -1492,12 +1991,12 @@ TIFFImageIO::PutRGB_(TType *      to,
 
 template <typename TType, typename TFromType>
 void
-TIFFImageIO::PutPaletteRGB(TType *      to,
-                           TFromType *  from,
-                           unsigned int xsize,
-                           unsigned int ysize,
-                           unsigned int toskew,
-                           unsigned int fromskew)
+TIFFImageIO::PutPaletteRGB(TType *           to,
+                           const TFromType * from,
+                           unsigned int      xsize,
+                           unsigned int      ysize,
+                           unsigned int      toskew,
+                           unsigned int      fromskew)
 {
   for (unsigned int y = ysize; y-- > 0;)
   {
@@ -1522,12 +2021,12 @@ TIFFImageIO::PutPaletteRGB(TType *      to,
 
 template <typename TType, typename TFromType>
 void
-TIFFImageIO::PutPaletteGrayscale(TType *      to,
-                                 TFromType *  from,
-                                 unsigned int xsize,
-                                 unsigned int ysize,
-                                 unsigned int toskew,
-                                 unsigned int fromskew)
+TIFFImageIO::PutPaletteGrayscale(TType *           to,
+                                 const TFromType * from,
+                                 unsigned int      xsize,
+                                 unsigned int      ysize,
+                                 unsigned int      toskew,
+                                 unsigned int      fromskew)
 {
   for (unsigned int y = ysize; y-- > 0;)
   {
@@ -1547,12 +2046,12 @@ TIFFImageIO::PutPaletteGrayscale(TType *      to,
 
 template <typename TType, typename TFromType>
 void
-TIFFImageIO::PutPaletteScalar(TType *      to,
-                              TFromType *  from,
-                              unsigned int xsize,
-                              unsigned int ysize,
-                              unsigned int toskew,
-                              unsigned int fromskew)
+TIFFImageIO::PutPaletteScalar(TType *           to,
+                              const TFromType * from,
+                              unsigned int      xsize,
+                              unsigned int      ysize,
+                              unsigned int      toskew,
+                              unsigned int      fromskew)
 {
   for (unsigned int y = ysize; y-- > 0;)
   {
@@ -81,6 +81,36 @@ itkTIFFWarningHandlerExtR([[maybe_unused]] TIFF * tif,
 
 int
 TIFFReaderInternal::Open(const char * filename, bool silent)
+{
+  if (!this->OpenFile(filename, silent))
+  {
+    return 0;
+  }
+  if (!this->Initialize())
+  {
+    this->Clean();
+    return 0;
+  }
+
+  this->m_WarningSilence = false;
+  this->m_ErrorSilence = false;
+  this->m_IsOpen = true;
+  return 1;
+}
+
+int
+TIFFReaderInternal::OpenForDecoding(const char * filename)
+{
+  if (!this->OpenFile(filename, false))
+  {
+    return 0;
+  }
+  this->m_IsOpen = true;
+  return 1;
+}
+
+int
+TIFFReaderInternal::OpenFile(const char * filename, bool silent)
 {
   this->Clean();
   struct stat fs;
@@ -130,15 +160,6 @@ TIFFReaderInternal::Open(const char * filename, bool silent)
     this->Clean();
     return 0;
   }
-  if (!this->Initialize())
-  {
-    this->Clean();
-    return 0;
-  }
-
-  this->m_WarningSilence = false;
-  this->m_ErrorSilence = false;
-  this->m_IsOpen = true;
   return 1;
 }
 
@@ -185,6 +206,11 @@ TIFFReaderInternal::TIFFReaderInternal()
   this->Clean();
 }
 
+TIFFReaderInternal::~TIFFReaderInternal()
+{
+  this->Clean();
+}
+
 int
 TIFFReaderInternal::Initialize()
 {
@@ -293,4 +319,13 @@ TIFFReaderInternal::CanRead()
           (this->m_BitsPerSample == 8 || this->m_BitsPerSample == 16 || this->m_BitsPerSample == 32));
 }
 
+int
+TIFFReaderInternal::CanReadRGBATiles()
+{
+  char emsg[1024];
+  return (this->m_Image && (this->m_Width > 0) && (this->m_Height > 0) && (this->m_NumberOfTiles > 0) &&
+          TIFFIsCODECConfigured(this->m_Compression) == 1 && this->m_Orientation == ORIENTATION_TOPLEFT &&
+          TIFFRGBAImageOK(this->m_Image, emsg) == 1);
+}
+
 } // namespace itk
@@ -30,6 +30,8 @@ class ITKIOTIFF_HIDDEN TIFFReaderInternal
 {
 public:
   TIFFReaderInternal();
+  ~TIFFReaderInternal();
+
   int
   Initialize();
 
@@ -39,9 +41,19 @@ public:
   int
   CanRead();
 
+  /** Whether the tiles of the file can be decoded one by one as RGBA,
+   * the tiled files not being read natively. */
+  int
+  CanReadRGBATiles();
+
   int
   Open(const char * filename, bool silent = false);
 
+  /** Open the file without reading the tags of its directories, only
+   * to decode the strips or tiles of a directory set by the caller. */
+  int
+  OpenForDecoding(const char * filename);
+
   TIFF *   m_Image;
   bool     m_IsOpen;
   uint32_t m_Width;
@@ -69,6 +81,10 @@ public:
 
   bool m_WarningSilence{ false };
   bool m_ErrorSilence{ false };
+
+private:
+  int
+  OpenFile(const char * filename, bool silent);
 };
 
 } // namespace itk
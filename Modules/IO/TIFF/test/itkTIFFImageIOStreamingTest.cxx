@@ -0,0 +1,320 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkRGBAPixel.h"
+#include "itkRGBPixel.h"
+#include "itkTIFFImageIO.h"
+#include "itkTestingMacros.h"
+#include "itk_tiff.h"
+
+// Read regions of tiled and stripped TIFF files, written here with libtiff.
+
+namespace
+{
+
+unsigned int
+ExpectedValue(unsigned int x, unsigned int y, unsigned int z, unsigned int component)
+{
+  return (7 * x + 13 * y + 29 * z + 53 * component) % 251;
+}
+
+// The expected component of a pixel, the tiled files being read as RGBA.
+unsigned int
+ExpectedComponent(unsigned int x,
+                  unsigned int y,
+                  unsigned int z,
+                  unsigned int component,
+                  unsigned int samplesPerPixel,
+                  unsigned int numberOfComponents)
+{
+  if (numberOfComponents == samplesPerPixel)
+  {
+    return ExpectedValue(x, y, z, component);
+  }
+  if (component == 3)
+  {
+    return 255;
+  }
+  return ExpectedValue(x, y, z, samplesPerPixel == 1 ? 0 : component);
+}
+
+uint16_t
+GetCompression()
+{
+  return TIFFIsCODECConfigured(COMPRESSION_ADOBE_DEFLATE) ? COMPRESSION_ADOBE_DEFLATE : COMPRESSION_NONE;
+}
+
+// Write the pages, tiled when tileWidth is not zero, stripped otherwise.
+// A reduced resolution page is inserted after the first page, it must be
+// ignored by the reader.
+template <typename TComponent>
+bool
+WriteTIFF(const std::string & fileName,
+          unsigned int        width,
+          unsigned int        height,
+          unsigned int        numberOfPages,
+          unsigned int        samplesPerPixel,
+          unsigned int        tileWidth,
+          unsigned int        tileHeight,
+          uint16_t            orientation)
+{
+  TIFF * tiff = TIFFOpen(fileName.c_str(), "w");
+  if (tiff == nullptr)
+  {
+    return false;
+  }
+
+  std::vector<TComponent> buffer;
+  for (unsigned int page = 0; page < numberOfPages; ++page)
+  {
+    for (const bool reduced : { false, true })
+    {
+      if (reduced && (page != 0 || numberOfPages == 1))
+      {
+        continue;
+      }
+      const unsigned int pageWidth = reduced ? width / 2 : width;
+      const unsigned int pageHeight = reduced ? height / 2 : height;
+
+      TIFFSetField(tiff, TIFFTAG_SUBFILETYPE, reduced ? FILETYPE_REDUCEDIMAGE : 0);
+      TIFFSetField(tiff, TIFFTAG_IMAGEWIDTH, pageWidth);
+      TIFFSetField(tiff, TIFFTAG_IMAGELENGTH, pageHeight);
+      TIFFSetField(tiff, TIFFTAG_BITSPERSAMPLE, 8 * sizeof(TComponent));
+      TIFFSetField(tiff, TIFFTAG_SAMPLESPERPIXEL, samplesPerPixel);
+      TIFFSetField(tiff, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+      TIFFSetField(tiff, TIFFTAG_PHOTOMETRIC, samplesPerPixel == 3 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK);
+      TIFFSetField(tiff, TIFFTAG_ORIENTATION, orientation);
+      TIFFSetField(tiff, TIFFTAG_COMPRESSION, GetCompression());
+
+      // the samples of the page, top down
+      const unsigned int imageWidth = tileWidth ? (pageWidth + tileWidth - 1) / tileWidth * tileWidth : pageWidth;
+      const unsigned int imageHeight = tileWidth ? (pageHeight + tileHeight - 1) / tileHeight * tileHeight : pageHeight;
+      buffer.assign(size_t{ imageWidth } * imageHeight * samplesPerPixel, 0);
+      for (unsigned int row = 0; row < pageHeight; ++row)
+      {
+        const unsigned int y = (orientation == ORIENTATION_BOTLEFT) ? pageHeight - 1 - row : row;
+        for (unsigned int x = 0; x < pageWidth; ++x)
+        {
+          for (unsigned int c = 0; c < samplesPerPixel; ++c)
+          {
+            buffer[(size_t{ row } * imageWidth + x) * samplesPerPixel + c] =
+              static_cast<TComponent>(reduced ? 0 : ExpectedValue(x, y, page, c));
+          }
+        }
+      }
+
+      if (tileWidth)
+      {
+        TIFFSetField(tiff, TIFFTAG_TILEWIDTH, tileWidth);
+        TIFFSetField(tiff, TIFFTAG_TILELENGTH, tileHeight);
+        std::vector<TComponent> tile(size_t{ tileWidth } * tileHeight * samplesPerPixel);
+        for (unsigned int row = 0; row < imageHeight; row += tileHeight)
+        {
+          for (unsigned int column = 0; column < imageWidth; column += tileWidth)
+          {
+            for (unsigned int r = 0; r < tileHeight; ++r)
+            {
+              std::copy_n(&buffer[(size_t{ row + r } * imageWidth + column) * samplesPerPixel],
+                          tileWidth * samplesPerPixel,
+                          &tile[size_t{ r } * tileWidth * samplesPerPixel]);
+            }
+            if (TIFFWriteTile(tiff, tile.data(), column, row, 0, 0) < 0)
+            {
+              TIFFClose(tiff);
+              return false;
+            }
+          }
+        }
+      }
+      else
+      {
+        TIFFSetField(tiff, TIFFTAG_ROWSPERSTRIP, 5);
+        for (unsigned int row = 0; row < pageHeight; ++row)
+        {
+          if (TIFFWriteScanline(tiff, &buffer[size_t{ row } * imageWidth * samplesPerPixel], row, 0) < 0)
+          {
+            TIFFClose(tiff);
+            return false;
+          }
+        }
+      }
+      TIFFWriteDirectory(tiff);
+    }
+  }
+  TIFFClose(tiff);
+  return true;
+}
+
+// Read the region and check its pixels.
+template <typename TImage>
+bool
+ReadRegion(itk::TIFFImageIO *                   imageIO,
+           const std::string &                  fileName,
+           unsigned int                         samplesPerPixel,
+           const typename TImage::RegionType & region)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(imageIO);
+  reader->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Update();
+
+  const TImage * image = reader->GetOutput();
+  if (image->GetBufferedRegion() != region)
+  {
+    std::cerr << "Read region " << image->GetBufferedRegion() << " instead of " << region << std::endl;
+    return false;
+  }
+
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const typename TImage::IndexType index = it.GetIndex();
+    const auto                       z = (TImage::ImageDimension > 2) ? index[TImage::ImageDimension - 1] : 0;
+    const typename TImage::PixelType pixel = it.Get();
+    const unsigned int numberOfComponents = itk::NumericTraits<typename TImage::PixelType>::GetLength(pixel);
+    for (unsigned int c = 0; c < numberOfComponents; ++c)
+    {
+      const auto expected = ExpectedComponent(index[0], index[1], z, c, samplesPerPixel, numberOfComponents);
+      if (static_cast<unsigned int>(itk::DefaultConvertPixelTraits<typename TImage::PixelType>::GetNthComponent(
+            c, pixel)) != expected)
+      {
+        std::cerr << "Wrong component " << c << " at " << index << " in region " << region << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Read the whole image and regions, in several configurations of the ImageIO.
+template <typename TImage>
+bool
+ReadRegions(const std::string &                  fileName,
+            unsigned int                         samplesPerPixel,
+            const typename TImage::RegionType & largestRegion)
+{
+  using RegionType = typename TImage::RegionType;
+
+  std::vector<RegionType> regions{ largestRegion };
+  RegionType              region = largestRegion;
+  region.ShrinkByRadius(3);
+  regions.push_back(region);
+  region.SetIndex(0, 1);
+  region.SetSize(0, 1);
+  regions.push_back(region);
+  region = largestRegion;
+  region.SetIndex(1, largestRegion.GetSize(1) - 1);
+  region.SetSize(1, 1);
+  regions.push_back(region);
+  regions.push_back(regions[1]);
+
+  bool passed = true;
+  for (const unsigned int numberOfWorkUnits : { 1, 4 })
+  {
+    for (const itk::SizeValueType tileCacheSize : { 0, 1 << 20, 2000 })
+    {
+      auto imageIO = itk::TIFFImageIO::New();
+      imageIO->SetNumberOfWorkUnits(numberOfWorkUnits);
+      imageIO->SetTileCacheSize(tileCacheSize);
+      for (const RegionType & regionToRead : regions)
+      {
+        if (!ReadRegion<TImage>(imageIO, fileName, samplesPerPixel, regionToRead))
+        {
+          std::cerr << "  with " << numberOfWorkUnits << " work units and a cache of " << tileCacheSize << " bytes"
+                    << std::endl;
+          passed = false;
+        }
+      }
+      if (!imageIO->CanStreamRead())
+      {
+        std::cerr << fileName << " cannot be stream read" << std::endl;
+        passed = false;
+      }
+    }
+  }
+  return passed;
+}
+
+} // namespace
+
+int
+itkTIFFImageIOStreamingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  auto imageIO = itk::TIFFImageIO::New();
+  ITK_TEST_SET_GET_VALUE(0, imageIO->GetNumberOfWorkUnits());
+  ITK_TEST_SET_GET_VALUE(0, imageIO->GetTileCacheSize());
+
+  bool passed = true;
+
+  // The tiled files are read as RGBA, as they were before their tiles were
+  // decoded one by one
+  std::cout << "Tiled 2D image" << std::endl;
+  using TiledImageType = itk::Image<itk::RGBAPixel<unsigned char>, 2>;
+  const std::string tiledFileName = directory + "/itkTIFFImageIOStreamingTestTiled.tif";
+  ITK_TEST_EXPECT_TRUE(WriteTIFF<unsigned char>(tiledFileName, 100, 77, 1, 1, 32, 16, ORIENTATION_TOPLEFT));
+  const TiledImageType::SizeType tiledSize{ { 100, 77 } };
+  passed &= ReadRegions<TiledImageType>(tiledFileName, 1, TiledImageType::RegionType(tiledSize));
+
+  imageIO->SetFileName(tiledFileName);
+  imageIO->ReadImageInformation();
+  ITK_TEST_EXPECT_EQUAL(imageIO->GetPixelType(), itk::IOPixelEnum::RGBA);
+  ITK_TEST_EXPECT_EQUAL(imageIO->GetComponentType(), itk::IOComponentEnum::UCHAR);
+  ITK_TEST_EXPECT_EQUAL(imageIO->GetNumberOfComponents(), 4);
+
+  std::cout << "Tiled RGB volume" << std::endl;
+  using TiledVolumeType = itk::Image<itk::RGBAPixel<unsigned char>, 3>;
+  const std::string tiledVolumeFileName = directory + "/itkTIFFImageIOStreamingTestTiledVolume.tif";
+  ITK_TEST_EXPECT_TRUE(WriteTIFF<unsigned char>(tiledVolumeFileName, 50, 33, 6, 3, 16, 16, ORIENTATION_TOPLEFT));
+  const TiledVolumeType::SizeType tiledVolumeSize{ { 50, 33, 6 } };
+  passed &= ReadRegions<TiledVolumeType>(tiledVolumeFileName, 3, TiledVolumeType::RegionType(tiledVolumeSize));
+
+  std::cout << "Tiled bottom up image" << std::endl;
+  const std::string bottomUpFileName = directory + "/itkTIFFImageIOStreamingTestTiledBottomUp.tif";
+  ITK_TEST_EXPECT_TRUE(WriteTIFF<unsigned char>(bottomUpFileName, 40, 21, 1, 1, 16, 16, ORIENTATION_BOTLEFT));
+  const TiledImageType::SizeType bottomUpSize{ { 40, 21 } };
+  auto                           bottomUpImageIO = itk::TIFFImageIO::New();
+  passed &=
+    ReadRegion<TiledImageType>(bottomUpImageIO, bottomUpFileName, 1, TiledImageType::RegionType(bottomUpSize));
+  ITK_TEST_EXPECT_TRUE(!bottomUpImageIO->CanStreamRead());
+
+  std::cout << "Stripped bottom up volume" << std::endl;
+  using StrippedVolumeType = itk::Image<unsigned char, 3>;
+  const std::string strippedFileName = directory + "/itkTIFFImageIOStreamingTestStripped.tif";
+  ITK_TEST_EXPECT_TRUE(WriteTIFF<unsigned char>(strippedFileName, 37, 29, 7, 1, 0, 0, ORIENTATION_BOTLEFT));
+  const StrippedVolumeType::SizeType strippedSize{ { 37, 29, 7 } };
+  passed &= ReadRegions<StrippedVolumeType>(strippedFileName, 1, StrippedVolumeType::RegionType(strippedSize));
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
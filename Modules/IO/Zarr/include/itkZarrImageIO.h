@@ -0,0 +1,199 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkZarrImageIO_h
+#define itkZarrImageIO_h
+#include "ITKIOZarrExport.h"
+
+#include "itkStreamingImageIOBase.h"
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class ZarrImageIO
+ *
+ * \brief Read and write images stored as Zarr arrays.
+ *
+ * A Zarr array is a directory holding the metadata of an N-dimensional
+ * array, and its chunks: the array is split in a regular grid of
+ * chunks, each stored, compressed or not, in a file of its own. Each
+ * chunk is addressed independently, so that any region of the image is
+ * read or written by reading or writing the chunks it overlaps only.
+ * The chunks of a region are decompressed and compressed, read and
+ * written concurrently on threads of their own.
+ *
+ * Version 2 of the format, with its \c .zarray and \c .zattrs files, and
+ * version 3, with its \c zarr.json file, are both read and written. The
+ * first data set of an OME-Zarr multiscale group is read too. The axes of
+ * the array are in the reverse order of the image dimensions, the slowest
+ * moving first, and the components of a multi-component pixel are its
+ * last, fastest moving, axis. The spacing, origin, direction, pixel type
+ * and string meta data of the image are stored in the \c itk attribute of
+ * the array.
+ *
+ * The chunks are either uncompressed, or compressed by zlib or gzip
+ * when UseCompression is on, the compressor being selected by
+ * SetCompressor("ZLIB"), the default, or SetCompressor("GZIP"). Other
+ * codecs, like blosc or zstd, are not supported. Chunks missing from the
+ * directory hold the fill value of the array.
+ *
+ * Both streamed reading and streamed writing are supported, so that
+ * images larger than memory are processed by a StreamingImageFilter or
+ * an ImageFileWriter with stream divisions. A region pasted in an
+ * existing array only rewrites the chunks it overlaps.
+ *
+ * \sa HDF5ImageIO
+ * \ingroup IOFilters
+ * \ingroup ITKIOZarr
+ */
+class ITKIOZarr_EXPORT ZarrImageIO : public StreamingImageIOBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ZarrImageIO);
+
+  /** Standard class type aliases. */
+  using Self = ZarrImageIO;
+  using Superclass = StreamingImageIOBase;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ZarrImageIO);
+
+  /*-------- This part of the interfaces deals with reading data. ----- */
+
+  /** Determine if the file can be read with this ImageIO implementation:
+   * it must be a directory holding a Zarr array, or an OME-Zarr
+   * multiscale group. */
+  bool
+  CanReadFile(const char * filename) override;
+
+  /** Set the spacing and dimension information for the set filename. */
+  void
+  ReadImageInformation() override;
+
+  /** Reads the chunks overlapping the IO region into the memory buffer
+   * provided. */
+  void
+  Read(void * buffer) override;
+
+  /*-------- This part of the interfaces deals with writing data. ----- */
+
+  /** Determine if the file can be written with this ImageIO
+   * implementation: its extension must be ".zarr". */
+  bool
+  CanWriteFile(const char * filename) override;
+
+  /** Create the directory of the array, replacing any existing array,
+   * and write its metadata. */
+  void
+  WriteImageInformation() override;
+
+  /** Writes the chunks overlapping the IO region from the memory buffer
+   * provided, creating the array first unless a region is pasted in an
+   * existing one. */
+  void
+  Write(const void * buffer) override;
+
+  /** Removes an existing array before streaming a whole image into a
+   * new one. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  /** Shape of a chunk, in image (fastest moving first) order. */
+  using ChunkSizeType = std::vector<SizeValueType>;
+
+  /** Set/Get the shape, in pixels, of the chunks of the arrays written,
+   * in image order. The components of a pixel always share a chunk, and
+   * the extents are clamped to the image size. An empty shape, the
+   * default, selects near-cubic chunks of about 1 MiB by halving the
+   * largest extent of the image until a chunk fits. */
+  itkSetMacro(ChunkSize, ChunkSizeType);
+  itkGetConstReferenceMacro(ChunkSize, ChunkSizeType);
+
+  /** Set/Get the version of the Zarr format of the arrays written, 2 or
+   * 3. Defaults to 2. Both versions are read. */
+  itkSetClampMacro(ZarrFormat, unsigned int, 2, 3);
+  itkGetConstMacro(ZarrFormat, unsigned int);
+
+  /** Set/Get the number of work units reading and writing the chunks of
+   * a region concurrently. Zero, the default, uses the global default
+   * number of threads. */
+  itkSetMacro(NumberOfWorkUnits, unsigned int);
+  itkGetConstMacro(NumberOfWorkUnits, unsigned int);
+
+protected:
+  ZarrImageIO();
+  ~ZarrImageIO() override;
+
+  SizeType
+  GetHeaderSize() const override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Also copies the chunk size, the format version and the number of work units. */
+  LightObject::Pointer
+  InternalClone() const override;
+
+  void
+  InternalSetCompressor(const std::string & _compressor) override;
+
+private:
+  /** Remove the array, or the file, stored at the file name, refusing
+   * to remove a directory which is not a single Zarr array, like a Zarr
+   * group. */
+  void
+  RemoveExistingArray();
+
+  /** The chunk shape of the array to write, in image order. */
+  ChunkSizeType
+  ComputeChunkSize() const;
+
+  /** The name of the file of a chunk, from its index in the grid of
+   * chunks, in array (slowest moving first) order. */
+  std::string
+  GetChunkFileName(const std::vector<SizeValueType> & chunkIndex) const;
+
+  /** Write the chunks overlapping the IO region concurrently. */
+  void
+  WriteChunks(const void * buffer);
+
+  ChunkSizeType m_ChunkSize{};
+  unsigned int  m_ZarrFormat{ 2 };
+  unsigned int  m_NumberOfWorkUnits{ 0 };
+  std::string   m_CompressorCodec{ "zlib" };
+
+  // The layout of the chunks of the array read or written
+  std::string   m_ArrayPath{};
+  ChunkSizeType m_StoredChunkSize{};
+  std::string   m_ChunkKeyPrefix{};
+  char          m_ChunkKeySeparator{ '.' };
+  std::string   m_Codec{};
+  int           m_CodecLevel{ 0 };
+  bool          m_IsBigEndian{ false };
+  double        m_FillValue{ 0.0 };
+};
+} // end namespace itk
+
+#endif // itkZarrImageIO_h
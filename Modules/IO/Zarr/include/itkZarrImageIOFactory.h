@@ -0,0 +1,71 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkZarrImageIOFactory_h
+#define itkZarrImageIOFactory_h
+#include "ITKIOZarrExport.h"
+
+#include "itkObjectFactoryBase.h"
+#include "itkImageIOBase.h"
+
+namespace itk
+{
+/**
+ * \class ZarrImageIOFactory
+ * \brief Create instances of ZarrImageIO objects using an object factory.
+ * \ingroup ITKIOZarr
+ */
+class ITKIOZarr_EXPORT ZarrImageIOFactory : public ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ZarrImageIOFactory);
+
+  /** Standard class type aliases. */
+  using Self = ZarrImageIOFactory;
+  using Superclass = ObjectFactoryBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Class methods used to interface with the registered factories. */
+  const char *
+  GetITKSourceVersion() const override;
+
+  const char *
+  GetDescription() const override;
+
+  /** Method for class instantiation. */
+  itkFactorylessNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ZarrImageIOFactory);
+
+  /** Register one factory of this type  */
+  static void
+  RegisterOneFactory()
+  {
+    auto ZarrFactory = ZarrImageIOFactory::New();
+
+    ObjectFactoryBase::RegisterFactoryInternal(ZarrFactory);
+  }
+
+protected:
+  ZarrImageIOFactory();
+  ~ZarrImageIOFactory() override;
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,18 @@
+set(DOCUMENTATION "This module contains an ImageIO class for reading and writing
+chunked N-dimensional arrays stored as Zarr (version 2 and 3) directories.
+The chunks are compressed, decompressed, read and written concurrently.")
+
+itk_module(
+  ITKIOZarr
+  ENABLE_SHARED
+  DEPENDS
+  ITKIOImageBase
+  PRIVATE_DEPENDS
+  ITKZLIB
+  TEST_DEPENDS
+  ITKTestKernel
+  ITKImageSources
+  FACTORY_NAMES
+  ImageIO::Zarr
+  DESCRIPTION
+  "${DOCUMENTATION}")
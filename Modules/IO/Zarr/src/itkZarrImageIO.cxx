@@ -0,0 +1,1922 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkZarrImageIO.h"
+#include "itkByteSwapper.h"
+#include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
+#include "itk_zlib.h"
+#include "itksys/Directory.hxx"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <locale>
+#include <set>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace itk
+{
+namespace
+{
+const std::string ArrayMetadataFile("/.zarray");
+const std::string AttributesFile("/.zattrs");
+const std::string GroupMetadataFile("/.zgroup");
+const std::string V3MetadataFile("/zarr.json");
+const std::string ItkAttribute("itk");
+
+// The size of the chunks selected when no chunk size is set
+constexpr size_t AutomaticChunkBytes = size_t{ 1 } << 20;
+
+// A JSON value, enough for the metadata of the Zarr format.
+struct JsonValue
+{
+  enum class Type
+  {
+    Null,
+    Boolean,
+    Number,
+    String,
+    Array,
+    Object
+  };
+
+  Type                                           type{ Type::Null };
+  bool                                           boolean{ false };
+  double                                         number{ 0.0 };
+  std::string                                    string{};
+  std::vector<JsonValue>                         array{};
+  std::vector<std::pair<std::string, JsonValue>> object{};
+
+  // The member of an object, or nullptr when missing
+  const JsonValue *
+  Find(const std::string & key) const
+  {
+    for (const auto & member : object)
+    {
+      if (member.first == key)
+      {
+        return &member.second;
+      }
+    }
+    return nullptr;
+  }
+
+  // Add a member to an object
+  void
+  Set(const std::string & key, JsonValue value)
+  {
+    type = Type::Object;
+    object.emplace_back(key, std::move(value));
+  }
+};
+
+JsonValue
+MakeJsonNumber(double number)
+{
+  JsonValue value;
+  value.type = JsonValue::Type::Number;
+  value.number = number;
+  return value;
+}
+
+JsonValue
+MakeJsonString(std::string string)
+{
+  JsonValue value;
+  value.type = JsonValue::Type::String;
+  value.string = std::move(string);
+  return value;
+}
+
+template <typename TNumber>
+JsonValue
+MakeJsonArray(const std::vector<TNumber> & numbers)
+{
+  JsonValue value;
+  value.type = JsonValue::Type::Array;
+  for (const TNumber number : numbers)
+  {
+    value.array.push_back(MakeJsonNumber(static_cast<double>(number)));
+  }
+  return value;
+}
+
+JsonValue
+MakeJsonObject()
+{
+  JsonValue value;
+  value.type = JsonValue::Type::Object;
+  return value;
+}
+
+// A recursive descent parser of JSON text. The non-finite numbers NaN,
+// Infinity and -Infinity, written by some Zarr implementations, are
+// accepted.
+class JsonParser
+{
+public:
+  JsonParser(const std::string & text, const std::string & fileName)
+    : m_Text(text)
+    , m_FileName(fileName)
+  {}
+
+  JsonValue
+  Parse()
+  {
+    JsonValue value = this->ParseValue();
+    this->SkipSpaces();
+    if (m_Position != m_Text.size())
+    {
+      this->Fail("unexpected characters after the value");
+    }
+    return value;
+  }
+
+private:
+  [[noreturn]] void
+  Fail(const char * what) const
+  {
+    itkGenericExceptionMacro("Invalid JSON in " << m_FileName << " at offset " << m_Position << ": " << what);
+  }
+
+  void
+  SkipSpaces()
+  {
+    while (m_Position < m_Text.size() &&
+           (m_Text[m_Position] == ' ' || m_Text[m_Position] == '\t' || m_Text[m_Position] == '\n' ||
+            m_Text[m_Position] == '\r'))
+    {
+      ++m_Position;
+    }
+  }
+
+  bool
+  Consume(const char * token)
+  {
+    const size_t length = std::strlen(token);
+    if (m_Text.compare(m_Position, length, token) == 0)
+    {
+      m_Position += length;
+      return true;
+    }
+    return false;
+  }
+
+  void
+  Expect(char character)
+  {
+    this->SkipSpaces();
+    if (m_Position >= m_Text.size() || m_Text[m_Position] != character)
+    {
+      this->Fail("unexpected character");
+    }
+    ++m_Position;
+  }
+
+  JsonValue
+  ParseValue()
+  {
+    this->SkipSpaces();
+    if (m_Position >= m_Text.size())
+    {
+      this->Fail("unexpected end of the text");
+    }
+
+    JsonValue value;
+    const char first = m_Text[m_Position];
+    if (first == '{')
+    {
+      ++m_Position;
+      value.type = JsonValue::Type::Object;
+      this->SkipSpaces();
+      if (m_Position < m_Text.size() && m_Text[m_Position] == '}')
+      {
+        ++m_Position;
+        return value;
+      }
+      for (;;)
+      {
+        this->SkipSpaces();
+        std::string key = this->ParseString();
+        this->Expect(':');
+        value.object.emplace_back(std::move(key), this->ParseValue());
+        this->SkipSpaces();
+        if (this->Consume("}"))
+        {
+          return value;
+        }
+        this->Expect(',');
+      }
+    }
+    if (first == '[')
+    {
+      ++m_Position;
+      value.type = JsonValue::Type::Array;
+      this->SkipSpaces();
+      if (m_Position < m_Text.size() && m_Text[m_Position] == ']')
+      {
+        ++m_Position;
+        return value;
+      }
+      for (;;)
+      {
+        value.array.push_back(this->ParseValue());
+        this->SkipSpaces();
+        if (this->Consume("]"))
+        {
+          return value;
+        }
+        this->Expect(',');
+      }
+    }
+    if (first == '"')
+    {
+      value.type = JsonValue::Type::String;
+      value.string = this->ParseString();
+      return value;
+    }
+    if (this->Consume("true"))
+    {
+      value.type = JsonValue::Type::Boolean;
+      value.boolean = true;
+      return value;
+    }
+    if (this->Consume("false"))
+    {
+      value.type = JsonValue::Type::Boolean;
+      return value;
+    }
+    if (this->Consume("null"))
+    {
+      return value;
+    }
+
+    value.type = JsonValue::Type::Number;
+    if (this->Consume("NaN"))
+    {
+      value.number = std::numeric_limits<double>::quiet_NaN();
+    }
+    else if (this->Consume("Infinity"))
+    {
+      value.number = std::numeric_limits<double>::infinity();
+    }
+    else if (this->Consume("-Infinity"))
+    {
+      value.number = -std::numeric_limits<double>::infinity();
+    }
+    else
+    {
+      const size_t begin = m_Position;
+      while (m_Position < m_Text.size() && m_Text[m_Position] != '\0' &&
+             std::strchr("+-0123456789.eE", m_Text[m_Position]) != nullptr)
+      {
+        ++m_Position;
+      }
+      std::istringstream number(m_Text.substr(begin, m_Position - begin));
+      number.imbue(std::locale::classic());
+      if (begin == m_Position || !(number >> value.number) || number.peek() != std::char_traits<char>::eof())
+      {
+        m_Position = begin;
+        this->Fail("invalid value");
+      }
+    }
+    return value;
+  }
+
+  void
+  AppendUtf8(std::string & string, unsigned long codePoint) const
+  {
+    if (codePoint < 0x80)
+    {
+      string += static_cast<char>(codePoint);
+    }
+    else if (codePoint < 0x800)
+    {
+      string += static_cast<char>(0xC0 | (codePoint >> 6));
+      string += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint < 0x10000)
+    {
+      string += static_cast<char>(0xE0 | (codePoint >> 12));
+      string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      string += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+      string += static_cast<char>(0xF0 | (codePoint >> 18));
+      string += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+      string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      string += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+  }
+
+  unsigned long
+  ParseHexadecimal()
+  {
+    if (m_Position + 4 > m_Text.size())
+    {
+      this->Fail("truncated escape sequence");
+    }
+    unsigned long codePoint = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      const char digit = m_Text[m_Position++];
+      codePoint <<= 4;
+      if (digit >= '0' && digit <= '9')
+      {
+        codePoint |= static_cast<unsigned long>(digit - '0');
+      }
+      else if (digit >= 'a' && digit <= 'f')
+      {
+        codePoint |= static_cast<unsigned long>(digit - 'a' + 10);
+      }
+      else if (digit >= 'A' && digit <= 'F')
+      {
+        codePoint |= static_cast<unsigned long>(digit - 'A' + 10);
+      }
+      else
+      {
+        this->Fail("invalid escape sequence");
+      }
+    }
+    return codePoint;
+  }
+
+  std::string
+  ParseString()
+  {
+    if (m_Position >= m_Text.size() || m_Text[m_Position] != '"')
+    {
+      this->Fail("expected a string");
+    }
+    ++m_Position;
+
+    std::string string;
+    for (;;)
+    {
+      if (m_Position >= m_Text.size())
+      {
+        this->Fail("unterminated string");
+      }
+      const char character = m_Text[m_Position++];
+      if (character == '"')
+      {
+        return string;
+      }
+      if (character != '\\')
+      {
+        string += character;
+        continue;
+      }
+      if (m_Position >= m_Text.size())
+      {
+        this->Fail("unterminated string");
+      }
+      const char escaped = m_Text[m_Position++];
+      switch (escaped)
+      {
+        case '"':
+        case '\\':
+        case '/':
+          string += escaped;
+          break;
+        case 'b':
+          string += '\b';
+          break;
+        case 'f':
+          string += '\f';
+          break;
+        case 'n':
+          string += '\n';
+          break;
+        case 'r':
+          string += '\r';
+          break;
+        case 't':
+          string += '\t';
+          break;
+        case 'u':
+        {
+          unsigned long codePoint = this->ParseHexadecimal();
+          // A surrogate pair encodes a code point above the basic plane
+          if (codePoint >= 0xD800 && codePoint < 0xDC00 && this->Consume("\\u"))
+          {
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (this->ParseHexadecimal() - 0xDC00);
+          }
+          this->AppendUtf8(string, codePoint);
+          break;
+        }
+        default:
+          this->Fail("invalid escape sequence");
+      }
+    }
+  }
+
+  const std::string & m_Text;
+  const std::string & m_FileName;
+  size_t              m_Position{ 0 };
+};
+
+void
+WriteJsonString(std::ostream & os, const std::string & string)
+{
+  os << '"';
+  for (const char character : string)
+  {
+    switch (character)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\r':
+        os << "\\r";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(character) < 0x20)
+        {
+          const char * hexadecimal = "0123456789abcdef";
+          os << "\\u00" << hexadecimal[(character >> 4) & 0xF] << hexadecimal[character & 0xF];
+        }
+        else
+        {
+          os << character;
+        }
+    }
+  }
+  os << '"';
+}
+
+// Write a JSON value, an object member or array element per line, except
+// for the arrays without objects, on a single line.
+void
+WriteJson(std::ostream & os, const JsonValue & value, unsigned int indent)
+{
+  switch (value.type)
+  {
+    case JsonValue::Type::Null:
+      os << "null";
+      break;
+    case JsonValue::Type::Boolean:
+      os << (value.boolean ? "true" : "false");
+      break;
+    case JsonValue::Type::Number:
+      if (!std::isfinite(value.number))
+      {
+        os << "null";
+      }
+      else if (value.number == std::floor(value.number) && std::abs(value.number) < 9007199254740992.0)
+      {
+        os << static_cast<std::int64_t>(value.number);
+      }
+      else
+      {
+        os << value.number;
+      }
+      break;
+    case JsonValue::Type::String:
+      WriteJsonString(os, value.string);
+      break;
+    case JsonValue::Type::Array:
+    {
+      const bool hasObjects = std::any_of(value.array.cbegin(), value.array.cend(), [](const JsonValue & element) {
+        return element.type == JsonValue::Type::Object;
+      });
+      if (!hasObjects)
+      {
+        os << '[';
+        for (size_t i = 0; i < value.array.size(); ++i)
+        {
+          os << (i == 0 ? "" : ", ");
+          WriteJson(os, value.array[i], indent);
+        }
+        os << ']';
+        break;
+      }
+      os << "[\n";
+      for (size_t i = 0; i < value.array.size(); ++i)
+      {
+        os << std::string(indent + 2, ' ');
+        WriteJson(os, value.array[i], indent + 2);
+        os << (i + 1 < value.array.size() ? ",\n" : "\n");
+      }
+      os << std::string(indent, ' ') << ']';
+      break;
+    }
+    case JsonValue::Type::Object:
+    {
+      if (value.object.empty())
+      {
+        os << "{}";
+        break;
+      }
+      os << "{\n";
+      for (size_t i = 0; i < value.object.size(); ++i)
+      {
+        os << std::string(indent + 2, ' ');
+        WriteJsonString(os, value.object[i].first);
+        os << ": ";
+        WriteJson(os, value.object[i].second, indent + 2);
+        os << (i + 1 < value.object.size() ? ",\n" : "\n");
+      }
+      os << std::string(indent, ' ') << '}';
+      break;
+    }
+  }
+}
+
+JsonValue
+ReadJsonFile(const std::string & fileName)
+{
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName);
+  }
+  std::ostringstream text;
+  text << file.rdbuf();
+  return JsonParser(text.str(), fileName).Parse();
+}
+
+void
+WriteJsonFile(const std::string & fileName, const JsonValue & value)
+{
+  std::ostringstream text;
+  text.imbue(std::locale::classic());
+  text.precision(17);
+  WriteJson(text, value, 0);
+  text << '\n';
+
+  std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  file << text.str();
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot write " << fileName);
+  }
+}
+
+// The member of a metadata object, which must be present.
+const JsonValue &
+GetMember(const JsonValue & object, const std::string & key, JsonValue::Type type)
+{
+  const JsonValue * member = object.Find(key);
+  if (member == nullptr || member->type != type)
+  {
+    itkGenericExceptionMacro("Missing or invalid \"" << key << "\" in the Zarr metadata");
+  }
+  return *member;
+}
+
+template <typename TNumber>
+std::vector<TNumber>
+GetNumbers(const JsonValue & value, const std::string & key)
+{
+  std::vector<TNumber> numbers;
+  if (value.type != JsonValue::Type::Array)
+  {
+    itkGenericExceptionMacro("Invalid \"" << key << "\" in the Zarr metadata");
+  }
+  for (const JsonValue & element : value.array)
+  {
+    if (element.type != JsonValue::Type::Number || (std::is_integral<TNumber>::value && element.number < 0))
+    {
+      itkGenericExceptionMacro("Invalid \"" << key << "\" in the Zarr metadata");
+    }
+    numbers.push_back(static_cast<TNumber>(element.number));
+  }
+  return numbers;
+}
+
+bool
+IsFile(const std::string & fileName)
+{
+  return itksys::SystemTools::FileExists(fileName, true);
+}
+
+// Whether a directory holds a Zarr array or group.
+bool
+IsZarrDirectory(const std::string & path)
+{
+  return IsFile(path + ArrayMetadataFile) || IsFile(path + GroupMetadataFile) || IsFile(path + V3MetadataFile);
+}
+
+// Whether a directory holds a single Zarr array, rather than a group which
+// may hold several arrays.
+bool
+IsZarrArrayDirectory(const std::string & path)
+{
+  if (IsFile(path + GroupMetadataFile))
+  {
+    return false;
+  }
+  if (IsFile(path + ArrayMetadataFile))
+  {
+    return true;
+  }
+  if (!IsFile(path + V3MetadataFile))
+  {
+    return false;
+  }
+  try
+  {
+    const JsonValue   metadata = ReadJsonFile(path + V3MetadataFile);
+    const JsonValue * nodeType = metadata.Find("node_type");
+    return nodeType != nullptr && nodeType->type == JsonValue::Type::String && nodeType->string == "array";
+  }
+  catch (const ExceptionObject &)
+  {
+    return false;
+  }
+}
+
+// Process the chunks on dedicated threads, the calling thread being one of
+// them, rather than on the pool of the MultiThreaderBase: the ImageIO may be
+// used by a task of the pool, which must not wait on other tasks of it.
+void
+ProcessChunks(size_t numberOfChunks, unsigned int numberOfThreads, const std::function<void(size_t)> & processChunk)
+{
+  std::atomic<size_t> nextChunk{ 0 };
+  const auto          processNextChunks = [&]() {
+    for (size_t k = nextChunk++; k < numberOfChunks; k = nextChunk++)
+    {
+      processChunk(k);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < std::min<size_t>(numberOfThreads, numberOfChunks); ++t)
+  {
+    try
+    {
+      threads.emplace_back(processNextChunks);
+    }
+    catch (const std::system_error &)
+    {
+      break;
+    }
+  }
+  processNextChunks();
+  for (std::thread & thread : threads)
+  {
+    thread.join();
+  }
+}
+
+// The metadata of an array, and the scale and translation of the
+// multiscale group it belongs to, if any.
+struct ArrayNode
+{
+  std::string         path{};
+  unsigned int        zarrFormat{ 2 };
+  JsonValue           metadata{};
+  JsonValue           attributes{};
+  std::vector<double> scale{};
+  std::vector<double> translation{};
+};
+
+// Find the array stored in a directory, or the full resolution array of
+// an OME-Zarr multiscale group.
+ArrayNode
+FindArray(const std::string & path)
+{
+  ArrayNode node;
+  node.path = path;
+  JsonValue groupAttributes;
+  if (IsFile(path + ArrayMetadataFile))
+  {
+    node.metadata = ReadJsonFile(path + ArrayMetadataFile);
+    if (IsFile(path + AttributesFile))
+    {
+      node.attributes = ReadJsonFile(path + AttributesFile);
+    }
+    return node;
+  }
+  if (IsFile(path + V3MetadataFile))
+  {
+    JsonValue metadata = ReadJsonFile(path + V3MetadataFile);
+    const JsonValue * attributes = metadata.Find("attributes");
+    if (GetMember(metadata, "node_type", JsonValue::Type::String).string == "array")
+    {
+      node.zarrFormat = 3;
+      node.attributes = attributes != nullptr ? *attributes : JsonValue();
+      node.metadata = std::move(metadata);
+      return node;
+    }
+    groupAttributes = attributes != nullptr ? *attributes : JsonValue();
+  }
+  else if (IsFile(path + GroupMetadataFile))
+  {
+    if (IsFile(path + AttributesFile))
+    {
+      groupAttributes = ReadJsonFile(path + AttributesFile);
+    }
+  }
+  else
+  {
+    itkGenericExceptionMacro("No Zarr array or group in " << path);
+  }
+
+  // The first data set of a multiscale image has the full resolution
+  const JsonValue * ome = groupAttributes.Find("ome");
+  const JsonValue * multiscales = (ome != nullptr ? *ome : groupAttributes).Find("multiscales");
+  if (multiscales == nullptr || multiscales->type != JsonValue::Type::Array || multiscales->array.empty())
+  {
+    itkGenericExceptionMacro("The Zarr group " << path << " holds no multiscale image");
+  }
+  const JsonValue & datasets = GetMember(multiscales->array[0], "datasets", JsonValue::Type::Array);
+  if (datasets.array.empty())
+  {
+    itkGenericExceptionMacro("The Zarr group " << path << " holds no multiscale image");
+  }
+  const JsonValue & dataset = datasets.array[0];
+  node = FindArray(path + '/' + GetMember(dataset, "path", JsonValue::Type::String).string);
+
+  const JsonValue * transformations = dataset.Find("coordinateTransformations");
+  if (transformations != nullptr && transformations->type == JsonValue::Type::Array)
+  {
+    for (const JsonValue & transformation : transformations->array)
+    {
+      const JsonValue * type = transformation.Find("type");
+      if (type != nullptr && type->string == "scale" && transformation.Find("scale") != nullptr)
+      {
+        node.scale = GetNumbers<double>(*transformation.Find("scale"), "scale");
+      }
+      else if (type != nullptr && type->string == "translation" && transformation.Find("translation") != nullptr)
+      {
+        node.translation = GetNumbers<double>(*transformation.Find("translation"), "translation");
+      }
+    }
+  }
+  return node;
+}
+
+// The kind of a component type in the Zarr data types: 'u', 'i' or 'f'.
+char
+GetComponentKind(IOComponentEnum componentType)
+{
+  switch (componentType)
+  {
+    case IOComponentEnum::UCHAR:
+    case IOComponentEnum::USHORT:
+    case IOComponentEnum::UINT:
+    case IOComponentEnum::ULONG:
+    case IOComponentEnum::ULONGLONG:
+      return 'u';
+    case IOComponentEnum::CHAR:
+    case IOComponentEnum::SHORT:
+    case IOComponentEnum::INT:
+    case IOComponentEnum::LONG:
+    case IOComponentEnum::LONGLONG:
+      return 'i';
+    case IOComponentEnum::FLOAT:
+    case IOComponentEnum::DOUBLE:
+      return 'f';
+    default:
+      return '\0';
+  }
+}
+
+IOComponentEnum
+ToComponentType(char kind, unsigned int size)
+{
+  if (kind == 'f')
+  {
+    if (size == 4 || size == 8)
+    {
+      return size == 4 ? IOComponentEnum::FLOAT : IOComponentEnum::DOUBLE;
+    }
+    return IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+  }
+  if (kind != 'u' && kind != 'i')
+  {
+    return IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+  }
+  const bool isUnsigned = kind == 'u';
+  switch (size)
+  {
+    case 1:
+      return isUnsigned ? IOComponentEnum::UCHAR : IOComponentEnum::CHAR;
+    case 2:
+      return isUnsigned ? IOComponentEnum::USHORT : IOComponentEnum::SHORT;
+    case 4:
+      return isUnsigned ? IOComponentEnum::UINT : IOComponentEnum::INT;
+    case 8:
+      // The type of 64 bits written by an image of long is read back as
+      // long where it has 64 bits, for the pasting in an existing array
+      if (sizeof(long) == 8)
+      {
+        return isUnsigned ? IOComponentEnum::ULONG : IOComponentEnum::LONG;
+      }
+      return isUnsigned ? IOComponentEnum::ULONGLONG : IOComponentEnum::LONGLONG;
+    default:
+      return IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+  }
+}
+
+template <typename TComponent>
+void
+AppendFillComponents(double fillValue, unsigned int numberOfComponents, std::vector<char> & element)
+{
+  TComponent component{};
+  if (std::is_floating_point<TComponent>::value || std::isfinite(fillValue))
+  {
+    component = static_cast<TComponent>(fillValue);
+  }
+  for (unsigned int i = 0; i < numberOfComponents; ++i)
+  {
+    const auto * bytes = reinterpret_cast<const char *>(&component);
+    element.insert(element.end(), bytes, bytes + sizeof(TComponent));
+  }
+}
+
+// The bytes of a pixel whose components hold the fill value, in the
+// byte order of the system.
+std::vector<char>
+GetFillElement(IOComponentEnum componentType, unsigned int numberOfComponents, double fillValue)
+{
+  std::vector<char> element;
+  switch (componentType)
+  {
+    case IOComponentEnum::UCHAR:
+      AppendFillComponents<unsigned char>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::CHAR:
+      AppendFillComponents<signed char>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::USHORT:
+      AppendFillComponents<unsigned short>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::SHORT:
+      AppendFillComponents<short>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::UINT:
+      AppendFillComponents<unsigned int>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::INT:
+      AppendFillComponents<int>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::ULONG:
+      AppendFillComponents<unsigned long>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::LONG:
+      AppendFillComponents<long>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::ULONGLONG:
+      AppendFillComponents<unsigned long long>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::LONGLONG:
+      AppendFillComponents<long long>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::FLOAT:
+      AppendFillComponents<float>(fillValue, numberOfComponents, element);
+      break;
+    case IOComponentEnum::DOUBLE:
+      AppendFillComponents<double>(fillValue, numberOfComponents, element);
+      break;
+    default:
+      break;
+  }
+  return element;
+}
+
+double
+GetFillValue(const JsonValue * fillValue)
+{
+  if (fillValue == nullptr || fillValue->type == JsonValue::Type::Null)
+  {
+    return 0.0;
+  }
+  if (fillValue->type == JsonValue::Type::Number)
+  {
+    return fillValue->number;
+  }
+  if (fillValue->type == JsonValue::Type::Boolean)
+  {
+    return fillValue->boolean ? 1.0 : 0.0;
+  }
+  if (fillValue->type == JsonValue::Type::String)
+  {
+    if (fillValue->string == "NaN")
+    {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (fillValue->string == "Infinity")
+    {
+      return std::numeric_limits<double>::infinity();
+    }
+    if (fillValue->string == "-Infinity")
+    {
+      return -std::numeric_limits<double>::infinity();
+    }
+  }
+  itkGenericExceptionMacro("Unsupported fill value in the Zarr metadata");
+}
+
+// A region of the array, in array (slowest moving first) order.
+struct Slab
+{
+  std::vector<SizeValueType> offset;
+  std::vector<SizeValueType> count;
+};
+
+Slab
+RegionToSlab(const ImageIORegion & region, unsigned int numberOfDimensions)
+{
+  Slab slab{ std::vector<SizeValueType>(numberOfDimensions, 0), std::vector<SizeValueType>(numberOfDimensions, 1) };
+  for (unsigned int i = 0; i < numberOfDimensions && i < region.GetImageDimension(); ++i)
+  {
+    slab.offset[numberOfDimensions - 1 - i] = static_cast<SizeValueType>(region.GetIndex(i));
+    slab.count[numberOfDimensions - 1 - i] = region.GetSize(i);
+  }
+  return slab;
+}
+
+// The indices of the chunks overlapping a slab, in storage order.
+std::vector<std::vector<SizeValueType>>
+OverlappingChunks(const std::vector<SizeValueType> & chunkDims, const Slab & slab)
+{
+  const size_t               rank = chunkDims.size();
+  std::vector<SizeValueType> first(rank);
+  std::vector<SizeValueType> last(rank);
+  for (size_t d = 0; d < rank; ++d)
+  {
+    first[d] = slab.offset[d] / chunkDims[d];
+    last[d] = (slab.offset[d] + slab.count[d] - 1) / chunkDims[d];
+  }
+
+  std::vector<std::vector<SizeValueType>> chunks;
+  std::vector<SizeValueType>              index = first;
+  for (;;)
+  {
+    chunks.push_back(index);
+    size_t d = rank;
+    for (; d > 0; --d)
+    {
+      if (index[d - 1] < last[d - 1])
+      {
+        ++index[d - 1];
+        break;
+      }
+      index[d - 1] = first[d - 1];
+    }
+    if (d == 0)
+    {
+      return chunks;
+    }
+  }
+}
+
+// Copy the part of a chunk overlapping a slab from the chunk buffer to
+// the slab buffer, or the other way round.
+void
+CopyChunkOverlap(const std::vector<SizeValueType> & chunkIndex,
+                 const std::vector<SizeValueType> & chunkDims,
+                 const Slab &                       slab,
+                 size_t                             elementSize,
+                 char *                             chunk,
+                 char *                             slabBuffer,
+                 bool                               toChunk)
+{
+  const size_t               rank = chunkDims.size();
+  std::vector<SizeValueType> chunkOffset(rank);
+  std::vector<SizeValueType> begin(rank);
+  std::vector<SizeValueType> end(rank);
+  for (size_t d = 0; d < rank; ++d)
+  {
+    chunkOffset[d] = chunkIndex[d] * chunkDims[d];
+    begin[d] = std::max(chunkOffset[d], slab.offset[d]);
+    end[d] = std::min(chunkOffset[d] + chunkDims[d], slab.offset[d] + slab.count[d]);
+  }
+  const size_t runBytes = (end[rank - 1] - begin[rank - 1]) * elementSize;
+
+  // Copy the overlap run by run along the fastest moving dimension
+  std::vector<SizeValueType> position = begin;
+  for (;;)
+  {
+    size_t chunkPosition = 0;
+    size_t slabPosition = 0;
+    for (size_t d = 0; d < rank; ++d)
+    {
+      chunkPosition = chunkPosition * chunkDims[d] + (position[d] - chunkOffset[d]);
+      slabPosition = slabPosition * slab.count[d] + (position[d] - slab.offset[d]);
+    }
+    if (toChunk)
+    {
+      std::memcpy(chunk + chunkPosition * elementSize, slabBuffer + slabPosition * elementSize, runBytes);
+    }
+    else
+    {
+      std::memcpy(slabBuffer + slabPosition * elementSize, chunk + chunkPosition * elementSize, runBytes);
+    }
+
+    size_t d = rank - 1;
+    for (; d > 0; --d)
+    {
+      if (++position[d - 1] < end[d - 1])
+      {
+        break;
+      }
+      position[d - 1] = begin[d - 1];
+    }
+    if (d == 0)
+    {
+      return;
+    }
+  }
+}
+
+// Decodes and encodes the chunks of an array. A chunk holds its pixels
+// in the byte order of the system once decoded.
+struct ChunkCoder
+{
+  std::string       codec;
+  int               level;
+  unsigned int      componentSize;
+  bool              isBigEndian;
+  size_t            chunkBytes;
+  std::vector<char> fillElement;
+
+  void
+  Fill(std::vector<char> & chunk) const
+  {
+    chunk.resize(chunkBytes);
+    for (size_t position = 0; position < chunkBytes; position += fillElement.size())
+    {
+      std::memcpy(chunk.data() + position, fillElement.data(), fillElement.size());
+    }
+  }
+
+  // Swap the bytes of the components between the stored byte order and
+  // the one of the system, which is its own inverse.
+  void
+  SwapBytes(std::vector<char> & chunk) const
+  {
+    const SizeValueType numberOfComponents = chunk.size() / componentSize;
+    switch (componentSize)
+    {
+      case 2:
+        isBigEndian ? ByteSwapper<uint16_t>::SwapRangeFromSystemToBigEndian(
+                        reinterpret_cast<uint16_t *>(chunk.data()), numberOfComponents)
+                    : ByteSwapper<uint16_t>::SwapRangeFromSystemToLittleEndian(
+                        reinterpret_cast<uint16_t *>(chunk.data()), numberOfComponents);
+        break;
+      case 4:
+        isBigEndian ? ByteSwapper<uint32_t>::SwapRangeFromSystemToBigEndian(
+                        reinterpret_cast<uint32_t *>(chunk.data()), numberOfComponents)
+                    : ByteSwapper<uint32_t>::SwapRangeFromSystemToLittleEndian(
+                        reinterpret_cast<uint32_t *>(chunk.data()), numberOfComponents);
+        break;
+      case 8:
+        isBigEndian ? ByteSwapper<uint64_t>::SwapRangeFromSystemToBigEndian(
+                        reinterpret_cast<uint64_t *>(chunk.data()), numberOfComponents)
+                    : ByteSwapper<uint64_t>::SwapRangeFromSystemToLittleEndian(
+                        reinterpret_cast<uint64_t *>(chunk.data()), numberOfComponents);
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Read and decode a chunk, which holds the fill value when its file
+  // is missing.
+  void
+  Load(const std::string & fileName, std::vector<char> & chunk) const
+  {
+    if (!IsFile(fileName))
+    {
+      this->Fill(chunk);
+      return;
+    }
+
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    std::vector<char> stored;
+    if (file)
+    {
+      file.seekg(0, std::ios::end);
+      stored.resize(static_cast<size_t>(file.tellg()));
+      file.seekg(0, std::ios::beg);
+      file.read(stored.data(), static_cast<std::streamsize>(stored.size()));
+    }
+    if (!file)
+    {
+      itkGenericExceptionMacro("Cannot read the chunk " << fileName);
+    }
+
+    if (codec.empty())
+    {
+      chunk = std::move(stored);
+    }
+    else
+    {
+      // Both the zlib and the gzip streams are detected
+      chunk.resize(chunkBytes);
+      z_stream stream{};
+      stream.next_in = reinterpret_cast<Bytef *>(stored.data());
+      stream.avail_in = static_cast<uInt>(stored.size());
+      stream.next_out = reinterpret_cast<Bytef *>(chunk.data());
+      stream.avail_out = static_cast<uInt>(chunk.size());
+      bool isDecoded = inflateInit2(&stream, 15 + 32) == Z_OK;
+      isDecoded = isDecoded && inflate(&stream, Z_FINISH) == Z_STREAM_END;
+      isDecoded = inflateEnd(&stream) == Z_OK && isDecoded;
+      if (!isDecoded)
+      {
+        itkGenericExceptionMacro("Cannot decompress the chunk " << fileName);
+      }
+      chunk.resize(stream.total_out);
+    }
+    if (chunk.size() != chunkBytes)
+    {
+      itkGenericExceptionMacro("The chunk " << fileName << " has " << chunk.size() << " bytes instead of "
+                                            << chunkBytes);
+    }
+    this->SwapBytes(chunk);
+  }
+
+  // Encode and write a chunk, whose buffer is modified.
+  void
+  Store(const std::string & fileName, std::vector<char> & chunk) const
+  {
+    this->SwapBytes(chunk);
+
+    std::vector<char> encoded;
+    if (!codec.empty())
+    {
+      encoded.resize(compressBound(static_cast<uLong>(chunk.size())) + 32);
+      z_stream stream{};
+      stream.next_in = reinterpret_cast<Bytef *>(chunk.data());
+      stream.avail_in = static_cast<uInt>(chunk.size());
+      stream.next_out = reinterpret_cast<Bytef *>(encoded.data());
+      stream.avail_out = static_cast<uInt>(encoded.size());
+      const int windowBits = codec == "gzip" ? 15 + 16 : 15;
+      bool      isEncoded = deflateInit2(&stream, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+      isEncoded = isEncoded && deflate(&stream, Z_FINISH) == Z_STREAM_END;
+      isEncoded = deflateEnd(&stream) == Z_OK && isEncoded;
+      if (!isEncoded)
+      {
+        itkGenericExceptionMacro("Cannot compress the chunk " << fileName);
+      }
+      encoded.resize(stream.total_out);
+    }
+    const std::vector<char> & stored = codec.empty() ? chunk : encoded;
+
+    std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(stored.data(), static_cast<std::streamsize>(stored.size()));
+    if (!file)
+    {
+      itkGenericExceptionMacro("Cannot write the chunk " << fileName);
+    }
+  }
+};
+} // namespace
+
+ZarrImageIO::ZarrImageIO()
+{
+  this->AddSupportedWriteExtension(".zarr");
+  this->AddSupportedReadExtension(".zarr");
+
+  this->Self::SetCompressor("");
+  this->Self::SetMaximumCompressionLevel(9);
+  this->Self::SetCompressionLevel(5);
+}
+
+ZarrImageIO::~ZarrImageIO() = default;
+
+LightObject::Pointer
+ZarrImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_ChunkSize = m_ChunkSize;
+  rval->m_ZarrFormat = m_ZarrFormat;
+  rval->m_NumberOfWorkUnits = m_NumberOfWorkUnits;
+  rval->m_CompressorCodec = m_CompressorCodec;
+  return loPtr;
+}
+
+void
+ZarrImageIO::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ChunkSize: ";
+  for (const SizeValueType extent : m_ChunkSize)
+  {
+    os << extent << ' ';
+  }
+  os << std::endl;
+  os << indent << "ZarrFormat: " << m_ZarrFormat << std::endl;
+  os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
+  os << indent << "ArrayPath: " << m_ArrayPath << std::endl;
+  os << indent << "Codec: " << (m_Codec.empty() ? "(none)" : m_Codec) << std::endl;
+}
+
+ImageIOBase::SizeType
+ZarrImageIO::GetHeaderSize() const
+{
+  return 0;
+}
+
+void
+ZarrImageIO::InternalSetCompressor(const std::string & _compressor)
+{
+  if (_compressor.empty() || _compressor == "ZLIB")
+  {
+    m_CompressorCodec = "zlib";
+  }
+  else if (_compressor == "GZIP")
+  {
+    m_CompressorCodec = "gzip";
+  }
+  else
+  {
+    this->Superclass::InternalSetCompressor(_compressor);
+  }
+}
+
+bool
+ZarrImageIO::CanReadFile(const char * filename)
+{
+  if (filename == nullptr || !itksys::SystemTools::FileIsDirectory(filename) || !IsZarrDirectory(filename))
+  {
+    return false;
+  }
+
+  // A group must hold a multiscale image, and an array a supported one
+  try
+  {
+    auto imageIO = Self::New();
+    imageIO->SetFileName(filename);
+    imageIO->ReadImageInformation();
+  }
+  catch (const ExceptionObject &)
+  {
+    return false;
+  }
+  return true;
+}
+
+void
+ZarrImageIO::ReadImageInformation()
+{
+  const ArrayNode node = FindArray(m_FileName);
+
+  std::vector<SizeValueType> shape = GetNumbers<SizeValueType>(node.metadata.Find("shape") != nullptr
+                                                                 ? *node.metadata.Find("shape")
+                                                                 : JsonValue(),
+                                                               "shape");
+  std::vector<SizeValueType> chunks;
+  std::string                dataType;
+  char                       kind = '\0';
+  unsigned int               componentSize = 0;
+
+  m_ArrayPath = node.path;
+  m_Codec.clear();
+  m_CodecLevel = 0;
+  m_IsBigEndian = false;
+  m_FillValue = GetFillValue(node.metadata.Find("fill_value"));
+
+  if (node.zarrFormat == 2)
+  {
+    chunks = GetNumbers<SizeValueType>(GetMember(node.metadata, "chunks", JsonValue::Type::Array), "chunks");
+    dataType = GetMember(node.metadata, "dtype", JsonValue::Type::String).string;
+    if (dataType.size() < 3 || (dataType[0] != '<' && dataType[0] != '>' && dataType[0] != '|'))
+    {
+      itkExceptionMacro("Unsupported data type " << dataType << " in " << m_ArrayPath);
+    }
+    m_IsBigEndian = dataType[0] == '>';
+    kind = dataType[1];
+    componentSize = static_cast<unsigned int>(std::atoi(dataType.c_str() + 2));
+
+    const JsonValue * order = node.metadata.Find("order");
+    if (order != nullptr && order->string != "C")
+    {
+      itkExceptionMacro("Only the arrays in C order are supported: " << m_ArrayPath);
+    }
+    const JsonValue * filters = node.metadata.Find("filters");
+    if (filters != nullptr && !(filters->type == JsonValue::Type::Null || filters->array.empty()))
+    {
+      itkExceptionMacro("The filters of " << m_ArrayPath << " are not supported");
+    }
+    const JsonValue * compressor = node.metadata.Find("compressor");
+    if (compressor != nullptr && compressor->type == JsonValue::Type::Object)
+    {
+      m_Codec = GetMember(*compressor, "id", JsonValue::Type::String).string;
+      const JsonValue * level = compressor->Find("level");
+      m_CodecLevel = level != nullptr ? static_cast<int>(level->number) : 0;
+    }
+    const JsonValue * separator = node.metadata.Find("dimension_separator");
+    m_ChunkKeyPrefix.clear();
+    m_ChunkKeySeparator = separator != nullptr && separator->string == "/" ? '/' : '.';
+  }
+  else
+  {
+    const JsonValue & chunkGrid = GetMember(node.metadata, "chunk_grid", JsonValue::Type::Object);
+    if (GetMember(chunkGrid, "name", JsonValue::Type::String).string != "regular")
+    {
+      itkExceptionMacro("Only the regular chunk grids are supported: " << m_ArrayPath);
+    }
+    chunks = GetNumbers<SizeValueType>(
+      GetMember(GetMember(chunkGrid, "configuration", JsonValue::Type::Object), "chunk_shape", JsonValue::Type::Array),
+      "chunk_shape");
+
+    // The default encoding of the chunk keys is "c/0/1", and the one of
+    // version 2 is "0.1"
+    m_ChunkKeyPrefix = "c";
+    m_ChunkKeySeparator = '/';
+    const JsonValue * keyEncoding = node.metadata.Find("chunk_key_encoding");
+    if (keyEncoding != nullptr)
+    {
+      const JsonValue * configuration = keyEncoding->Find("configuration");
+      const JsonValue * separator = configuration != nullptr ? configuration->Find("separator") : nullptr;
+      if (GetMember(*keyEncoding, "name", JsonValue::Type::String).string == "v2")
+      {
+        m_ChunkKeyPrefix.clear();
+        m_ChunkKeySeparator = '.';
+      }
+      if (separator != nullptr && !separator->string.empty())
+      {
+        m_ChunkKeySeparator = separator->string[0];
+      }
+    }
+
+    dataType = GetMember(node.metadata, "data_type", JsonValue::Type::String).string;
+    for (const char * name : { "uint", "int", "float" })
+    {
+      if (dataType.compare(0, std::strlen(name), name) == 0)
+      {
+        kind = name[0] == 'f' ? 'f' : name[0] == 'u' ? 'u' : 'i';
+        componentSize = static_cast<unsigned int>(std::atoi(dataType.c_str() + std::strlen(name))) / 8;
+        break;
+      }
+    }
+
+    for (const JsonValue & codec : GetMember(node.metadata, "codecs", JsonValue::Type::Array).array)
+    {
+      const std::string &     name = GetMember(codec, "name", JsonValue::Type::String).string;
+      const JsonValue *       configuration = codec.Find("configuration");
+      static const JsonValue  noConfiguration;
+      const JsonValue &       options = configuration != nullptr ? *configuration : noConfiguration;
+      const JsonValue * const level = options.Find("level");
+      if (name == "bytes")
+      {
+        const JsonValue * endian = options.Find("endian");
+        m_IsBigEndian = endian != nullptr && endian->string == "big";
+      }
+      else if ((name == "gzip" || name == "zlib" || name == "numcodecs.zlib") && m_Codec.empty())
+      {
+        m_Codec = name == "gzip" ? "gzip" : "zlib";
+        m_CodecLevel = level != nullptr ? static_cast<int>(level->number) : 0;
+      }
+      else
+      {
+        itkExceptionMacro("The codec " << name << " of " << m_ArrayPath << " is not supported");
+      }
+    }
+  }
+
+  if (m_Codec != "" && m_Codec != "zlib" && m_Codec != "gzip")
+  {
+    itkExceptionMacro("The compressor " << m_Codec << " of " << m_ArrayPath << " is not supported");
+  }
+  const IOComponentEnum componentType = ToComponentType(kind, componentSize);
+  if (componentType == IOComponentEnum::UNKNOWNCOMPONENTTYPE)
+  {
+    itkExceptionMacro("Unsupported data type " << dataType << " in " << m_ArrayPath);
+  }
+  if (chunks.size() != shape.size() || shape.empty() ||
+      std::find(chunks.cbegin(), chunks.cend(), SizeValueType{ 0 }) != chunks.cend())
+  {
+    itkExceptionMacro("Invalid shape or chunk shape in " << m_ArrayPath);
+  }
+
+  // The attributes written by ITK hold the geometry of the image, whose
+  // pixel components are the last axis of the array
+  static const JsonValue noAttributes;
+  const JsonValue *      itkAttributes = node.attributes.Find(ItkAttribute);
+  const JsonValue &      attributes = itkAttributes != nullptr ? *itkAttributes : noAttributes;
+  const JsonValue *      numberOfComponentsValue = attributes.Find("numberOfComponents");
+  const unsigned int     numberOfComponents =
+    numberOfComponentsValue != nullptr ? static_cast<unsigned int>(numberOfComponentsValue->number) : 1;
+  if (numberOfComponents > 1)
+  {
+    if (shape.size() < 2 || shape.back() != numberOfComponents || chunks.back() != numberOfComponents)
+    {
+      itkExceptionMacro("The components of the pixels of " << m_ArrayPath << " must be the last axis, in one chunk");
+    }
+    shape.pop_back();
+    chunks.pop_back();
+  }
+
+  const auto numberOfDimensions = static_cast<unsigned int>(shape.size());
+  this->SetNumberOfDimensions(numberOfDimensions);
+  this->SetComponentType(componentType);
+  this->SetNumberOfComponents(std::max(1U, numberOfComponents));
+  this->SetPixelType(numberOfComponents > 1 ? IOPixelEnum::VECTOR : IOPixelEnum::SCALAR);
+  const JsonValue * pixelType = attributes.Find("pixelType");
+  if (pixelType != nullptr && pixelType->type == JsonValue::Type::String)
+  {
+    this->SetPixelType(ImageIOBase::GetPixelTypeFromString(pixelType->string));
+  }
+
+  m_StoredChunkSize.assign(chunks.rbegin(), chunks.rend());
+  const JsonValue *   spacingValue = attributes.Find("spacing");
+  const JsonValue *   originValue = attributes.Find("origin");
+  const JsonValue *   directionValue = attributes.Find("direction");
+  std::vector<double> spacing = spacingValue != nullptr ? GetNumbers<double>(*spacingValue, "spacing") : node.scale;
+  std::vector<double> origin =
+    originValue != nullptr ? GetNumbers<double>(*originValue, "origin") : node.translation;
+  if (spacingValue == nullptr)
+  {
+    std::reverse(spacing.begin(), spacing.end());
+  }
+  if (originValue == nullptr)
+  {
+    std::reverse(origin.begin(), origin.end());
+  }
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    this->SetDimensions(i, shape[numberOfDimensions - 1 - i]);
+    this->SetSpacing(i, spacing.size() == numberOfDimensions ? spacing[i] : 1.0);
+    this->SetOrigin(i, origin.size() == numberOfDimensions ? origin[i] : 0.0);
+
+    std::vector<double> axis(numberOfDimensions, 0.0);
+    axis[i] = 1.0;
+    if (directionValue != nullptr && directionValue->type == JsonValue::Type::Array &&
+        directionValue->array.size() == numberOfDimensions)
+    {
+      std::vector<double> direction = GetNumbers<double>(directionValue->array[i], "direction");
+      if (direction.size() == numberOfDimensions)
+      {
+        axis = std::move(direction);
+      }
+    }
+    this->SetDirection(i, axis);
+  }
+
+  MetaDataDictionary & dictionary = this->GetMetaDataDictionary();
+  dictionary.Clear();
+  const JsonValue * metaData = attributes.Find("metaData");
+  if (metaData != nullptr)
+  {
+    for (const auto & entry : metaData->object)
+    {
+      if (entry.second.type == JsonValue::Type::String)
+      {
+        EncapsulateMetaData<std::string>(dictionary, entry.first, entry.second.string);
+      }
+    }
+  }
+}
+
+std::string
+ZarrImageIO::GetChunkFileName(const std::vector<SizeValueType> & chunkIndex) const
+{
+  std::ostringstream key;
+  key << m_ArrayPath << '/' << m_ChunkKeyPrefix;
+  bool isFirst = m_ChunkKeyPrefix.empty();
+  for (const SizeValueType index : chunkIndex)
+  {
+    key << (isFirst ? "" : std::string(1, m_ChunkKeySeparator)) << index;
+    isFirst = false;
+  }
+  // The components of a pixel are in the first chunk of their axis
+  if (this->GetNumberOfComponents() > 1)
+  {
+    key << (isFirst ? "" : std::string(1, m_ChunkKeySeparator)) << 0;
+  }
+  return key.str();
+}
+
+void
+ZarrImageIO::Read(void * buffer)
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  const Slab         slab = RegionToSlab(this->GetIORegion(), numberOfDimensions);
+  if (std::find(slab.count.cbegin(), slab.count.cend(), SizeValueType{ 0 }) != slab.count.cend())
+  {
+    return;
+  }
+
+  const size_t                     elementSize = this->GetComponentSize() * this->GetNumberOfComponents();
+  const std::vector<SizeValueType> chunkDims(m_StoredChunkSize.rbegin(), m_StoredChunkSize.rend());
+  ChunkCoder                       coder{ m_Codec,
+                    m_CodecLevel,
+                    this->GetComponentSize(),
+                    m_IsBigEndian,
+                    elementSize,
+                    GetFillElement(this->GetComponentType(), this->GetNumberOfComponents(), m_FillValue) };
+  for (const SizeValueType extent : chunkDims)
+  {
+    coder.chunkBytes *= extent;
+  }
+
+  const std::vector<std::vector<SizeValueType>> chunks = OverlappingChunks(chunkDims, slab);
+  std::vector<std::string>                      errors(chunks.size());
+
+  ProcessChunks(
+    chunks.size(),
+    m_NumberOfWorkUnits > 0 ? m_NumberOfWorkUnits : MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
+    [&](size_t k) {
+      try
+      {
+        std::vector<char> chunk;
+        coder.Load(this->GetChunkFileName(chunks[k]), chunk);
+        CopyChunkOverlap(chunks[k], chunkDims, slab, elementSize, chunk.data(), static_cast<char *>(buffer), false);
+      }
+      catch (const ExceptionObject & e)
+      {
+        errors[k] = e.GetDescription();
+      }
+    });
+
+  for (const std::string & error : errors)
+  {
+    if (!error.empty())
+    {
+      itkExceptionMacro(<< error);
+    }
+  }
+}
+
+bool
+ZarrImageIO::CanWriteFile(const char * filename)
+{
+  return filename != nullptr && this->HasSupportedWriteExtension(filename, false);
+}
+
+ZarrImageIO::ChunkSizeType
+ZarrImageIO::ComputeChunkSize() const
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  ChunkSizeType      chunkSize(numberOfDimensions);
+
+  if (!m_ChunkSize.empty())
+  {
+    if (m_ChunkSize.size() != numberOfDimensions)
+    {
+      itkExceptionMacro("The chunk size has " << m_ChunkSize.size() << " extents but the image has "
+                                              << numberOfDimensions << " dimensions");
+    }
+    for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+      chunkSize[i] = std::clamp<SizeValueType>(m_ChunkSize[i], 1, std::max<SizeValueType>(1, m_Dimensions[i]));
+    }
+    return chunkSize;
+  }
+
+  // Halve the largest extent until the chunk fits, which keeps the
+  // chunks close to cubes whatever the region read later.
+  size_t chunkBytes = this->GetComponentSize() * this->GetNumberOfComponents();
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    chunkSize[i] = std::max<SizeValueType>(1, m_Dimensions[i]);
+    chunkBytes *= chunkSize[i];
+  }
+  while (chunkBytes > AutomaticChunkBytes && numberOfDimensions > 0)
+  {
+    const auto largest = std::max_element(chunkSize.begin(), chunkSize.end());
+    if (*largest == 1)
+    {
+      break;
+    }
+    chunkBytes = chunkBytes / *largest * ((*largest + 1) / 2);
+    *largest = (*largest + 1) / 2;
+  }
+  return chunkSize;
+}
+
+void
+ZarrImageIO::RemoveExistingArray()
+{
+  if (itksys::SystemTools::FileIsDirectory(m_FileName))
+  {
+    itksys::Directory directory;
+    directory.Load(m_FileName);
+    // An empty directory only lists "." and "..". A group, like an
+    // OME-Zarr image, may hold other arrays than the one written.
+    if (!IsZarrArrayDirectory(m_FileName) && directory.GetNumberOfFiles() > 2)
+    {
+      itkExceptionMacro("The directory " << m_FileName << " is not a single Zarr array, and is not replaced");
+    }
+    if (!itksys::SystemTools::RemoveADirectory(m_FileName))
+    {
+      itkExceptionMacro("Cannot remove the Zarr array " << m_FileName);
+    }
+  }
+  else if (itksys::SystemTools::FileExists(m_FileName) && !itksys::SystemTools::RemoveFile(m_FileName))
+  {
+    itkExceptionMacro("Cannot remove the file " << m_FileName);
+  }
+}
+
+unsigned int
+ZarrImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  // The superclass removes the file a whole image is streamed to, which
+  // is a directory here
+  if (pasteRegion == largestPossibleRegion && numberOfRequestedSplits != 1)
+  {
+    this->RemoveExistingArray();
+  }
+  return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+}
+
+void
+ZarrImageIO::WriteImageInformation()
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  const unsigned int numberOfComponents = this->GetNumberOfComponents();
+  const char         kind = GetComponentKind(this->GetComponentType());
+  if (kind == '\0' || numberOfDimensions == 0)
+  {
+    itkExceptionMacro("Cannot write an image of " << this->GetComponentTypeAsString(this->GetComponentType())
+                                                  << " components and " << numberOfDimensions
+                                                  << " dimensions as a Zarr array");
+  }
+
+  this->RemoveExistingArray();
+  if (!itksys::SystemTools::MakeDirectory(m_FileName))
+  {
+    itkExceptionMacro("Cannot create the directory " << m_FileName);
+  }
+
+  m_ArrayPath = m_FileName;
+  m_StoredChunkSize = this->ComputeChunkSize();
+  m_Codec = this->GetUseCompression() ? m_CompressorCodec : std::string();
+  m_CodecLevel = this->GetCompressionLevel();
+  m_IsBigEndian = false;
+  m_FillValue = 0.0;
+  m_ChunkKeyPrefix = m_ZarrFormat == 3 ? "c" : "";
+  m_ChunkKeySeparator = m_ZarrFormat == 3 ? '/' : '.';
+
+  // The axes of the array are in the reverse order of the image
+  // dimensions, followed by the components of the pixels
+  std::vector<SizeValueType> shape;
+  std::vector<SizeValueType> chunks;
+  for (unsigned int i = numberOfDimensions; i > 0; --i)
+  {
+    shape.push_back(this->GetDimensions(i - 1));
+    chunks.push_back(m_StoredChunkSize[i - 1]);
+  }
+  if (numberOfComponents > 1)
+  {
+    shape.push_back(numberOfComponents);
+    chunks.push_back(numberOfComponents);
+  }
+
+  JsonValue itkAttributes = MakeJsonObject();
+  itkAttributes.Set("spacing", MakeJsonArray(m_Spacing));
+  itkAttributes.Set("origin", MakeJsonArray(m_Origin));
+  JsonValue direction;
+  direction.type = JsonValue::Type::Array;
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    direction.array.push_back(MakeJsonArray(this->GetDirection(i)));
+  }
+  itkAttributes.Set("direction", std::move(direction));
+  itkAttributes.Set("pixelType", MakeJsonString(ImageIOBase::GetPixelTypeAsString(this->GetPixelType())));
+  itkAttributes.Set("numberOfComponents", MakeJsonNumber(numberOfComponents));
+  JsonValue                  metaData = MakeJsonObject();
+  const MetaDataDictionary & dictionary = this->GetMetaDataDictionary();
+  for (const std::string & key : dictionary.GetKeys())
+  {
+    std::string value;
+    if (ExposeMetaData<std::string>(dictionary, key, value))
+    {
+      metaData.Set(key, MakeJsonString(value));
+    }
+  }
+  itkAttributes.Set("metaData", std::move(metaData));
+  JsonValue attributes = MakeJsonObject();
+  attributes.Set(ItkAttribute, std::move(itkAttributes));
+
+  const unsigned int componentSize = this->GetComponentSize();
+  JsonValue          metadata = MakeJsonObject();
+  metadata.Set("zarr_format", MakeJsonNumber(m_ZarrFormat));
+  if (m_ZarrFormat == 2)
+  {
+    metadata.Set("shape", MakeJsonArray(shape));
+    metadata.Set("chunks", MakeJsonArray(chunks));
+    metadata.Set("dtype", MakeJsonString((componentSize == 1 ? "|" : "<") + std::string(1, kind) +
+                                         std::to_string(componentSize)));
+    JsonValue compressor;
+    if (!m_Codec.empty())
+    {
+      compressor.Set("id", MakeJsonString(m_Codec));
+      compressor.Set("level", MakeJsonNumber(m_CodecLevel));
+    }
+    metadata.Set("compressor", std::move(compressor));
+    metadata.Set("fill_value", MakeJsonNumber(m_FillValue));
+    metadata.Set("order", MakeJsonString("C"));
+    metadata.Set("filters", JsonValue());
+    metadata.Set("dimension_separator", MakeJsonString(std::string(1, m_ChunkKeySeparator)));
+    WriteJsonFile(m_FileName + ArrayMetadataFile, metadata);
+    WriteJsonFile(m_FileName + AttributesFile, attributes);
+    return;
+  }
+
+  metadata.Set("node_type", MakeJsonString("array"));
+  metadata.Set("shape", MakeJsonArray(shape));
+  metadata.Set("data_type",
+               MakeJsonString((kind == 'u' ? "uint" : kind == 'i' ? "int" : "float") +
+                              std::to_string(8 * componentSize)));
+  JsonValue chunkGridConfiguration = MakeJsonObject();
+  chunkGridConfiguration.Set("chunk_shape", MakeJsonArray(chunks));
+  JsonValue chunkGrid = MakeJsonObject();
+  chunkGrid.Set("name", MakeJsonString("regular"));
+  chunkGrid.Set("configuration", std::move(chunkGridConfiguration));
+  metadata.Set("chunk_grid", std::move(chunkGrid));
+  JsonValue keyEncodingConfiguration = MakeJsonObject();
+  keyEncodingConfiguration.Set("separator", MakeJsonString(std::string(1, m_ChunkKeySeparator)));
+  JsonValue keyEncoding = MakeJsonObject();
+  keyEncoding.Set("name", MakeJsonString("default"));
+  keyEncoding.Set("configuration", std::move(keyEncodingConfiguration));
+  metadata.Set("chunk_key_encoding", std::move(keyEncoding));
+  metadata.Set("fill_value", MakeJsonNumber(m_FillValue));
+  JsonValue codecs;
+  codecs.type = JsonValue::Type::Array;
+  JsonValue bytesConfiguration = MakeJsonObject();
+  bytesConfiguration.Set("endian", MakeJsonString("little"));
+  JsonValue bytes = MakeJsonObject();
+  bytes.Set("name", MakeJsonString("bytes"));
+  bytes.Set("configuration", std::move(bytesConfiguration));
+  codecs.array.push_back(std::move(bytes));
+  if (!m_Codec.empty())
+  {
+    // The zlib codec is not part of the version 3 specification, and is
+    // registered by numcodecs
+    JsonValue compressorConfiguration = MakeJsonObject();
+    compressorConfiguration.Set("level", MakeJsonNumber(m_CodecLevel));
+    JsonValue compressor = MakeJsonObject();
+    compressor.Set("name", MakeJsonString(m_Codec == "gzip" ? "gzip" : "numcodecs.zlib"));
+    compressor.Set("configuration", std::move(compressorConfiguration));
+    codecs.array.push_back(std::move(compressor));
+  }
+  metadata.Set("codecs", std::move(codecs));
+  metadata.Set("attributes", std::move(attributes));
+  WriteJsonFile(m_FileName + V3MetadataFile, metadata);
+}
+
+void
+ZarrImageIO::Write(const void * buffer)
+{
+  if (!this->RequestedToStream() || !IsZarrDirectory(m_FileName))
+  {
+    this->WriteImageInformation();
+  }
+  else
+  {
+    // A region is pasted in the existing array, whose layout is kept.
+    // The superclass checked that the image matches it.
+    auto storedImageIO = Self::New();
+    storedImageIO->SetFileName(m_FileName);
+    storedImageIO->ReadImageInformation();
+    m_ArrayPath = storedImageIO->m_ArrayPath;
+    m_StoredChunkSize = storedImageIO->m_StoredChunkSize;
+    m_ChunkKeyPrefix = storedImageIO->m_ChunkKeyPrefix;
+    m_ChunkKeySeparator = storedImageIO->m_ChunkKeySeparator;
+    m_Codec = storedImageIO->m_Codec;
+    m_CodecLevel = storedImageIO->m_CodecLevel;
+    m_IsBigEndian = storedImageIO->m_IsBigEndian;
+    m_FillValue = storedImageIO->m_FillValue;
+    if (storedImageIO->GetNumberOfComponents() != this->GetNumberOfComponents() ||
+        storedImageIO->GetComponentType() != this->GetComponentType() ||
+        storedImageIO->GetNumberOfDimensions() != this->GetNumberOfDimensions())
+    {
+      itkExceptionMacro("The image does not match the Zarr array " << m_FileName << " it is pasted in");
+    }
+  }
+  this->WriteChunks(buffer);
+}
+
+void
+ZarrImageIO::WriteChunks(const void * buffer)
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  const Slab         slab = RegionToSlab(this->GetIORegion(), numberOfDimensions);
+  if (std::find(slab.count.cbegin(), slab.count.cend(), SizeValueType{ 0 }) != slab.count.cend())
+  {
+    return;
+  }
+
+  const size_t                     elementSize = this->GetComponentSize() * this->GetNumberOfComponents();
+  const std::vector<SizeValueType> chunkDims(m_StoredChunkSize.rbegin(), m_StoredChunkSize.rend());
+  const std::vector<SizeValueType> imageDims(m_Dimensions.rbegin(), m_Dimensions.rend());
+  ChunkCoder                       coder{ m_Codec,
+                    m_CodecLevel,
+                    this->GetComponentSize(),
+                    m_IsBigEndian,
+                    elementSize,
+                    GetFillElement(this->GetComponentType(), this->GetNumberOfComponents(), m_FillValue) };
+  for (const SizeValueType extent : chunkDims)
+  {
+    coder.chunkBytes *= extent;
+  }
+
+  const std::vector<std::vector<SizeValueType>> chunks = OverlappingChunks(chunkDims, slab);
+
+  // The directories of nested chunk keys are created before the chunks
+  // are written concurrently
+  std::set<std::string> directories;
+  for (const std::vector<SizeValueType> & chunkIndex : chunks)
+  {
+    directories.insert(itksys::SystemTools::GetFilenamePath(this->GetChunkFileName(chunkIndex)));
+  }
+  for (const std::string & directory : directories)
+  {
+    if (!itksys::SystemTools::MakeDirectory(directory))
+    {
+      itkExceptionMacro("Cannot create the directory " << directory);
+    }
+  }
+
+  std::vector<std::string> errors(chunks.size());
+  ProcessChunks(
+    chunks.size(),
+    m_NumberOfWorkUnits > 0 ? m_NumberOfWorkUnits : MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
+    [&](size_t k) {
+      try
+      {
+        // The chunks the region only partly covers are merged with their
+        // stored data. The part of the edge chunks outside of the image
+        // holds the fill value.
+        bool isWhole = true;
+        for (unsigned int d = 0; d < numberOfDimensions; ++d)
+        {
+          const SizeValueType chunkOffset = chunks[k][d] * chunkDims[d];
+          isWhole = isWhole && chunkOffset >= slab.offset[d] &&
+                    std::min(chunkOffset + chunkDims[d], imageDims[d]) <= slab.offset[d] + slab.count[d];
+        }
+        const std::string fileName = this->GetChunkFileName(chunks[k]);
+        std::vector<char> chunk;
+        if (isWhole)
+        {
+          coder.Fill(chunk);
+        }
+        else
+        {
+          coder.Load(fileName, chunk);
+        }
+        CopyChunkOverlap(chunks[k],
+                         chunkDims,
+                         slab,
+                         elementSize,
+                         chunk.data(),
+                         static_cast<char *>(const_cast<void *>(buffer)),
+                         true);
+        coder.Store(fileName, chunk);
+      }
+      catch (const ExceptionObject & e)
+      {
+        errors[k] = e.GetDescription();
+      }
+    });
+
+  for (const std::string & error : errors)
+  {
+    if (!error.empty())
+    {
+      itkExceptionMacro(<< error);
+    }
+  }
+}
+} // end namespace itk
@@ -0,0 +1,52 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkZarrImageIOFactory.h"
+#include "itkZarrImageIO.h"
+#include "itkVersion.h"
+
+namespace itk
+{
+ZarrImageIOFactory::ZarrImageIOFactory()
+{
+  this->RegisterOverride(
+    "itkImageIOBase", "itkZarrImageIO", "Zarr Image IO", true, CreateObjectFunction<ZarrImageIO>::New());
+}
+
+ZarrImageIOFactory::~ZarrImageIOFactory() = default;
+
+const char *
+ZarrImageIOFactory::GetITKSourceVersion() const
+{
+  return ITK_SOURCE_VERSION;
+}
+
+const char *
+ZarrImageIOFactory::GetDescription() const
+{
+  return "Zarr ImageIO Factory, allows the loading of Zarr images into Insight";
+}
+
+// Undocumented API used to register during static initialization.
+// DO NOT CALL DIRECTLY.
+void ITKIOZarr_EXPORT
+     ZarrImageIOFactoryRegister__Private()
+{
+  ObjectFactoryBase::RegisterInternalFactoryOnce<ZarrImageIOFactory>();
+}
+
+} // end namespace itk
@@ -0,0 +1,444 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkZarrImageIO.h"
+#include "itkZarrImageIOFactory.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkGaussianImageSource.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaDataObject.h"
+#include "itkStreamingImageFilter.h"
+#include "itkVector.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  typename TImage::SpacingType   spacing;
+  typename TImage::PointType     origin;
+  typename TImage::DirectionType direction;
+  direction.Fill(0.0);
+  for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+  {
+    spacing[i] = 0.5 + i;
+    origin[i] = -3.25 * (i + 1);
+    direction[(i + 1) % TImage::ImageDimension][i] = 1.0;
+  }
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->SetDirection(direction);
+
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    using Traits = itk::DefaultConvertPixelTraits<typename TImage::PixelType>;
+    typename TImage::PixelType value{};
+    for (unsigned int c = 0; c < Traits::GetNumberOfComponents(); ++c)
+    {
+      long offset = 17 * c;
+      for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+      {
+        offset = offset * 31 + it.GetIndex()[i];
+      }
+      Traits::SetNthComponent(c, value, static_cast<typename Traits::ComponentType>(offset % 251));
+    }
+    it.Set(value);
+  }
+  return image;
+}
+
+template <typename TImage>
+bool
+SameImages(const TImage * expected, const TImage * image, const typename TImage::RegionType & region)
+{
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != expected->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Wrong pixel " << it.Get() << " at " << it.GetIndex() << ", expected "
+                << expected->GetPixel(it.GetIndex()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Write an image, read it back, and compare the pixels and the geometry.
+template <typename TImage>
+int
+WriteAndRead(const TImage * image, itk::ZarrImageIO * writeImageIO, bool useCompression, const std::string & fileName)
+{
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(image);
+  writer->SetUseCompression(useCompression);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(writeImageIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto imageIO = itk::ZarrImageIO::New();
+  ITK_TEST_EXPECT_TRUE(imageIO->CanReadFile(fileName.c_str()));
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(imageIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  const TImage * output = reader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(output->GetLargestPossibleRegion(), image->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_EQUAL(output->GetSpacing(), image->GetSpacing());
+  ITK_TEST_EXPECT_EQUAL(output->GetOrigin(), image->GetOrigin());
+  ITK_TEST_EXPECT_EQUAL(output->GetDirection(), image->GetDirection());
+  ITK_TEST_EXPECT_EQUAL(imageIO->GetNumberOfComponents(),
+                        itk::DefaultConvertPixelTraits<typename TImage::PixelType>::GetNumberOfComponents());
+  if (!SameImages(image, output, output->GetLargestPossibleRegion()))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+void
+WriteFile(const std::string & fileName, const std::string & contents)
+{
+  std::ofstream file(fileName, std::ios::out | std::ios::binary);
+  file << contents;
+}
+} // namespace
+
+int
+itkZarrImageIOTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " OutputTestDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = std::string(argv[1]) + "/itkZarrImageIOTest";
+  itksys::SystemTools::RemoveADirectory(directory);
+  itksys::SystemTools::MakeDirectory(directory);
+
+  auto imageIO = itk::ZarrImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(imageIO, ZarrImageIO, StreamingImageIOBase);
+  ITK_TEST_EXPECT_TRUE(imageIO->GetChunkSize().empty());
+  ITK_TEST_SET_GET_VALUE(2, imageIO->GetZarrFormat());
+  ITK_TEST_SET_GET_VALUE(0, imageIO->GetNumberOfWorkUnits());
+  ITK_TEST_EXPECT_TRUE(imageIO->CanStreamRead());
+  ITK_TEST_EXPECT_TRUE(imageIO->CanStreamWrite());
+  ITK_TEST_EXPECT_TRUE(imageIO->CanWriteFile("image.zarr"));
+  ITK_TEST_EXPECT_TRUE(!imageIO->CanWriteFile("image.mha"));
+  ITK_TEST_EXPECT_TRUE(!imageIO->CanReadFile(directory.c_str()));
+  imageIO->SetZarrFormat(4);
+  ITK_TEST_SET_GET_VALUE(3, imageIO->GetZarrFormat());
+
+  // The factory creates the ImageIO of the files not given one
+  itk::ZarrImageIOFactory::RegisterOneFactory();
+
+  int result = EXIT_SUCCESS;
+
+  using ImageType = itk::Image<short, 3>;
+  const ImageType::Pointer image = MakeImage<ImageType>({ { 23, 17, 9 } });
+  itk::EncapsulateMetaData<std::string>(image->GetMetaDataDictionary(), "Modality", "Light \"sheet\"");
+
+  // Both versions of the format, with or without compression, and a
+  // single or several work units
+  for (const unsigned int zarrFormat : { 2, 3 })
+  {
+    for (const bool useCompression : { false, true })
+    {
+      auto writeImageIO = itk::ZarrImageIO::New();
+      writeImageIO->SetZarrFormat(zarrFormat);
+      writeImageIO->SetChunkSize({ 8, 8, 4 });
+      writeImageIO->SetNumberOfWorkUnits(useCompression ? 3 : 1);
+      writeImageIO->SetCompressor(zarrFormat == 3 ? "GZIP" : "ZLIB");
+
+      const std::string fileName =
+        directory + "/short" + std::to_string(zarrFormat) + (useCompression ? "z" : "") + ".zarr";
+      if (WriteAndRead<ImageType>(image, writeImageIO, useCompression, fileName) != EXIT_SUCCESS)
+      {
+        result = EXIT_FAILURE;
+      }
+
+      // The chunks are files of their own, the last one padded
+      const std::string lastChunk = zarrFormat == 3 ? "/c/2/2/2" : "/2.2.2";
+      ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(fileName + lastChunk, true));
+      const unsigned long chunkLength = itksys::SystemTools::FileLength(fileName + lastChunk);
+      ITK_TEST_EXPECT_TRUE(useCompression ? chunkLength < 4 * 8 * 8 * sizeof(short)
+                                          : chunkLength == 4 * 8 * 8 * sizeof(short));
+
+      auto readImageIO = itk::ZarrImageIO::New();
+      readImageIO->SetFileName(fileName);
+      readImageIO->ReadImageInformation();
+      std::string modality;
+      ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(readImageIO->GetMetaDataDictionary(), "Modality", modality));
+      ITK_TEST_EXPECT_EQUAL(modality, "Light \"sheet\"");
+    }
+  }
+  const std::string fileName = directory + "/short2.zarr";
+
+  // A region is read from the chunks overlapping it only
+  {
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetFileName(fileName);
+    reader->SetImageIO(itk::ZarrImageIO::New());
+    const ImageType::RegionType region({ { 5, 9, 3 } }, { { 11, 4, 2 } });
+    reader->GetOutput()->SetRequestedRegion(region);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetBufferedRegion(), region);
+    if (!SameImages<ImageType>(image, reader->GetOutput(), region))
+    {
+      result = EXIT_FAILURE;
+    }
+
+    // Streamed through a pipeline
+    auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+    reader->SetImageIO(itk::ZarrImageIO::New());
+    streamer->SetInput(reader->GetOutput());
+    streamer->SetNumberOfStreamDivisions(5);
+    ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+    if (!SameImages<ImageType>(image, streamer->GetOutput(), image->GetLargestPossibleRegion()))
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // The chunks missing from the array hold the fill value
+  {
+    ITK_TEST_EXPECT_TRUE(itksys::SystemTools::RemoveFile(fileName + "/0.1.2"));
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetFileName(fileName);
+    reader->SetImageIO(itk::ZarrImageIO::New());
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetPixel({ { 16, 8, 0 } }), 0);
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetPixel({ { 22, 15, 3 } }), 0);
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetPixel({ { 15, 8, 0 } }), image->GetPixel({ { 15, 8, 0 } }));
+  }
+
+  // A region pasted in an existing array rewrites the chunks it overlaps
+  {
+    const ImageType::RegionType pasteRegion({ { 3, 2, 1 } }, { { 14, 9, 5 } });
+    // Only the pasted region is buffered, so that the writer does not
+    // write the whole image instead
+    auto pasted = ImageType::New();
+    pasted->CopyInformation(image);
+    pasted->SetBufferedRegion(pasteRegion);
+    pasted->SetRequestedRegion(pasteRegion);
+    pasted->Allocate();
+    pasted->FillBuffer(-7);
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(pasted);
+    writer->SetFileName(directory + "/short2z.zarr");
+    writer->SetImageIO(itk::ZarrImageIO::New());
+    itk::ImageIORegion ioRegion(3);
+    itk::ImageIORegionAdaptor<3>::Convert(pasteRegion, ioRegion, pasted->GetLargestPossibleRegion().GetIndex());
+    writer->SetIORegion(ioRegion);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    const ImageType::Pointer output = itk::ReadImage<ImageType>(directory + "/short2z.zarr");
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      const short expected = pasteRegion.IsInside(it.GetIndex()) ? -7 : image->GetPixel(it.GetIndex());
+      if (it.Get() != expected)
+      {
+        std::cerr << "Wrong pasted pixel " << it.Get() << " at " << it.GetIndex() << std::endl;
+        result = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+
+  // An image generated in pieces is streamed into a new array, replacing
+  // the existing one
+  {
+    using FloatImageType = itk::Image<float, 3>;
+    auto source = itk::GaussianImageSource<FloatImageType>::New();
+    source->SetSize({ { 20, 18, 16 } });
+    source->SetScale(100.0);
+    itk::GaussianImageSource<FloatImageType>::ArrayType mean;
+    itk::GaussianImageSource<FloatImageType>::ArrayType sigma;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      mean[i] = 9.0 - i;
+      sigma[i] = 3.0 + i;
+    }
+    source->SetMean(mean);
+    source->SetSigma(sigma);
+    ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+    const FloatImageType::Pointer expected = source->GetOutput();
+    expected->DisconnectPipeline();
+
+    auto writeImageIO = itk::ZarrImageIO::New();
+    writeImageIO->SetChunkSize({ 7, 7, 7 });
+    writeImageIO->SetZarrFormat(3);
+    auto writer = itk::ImageFileWriter<FloatImageType>::New();
+    writer->UseCompressionOn();
+    writer->SetInput(source->GetOutput());
+    writer->SetFileName(fileName);
+    writer->SetImageIO(writeImageIO);
+    writer->SetNumberOfStreamDivisions(4);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+    ITK_TEST_EXPECT_TRUE(!itksys::SystemTools::FileExists(fileName + "/.zarray"));
+
+    auto reader = itk::ImageFileReader<FloatImageType>::New();
+    reader->SetFileName(fileName);
+    reader->SetImageIO(itk::ZarrImageIO::New());
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    if (!SameImages<FloatImageType>(expected, reader->GetOutput(), expected->GetLargestPossibleRegion()))
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // The components of a pixel are the last axis of the array
+  {
+    using VectorImageType = itk::Image<itk::Vector<unsigned char, 3>, 2>;
+    const VectorImageType::Pointer vectorImage = MakeImage<VectorImageType>({ { 40, 27 } });
+    for (const unsigned int zarrFormat : { 2, 3 })
+    {
+      auto writeImageIO = itk::ZarrImageIO::New();
+      writeImageIO->SetZarrFormat(zarrFormat);
+      writeImageIO->SetChunkSize({ 16, 10 });
+      const std::string vectorFileName = directory + "/vector" + std::to_string(zarrFormat) + ".zarr";
+      if (WriteAndRead<VectorImageType>(vectorImage, writeImageIO, true, vectorFileName) != EXIT_SUCCESS)
+      {
+        result = EXIT_FAILURE;
+      }
+      ITK_TEST_EXPECT_TRUE(
+        itksys::SystemTools::FileExists(vectorFileName + (zarrFormat == 3 ? "/c/2/2/0" : "/2.2.0"), true));
+    }
+  }
+
+  // An array written by another implementation: big endian, nested
+  // chunk keys, without the attributes of ITK
+  {
+    const std::string foreignFileName = directory + "/foreign.zarr";
+    itksys::SystemTools::MakeDirectory(foreignFileName + "/0");
+    itksys::SystemTools::MakeDirectory(foreignFileName + "/1");
+    WriteFile(foreignFileName + "/.zarray",
+              R"({"zarr_format": 2, "shape": [3, 4], "chunks": [2, 3], "dtype": ">u2", "compressor": null,
+                  "fill_value": 5, "order": "C", "filters": null, "dimension_separator": "/"})");
+    // Each chunk holds 2 rows of 3 columns, the edge chunks being padded
+    for (const unsigned int chunkRow : { 0, 1 })
+    {
+      for (const unsigned int chunkColumn : { 0, 1 })
+      {
+        std::string contents;
+        for (unsigned int row = 2 * chunkRow; row < 2 * chunkRow + 2; ++row)
+        {
+          for (unsigned int column = 3 * chunkColumn; column < 3 * chunkColumn + 3; ++column)
+          {
+            const unsigned int value = 1000 * row + column;
+            contents += static_cast<char>(value >> 8);
+            contents += static_cast<char>(value & 0xFF);
+          }
+        }
+        if (chunkRow == 1 && chunkColumn == 1)
+        {
+          continue;
+        }
+        WriteFile(foreignFileName + '/' + std::to_string(chunkRow) + '/' + std::to_string(chunkColumn), contents);
+      }
+    }
+
+    using UShortImageType = itk::Image<unsigned short, 2>;
+    auto foreignImageIO = itk::ZarrImageIO::New();
+    ITK_TEST_EXPECT_TRUE(foreignImageIO->CanReadFile(foreignFileName.c_str()));
+    auto reader = itk::ImageFileReader<UShortImageType>::New();
+    reader->SetFileName(foreignFileName);
+    reader->SetImageIO(foreignImageIO);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(foreignImageIO->GetComponentType(), itk::IOComponentEnum::USHORT);
+    const UShortImageType::Pointer output = reader->GetOutput();
+    output->DisconnectPipeline();
+    ITK_TEST_EXPECT_EQUAL(output->GetLargestPossibleRegion().GetSize(), UShortImageType::SizeType({ { 4, 3 } }));
+    ITK_TEST_EXPECT_EQUAL(output->GetSpacing()[0], 1.0);
+    for (itk::ImageRegionConstIteratorWithIndex<UShortImageType> it(output, output->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      const bool           isMissing = it.GetIndex()[1] == 2 && it.GetIndex()[0] == 3;
+      const unsigned short expected =
+        isMissing ? 5 : static_cast<unsigned short>(1000 * it.GetIndex()[1] + it.GetIndex()[0]);
+      if (it.Get() != expected)
+      {
+        std::cerr << "Wrong foreign pixel " << it.Get() << " at " << it.GetIndex() << std::endl;
+        result = EXIT_FAILURE;
+      }
+    }
+
+    // The full resolution of an OME-Zarr multiscale image, with its scale
+    const std::string omeFileName = directory + "/ome.zarr";
+    itksys::SystemTools::CopyADirectory(foreignFileName, omeFileName + "/0");
+    WriteFile(omeFileName + "/.zgroup", R"({"zarr_format": 2})");
+    WriteFile(omeFileName + "/.zattrs",
+              R"({"multiscales": [{"version": "0.4", "datasets": [{"path": "0", "coordinateTransformations":
+                  [{"type": "scale", "scale": [2.0, 0.5]}]}, {"path": "1"}]}]})");
+    reader->SetFileName(omeFileName);
+    reader->SetImageIO(itk::ZarrImageIO::New());
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetSpacing()[0], 0.5);
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetSpacing()[1], 2.0);
+    if (!SameImages<UShortImageType>(output, reader->GetOutput(), output->GetLargestPossibleRegion()))
+    {
+      result = EXIT_FAILURE;
+    }
+
+    // A group is not replaced by the array written in its place
+    auto groupWriter = itk::ImageFileWriter<UShortImageType>::New();
+    groupWriter->SetInput(output);
+    groupWriter->SetFileName(omeFileName);
+    groupWriter->SetImageIO(itk::ZarrImageIO::New());
+    ITK_TRY_EXPECT_EXCEPTION(groupWriter->Update());
+    ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(omeFileName + "/0/.zarray", true));
+    ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(omeFileName + "/.zgroup", true));
+
+    // Unsupported codecs are reported
+    WriteFile(foreignFileName + "/.zarray",
+              R"({"zarr_format": 2, "shape": [3, 4], "chunks": [2, 3], "dtype": "<u2",
+                  "compressor": {"id": "blosc"}, "fill_value": 0, "order": "C", "filters": null})");
+    ITK_TEST_EXPECT_TRUE(!foreignImageIO->CanReadFile(foreignFileName.c_str()));
+    foreignImageIO->SetFileName(foreignFileName);
+    ITK_TRY_EXPECT_EXCEPTION(foreignImageIO->ReadImageInformation());
+  }
+
+  // A directory which is not an array is not replaced
+  {
+    const std::string otherFileName = directory + "/other.zarr";
+    itksys::SystemTools::MakeDirectory(otherFileName);
+    WriteFile(otherFileName + "/notes.txt", "keep");
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(image);
+    writer->SetFileName(otherFileName);
+    writer->SetImageIO(itk::ZarrImageIO::New());
+    ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+    ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(otherFileName + "/notes.txt", true));
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
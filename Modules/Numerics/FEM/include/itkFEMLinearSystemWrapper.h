@@ -241,6 +241,35 @@ public:
   virtual void
   DestroySolution(unsigned int solutionIndex = 0) = 0;
 
+  /**
+   * Check whether the matrices can be preallocated with
+   * SetMatrixSparsityPattern(). Solver only computes the sparsity
+   * pattern of the stiffness matrix if this returns true.
+   */
+  virtual bool
+  GetSupportsSparsityPattern() const
+  {
+    return false;
+  }
+
+  /**
+   * Initialization of a matrix with storage for the entries of a sparsity
+   * pattern. The pattern is given in compressed sparse row format: the
+   * columns of the entries of row i are columnIndices[rowPointers[i]] to
+   * columnIndices[rowPointers[i + 1] - 1], in increasing order. Values may
+   * still be added outside of the pattern. All elements are set to zero.
+   * The default implementation ignores the pattern and calls
+   * InitializeMatrix().
+   *
+   * \param rowPointers offsets of the rows in columnIndices, of size N + 1
+   * \param columnIndices columns of the entries of all the rows
+   * \param matrixIndex index of matrix to initialize
+   */
+  virtual void
+  SetMatrixSparsityPattern(const ColumnArray & rowPointers,
+                           const ColumnArray & columnIndices,
+                           unsigned int        matrixIndex = 0);
+
   /**
    * Virtual function to get a value of a specific element of a matrix.
    * \param i row of the element
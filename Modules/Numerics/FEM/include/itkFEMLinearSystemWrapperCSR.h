@@ -0,0 +1,422 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFEMLinearSystemWrapperCSR_h
+#define itkFEMLinearSystemWrapperCSR_h
+
+#include "itkFEMLinearSystemWrapper.h"
+#include "itkMultiThreaderBase.h"
+#include "ITKFEMExport.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+namespace fem
+{
+/** \class LinearSystemWrapperCSREnums
+ * \brief Contains all enum classes used by the LinearSystemWrapperCSR class.
+ * \ingroup ITKFEM
+ */
+class LinearSystemWrapperCSREnums
+{
+public:
+  /** \class SolverMethod
+   * \ingroup ITKFEM
+   * Iterative method used to solve the linear system. */
+  enum class SolverMethod : uint8_t
+  {
+    ConjugateGradient,
+    BiConjugateGradientStabilized,
+    MinimumResidual
+  };
+
+  /** \class Preconditioner
+   * \ingroup ITKFEM
+   * Preconditioner of the iterative method. */
+  enum class Preconditioner : uint8_t
+  {
+    None,
+    Jacobi,
+    IncompleteLU
+  };
+};
+// Define how to print enumeration
+extern ITKFEM_EXPORT std::ostream &
+                     operator<<(std::ostream & out, const LinearSystemWrapperCSREnums::SolverMethod value);
+extern ITKFEM_EXPORT std::ostream &
+                     operator<<(std::ostream & out, const LinearSystemWrapperCSREnums::Preconditioner value);
+
+/**
+ * \class LinearSystemWrapperCSR
+ * \brief LinearSystemWrapper class that stores sparse matrices in compressed
+ *        sparse row (CSR) format and solves the linear system with a
+ *        multithreaded preconditioned iterative method.
+ *
+ * The storage of a matrix can be preallocated with SetMatrixSparsityPattern(),
+ * after which adding a value to an entry of the pattern is a binary search in
+ * its row. Solver computes the pattern from the connectivity of the elements
+ * before assembling the stiffness matrix. Entries outside of the pattern are
+ * kept in per-row side storage and merged into the compressed rows before the
+ * next matrix operation.
+ *
+ * Solve() uses matrix, vector and solution 0. The conjugate gradient method
+ * requires a symmetric positive definite matrix, as the stiffness matrices
+ * without multi freedom constraints. The multi freedom constraints add
+ * Lagrange multiplier rows with a zero diagonal, which make the matrix
+ * indefinite: when the conjugate gradient method is selected and a diagonal
+ * entry is not positive, MINRES is used instead. MINRES handles symmetric
+ * indefinite systems, and is preconditioned by the inverse of the absolute
+ * value of the diagonal unless the preconditioner is None. BiCGSTAB also
+ * handles nonsymmetric systems. The current content of the solution is the
+ * initial guess, so that repeated solves of slowly changing systems converge
+ * faster. The iterations stop when the norm of the residual is below Tolerance
+ * times the norm of the right hand side. Solve() throws a
+ * FEMExceptionLinearSystem if they stop before, at the maximum number of
+ * iterations or on a breakdown of the method; the solution then holds the
+ * last iterate.
+ *
+ * Matrix-vector products, dot products and vector updates are computed in
+ * parallel. Reductions are computed over a fixed partition of the rows, so the
+ * result does not depend on the number of threads. The ILU(0) triangular solves
+ * are sequential.
+ *
+ * \sa LinearSystemWrapper
+ * \ingroup ITKFEM
+ */
+class ITKFEM_EXPORT LinearSystemWrapperCSR : public LinearSystemWrapper
+{
+public:
+  /* values stored in matrices & vectors */
+  using Float = LinearSystemWrapper::Float;
+
+  /* superclass */
+  using Superclass = LinearSystemWrapper;
+
+  using ColumnArray = Superclass::ColumnArray;
+
+  using SolverMethodEnum = LinearSystemWrapperCSREnums::SolverMethod;
+  using PreconditionerEnum = LinearSystemWrapperCSREnums::Preconditioner;
+
+  /** Sparse matrix in compressed sparse row format. The columns of row i are
+   * ColumnIndices[RowPointers[i]] to ColumnIndices[RowPointers[i + 1] - 1], in
+   * increasing order. */
+  struct MatrixRepresentation
+  {
+    ColumnArray        RowPointers;
+    ColumnArray        ColumnIndices;
+    std::vector<Float> Values;
+
+    /** Entries added outside of the compressed rows, sorted by column. */
+    std::vector<std::vector<std::pair<unsigned int, Float>>> PendingRows;
+    bool                                                      HasPendingEntries{ false };
+  };
+
+  using VectorRepresentation = std::vector<Float>;
+
+  /* constructor & destructor */
+  LinearSystemWrapperCSR();
+  ~LinearSystemWrapperCSR() override;
+
+  /** Iterative method used by Solve(). Defaults to ConjugateGradient, which
+   * falls back to MinimumResidual for a matrix with a diagonal entry that is
+   * not positive. */
+  void
+  SetSolverMethod(SolverMethodEnum method)
+  {
+    m_SolverMethod = method;
+  }
+  SolverMethodEnum
+  GetSolverMethod() const
+  {
+    return m_SolverMethod;
+  }
+
+  /** Preconditioner used by Solve(). Defaults to Jacobi. */
+  void
+  SetPreconditioner(PreconditionerEnum preconditioner)
+  {
+    m_Preconditioner = preconditioner;
+  }
+  PreconditionerEnum
+  GetPreconditioner() const
+  {
+    return m_Preconditioner;
+  }
+
+  /** Relative residual norm at which the iterations stop. Defaults to 1e-8. */
+  void
+  SetTolerance(double tolerance)
+  {
+    m_Tolerance = tolerance;
+  }
+  double
+  GetTolerance() const
+  {
+    return m_Tolerance;
+  }
+
+  /** Maximum number of iterations of Solve(). Zero, the default, allows three
+   * times the order of the system. */
+  void
+  SetMaximumNumberOfIterations(unsigned int iterations)
+  {
+    m_MaximumNumberOfIterations = iterations;
+  }
+  unsigned int
+  GetMaximumNumberOfIterations() const
+  {
+    return m_MaximumNumberOfIterations;
+  }
+
+  /** Iterative method, number of iterations and relative residual norm of
+   * the last Solve(). */
+  SolverMethodEnum
+  GetSolverMethodOfLastSolve() const
+  {
+    return m_SolverMethodOfLastSolve;
+  }
+  unsigned int
+  GetNumberOfIterations() const
+  {
+    return m_NumberOfIterations;
+  }
+  double
+  GetRelativeResidualNorm() const
+  {
+    return m_RelativeResidualNorm;
+  }
+
+  /** Multithreader used by the matrix and vector operations. Set its number
+   * of work units to limit the number of threads. */
+  MultiThreaderBase *
+  GetMultiThreader() const
+  {
+    return m_MultiThreader;
+  }
+
+  /** Number of values stored in a matrix, including the explicit zeros of its
+   * sparsity pattern. */
+  unsigned int
+  GetNumberOfStoredValuesInMatrix(unsigned int matrixIndex = 0) const;
+
+  /* memory management routines */
+  void
+  InitializeMatrix(unsigned int matrixIndex) override;
+
+  bool
+  IsMatrixInitialized(unsigned int matrixIndex) override;
+
+  void
+  DestroyMatrix(unsigned int matrixIndex) override;
+
+  void
+  InitializeVector(unsigned int vectorIndex) override;
+
+  bool
+  IsVectorInitialized(unsigned int vectorIndex) override;
+
+  void
+  DestroyVector(unsigned int vectorIndex) override;
+
+  void
+  InitializeSolution(unsigned int solutionIndex) override;
+
+  bool
+  IsSolutionInitialized(unsigned int solutionIndex) override;
+
+  void
+  DestroySolution(unsigned int solutionIndex) override;
+
+  bool
+  GetSupportsSparsityPattern() const override
+  {
+    return true;
+  }
+
+  void
+  SetMatrixSparsityPattern(const ColumnArray & rowPointers,
+                           const ColumnArray & columnIndices,
+                           unsigned int        matrixIndex) override;
+
+  /* assembly & solving routines */
+  Float
+  GetMatrixValue(unsigned int i, unsigned int j, unsigned int matrixIndex) const override;
+
+  void
+  SetMatrixValue(unsigned int i, unsigned int j, Float value, unsigned int matrixIndex) override;
+
+  void
+  AddMatrixValue(unsigned int i, unsigned int j, Float value, unsigned int matrixIndex) override;
+
+  void
+  GetColumnsOfNonZeroMatrixElementsInRow(unsigned int row, ColumnArray & cols, unsigned int matrixIndex) override;
+
+  Float
+  GetVectorValue(unsigned int i, unsigned int vectorIndex) const override
+  {
+    return (*m_Vectors[vectorIndex])[i];
+  }
+  void
+  SetVectorValue(unsigned int i, Float value, unsigned int vectorIndex) override
+  {
+    (*m_Vectors[vectorIndex])[i] = value;
+  }
+  void
+  AddVectorValue(unsigned int i, Float value, unsigned int vectorIndex) override
+  {
+    (*m_Vectors[vectorIndex])[i] += value;
+  }
+  Float
+  GetSolutionValue(unsigned int i, unsigned int solutionIndex) const override;
+
+  void
+  SetSolutionValue(unsigned int i, Float value, unsigned int solutionIndex) override
+  {
+    (*m_Solutions[solutionIndex])[i] = value;
+  }
+  void
+  AddSolutionValue(unsigned int i, Float value, unsigned int solutionIndex) override
+  {
+    (*m_Solutions[solutionIndex])[i] += value;
+  }
+  void
+  Solve() override;
+
+  /* matrix & vector manipulation routines */
+  void
+  ScaleMatrix(Float scale, unsigned int matrixIndex) override;
+
+  void
+  SwapMatrices(unsigned int matrixIndex1, unsigned int matrixIndex2) override;
+
+  void
+  CopyMatrix(unsigned int matrixIndex1, unsigned int matrixIndex2) override;
+
+  void
+  AddMatrixMatrix(unsigned int matrixIndex1, unsigned int matrixIndex2) override;
+
+  void
+  SwapVectors(unsigned int vectorIndex1, unsigned int vectorIndex2) override;
+
+  void
+  SwapSolutions(unsigned int solutionIndex1, unsigned int solutionIndex2) override;
+
+  void
+  CopySolution2Vector(unsigned int solutionIndex, unsigned int vectorIndex) override;
+
+  void
+  CopyVector2Solution(unsigned int vectorIndex, unsigned int solutionIndex) override;
+
+  void
+  CopyVector(unsigned int vectorSource, unsigned int vectorDestination) override;
+
+  void
+  AddVectorVector(unsigned int vectorIndex1, unsigned int vectorIndex2) override;
+
+  void
+  MultiplyMatrixMatrix(unsigned int resultMatrixIndex,
+                       unsigned int leftMatrixIndex,
+                       unsigned int rightMatrixIndex) override;
+
+  void
+  MultiplyMatrixVector(unsigned int resultVectorIndex, unsigned int matrixIndex, unsigned int vectorIndex) override;
+
+  void
+  MultiplyMatrixSolution(unsigned int resultVectorIndex, unsigned int matrixIndex, unsigned int solutionIndex) override;
+
+private:
+  /** Merge the pending entries of a matrix into its compressed rows. */
+  void
+  CompressMatrix(MatrixRepresentation & matrix) const;
+
+  /** Position of entry (i, j) in the compressed rows, or the number of
+   * compressed values if the entry is not in the compressed rows. */
+  static size_t
+  FindCompressedPosition(const MatrixRepresentation & matrix, unsigned int i, unsigned int j);
+
+  /** y = A x, in parallel over the rows. */
+  void
+  Multiply(const MatrixRepresentation & matrix, const Float * x, Float * y) const;
+
+  /** Sum of x[i] * y[i]. */
+  double
+  Dot(const VectorRepresentation & x, const VectorRepresentation & y) const;
+
+  /** Call function(first, end) for the ranges of a fixed partition of the
+   * rows, in parallel. */
+  template <typename TFunction>
+  void
+  ParallelizeRows(const TFunction & function) const;
+
+  /** Sum of function(first, end) over the ranges of a fixed partition of the
+   * rows, computed in parallel and added in a fixed order. */
+  template <typename TFunction>
+  double
+  ReduceRows(const TFunction & function) const;
+
+  void
+  ConjugateGradient(const MatrixRepresentation & matrix, const VectorRepresentation & b, VectorRepresentation & x);
+
+  void
+  BiConjugateGradientStabilized(const MatrixRepresentation & matrix,
+                                const VectorRepresentation & b,
+                                VectorRepresentation &       x);
+
+  void
+  MinimumResidual(const MatrixRepresentation & matrix, const VectorRepresentation & b, VectorRepresentation & x);
+
+  /** Whether all the diagonal entries of matrix are positive. */
+  bool
+  HasPositiveDiagonal(const MatrixRepresentation & matrix) const;
+
+  /** Compute the preconditioner of matrix. */
+  void
+  InitializePreconditioner(const MatrixRepresentation & matrix);
+
+  /** z = M^-1 r, where M is the preconditioner of matrix. */
+  void
+  ApplyPreconditioner(const MatrixRepresentation & matrix,
+                      const VectorRepresentation & r,
+                      VectorRepresentation &       z) const;
+
+  std::vector<std::unique_ptr<MatrixRepresentation>> m_Matrices;
+  std::vector<std::unique_ptr<VectorRepresentation>> m_Vectors;
+  std::vector<std::unique_ptr<VectorRepresentation>> m_Solutions;
+
+  SolverMethodEnum   m_SolverMethod{ SolverMethodEnum::ConjugateGradient };
+  SolverMethodEnum   m_SolverMethodOfLastSolve{ SolverMethodEnum::ConjugateGradient };
+  PreconditionerEnum m_Preconditioner{ PreconditionerEnum::Jacobi };
+  double             m_Tolerance{ 1e-8 };
+  unsigned int       m_MaximumNumberOfIterations{ 0 };
+  unsigned int       m_NumberOfIterations{ 0 };
+  double             m_RelativeResidualNorm{ 0.0 };
+
+  /** Inverse of the diagonal for Jacobi, or the ILU(0) factors stored in the
+   * pattern of the matrix, with the positions of the diagonal entries. */
+  VectorRepresentation m_PreconditionerValues;
+  ColumnArray          m_DiagonalPositions;
+
+  MultiThreaderBase::Pointer m_MultiThreader;
+};
+} // end namespace fem
+} // end namespace itk
+
+#endif // itkFEMLinearSystemWrapperCSR_h
@@ -60,6 +60,12 @@ namespace fem
  * solution. Based on the solution and the user specified grid, a deformation
  * field is generated.
  *
+ * The linear systems are solved with LinearSystemWrapperItpack, unless another
+ * wrapper is set with SetLinearSystemWrapper(). With LinearSystemWrapperCSR,
+ * the matrices are preallocated from the connectivity of the mesh and solved
+ * with multiple threads, which, with ParallelElementAssemblyOn(), suits large
+ * meshes.
+ *
  * \author Yixun Liu
  *
  * \par REFERENCE
@@ -61,27 +61,48 @@ template <unsigned int VDimension>
 void
 RobustSolver<VDimension>::Initialization()
 {
-  this->SetLinearSystemWrapper(&m_Itpack);
+  // Itpack is used unless another linear system wrapper was set
+  if (this->m_LinearSystem == &this->m_LinearSystemVNL)
+  {
+    this->SetLinearSystemWrapper(&m_Itpack);
+  }
 
-  constexpr FEMIndexType maximumNonZeroMatrixEntriesFactor = 100;
+  if (this->m_LinearSystem == &m_Itpack)
+  {
+    constexpr FEMIndexType maximumNonZeroMatrixEntriesFactor = 100;
 
-  const FEMIndexType maxNumberOfNonZeroValues = this->m_NGFN * maximumNonZeroMatrixEntriesFactor;
+    const FEMIndexType maxNumberOfNonZeroValues = this->m_NGFN * maximumNonZeroMatrixEntriesFactor;
 
-  if (maxNumberOfNonZeroValues > NumericTraits<FEMIndexType>::max() / 2)
-  {
-    itkExceptionMacro("Too large system of equations");
-  }
+    if (maxNumberOfNonZeroValues > NumericTraits<FEMIndexType>::max() / 2)
+    {
+      itkExceptionMacro("Too large system of equations");
+    }
 
-  this->m_Itpack.SetMaximumNonZeroValuesInMatrix(maxNumberOfNonZeroValues);
+    this->m_Itpack.SetMaximumNonZeroValuesInMatrix(maxNumberOfNonZeroValues);
+  }
 
   // The NGFN is determined once the FEMObject is finalized
   this->m_LinearSystem->SetSystemOrder(this->m_NGFN);
   this->m_LinearSystem->SetNumberOfVectors(3);
   this->m_LinearSystem->SetNumberOfSolutions(1);
   this->m_LinearSystem->SetNumberOfMatrices(3);
-  this->m_LinearSystem->InitializeMatrix(m_MeshStiffnessMatrixIndex);
-  this->m_LinearSystem->InitializeMatrix(m_LandmarkStiffnessMatrixIndex);
-  this->m_LinearSystem->InitializeMatrix(m_StiffnessMatrixIndex);
+  if (this->m_LinearSystem->GetSupportsSparsityPattern())
+  {
+    // The landmarks only couple the nodes of their element, so all the
+    // matrices share the pattern of the mesh.
+    LinearSystemWrapper::ColumnArray rowPointers;
+    LinearSystemWrapper::ColumnArray columnIndices;
+    this->ComputeMatrixSparsityPattern(this->m_NGFN, rowPointers, columnIndices);
+    this->m_LinearSystem->SetMatrixSparsityPattern(rowPointers, columnIndices, m_MeshStiffnessMatrixIndex);
+    this->m_LinearSystem->SetMatrixSparsityPattern(rowPointers, columnIndices, m_LandmarkStiffnessMatrixIndex);
+    this->m_LinearSystem->SetMatrixSparsityPattern(rowPointers, columnIndices, m_StiffnessMatrixIndex);
+  }
+  else
+  {
+    this->m_LinearSystem->InitializeMatrix(m_MeshStiffnessMatrixIndex);
+    this->m_LinearSystem->InitializeMatrix(m_LandmarkStiffnessMatrixIndex);
+    this->m_LinearSystem->InitializeMatrix(m_StiffnessMatrixIndex);
+  }
   this->m_LinearSystem->InitializeVector(m_ForceIndex);
   this->m_LinearSystem->InitializeVector(m_LandmarkForceIndex);
   this->m_LinearSystem->InitializeVector(m_ExternalForceIndex);
@@ -609,6 +630,12 @@ RobustSolver<VDimension>::AssembleMeshStiffnessMatrix()
     return;
   }
 
+  if (this->m_ParallelElementAssembly)
+  {
+    this->AssembleElementStiffnessMatrices(this->m_MeshStiffnessMatrixIndex);
+    return;
+  }
+
   // Assemble the mechanical matrix by stepping over all elements
   FEMIndexType numberOfElements = this->m_FEMObject->GetNumberOfElements();
   for (FEMIndexType i = 0; i < numberOfElements; ++i)
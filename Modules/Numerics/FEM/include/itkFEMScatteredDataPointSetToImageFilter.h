@@ -104,6 +104,10 @@ namespace fem
 
    \endcode
  *
+ * The linear system wrapper of the solver, returned by GetModifiableFEMSolver(),
+ * can be replaced before the update, for instance by a LinearSystemWrapperCSR
+ * for large meshes.
+ *
  * \author Yixun Liu
  *
  * \par REFERENCE
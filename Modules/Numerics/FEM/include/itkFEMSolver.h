@@ -131,6 +131,14 @@ public:
   itkSetMacro(Direction, InterpolationGridDirectionType);
   itkGetMacro(Direction, InterpolationGridDirectionType);
 
+  /** Get/Set whether AssembleK() computes the element stiffness matrices in
+   * parallel. The element matrices are then added to the master stiffness
+   * matrix without calling AssembleElementMatrix(), so derived classes that
+   * override it must leave this off. Off by default. */
+  itkSetMacro(ParallelElementAssembly, bool);
+  itkGetConstMacro(ParallelElementAssembly, bool);
+  itkBooleanMacro(ParallelElementAssembly);
+
   /** Returns the time step used for dynamic problems. */
   virtual Float
   GetTimeStep() const;
@@ -344,6 +352,32 @@ protected:
   virtual void
   AssembleElementMatrix(Element::Pointer e);
 
+  /**
+   * Add the stiffness matrices of all the elements to a matrix of the linear
+   * system. Blocks of element matrices are computed in parallel, and added in
+   * the order of the elements, so the result does not depend on the number of
+   * threads.
+   */
+  void
+  AssembleElementStiffnessMatrices(unsigned int matrixIndex = 0);
+
+  /**
+   * Add the nonzero entries of an element matrix to a matrix of the linear
+   * system, at the global degrees of freedom of the element.
+   */
+  void
+  AddElementMatrix(const Element * e, const Element::MatrixType & Ke, unsigned int matrixIndex = 0);
+
+  /**
+   * Compute the sparsity pattern of a matrix of order N that couples the
+   * degrees of freedom of each element, in the compressed sparse row format of
+   * LinearSystemWrapper::SetMatrixSparsityPattern().
+   */
+  void
+  ComputeMatrixSparsityPattern(unsigned int                       N,
+                               LinearSystemWrapper::ColumnArray & rowPointers,
+                               LinearSystemWrapper::ColumnArray & columnIndices) const;
+
   /**
    * Add the contribution of the landmark-containing elements to the
    * correct position in the master stiffness matrix. Since more
@@ -431,6 +465,8 @@ protected:
 
   FEMObjectPointer m_FEMObject{};
 
+  bool m_ParallelElementAssembly{ false };
+
 private:
   /** Properties of the interpolation grid. */
   InterpolationGridRegionType    m_Region{};
@@ -25,6 +25,7 @@
 #include "itkFEMLoadBC.h"
 #include "itkFEMLoadBCMFC.h"
 #include "itkFEMLoadLandmark.h"
+#include "itkMultiThreaderBase.h"
 #include "itkTimeProbe.h"
 #include "itkImageRegionIterator.h"
 
@@ -168,6 +169,7 @@ Solver<VDimension>::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Global degrees of freedom: " << m_NGFN << std::endl;
   os << indent << "Multi freedom constraints: " << m_NMFC << std::endl;
   os << indent << "FEM Object: " << m_FEMObject << std::endl;
+  itkPrintSelfBooleanMacro(ParallelElementAssembly);
 }
 
 template <unsigned int VDimension>
@@ -231,13 +233,20 @@ Solver<VDimension>::AssembleK()
   this->InitializeMatrixForAssembly(NGFN + NMFC);
 
   // Step over all elements
-  unsigned int numberOfElements = m_FEMObject->GetNumberOfElements();
-  for (unsigned int i = 0; i < numberOfElements; ++i)
+  if (m_ParallelElementAssembly)
+  {
+    this->AssembleElementStiffnessMatrices();
+  }
+  else
   {
-    // Call the function that actually moves the element matrix
-    // to the master matrix.
-    Element::Pointer e = m_FEMObject->GetElement(i);
-    this->AssembleElementMatrix(e);
+    unsigned int numberOfElements = m_FEMObject->GetNumberOfElements();
+    for (unsigned int i = 0; i < numberOfElements; ++i)
+    {
+      // Call the function that actually moves the element matrix
+      // to the master matrix.
+      Element::Pointer e = m_FEMObject->GetElement(i);
+      this->AssembleElementMatrix(e);
+    }
   }
 
   // Step over all the loads again to add the landmark contributions
@@ -263,7 +272,87 @@ Solver<VDimension>::InitializeMatrixForAssembly(unsigned int N)
 {
   // We use LinearSystemWrapper object, to store the K matrix.
   this->m_LinearSystem->SetSystemOrder(N);
-  this->m_LinearSystem->InitializeMatrix();
+  if (this->m_LinearSystem->GetSupportsSparsityPattern())
+  {
+    // Preallocate the entries coupled by the elements
+    LinearSystemWrapper::ColumnArray rowPointers;
+    LinearSystemWrapper::ColumnArray columnIndices;
+    this->ComputeMatrixSparsityPattern(N, rowPointers, columnIndices);
+    this->m_LinearSystem->SetMatrixSparsityPattern(rowPointers, columnIndices);
+  }
+  else
+  {
+    this->m_LinearSystem->InitializeMatrix();
+  }
+}
+
+template <unsigned int VDimension>
+void
+Solver<VDimension>::ComputeMatrixSparsityPattern(unsigned int                       N,
+                                                 LinearSystemWrapper::ColumnArray & rowPointers,
+                                                 LinearSystemWrapper::ColumnArray & columnIndices) const
+{
+  // Count the degrees of freedom of the elements that contain each degree of
+  // freedom, to collect the columns of all the rows in one array.
+  const unsigned int numberOfElements = m_FEMObject->GetNumberOfElements();
+  rowPointers.assign(N + 1, 0);
+  for (unsigned int i = 0; i < numberOfElements; ++i)
+  {
+    const Element * e = m_FEMObject->GetElement(i);
+    const unsigned int Ne = e->GetNumberOfDegreesOfFreedom();
+    for (unsigned int j = 0; j < Ne; ++j)
+    {
+      const Element::DegreeOfFreedomIDType dof = e->GetDegreeOfFreedom(j);
+      if (dof < N)
+      {
+        rowPointers[dof + 1] += Ne;
+      }
+    }
+  }
+  for (unsigned int row = 0; row < N; ++row)
+  {
+    rowPointers[row + 1] += rowPointers[row];
+  }
+
+  LinearSystemWrapper::ColumnArray allColumns(rowPointers[N]);
+  LinearSystemWrapper::ColumnArray rowEnds(rowPointers.begin(), rowPointers.end() - 1);
+  for (unsigned int i = 0; i < numberOfElements; ++i)
+  {
+    const Element * e = m_FEMObject->GetElement(i);
+    const unsigned int Ne = e->GetNumberOfDegreesOfFreedom();
+    for (unsigned int j = 0; j < Ne; ++j)
+    {
+      const Element::DegreeOfFreedomIDType dof = e->GetDegreeOfFreedom(j);
+      if (dof < N)
+      {
+        for (unsigned int k = 0; k < Ne; ++k)
+        {
+          allColumns[rowEnds[dof]++] = e->GetDegreeOfFreedom(k);
+        }
+      }
+    }
+  }
+
+  // Sort the columns of each row and remove the duplicates
+  columnIndices.clear();
+  columnIndices.reserve(allColumns.size());
+  unsigned int rowBegin = 0;
+  for (unsigned int row = 0; row < N; ++row)
+  {
+    const auto first = allColumns.begin() + rowBegin;
+    const auto last = allColumns.begin() + rowPointers[row + 1];
+    std::sort(first, last);
+    rowBegin = rowPointers[row + 1];
+    rowPointers[row] = static_cast<unsigned int>(columnIndices.size());
+    for (auto it = first; it != last; ++it)
+    {
+      if (*it < N && (columnIndices.size() == rowPointers[row] || columnIndices.back() != *it))
+      {
+        columnIndices.push_back(*it);
+      }
+    }
+  }
+  rowPointers[N] = static_cast<unsigned int>(columnIndices.size());
 }
 
 template <unsigned int VDimension>
@@ -310,6 +399,13 @@ Solver<VDimension>::AssembleElementMatrix(Element::Pointer e)
 
   e->GetStiffnessMatrix(Ke);
 
+  this->AddElementMatrix(e, Ke);
+}
+
+template <unsigned int VDimension>
+void
+Solver<VDimension>::AddElementMatrix(const Element * e, const Element::MatrixType & Ke, unsigned int matrixIndex)
+{
   // Same for number of DOF
   int Ne = e->GetNumberOfDegreesOfFreedom();
   // step over all rows in element matrix
@@ -330,12 +426,41 @@ Solver<VDimension>::AssembleElementMatrix(Element::Pointer e)
       // allocated in sparse matrix.
       if (Math::NotExactlyEquals(Ke[j][k], Float(0.0)))
       {
-        this->m_LinearSystem->AddMatrixValue(e->GetDegreeOfFreedom(j), e->GetDegreeOfFreedom(k), Ke[j][k]);
+        this->m_LinearSystem->AddMatrixValue(
+          e->GetDegreeOfFreedom(j), e->GetDegreeOfFreedom(k), Ke[j][k], matrixIndex);
       }
     }
   }
 }
 
+template <unsigned int VDimension>
+void
+Solver<VDimension>::AssembleElementStiffnessMatrices(unsigned int matrixIndex)
+{
+  // The element matrices are computed in parallel, but the linear system
+  // wrappers are not thread safe, so each block is added by this thread.
+  constexpr unsigned int elementsPerBlock = 4096;
+
+  const unsigned int               numberOfElements = m_FEMObject->GetNumberOfElements();
+  std::vector<Element::MatrixType> elementMatrices(std::min(numberOfElements, elementsPerBlock));
+  for (unsigned int blockBegin = 0; blockBegin < numberOfElements; blockBegin += elementsPerBlock)
+  {
+    const unsigned int blockEnd = std::min(blockBegin + elementsPerBlock, numberOfElements);
+    this->GetMultiThreader()->ParallelizeArray(
+      blockBegin,
+      blockEnd,
+      [this, blockBegin, &elementMatrices](SizeValueType i) {
+        m_FEMObject->GetElement(i)->GetStiffnessMatrix(elementMatrices[i - blockBegin]);
+      },
+      nullptr);
+
+    for (unsigned int i = blockBegin; i < blockEnd; ++i)
+    {
+      this->AddElementMatrix(m_FEMObject->GetElement(i), elementMatrices[i - blockBegin], matrixIndex);
+    }
+  }
+}
+
 template <unsigned int VDimension>
 void
 Solver<VDimension>::AssembleF(int dim)
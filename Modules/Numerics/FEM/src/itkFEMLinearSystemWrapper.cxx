@@ -160,6 +160,14 @@ LinearSystemWrapper::MultiplyMatrixSolution(unsigned int resultVector,
   }
 }
 
+void
+LinearSystemWrapper::SetMatrixSparsityPattern(const ColumnArray &, const ColumnArray &, unsigned int matrixIndex)
+{
+  // By default the pattern is only a hint, and the matrix grows as values
+  // are added
+  this->InitializeMatrix(matrixIndex);
+}
+
 void
 LinearSystemWrapper::GetColumnsOfNonZeroMatrixElementsInRow(unsigned int, ColumnArray & cols, unsigned int)
 {
@@ -0,0 +1,1172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFEMLinearSystemWrapperCSR.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace itk
+{
+namespace fem
+{
+namespace
+{
+// Number of rows of the ranges processed by the threads. Reductions are
+// summed per range, so this also fixes the order of the floating point
+// additions.
+constexpr unsigned int RowsPerChunk = 1024;
+
+using EntryType = std::pair<unsigned int, LinearSystemWrapperCSR::Float>;
+
+bool
+CompareEntryColumn(const EntryType & entry, unsigned int column)
+{
+  return entry.first < column;
+}
+
+// Make sure that the holder has room for index, and return its slot.
+template <typename THolder>
+typename THolder::value_type &
+HolderSlot(THolder & holder, unsigned int index)
+{
+  if (index >= holder.size())
+  {
+    holder.resize(index + 1);
+  }
+  return holder[index];
+}
+} // namespace
+
+std::ostream &
+operator<<(std::ostream & out, const LinearSystemWrapperCSREnums::SolverMethod value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case LinearSystemWrapperCSREnums::SolverMethod::ConjugateGradient:
+        return "itk::fem::LinearSystemWrapperCSREnums::SolverMethod::ConjugateGradient";
+      case LinearSystemWrapperCSREnums::SolverMethod::BiConjugateGradientStabilized:
+        return "itk::fem::LinearSystemWrapperCSREnums::SolverMethod::BiConjugateGradientStabilized";
+      case LinearSystemWrapperCSREnums::SolverMethod::MinimumResidual:
+        return "itk::fem::LinearSystemWrapperCSREnums::SolverMethod::MinimumResidual";
+      default:
+        return "INVALID VALUE FOR itk::fem::LinearSystemWrapperCSREnums::SolverMethod";
+    }
+  }();
+}
+
+std::ostream &
+operator<<(std::ostream & out, const LinearSystemWrapperCSREnums::Preconditioner value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case LinearSystemWrapperCSREnums::Preconditioner::None:
+        return "itk::fem::LinearSystemWrapperCSREnums::Preconditioner::None";
+      case LinearSystemWrapperCSREnums::Preconditioner::Jacobi:
+        return "itk::fem::LinearSystemWrapperCSREnums::Preconditioner::Jacobi";
+      case LinearSystemWrapperCSREnums::Preconditioner::IncompleteLU:
+        return "itk::fem::LinearSystemWrapperCSREnums::Preconditioner::IncompleteLU";
+      default:
+        return "INVALID VALUE FOR itk::fem::LinearSystemWrapperCSREnums::Preconditioner";
+    }
+  }();
+}
+
+LinearSystemWrapperCSR::LinearSystemWrapperCSR()
+  : m_MultiThreader(MultiThreaderBase::New())
+{}
+
+LinearSystemWrapperCSR::~LinearSystemWrapperCSR() = default;
+
+void
+LinearSystemWrapperCSR::InitializeMatrix(unsigned int matrixIndex)
+{
+  auto matrix = std::make_unique<MatrixRepresentation>();
+  matrix->RowPointers.assign(this->GetSystemOrder() + 1, 0);
+  matrix->PendingRows.resize(this->GetSystemOrder());
+  HolderSlot(m_Matrices, matrixIndex) = std::move(matrix);
+}
+
+bool
+LinearSystemWrapperCSR::IsMatrixInitialized(unsigned int matrixIndex)
+{
+  return matrixIndex < m_Matrices.size() && m_Matrices[matrixIndex] != nullptr;
+}
+
+void
+LinearSystemWrapperCSR::DestroyMatrix(unsigned int matrixIndex)
+{
+  if (matrixIndex < m_Matrices.size())
+  {
+    m_Matrices[matrixIndex].reset();
+  }
+}
+
+void
+LinearSystemWrapperCSR::InitializeVector(unsigned int vectorIndex)
+{
+  HolderSlot(m_Vectors, vectorIndex) = std::make_unique<VectorRepresentation>(this->GetSystemOrder(), 0.0);
+}
+
+bool
+LinearSystemWrapperCSR::IsVectorInitialized(unsigned int vectorIndex)
+{
+  return vectorIndex < m_Vectors.size() && m_Vectors[vectorIndex] != nullptr;
+}
+
+void
+LinearSystemWrapperCSR::DestroyVector(unsigned int vectorIndex)
+{
+  if (vectorIndex < m_Vectors.size())
+  {
+    m_Vectors[vectorIndex].reset();
+  }
+}
+
+void
+LinearSystemWrapperCSR::InitializeSolution(unsigned int solutionIndex)
+{
+  HolderSlot(m_Solutions, solutionIndex) = std::make_unique<VectorRepresentation>(this->GetSystemOrder(), 0.0);
+}
+
+bool
+LinearSystemWrapperCSR::IsSolutionInitialized(unsigned int solutionIndex)
+{
+  return solutionIndex < m_Solutions.size() && m_Solutions[solutionIndex] != nullptr;
+}
+
+void
+LinearSystemWrapperCSR::DestroySolution(unsigned int solutionIndex)
+{
+  if (solutionIndex < m_Solutions.size())
+  {
+    m_Solutions[solutionIndex].reset();
+  }
+}
+
+void
+LinearSystemWrapperCSR::SetMatrixSparsityPattern(const ColumnArray & rowPointers,
+                                                 const ColumnArray & columnIndices,
+                                                 unsigned int        matrixIndex)
+{
+  const unsigned int order = this->GetSystemOrder();
+  if (rowPointers.size() != order + 1 || rowPointers.front() != 0 || rowPointers.back() != columnIndices.size())
+  {
+    itkGenericExceptionMacro("LinearSystemWrapperCSR::SetMatrixSparsityPattern(): the row pointers do not match the "
+                             "order of the system and the number of column indices.");
+  }
+  for (unsigned int i = 0; i < order; ++i)
+  {
+    for (unsigned int k = rowPointers[i]; k < rowPointers[i + 1]; ++k)
+    {
+      if (columnIndices[k] >= order || (k > rowPointers[i] && columnIndices[k] <= columnIndices[k - 1]))
+      {
+        itkGenericExceptionMacro("LinearSystemWrapperCSR::SetMatrixSparsityPattern(): the columns of row "
+                                 << i << " are not increasing column indices of the system.");
+      }
+    }
+  }
+
+  auto matrix = std::make_unique<MatrixRepresentation>();
+  matrix->RowPointers = rowPointers;
+  matrix->ColumnIndices = columnIndices;
+  matrix->Values.assign(columnIndices.size(), 0.0);
+  matrix->PendingRows.resize(order);
+  HolderSlot(m_Matrices, matrixIndex) = std::move(matrix);
+}
+
+unsigned int
+LinearSystemWrapperCSR::GetNumberOfStoredValuesInMatrix(unsigned int matrixIndex) const
+{
+  const MatrixRepresentation & matrix = *m_Matrices[matrixIndex];
+  size_t                       numberOfValues = matrix.Values.size();
+  if (matrix.HasPendingEntries)
+  {
+    for (const auto & row : matrix.PendingRows)
+    {
+      numberOfValues += row.size();
+    }
+  }
+  return static_cast<unsigned int>(numberOfValues);
+}
+
+size_t
+LinearSystemWrapperCSR::FindCompressedPosition(const MatrixRepresentation & matrix, unsigned int i, unsigned int j)
+{
+  const auto rowBegin = matrix.ColumnIndices.begin() + matrix.RowPointers[i];
+  const auto rowEnd = matrix.ColumnIndices.begin() + matrix.RowPointers[i + 1];
+  const auto it = std::lower_bound(rowBegin, rowEnd, j);
+  if (it == rowEnd || *it != j)
+  {
+    return matrix.Values.size();
+  }
+  return static_cast<size_t>(it - matrix.ColumnIndices.begin());
+}
+
+LinearSystemWrapperCSR::Float
+LinearSystemWrapperCSR::GetMatrixValue(unsigned int i, unsigned int j, unsigned int matrixIndex) const
+{
+  const MatrixRepresentation & matrix = *m_Matrices[matrixIndex];
+  const size_t                 position = FindCompressedPosition(matrix, i, j);
+  if (position < matrix.Values.size())
+  {
+    return matrix.Values[position];
+  }
+  if (matrix.HasPendingEntries)
+  {
+    const auto & row = matrix.PendingRows[i];
+    const auto   it = std::lower_bound(row.begin(), row.end(), j, CompareEntryColumn);
+    if (it != row.end() && it->first == j)
+    {
+      return it->second;
+    }
+  }
+  return 0.0;
+}
+
+void
+LinearSystemWrapperCSR::SetMatrixValue(unsigned int i, unsigned int j, Float value, unsigned int matrixIndex)
+{
+  MatrixRepresentation & matrix = *m_Matrices[matrixIndex];
+  const size_t           position = FindCompressedPosition(matrix, i, j);
+  if (position < matrix.Values.size())
+  {
+    matrix.Values[position] = value;
+    return;
+  }
+  auto &     row = matrix.PendingRows[i];
+  const auto it = std::lower_bound(row.begin(), row.end(), j, CompareEntryColumn);
+  if (it != row.end() && it->first == j)
+  {
+    it->second = value;
+  }
+  else if (value != 0.0)
+  {
+    row.insert(it, EntryType(j, value));
+    matrix.HasPendingEntries = true;
+  }
+}
+
+void
+LinearSystemWrapperCSR::AddMatrixValue(unsigned int i, unsigned int j, Float value, unsigned int matrixIndex)
+{
+  MatrixRepresentation & matrix = *m_Matrices[matrixIndex];
+  const size_t           position = FindCompressedPosition(matrix, i, j);
+  if (position < matrix.Values.size())
+  {
+    matrix.Values[position] += value;
+    return;
+  }
+  auto &     row = matrix.PendingRows[i];
+  const auto it = std::lower_bound(row.begin(), row.end(), j, CompareEntryColumn);
+  if (it != row.end() && it->first == j)
+  {
+    it->second += value;
+  }
+  else
+  {
+    row.insert(it, EntryType(j, value));
+    matrix.HasPendingEntries = true;
+  }
+}
+
+void
+LinearSystemWrapperCSR::CompressMatrix(MatrixRepresentation & matrix) const
+{
+  if (!matrix.HasPendingEntries)
+  {
+    return;
+  }
+
+  const unsigned int order = this->GetSystemOrder();
+  size_t             numberOfValues = matrix.Values.size();
+  for (const auto & row : matrix.PendingRows)
+  {
+    numberOfValues += row.size();
+  }
+
+  ColumnArray        rowPointers(order + 1);
+  ColumnArray        columnIndices;
+  std::vector<Float> values;
+  columnIndices.reserve(numberOfValues);
+  values.reserve(numberOfValues);
+
+  // Merge the sorted compressed and pending entries of each row. They never
+  // have a column in common.
+  rowPointers[0] = 0;
+  for (unsigned int i = 0; i < order; ++i)
+  {
+    auto &       pendingRow = matrix.PendingRows[i];
+    auto         pending = pendingRow.cbegin();
+    unsigned int k = matrix.RowPointers[i];
+    while (k < matrix.RowPointers[i + 1] || pending != pendingRow.cend())
+    {
+      if (pending == pendingRow.cend() || (k < matrix.RowPointers[i + 1] && matrix.ColumnIndices[k] < pending->first))
+      {
+        columnIndices.push_back(matrix.ColumnIndices[k]);
+        values.push_back(matrix.Values[k]);
+        ++k;
+      }
+      else
+      {
+        columnIndices.push_back(pending->first);
+        values.push_back(pending->second);
+        ++pending;
+      }
+    }
+    pendingRow.clear();
+    rowPointers[i + 1] = static_cast<unsigned int>(columnIndices.size());
+  }
+
+  matrix.RowPointers.swap(rowPointers);
+  matrix.ColumnIndices.swap(columnIndices);
+  matrix.Values.swap(values);
+  matrix.HasPendingEntries = false;
+}
+
+void
+LinearSystemWrapperCSR::GetColumnsOfNonZeroMatrixElementsInRow(unsigned int  row,
+                                                               ColumnArray & cols,
+                                                               unsigned int  matrixIndex)
+{
+  MatrixRepresentation & matrix = *m_Matrices[matrixIndex];
+  this->CompressMatrix(matrix);
+  cols.assign(matrix.ColumnIndices.begin() + matrix.RowPointers[row],
+              matrix.ColumnIndices.begin() + matrix.RowPointers[row + 1]);
+}
+
+LinearSystemWrapperCSR::Float
+LinearSystemWrapperCSR::GetSolutionValue(unsigned int i, unsigned int solutionIndex) const
+{
+  if (solutionIndex >= m_Solutions.size() || m_Solutions[solutionIndex] == nullptr ||
+      m_Solutions[solutionIndex]->size() <= i)
+  {
+    return 0.0;
+  }
+  return (*m_Solutions[solutionIndex])[i];
+}
+
+template <typename TFunction>
+void
+LinearSystemWrapperCSR::ParallelizeRows(const TFunction & function) const
+{
+  const unsigned int order = this->GetSystemOrder();
+  const unsigned int numberOfChunks = (order + RowsPerChunk - 1) / RowsPerChunk;
+  if (numberOfChunks <= 1)
+  {
+    function(0u, order);
+    return;
+  }
+  m_MultiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&function, order](SizeValueType chunk) {
+      const auto first = static_cast<unsigned int>(chunk * RowsPerChunk);
+      function(first, std::min(first + RowsPerChunk, order));
+    },
+    nullptr);
+}
+
+template <typename TFunction>
+double
+LinearSystemWrapperCSR::ReduceRows(const TFunction & function) const
+{
+  const unsigned int order = this->GetSystemOrder();
+  if (order == 0)
+  {
+    return 0.0;
+  }
+  std::vector<double> partialSums((order + RowsPerChunk - 1) / RowsPerChunk, 0.0);
+  this->ParallelizeRows([&function, &partialSums](unsigned int first, unsigned int end) {
+    partialSums[first / RowsPerChunk] = function(first, end);
+  });
+
+  double sum = 0.0;
+  for (const double partialSum : partialSums)
+  {
+    sum += partialSum;
+  }
+  return sum;
+}
+
+void
+LinearSystemWrapperCSR::Multiply(const MatrixRepresentation & matrix, const Float * x, Float * y) const
+{
+  this->ParallelizeRows([&matrix, x, y](unsigned int first, unsigned int end) {
+    for (unsigned int i = first; i < end; ++i)
+    {
+      Float sum = 0.0;
+      for (unsigned int k = matrix.RowPointers[i]; k < matrix.RowPointers[i + 1]; ++k)
+      {
+        sum += matrix.Values[k] * x[matrix.ColumnIndices[k]];
+      }
+      y[i] = sum;
+    }
+  });
+}
+
+double
+LinearSystemWrapperCSR::Dot(const VectorRepresentation & x, const VectorRepresentation & y) const
+{
+  return this->ReduceRows([&x, &y](unsigned int first, unsigned int end) {
+    double sum = 0.0;
+    for (unsigned int i = first; i < end; ++i)
+    {
+      sum += x[i] * y[i];
+    }
+    return sum;
+  });
+}
+
+void
+LinearSystemWrapperCSR::InitializePreconditioner(const MatrixRepresentation & matrix)
+{
+  const unsigned int order = this->GetSystemOrder();
+
+  if (m_Preconditioner == PreconditionerEnum::Jacobi)
+  {
+    m_PreconditionerValues.resize(order);
+    this->ParallelizeRows([this, &matrix](unsigned int first, unsigned int end) {
+      for (unsigned int i = first; i < end; ++i)
+      {
+        const size_t position = FindCompressedPosition(matrix, i, i);
+        const Float  diagonal = position < matrix.Values.size() ? matrix.Values[position] : 0.0;
+        m_PreconditionerValues[i] = diagonal != 0.0 ? 1.0 / diagonal : 1.0;
+      }
+    });
+  }
+  else if (m_Preconditioner == PreconditionerEnum::IncompleteLU)
+  {
+    // Factorize in the pattern of the matrix: L has a unit diagonal and is
+    // stored below the diagonal, U on and above the diagonal.
+    m_PreconditionerValues = matrix.Values;
+    m_DiagonalPositions.resize(order);
+    for (unsigned int i = 0; i < order; ++i)
+    {
+      const auto rowBegin = matrix.ColumnIndices.begin() + matrix.RowPointers[i];
+      const auto rowEnd = matrix.ColumnIndices.begin() + matrix.RowPointers[i + 1];
+      const auto it = std::lower_bound(rowBegin, rowEnd, i);
+      if (it == rowEnd || *it != i)
+      {
+        itkGenericExceptionMacro("LinearSystemWrapperCSR::Solve(): ILU(0) preconditioner requires diagonal entry "
+                                 << i << " in the matrix.");
+      }
+      m_DiagonalPositions[i] = static_cast<unsigned int>(it - matrix.ColumnIndices.begin());
+    }
+
+    Float * values = m_PreconditionerValues.data();
+    for (unsigned int i = 0; i < order; ++i)
+    {
+      const unsigned int rowEnd = matrix.RowPointers[i + 1];
+      for (unsigned int ik = matrix.RowPointers[i]; ik < m_DiagonalPositions[i]; ++ik)
+      {
+        const unsigned int k = matrix.ColumnIndices[ik];
+        values[ik] /= values[m_DiagonalPositions[k]];
+
+        // Subtract l_ik times row k of U from the entries of row i that are in
+        // the pattern. Both rows are sorted by column.
+        unsigned int ij = ik + 1;
+        for (unsigned int kj = m_DiagonalPositions[k] + 1; kj < matrix.RowPointers[k + 1] && ij < rowEnd; ++kj)
+        {
+          const unsigned int j = matrix.ColumnIndices[kj];
+          while (ij < rowEnd && matrix.ColumnIndices[ij] < j)
+          {
+            ++ij;
+          }
+          if (ij < rowEnd && matrix.ColumnIndices[ij] == j)
+          {
+            values[ij] -= values[ik] * values[kj];
+          }
+        }
+      }
+      if (values[m_DiagonalPositions[i]] == 0.0)
+      {
+        itkGenericExceptionMacro("LinearSystemWrapperCSR::Solve(): zero pivot in row "
+                                 << i << " of the ILU(0) preconditioner.");
+      }
+    }
+  }
+}
+
+void
+LinearSystemWrapperCSR::ApplyPreconditioner(const MatrixRepresentation & matrix,
+                                            const VectorRepresentation & r,
+                                            VectorRepresentation &       z) const
+{
+  switch (m_Preconditioner)
+  {
+    case PreconditionerEnum::Jacobi:
+      this->ParallelizeRows([this, &r, &z](unsigned int first, unsigned int end) {
+        for (unsigned int i = first; i < end; ++i)
+        {
+          z[i] = r[i] * m_PreconditionerValues[i];
+        }
+      });
+      break;
+    case PreconditionerEnum::IncompleteLU:
+    {
+      const unsigned int order = this->GetSystemOrder();
+      const Float *      values = m_PreconditionerValues.data();
+      // Solve L y = r, then U z = y.
+      for (unsigned int i = 0; i < order; ++i)
+      {
+        Float sum = r[i];
+        for (unsigned int k = matrix.RowPointers[i]; k < m_DiagonalPositions[i]; ++k)
+        {
+          sum -= values[k] * z[matrix.ColumnIndices[k]];
+        }
+        z[i] = sum;
+      }
+      for (unsigned int i = order; i-- > 0;)
+      {
+        Float sum = z[i];
+        for (unsigned int k = m_DiagonalPositions[i] + 1; k < matrix.RowPointers[i + 1]; ++k)
+        {
+          sum -= values[k] * z[matrix.ColumnIndices[k]];
+        }
+        z[i] = sum / values[m_DiagonalPositions[i]];
+      }
+      break;
+    }
+    default:
+      z = r;
+      break;
+  }
+}
+
+void
+LinearSystemWrapperCSR::Solve()
+{
+  if (!this->IsMatrixInitialized(0) || !this->IsVectorInitialized(0))
+  {
+    itkGenericExceptionMacro("LinearSystemWrapperCSR::Solve(): matrix 0 and vector 0 must be initialized.");
+  }
+  if (!this->IsSolutionInitialized(0))
+  {
+    this->InitializeSolution(0);
+  }
+
+  MatrixRepresentation & matrix = *m_Matrices[0];
+  this->CompressMatrix(matrix);
+
+  VectorRepresentation & x = *m_Solutions[0];
+  x.resize(this->GetSystemOrder(), 0.0);
+
+  // The conjugate gradient method diverges on indefinite matrices, such as
+  // the ones of the Lagrange multipliers of the multi freedom constraints.
+  m_SolverMethodOfLastSolve = m_SolverMethod;
+  if (m_SolverMethod == SolverMethodEnum::ConjugateGradient && !this->HasPositiveDiagonal(matrix))
+  {
+    m_SolverMethodOfLastSolve = SolverMethodEnum::MinimumResidual;
+  }
+
+  switch (m_SolverMethodOfLastSolve)
+  {
+    case SolverMethodEnum::BiConjugateGradientStabilized:
+      this->InitializePreconditioner(matrix);
+      this->BiConjugateGradientStabilized(matrix, *m_Vectors[0], x);
+      break;
+    case SolverMethodEnum::MinimumResidual:
+      this->MinimumResidual(matrix, *m_Vectors[0], x);
+      break;
+    default:
+      this->InitializePreconditioner(matrix);
+      this->ConjugateGradient(matrix, *m_Vectors[0], x);
+      break;
+  }
+
+  if (!(m_RelativeResidualNorm <= m_Tolerance))
+  {
+    std::ostringstream description;
+    description << "The iterations did not converge: relative residual norm " << m_RelativeResidualNorm << " after "
+                << m_NumberOfIterations << " iterations.";
+    throw FEMExceptionLinearSystem(__FILE__, __LINE__, "LinearSystemWrapperCSR::Solve", description.str());
+  }
+}
+
+bool
+LinearSystemWrapperCSR::HasPositiveDiagonal(const MatrixRepresentation & matrix) const
+{
+  const double numberOfNonPositiveDiagonalEntries =
+    this->ReduceRows([&matrix](unsigned int first, unsigned int end) {
+      double count = 0.0;
+      for (unsigned int i = first; i < end; ++i)
+      {
+        const size_t position = FindCompressedPosition(matrix, i, i);
+        if (position >= matrix.Values.size() || !(matrix.Values[position] > 0.0))
+        {
+          ++count;
+        }
+      }
+      return count;
+    });
+  return numberOfNonPositiveDiagonalEntries == 0.0;
+}
+
+void
+LinearSystemWrapperCSR::ConjugateGradient(const MatrixRepresentation & matrix,
+                                          const VectorRepresentation & b,
+                                          VectorRepresentation &       x)
+{
+  const unsigned int order = this->GetSystemOrder();
+  const unsigned int maximumNumberOfIterations =
+    m_MaximumNumberOfIterations > 0 ? m_MaximumNumberOfIterations : 3 * order;
+
+  m_NumberOfIterations = 0;
+  m_RelativeResidualNorm = 0.0;
+
+  const double bNorm = std::sqrt(this->Dot(b, b));
+  if (bNorm == 0.0)
+  {
+    std::fill(x.begin(), x.end(), 0.0);
+    return;
+  }
+
+  VectorRepresentation r(order);
+  VectorRepresentation z(order);
+  VectorRepresentation p(order);
+  VectorRepresentation q(order);
+
+  // r = b - A x
+  this->Multiply(matrix, x.data(), q.data());
+  double rNorm = std::sqrt(this->ReduceRows([&b, &q, &r](unsigned int first, unsigned int end) {
+    double sum = 0.0;
+    for (unsigned int i = first; i < end; ++i)
+    {
+      r[i] = b[i] - q[i];
+      sum += r[i] * r[i];
+    }
+    return sum;
+  }));
+
+  this->ApplyPreconditioner(matrix, r, z);
+  p = z;
+  double rz = this->Dot(r, z);
+
+  while (rNorm > m_Tolerance * bNorm && m_NumberOfIterations < maximumNumberOfIterations)
+  {
+    this->Multiply(matrix, p.data(), q.data());
+    const double pq = this->Dot(p, q);
+    if (pq == 0.0 || !std::isfinite(pq))
+    {
+      break;
+    }
+    const double alpha = rz / pq;
+
+    // x += alpha p, r -= alpha q
+    rNorm = std::sqrt(this->ReduceRows([alpha, &p, &q, &r, &x](unsigned int first, unsigned int end) {
+      double sum = 0.0;
+      for (unsigned int i = first; i < end; ++i)
+      {
+        x[i] += alpha * p[i];
+        r[i] -= alpha * q[i];
+        sum += r[i] * r[i];
+      }
+      return sum;
+    }));
+    ++m_NumberOfIterations;
+
+    this->ApplyPreconditioner(matrix, r, z);
+    const double rzNext = this->Dot(r, z);
+    const double beta = rzNext / rz;
+    rz = rzNext;
+
+    // p = z + beta p
+    this->ParallelizeRows([beta, &p, &z](unsigned int first, unsigned int end) {
+      for (unsigned int i = first; i < end; ++i)
+      {
+        p[i] = z[i] + beta * p[i];
+      }
+    });
+  }
+
+  m_RelativeResidualNorm = rNorm / bNorm;
+}
+
+void
+LinearSystemWrapperCSR::BiConjugateGradientStabilized(const MatrixRepresentation & matrix,
+                                                      const VectorRepresentation & b,
+                                                      VectorRepresentation &       x)
+{
+  const unsigned int order = this->GetSystemOrder();
+  const unsigned int maximumNumberOfIterations =
+    m_MaximumNumberOfIterations > 0 ? m_MaximumNumberOfIterations : 3 * order;
+
+  m_NumberOfIterations = 0;
+  m_RelativeResidualNorm = 0.0;
+
+  const double bNorm = std::sqrt(this->Dot(b, b));
+  if (bNorm == 0.0)
+  {
+    std::fill(x.begin(), x.end(), 0.0);
+    return;
+  }
+
+  VectorRepresentation r(order);
+  VectorRepresentation p(order, 0.0);
+  VectorRepresentation v(order, 0.0);
+  VectorRepresentation s(order);
+  VectorRepresentation t(order);
+  VectorRepresentation preconditioned(order);
+
+  // r = b - A x
+  this->Multiply(matrix, x.data(), t.data());
+  double rNorm = std::sqrt(this->ReduceRows([&b, &t, &r](unsigned int first, unsigned int end) {
+    double sum = 0.0;
+    for (unsigned int i = first; i < end; ++i)
+    {
+      r[i] = b[i] - t[i];
+      sum += r[i] * r[i];
+    }
+    return sum;
+  }));
+  const VectorRepresentation shadowResidual = r;
+
+  double rho = 1.0;
+  double alpha = 1.0;
+  double omega = 1.0;
+
+  while (rNorm > m_Tolerance * bNorm && m_NumberOfIterations < maximumNumberOfIterations)
+  {
+    const double rhoNext = this->Dot(shadowResidual, r);
+    if (rhoNext == 0.0 || !std::isfinite(rhoNext))
+    {
+      break;
+    }
+    const double beta = (rhoNext / rho) * (alpha / omega);
+    rho = rhoNext;
+
+    // p = r + beta (p - omega v)
+    this->ParallelizeRows([beta, omega, &p, &r, &v](unsigned int first, unsigned int end) {
+      for (unsigned int i = first; i < end; ++i)
+      {
+        p[i] = r[i] + beta * (p[i] - omega * v[i]);
+      }
+    });
+
+    this->ApplyPreconditioner(matrix, p, preconditioned);
+    this->Multiply(matrix, preconditioned.data(), v.data());
+    const double shadowV = this->Dot(shadowResidual, v);
+    if (shadowV == 0.0 || !std::isfinite(shadowV))
+    {
+      break;
+    }
+    alpha = rho / shadowV;
+
+    // x += alpha M^-1 p, s = r - alpha v
+    const double sNorm =
+      std::sqrt(this->ReduceRows([alpha, &preconditioned, &r, &s, &v, &x](unsigned int first, unsigned int end) {
+        double sum = 0.0;
+        for (unsigned int i = first; i < end; ++i)
+        {
+          x[i] += alpha * preconditioned[i];
+          s[i] = r[i] - alpha * v[i];
+          sum += s[i] * s[i];
+        }
+        return sum;
+      }));
+    ++m_NumberOfIterations;
+    if (sNorm <= m_Tolerance * bNorm)
+    {
+      rNorm = sNorm;
+      break;
+    }
+
+    this->ApplyPreconditioner(matrix, s, preconditioned);
+    this->Multiply(matrix, preconditioned.data(), t.data());
+    const double tt = this->Dot(t, t);
+    omega = tt > 0.0 ? this->Dot(t, s) / tt : 0.0;
+    if (omega == 0.0 || !std::isfinite(omega))
+    {
+      rNorm = sNorm;
+      break;
+    }
+
+    // x += omega M^-1 s, r = s - omega t
+    rNorm = std::sqrt(this->ReduceRows([omega, &preconditioned, &r, &s, &t, &x](unsigned int first, unsigned int end) {
+      double sum = 0.0;
+      for (unsigned int i = first; i < end; ++i)
+      {
+        x[i] += omega * preconditioned[i];
+        r[i] = s[i] - omega * t[i];
+        sum += r[i] * r[i];
+      }
+      return sum;
+    }));
+  }
+
+  m_RelativeResidualNorm = rNorm / bNorm;
+}
+
+void
+LinearSystemWrapperCSR::MinimumResidual(const MatrixRepresentation & matrix,
+                                        const VectorRepresentation & b,
+                                        VectorRepresentation &       x)
+{
+  const unsigned int order = this->GetSystemOrder();
+  const unsigned int maximumNumberOfIterations =
+    m_MaximumNumberOfIterations > 0 ? m_MaximumNumberOfIterations : 3 * order;
+
+  m_NumberOfIterations = 0;
+  m_RelativeResidualNorm = 0.0;
+
+  const double bNorm = std::sqrt(this->Dot(b, b));
+  if (bNorm == 0.0)
+  {
+    std::fill(x.begin(), x.end(), 0.0);
+    return;
+  }
+
+  // The preconditioner of MINRES must be symmetric positive definite: the
+  // inverse of the absolute value of the diagonal, whatever the preconditioner
+  // other than None.
+  VectorRepresentation inverseDiagonal(order, 1.0);
+  if (m_Preconditioner != PreconditionerEnum::None)
+  {
+    this->ParallelizeRows([&matrix, &inverseDiagonal](unsigned int first, unsigned int end) {
+      for (unsigned int i = first; i < end; ++i)
+      {
+        const size_t position = FindCompressedPosition(matrix, i, i);
+        const Float  diagonal = position < matrix.Values.size() ? std::abs(matrix.Values[position]) : 0.0;
+        inverseDiagonal[i] = diagonal != 0.0 ? 1.0 / diagonal : 1.0;
+      }
+    });
+  }
+
+  VectorRepresentation r1(order);
+  VectorRepresentation r2(order);
+  VectorRepresentation y(order);
+  VectorRepresentation v(order);
+  VectorRepresentation w(order);
+  VectorRepresentation w1(order);
+  VectorRepresentation w2(order);
+
+  // r1 = b - A x, returns the norm of r1
+  const auto computeResidual = [this, &matrix, &b, &x, &r1, &y]() {
+    this->Multiply(matrix, x.data(), y.data());
+    return std::sqrt(this->ReduceRows([&b, &r1, &y](unsigned int first, unsigned int end) {
+      double sum = 0.0;
+      for (unsigned int i = first; i < end; ++i)
+      {
+        r1[i] = b[i] - y[i];
+        sum += r1[i] * r1[i];
+      }
+      return sum;
+    }));
+  };
+
+  // y = D r
+  const auto precondition = [this, &inverseDiagonal](const VectorRepresentation & r, VectorRepresentation & z) {
+    this->ParallelizeRows([&inverseDiagonal, &r, &z](unsigned int first, unsigned int end) {
+      for (unsigned int i = first; i < end; ++i)
+      {
+        z[i] = inverseDiagonal[i] * r[i];
+      }
+    });
+  };
+
+  // The norm of the residual is estimated in the norm of the preconditioner
+  // during the iterations. When the estimate converged, but not the residual
+  // itself, MINRES restarts from the current solution.
+  double rNorm = computeResidual();
+  while (rNorm > m_Tolerance * bNorm && m_NumberOfIterations < maximumNumberOfIterations)
+  {
+    r2 = r1;
+    precondition(r1, y);
+    const double beta1 = std::sqrt(this->Dot(r1, y));
+    if (beta1 == 0.0 || !std::isfinite(beta1))
+    {
+      break;
+    }
+    const double targetEstimate = beta1 * m_Tolerance * bNorm / rNorm;
+
+    double oldBeta = 0.0;
+    double beta = beta1;
+    double dBar = 0.0;
+    double epsilon = 0.0;
+    double phiBar = beta1;
+    double cs = -1.0;
+    double sn = 0.0;
+    std::fill(w.begin(), w.end(), 0.0);
+    std::fill(w2.begin(), w2.end(), 0.0);
+
+    unsigned int cycleIterations = 0;
+    while (phiBar > targetEstimate && m_NumberOfIterations < maximumNumberOfIterations)
+    {
+      // Lanczos step: v = y / beta, y = A v - (beta / oldBeta) r1 - (alpha / beta) r2
+      const double inverseBeta = 1.0 / beta;
+      this->ParallelizeRows([inverseBeta, &v, &y](unsigned int first, unsigned int end) {
+        for (unsigned int i = first; i < end; ++i)
+        {
+          v[i] = inverseBeta * y[i];
+        }
+      });
+      this->Multiply(matrix, v.data(), y.data());
+      if (cycleIterations > 0)
+      {
+        const double scale = beta / oldBeta;
+        this->ParallelizeRows([scale, &r1, &y](unsigned int first, unsigned int end) {
+          for (unsigned int i = first; i < end; ++i)
+          {
+            y[i] -= scale * r1[i];
+          }
+        });
+      }
+      const double alpha = this->Dot(v, y);
+      const double scale = alpha / beta;
+      this->ParallelizeRows([scale, &r2, &y](unsigned int first, unsigned int end) {
+        for (unsigned int i = first; i < end; ++i)
+        {
+          y[i] -= scale * r2[i];
+        }
+      });
+      // r1 = r2, r2 = y, y = D r2
+      std::swap(r1, r2);
+      std::swap(r2, y);
+      precondition(r2, y);
+      oldBeta = beta;
+      beta = std::sqrt(this->Dot(r2, y));
+
+      // Apply the previous rotation, and compute the next one
+      const double oldEpsilon = epsilon;
+      const double delta = cs * dBar + sn * alpha;
+      const double gBar = sn * dBar - cs * alpha;
+      epsilon = sn * beta;
+      dBar = -cs * beta;
+      const double gamma = std::max(std::hypot(gBar, beta), std::numeric_limits<double>::epsilon());
+      cs = gBar / gamma;
+      sn = beta / gamma;
+      const double phi = cs * phiBar;
+      phiBar = sn * phiBar;
+
+      // w = (v - oldEpsilon w1 - delta w2) / gamma, x += phi w
+      std::swap(w1, w2);
+      std::swap(w2, w);
+      this->ParallelizeRows(
+        [gamma, oldEpsilon, delta, phi, &v, &w, &w1, &w2, &x](unsigned int first, unsigned int end) {
+          for (unsigned int i = first; i < end; ++i)
+          {
+            w[i] = (v[i] - oldEpsilon * w1[i] - delta * w2[i]) / gamma;
+            x[i] += phi * w[i];
+          }
+        });
+      ++cycleIterations;
+      ++m_NumberOfIterations;
+
+      if (beta == 0.0 || !std::isfinite(beta))
+      {
+        // The Krylov space is exhausted
+        break;
+      }
+    }
+
+    rNorm = computeResidual();
+    if (cycleIterations == 0)
+    {
+      break;
+    }
+  }
+
+  m_RelativeResidualNorm = rNorm / bNorm;
+}
+
+void
+LinearSystemWrapperCSR::ScaleMatrix(Float scale, unsigned int matrixIndex)
+{
+  MatrixRepresentation & matrix = *m_Matrices[matrixIndex];
+  for (auto & value : matrix.Values)
+  {
+    value *= scale;
+  }
+  if (matrix.HasPendingEntries)
+  {
+    for (auto & row : matrix.PendingRows)
+    {
+      for (auto & entry : row)
+      {
+        entry.second *= scale;
+      }
+    }
+  }
+}
+
+void
+LinearSystemWrapperCSR::SwapMatrices(unsigned int matrixIndex1, unsigned int matrixIndex2)
+{
+  std::swap(HolderSlot(m_Matrices, matrixIndex1), HolderSlot(m_Matrices, matrixIndex2));
+}
+
+void
+LinearSystemWrapperCSR::CopyMatrix(unsigned int matrixIndex1, unsigned int matrixIndex2)
+{
+  MatrixRepresentation & source = *m_Matrices[matrixIndex1];
+  this->CompressMatrix(source);
+  HolderSlot(m_Matrices, matrixIndex2) = std::make_unique<MatrixRepresentation>(source);
+}
+
+void
+LinearSystemWrapperCSR::AddMatrixMatrix(unsigned int matrixIndex1, unsigned int matrixIndex2)
+{
+  MatrixRepresentation & matrix1 = *m_Matrices[matrixIndex1];
+  MatrixRepresentation & matrix2 = *m_Matrices[matrixIndex2];
+  this->CompressMatrix(matrix1);
+  this->CompressMatrix(matrix2);
+
+  if (matrix1.RowPointers == matrix2.RowPointers && matrix1.ColumnIndices == matrix2.ColumnIndices)
+  {
+    for (size_t k = 0; k < matrix1.Values.size(); ++k)
+    {
+      matrix1.Values[k] += matrix2.Values[k];
+    }
+    return;
+  }
+
+  // Add the entries of matrix2 outside of the pattern of matrix1 as pending
+  // entries, then merge them.
+  for (unsigned int i = 0; i < this->GetSystemOrder(); ++i)
+  {
+    for (unsigned int k = matrix2.RowPointers[i]; k < matrix2.RowPointers[i + 1]; ++k)
+    {
+      this->AddMatrixValue(i, matrix2.ColumnIndices[k], matrix2.Values[k], matrixIndex1);
+    }
+  }
+  this->CompressMatrix(matrix1);
+}
+
+void
+LinearSystemWrapperCSR::SwapVectors(unsigned int vectorIndex1, unsigned int vectorIndex2)
+{
+  std::swap(HolderSlot(m_Vectors, vectorIndex1), HolderSlot(m_Vectors, vectorIndex2));
+}
+
+void
+LinearSystemWrapperCSR::SwapSolutions(unsigned int solutionIndex1, unsigned int solutionIndex2)
+{
+  std::swap(HolderSlot(m_Solutions, solutionIndex1), HolderSlot(m_Solutions, solutionIndex2));
+}
+
+void
+LinearSystemWrapperCSR::CopySolution2Vector(unsigned int solutionIndex, unsigned int vectorIndex)
+{
+  HolderSlot(m_Vectors, vectorIndex) = std::make_unique<VectorRepresentation>(*m_Solutions[solutionIndex]);
+}
+
+void
+LinearSystemWrapperCSR::CopyVector2Solution(unsigned int vectorIndex, unsigned int solutionIndex)
+{
+  HolderSlot(m_Solutions, solutionIndex) = std::make_unique<VectorRepresentation>(*m_Vectors[vectorIndex]);
+}
+
+void
+LinearSystemWrapperCSR::CopyVector(unsigned int vectorSource, unsigned int vectorDestination)
+{
+  HolderSlot(m_Vectors, vectorDestination) = std::make_unique<VectorRepresentation>(*m_Vectors[vectorSource]);
+}
+
+void
+LinearSystemWrapperCSR::AddVectorVector(unsigned int vectorIndex1, unsigned int vectorIndex2)
+{
+  VectorRepresentation &       vector1 = *m_Vectors[vectorIndex1];
+  const VectorRepresentation & vector2 = *m_Vectors[vectorIndex2];
+  for (size_t i = 0; i < vector1.size(); ++i)
+  {
+    vector1[i] += vector2[i];
+  }
+}
+
+void
+LinearSystemWrapperCSR::MultiplyMatrixMatrix(unsigned int resultMatrixIndex,
+                                             unsigned int leftMatrixIndex,
+                                             unsigned int rightMatrixIndex)
+{
+  MatrixRepresentation & left = *m_Matrices[leftMatrixIndex];
+  MatrixRepresentation & right = *m_Matrices[rightMatrixIndex];
+  this->CompressMatrix(left);
+  this->CompressMatrix(right);
+
+  // Row by row product, accumulating each row of the result in a dense row.
+  const unsigned int order = this->GetSystemOrder();
+  auto               result = std::make_unique<MatrixRepresentation>();
+  result->RowPointers.assign(order + 1, 0);
+  result->PendingRows.resize(order);
+
+  std::vector<Float>        accumulator(order, 0.0);
+  std::vector<unsigned int> rowOfColumn(order, order);
+  ColumnArray               columns;
+  for (unsigned int i = 0; i < order; ++i)
+  {
+    columns.clear();
+    for (unsigned int ik = left.RowPointers[i]; ik < left.RowPointers[i + 1]; ++ik)
+    {
+      const unsigned int k = left.ColumnIndices[ik];
+      for (unsigned int kj = right.RowPointers[k]; kj < right.RowPointers[k + 1]; ++kj)
+      {
+        const unsigned int j = right.ColumnIndices[kj];
+        if (rowOfColumn[j] != i)
+        {
+          rowOfColumn[j] = i;
+          accumulator[j] = 0.0;
+          columns.push_back(j);
+        }
+        accumulator[j] += left.Values[ik] * right.Values[kj];
+      }
+    }
+    std::sort(columns.begin(), columns.end());
+    for (const unsigned int j : columns)
+    {
+      result->ColumnIndices.push_back(j);
+      result->Values.push_back(accumulator[j]);
+    }
+    result->RowPointers[i + 1] = static_cast<unsigned int>(result->ColumnIndices.size());
+  }
+
+  HolderSlot(m_Matrices, resultMatrixIndex) = std::move(result);
+}
+
+void
+LinearSystemWrapperCSR::MultiplyMatrixVector(unsigned int resultVectorIndex,
+                                             unsigned int matrixIndex,
+                                             unsigned int vectorIndex)
+{
+  MatrixRepresentation & matrix = *m_Matrices[matrixIndex];
+  this->CompressMatrix(matrix);
+
+  auto result = std::make_unique<VectorRepresentation>(this->GetSystemOrder());
+  this->Multiply(matrix, m_Vectors[vectorIndex]->data(), result->data());
+  HolderSlot(m_Vectors, resultVectorIndex) = std::move(result);
+}
+
+void
+LinearSystemWrapperCSR::MultiplyMatrixSolution(unsigned int resultVectorIndex,
+                                               unsigned int matrixIndex,
+                                               unsigned int solutionIndex)
+{
+  MatrixRepresentation & matrix = *m_Matrices[matrixIndex];
+  this->CompressMatrix(matrix);
+
+  auto result = std::make_unique<VectorRepresentation>(this->GetSystemOrder());
+  this->Multiply(matrix, m_Solutions[solutionIndex]->data(), result->data());
+  HolderSlot(m_Vectors, resultVectorIndex) = std::move(result);
+}
+
+} // end namespace fem
+} // end namespace itk
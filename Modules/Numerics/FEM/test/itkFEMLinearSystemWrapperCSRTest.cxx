@@ -0,0 +1,377 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFEMLinearSystemWrapperCSR.h"
+#include "itkTestingMacros.h"
+#include <iostream>
+
+namespace
+{
+using WrapperType = itk::fem::LinearSystemWrapperCSR;
+using ColumnArray = WrapperType::ColumnArray;
+
+// Five point stencil of -laplacian + shift on a gridSize x gridSize grid,
+// plus convection * first difference along x, which makes it nonsymmetric.
+void
+FillGridMatrix(WrapperType & system, unsigned int gridSize, double shift, double convection, bool usePattern)
+{
+  const unsigned int order = gridSize * gridSize;
+  system.SetSystemOrder(order);
+  if (usePattern)
+  {
+    ColumnArray rowPointers(1, 0);
+    ColumnArray columnIndices;
+    for (unsigned int y = 0; y < gridSize; ++y)
+    {
+      for (unsigned int x = 0; x < gridSize; ++x)
+      {
+        const unsigned int i = x + gridSize * y;
+        if (y > 0)
+        {
+          columnIndices.push_back(i - gridSize);
+        }
+        if (x > 0)
+        {
+          columnIndices.push_back(i - 1);
+        }
+        columnIndices.push_back(i);
+        if (x + 1 < gridSize)
+        {
+          columnIndices.push_back(i + 1);
+        }
+        if (y + 1 < gridSize)
+        {
+          columnIndices.push_back(i + gridSize);
+        }
+        rowPointers.push_back(static_cast<unsigned int>(columnIndices.size()));
+      }
+    }
+    system.SetMatrixSparsityPattern(rowPointers, columnIndices, 0);
+  }
+  else
+  {
+    system.InitializeMatrix(0);
+  }
+  system.InitializeVector(0);
+  system.InitializeSolution(0);
+
+  for (unsigned int y = 0; y < gridSize; ++y)
+  {
+    for (unsigned int x = 0; x < gridSize; ++x)
+    {
+      const unsigned int i = x + gridSize * y;
+      system.AddMatrixValue(i, i, 4.0 + shift, 0);
+      if (x > 0)
+      {
+        system.AddMatrixValue(i, i - 1, -1.0 - convection, 0);
+      }
+      if (x + 1 < gridSize)
+      {
+        system.AddMatrixValue(i, i + 1, -1.0 + convection, 0);
+      }
+      if (y > 0)
+      {
+        system.AddMatrixValue(i, i - gridSize, -1.0, 0);
+      }
+      if (y + 1 < gridSize)
+      {
+        system.AddMatrixValue(i, i + gridSize, -1.0, 0);
+      }
+      system.SetVectorValue(i, 1.0 + (i % 7), 0);
+    }
+  }
+}
+
+// Solve and check that the residual of the solution is small.
+bool
+SolveAndCheck(WrapperType &                    system,
+              WrapperType::SolverMethodEnum   method,
+              WrapperType::PreconditionerEnum preconditioner)
+{
+  system.SetSolverMethod(method);
+  system.SetPreconditioner(preconditioner);
+  system.InitializeSolution(0);
+  system.Solve();
+
+  // vector 1 = A x
+  system.MultiplyMatrixSolution(1, 0, 0);
+  double residual = 0.0;
+  double norm = 0.0;
+  for (unsigned int i = 0; i < system.GetSystemOrder(); ++i)
+  {
+    const double difference = system.GetVectorValue(i, 1) - system.GetVectorValue(i, 0);
+    residual += difference * difference;
+    norm += system.GetVectorValue(i, 0) * system.GetVectorValue(i, 0);
+  }
+  const double relativeResidual = std::sqrt(residual / norm);
+  std::cout << method << ", " << preconditioner << ": " << system.GetNumberOfIterations()
+            << " iterations, relative residual " << relativeResidual << std::endl;
+  return relativeResidual < 1e-6 && system.GetRelativeResidualNorm() <= system.GetTolerance();
+}
+} // namespace
+
+int
+itkFEMLinearSystemWrapperCSRTest(int, char *[])
+{
+  using SolverMethodEnum = WrapperType::SolverMethodEnum;
+  using PreconditionerEnum = WrapperType::PreconditionerEnum;
+
+  WrapperType system;
+  system.SetNumberOfMatrices(3);
+  system.SetNumberOfVectors(2);
+  system.SetNumberOfSolutions(1);
+
+  /* Assembly and matrix operations on a small system
+   * |11  0  0 14 15|
+   * | 0 22  0  0  0|
+   * | 0  0 33  0  0|
+   * |14  0  0 44 45|
+   * |15  0  0 45 55|
+   * The pattern holds the diagonal only, the other entries are added outside
+   * of it.
+   */
+  constexpr unsigned int N = 5;
+  system.SetSystemOrder(N);
+  const ColumnArray diagonalRowPointers{ 0, 1, 2, 3, 4, 5 };
+  const ColumnArray diagonalColumnIndices{ 0, 1, 2, 3, 4 };
+  system.SetMatrixSparsityPattern(diagonalRowPointers, diagonalColumnIndices, 0);
+  ITK_TEST_EXPECT_TRUE(system.IsMatrixInitialized(0));
+  ITK_TEST_EXPECT_EQUAL(system.GetNumberOfStoredValuesInMatrix(0), 5);
+
+  const double denseMatrix[N][N] = {
+    { 11, 0, 0, 14, 15 }, { 0, 22, 0, 0, 0 }, { 0, 0, 33, 0, 0 }, { 14, 0, 0, 44, 45 }, { 15, 0, 0, 45, 55 }
+  };
+  for (unsigned int i = 0; i < N; ++i)
+  {
+    for (unsigned int j = 0; j < N; ++j)
+    {
+      if (denseMatrix[i][j] != 0.0)
+      {
+        system.AddMatrixValue(i, j, denseMatrix[i][j] - 1.0, 0);
+        system.AddMatrixValue(i, j, 1.0, 0);
+      }
+    }
+  }
+  system.SetMatrixValue(2, 0, 0.0, 0);
+  ITK_TEST_EXPECT_EQUAL(system.GetNumberOfStoredValuesInMatrix(0), 11);
+  for (unsigned int i = 0; i < N; ++i)
+  {
+    for (unsigned int j = 0; j < N; ++j)
+    {
+      ITK_TEST_EXPECT_EQUAL(system.GetMatrixValue(i, j, 0), denseMatrix[i][j]);
+    }
+  }
+
+  ColumnArray columns;
+  system.GetColumnsOfNonZeroMatrixElementsInRow(3, columns, 0);
+  ITK_TEST_EXPECT_TRUE((columns == ColumnArray{ 0, 3, 4 }));
+
+  // matrix 1 = 2 * matrix 0, matrix 2 = matrix 0 * matrix 1
+  system.CopyMatrix(0, 1);
+  system.AddMatrixMatrix(1, 0);
+  system.MultiplyMatrixMatrix(2, 0, 1);
+  for (unsigned int i = 0; i < N; ++i)
+  {
+    for (unsigned int j = 0; j < N; ++j)
+    {
+      double product = 0.0;
+      for (unsigned int k = 0; k < N; ++k)
+      {
+        product += denseMatrix[i][k] * 2.0 * denseMatrix[k][j];
+      }
+      ITK_TEST_EXPECT_EQUAL(system.GetMatrixValue(i, j, 1), 2.0 * denseMatrix[i][j]);
+      ITK_TEST_EXPECT_EQUAL(system.GetMatrixValue(i, j, 2), product);
+    }
+  }
+  system.ScaleMatrix(0.5, 1);
+  system.SwapMatrices(1, 2);
+  ITK_TEST_EXPECT_EQUAL(system.GetMatrixValue(4, 3, 2), 45.0);
+
+  // vector 1 = matrix 0 * vector 0
+  system.InitializeVector(0);
+  for (unsigned int i = 0; i < N; ++i)
+  {
+    system.SetVectorValue(i, i + 1.0, 0);
+  }
+  system.MultiplyMatrixVector(1, 0, 0);
+  for (unsigned int i = 0; i < N; ++i)
+  {
+    double product = 0.0;
+    for (unsigned int k = 0; k < N; ++k)
+    {
+      product += denseMatrix[i][k] * (k + 1.0);
+    }
+    ITK_TEST_EXPECT_EQUAL(system.GetVectorValue(i, 1), product);
+  }
+
+  // The small system is symmetric positive definite.
+  system.InitializeSolution(0);
+  system.Solve();
+  system.MultiplyMatrixSolution(1, 0, 0);
+  for (unsigned int i = 0; i < N; ++i)
+  {
+    ITK_TEST_EXPECT_TRUE(std::abs(system.GetVectorValue(i, 1) - system.GetVectorValue(i, 0)) < 1e-6);
+  }
+
+  // Invalid patterns are rejected.
+  const ColumnArray unsortedColumnIndices{ 0, 1, 2, 4, 3 };
+  const ColumnArray unsortedRowPointers{ 0, 1, 2, 3, 3, 5 };
+  ITK_TRY_EXPECT_EXCEPTION(system.SetMatrixSparsityPattern(unsortedRowPointers, unsortedColumnIndices, 0));
+  const ColumnArray shortRowPointers{ 0, 1, 2 };
+  ITK_TRY_EXPECT_EXCEPTION(system.SetMatrixSparsityPattern(shortRowPointers, diagonalColumnIndices, 0));
+
+  // Symmetric positive definite system, large enough to be split among
+  // threads, assembled in a preallocated pattern or not.
+  system.SetTolerance(1e-10);
+  for (const bool usePattern : { true, false })
+  {
+    FillGridMatrix(system, 60, 0.01, 0.0, usePattern);
+    ITK_TEST_EXPECT_EQUAL(system.GetNumberOfStoredValuesInMatrix(0), 5 * 3600 - 4 * 60);
+    for (const auto preconditioner :
+         { PreconditionerEnum::None, PreconditionerEnum::Jacobi, PreconditionerEnum::IncompleteLU })
+    {
+      ITK_TEST_EXPECT_TRUE(SolveAndCheck(system, SolverMethodEnum::ConjugateGradient, preconditioner));
+      ITK_TEST_EXPECT_TRUE(SolveAndCheck(system, SolverMethodEnum::BiConjugateGradientStabilized, preconditioner));
+    }
+  }
+
+  // ILU(0) needs fewer iterations than Jacobi.
+  system.SetPreconditioner(PreconditionerEnum::Jacobi);
+  system.InitializeSolution(0);
+  system.Solve();
+  const unsigned int jacobiIterations = system.GetNumberOfIterations();
+  system.SetPreconditioner(PreconditionerEnum::IncompleteLU);
+  system.InitializeSolution(0);
+  system.Solve();
+  ITK_TEST_EXPECT_TRUE(system.GetNumberOfIterations() < jacobiIterations);
+
+  // The solution is the initial guess of the next solve.
+  system.Solve();
+  ITK_TEST_EXPECT_EQUAL(system.GetNumberOfIterations(), 0);
+
+  // The result does not depend on the number of threads.
+  system.SetSolverMethod(SolverMethodEnum::ConjugateGradient);
+  system.SetPreconditioner(PreconditionerEnum::Jacobi);
+  system.InitializeSolution(0);
+  system.Solve();
+  std::vector<double> solution(system.GetSystemOrder());
+  for (unsigned int i = 0; i < system.GetSystemOrder(); ++i)
+  {
+    solution[i] = system.GetSolutionValue(i, 0);
+  }
+  system.GetMultiThreader()->SetNumberOfWorkUnits(1);
+  system.InitializeSolution(0);
+  system.Solve();
+  for (unsigned int i = 0; i < system.GetSystemOrder(); ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL(system.GetSolutionValue(i, 0), solution[i]);
+  }
+
+  // Nonsymmetric system.
+  FillGridMatrix(system, 40, 0.0, 0.4, true);
+  ITK_TEST_EXPECT_TRUE(
+    SolveAndCheck(system, SolverMethodEnum::BiConjugateGradientStabilized, PreconditionerEnum::Jacobi));
+  ITK_TEST_EXPECT_TRUE(
+    SolveAndCheck(system, SolverMethodEnum::BiConjugateGradientStabilized, PreconditionerEnum::IncompleteLU));
+
+  // The iterations stop at the maximum number of iterations, and Solve throws.
+  system.SetMaximumNumberOfIterations(3);
+  system.InitializeSolution(0);
+  ITK_TRY_EXPECT_EXCEPTION(system.Solve());
+  ITK_TEST_EXPECT_EQUAL(system.GetNumberOfIterations(), 3);
+  ITK_TEST_EXPECT_TRUE(system.GetRelativeResidualNorm() > system.GetTolerance());
+  system.SetMaximumNumberOfIterations(0);
+
+  // Symmetric indefinite system of Lagrange multipliers, as assembled for
+  // the multi freedom constraints: the zero diagonal of the multipliers makes
+  // Solve use MINRES instead of the conjugate gradient.
+  constexpr unsigned int gridSize = 40;
+  constexpr unsigned int numberOfConstraints = 30;
+  const unsigned int     gridOrder = gridSize * gridSize;
+  system.SetSystemOrder(gridOrder + numberOfConstraints);
+  system.InitializeMatrix(0);
+  system.InitializeVector(0);
+  system.InitializeSolution(0);
+  for (unsigned int i = 0; i < gridOrder; ++i)
+  {
+    const unsigned int x = i % gridSize;
+    const unsigned int y = i / gridSize;
+    system.AddMatrixValue(i, i, 4.01, 0);
+    if (x > 0)
+    {
+      system.AddMatrixValue(i, i - 1, -1.0, 0);
+      system.AddMatrixValue(i - 1, i, -1.0, 0);
+    }
+    if (y > 0)
+    {
+      system.AddMatrixValue(i, i - gridSize, -1.0, 0);
+      system.AddMatrixValue(i - gridSize, i, -1.0, 0);
+    }
+    system.SetVectorValue(i, 1.0 + (i % 7), 0);
+  }
+  for (unsigned int c = 0; c < numberOfConstraints; ++c)
+  {
+    // u[first] - u[second] = c / 10
+    const unsigned int row = gridOrder + c;
+    const unsigned int first = 37 * c + 5;
+    const unsigned int second = 53 * c + 11;
+    system.SetMatrixValue(row, first, 1.0, 0);
+    system.SetMatrixValue(first, row, 1.0, 0);
+    system.SetMatrixValue(row, second, -1.0, 0);
+    system.SetMatrixValue(second, row, -1.0, 0);
+    system.SetVectorValue(row, 0.1 * c, 0);
+  }
+  ITK_TEST_EXPECT_TRUE(SolveAndCheck(system, SolverMethodEnum::ConjugateGradient, PreconditionerEnum::Jacobi));
+  ITK_TEST_EXPECT_EQUAL(system.GetSolverMethodOfLastSolve(), SolverMethodEnum::MinimumResidual);
+  for (unsigned int c = 0; c < numberOfConstraints; ++c)
+  {
+    const double difference = system.GetSolutionValue(37 * c + 5, 0) - system.GetSolutionValue(53 * c + 11, 0);
+    ITK_TEST_EXPECT_TRUE(std::abs(difference - 0.1 * c) < 1e-6);
+  }
+  ITK_TEST_EXPECT_TRUE(SolveAndCheck(system, SolverMethodEnum::ConjugateGradient, PreconditionerEnum::None));
+  ITK_TEST_EXPECT_EQUAL(system.GetSolverMethodOfLastSolve(), SolverMethodEnum::MinimumResidual);
+
+  // The result of MINRES does not depend on the number of threads either.
+  system.SetPreconditioner(PreconditionerEnum::Jacobi);
+  system.GetMultiThreader()->SetNumberOfWorkUnits(4);
+  system.InitializeSolution(0);
+  system.Solve();
+  solution.resize(system.GetSystemOrder());
+  for (unsigned int i = 0; i < system.GetSystemOrder(); ++i)
+  {
+    solution[i] = system.GetSolutionValue(i, 0);
+  }
+  system.GetMultiThreader()->SetNumberOfWorkUnits(1);
+  system.InitializeSolution(0);
+  system.Solve();
+  for (unsigned int i = 0; i < system.GetSystemOrder(); ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL(system.GetSolutionValue(i, 0), solution[i]);
+  }
+
+  // A system without unknowns.
+  system.SetSystemOrder(0);
+  system.InitializeMatrix(0);
+  system.InitializeVector(0);
+  system.InitializeSolution(0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(system.Solve());
+  ITK_TEST_EXPECT_EQUAL(system.GetNumberOfIterations(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,7 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkPointSet.h"
 #include "itkFEMScatteredDataPointSetToImageFilter.h"
+#include "itkFEMLinearSystemWrapperCSR.h"
 #include "itkTestingMacros.h"
 
 /**
@@ -173,6 +174,28 @@ itkFEMScatteredDataPointSetToImageFilterTest(int, char *[])
     return EXIT_FAILURE;
   }
 
+  // Same problem, with the compressed sparse row linear system and the
+  // element matrices computed in parallel
+  itk::fem::LinearSystemWrapperCSR csrLinearSystem;
+  csrLinearSystem.SetTolerance(1e-12);
+  filter->GetModifiableFEMSolver()->SetLinearSystemWrapper(&csrLinearSystem);
+  ITK_TEST_SET_GET_BOOLEAN(filter->GetModifiableFEMSolver(), ParallelElementAssembly, true);
+  filter->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_TRUE(csrLinearSystem.GetNumberOfIterations() > 0);
+
+  DF = filter->GetOutput();
+  ConstIteratorType csrIterator(DF, DF->GetRequestedRegion());
+  for (csrIterator.GoToBegin(); !csrIterator.IsAtEnd(); ++csrIterator)
+  {
+    const VectorType error = csrIterator.Get() - realDisplacement;
+    if (error.GetNorm() > 0.0001)
+    {
+      std::cout << "Test FAILED with the CSR linear system!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   std::cout << "Test finished." << std::endl;
   return EXIT_SUCCESS;
 }
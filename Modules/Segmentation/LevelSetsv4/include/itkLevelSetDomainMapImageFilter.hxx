@@ -97,18 +97,12 @@ LevelSetDomainMapImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   this->m_InputImage = this->GetInput();
   const InputImageRegionType & region = this->m_InputImage->GetLargestPossibleRegion();
-  const InputImageSizeType     size = region.GetSize();
 
   this->m_OutputImage = this->GetOutput();
   this->m_OutputImage->SetBufferedRegion(region);
   this->m_OutputImage->AllocateInitialized();
 
-  InputImageIndexType end;
-
-  for (unsigned int i = 0; i < ImageDimension; ++i)
-  {
-    end[i] = size[i] - 1;
-  }
+  const InputImageIndexType end = region.GetUpperIndex();
 
   IdentifierType segmentId = NumericTraits<IdentifierType>::OneValue();
 
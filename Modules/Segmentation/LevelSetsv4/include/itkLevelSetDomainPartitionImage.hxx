@@ -43,20 +43,18 @@ LevelSetDomainPartitionImage<TImage>::PopulateListDomain()
 
   const ListRegionType & region = this->m_ListDomain->GetLargestPossibleRegion();
 
-  for (ListIteratorType lIt(this->m_ListDomain, region); !lIt.IsAtEnd(); ++lIt)
+  // Visit the domain of each level set rather than testing every domain for
+  // every pixel. Identifiers are appended in increasing order.
+  for (IdentifierType i{}; i < this->m_NumberOfLevelSetFunctions; ++i)
   {
-    ListIndexType      listIndex = lIt.GetIndex();
-    IdentifierListType identifierList;
-    IdentifierType     i{};
-    while (i < this->m_NumberOfLevelSetFunctions)
+    ListRegionType levelSetRegion = this->m_LevelSetDomainRegionVector[i];
+    if (levelSetRegion.Crop(region))
     {
-      if (this->m_LevelSetDomainRegionVector[i].IsInside(listIndex))
+      for (ImageRegionIterator<ListImageType> lIt(this->m_ListDomain, levelSetRegion); !lIt.IsAtEnd(); ++lIt)
       {
-        identifierList.push_back(i);
+        lIt.Value().push_back(i);
       }
-      ++i;
     }
-    lIt.Set(identifierList);
   }
 }
 
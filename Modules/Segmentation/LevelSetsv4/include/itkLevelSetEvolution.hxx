@@ -274,7 +274,7 @@ LevelSetEvolution<TEquationContainer, WhitakerSparseLevelSetImage<TOutput, VDime
   {
     typename LevelSetType::ConstPointer levelSet =
       this->m_LevelSetContainerIteratorToProcessWhenThreading->GetLevelSet();
-    const LevelSetLayerType                           zeroLayer = levelSet->GetLayer(0);
+    const LevelSetLayerType &                         zeroLayer = levelSet->GetLayer(0);
     auto                                              layerBegin = zeroLayer.begin();
     auto                                              layerEnd = zeroLayer.end();
     typename SplitLevelSetPartitionerType::DomainType completeDomain(layerBegin, layerEnd);
@@ -114,33 +114,44 @@ LevelSetEvolutionComputeIterationThreader<
 {
   typename InputImageType::ConstPointer inputImage = this->m_Associate->m_EquationContainer->GetInput();
 
+  // The level sets and equations of a domain are looked up once per domain,
+  // instead of once per pixel and level set.
+  std::vector<LevelSetImageType *> levelSetUpdateImages;
+  std::vector<OffsetType>          offsets;
+  std::vector<TermContainerType *> termContainers;
+
   typename DomainType::IteratorType mapIt = imageSubDomain.Begin();
   while (mapIt != imageSubDomain.End())
   {
+    const IdListType & idList = *(mapIt->second.GetIdList());
+
+    // itkAssertInDebugOrThrowInReleaseMacro( !idList.empty() );
+
+    levelSetUpdateImages.clear();
+    offsets.clear();
+    termContainers.clear();
+    for (const auto & id : idList)
+    {
+      LevelSetType * levelSetUpdate = this->m_Associate->m_UpdateBuffer->GetLevelSet(id - 1);
+      levelSetUpdateImages.push_back(levelSetUpdate->GetModifiableImage());
+      offsets.push_back(levelSetUpdate->GetDomainOffset());
+      termContainers.push_back(this->m_Associate->m_EquationContainer->GetEquation(id - 1));
+    }
+    const size_t numberOfLevelSets = termContainers.size();
+
     ImageRegionConstIteratorWithIndex<InputImageType> it(inputImage, *(mapIt->second.GetRegion()));
     it.GoToBegin();
 
     while (!it.IsAtEnd())
     {
-      const IdListType idList = *(mapIt->second.GetIdList());
-
-      // itkAssertInDebugOrThrowInReleaseMacro( !idList.empty() );
-
-      for (auto idListIt = idList.begin(); idListIt != idList.end(); ++idListIt)
+      const IndexType & inputIndex = it.GetIndex();
+      for (size_t k = 0; k < numberOfLevelSets; ++k)
       {
-        typename LevelSetType::Pointer levelSetUpdate = this->m_Associate->m_UpdateBuffer->GetLevelSet(*idListIt - 1);
-
-        OffsetType offset = levelSetUpdate->GetDomainOffset();
-        IndexType  levelSetIndex = it.GetIndex() - offset;
-
-        LevelSetDataType                    characteristics;
-        typename TermContainerType::Pointer termContainer =
-          this->m_Associate->m_EquationContainer->GetEquation(*idListIt - 1);
-        termContainer->ComputeRequiredData(it.GetIndex(), characteristics);
-        LevelSetOutputRealType tempUpdate = termContainer->Evaluate(it.GetIndex(), characteristics);
+        LevelSetDataType characteristics;
+        termContainers[k]->ComputeRequiredData(inputIndex, characteristics);
+        LevelSetOutputRealType tempUpdate = termContainers[k]->Evaluate(inputIndex, characteristics);
 
-        LevelSetImageType * levelSetImage = levelSetUpdate->GetModifiableImage();
-        levelSetImage->SetPixel(levelSetIndex, tempUpdate);
+        levelSetUpdateImages[k]->SetPixel(inputIndex - offsets[k], tempUpdate);
       }
       ++it;
     }
@@ -210,13 +221,16 @@ LevelSetEvolutionComputeIterationThreader<
   typename LevelSetEvolutionType::LevelSetLayerType * levelSetLayerUpdateBuffer =
     this->m_Associate->m_UpdateBuffer[levelSetId];
 
+  // Each work unit processed a contiguous range of the (sorted) zero layer,
+  // and the ranges are in order: the pairs are appended to the update buffer
+  // in order, which makes every insertion constant time.
   const ThreadIdType numberOfWorkUnits = this->GetNumberOfWorkUnitsUsed();
   for (ThreadIdType ii = 0; ii < numberOfWorkUnits; ++ii)
   {
     typename std::vector<NodePairType>::const_iterator pairIt = this->m_NodePairsPerThread[ii].begin();
     while (pairIt != this->m_NodePairsPerThread[ii].end())
     {
-      levelSetLayerUpdateBuffer->insert(*pairIt);
+      levelSetLayerUpdateBuffer->insert(levelSetLayerUpdateBuffer->end(), *pairIt);
       ++pairIt;
     }
   }
@@ -91,7 +91,7 @@ UpdateWhitakerSparseLevelSet<VDimension, TLevelSetValueType, TEquationContainer>
   // Here, we are adding all pairs of indices and levelset values to a map
   for (LevelSetLayerIdType status = LevelSetType::MinusOneLayer(); status < LevelSetType::PlusTwoLayer(); ++status)
   {
-    const LevelSetLayerType layer = this->m_InputLevelSet->GetLayer(status);
+    const LevelSetLayerType & layer = this->m_InputLevelSet->GetLayer(status);
 
     auto it = layer.begin();
     while (it != layer.end())
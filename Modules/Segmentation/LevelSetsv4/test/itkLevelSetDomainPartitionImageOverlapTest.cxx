@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAtanRegularizedHeavisideStepFunction.h"
+#include "itkLevelSetContainer.h"
+#include "itkLevelSetDenseImage.h"
+#include "itkLevelSetDomainPartitionImage.h"
+#include "itkLevelSetEquationChanAndVeseExternalTerm.h"
+#include "itkLevelSetEquationChanAndVeseInternalTerm.h"
+#include "itkLevelSetEquationContainer.h"
+#include "itkLevelSetEquationTermContainer.h"
+#include "itkLevelSetEvolution.h"
+#include "itkLevelSetEvolutionNumberOfIterationsStoppingCriterion.h"
+#include "itkTestingMacros.h"
+
+// Partition the domain of several overlapping level sets, and compare the
+// lists of the partition, and an iteration of the evolution of the level
+// sets, with those of a list image computed at every pixel of the image.
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using InputImageType = itk::Image<unsigned char, Dimension>;
+using ImageType = itk::Image<float, Dimension>;
+using LevelSetType = itk::LevelSetDenseImage<ImageType>;
+using LevelSetContainerType = itk::LevelSetContainer<itk::IdentifierType, LevelSetType>;
+using IdListImageType = LevelSetContainerType::IdListImageType;
+using DomainMapImageFilterType = LevelSetContainerType::DomainMapImageFilterType;
+using DomainPartitionType = itk::LevelSetDomainPartitionImage<InputImageType>;
+using RegionVectorType = DomainPartitionType::LevelSetDomainRegionVectorType;
+
+// The list of the level sets of every pixel, testing every domain.
+IdListImageType::Pointer
+ComputeReferenceListImage(const InputImageType::RegionType & region, const RegionVectorType & regionVector)
+{
+  auto listImage = IdListImageType::New();
+  listImage->SetRegions(region);
+  listImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<IdListImageType> it(listImage, region); !it.IsAtEnd(); ++it)
+  {
+    for (itk::IdentifierType i = 0; i < regionVector.size(); ++i)
+    {
+      if (regionVector[i].IsInside(it.GetIndex()))
+      {
+        it.Value().push_back(i);
+      }
+    }
+  }
+  return listImage;
+}
+
+// Evolve a circle centered in the domain of each level set, but the
+// first which is empty, for one iteration.
+std::vector<ImageType::Pointer>
+EvolveOnce(InputImageType * input, const IdListImageType * listImage, const RegionVectorType & regionVector)
+{
+  using TermContainerType = itk::LevelSetEquationTermContainer<InputImageType, LevelSetContainerType>;
+  using EquationContainerType = itk::LevelSetEquationContainer<TermContainerType>;
+  using EvolutionType = itk::LevelSetEvolution<EquationContainerType, LevelSetType>;
+  using InternalTermType = itk::LevelSetEquationChanAndVeseInternalTerm<InputImageType, LevelSetContainerType>;
+  using ExternalTermType = itk::LevelSetEquationChanAndVeseExternalTerm<InputImageType, LevelSetContainerType>;
+  using RealType = LevelSetType::OutputRealType;
+  using HeavisideType = itk::AtanRegularizedHeavisideStepFunction<RealType, RealType>;
+  using StoppingCriterionType = itk::LevelSetEvolutionNumberOfIterationsStoppingCriterion<LevelSetContainerType>;
+
+  auto domainMapFilter = DomainMapImageFilterType::New();
+  domainMapFilter->SetInput(listImage);
+  domainMapFilter->Update();
+
+  auto heaviside = HeavisideType::New();
+  heaviside->SetEpsilon(1.0);
+
+  auto levelSetContainer = LevelSetContainerType::New();
+  levelSetContainer->SetHeaviside(heaviside);
+  levelSetContainer->SetDomainMapFilter(domainMapFilter);
+
+  // The identifiers of the domain map are those of the level sets plus one
+  std::vector<ImageType::Pointer> levelSetImages;
+  for (itk::IdentifierType id = 0; id + 1 < regionVector.size(); ++id)
+  {
+    const InputImageType::RegionType & domain = regionVector[id + 1];
+    auto                               image = ImageType::New();
+    image->SetRegions(input->GetLargestPossibleRegion());
+    image->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      double squaredDistance = 0.0;
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        const double center = domain.GetIndex(d) + 0.5 * (domain.GetSize(d) - 1);
+        squaredDistance += (it.GetIndex()[d] - center) * (it.GetIndex()[d] - center);
+      }
+      it.Set(static_cast<float>(std::sqrt(squaredDistance) - 3.0));
+    }
+    levelSetImages.push_back(image);
+
+    auto levelSet = LevelSetType::New();
+    levelSet->SetImage(image);
+    levelSetContainer->AddLevelSet(id, levelSet, false);
+  }
+
+  auto equationContainer = EquationContainerType::New();
+  equationContainer->SetLevelSetContainer(levelSetContainer);
+  for (itk::IdentifierType id = 0; id < levelSetImages.size(); ++id)
+  {
+    auto internalTerm = InternalTermType::New();
+    internalTerm->SetInput(input);
+    internalTerm->SetCoefficient(1.0);
+
+    auto externalTerm = ExternalTermType::New();
+    externalTerm->SetInput(input);
+    externalTerm->SetCoefficient(1.0);
+
+    auto termContainer = TermContainerType::New();
+    termContainer->SetInput(input);
+    termContainer->SetCurrentLevelSetId(id);
+    termContainer->SetLevelSetContainer(levelSetContainer);
+    termContainer->AddTerm(0, internalTerm);
+    termContainer->AddTerm(1, externalTerm);
+    equationContainer->AddEquation(id, termContainer);
+  }
+
+  auto criterion = StoppingCriterionType::New();
+  criterion->SetNumberOfIterations(1);
+
+  auto evolution = EvolutionType::New();
+  evolution->SetEquationContainer(equationContainer);
+  evolution->SetStoppingCriterion(criterion);
+  evolution->SetLevelSetContainer(levelSetContainer);
+  evolution->SetNumberOfWorkUnits(1);
+  evolution->Update();
+
+  return levelSetImages;
+}
+} // namespace
+
+int
+itkLevelSetDomainPartitionImageOverlapTest(int, char *[])
+{
+  const InputImageType::RegionType region({ { 0, 0 } }, { { 48, 40 } });
+
+  auto input = InputImageType::New();
+  input->SetRegions(region);
+  input->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<InputImageType> it(input, region); !it.IsAtEnd(); ++it)
+  {
+    const InputImageType::IndexType & index = it.GetIndex();
+    const bool                        inside = index[0] >= 10 && index[0] < 30 && index[1] >= 6 && index[1] < 26;
+    it.Set(static_cast<unsigned char>((inside ? 150 : 0) + (7 * index[0] + 3 * index[1]) % 50));
+  }
+
+  // The first domain is empty. The fourth one is cropped by the image, and
+  // the sixth one is inside the third one.
+  const RegionVectorType regionVector = { InputImageType::RegionType(),
+                                          InputImageType::RegionType({ { 4, 5 } }, { { 14, 12 } }),
+                                          InputImageType::RegionType({ { 12, 9 } }, { { 16, 14 } }),
+                                          InputImageType::RegionType({ { 22, -3 } }, { { 14, 12 } }),
+                                          InputImageType::RegionType({ { 8, 18 } }, { { 12, 14 } }),
+                                          InputImageType::RegionType({ { 15, 12 } }, { { 8, 8 } }) };
+
+  auto partition = DomainPartitionType::New();
+  partition->SetNumberOfLevelSetFunctions(regionVector.size());
+  partition->SetLevelSetDomainRegionVector(regionVector);
+  partition->SetImage(input);
+  partition->PopulateListDomain();
+
+  // The list image covers the whole image
+  const IdListImageType * listImage = partition->GetListDomain();
+  ITK_TEST_EXPECT_EQUAL(listImage->GetLargestPossibleRegion(), region);
+  ITK_TEST_EXPECT_EQUAL(listImage->GetBufferedRegion(), region);
+
+  const IdListImageType::Pointer referenceListImage = ComputeReferenceListImage(region, regionVector);
+  for (itk::ImageRegionConstIteratorWithIndex<IdListImageType> it(referenceListImage, region); !it.IsAtEnd(); ++it)
+  {
+    if (listImage->GetPixel(it.GetIndex()) != it.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong list of level sets at " << it.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Both list images partition the image in the same domains
+  auto domainMapFilter = DomainMapImageFilterType::New();
+  domainMapFilter->SetInput(listImage);
+  domainMapFilter->Update();
+  auto referenceDomainMapFilter = DomainMapImageFilterType::New();
+  referenceDomainMapFilter->SetInput(referenceListImage);
+  referenceDomainMapFilter->Update();
+
+  const DomainMapImageFilterType::DomainMapType & domainMap = domainMapFilter->GetDomainMap();
+  const DomainMapImageFilterType::DomainMapType & referenceDomainMap = referenceDomainMapFilter->GetDomainMap();
+  ITK_TEST_EXPECT_EQUAL(domainMap.size(), referenceDomainMap.size());
+  for (auto mapIt = domainMap.begin(), referenceIt = referenceDomainMap.begin();
+       mapIt != domainMap.end() && referenceIt != referenceDomainMap.end();
+       ++mapIt, ++referenceIt)
+  {
+    ITK_TEST_EXPECT_EQUAL(*mapIt->second.GetRegion(), *referenceIt->second.GetRegion());
+    ITK_TEST_EXPECT_TRUE(*mapIt->second.GetIdList() == *referenceIt->second.GetIdList());
+  }
+
+  // An iteration of the evolution of the level sets is the same
+  const std::vector<ImageType::Pointer> levelSetImages = EvolveOnce(input, listImage, regionVector);
+  const std::vector<ImageType::Pointer> referenceLevelSetImages =
+    EvolveOnce(input, referenceListImage, regionVector);
+  for (size_t i = 0; i < levelSetImages.size(); ++i)
+  {
+    const size_t  numberOfPixels = region.GetNumberOfPixels();
+    const float * buffer = levelSetImages[i]->GetBufferPointer();
+    const float * referenceBuffer = referenceLevelSetImages[i]->GetBufferPointer();
+    if (!std::equal(buffer, buffer + numberOfPixels, referenceBuffer))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Level set " << i << " differs from the reference after an iteration" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The first level set has evolved in its domain
+  const float initialValue = static_cast<float>(std::sqrt(2.0 * 0.5 * 0.5) - 3.0);
+  ITK_TEST_EXPECT_TRUE(levelSetImages[0]->GetPixel({ { 10, 10 } }) != initialValue);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -21,10 +21,11 @@
 #include "itkMath.h"
 #include "itkMacro.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionSplitterSlowDimension.h"
 #include "itkImageNeighborhoodOffsets.h"
 #include "itkShapedImageNeighborhoodRange.h"
 #include "itkBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
+#include "itkParallelFloodFill.h"
 #include "itkProgressReporter.h"
 #include "itkPrintHelper.h"
 #include <algorithm> // For min and max.
@@ -124,10 +125,6 @@ void
 ConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
 {
   using FunctionType = BinaryThresholdImageFunction<InputImageType, double>;
-  using SecondFunctionType = BinaryThresholdImageFunction<OutputImageType, double>;
-
-  using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
-  using SecondIteratorType = FloodFilledImageFunctionConditionalConstIterator<InputImageType, SecondFunctionType>;
 
   unsigned int loop;
 
@@ -276,49 +273,75 @@ ConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   itkDebugMacro("\nLower intensity = " << lower << ", Upper intensity = " << upper << "\nmean = " << m_Mean
                                        << " , std::sqrt(variance) = " << std::sqrt(m_Variance));
 
-  // Segment the image, the iterator walks the output image (so Set()
-  // writes into the output image), starting at the seed point.  As
-  // the iterator walks, if the corresponding pixel in the input image
-  // (accessed via the "function" assigned to the iterator) is within
-  // the [lower, upper] bounds prescribed, the pixel is added to the
-  // output segmentation and its neighbors become candidates for the
-  // iterator to walk.
-  IteratorType it(outputImage, function, m_Seeds);
-  it.GoToBegin();
-  while (!it.IsAtEnd())
-  {
-    it.Set(m_ReplaceValue);
-    ++it;
-  }
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // Segment the image, the flood walks the output image starting at
+  // the seed points.  If the corresponding pixel in the input image
+  // (accessed via the "function") is within the [lower, upper] bounds
+  // prescribed, the pixel is added to the output segmentation and its
+  // neighbors become candidates for the next frontier of the flood.
+  ParallelFloodFill<OutputImageType::ImageDimension> floodFill(region);
+  const auto isIncluded = [&function](const IndexType & index) { return function->EvaluateAtIndex(index); };
+  const auto replace = [&outputImage, this](const IndexType & index) { outputImage->SetPixel(index, m_ReplaceValue); };
+
+  floodFill.Fill(m_Seeds, isIncluded, replace, this->GetMultiThreader());
+
+  // The statistics are accumulated in parallel over slabs of the
+  // region, and the partial sums are combined in a fixed order.
+  const auto         splitter = ImageRegionSplitterSlowDimension::New();
+  const unsigned int numberOfSplits = splitter->GetNumberOfSplits(region, this->GetNumberOfWorkUnits());
+
+  std::vector<InputRealType> partialSums(numberOfSplits);
+  std::vector<InputRealType> partialSumsOfSquares(numberOfSplits);
+  std::vector<SizeValueType> partialNumberOfSamples(numberOfSplits);
 
   ProgressReporter progress(this, 0, region.GetNumberOfPixels() * m_NumberOfIterations);
 
   for (loop = 0; loop < m_NumberOfIterations; ++loop)
   {
     // Now that we have an initial segmentation, let's recalculate the
-    // statistics.  Since we have already labelled the output, we visit
-    // pixels in the input image that have been set in the output image.
-    // Essentially, we flip the iterator around, so we walk the input
-    // image (so Get() will get pixel values from the input) and constrain
-    // iterator such it only visits pixels that were set in the output.
-    auto secondFunction = SecondFunctionType::New();
-    secondFunction->SetInputImage(outputImage);
-    secondFunction->ThresholdBetween(m_ReplaceValue, m_ReplaceValue);
+    // statistics.  Every pixel set in the output image is connected to
+    // a seed, so the statistics are computed from the input pixels
+    // which have been set in the output image.
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfSplits,
+      [&](SizeValueType split) {
+        OutputImageRegionType splitRegion = region;
+        splitter->GetSplit(split, numberOfSplits, splitRegion);
+
+        InputRealType splitSum{};
+        InputRealType splitSumOfSquares{};
+        SizeValueType splitNumberOfSamples = 0;
+
+        ImageRegionConstIterator<InputImageType>  iit(inputImage, splitRegion);
+        ImageRegionConstIterator<OutputImageType> oit(outputImage, splitRegion);
+        for (; !oit.IsAtEnd(); ++iit, ++oit)
+        {
+          if (Math::ExactlyEquals(oit.Get(), m_ReplaceValue))
+          {
+            const auto value = static_cast<InputRealType>(iit.Get());
+            splitSum += value;
+            splitSumOfSquares += value * value;
+            ++splitNumberOfSamples;
+          }
+        }
+        partialSums[split] = splitSum;
+        partialSumsOfSquares[split] = splitSumOfSquares;
+        partialNumberOfSamples[split] = splitNumberOfSamples;
+      },
+      nullptr);
 
     typename NumericTraits<typename InputImageType::PixelType>::RealType sum, sumOfSquares;
     sum = InputRealType{};
     sumOfSquares = InputRealType{};
     typename TOutputImage::SizeValueType numberOfSamples = 0;
 
-    SecondIteratorType sit(inputImage, secondFunction, m_Seeds);
-    sit.GoToBegin();
-    while (!sit.IsAtEnd())
+    for (unsigned int split = 0; split < numberOfSplits; ++split)
     {
-      const auto value = static_cast<InputRealType>(sit.Get());
-      sum += value;
-      sumOfSquares += value * value;
-      ++numberOfSamples;
-      ++sit;
+      sum += partialSums[split];
+      sumOfSquares += partialSumsOfSquares[split];
+      numberOfSamples += partialNumberOfSamples[split];
     }
     m_Mean = sum / static_cast<double>(numberOfSamples);
     m_Variance = (sumOfSquares - (sum * sum / static_cast<double>(numberOfSamples))) /
@@ -359,24 +382,12 @@ ConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
                                          << " , std::sqrt(variance) = " << std::sqrt(m_Variance));
     itkDebugMacro("\nsum = " << sum << ", sumOfSquares = " << sumOfSquares << "\nnum = " << numberOfSamples);
 
-    // Rerun the segmentation, the iterator walks the output image,
-    // starting at the seed point.  As the iterator walks, if the
-    // corresponding pixel in the input image (accessed via the
-    // "function" assigned to the iterator) is within the [lower,
-    // upper] bounds prescribed, the pixel is added to the output
-    // segmentation and its neighbors become candidates for the
-    // iterator to walk.
+    // Rerun the segmentation with the updated bounds, the flood walks
+    // the output image starting at the seed points.
     outputImage->FillBuffer(OutputImagePixelType{});
-    IteratorType thirdIt(outputImage, function, m_Seeds);
-    thirdIt.GoToBegin();
     try
     {
-      while (!thirdIt.IsAtEnd())
-      {
-        thirdIt.Set(m_ReplaceValue);
-        ++thirdIt;
-        progress.CompletedPixel(); // potential exception thrown here
-      }
+      floodFill.Fill(m_Seeds, isIncluded, replace, this->GetMultiThreader(), &progress);
     }
     catch (const ProcessAborted &)
     {
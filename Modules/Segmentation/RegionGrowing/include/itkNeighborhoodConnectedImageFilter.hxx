@@ -19,7 +19,7 @@
 #define itkNeighborhoodConnectedImageFilter_hxx
 
 #include "itkNeighborhoodBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
+#include "itkParallelFloodFill.h"
 #include "itkProgressReporter.h"
 #include "itkPrintHelper.h"
 
@@ -114,21 +114,23 @@ NeighborhoodConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   outputImage->FillBuffer(OutputImagePixelType{});
 
   using FunctionType = NeighborhoodBinaryThresholdImageFunction<InputImageType>;
-  using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
 
   auto function = FunctionType::New();
   function->SetInputImage(inputImage);
   function->ThresholdBetween(m_Lower, m_Upper);
   function->SetRadius(m_Radius);
-  IteratorType it(outputImage, function, m_Seeds);
 
   ProgressReporter progress(this, 0, outputImage->GetRequestedRegion().GetNumberOfPixels());
-  while (!it.IsAtEnd())
-  {
-    it.Set(m_ReplaceValue);
-    ++it;
-    progress.CompletedPixel();
-  }
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  ParallelFloodFill<OutputImageDimension> floodFill(outputImage->GetRequestedRegion());
+  floodFill.Fill(
+    m_Seeds,
+    [&function](const IndexType & index) { return function->EvaluateAtIndex(index); },
+    [&outputImage, this](const IndexType & index) { outputImage->SetPixel(index, m_ReplaceValue); },
+    this->GetMultiThreader(),
+    &progress);
 }
 } // end namespace itk
 
@@ -0,0 +1,138 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelFloodFill_h
+#define itkParallelFloodFill_h
+
+#include "itkImageRegion.h"
+#include "itkMultiThreaderBase.h"
+#include "itkProgressReporter.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace itk
+{
+/** \class ParallelFloodFill
+ * \brief Multi-threaded flood fill of an image region from a set of seeds.
+ *
+ * ParallelFloodFill visits every index of a region which is connected
+ * to one of the seeds through indices satisfying an inclusion
+ * predicate. It produces the same set of indices as
+ * FloodFilledImageFunctionConditionalIterator (face connectivity) or
+ * ShapedFloodFilledImageFunctionConditionalIterator (full
+ * connectivity), but the flood proceeds frontier by frontier: the
+ * indices of the current frontier are split into chunks which are
+ * expanded concurrently, each into its own part of the next frontier.
+ *
+ * The indices which have been tested are recorded in a bit set
+ * updated with atomic operations, so each index is tested exactly
+ * once and the flood requires one bit per pixel instead of a
+ * temporary image.
+ *
+ * The predicate and the visitor are called concurrently from several
+ * threads with distinct indices, and the visitor is called once for
+ * each included index, in no particular order.
+ *
+ * \ingroup RegionGrowingSegmentation
+ * \ingroup ITKRegionGrowing
+ */
+template <unsigned int VDimension>
+class ITK_TEMPLATE_EXPORT ParallelFloodFill
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ParallelFloodFill);
+
+  static constexpr unsigned int ImageDimension = VDimension;
+
+  using RegionType = ImageRegion<VDimension>;
+  using IndexType = Index<VDimension>;
+  using OffsetType = Offset<VDimension>;
+  using SeedContainerType = std::vector<IndexType>;
+
+  /** Prepare a flood of the region, using face connectivity (2*N
+   * neighbors) or full connectivity (3^N-1 neighbors). */
+  explicit ParallelFloodFill(const RegionType & region, bool fullyConnected = false);
+
+  ~ParallelFloodFill() = default;
+
+  /** Flood from the seeds which are inside the region and satisfy the
+   * predicate. `isIncluded(const IndexType &)` returns whether an
+   * index belongs to the flooded region, `visit(const IndexType &)`
+   * is called for every index of the flooded region. Progress is
+   * reported, and aborting checked, through the optional reporter
+   * from the calling thread. Returns the number of visited indices. */
+  template <typename TPredicate, typename TVisitor>
+  SizeValueType
+  Fill(const SeedContainerType & seeds,
+       const TPredicate &        isIncluded,
+       const TVisitor &          visit,
+       MultiThreaderBase *       multiThreader,
+       ProgressReporter *        progress = nullptr);
+
+  /** Whether the index was tested by the last flood. */
+  bool
+  IsTested(const IndexType & index) const;
+
+  const RegionType &
+  GetRegion() const
+  {
+    return m_Region;
+  }
+
+  bool
+  GetFullyConnected() const
+  {
+    return m_FullyConnected;
+  }
+
+protected:
+  /** Mark an offset of the region as tested. Returns false when it already was. */
+  bool
+  TestAndMark(OffsetValueType offset);
+
+  IndexType
+  ComputeIndex(OffsetValueType offset) const;
+
+  OffsetValueType
+  ComputeOffset(const IndexType & index) const;
+
+private:
+  /** Frontier size below which a level is expanded by the calling thread. */
+  static constexpr SizeValueType MinimumFrontierChunkSize = 1024;
+
+  RegionType m_Region{};
+  bool       m_FullyConnected{ false };
+
+  OffsetValueType m_OffsetTable[VDimension + 1]{};
+
+  std::vector<OffsetType>      m_NeighborOffsets{};
+  std::vector<OffsetValueType> m_NeighborLinearOffsets{};
+
+  size_t                                    m_NumberOfBitWords{ 0 };
+  std::unique_ptr<std::atomic<uint64_t>[]>  m_TestedBits{};
+  std::vector<OffsetValueType>              m_Frontier{};
+  std::vector<std::vector<OffsetValueType>> m_NextFrontierChunks{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkParallelFloodFill.hxx"
+#endif
+
+#endif
@@ -0,0 +1,242 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelFloodFill_hxx
+#define itkParallelFloodFill_hxx
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <unsigned int VDimension>
+ParallelFloodFill<VDimension>::ParallelFloodFill(const RegionType & region, bool fullyConnected)
+  : m_Region(region)
+  , m_FullyConnected(fullyConnected)
+{
+  m_OffsetTable[0] = 1;
+  for (unsigned int i = 0; i < VDimension; ++i)
+  {
+    m_OffsetTable[i + 1] = m_OffsetTable[i] * static_cast<OffsetValueType>(region.GetSize(i));
+  }
+
+  // Build the neighborhood, either the face neighbors or all the
+  // neighbors of the 3^N block but the center.
+  if (m_FullyConnected)
+  {
+    OffsetType offset;
+    offset.Fill(-1);
+    while (offset[VDimension - 1] <= 1)
+    {
+      if (offset != OffsetType{})
+      {
+        m_NeighborOffsets.push_back(offset);
+      }
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        if (++offset[i] <= 1 || i == VDimension - 1)
+        {
+          break;
+        }
+        offset[i] = -1;
+      }
+    }
+  }
+  else
+  {
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      for (const OffsetValueType step : { -1, 1 })
+      {
+        OffsetType offset{};
+        offset[i] = step;
+        m_NeighborOffsets.push_back(offset);
+      }
+    }
+  }
+
+  for (const OffsetType & offset : m_NeighborOffsets)
+  {
+    OffsetValueType linearOffset = 0;
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      linearOffset += offset[i] * m_OffsetTable[i];
+    }
+    m_NeighborLinearOffsets.push_back(linearOffset);
+  }
+
+  m_NumberOfBitWords = (m_OffsetTable[VDimension] + 63) / 64;
+  m_TestedBits = std::make_unique<std::atomic<uint64_t>[]>(m_NumberOfBitWords);
+}
+
+
+template <unsigned int VDimension>
+template <typename TPredicate, typename TVisitor>
+SizeValueType
+ParallelFloodFill<VDimension>::Fill(const SeedContainerType & seeds,
+                                    const TPredicate &        isIncluded,
+                                    const TVisitor &          visit,
+                                    MultiThreaderBase *       multiThreader,
+                                    ProgressReporter *        progress)
+{
+  for (size_t w = 0; w < m_NumberOfBitWords; ++w)
+  {
+    m_TestedBits[w].store(0, std::memory_order_relaxed);
+  }
+
+  m_Frontier.clear();
+  for (const IndexType & seed : seeds)
+  {
+    if (m_Region.IsInside(seed) && isIncluded(seed) && this->TestAndMark(this->ComputeOffset(seed)))
+    {
+      visit(seed);
+      m_Frontier.push_back(this->ComputeOffset(seed));
+    }
+  }
+
+  SizeValueType numberOfVisitedIndices = m_Frontier.size();
+  if (progress)
+  {
+    for (size_t n = 0; n < m_Frontier.size(); ++n)
+    {
+      progress->CompletedPixel();
+    }
+  }
+
+  const SizeValueType numberOfWorkUnits = multiThreader ? multiThreader->GetNumberOfWorkUnits() : 1;
+
+  while (!m_Frontier.empty())
+  {
+    const SizeValueType numberOfChunks = std::max<SizeValueType>(
+      1, std::min<SizeValueType>(numberOfWorkUnits, m_Frontier.size() / MinimumFrontierChunkSize));
+    m_NextFrontierChunks.resize(numberOfChunks);
+
+    const auto expandChunk = [this, numberOfChunks, &isIncluded, &visit](SizeValueType chunk) {
+      std::vector<OffsetValueType> & nextFrontier = m_NextFrontierChunks[chunk];
+      nextFrontier.clear();
+
+      const size_t begin = (m_Frontier.size() * chunk) / numberOfChunks;
+      const size_t end = (m_Frontier.size() * (chunk + 1)) / numberOfChunks;
+      for (size_t n = begin; n < end; ++n)
+      {
+        const OffsetValueType offset = m_Frontier[n];
+        const IndexType       index = this->ComputeIndex(offset);
+
+        for (size_t k = 0; k < m_NeighborOffsets.size(); ++k)
+        {
+          const IndexType neighbor = index + m_NeighborOffsets[k];
+          if (!m_Region.IsInside(neighbor))
+          {
+            continue;
+          }
+
+          // The neighbor is tested only by the thread which marks it first
+          const OffsetValueType neighborOffset = offset + m_NeighborLinearOffsets[k];
+          if (this->TestAndMark(neighborOffset) && isIncluded(neighbor))
+          {
+            visit(neighbor);
+            nextFrontier.push_back(neighborOffset);
+          }
+        }
+      }
+    };
+
+    if (numberOfChunks == 1 || multiThreader == nullptr)
+    {
+      for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+      {
+        expandChunk(chunk);
+      }
+    }
+    else
+    {
+      multiThreader->ParallelizeArray(0, numberOfChunks, expandChunk, nullptr);
+    }
+
+    m_Frontier.clear();
+    for (const std::vector<OffsetValueType> & nextFrontier : m_NextFrontierChunks)
+    {
+      m_Frontier.insert(m_Frontier.end(), nextFrontier.cbegin(), nextFrontier.cend());
+    }
+
+    numberOfVisitedIndices += m_Frontier.size();
+    if (progress)
+    {
+      for (size_t n = 0; n < m_Frontier.size(); ++n)
+      {
+        progress->CompletedPixel(); // potential exception thrown here
+      }
+    }
+  }
+
+  return numberOfVisitedIndices;
+}
+
+
+template <unsigned int VDimension>
+bool
+ParallelFloodFill<VDimension>::IsTested(const IndexType & index) const
+{
+  if (!m_Region.IsInside(index))
+  {
+    return false;
+  }
+  const OffsetValueType offset = this->ComputeOffset(index);
+  const uint64_t        mask = uint64_t{ 1 } << (offset % 64);
+  return (m_TestedBits[offset / 64].load(std::memory_order_relaxed) & mask) != 0;
+}
+
+
+template <unsigned int VDimension>
+bool
+ParallelFloodFill<VDimension>::TestAndMark(OffsetValueType offset)
+{
+  const uint64_t mask = uint64_t{ 1 } << (offset % 64);
+  return (m_TestedBits[offset / 64].fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+}
+
+
+template <unsigned int VDimension>
+auto
+ParallelFloodFill<VDimension>::ComputeIndex(OffsetValueType offset) const -> IndexType
+{
+  IndexType index;
+  for (unsigned int i = VDimension - 1; i > 0; --i)
+  {
+    index[i] = m_Region.GetIndex(i) + offset / m_OffsetTable[i];
+    offset %= m_OffsetTable[i];
+  }
+  index[0] = m_Region.GetIndex(0) + offset;
+  return index;
+}
+
+
+template <unsigned int VDimension>
+OffsetValueType
+ParallelFloodFill<VDimension>::ComputeOffset(const IndexType & index) const
+{
+  OffsetValueType offset = 0;
+  for (unsigned int i = 0; i < VDimension; ++i)
+  {
+    offset += (index[i] - m_Region.GetIndex(i)) * m_OffsetTable[i];
+  }
+  return offset;
+}
+
+} // end namespace itk
+
+#endif
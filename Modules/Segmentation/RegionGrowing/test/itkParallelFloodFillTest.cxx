@@ -0,0 +1,280 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkParallelFloodFill.h"
+#include "itkBinaryThresholdImageFunction.h"
+#include "itkConfidenceConnectedImageFilter.h"
+#include "itkConnectedThresholdImageFilter.h"
+#include "itkFloodFilledImageFunctionConditionalIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNeighborhoodConnectedImageFilter.h"
+#include "itkShapedFloodFilledImageFunctionConditionalIterator.h"
+#include "itkTestingMacros.h"
+
+#include <random>
+
+// Compare the parallel flood fill with the flood filled iterators on
+// noisy images, and check that the region growing filters produce the
+// same segmentation for any number of work units.
+
+namespace
+{
+
+template <typename TImage>
+typename TImage::Pointer
+CreateNoisyImage(const typename TImage::SizeType & size, unsigned int seed)
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::RegionType(size));
+  image->Allocate();
+
+  std::mt19937                       generator(seed);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename TImage::PixelType>(distribution(generator)));
+  }
+  return image;
+}
+
+template <typename TImage>
+bool
+ImagesAreEqual(const TImage * image1, const TImage * image2)
+{
+  itk::ImageRegionConstIterator<TImage> it1(image1, image1->GetBufferedRegion());
+  itk::ImageRegionConstIterator<TImage> it2(image2, image2->GetBufferedRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (it1.Get() != it2.Get())
+    {
+      std::cerr << "Images differ at " << it1.GetIndex() << ": " << +it1.Get() << " != " << +it2.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <unsigned int VDimension>
+bool
+TestFloodFill(unsigned int size, bool fullyConnected, unsigned int numberOfWorkUnits)
+{
+  using ImageType = itk::Image<unsigned char, VDimension>;
+  using FunctionType = itk::BinaryThresholdImageFunction<ImageType, double>;
+  using FloodFillType = itk::ParallelFloodFill<VDimension>;
+
+  auto image = CreateNoisyImage<ImageType>(ImageType::SizeType::Filled(size), size + VDimension);
+
+  auto function = FunctionType::New();
+  function->SetInputImage(image);
+  // about 70% of the pixels are included, above the percolation threshold
+  function->ThresholdBetween(0, 180);
+
+  typename FloodFillType::SeedContainerType seeds;
+  seeds.push_back(ImageType::IndexType::Filled(size / 2));
+  seeds.push_back(ImageType::IndexType::Filled(size / 5));
+  for (const auto & seed : seeds)
+  {
+    image->SetPixel(seed, 0);
+  }
+  seeds.push_back(ImageType::IndexType::Filled(size + 4)); // outside of the region
+
+  // Reference segmentation from the iterators
+  auto expected = ImageType::New();
+  expected->SetRegions(image->GetBufferedRegion());
+  expected->AllocateInitialized();
+  itk::SizeValueType expectedNumberOfPixels = 0;
+  if (fullyConnected)
+  {
+    itk::ShapedFloodFilledImageFunctionConditionalIterator<ImageType, FunctionType> it(expected, function, seeds);
+    it.FullyConnectedOn();
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++expectedNumberOfPixels)
+    {
+      it.Set(1);
+    }
+  }
+  else
+  {
+    itk::FloodFilledImageFunctionConditionalIterator<ImageType, FunctionType> it(expected, function, seeds);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++expectedNumberOfPixels)
+    {
+      it.Set(1);
+    }
+  }
+
+  auto result = ImageType::New();
+  result->SetRegions(image->GetBufferedRegion());
+  result->AllocateInitialized();
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+  FloodFillType            floodFill(image->GetBufferedRegion(), fullyConnected);
+  const itk::SizeValueType numberOfPixels = floodFill.Fill(
+    seeds,
+    [&function](const typename ImageType::IndexType & index) { return function->EvaluateAtIndex(index); },
+    [&result](const typename ImageType::IndexType & index) { result->SetPixel(index, result->GetPixel(index) + 1); },
+    multiThreader);
+
+  std::cout << VDimension << "D, size " << size << ", fully connected " << fullyConnected << ", work units "
+            << numberOfWorkUnits << ": " << numberOfPixels << " pixels" << std::endl;
+
+  bool passed = true;
+  if (numberOfPixels != expectedNumberOfPixels)
+  {
+    std::cerr << "Expected " << expectedNumberOfPixels << " flooded pixels, got " << numberOfPixels << std::endl;
+    passed = false;
+  }
+  // each pixel must be visited exactly once
+  passed &= ImagesAreEqual<ImageType>(expected, result);
+
+  // every flooded pixel has been tested
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    if (it.Get() && !floodFill.IsTested(it.GetIndex()))
+    {
+      std::cerr << "Flooded pixel " << it.GetIndex() << " is not marked as tested" << std::endl;
+      passed = false;
+      break;
+    }
+  }
+  return passed;
+}
+
+template <typename TFilter>
+bool
+TestFilterWorkUnitIndependence(TFilter * filter)
+{
+  filter->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  using ImageType = typename TFilter::OutputImageType;
+  typename ImageType::Pointer expected = filter->GetOutput();
+  expected->DisconnectPipeline();
+
+  bool passed = true;
+
+  itk::SizeValueType numberOfSegmentedPixels = 0;
+  for (itk::ImageRegionConstIterator<ImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    numberOfSegmentedPixels += (it.Get() != 0);
+  }
+  std::cout << filter->GetNameOfClass() << ": " << numberOfSegmentedPixels << " segmented pixels" << std::endl;
+  if (numberOfSegmentedPixels < 2)
+  {
+    std::cerr << filter->GetNameOfClass() << " did not grow the region from the seed" << std::endl;
+    passed = false;
+  }
+  for (const unsigned int numberOfWorkUnits : { 3u, 8u })
+  {
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+    if (!ImagesAreEqual<ImageType>(expected, filter->GetOutput()))
+    {
+      std::cerr << filter->GetNameOfClass() << " output differs with " << numberOfWorkUnits << " work units"
+                << std::endl;
+      passed = false;
+    }
+  }
+  return passed;
+}
+
+} // namespace
+
+int
+itkParallelFloodFillTest(int, char *[])
+{
+  bool passed = true;
+
+  for (const unsigned int numberOfWorkUnits : { 1u, 4u })
+  {
+    for (const bool fullyConnected : { false, true })
+    {
+      passed &= TestFloodFill<2>(300, fullyConnected, numberOfWorkUnits);
+      passed &= TestFloodFill<3>(60, fullyConnected, numberOfWorkUnits);
+    }
+  }
+
+  // A noisy dark ball with bright holes, in a bright background
+  using ImageType = itk::Image<unsigned char, 3>;
+  const auto image = CreateNoisyImage<ImageType>(ImageType::SizeType::Filled(50), 11);
+  const auto seed = ImageType::IndexType::Filled(25);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto offset = it.GetIndex() - seed;
+    const bool inside = offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2] < 20 * 20;
+    const int  value = it.Get();
+    if (inside)
+    {
+      it.Set(static_cast<unsigned char>(value < 250 ? value * 100 / 250 : 200));
+    }
+    else
+    {
+      it.Set(static_cast<unsigned char>(150 + value * 105 / 255));
+    }
+  }
+  ImageType::RegionType seedRegion(seed, ImageType::SizeType::Filled(1));
+  seedRegion.PadByRadius(1);
+  for (itk::ImageRegionIterator<ImageType> it(image, seedRegion); !it.IsAtEnd(); ++it)
+  {
+    it.Set(50);
+  }
+
+  {
+    using FilterType = itk::ConnectedThresholdImageFilter<ImageType, ImageType>;
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetSeed(seed);
+    filter->SetLower(0);
+    filter->SetUpper(150);
+    filter->SetReplaceValue(255);
+    passed &= TestFilterWorkUnitIndependence(filter.GetPointer());
+    filter->SetConnectivity(FilterType::ConnectivityEnum::FullConnectivity);
+    passed &= TestFilterWorkUnitIndependence(filter.GetPointer());
+  }
+  {
+    using FilterType = itk::NeighborhoodConnectedImageFilter<ImageType, ImageType>;
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetSeed(seed);
+    filter->SetLower(0);
+    filter->SetUpper(120);
+    filter->SetRadius(ImageType::SizeType::Filled(1));
+    passed &= TestFilterWorkUnitIndependence(filter.GetPointer());
+  }
+  {
+    using FilterType = itk::ConfidenceConnectedImageFilter<ImageType, ImageType>;
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetSeed(seed);
+    filter->SetMultiplier(1.5);
+    filter->SetInitialNeighborhoodRadius(2);
+    filter->SetNumberOfIterations(3);
+    passed &= TestFilterWorkUnitIndependence(filter.GetPointer());
+  }
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -19,7 +19,6 @@
 #define itkSLICImageFilter_h
 
 #include "itkImageToImageFilter.h"
-#include <mutex>
 
 namespace itk
 {
@@ -49,6 +48,13 @@ namespace itk
  * superpixel cluster. Every pixel in the output is labeled, and the
  * starting label id is zero.
  *
+ * All stages of the algorithm are multi-threaded. The cluster centers
+ * are updated from per-slab partial sums which are reduced in a fixed
+ * order, and the connectivity enforcement labels the disconnected
+ * components of each slab independently before merging them across
+ * slab boundaries. The output therefore does not depend on the order
+ * in which the work units complete.
+ *
  * This code was contributed in the Insight Journal paper:
  * "Scalable Simple Linear Iterative Clustering (SSLIC) Using a
  * Generic and Parallel Approach" by Lowekamp B. C., Chen D. T., Yaniv
@@ -177,8 +183,13 @@ protected:
   void
   ThreadedUpdateDistanceAndLabel(const OutputImageRegionType & outputRegionForThread);
 
+  /** Accumulate the partial cluster sums of one slab of the output. */
+  void
+  ThreadedUpdateClusters(SizeValueType slabIndex);
+
+  /** Reduce the partial sums of all slabs into the new cluster center. */
   void
-  ThreadedUpdateClusters(const OutputImageRegionType & updateRegionForThread);
+  ThreadedReduceClusters(SizeValueType clusterIndex);
 
   void
   ThreadedPerturbClusters(SizeValueType clusterIndex);
@@ -186,8 +197,17 @@ protected:
   void
   ThreadedConnectivity(SizeValueType clusterIndex);
 
+  /** Label the components not connected to a cluster center within one slab. */
+  void
+  ThreadedLabelOrphanComponents(SizeValueType slabIndex);
+
+  /** Merge the orphan components across slab boundaries and assign their final labels. */
+  void
+  MergeOrphanComponents();
+
+  /** Write the final labels of the orphan components of one slab. */
   void
-  SingleThreadedConnectivity();
+  ThreadedRelabelOrphanComponents(SizeValueType slabIndex);
 
   void
   GenerateData() override;
@@ -218,17 +238,40 @@ private:
                          OutputPixelType          outputLabel,
                          std::vector<IndexType> & indexStack);
 
-  struct UpdateCluster
+  /** Split the output requested region into slabs along the slowest dimension. */
+  void
+  InitializeSlabs();
+
+  /** Dense sums over the contiguous range of labels found in a slab. */
+  struct PartialClusterSums
+  {
+    size_t                            firstLabel{};
+    std::vector<size_t>               count{};
+    std::vector<ClusterComponentType> sum{};
+  };
+
+  /** The components of a slab whose pixels are not connected to their cluster center. */
+  struct OrphanComponents
   {
-    size_t                           count;
-    vnl_vector<ClusterComponentType> cluster;
+    /** Buffer offsets of the pixels, grouped by component in raster order of their first pixel. */
+    std::vector<OffsetValueType> pixels{};
+    std::vector<size_t>          componentStart{};
+    /** Buffer offsets of the pixels sorted, paired with their component. */
+    std::vector<std::pair<OffsetValueType, size_t>> sortedPixels{};
+    /** The global id of the first component of the slab. */
+    size_t firstGlobalComponent{};
   };
 
-  using UpdateClusterMap = std::map<size_t, UpdateCluster>;
+  size_t
+  FindOrphanComponent(OffsetValueType offset) const;
 
   using MarkerImageType = Image<unsigned char, ImageDimension>;
 
-  std::vector<UpdateClusterMap> m_UpdateClusterPerThread{};
+  std::vector<OutputImageRegionType> m_Slabs{};
+  std::vector<PartialClusterSums>    m_PartialClusterSums{};
+  std::vector<OrphanComponents>      m_OrphanComponents{};
+  std::vector<size_t>                m_OrphanComponentParent{};
+  std::vector<OutputPixelType>       m_OrphanComponentLabel{};
 
   typename DistanceImageType::Pointer m_DistanceImage{};
   typename MarkerImageType::Pointer   m_MarkerImage{};
@@ -237,8 +280,7 @@ private:
 
   bool m_InitializationPerturbation{ true };
 
-  double     m_AverageResidual{};
-  std::mutex m_Mutex{};
+  double m_AverageResidual{};
 };
 } // end namespace itk
 
@@ -35,6 +35,7 @@
 
 #include "itkMath.h"
 
+#include <algorithm>
 #include <numeric>
 
 
@@ -183,8 +184,7 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::BeforeThreadedGenera
     m_DistanceScales[i] = m_SpatialProximityWeight / m_SuperGridSize[i];
   }
 
-
-  m_UpdateClusterPerThread.clear();
+  this->InitializeSlabs();
 
   this->Superclass::BeforeThreadedGenerateData();
 }
@@ -231,6 +231,7 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateDistan
 
     ImageScanlineConstIterator inputIter(inputImage, localRegion);
     ImageScanlineIterator      distanceIter(m_DistanceImage, localRegion);
+    ImageScanlineIterator      outputIter(outputImage, localRegion);
 
 
     while (!inputIter.IsAtEnd())
@@ -244,14 +245,16 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateDistan
         if (distance < distanceIter.Get())
         {
           distanceIter.Set(distance);
-          outputImage->SetPixel(currentIdx, i);
+          outputIter.Set(i);
         }
 
         ++distanceIter;
         ++inputIter;
+        ++outputIter;
       }
       inputIter.NextLine();
       distanceIter.NextLine();
+      outputIter.NextLine();
     }
 
     // for neighborhood iterator size S
@@ -261,8 +264,7 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateDistan
 
 template <typename TInputImage, typename TOutputImage, typename TDistancePixel>
 void
-SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateClusters(
-  const OutputImageRegionType & updateRegionForThread)
+SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateClusters(SizeValueType slabIndex)
 {
   const InputImageType * inputImage = this->GetInput();
   OutputImageType *      outputImage = this->GetOutput();
@@ -270,7 +272,28 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateCluste
   const unsigned int numberOfComponents = inputImage->GetNumberOfComponentsPerPixel();
   const unsigned int numberOfClusterComponents = numberOfComponents + ImageDimension;
 
-  UpdateClusterMap clusterMap;
+  const OutputImageRegionType & updateRegionForThread = m_Slabs[slabIndex];
+  PartialClusterSums &          partialSums = m_PartialClusterSums[slabIndex];
+  const size_t                  ln = updateRegionForThread.GetSize(0);
+
+  // The clusters are initialized in raster order, so a slab only contains
+  // a contiguous range of labels, which is accumulated densely.
+  size_t minLabel = NumericTraits<size_t>::max();
+  size_t maxLabel = 0;
+  for (ImageScanlineConstIterator itOut(outputImage, updateRegionForThread); !itOut.IsAtEnd(); itOut.NextLine())
+  {
+    for (size_t x = 0; x < ln; ++x)
+    {
+      const size_t l = itOut.Get();
+      minLabel = std::min(minLabel, l);
+      maxLabel = std::max(maxLabel, l);
+      ++itOut;
+    }
+  }
+
+  partialSums.firstLabel = minLabel;
+  partialSums.count.assign(maxLabel - minLabel + 1, 0);
+  partialSums.sum.assign((maxLabel - minLabel + 1) * numberOfClusterComponents, 0.0);
 
   itkDebugMacro("Estimating Centers");
   // calculate new centers
@@ -278,22 +301,14 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateCluste
   ImageScanlineConstIterator itIn(inputImage, updateRegionForThread);
   while (!itOut.IsAtEnd())
   {
-    const size_t ln = updateRegionForThread.GetSize(0);
-    for (unsigned int x = 0; x < ln; ++x)
+    for (size_t x = 0; x < ln; ++x)
     {
-      const IndexType &                         idx = itOut.GetIndex();
-      const InputPixelType &                    v = itIn.Get();
-      const typename OutputImageType::PixelType l = itOut.Get();
+      const IndexType &      idx = itOut.GetIndex();
+      const InputPixelType & v = itIn.Get();
+      const size_t           localLabel = itOut.Get() - minLabel;
 
-      std::pair<typename UpdateClusterMap::iterator, bool> r = clusterMap.insert(std::make_pair(l, UpdateCluster()));
-      vnl_vector<ClusterComponentType> &                   cluster = r.first->second.cluster;
-      if (r.second)
-      {
-        cluster.set_size(numberOfClusterComponents);
-        cluster.fill(0.0);
-        r.first->second.count = 0;
-      }
-      ++r.first->second.count;
+      ++partialSums.count[localLabel];
+      ClusterComponentType * cluster = &partialSums.sum[localLabel * numberOfClusterComponents];
 
       const typename NumericTraits<InputPixelType>::MeasurementVectorType & mv = v;
       for (unsigned int i = 0; i < numberOfComponents; ++i)
@@ -312,10 +327,36 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateCluste
     itIn.NextLine();
     itOut.NextLine();
   }
+}
+
 
-  // TODO improve merge algorithm
-  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
-  m_UpdateClusterPerThread.push_back(clusterMap);
+template <typename TInputImage, typename TOutputImage, typename TDistancePixel>
+void
+SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedReduceClusters(SizeValueType clusterIndex)
+{
+  const unsigned int numberOfComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+  const unsigned int numberOfClusterComponents = numberOfComponents + ImageDimension;
+
+  ClusterType cluster(numberOfClusterComponents, &m_Clusters[clusterIndex * numberOfClusterComponents]);
+  cluster.fill(0.0);
+
+  // The slabs are always reduced in the same order, so the result is
+  // independent of the scheduling of the work units.
+  size_t count = 0;
+  for (const PartialClusterSums & partialSums : m_PartialClusterSums)
+  {
+    if (clusterIndex < partialSums.firstLabel || clusterIndex - partialSums.firstLabel >= partialSums.count.size())
+    {
+      continue;
+    }
+    const size_t localLabel = clusterIndex - partialSums.firstLabel;
+    count += partialSums.count[localLabel];
+    for (unsigned int i = 0; i < numberOfClusterComponents; ++i)
+    {
+      cluster[i] += partialSums.sum[localLabel * numberOfClusterComponents + i];
+    }
+  }
+  cluster /= count;
 }
 
 
@@ -504,9 +545,121 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedConnectivity
 
 template <typename TInputImage, typename TOutputImage, typename TDistancePixel>
 void
-SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::SingleThreadedConnectivity()
+SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedLabelOrphanComponents(SizeValueType slabIndex)
+{
+  itkDebugMacro("Threaded Label Orphan Components");
+
+  OutputImageType *             outputImage = this->GetOutput();
+  const OutputImageRegionType & slab = m_Slabs[slabIndex];
+  OrphanComponents &            components = m_OrphanComponents[slabIndex];
+
+  const OutputPixelType * labels = outputImage->GetBufferPointer();
+  unsigned char *         markers = m_MarkerImage->GetBufferPointer();
+  const OffsetValueType * offsetTable = outputImage->GetOffsetTable();
+
+  components.pixels.clear();
+  components.componentStart.clear();
+
+  // The pixels not connected to the SuperPixel centroids ( marker 0 )
+  // are grouped into face connected components of the same label. The
+  // search is restricted to the slab, so the slabs are labeled
+  // independently and the visited pixels are marked with 2.
+  ImageScanlineConstIterator markerIter(m_MarkerImage.GetPointer(), slab);
+  while (!markerIter.IsAtEnd())
+  {
+    while (!markerIter.IsAtEndOfLine())
+    {
+      if (markerIter.Get() == 0)
+      {
+        const OffsetValueType seed = m_MarkerImage->ComputeOffset(markerIter.GetIndex());
+        const OutputPixelType label = labels[seed];
+
+        components.componentStart.push_back(components.pixels.size());
+        components.pixels.push_back(seed);
+        markers[seed] = 2;
+
+        for (size_t n = components.componentStart.back(); n < components.pixels.size(); ++n)
+        {
+          const OffsetValueType offset = components.pixels[n];
+          const IndexType       idx = outputImage->ComputeIndex(offset);
+          for (unsigned int j = 0; j < ImageDimension; ++j)
+          {
+            if (idx[j] > slab.GetIndex(j))
+            {
+              const OffsetValueType nOffset = offset - offsetTable[j];
+              if (markers[nOffset] == 0 && labels[nOffset] == label)
+              {
+                markers[nOffset] = 2;
+                components.pixels.push_back(nOffset);
+              }
+            }
+            if (idx[j] < slab.GetUpperIndex()[j])
+            {
+              const OffsetValueType nOffset = offset + offsetTable[j];
+              if (markers[nOffset] == 0 && labels[nOffset] == label)
+              {
+                markers[nOffset] = 2;
+                components.pixels.push_back(nOffset);
+              }
+            }
+          }
+        }
+      }
+      ++markerIter;
+    }
+    markerIter.NextLine();
+  }
+  components.componentStart.push_back(components.pixels.size());
+
+  components.sortedPixels.clear();
+  components.sortedPixels.reserve(components.pixels.size());
+  for (size_t c = 0; c + 1 < components.componentStart.size(); ++c)
+  {
+    for (size_t n = components.componentStart[c]; n < components.componentStart[c + 1]; ++n)
+    {
+      components.sortedPixels.emplace_back(components.pixels[n], c);
+    }
+  }
+  std::sort(components.sortedPixels.begin(), components.sortedPixels.end());
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TDistancePixel>
+size_t
+SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::FindOrphanComponent(OffsetValueType offset) const
+{
+  const IndexValueType slowIndex = this->GetOutput()->ComputeIndex(offset)[ImageDimension - 1];
+
+  const auto slabIter = std::find_if(m_Slabs.cbegin(), m_Slabs.cend(), [slowIndex](const OutputImageRegionType & slab) {
+    return slowIndex <= slab.GetUpperIndex()[ImageDimension - 1];
+  });
+  const OrphanComponents & components = m_OrphanComponents[slabIter - m_Slabs.cbegin()];
+
+  const auto pixelIter =
+    std::lower_bound(components.sortedPixels.cbegin(),
+                     components.sortedPixels.cend(),
+                     offset,
+                     [](const std::pair<OffsetValueType, size_t> & p, OffsetValueType o) { return p.first < o; });
+  if (pixelIter == components.sortedPixels.cend() || pixelIter->first != offset)
+  {
+    return NumericTraits<size_t>::max();
+  }
+
+  // find the root component
+  size_t component = components.firstGlobalComponent + pixelIter->second;
+  while (m_OrphanComponentParent[component] != component)
+  {
+    component = m_OrphanComponentParent[component];
+  }
+  return component;
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TDistancePixel>
+void
+SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::MergeOrphanComponents()
 {
-  itkDebugMacro("Single Threaded Connectivity");
+  itkDebugMacro("Merge Orphan Components");
 
   const InputImageType * inputImage = this->GetInput();
   OutputImageType *      outputImage = this->GetOutput();
@@ -514,55 +667,141 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::SingleThreadedConnec
   const unsigned int numberOfComponents = inputImage->GetNumberOfComponentsPerPixel();
   const unsigned int numberOfClusterComponents = numberOfComponents + ImageDimension;
 
-  OutputPixelType nextLabel = m_Clusters.size() / numberOfClusterComponents;
-  OutputPixelType prevLabel = m_Clusters.size() / numberOfClusterComponents;
+  const OutputPixelType * labels = outputImage->GetBufferPointer();
+  const unsigned char *   markers = m_MarkerImage->GetBufferPointer();
+  const OffsetValueType   sliceStride = outputImage->GetOffsetTable()[ImageDimension - 1];
 
   const size_t minSuperSize =
     std::accumulate(m_SuperGridSize.cbegin(), m_SuperGridSize.cend(), size_t(1), std::multiplies<size_t>()) / 4;
 
-  std::vector<IndexType> indexStack;
+  size_t numberOfOrphanComponents = 0;
+  for (OrphanComponents & components : m_OrphanComponents)
+  {
+    components.firstGlobalComponent = numberOfOrphanComponents;
+    numberOfOrphanComponents += components.componentStart.size() - 1;
+  }
+
+  m_OrphanComponentParent.resize(numberOfOrphanComponents);
+  std::iota(m_OrphanComponentParent.begin(), m_OrphanComponentParent.end(), size_t(0));
+
+  // Join the components which touch across the boundary between two
+  // slabs. The global component ids follow the raster order of the
+  // first pixel of the components, so the smaller id is kept as the root.
+  for (size_t s = 1; s < m_Slabs.size(); ++s)
+  {
+    OutputImageRegionType boundary = m_Slabs[s];
+    boundary.SetSize(ImageDimension - 1, 1);
+
+    for (ImageScanlineConstIterator it(m_MarkerImage.GetPointer(), boundary); !it.IsAtEnd(); it.NextLine())
+    {
+      while (!it.IsAtEndOfLine())
+      {
+        const OffsetValueType offset = m_MarkerImage->ComputeOffset(it.GetIndex());
+        const OffsetValueType belowOffset = offset - sliceStride;
+        if (markers[offset] == 2 && markers[belowOffset] == 2 && labels[offset] == labels[belowOffset])
+        {
+          const size_t a = this->FindOrphanComponent(offset);
+          const size_t b = this->FindOrphanComponent(belowOffset);
+          // both are roots, so the union keeps the parent of a component smaller than itself
+          m_OrphanComponentParent[std::max(a, b)] = std::min(a, b);
+        }
+        ++it;
+      }
+    }
+  }
+
+  std::vector<size_t> componentSize(numberOfOrphanComponents, 0);
+  for (size_t c = 0; c < numberOfOrphanComponents; ++c)
+  {
+    // The parent of a component always has a smaller id, so it is already resolved to the root.
+    m_OrphanComponentParent[c] = m_OrphanComponentParent[m_OrphanComponentParent[c]];
+  }
+  for (const OrphanComponents & components : m_OrphanComponents)
+  {
+    for (size_t c = 0; c + 1 < components.componentStart.size(); ++c)
+    {
+      componentSize[m_OrphanComponentParent[components.firstGlobalComponent + c]] +=
+        components.componentStart[c + 1] - components.componentStart[c];
+    }
+  }
 
   // Next we relabel the remaining regions ( defined by having the
   // label id ) not connected to the SuperPixel centroids. If the
   // region is larger than the minimum superpixel size than it gets
-  // a new label, otherwise it just gets the previously encountered
-  // label id.
-
-  ImageScanlineIterator outputIter(outputImage, outputImage->GetRequestedRegion());
-  ImageScanlineIterator markerIter(m_MarkerImage, outputImage->GetRequestedRegion());
+  // a new label, otherwise it just gets the label of the pixel
+  // preceding it in raster order.
+  OutputPixelType nextLabel = m_Clusters.size() / numberOfClusterComponents;
+  m_OrphanComponentLabel.assign(numberOfOrphanComponents, nextLabel);
 
-  while (!markerIter.IsAtEnd())
+  for (const OrphanComponents & components : m_OrphanComponents)
   {
-    while (!markerIter.IsAtEndOfLine())
+    for (size_t c = 0; c + 1 < components.componentStart.size(); ++c)
     {
-      if (markerIter.Get() == 0)
+      const size_t component = components.firstGlobalComponent + c;
+      if (m_OrphanComponentParent[component] != component)
       {
-        // try relabeling the connected component to the next label id
-        this->RelabelConnectedRegion(markerIter.GetIndex(), outputIter.Get(), nextLabel, indexStack);
+        continue;
+      }
 
-        if (indexStack.size() >= minSuperSize)
-        {
-          prevLabel = nextLabel++;
-        }
-        else
-        {
-          for (size_t indexStackDelabel = 0; indexStackDelabel < indexStack.size(); ++indexStackDelabel)
-          {
-            outputImage->SetPixel(indexStack[indexStackDelabel], prevLabel);
-          }
-        }
+      if (componentSize[component] >= minSuperSize)
+      {
+        m_OrphanComponentLabel[component] = nextLabel++;
+        continue;
       }
-      else
+
+      const OffsetValueType firstOffset = components.pixels[components.componentStart[c]];
+      if (firstOffset > 0)
       {
-        prevLabel = outputIter.Get();
+        const size_t previousComponent = this->FindOrphanComponent(firstOffset - 1);
+        m_OrphanComponentLabel[component] = (previousComponent == NumericTraits<size_t>::max())
+                                              ? labels[firstOffset - 1]
+                                              : m_OrphanComponentLabel[previousComponent];
       }
-      ++markerIter;
-      ++outputIter;
     }
+  }
+}
 
-    markerIter.NextLine();
-    outputIter.NextLine();
+
+template <typename TInputImage, typename TOutputImage, typename TDistancePixel>
+void
+SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedRelabelOrphanComponents(SizeValueType slabIndex)
+{
+  OutputPixelType *        labels = this->GetOutput()->GetBufferPointer();
+  const OrphanComponents & components = m_OrphanComponents[slabIndex];
+
+  for (size_t c = 0; c + 1 < components.componentStart.size(); ++c)
+  {
+    const OutputPixelType label =
+      m_OrphanComponentLabel[m_OrphanComponentParent[components.firstGlobalComponent + c]];
+    for (size_t n = components.componentStart[c]; n < components.componentStart[c + 1]; ++n)
+    {
+      labels[components.pixels[n]] = label;
+    }
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TDistancePixel>
+void
+SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::InitializeSlabs()
+{
+  const OutputImageRegionType & requestedRegion = this->GetOutput()->GetRequestedRegion();
+  const SizeValueType           slowSize = requestedRegion.GetSize(ImageDimension - 1);
+  const SizeValueType           numberOfSlabs =
+    std::max<SizeValueType>(std::min<SizeValueType>(this->GetNumberOfWorkUnits(), slowSize), 1);
+
+  m_Slabs.resize(numberOfSlabs);
+  for (SizeValueType s = 0; s < numberOfSlabs; ++s)
+  {
+    const SizeValueType begin = (slowSize * s) / numberOfSlabs;
+    const SizeValueType end = (slowSize * (s + 1)) / numberOfSlabs;
+
+    m_Slabs[s] = requestedRegion;
+    m_Slabs[s].SetIndex(ImageDimension - 1, requestedRegion.GetIndex(ImageDimension - 1) + begin);
+    m_Slabs[s].SetSize(ImageDimension - 1, end - begin);
   }
+  m_PartialClusterSums.resize(numberOfSlabs);
+  m_OrphanComponents.resize(numberOfSlabs);
 }
 
 
@@ -606,7 +845,6 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::GenerateData()
     itkDebugMacro("Iteration :" << loopCnt);
 
     m_DistanceImage->FillBuffer(NumericTraits<typename DistanceImageType::PixelType>::max());
-    m_UpdateClusterPerThread.clear();
 
     this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
       outputImage->GetRequestedRegion(),
@@ -616,41 +854,19 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::GenerateData()
       this);
 
 
-    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
-      outputImage->GetRequestedRegion(),
-      [this](const OutputImageRegionType & outputRegionForThread) {
-        this->ThreadedUpdateClusters(outputRegionForThread);
-      },
-      this);
+    this->GetMultiThreader()->ParallelizeArray(
+      0, m_Slabs.size(), [this](SizeValueType idx) { this->ThreadedUpdateClusters(idx); }, this);
 
-    // prepare to update clusters
+    // reduce the per-slab partial sums into the m_Cluster array
     swap(m_Clusters, m_OldClusters);
-    std::fill(m_Clusters.begin(), m_Clusters.end(), 0.0);
-    std::vector<size_t> clusterCount(m_Clusters.size() / numberOfClusterComponents, 0);
-
-    // reduce the produce cluster maps per-thread into m_Cluster array
-    for (unsigned int i = 0; i < m_UpdateClusterPerThread.size(); ++i)
-    {
-      UpdateClusterMap & clusterMap = m_UpdateClusterPerThread[i];
-      for (typename UpdateClusterMap::const_iterator clusterIter = clusterMap.begin(); clusterIter != clusterMap.end();
-           ++clusterIter)
-      {
-        const size_t clusterIdx = clusterIter->first;
-        clusterCount[clusterIdx] += clusterIter->second.count;
-
-        ClusterType cluster(numberOfClusterComponents, &m_Clusters[clusterIdx * numberOfClusterComponents]);
-        cluster += clusterIter->second.cluster;
-      }
-    }
+    this->GetMultiThreader()->ParallelizeArray(
+      0, numberOfClusters, [this](SizeValueType idx) { this->ThreadedReduceClusters(idx); }, this);
 
-    // average, l1
+    // l1 residual
     double l1Residual = 0.0;
     for (size_t i = 0; i * numberOfClusterComponents < m_Clusters.size(); ++i)
     {
-
       ClusterType cluster(numberOfClusterComponents, &m_Clusters[i * numberOfClusterComponents]);
-      cluster /= clusterCount[i];
-
       ClusterType oldCluster(numberOfClusterComponents, &m_OldClusters[i * numberOfClusterComponents]);
       l1Residual += Distance(cluster, oldCluster);
     }
@@ -675,7 +891,12 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::GenerateData()
 
     this->GetMultiThreader()->ParallelizeArray(
       0, numberOfClusters, [this](SizeValueType idx) { this->ThreadedConnectivity(idx); }, this);
-    this->SingleThreadedConnectivity();
+
+    this->GetMultiThreader()->ParallelizeArray(
+      0, m_Slabs.size(), [this](SizeValueType idx) { this->ThreadedLabelOrphanComponents(idx); }, this);
+    this->MergeOrphanComponents();
+    this->GetMultiThreader()->ParallelizeArray(
+      0, m_Slabs.size(), [this](SizeValueType idx) { this->ThreadedRelabelOrphanComponents(idx); }, this);
   }
 
 
@@ -695,10 +916,11 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::AfterThreadedGenerat
   // cleanup
   std::vector<ClusterComponentType>().swap(m_Clusters);
   std::vector<ClusterComponentType>().swap(m_OldClusters);
-  for (unsigned int i = 0; i < m_UpdateClusterPerThread.size(); ++i)
-  {
-    UpdateClusterMap().swap(m_UpdateClusterPerThread[i]);
-  }
+  std::vector<OutputImageRegionType>().swap(m_Slabs);
+  std::vector<PartialClusterSums>().swap(m_PartialClusterSums);
+  std::vector<OrphanComponents>().swap(m_OrphanComponents);
+  std::vector<size_t>().swap(m_OrphanComponentParent);
+  std::vector<OutputPixelType>().swap(m_OrphanComponentLabel);
 }
 
 
@@ -20,6 +20,7 @@
 
 #include "itkSLICImageFilter.h"
 #include "itkVectorImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
 
 #include "itkCommand.h"
 
@@ -177,3 +178,41 @@ TEST_F(SLICFixture, ClusterInitializationOverflow)
   EXPECT_EQ("be2250b1d36e8a418f6487189db1ea64", MD5Hash(filter->GetOutput()));
   EXPECT_FLOAT_EQ(0.023752308, filter->GetAverageResidual());
 }
+
+
+TEST_F(SLICFixture, WorkUnitIndependence)
+{
+  // The cluster update and the connectivity enforcement are computed
+  // per slab, the output must not depend on the number of work units.
+  using namespace itk::GTest::TypedefsAndConstructors::Dimension3;
+  using Utils = FixtureUtilities<3, unsigned char>;
+
+  auto image = Utils::CreateImage(40);
+
+  itk::ImageRegionIteratorWithIndex<Utils::InputImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const auto & idx = it.GetIndex();
+    // a noisy pattern with oblique boundaries to produce disconnected fragments
+    const unsigned int noise = (idx[0] * 7919 + idx[1] * 104729 + idx[2] * 1299709) % 37;
+    it.Set(static_cast<unsigned char>(((idx[0] + 2 * idx[1] + 3 * idx[2]) % 23 < 11 ? 100 : 0) + noise));
+  }
+
+  auto filter = Utils::FilterType::New();
+  filter->SetInput(image);
+  filter->SetSuperGridSize(6);
+  filter->SetEnforceConnectivity(true);
+  filter->SetNumberOfWorkUnits(1);
+  filter->Update();
+
+  const std::string expectedHash = MD5Hash(filter->GetOutput());
+  const double      expectedResidual = filter->GetAverageResidual();
+
+  for (const unsigned int numberOfWorkUnits : { 2u, 3u, 7u, 64u })
+  {
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    filter->Update();
+    EXPECT_EQ(expectedHash, MD5Hash(filter->GetOutput())) << "Number of work units: " << numberOfWorkUnits;
+    EXPECT_EQ(expectedResidual, filter->GetAverageResidual()) << "Number of work units: " << numberOfWorkUnits;
+  }
+}